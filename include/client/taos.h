@@ -178,6 +178,10 @@ DLL_EXPORT int       taos_stmt_get_param(TAOS_STMT *stmt, int idx, int *type, in
 DLL_EXPORT int       taos_stmt_bind_param(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind);
 DLL_EXPORT int       taos_stmt_bind_param_batch(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind);
 DLL_EXPORT int       taos_stmt_bind_single_param_batch(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind, int colIdx);
+// bind the rows of multiple tables in one call, the table of each row is given by `tbnames`, and the tags of a table
+// to be created by its first row in `tags`, the rows of each table are added to the batch
+DLL_EXPORT int       taos_stmt_bind_multi_table_batch(TAOS_STMT *stmt, TAOS_MULTI_BIND *tbnames, TAOS_MULTI_BIND *tags,
+                                                      TAOS_MULTI_BIND *bind);
 DLL_EXPORT int       taos_stmt_add_batch(TAOS_STMT *stmt);
 DLL_EXPORT int       taos_stmt_execute(TAOS_STMT *stmt);
 DLL_EXPORT TAOS_RES *taos_stmt_use_result(TAOS_STMT *stmt);
@@ -34,6 +34,7 @@ typedef struct SBlockOrderInfo {
 
 #define BLOCK_VERSION_1          1
 #define BLOCK_VERSION_2          2
+#define BLOCK_VERSION_3          3  // the columns are compressed, see blockCompressEncode
 
 #define NBIT                     (3u)
 #define BitPos(_n)               ((_n) & ((1 << NBIT) - 1))
@@ -229,6 +230,10 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief move the rows into the order given by index, the i-th row of the block is taken from the row index[i]
+ */
+int32_t blockDataReorderRows(SSDataBlock* pDataBlock, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
@@ -266,6 +271,8 @@ SColumnInfoData* bdGetColumnInfoData(const SSDataBlock* pBlock, int32_t index);
 
 int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
+int32_t blockGetCompressEncodeSize(const SSDataBlock* pBlock);
+int32_t blockCompressEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 const char* blockDecode(SSDataBlock* pBlock, const char* pData);
 
 // for debug
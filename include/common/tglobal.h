@@ -71,6 +71,7 @@ extern int32_t tsTagFilterResCacheSize;
 extern int32_t tsNumOfRpcThreads;
 extern int32_t tsNumOfRpcSessions;
 extern int32_t tsTimeToGetAvailableConn;
+extern int32_t tsRpcMuxWindow;
 extern int32_t tsKeepAliveIdle;
 extern int32_t tsNumOfCommitThreads;
 extern int32_t tsNumOfTaskQueueThreads;
@@ -81,6 +82,7 @@ extern int32_t tsNumOfVnodeQueryThreads;
 extern float   tsRatioOfVnodeStreamThreads;
 extern int32_t tsNumOfVnodeFetchThreads;
 extern int32_t tsNumOfVnodeRsmaThreads;
+extern int32_t tsNumOfParaScanThreads;
 extern int32_t tsNumOfQnodeQueryThreads;
 extern int32_t tsNumOfQnodeFetchThreads;
 extern int32_t tsNumOfSnodeStreamThreads;
@@ -154,12 +156,18 @@ extern char    *tsSvrCrashReportUri;
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
+extern int32_t tsReadAheadBlocks;         // number of file blocks read ahead by the tsdb reader
+extern int32_t tsReadAheadSize;           // maximum size (in MB) of the file blocks read ahead by the tsdb reader
+extern bool    tsIoUring;                 // submit batched file io through io_uring
+extern bool    tsLockFreeWriteQueue;      // vnode write queues are lock free
 
 // query client
 extern int32_t tsQueryPolicy;
 extern int32_t tsQueryRspPolicy;
+extern bool    tsCompressFetchRsp;
 extern int64_t tsQueryMaxConcurrentTables;
 extern int32_t tsQuerySmaOptimize;
+extern int32_t tsQueryScanParallelism;
 extern int32_t tsQueryRsmaTolerance;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
@@ -184,6 +192,7 @@ extern bool    tsMultiResultFunctionStarReturnTags;
 extern int32_t tsMinSlidingTime;
 extern int32_t tsMinIntervalTime;
 extern int32_t tsMaxInsertBatchRows;
+extern int32_t tsNumOfCsvParseThreads;
 
 // build info
 extern char version[];
@@ -57,6 +57,7 @@ typedef struct SDataSinkStat {
 typedef struct SDataSinkMgtCfg {
   uint32_t maxDataBlockNum;  // todo: this should be numOfRows?
   uint32_t maxDataBlockNumPerQuery;
+  bool     compress;  // the blocks are fetched by an exchange operator, and are sent with the columns compressed
 } SDataSinkMgtCfg;
 
 int32_t dsDataSinkMgtInit(SDataSinkMgtCfg* cfg, SStorageAPI* pAPI, void** ppSinkManager);
@@ -177,6 +177,8 @@ typedef enum EFunctionType {
   FUNCTION_TYPE_STDDEV_STATE_MERGE,
   FUNCTION_TYPE_HYPERLOGLOG_STATE,
   FUNCTION_TYPE_HYPERLOGLOG_STATE_MERGE,
+  FUNCTION_TYPE_PERCENTILE_PARTIAL,
+  FUNCTION_TYPE_PERCENTILE_MERGE,
 
   // geometry functions
   FUNCTION_TYPE_GEOM_FROM_TEXT = 4250,
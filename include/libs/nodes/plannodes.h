@@ -475,6 +475,7 @@ typedef struct STableScanPhysiNode {
   bool           needCountEmptyTable;
   bool           paraTablesSort;
   bool           smallDataTsSort;
+  int8_t         scanParallelism;  // number of concurrent readers over the table list, 1 means serial scan
 } STableScanPhysiNode;
 
 typedef STableScanPhysiNode STableSeqScanPhysiNode;
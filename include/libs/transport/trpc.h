@@ -124,6 +124,7 @@ typedef struct SRpcInit {
   int32_t timeToGetConn;
   int8_t  supportBatch;  // 0: no batch, 1. batch
   int32_t batchSize;
+  int32_t muxWindow;  // 0: one request per conn, n: at most n requests in flight on the conn shared by a peer
   void   *parent;
 } SRpcInit;
 
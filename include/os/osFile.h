@@ -87,6 +87,23 @@ bool    taosCheckExistFile(const char *pathname);
 int64_t taosLSeekFile(TdFilePtr pFile, int64_t offset, int32_t whence);
 int32_t taosFtruncateFile(TdFilePtr pFile, int64_t length);
 int32_t taosFsyncFile(TdFilePtr pFile);
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t len);
+
+// one read/write of a batch, offset -1 means to use and advance the current file position
+typedef struct STdFileIo {
+  TdFilePtr pFile;
+  void     *buf;
+  int64_t   count;
+  int64_t   offset;
+  int64_t   result;  // number of bytes read/written, or -errno if failed
+} STdFileIo;
+
+// Try to submit the batched reads/writes through io_uring, if it is not supported by the kernel, -1 is returned and the
+// batched reads/writes are issued one by one.
+int32_t taosInitFileIoUring(bool enable);
+bool    taosFileIoUringEnabled();
+int32_t taosReadFileBatch(STdFileIo *pIos, int32_t num);
+int32_t taosWriteFileBatch(STdFileIo *pIos, int32_t num, bool fsync);
 
 int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
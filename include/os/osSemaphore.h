@@ -98,6 +98,11 @@ int tsem2_destroy(tsem2_t* sem);
 // #define taosThreadSpinUnlock(lock)     taosThreadMutexUnlock(lock)
 #endif
 
+// block while *addr equals val, it may also return spuriously, so the caller shall check the condition again
+int32_t taosFutexWait(int32_t volatile *addr, int32_t val);
+// wake up at most num threads blocked on addr
+int32_t taosFutexWake(int32_t volatile *addr, int32_t num);
+
 bool    taosCheckPthreadValid(TdThread thread);
 int64_t taosGetSelfPthreadId();
 int64_t taosGetPthreadId(TdThread thread);
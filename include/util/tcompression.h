@@ -158,6 +158,9 @@ int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelemen
 int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
                                     bool bigEndian);
 int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output, bool bigEndian);
+int32_t tsDecompressDoubleImplAvx512(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressBoolImplAvx2(const char *const input, const int32_t nelements, char *const output);
 
 /*************************************************************************
  *                  REGULAR COMPRESSION 2
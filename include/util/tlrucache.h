@@ -31,6 +31,10 @@ typedef struct LRUHandle LRUHandle;
 
 typedef enum { TAOS_LRU_PRIORITY_HIGH, TAOS_LRU_PRIORITY_LOW } LRUPriority;
 
+// TAOS_LRU_POLICY_TINYLFU keeps new entries in a small lru window, and lets one into the main lru only if its lookups
+// are more frequent than those of the entry it evicts, so that a scan of cold entries can not flush the hot ones
+typedef enum { TAOS_LRU_POLICY_LRU, TAOS_LRU_POLICY_TINYLFU } LRUPolicy;
+
 typedef enum {
   TAOS_LRU_STATUS_OK,
   TAOS_LRU_STATUS_FAIL,
@@ -38,7 +42,16 @@ typedef enum {
   TAOS_LRU_STATUS_OK_OVERWRITTEN
 } LRUStatus;
 
+typedef struct {
+  int64_t hits;
+  int64_t misses;
+  int64_t evictions;   // entries evicted for capacity
+  int64_t rejections;  // new entries evicted by tinylfu instead of an entry of the main lru
+  size_t  windowUsage;  // charge of the unpinned entries in the admission window of tinylfu
+} SLRUCacheStats;
+
 SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio);
+SLRUCache *taosLRUCacheInitWithPolicy(size_t capacity, int numShardBits, double highPriPoolRatio, LRUPolicy policy);
 void       taosLRUCacheCleanup(SLRUCache *cache);
 
 LRUStatus  taosLRUCacheInsert(SLRUCache *cache, const void *key, size_t keyLen, void *value, size_t charge,
@@ -59,6 +72,8 @@ size_t taosLRUCacheGetPinnedUsage(SLRUCache *cache);
 
 int32_t taosLRUCacheGetElems(SLRUCache *cache);
 
+void taosLRUCacheGetStats(SLRUCache *cache, SLRUCacheStats *stats);
+
 void   taosLRUCacheSetCapacity(SLRUCache *cache, size_t capacity);
 size_t taosLRUCacheGetCapacity(SLRUCache *cache);
 
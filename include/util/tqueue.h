@@ -56,6 +56,14 @@ typedef enum {
   RPC_QITEM = 1,
 } EQItype;
 
+typedef enum {
+  QUEUE_MODE_MUTEX = 0,
+  // multi-producer single-consumer, the writers never block, and the consumer parks on a futex when all the queues
+  // in its qset are empty. Only one thread may read from the queue or the qset, and queues can only be added into
+  // a qset of the same mode
+  QUEUE_MODE_LOCK_FREE = 1,
+} EQueueMode;
+
 typedef void (*FItem)(SQueueInfo *pInfo, void *pItem);
 typedef void (*FItems)(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfItems);
 
@@ -73,6 +81,7 @@ struct STaosQnode {
 };
 
 STaosQueue *taosOpenQueue();
+STaosQueue *taosOpenQueueEx(EQueueMode mode);
 void        taosCloseQueue(STaosQueue *queue);
 void        taosSetQueueFp(STaosQueue *queue, FItem itemFp, FItems itemsFp);
 void       *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize);
@@ -97,6 +106,7 @@ int64_t    taosQallUnAccessedItemSize(STaosQall *qall);
 int64_t    taosQallUnAccessedMemSize(STaosQall *qall);
 
 STaosQset *taosOpenQset();
+STaosQset *taosOpenQsetEx(EQueueMode mode);
 void       taosCloseQset(STaosQset *qset);
 void       taosQsetThreadResume(STaosQset *qset);
 int32_t    taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle);
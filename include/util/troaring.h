@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_UTIL_ROARING_H_
+#define _TD_UTIL_ROARING_H_
+
+#include "os.h"
+#include "tarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * roaring bitmap of uint64 values, e.g. the table uids.
+ * The values are grouped by the high 48 bits, and the low 16 bits of each group are kept in a container, which is a
+ * sorted uint16 array if it has at most ROARING_ARRAY_MAX_SIZE values, or a bitmap of 65536 bits otherwise.
+ * The uids generated by tGenIdPI64 carry a serial number in the low 20 bits, so the uids of the tables created
+ * together fall into a few containers.
+ */
+#define ROARING_ARRAY_MAX_SIZE   4096
+#define ROARING_BITMAP_WORDS     1024  // 65536 bits
+
+typedef struct SRoaringContainer {
+  uint64_t key;     // the high 48 bits of the values
+  int32_t  num;     // number of the values
+  int32_t  cap;     // capacity of the array container, 0 for a bitmap container
+  void    *pData;   // uint16_t array, or uint64_t bitmap
+} SRoaringContainer;
+
+typedef struct SRoaringBitmap {
+  int32_t            size;
+  int32_t            cap;
+  int32_t            lastIdx;  // the container of the last added value
+  SRoaringContainer *pContainers;
+} SRoaringBitmap;
+
+SRoaringBitmap *tRoaringCreate();
+void            tRoaringDestroy(SRoaringBitmap *pBitmap);
+void            tRoaringClear(SRoaringBitmap *pBitmap);
+
+// tRoaringAdd is for the values added in ascending order mostly, and tRoaringAddBatch for those in any order
+int32_t tRoaringAdd(SRoaringBitmap *pBitmap, uint64_t val);
+int32_t tRoaringAddBatch(SRoaringBitmap *pBitmap, const uint64_t *pVals, int32_t num);
+bool    tRoaringContains(const SRoaringBitmap *pBitmap, uint64_t val);
+int64_t tRoaringCardinality(const SRoaringBitmap *pBitmap);
+
+/*
+ * in place set operations, the result is saved in pDst
+ */
+int32_t tRoaringAnd(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc);
+int32_t tRoaringOr(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc);
+int32_t tRoaringAndNot(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc);
+
+/*
+ * append the values to an array of uint64_t in ascending order
+ */
+int32_t tRoaringToArray(const SRoaringBitmap *pBitmap, SArray *pArray);
+
+int32_t         tRoaringGetEncodeSize(const SRoaringBitmap *pBitmap);
+int32_t         tRoaringEncode(const SRoaringBitmap *pBitmap, char *buf);
+SRoaringBitmap *tRoaringDecode(const char *buf, int32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_UTIL_ROARING_H_*/
@@ -32,6 +32,11 @@ typedef void (*_hash_free_fn_t)(void *);
  */
 typedef struct SSHashObj SSHashObj;
 
+typedef enum {
+  SHASH_TYPE_CHAINED = 0,  // buckets of chained nodes
+  SHASH_TYPE_OPEN_ADDR,    // open addressing, groups of control bytes probed with SIMD
+} ESHashType;
+
 /**
  * init the hash table
  *
@@ -41,6 +46,18 @@ typedef struct SSHashObj SSHashObj;
  */
 SSHashObj *tSimpleHashInit(size_t capacity, _hash_fn_t fn);
 
+/**
+ * init the hash table of the specified type. The open addressing table keeps the same semantics as the chained one:
+ * the returned payload pointers stay valid until the element is removed, and tSimpleHashGetKey works on them.
+ * However, the resize is done incrementally in the following put operations, so do not put elements during iterating.
+ *
+ * @param capacity    initial capacity of the hash table
+ * @param fn          hash function to generate the hash value
+ * @param type        hash table type
+ * @return
+ */
+SSHashObj *tSimpleHashInitEx(size_t capacity, _hash_fn_t fn, ESHashType type);
+
 /**
  * return the size of hash table
  * @param pHashObj
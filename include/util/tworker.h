@@ -63,6 +63,7 @@ struct SWWorkerPool {
   int32_t       max;  // max number of workers
   int32_t       num;
   int32_t       nextId;  // from 0 to max-1, cyclic
+  EQueueMode    queueMode;
   const char   *name;
   SWWorker     *workers;
   TdThreadMutex mutex;
@@ -102,6 +103,7 @@ typedef struct {
   int32_t     max;
   FItems      fp;
   void       *param;
+  EQueueMode  queueMode;
 } SMultiWorkerCfg;
 
 typedef struct {
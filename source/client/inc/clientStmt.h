@@ -177,6 +177,7 @@ int         stmtGetParam(TAOS_STMT *stmt, int idx, int *type, int *bytes);
 int         stmtAddBatch(TAOS_STMT *stmt);
 TAOS_RES   *stmtUseResult(TAOS_STMT *stmt);
 int         stmtBindBatch(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind, int32_t colIdx);
+int         stmtBindMultiTable(TAOS_STMT *stmt, TAOS_MULTI_BIND *tbnames, TAOS_MULTI_BIND *tags, TAOS_MULTI_BIND *bind);
 
 #ifdef __cplusplus
 }
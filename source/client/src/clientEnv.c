@@ -191,6 +191,7 @@ void *openTransporter(const char *user, const char *auth, int32_t numOfThread) {
   connLimitNum = TMIN(connLimitNum, 1000);
   rpcInit.connLimitNum = connLimitNum;
   rpcInit.timeToGetConn = tsTimeToGetAvailableConn;
+  rpcInit.muxWindow = tsRpcMuxWindow;
 
   taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
 
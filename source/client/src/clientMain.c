@@ -1713,6 +1713,37 @@ int taos_stmt_bind_single_param_batch(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind, in
   return stmtBindBatch(stmt, bind, colIdx);
 }
 
+int taos_stmt_bind_multi_table_batch(TAOS_STMT *stmt, TAOS_MULTI_BIND *tbnames, TAOS_MULTI_BIND *tags,
+                                     TAOS_MULTI_BIND *bind) {
+  if (stmt == NULL || tbnames == NULL || bind == NULL) {
+    tscError("NULL parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  if (tbnames->num <= 0 || tbnames->num > INT16_MAX) {
+    tscError("invalid bind num %d", tbnames->num);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  if (tbnames->buffer_type != TSDB_DATA_TYPE_BINARY) {
+    tscError("invalid table name buffer type %d", tbnames->buffer_type);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  int32_t insert = 0;
+  stmtIsInsert(stmt, &insert);
+  if (0 == insert) {
+    tscError("multi-table bind not available for none insert statement");
+    terrno = TSDB_CODE_TSC_STMT_API_ERROR;
+    return terrno;
+  }
+
+  return stmtBindMultiTable(stmt, tbnames, tags, bind);
+}
+
 int taos_stmt_add_batch(TAOS_STMT *stmt) {
   if (stmt == NULL) {
     tscError("NULL parameter for %s", __FUNCTION__);
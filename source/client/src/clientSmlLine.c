@@ -48,6 +48,36 @@
 #define BINARY_ADD_LEN (sizeof("\"\"")-1)    // "binary"   2 means length of ("")
 #define NCHAR_ADD_LEN  (sizeof("L\"\"")-1)   // L"nchar"   3 means length of (L"")
 
+// the characters with a meaning in the line protocol, the others are skipped in blocks when scanning a line
+static const uint8_t smlStructChar[256] = {[SPACE] = 1, [COMMA] = 1, [EQUAL] = 1, [QUOTE] = 1, [SLASH] = 1};
+
+// return the first structural character in [p, end), or end
+static FORCE_INLINE char *smlSkipPlainChars(char *p, char *end) {
+#if __AVX2__
+  if (tsSIMDEnable && tsAVX2Enable) {
+    const __m256i space = _mm256_set1_epi8(SPACE);
+    const __m256i comma = _mm256_set1_epi8(COMMA);
+    const __m256i equal = _mm256_set1_epi8(EQUAL);
+    const __m256i quote = _mm256_set1_epi8(QUOTE);
+    const __m256i slash = _mm256_set1_epi8(SLASH);
+    while (end - p >= 32) {
+      __m256i  v = _mm256_loadu_si256((const __m256i *)p);
+      __m256i  m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, comma)),
+                                   _mm256_or_si256(_mm256_cmpeq_epi8(v, equal), _mm256_cmpeq_epi8(v, quote)));
+      uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(m, _mm256_cmpeq_epi8(v, slash)));
+      if (mask != 0) {
+        return p + __builtin_ctz(mask);
+      }
+      p += 32;
+    }
+  }
+#endif
+  while (p < end && !smlStructChar[(uint8_t)*p]) {
+    p++;
+  }
+  return p;
+}
+
 uint8_t smlPrecisionConvert[] = {TSDB_TIME_PRECISION_NANO,    TSDB_TIME_PRECISION_HOURS, TSDB_TIME_PRECISION_MINUTES,
                                   TSDB_TIME_PRECISION_SECONDS, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MICRO,
                                   TSDB_TIME_PRECISION_NANO};
@@ -210,6 +240,10 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     const char *escapeChar = NULL;
 
     while (*sql < sqlEnd) {
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         terrno = TSDB_CODE_SML_INVALID_DATA;
@@ -241,6 +275,10 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     size_t      valueLenEscaped = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         break;
       } else if (unlikely(IS_EQUAL(*sql,escapeChar))) {
@@ -341,6 +379,10 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     size_t      keyLenEscaped = 0;
     const char *escapeChar = NULL;
     while (*sql < sqlEnd) {
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -371,6 +413,10 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     int         quoteNum = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(*(*sql) == QUOTE && (*(*sql - 1) != SLASH || (*sql - 1) == escapeChar))) {
         quoteNum++;
         (*sql)++;
@@ -460,6 +506,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   size_t measureLenEscaped = 0;
   const char *escapeChar = NULL;
   while (sql < sqlEnd) {
+    sql = smlSkipPlainChars(sql, sqlEnd);
+    if (sql >= sqlEnd) {
+      break;
+    }
     if (unlikely(IS_COMMA(sql,escapeChar) || IS_SPACE(sql,escapeChar))) {
       break;
     }
@@ -482,6 +532,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // to get measureTagsLen before
   const char *tmp = sql;
   while (tmp < sqlEnd) {
+    tmp = smlSkipPlainChars((char *)tmp, sqlEnd);
+    if (tmp >= sqlEnd) {
+      break;
+    }
     if (unlikely(IS_SPACE(tmp,escapeChar))) {
       break;
     }
@@ -795,6 +795,476 @@ int stmtAddBatch(TAOS_STMT* stmt) {
   return TSDB_CODE_SUCCESS;
 }
 
+typedef struct SStmtTbGroup {
+  int32_t        firstRow;
+  int32_t        lastRow;
+  int32_t        numOfRows;
+  int32_t        offset;  // start of the rows of the table in the row list
+  int32_t        vgId;    // 0 until it is got from the catalog
+  uint64_t       uid;
+  uint64_t       suid;
+  uint64_t       cacheUid;   // key of the cached data context which the one of the table is built from
+  SName          sname;
+  STableDataCxt* pBlock;     // data context of the table in the exec block hash
+  void*          boundTags;  // set when the tags are to be bound, only for the table new to this execution
+} SStmtTbGroup;
+
+static int32_t stmtGetBindTbName(TAOS_MULTI_BIND* tbnames, int32_t row, char** pName, int32_t* pLen) {
+  if (tbnames->is_null && tbnames->is_null[row]) {
+    return TSDB_CODE_TSC_STMT_TBNAME_ERROR;
+  }
+
+  char*   name = (char*)tbnames->buffer + (int64_t)row * tbnames->buffer_length;
+  int32_t len = tbnames->length ? tbnames->length[row] : strnlen(name, tbnames->buffer_length);
+  if (len <= 0 || len >= TSDB_TABLE_FNAME_LEN || len > (int64_t)tbnames->buffer_length) {
+    return TSDB_CODE_TSC_STMT_TBNAME_ERROR;
+  }
+
+  *pName = name;
+  *pLen = len;
+  return TSDB_CODE_SUCCESS;
+}
+
+// group the rows by table in one pass, the tables are kept in the order of their first row
+static int32_t stmtGroupRowsByTable(TAOS_MULTI_BIND* tbnames, SArray* pGroups, int32_t* pRows) {
+  int32_t   code = TSDB_CODE_SUCCESS;
+  int32_t   num = tbnames->num;
+  int32_t*  pRowGroup = taosMemoryMalloc(num * sizeof(int32_t));
+  SHashObj* pNameHash = taosHashInit(num, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  if (NULL == pRowGroup || NULL == pNameHash) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _return;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    char*   name = NULL;
+    int32_t len = 0;
+    code = stmtGetBindTbName(tbnames, i, &name, &len);
+    if (code) {
+      tscError("invalid table name in row %d", i);
+      goto _return;
+    }
+
+    int32_t* pIdx = taosHashGet(pNameHash, name, len);
+    if (pIdx) {
+      SStmtTbGroup* pGroup = taosArrayGet(pGroups, *pIdx);
+      pGroup->lastRow = i;
+      pGroup->numOfRows++;
+      pRowGroup[i] = *pIdx;
+      continue;
+    }
+
+    int32_t      idx = taosArrayGetSize(pGroups);
+    SStmtTbGroup group = {.firstRow = i, .lastRow = i, .numOfRows = 1};
+    if (NULL == taosArrayPush(pGroups, &group) || taosHashPut(pNameHash, name, len, &idx, sizeof(idx))) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _return;
+    }
+    pRowGroup[i] = idx;
+  }
+
+  int32_t offset = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pGroups); ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+    pGroup->offset = offset;
+    offset += pGroup->numOfRows;
+    pGroup->numOfRows = 0;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, pRowGroup[i]);
+    pRows[pGroup->offset + pGroup->numOfRows++] = i;
+  }
+
+_return:
+  taosMemoryFree(pRowGroup);
+  taosHashCleanup(pNameHash);
+  return code;
+}
+
+static void stmtSliceBind(TAOS_MULTI_BIND* pSrc, int32_t start, int32_t num, TAOS_MULTI_BIND* pDst) {
+  *pDst = *pSrc;
+  pDst->buffer = pSrc->buffer ? (char*)pSrc->buffer + (int64_t)start * pSrc->buffer_length : NULL;
+  pDst->length = pSrc->length ? pSrc->length + start : NULL;
+  pDst->is_null = pSrc->is_null ? pSrc->is_null + start : NULL;
+  pDst->num = num;
+}
+
+// pDst already holds the buffers for num rows, which are kept
+static void stmtGatherBind(TAOS_MULTI_BIND* pSrc, const int32_t* pRows, int32_t num, TAOS_MULTI_BIND* pDst) {
+  pDst->buffer_type = pSrc->buffer_type;
+  pDst->buffer_length = pSrc->buffer_length;
+  pDst->num = num;
+
+  for (int32_t i = 0; i < num; ++i) {
+    int32_t row = pRows[i];
+    if (pSrc->buffer) {
+      memcpy((char*)pDst->buffer + (int64_t)i * pSrc->buffer_length,
+             (char*)pSrc->buffer + (int64_t)row * pSrc->buffer_length, pSrc->buffer_length);
+    }
+    if (pSrc->length) {
+      pDst->length[i] = pSrc->length[row];
+    }
+    if (pSrc->is_null) {
+      pDst->is_null[i] = pSrc->is_null[row];
+    }
+  }
+
+  if (NULL == pSrc->length) {
+    pDst->length = NULL;
+  }
+  if (NULL == pSrc->is_null) {
+    pDst->is_null = NULL;
+  }
+}
+
+static char* stmtAllocGatherBuf(TAOS_MULTI_BIND* bind, int32_t numOfCols, int32_t maxRows, TAOS_MULTI_BIND* pGather) {
+  int64_t size = 0;
+  for (int32_t c = 0; c < numOfCols; ++c) {
+    size += (int64_t)maxRows * (bind[c].buffer_length + sizeof(int32_t) + sizeof(char));
+  }
+
+  char* pBuf = taosMemoryMalloc(size);
+  if (NULL == pBuf) {
+    return NULL;
+  }
+
+  char* p = pBuf;
+  for (int32_t c = 0; c < numOfCols; ++c) {
+    pGather[c].length = (int32_t*)p;
+    p += (int64_t)maxRows * sizeof(int32_t);
+    pGather[c].buffer = p;
+    p += (int64_t)maxRows * bind[c].buffer_length;
+    pGather[c].is_null = p;
+    p += maxRows;
+  }
+
+  return pBuf;
+}
+
+static int32_t stmtCheckBindRows(TAOS_MULTI_BIND* bind, int32_t numOfBind, int32_t num, const char* type) {
+  for (int32_t i = 0; i < numOfBind; ++i) {
+    if (bind[i].num != num) {
+      tscError("row number %d of %s %d not equal to table name rows %d", bind[i].num, type, i, num);
+      return TSDB_CODE_INVALID_PARA;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// find the data context of the table in this execution, or the cached one to build it from. Only the table which has
+// neither goes through stmtSetTbName to be parsed, and its data context is cached for the other tables.
+static int32_t stmtResolveTbGroup(STscStmt* pStmt, SRequestConnInfo* pConn, TAOS_MULTI_BIND* tbnames,
+                                  SStmtTbGroup* pGroup) {
+  char    tbName[TSDB_TABLE_FNAME_LEN];
+  char    tbFName[TSDB_TABLE_FNAME_LEN];
+  char*   name = NULL;
+  int32_t len = 0;
+
+  STMT_ERR_RET(stmtGetBindTbName(tbnames, pGroup->firstRow, &name, &len));
+  memcpy(tbName, name, len);
+  tbName[len] = 0;
+
+  STMT_ERR_RET(qCreateSName(&pGroup->sname, tbName, pStmt->taos->acctId, pStmt->exec.pRequest->pDb,
+                            pStmt->exec.pRequest->msgBuf, pStmt->exec.pRequest->msgBufLen));
+  tNameExtractFullName(&pGroup->sname, tbFName);
+
+  STableDataCxt** pCxtInExec = taosHashGet(pStmt->exec.pBlockHash, tbFName, strlen(tbFName));
+  if (pCxtInExec) {
+    pGroup->pBlock = *pCxtInExec;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pStmt->sql.pTableCache && taosHashGetSize(pStmt->sql.pTableCache) > 0) {
+    if (pStmt->sql.autoCreateTbl) {
+      pGroup->uid = 0;
+      pGroup->suid = pStmt->bInfo.tbSuid;
+      pGroup->cacheUid = pStmt->bInfo.tbSuid;
+    } else {
+      STableMeta* pTableMeta = NULL;
+      int32_t     code = catalogGetTableMeta(pStmt->pCatalog, pConn, &pGroup->sname, &pTableMeta);
+      if (TSDB_CODE_PAR_TABLE_NOT_EXIST == code) {
+        tscError("tb %s not exist", tbFName);
+      }
+      STMT_ERR_RET(code);
+
+      pGroup->uid = pTableMeta->uid;
+      pGroup->suid = pTableMeta->suid;
+      pGroup->cacheUid = (TSDB_CHILD_TABLE == pTableMeta->tableType) ? pTableMeta->suid : pTableMeta->uid;
+      taosMemoryFree(pTableMeta);
+    }
+
+    if (taosHashGet(pStmt->sql.pTableCache, &pGroup->cacheUid, sizeof(pGroup->cacheUid))) {
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  STMT_ERR_RET(stmtSetTbName(pStmt, tbName));
+
+  pCxtInExec = taosHashGet(pStmt->exec.pBlockHash, pStmt->bInfo.tbFName, strlen(pStmt->bInfo.tbFName));
+  if (NULL == pCxtInExec) {
+    tscError("table %s not found in exec blockHash", pStmt->bInfo.tbFName);
+    STMT_ERR_RET(TSDB_CODE_TSC_STMT_CACHE_ERROR);
+  }
+
+  pGroup->pBlock = *pCxtInExec;
+  pGroup->suid = pStmt->bInfo.tbSuid;
+  pGroup->boundTags = pStmt->bInfo.inExecCache ? NULL : pStmt->bInfo.boundTags;
+
+  // the bound tags are owned by the cache from now on
+  STMT_ERR_RET(stmtCacheBlock(pStmt));
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// build the data contexts of the tables new to this execution from the cached ones, the vgroups of the tables are got
+// in one batch when they are in the same db
+static int32_t stmtBuildTbGroupBlocks(STscStmt* pStmt, SRequestConnInfo* pConn, SArray* pGroups) {
+  int32_t       code = TSDB_CODE_SUCCESS;
+  int32_t       numOfGroups = taosArrayGetSize(pGroups);
+  int32_t       numOfNew = 0;
+  bool          sameDb = true;
+  SStmtTbGroup* pFirst = NULL;
+  const char**  pTbNames = NULL;
+  int32_t*      pVgIds = NULL;
+
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+    if (pGroup->pBlock) {
+      continue;
+    }
+
+    if (NULL == pFirst) {
+      pFirst = pGroup;
+    } else if (0 != strcmp(pGroup->sname.dbname, pFirst->sname.dbname)) {
+      sameDb = false;
+    }
+    ++numOfNew;
+  }
+
+  if (numOfNew > 1 && sameDb) {
+    pTbNames = taosMemoryMalloc(numOfNew * POINTER_BYTES);
+    pVgIds = taosMemoryMalloc(numOfNew * sizeof(int32_t));
+    if (NULL == pTbNames || NULL == pVgIds) {
+      STMT_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    for (int32_t i = 0, n = 0; i < numOfGroups; ++i) {
+      SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+      if (NULL == pGroup->pBlock) {
+        pTbNames[n++] = pGroup->sname.tname;
+      }
+    }
+
+    STMT_ERR_JRET(catalogGetTablesHashVgId(pStmt->pCatalog, pConn, pFirst->sname.acctId, pFirst->sname.dbname,
+                                           pTbNames, numOfNew, pVgIds));
+
+    for (int32_t i = 0, n = 0; i < numOfGroups; ++i) {
+      SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+      if (NULL == pGroup->pBlock) {
+        pGroup->vgId = pVgIds[n++];
+      }
+    }
+  }
+
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+    if (pGroup->pBlock) {
+      continue;
+    }
+
+    // the vgroup info is only got for the vgroup not in this statement yet
+    if (pGroup->vgId <= 0 || NULL == taosHashGet(pStmt->sql.pVgHash, &pGroup->vgId, sizeof(pGroup->vgId))) {
+      SVgroupInfo vgInfo = {0};
+      STMT_ERR_JRET(catalogGetTableHashVgroup(pStmt->pCatalog, pConn, &pGroup->sname, &vgInfo));
+      if (taosHashPut(pStmt->sql.pVgHash, (const char*)&vgInfo.vgId, sizeof(vgInfo.vgId), (char*)&vgInfo,
+                      sizeof(vgInfo))) {
+        STMT_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+      }
+      pGroup->vgId = vgInfo.vgId;
+    }
+
+    SStmtTableCache* pCache = taosHashGet(pStmt->sql.pTableCache, &pGroup->cacheUid, sizeof(pGroup->cacheUid));
+    if (NULL == pCache) {
+      tscError("table %s not found in sql blockHash, cacheUid:%" PRIx64, pGroup->sname.tname, pGroup->cacheUid);
+      STMT_ERR_JRET(TSDB_CODE_TSC_STMT_CACHE_ERROR);
+    }
+
+    STableDataCxt* pNewBlock = NULL;
+    char           tbFName[TSDB_TABLE_FNAME_LEN];
+    tNameExtractFullName(&pGroup->sname, tbFName);
+
+    code = qRebuildStmtDataBlock(&pNewBlock, pCache->pDataCtx, pGroup->uid, pGroup->suid, pGroup->vgId,
+                                 pStmt->sql.autoCreateTbl);
+    if (TSDB_CODE_SUCCESS == code &&
+        taosHashPut(pStmt->exec.pBlockHash, tbFName, strlen(tbFName), &pNewBlock, POINTER_BYTES)) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    }
+    if (code) {
+      qDestroyStmtDataBlock(pNewBlock);
+      STMT_ERR_JRET(code);
+    }
+
+    pGroup->pBlock = pNewBlock;
+    pGroup->boundTags = pCache->boundTags;
+  }
+
+  STMT_DLOG("tableDataCxt of %d tables rebuilt", numOfNew);
+
+_return:
+
+  taosMemoryFree(pTbNames);
+  taosMemoryFree(pVgIds);
+
+  return code;
+}
+
+// the rows of each table are bound to its data context in one pass, the data contexts of the tables new to this
+// execution are found or built before any row is bound
+int stmtBindMultiTable(TAOS_STMT* stmt, TAOS_MULTI_BIND* tbnames, TAOS_MULTI_BIND* tags, TAOS_MULTI_BIND* bind) {
+  STscStmt*        pStmt = (STscStmt*)stmt;
+  int32_t          code = 0;
+  int32_t          num = tbnames->num;
+  int32_t*         pRows = NULL;
+  SArray*          pGroups = NULL;
+  TAOS_MULTI_BIND* pTagBind = NULL;
+  TAOS_MULTI_BIND* pColBind = NULL;
+  TAOS_MULTI_BIND* pGather = NULL;
+  char*            pGatherBuf = NULL;
+  int32_t          numOfGroups = 0;
+  int32_t          numOfCols = 0;
+  int32_t          numOfTags = 0;
+  int32_t          maxGatherRows = 0;
+
+  STMT_DLOG("start to bind %d rows of multiple tables", num);
+
+  STMT_ERR_RET(stmtSwitchStatus(pStmt, STMT_SETTBNAME));
+
+  // checked before any table is resolved, the type is not known until the sql is parsed for the first table
+  if (pStmt->sql.type ? (STMT_TYPE_MULTI_INSERT != pStmt->sql.type)
+                      : !qIsInsertTbNameInPlaceholder(pStmt->sql.sqlStr, pStmt->sql.sqlLen)) {
+    tscError("table names can only be bound for the statement with the table name in placeholder");
+    STMT_ERR_RET(TSDB_CODE_TSC_STMT_API_ERROR);
+  }
+  STMT_ERR_RET(stmtCreateRequest(pStmt));
+
+  if (NULL == pStmt->pCatalog) {
+    STMT_ERR_RET(catalogGetHandle(pStmt->taos->pAppInfo->clusterId, &pStmt->pCatalog));
+  }
+
+  SRequestConnInfo conn = {.pTrans = pStmt->taos->pAppInfo->pTransporter,
+                           .requestId = pStmt->exec.pRequest->requestId,
+                           .requestObjRefId = pStmt->exec.pRequest->self,
+                           .mgmtEps = getEpSet_s(&pStmt->taos->pAppInfo->mgmtEp)};
+
+  pRows = taosMemoryMalloc(num * sizeof(int32_t));
+  pGroups = taosArrayInit(64, sizeof(SStmtTbGroup));
+  if (NULL == pRows || NULL == pGroups) {
+    STMT_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  STMT_ERR_JRET(stmtGroupRowsByTable(tbnames, pGroups, pRows));
+
+  numOfGroups = taosArrayGetSize(pGroups);
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    STMT_ERR_JRET(stmtResolveTbGroup(pStmt, &conn, tbnames, taosArrayGet(pGroups, i)));
+  }
+
+  STMT_ERR_JRET(stmtBuildTbGroupBlocks(pStmt, &conn, pGroups));
+
+  // the bound columns and tags are the same for all tables of the statement
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+    if (0 == i) {
+      numOfCols = pGroup->pBlock->boundColsInfo.numOfBound;
+      STMT_ERR_JRET(stmtCheckBindRows(bind, numOfCols, num, "column"));
+    }
+    if (tags && pGroup->boundTags && 0 == numOfTags) {
+      numOfTags = ((SBoundColInfo*)pGroup->boundTags)->numOfBound;
+      STMT_ERR_JRET(stmtCheckBindRows(tags, numOfTags, num, "tag"));
+    }
+    // the rows of a table which are not adjacent in the batch are gathered into one buffer
+    if (pGroup->lastRow - pGroup->firstRow + 1 != pGroup->numOfRows) {
+      maxGatherRows = TMAX(maxGatherRows, pGroup->numOfRows);
+    }
+  }
+
+  pColBind = taosMemoryCalloc(TMAX(numOfCols, 1), sizeof(TAOS_MULTI_BIND));
+  pGather = taosMemoryCalloc(TMAX(numOfCols, 1), sizeof(TAOS_MULTI_BIND));
+  pTagBind = taosMemoryCalloc(TMAX(numOfTags, 1), sizeof(TAOS_MULTI_BIND));
+  if (NULL == pColBind || NULL == pGather || NULL == pTagBind) {
+    STMT_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+  }
+  if (maxGatherRows > 0) {
+    pGatherBuf = stmtAllocGatherBuf(bind, numOfCols, maxGatherRows, pGather);
+    if (NULL == pGatherBuf) {
+      STMT_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
+    }
+  }
+
+  STMT_ERR_JRET(stmtSwitchStatus(pStmt, STMT_BIND));
+
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SStmtTbGroup* pGroup = taosArrayGet(pGroups, i);
+
+    // tags are only bound for the tables to be created, and only the first row of each table is used
+    if (tags && pGroup->boundTags) {
+      for (int32_t t = 0; t < numOfTags; ++t) {
+        stmtSliceBind(tags + t, pGroup->firstRow, 1, pTagBind + t);
+      }
+      STMT_ERR_JRET(qBindStmtTagsValue(pGroup->pBlock, pGroup->boundTags, pGroup->suid, pStmt->bInfo.stbFName,
+                                       pGroup->sname.tname, pTagBind, pStmt->exec.pRequest->msgBuf,
+                                       pStmt->exec.pRequest->msgBufLen));
+    }
+
+    if (pGroup->lastRow - pGroup->firstRow + 1 == pGroup->numOfRows) {
+      for (int32_t c = 0; c < numOfCols; ++c) {
+        stmtSliceBind(bind + c, pGroup->firstRow, pGroup->numOfRows, pColBind + c);
+      }
+    } else {
+      for (int32_t c = 0; c < numOfCols; ++c) {
+        TAOS_MULTI_BIND* pDst = pColBind + c;
+        *pDst = pGather[c];
+        stmtGatherBind(bind + c, pRows + pGroup->offset, pGroup->numOfRows, pDst);
+      }
+    }
+
+    code = qBindStmtColsValue(pGroup->pBlock, pColBind, pStmt->exec.pRequest->msgBuf, pStmt->exec.pRequest->msgBufLen);
+    if (code) {
+      tscError("qBindStmtColsValue failed, error:%s", tstrerror(code));
+      STMT_ERR_JRET(code);
+    }
+  }
+
+  // the last table is the current one, as if it were set by stmtSetTbName
+  SStmtTbGroup* pLast = taosArrayGetLast(pGroups);
+  STableMeta*   pMeta = qGetTableMetaInDataBlock(pLast->pBlock);
+  memcpy(&pStmt->bInfo.sname, &pLast->sname, sizeof(pLast->sname));
+  tNameExtractFullName(&pLast->sname, pStmt->bInfo.tbFName);
+  tstrncpy(pStmt->bInfo.tbName, pLast->sname.tname, sizeof(pStmt->bInfo.tbName));
+  pStmt->bInfo.tbUid = pStmt->sql.autoCreateTbl ? 0 : pMeta->uid;
+  pStmt->bInfo.tbSuid = pMeta->suid;
+  pStmt->bInfo.tbType = pMeta->tableType;
+  pStmt->bInfo.needParse = false;
+  pStmt->exec.pCurrBlock = pLast->pBlock;
+
+  STMT_ERR_JRET(stmtSwitchStatus(pStmt, STMT_ADD_BATCH));
+
+  STMT_DLOG("%d rows of %d tables bound", num, numOfGroups);
+
+_return:
+
+  taosMemoryFree(pRows);
+  taosArrayDestroy(pGroups);
+  taosMemoryFree(pTagBind);
+  taosMemoryFree(pColBind);
+  taosMemoryFree(pGather);
+  taosMemoryFree(pGatherBuf);
+
+  return code;
+}
+
 int stmtUpdateTableUid(STscStmt* pStmt, SSubmitRsp* pRsp) {
   tscDebug("stmt start to update tbUid, blockNum: %d", pRsp->nBlocks);
 
@@ -817,6 +817,99 @@ TEST(clientCase, insert_test) {
   taos_close(pConn);
 }
 
+TEST(clientCase, stmt_bind_multi_table_test) {
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  ASSERT_NE(pConn, nullptr);
+
+  const char* sqls[] = {"drop database if exists stmt_mt", "create database stmt_mt vgroups 2", "use stmt_mt",
+                        "create stable st (ts timestamp, v int) tags (t int)"};
+  for (int32_t i = 0; i < sizeof(sqls) / sizeof(sqls[0]); ++i) {
+    TAOS_RES* pRes = taos_query(pConn, sqls[i]);
+    ASSERT_EQ(taos_errno(pRes), 0) << sqls[i] << ": " << taos_errstr(pRes);
+    taos_free_result(pRes);
+  }
+
+  // the rows of three tables interleaved, the row i goes to the table ct(i % 3), which is created by the batch
+  const int32_t numOfTables = 3;
+  const int32_t numOfRows = 12;
+  const int32_t nameLen = 8;
+  char          names[numOfRows][nameLen] = {0};
+  int32_t       nameLens[numOfRows] = {0};
+  int32_t       tagVals[numOfRows] = {0};
+  int64_t       tsVals[numOfRows] = {0};
+  int32_t       vVals[numOfRows] = {0};
+  int64_t       ts = 1700000000000;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    nameLens[i] = snprintf(names[i], nameLen, "ct%d", i % numOfTables);
+    tagVals[i] = i % numOfTables;
+    tsVals[i] = ts + i;
+    vVals[i] = i;
+  }
+
+  TAOS_MULTI_BIND tbnames = {TSDB_DATA_TYPE_BINARY, names, nameLen, nameLens, NULL, numOfRows};
+  TAOS_MULTI_BIND tags = {TSDB_DATA_TYPE_INT, tagVals, sizeof(int32_t), NULL, NULL, numOfRows};
+  TAOS_MULTI_BIND cols[2] = {{TSDB_DATA_TYPE_TIMESTAMP, tsVals, sizeof(int64_t), NULL, NULL, numOfRows},
+                             {TSDB_DATA_TYPE_INT, vVals, sizeof(int32_t), NULL, NULL, numOfRows}};
+
+  // only the statement with the table name in placeholder binds the rows of many tables, and nothing is bound to
+  // the statement rejected
+  const char* rejected[] = {"insert into ct9 using st tags(9) values(?, ?)", "select * from st where v > ?"};
+  for (int32_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); ++i) {
+    TAOS_STMT* stmt = taos_stmt_init(pConn);
+    ASSERT_NE(stmt, nullptr);
+    ASSERT_EQ(taos_stmt_prepare(stmt, rejected[i], 0), 0);
+    ASSERT_EQ(taos_stmt_bind_multi_table_batch(stmt, &tbnames, &tags, cols), TSDB_CODE_TSC_STMT_API_ERROR)
+        << rejected[i];
+    taos_stmt_close(stmt);
+  }
+
+  TAOS_STMT* stmt = taos_stmt_init(pConn);
+  ASSERT_NE(stmt, nullptr);
+  ASSERT_EQ(taos_stmt_prepare(stmt, "insert into ? using st tags(?) values(?, ?)", 0), 0);
+  ASSERT_EQ(taos_stmt_bind_multi_table_batch(stmt, &tbnames, &tags, cols), 0) << taos_stmt_errstr(stmt);
+  ASSERT_EQ(taos_stmt_add_batch(stmt), 0);
+  ASSERT_EQ(taos_stmt_execute(stmt), 0) << taos_stmt_errstr(stmt);
+  ASSERT_EQ(taos_stmt_affected_rows(stmt), numOfRows);
+
+  // the tables already created take the rows of the next batch
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    tsVals[i] += numOfRows;
+    vVals[i] += numOfRows;
+  }
+  ASSERT_EQ(taos_stmt_bind_multi_table_batch(stmt, &tbnames, &tags, cols), 0) << taos_stmt_errstr(stmt);
+  ASSERT_EQ(taos_stmt_add_batch(stmt), 0);
+  ASSERT_EQ(taos_stmt_execute(stmt), 0) << taos_stmt_errstr(stmt);
+  ASSERT_EQ(taos_stmt_affected_rows(stmt), 2 * numOfRows);
+  taos_stmt_close(stmt);
+
+  TAOS_RES* pRes = taos_query(pConn, "select tbname, ts, v, t from st order by v");
+  ASSERT_EQ(taos_errno(pRes), 0) << taos_errstr(pRes);
+
+  int32_t  n = 0;
+  TAOS_ROW pRow = NULL;
+  while ((pRow = taos_fetch_row(pRes)) != NULL) {
+    int32_t* lengths = taos_fetch_lengths(pRes);
+    char     expect[nameLen] = {0};
+    snprintf(expect, nameLen, "ct%d", n % numOfTables);
+    ASSERT_EQ(std::string((char*)pRow[0], lengths[0]), expect);
+    ASSERT_EQ(*(int64_t*)pRow[1], ts + n);
+    ASSERT_EQ(*(int32_t*)pRow[2], n);
+    ASSERT_EQ(*(int32_t*)pRow[3], n % numOfTables);
+    ++n;
+  }
+  ASSERT_EQ(n, 2 * numOfRows);
+  taos_free_result(pRes);
+
+  pRes = taos_query(pConn, "select count(*) from information_schema.ins_tables where db_name = 'stmt_mt'");
+  ASSERT_EQ(taos_errno(pRes), 0) << taos_errstr(pRes);
+  pRow = taos_fetch_row(pRes);
+  ASSERT_NE(pRow, nullptr);
+  ASSERT_EQ(*(int64_t*)pRow[0], numOfTables);
+  taos_free_result(pRes);
+
+  taos_close(pConn);
+}
+
 TEST(clientCase, projection_query_tables) {
   TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
   ASSERT_NE(pConn, nullptr);
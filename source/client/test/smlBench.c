@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clientSml.h"
+
+// lines/s of smlParseInfluxString on telegraf shaped line protocol, with the scalar and the SIMD scanning
+typedef struct {
+  const char *name;
+  int32_t     numOfTables;
+} SBenchCorpus;
+
+static const SBenchCorpus benchCorpus[] = {
+    {"cpu", 64},        // short tags, float fields
+    {"disk", 256},      // long tag values with escaped spaces
+    {"net", 1024},      // many integer fields
+    {"syslog", 128},    // long quoted string fields with escapes
+    {"mixed", 10000},   // all of the above, one table per line
+};
+
+static const char *modeName[] = {"scalar", "avx2"};
+
+static uint32_t benchRand(uint32_t *seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 1) & 0x7fffffff;
+}
+
+static int32_t genBenchLine(const char *corpus, int32_t numOfTables, int32_t row, uint32_t *seed, char *buf) {
+  int32_t t = benchRand(seed) % numOfTables;
+  int64_t ts = 1700000000000000000LL + (int64_t)row * 1000000;
+
+  if (strcmp(corpus, "mixed") == 0) {
+    corpus = benchCorpus[row % (tListLen(benchCorpus) - 1)].name;
+  }
+
+  if (strcmp(corpus, "cpu") == 0) {
+    return sprintf(buf,
+                   "cpu,cpu=cpu%d,host=server%04d,region=us-west-2,datacenter=us-west-2a usage_user=%.2f,"
+                   "usage_system=%.2f,usage_idle=%.2f,usage_iowait=%.2f %" PRId64,
+                   t % 8, t, (benchRand(seed) % 10000) / 100.0, (benchRand(seed) % 10000) / 100.0,
+                   (benchRand(seed) % 10000) / 100.0, (benchRand(seed) % 10000) / 100.0, ts);
+  } else if (strcmp(corpus, "disk") == 0) {
+    return sprintf(buf,
+                   "disk,device=nvme0n1p%d,fstype=ext4,host=server%04d,mode=rw,path=/var/lib/docker/overlay2/"
+                   "volume\\ %08x/merged total=%ui,free=%ui,used=%ui,used_percent=%.3f,inodes_free=%ui %" PRId64,
+                   t % 4, t, t * 2654435761u, benchRand(seed), benchRand(seed), benchRand(seed),
+                   (benchRand(seed) % 100000) / 1000.0, benchRand(seed), ts);
+  } else if (strcmp(corpus, "net") == 0) {
+    return sprintf(buf,
+                   "net,host=server%04d,interface=eth%d bytes_sent=%ui,bytes_recv=%ui,packets_sent=%ui,"
+                   "packets_recv=%ui,err_in=%ui,err_out=%ui,drop_in=%ui,drop_out=%ui %" PRId64,
+                   t, t % 4, benchRand(seed), benchRand(seed), benchRand(seed), benchRand(seed),
+                   benchRand(seed) % 10, benchRand(seed) % 10, benchRand(seed) % 10, benchRand(seed) % 10, ts);
+  } else {
+    return sprintf(buf,
+                   "syslog,appname=sshd,facility=auth,host=server%04d,severity=info "
+                   "message=\"Accepted publickey for deploy from 10.0.%d.%d port %d ssh2: RSA "
+                   "SHA256:\\\"%08x%08x\\\"\",procid=\"%d\",timestamp=%ui,version=1i %" PRId64,
+                   t, t % 256, benchRand(seed) % 256, 1024 + benchRand(seed) % 60000, benchRand(seed), benchRand(seed),
+                   benchRand(seed) % 65536, benchRand(seed), ts);
+  }
+}
+
+// parse all lines once, and return the time used in us
+static int64_t benchOnce(char *pCorpus, int32_t *pOffset, int32_t numOfLines, char *pWork, int32_t nCorpus) {
+  memcpy(pWork, pCorpus, nCorpus);
+
+  SSmlHandle *info = smlBuildSmlInfo(NULL);
+  if (info == NULL) return -1;
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->dataFormat = false;
+  info->lineNum = numOfLines;
+  info->lines = taosMemoryCalloc(numOfLines, sizeof(SSmlLineInfo));
+  if (info->lines == NULL) {
+    smlDestroyInfo(info);
+    return -1;
+  }
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    char *line = pWork + pOffset[i];
+    char *lineEnd = pWork + pOffset[i + 1] - 1;
+    if (smlParseInfluxString(info, line, lineEnd, info->lines + i) != TSDB_CODE_SUCCESS) {
+      printf("failed to parse line %d: %.*s\n", i, (int32_t)(lineEnd - line), line);
+      smlDestroyInfo(info);
+      return -1;
+    }
+  }
+  int64_t used = taosGetTimestampUs() - st;
+
+  smlDestroyInfo(info);
+  return used;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfLines = 100000;
+  int32_t loops = 5;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfLines = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      loops = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n]: number of lines in each corpus, default: %d\n", numOfLines);
+      printf("  [-l]: number of loops for each case, the best one is reported, default: %d\n", loops);
+      exit(0);
+    }
+  }
+
+  if (numOfLines <= 0 || loops <= 0) {
+    printf("invalid options, lines:%d loops:%d\n", numOfLines, loops);
+    return -1;
+  }
+
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+
+  // each line is shorter than 512 bytes, and is ended by a '\n' which is not passed to the parser
+  int64_t  nBuf = (int64_t)numOfLines * 512;
+  char    *pCorpus = taosMemoryMalloc(nBuf);
+  char    *pWork = taosMemoryMalloc(nBuf);
+  int32_t *pOffset = taosMemoryMalloc((numOfLines + 1) * sizeof(int32_t));
+  if (pCorpus == NULL || pWork == NULL || pOffset == NULL) {
+    printf("out of memory, lines:%d\n", numOfLines);
+    return -1;
+  }
+
+  // csv output
+  printf("corpus,mode,lines,bytes,lines_per_sec,mb_per_sec\n");
+  for (int32_t c = 0; c < tListLen(benchCorpus); ++c) {
+    uint32_t seed = 20240601;
+    int32_t  nCorpus = 0;
+    for (int32_t i = 0; i < numOfLines; ++i) {
+      pOffset[i] = nCorpus;
+      nCorpus += genBenchLine(benchCorpus[c].name, benchCorpus[c].numOfTables, i, &seed, pCorpus + nCorpus);
+      pCorpus[nCorpus++] = '\n';
+    }
+    pOffset[numOfLines] = nCorpus;
+
+    for (int32_t mode = 0; mode < tListLen(modeName); ++mode) {
+      tsSIMDEnable = (mode != 0);
+      tsAVX2Enable = (mode != 0) ? avx2 : 0;
+      if (mode != 0 && !avx2) continue;
+
+      int64_t best = INT64_MAX;
+      for (int32_t l = 0; l < loops; ++l) {
+        int64_t used = benchOnce(pCorpus, pOffset, numOfLines, pWork, nCorpus);
+        if (used < 0) return -1;
+        best = TMIN(best, used);
+      }
+
+      best = TMAX(best, 1);
+      printf("%s,%s,%d,%d,%.0f,%.2f\n", benchCorpus[c].name, modeName[mode], numOfLines, nCorpus,
+             numOfLines * 1000000.0 / best, ((double)nCorpus) / best);
+    }
+  }
+
+  taosMemoryFree(pCorpus);
+  taosMemoryFree(pWork);
+  taosMemoryFree(pOffset);
+  return 0;
+}
@@ -148,6 +148,76 @@ TEST(testCase, smlParseInfluxString_Test) {
 
 }
 
+TEST(testCase, smlParseInfluxString_simd_Test) {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+  char simdEnable = tsSIMDEnable, avx2Enable = tsAVX2Enable;
+
+  // tokens longer than one SIMD block, with the escapes and quotes on both sides of the block boundaries
+  const char *data[] = {
+      "measurement_name_longer_than_32_bytes\\,with\\ escapes,tag_key_longer_than_32_bytes_0123=tag_value_\\=_"
+      "longer_than_32_bytes c1=\"a string field, with spaces and \\\"quotes\\\" longer than 32\",c2=1i64 "
+      "1626006833639000000",
+      "st,t1=0123456789012345678901234567890\\ ,t2=01234567890123456789012345678901\\, "
+      "c_0123456789012345678901234567890=3.5f64,c2=\"0123456789012345678901234567890\\\\\" 1626006833639000000",
+      "st,t1=3 c1=\"0123456789012345678901234567890123456789 1626006833639000000",  // unbalanced quotes
+      "st,t1=01234567890123456789012345678901234567890=1 c1=1 1626006833639000000",  // equal in tag value
+  };
+
+  for (int32_t i = 0; i < sizeof(data) / sizeof(data[0]); ++i) {
+    SSmlLineInfo elements[2] = {0};
+    int32_t      ret[2] = {0};
+    char        *sql[2] = {0};
+    int32_t      len = strlen(data[i]);
+    for (int32_t mode = 0; mode < 2; ++mode) {
+      tsSIMDEnable = mode;
+      tsAVX2Enable = mode ? avx2 : 0;
+
+      SSmlHandle *info = smlBuildSmlInfo(NULL);
+      info->protocol = TSDB_SML_LINE_PROTOCOL;
+      info->dataFormat = false;
+      sql[mode] = (char *)taosMemoryCalloc(len + 1, 1);
+      memcpy(sql[mode], data[i], len);
+      ret[mode] = smlParseInfluxString(info, sql[mode], sql[mode] + len, &elements[mode]);
+      smlDestroyInfo(info);
+    }
+
+    ASSERT_EQ(ret[0], ret[1]) << data[i];
+    ASSERT_EQ(elements[0].measureLen, elements[1].measureLen);
+    ASSERT_EQ(elements[0].measureTagsLen, elements[1].measureTagsLen);
+    ASSERT_EQ(elements[0].tagsLen, elements[1].tagsLen);
+    ASSERT_EQ(elements[0].colsLen, elements[1].colsLen);
+    ASSERT_EQ(elements[0].timestampLen, elements[1].timestampLen);
+    ASSERT_EQ(taosArrayGetSize(elements[0].colArray), taosArrayGetSize(elements[1].colArray));
+    for (int32_t j = 0; j < taosArrayGetSize(elements[0].colArray); ++j) {
+      SSmlKv *kv0 = (SSmlKv *)taosArrayGet(elements[0].colArray, j);
+      SSmlKv *kv1 = (SSmlKv *)taosArrayGet(elements[1].colArray, j);
+      ASSERT_EQ(kv0->type, kv1->type);
+      ASSERT_EQ(kv0->keyLen, kv1->keyLen);
+      ASSERT_EQ(memcmp(kv0->key, kv1->key, kv0->keyLen), 0);
+      ASSERT_EQ(kv0->length, kv1->length);
+      if (IS_VAR_DATA_TYPE(kv0->type)) {
+        ASSERT_EQ(memcmp(kv0->value, kv1->value, kv0->length), 0);
+      } else {
+        ASSERT_EQ(kv0->i, kv1->i);
+      }
+    }
+    if (i < 2) {
+      ASSERT_EQ(ret[0], 0);
+    } else {
+      ASSERT_NE(ret[0], 0);
+    }
+
+    for (int32_t mode = 0; mode < 2; ++mode) {
+      taosArrayDestroyEx(elements[mode].colArray, freeSSmlKv);
+      taosMemoryFree(sql[mode]);
+    }
+  }
+
+  tsSIMDEnable = simdEnable;
+  tsAVX2Enable = avx2Enable;
+}
+
 TEST(testCase, smlParseCols_Error_Test) {
   const char *data[] = {"st,t=1 c=\"89sd 1626006833639000000",  // binary, nchar
                         "st,t=1 c=j\"89sd\" 1626006833639000000",
@@ -1349,6 +1349,18 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t blockDataReorderRows(SSDataBlock* pDataBlock, const int32_t* index) {
+  SColumnInfoData* pCols = createHelpColInfoData(pDataBlock);
+  if (pCols == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return terrno;
+  }
+
+  blockDataAssign(pCols, pDataBlock, index);
+  copyBackToBlock(pDataBlock, pCols);
+  return TSDB_CODE_SUCCESS;
+}
+
 void blockDataCleanup(SSDataBlock* pDataBlock) {
   blockDataEmpty(pDataBlock);
   SDataBlockInfo* pInfo = &pDataBlock->info;
@@ -2493,12 +2505,65 @@ int32_t buildCtbNameByGroupIdImpl(const char* stbFullName, uint64_t groupId, cha
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+/*
+ * In BLOCK_VERSION_3, the null bitmap (or the offsets) and the data of each column are stored as compressed parts:
+ * | cmprAlg sizeof(int8_t) | compressed length sizeof(int32_t) | compressed data |
+ * The part is compressed by the codec of its type, i.e. delta of delta for timestamps, delta and simple8b for
+ * integers, xor for floats, bit packing for bools and lz4 for strings and the null bitmap, and is kept as it is if
+ * that does not make it smaller. The column lengths in the head are those before compression.
+ */
+#define BLOCK_CMPR_PART_HEAD_SIZE (sizeof(int8_t) + sizeof(int32_t))
+
+static int32_t blockCompressPart(const void* input, int32_t size, int8_t type, char* output) {
+  SCompressInfo info = {.cmprAlg = NO_COMPRESSION, .dataType = type, .originalSize = size};
+  char*         pOut = output + BLOCK_CMPR_PART_HEAD_SIZE;
+
+  bool lossy = false;
+#ifdef TD_TSZ
+  // the results of a query are exact, whatever the lossy columns of the storage are
+  lossy = (type == TSDB_DATA_TYPE_FLOAT && lossyFloat) || (type == TSDB_DATA_TYPE_DOUBLE && lossyDouble);
+#endif
+  if (size > 0 && input != NULL && tDataTypes[type].compFunc != NULL && !lossy) {
+    info.cmprAlg = ONE_STAGE_COMP;
+    if (tCompressData((void*)input, &info, pOut, size + COMP_OVERFLOW_BYTES, NULL) != 0 ||
+        info.compressedSize >= size) {
+      info.cmprAlg = NO_COMPRESSION;
+    }
+  }
+
+  if (info.cmprAlg == NO_COMPRESSION) {
+    if (size > 0 && input != NULL) {
+      memcpy(pOut, input, size);
+    }
+    info.compressedSize = size;
+  }
+
+  *(int8_t*)output = info.cmprAlg;
+  *(int32_t*)(output + sizeof(int8_t)) = info.compressedSize;
+  return BLOCK_CMPR_PART_HEAD_SIZE + info.compressedSize;
+}
+
+static const char* blockDecompressPart(const char* input, int32_t size, int8_t type, char* output) {
+  SCompressInfo info = {.cmprAlg = *(int8_t*)input,
+                        .dataType = type,
+                        .originalSize = size,
+                        .compressedSize = *(int32_t*)(input + sizeof(int8_t))};
+  input += BLOCK_CMPR_PART_HEAD_SIZE;
+
+  if (size > 0 && tDecompressData((void*)input, &info, output, size, NULL) != 0) {
+    terrno = TSDB_CODE_COMPRESS_ERROR;
+    return NULL;
+  }
+
+  return input + info.compressedSize;
+}
+
+static int32_t blockEncodeImpl(const SSDataBlock* pBlock, char* data, int32_t numOfCols, bool compress) {
   int32_t dataLen = 0;
 
   // todo extract method
   int32_t* version = (int32_t*)data;
-  *version = BLOCK_VERSION_1;
+  *version = compress ? BLOCK_VERSION_3 : BLOCK_VERSION_1;
   data += sizeof(int32_t);
 
   int32_t* actualLen = (int32_t*)data;
@@ -2546,16 +2611,31 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
     size_t metaSize = 0;
     if (IS_VAR_DATA_TYPE(pColRes->info.type)) {
       metaSize = numOfRows * sizeof(int32_t);
-      memcpy(data, pColRes->varmeta.offset, metaSize);
+      if (compress) {
+        metaSize = blockCompressPart(pColRes->varmeta.offset, metaSize, TSDB_DATA_TYPE_INT, data);
+      } else {
+        memcpy(data, pColRes->varmeta.offset, metaSize);
+      }
     } else {
       metaSize = BitmapLen(numOfRows);
-      memcpy(data, pColRes->nullbitmap, metaSize);
+      if (compress) {
+        metaSize = blockCompressPart(pColRes->nullbitmap, metaSize, TSDB_DATA_TYPE_BINARY, data);
+      } else {
+        memcpy(data, pColRes->nullbitmap, metaSize);
+      }
     }
 
     data += metaSize;
     dataLen += metaSize;
 
     if (pColRes->reassigned && IS_VAR_DATA_TYPE(pColRes->info.type)) {
+      // the values are gathered row by row, and are not compressed
+      char* pPartHead = data;
+      if (compress) {
+        data += BLOCK_CMPR_PART_HEAD_SIZE;
+        dataLen += BLOCK_CMPR_PART_HEAD_SIZE;
+      }
+
       colSizes[col] = 0;
       for (int32_t row = 0; row < numOfRows; ++row) {
         char*   pColData = pColRes->pData + pColRes->varmeta.offset[row];
@@ -2570,6 +2650,16 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
         memmove(data, pColData, colSize);
         data += colSize;
       }
+
+      if (compress) {
+        *(int8_t*)pPartHead = NO_COMPRESSION;
+        *(int32_t*)(pPartHead + sizeof(int8_t)) = colSizes[col];
+      }
+    } else if (compress) {
+      colSizes[col] = colDataGetLength(pColRes, numOfRows);
+      int32_t len = blockCompressPart(pColRes->pData, colSizes[col], pColRes->info.type, data);
+      dataLen += len;
+      data += len;
     } else {
       colSizes[col] = colDataGetLength(pColRes, numOfRows);
       dataLen += colSizes[col];
@@ -2594,10 +2684,23 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
   return dataLen;
 }
 
+int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+  return blockEncodeImpl(pBlock, data, numOfCols, false);
+}
+
+int32_t blockCompressEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+  return blockEncodeImpl(pBlock, data, numOfCols, true);
+}
+
 const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
   const char* pStart = pData;
 
+  // a block of a format unknown here, e.g. from a newer node during a rolling upgrade, can not be read at all
   int32_t version = *(int32_t*)pStart;
+  if (version != BLOCK_VERSION_1 && version != BLOCK_VERSION_3) {
+    terrno = TSDB_CODE_INVALID_MSG;
+    return NULL;
+  }
   pStart += sizeof(int32_t);
 
   // total length sizeof(int32_t)
@@ -2649,8 +2752,16 @@ const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
 
     SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, i);
     if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
-      memcpy(pColInfoData->varmeta.offset, pStart, sizeof(int32_t) * numOfRows);
-      pStart += sizeof(int32_t) * numOfRows;
+      if (version == BLOCK_VERSION_3) {
+        pStart = blockDecompressPart(pStart, sizeof(int32_t) * numOfRows, TSDB_DATA_TYPE_INT,
+                                     (char*)pColInfoData->varmeta.offset);
+        if (pStart == NULL) {
+          return NULL;
+        }
+      } else {
+        memcpy(pColInfoData->varmeta.offset, pStart, sizeof(int32_t) * numOfRows);
+        pStart += sizeof(int32_t) * numOfRows;
+      }
 
       if (colLen[i] > 0 && pColInfoData->varmeta.allocLen < colLen[i]) {
         char* tmp = taosMemoryRealloc(pColInfoData->pData, colLen[i]);
@@ -2663,19 +2774,32 @@ const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
       }
 
       pColInfoData->varmeta.length = colLen[i];
+    } else if (version == BLOCK_VERSION_3) {
+      pStart = blockDecompressPart(pStart, BitmapLen(numOfRows), TSDB_DATA_TYPE_BINARY, pColInfoData->nullbitmap);
+      if (pStart == NULL) {
+        return NULL;
+      }
     } else {
       memcpy(pColInfoData->nullbitmap, pStart, BitmapLen(numOfRows));
       pStart += BitmapLen(numOfRows);
     }
 
-    if (colLen[i] > 0) {
-      memcpy(pColInfoData->pData, pStart, colLen[i]);
-    }
-
     // TODO
     // setting this flag to true temporarily so aggregate function on stable will
     // examine NULL value for non-primary key column
     pColInfoData->hasNull = true;
+
+    if (version == BLOCK_VERSION_3) {
+      pStart = blockDecompressPart(pStart, colLen[i], pColInfoData->info.type, pColInfoData->pData);
+      if (pStart == NULL) {
+        return NULL;
+      }
+      continue;
+    }
+
+    if (colLen[i] > 0) {
+      memcpy(pColInfoData->pData, pStart, colLen[i]);
+    }
     pStart += colLen[i];
   }
 
@@ -2854,6 +2978,13 @@ int32_t blockGetEncodeSize(const SSDataBlock* pBlock) {
   return blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock)) + blockDataGetSize(pBlock);
 }
 
+// the parts of a column are never larger than they are in BLOCK_VERSION_1, and the last one may overflow a little
+// while it is compressed
+int32_t blockGetCompressEncodeSize(const SSDataBlock* pBlock) {
+  return blockGetEncodeSize(pBlock) +
+         taosArrayGetSize(pBlock->pDataBlock) * 2 * BLOCK_CMPR_PART_HEAD_SIZE + COMP_OVERFLOW_BYTES;
+}
+
 int32_t blockDataGetSortedRows(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   if (!pDataBlock || !pOrderInfo) return 0;
   for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
@@ -408,6 +408,106 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+TEST(testCase, compress_dataBlock_encode_test) {
+  int32_t numOfRows = 4096;
+
+  SSDataBlock* b = createDataBlock();
+
+  int8_t types[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT,    TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_DOUBLE,
+                    TSDB_DATA_TYPE_FLOAT,     TSDB_DATA_TYPE_BOOL,   TSDB_DATA_TYPE_BINARY, TSDB_DATA_TYPE_NCHAR};
+  for (int32_t i = 0; i < tListLen(types); ++i) {
+    int32_t         bytes = IS_VAR_DATA_TYPE(types[i]) ? 40 : tDataTypes[types[i]].bytes;
+    SColumnInfoData infoData = createColumnInfoData(types[i], bytes, i + 1);
+    blockDataAppendColInfo(b, &infoData);
+  }
+
+  blockDataEnsureCapacity(b, numOfRows);
+
+  char buf[41] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t ts = 1700000000000 + i * 1000;
+    int64_t v = i % 100;
+    double  d = 20.0 + (i % 50) / 10.0;
+    float   f = d;
+    bool    bl = i % 3;
+
+    for (int32_t j = 0; j < tListLen(types); ++j) {
+      SColumnInfoData* p = (SColumnInfoData*)taosArrayGet(b->pDataBlock, j);
+      if (j > 0 && i % 7 == 0) {
+        colDataSetNULL(p, i);
+        continue;
+      }
+
+      switch (types[j]) {
+        case TSDB_DATA_TYPE_TIMESTAMP:
+          colDataSetVal(p, i, (const char*)&ts, false);
+          break;
+        case TSDB_DATA_TYPE_DOUBLE:
+          colDataSetVal(p, i, (const char*)&d, false);
+          break;
+        case TSDB_DATA_TYPE_FLOAT:
+          colDataSetVal(p, i, (const char*)&f, false);
+          break;
+        case TSDB_DATA_TYPE_BOOL:
+          colDataSetVal(p, i, (const char*)&bl, false);
+          break;
+        case TSDB_DATA_TYPE_BINARY:
+        case TSDB_DATA_TYPE_NCHAR:
+          memset(varDataVal(buf), 'a' + i % 4, i % 9 * 4);
+          varDataSetLen(buf, i % 9 * 4);
+          colDataSetVal(p, i, buf, false);
+          break;
+        default:
+          colDataSetVal(p, i, (const char*)&v, false);
+          break;
+      }
+    }
+    b->info.rows++;
+  }
+
+  int32_t numOfCols = taosArrayGetSize(b->pDataBlock);
+  char*   pRaw = (char*)taosMemoryMalloc(blockGetEncodeSize(b));
+  char*   pCmpr = (char*)taosMemoryMalloc(blockGetCompressEncodeSize(b));
+  int32_t rawLen = blockEncode(b, pRaw, numOfCols);
+  int32_t cmprLen = blockCompressEncode(b, pCmpr, numOfCols);
+  printf("encoded length:%d, compressed length:%d\n", rawLen, cmprLen);
+  ASSERT_EQ(*(int32_t*)pCmpr, BLOCK_VERSION_3);
+  ASSERT_LT(cmprLen, rawLen);
+
+  SSDataBlock* pRes = createOneDataBlock(b, false);
+  const char*  pEnd = blockDecode(pRes, pCmpr);
+  ASSERT_EQ(pEnd, pCmpr + cmprLen);
+  ASSERT_EQ(pRes->info.rows, numOfRows);
+
+  for (int32_t j = 0; j < numOfCols; ++j) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, j);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, j);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      ASSERT_EQ(colDataIsNull_s(p0, i), colDataIsNull_s(p1, i));
+      if (colDataIsNull_s(p0, i)) continue;
+
+      char*   v0 = colDataGetData(p0, i);
+      char*   v1 = colDataGetData(p1, i);
+      int32_t len = IS_VAR_DATA_TYPE(types[j]) ? varDataTLen(v0) : p0->info.bytes;
+      ASSERT_EQ(memcmp(v0, v1, len), 0);
+    }
+  }
+
+  // the plain encoding is still read, and a format unknown to the decoder is rejected
+  blockDataCleanup(pRes);
+  ASSERT_EQ(blockDecode(pRes, pRaw), pRaw + rawLen);
+  ASSERT_EQ(pRes->info.rows, numOfRows);
+
+  *(int32_t*)pCmpr = BLOCK_VERSION_3 + 1;
+  ASSERT_EQ(blockDecode(pRes, pCmpr), nullptr);
+  ASSERT_EQ(terrno, TSDB_CODE_INVALID_MSG);
+
+  taosMemoryFree(pRaw);
+  taosMemoryFree(pCmpr);
+  blockDataDestroy(pRes);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
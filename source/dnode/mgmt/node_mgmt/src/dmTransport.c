@@ -374,6 +374,7 @@ int32_t dmInitClient(SDnode *pDnode) {
   rpcInit.supportBatch = 1;
   rpcInit.batchSize = 8 * 1024;
   rpcInit.timeToGetConn = tsTimeToGetAvailableConn;
+  rpcInit.muxWindow = tsRpcMuxWindow;
 
   taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
 
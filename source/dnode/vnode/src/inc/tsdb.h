@@ -98,6 +98,10 @@ typedef struct STsdbRowKey      STsdbRowKey;
 #define PAGE_OFFSET(PGNO, PAGE)            (((PGNO)-1) * (PAGE))
 #define OFFSET_PGNO(OFFSET, PAGE)          ((OFFSET) / (PAGE) + 1)
 
+// at most so many pages, or so many bytes of them, are submitted in one write batch
+#define TSDB_FD_WRITE_PAGES 16
+#define TSDB_FD_WRITE_SIZE  (1024 * 1024)
+
 static FORCE_INLINE int64_t tsdbLogicToFileSize(int64_t lSize, int32_t szPage) {
   int64_t fOffSet = LOGIC_TO_FILE_OFFSET(lSize, szPage);
   int64_t pgno = OFFSET_PGNO(fOffSet, szPage);
@@ -384,6 +388,12 @@ struct TSDBKEY {
   TSKEY   ts;
 };
 
+typedef struct {
+  int64_t   suid;
+  int64_t   uid;
+  STSchema *pTSchema;
+} SSkmInfo;
+
 typedef struct SMemSkipListNode SMemSkipListNode;
 typedef struct SMemSkipList {
   int64_t           size;
@@ -394,6 +404,21 @@ typedef struct SMemSkipList {
   SMemSkipListNode *pTail;
 } SMemSkipList;
 
+// rows appended in key order are kept in column chunks instead of the skiplist, the chunks are never changed
+// once linked, and the rows of all chunks are in ascending order
+typedef struct SMemColChunk SMemColChunk;
+struct SMemColChunk {
+  SBlockData   *pBlockData;
+  SMemColChunk *prev;
+  SMemColChunk *next;
+};
+
+typedef struct SMemColList {
+  int64_t       size;
+  SMemColChunk *pHead;
+  SMemColChunk *pTail;
+} SMemColList;
+
 struct STbData {
   tb_uid_t     suid;
   tb_uid_t     uid;
@@ -403,6 +428,7 @@ struct STbData {
   SDelData *   pHead;
   SDelData *   pTail;
   SMemSkipList sl;
+  SMemColList  cl;
   STbData *    next;
   SRBTreeNode  rbtn[1];
 };
@@ -422,6 +448,8 @@ struct SMemTable {
   int32_t          nBucket;
   STbData **       aBucket;
   SRBTree          tbDataTree[1];
+  SVBufArena       arena;  // for skiplist nodes, bypassed if the pool is locked for the concurrent writers of rsma
+  SSkmInfo         chunkSkm;  // schema of the rows to build column chunks, not used by the concurrent writers of rsma
 };
 
 struct TSDBROW {
@@ -440,6 +468,8 @@ struct TSDBROW {
 
 struct SMemSkipListNode {
   int8_t            level;
+  uint8_t           numOfPKs;
+  TSDBKEY           key;  // ts and version of the row kept in the node, so that searching seldom touches the row
   TSDBROW           row;
   SMemSkipListNode *forwards[0];
 };
@@ -546,6 +576,9 @@ struct STbDataIter {
   STbData *         pTbData;
   int8_t            backward;
   SMemSkipListNode *pNode;
+  SMemColChunk *    pChunk;  // NULL when the column chunks are exhausted
+  int32_t           iRow;
+  int8_t            inChunk;  // the current row is from pChunk
   TSDBROW *         pRow;
   TSDBROW           row;
 };
@@ -653,6 +686,10 @@ typedef struct {
   int64_t     pgno;
   uint8_t *   pBuf;
   int64_t     szFile;
+  uint8_t *   pWBuf;  // the pages written but not submitted yet
+  int64_t     aWPgno[TSDB_FD_WRITE_PAGES];
+  int32_t     nWPage;
+  int32_t     maxWPage;
   STsdb *     pTsdb;
   const char *objName;
   uint8_t     s3File;
@@ -810,12 +847,6 @@ typedef struct SMergeTree {
   bool        ignoreEarlierTs;
 } SMergeTree;
 
-typedef struct {
-  int64_t   suid;
-  int64_t   uid;
-  STSchema *pTSchema;
-} SSkmInfo;
-
 struct SDiskCol {
   SBlockCol      bCol;
   const uint8_t *pBit;
@@ -973,6 +1004,8 @@ static FORCE_INLINE int32_t tsdbKeyCmprFn(const void *p1, const void *p2) {
 // #define SL_NODE_FORWARD(n, l)  ((n)->forwards[l])
 // #define SL_NODE_BACKWARD(n, l) ((n)->forwards[(n)->level + (l)])
 
+TSDBROW *tsdbTbDataIterGetMerged(STbDataIter *pIter);
+
 static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
   if (pIter == NULL) return NULL;
 
@@ -980,6 +1013,11 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
     return pIter->pRow;
   }
 
+  if (pIter->pChunk) {
+    return tsdbTbDataIterGetMerged(pIter);
+  }
+
+  pIter->inChunk = 0;
   if (pIter->backward) {
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
       return NULL;
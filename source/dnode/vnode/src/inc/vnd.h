@@ -133,6 +133,18 @@ int32_t vnodeSyncCommit(SVnode* pVnode);
 int32_t vnodeAsyncCommit(SVnode* pVnode);
 bool    vnodeShouldRollback(SVnode* pVnode);
 
+// vnodeSvr.c
+typedef struct {
+  int32_t         end;         // the tables of the submit before it are created in a batch
+  int32_t         nBatched;    // the tables created in a batch
+  int32_t*        aCode;       // the code of each table of the submit created in a batch
+  STableMetaRsp** ppMetaRsps;  // the meta rsp of each table of the submit created in a batch, taken when handled
+} SSubmitCreateCtx;
+
+int32_t vnodeCreateSubmitTable(SVnode* pVnode, int64_t ver, SSubmitReq2* pSubmitReq, int32_t iTbData,
+                               SSubmitCreateCtx* pCtx, STableMetaRsp** ppMetaRsp);
+void    vnodeClearSubmitCreateCtx(SSubmitCreateCtx* pCtx, int32_t nTbData);
+
 // vnodeSync.c
 int64_t vnodeClusterId(SVnode* pVnode);
 int32_t vnodeNodeId(SVnode* pVnode);
@@ -142,8 +142,15 @@ int32_t     metaTbCursorPrev(SMTbCursor* pTbCur, ETableType jumpTableType);
 
 #endif
 
+// bump allocator over the chunks carved from SVBufPool, shall only be used by one thread unless the pool is locked
+typedef struct {
+  uint8_t* ptr;
+  uint8_t* end;
+} SVBufArena;
+
 void* vnodeBufPoolMalloc(SVBufPool* pPool, int size);
 void* vnodeBufPoolMallocAligned(SVBufPool* pPool, int size);
+void* vnodeBufArenaMalloc(SVBufPool* pPool, SVBufArena* pArena, int size);
 void  vnodeBufPoolFree(SVBufPool* pPool, void* p);
 void  vnodeBufPoolRef(SVBufPool* pPool);
 void  vnodeBufPoolUnRef(SVBufPool* pPool, bool proactive);
@@ -174,6 +181,8 @@ int             metaCreateSTable(SMeta* pMeta, int64_t version, SVCreateStbReq*
 int             metaAlterSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
 int             metaDropSTable(SMeta* pMeta, int64_t verison, SVDropStbReq* pReq, SArray* tbUidList);
 int             metaCreateTable(SMeta* pMeta, int64_t version, SVCreateTbReq* pReq, STableMetaRsp** pMetaRsp);
+int             metaCreateTables(SMeta* pMeta, int64_t version, SVCreateTbReq** ppReqs, int32_t nReqs, int32_t* aCode,
+                                 STableMetaRsp** ppMetaRsps, int32_t* pnDone);
 int             metaDropTable(SMeta* pMeta, int64_t version, SVDropTbReq* pReq, SArray* tbUids, int64_t* tbUid);
 int32_t         metaTrimTables(SMeta* pMeta);
 void            metaDropTables(SMeta* pMeta, SArray* tbUids);
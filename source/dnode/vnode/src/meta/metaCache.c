@@ -13,6 +13,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 #include "meta.h"
+#include "troaring.h"
 
 #ifdef TD_ENTERPRISE
 extern const char* tkLogStb[];
@@ -557,11 +558,24 @@ int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pK
 
   *acquireRes = 1;
 
+  // the uids are kept as they are, or in a roaring bitmap, see buildUidListCachePayload
   const char* p = taosLRUCacheValue(pCache, pHandle);
   int32_t     size = *(int32_t*)p;
+  int32_t     bitmapLen = *(int32_t*)(p + sizeof(int32_t));
+  p += sizeof(int32_t) * 2;
 
   // set the result into the buffer
-  taosArrayAddBatch(pList1, p + sizeof(int32_t), size);
+  if (bitmapLen == 0) {
+    taosArrayAddBatch(pList1, p, size);
+  } else {
+    SRoaringBitmap* pBitmap = tRoaringDecode(p, bitmapLen);
+    if (pBitmap == NULL || tRoaringToArray(pBitmap, pList1) != 0) {
+      metaError("vgId:%d, suid:%" PRIu64 " failed to decode the cached uid list, tables:%d", vgId, suid, size);
+      taosArrayClear(pList1);
+      *acquireRes = 0;
+    }
+    tRoaringDestroy(pBitmap);
+  }
 
   (*pEntry)->hitTimes += 1;
 
@@ -28,6 +28,7 @@ static int  metaSaveToSkmDb(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateCtbIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateSuidIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry);
+static int  metaHandleCtbEntries(SMeta *pMeta, const SMetaEntry *aEntry, int32_t nEntry);
 static int  metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type, tb_uid_t *pSuid, int8_t *pSysTbl);
 static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey);
 // opt ins_tables query
@@ -857,9 +858,32 @@ _err:
   return -1;
 }
 
-int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRsp **pMetaRsp) {
-  SMetaEntry  me = {0};
+// check if the table of the request exists, and the uid of the existing table is set to the request
+static int32_t metaCheckTableExist(SMeta *pMeta, SVCreateTbReq *pReq) {
   SMetaReader mr = {0};
+  int32_t     code = 0;
+
+  metaReaderDoInit(&mr, pMeta, META_READER_LOCK);
+  if (metaGetTableEntryByName(&mr, pReq->name) == 0) {
+    if (pReq->type == TSDB_CHILD_TABLE && pReq->ctb.suid != mr.me.ctbEntry.suid) {
+      code = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
+    } else {
+      pReq->uid = mr.me.uid;
+      if (pReq->type == TSDB_CHILD_TABLE) {
+        pReq->ctb.suid = mr.me.ctbEntry.suid;
+      }
+      code = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
+    }
+  } else if (terrno == TSDB_CODE_PAR_TABLE_NOT_EXIST) {
+    terrno = TSDB_CODE_SUCCESS;
+  }
+  metaReaderClear(&mr);
+
+  return code;
+}
+
+int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRsp **pMetaRsp) {
+  SMetaEntry me = {0};
 
   // validate message
   if (pReq->type != TSDB_CHILD_TABLE && pReq->type != TSDB_NORMAL_TABLE) {
@@ -876,24 +900,11 @@ int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRs
   }
 
   // validate req
-  metaReaderDoInit(&mr, pMeta, META_READER_LOCK);
-  if (metaGetTableEntryByName(&mr, pReq->name) == 0) {
-    if (pReq->type == TSDB_CHILD_TABLE && pReq->ctb.suid != mr.me.ctbEntry.suid) {
-      terrno = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
-      metaReaderClear(&mr);
-      return -1;
-    }
-    pReq->uid = mr.me.uid;
-    if (pReq->type == TSDB_CHILD_TABLE) {
-      pReq->ctb.suid = mr.me.ctbEntry.suid;
-    }
-    terrno = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
-    metaReaderClear(&mr);
+  int32_t code = metaCheckTableExist(pMeta, pReq);
+  if (code != 0) {
+    terrno = code;
     return -1;
-  } else if (terrno == TSDB_CODE_PAR_TABLE_NOT_EXIST) {
-    terrno = TSDB_CODE_SUCCESS;
   }
-  metaReaderClear(&mr);
 
   bool sysTbl = (pReq->type == TSDB_CHILD_TABLE) && metaTbInFilterCache(pMeta, pReq->ctb.stbName, 1);
 
@@ -1004,6 +1015,215 @@ _err:
   return -1;
 }
 
+typedef struct {
+  tb_uid_t suid;
+  int32_t  nCols;
+  int32_t  nNewCtbs;
+  bool     sysTbl;
+} SMetaBatchStbInfo;
+
+static SMetaBatchStbInfo *metaGetBatchStbInfo(SMeta *pMeta, SSHashObj *pStbs, const char *stbName) {
+  SMetaBatchStbInfo *pInfo = tSimpleHashGet(pStbs, stbName, strlen(stbName));
+  if (pInfo != NULL) {
+    return pInfo;
+  }
+
+  SMetaBatchStbInfo info = {.suid = metaGetTableEntryUidByName(pMeta, stbName),
+                            .sysTbl = metaTbInFilterCache(pMeta, stbName, 1)};
+  if (info.suid != 0 && !info.sysTbl) {
+    metaGetStbStats(pMeta->pVnode, info.suid, 0, &info.nCols);
+  }
+
+  if (tSimpleHashPut(pStbs, stbName, strlen(stbName), &info, sizeof(info)) != 0) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+  return tSimpleHashGet(pStbs, stbName, strlen(stbName));
+}
+
+/*
+ * Create the tables of a batch, and the code and the meta rsp of ppReqs[i] are saved in aCode[i] and ppMetaRsps[i].
+ * The child tables are validated one by one, and then saved by metaHandleCtbEntries, which writes each index in one
+ * pass of the sorted keys. The normal tables, and the tables of the same name or uid as one before them in the batch,
+ * are created by metaCreateTable in the order of the batch, so of the requests of the same name or uid, the first one
+ * is created and the others fail as they do one by one.
+ *
+ * If pnDone is not NULL, the batch stops before the first request that fails other than by already existing, or that
+ * is left to metaCreateTable, and the number of requests before it is saved in pnDone. The caller goes on from that
+ * request one by one, so the tables after the first error are not created. If the batch fails to be written, pnDone
+ * is 0.
+ */
+int metaCreateTables(SMeta *pMeta, int64_t ver, SVCreateTbReq **ppReqs, int32_t nReqs, int32_t *aCode,
+                     STableMetaRsp **ppMetaRsps, int32_t *pnDone) {
+  int32_t      code = 0;
+  SSHashObj   *pStbs = NULL;
+  SSHashObj   *pNames = NULL;
+  SSHashObj   *pUids = NULL;
+  SMetaEntry  *aEntry = NULL;
+  int32_t     *aEntryReq = NULL;
+  int32_t      nEntry = 0;
+  SArray      *pLater = NULL;
+  int32_t      nDone = nReqs;
+  SVnodeStats *pStats = &pMeta->pVnode->config.vndStats;
+
+  for (int32_t i = 0; i < nReqs; i++) {
+    aCode[i] = TSDB_CODE_SUCCESS;
+    ppMetaRsps[i] = NULL;
+  }
+
+  pStbs = tSimpleHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  pNames = tSimpleHashInit(nReqs, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  pUids = tSimpleHashInit(nReqs, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT));
+  aEntry = taosMemoryCalloc(nReqs, sizeof(SMetaEntry));
+  aEntryReq = taosMemoryMalloc(nReqs * sizeof(int32_t));
+  pLater = taosArrayInit(8, sizeof(int32_t));
+  if (pStbs == NULL || pNames == NULL || pUids == NULL || aEntry == NULL || aEntryReq == NULL || pLater == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // validate the requests and build the entries
+  for (int32_t i = 0; i < nReqs; i++) {
+    SVCreateTbReq *pReq = ppReqs[i];
+
+    // the name and uid of a request left to metaCreateTable are kept too, so that a child table of the same name or
+    // uid after it is left to metaCreateTable as well, and the one first in the batch is created
+    if (pReq->type != TSDB_CHILD_TABLE || tSimpleHashGet(pNames, pReq->name, strlen(pReq->name)) != NULL ||
+        tSimpleHashGet(pUids, &pReq->uid, sizeof(tb_uid_t)) != NULL) {
+      if (pnDone != NULL) {
+        nDone = i;
+        break;
+      }
+      if (taosArrayPush(pLater, &i) == NULL ||
+          tSimpleHashPut(pNames, pReq->name, strlen(pReq->name), &i, sizeof(i)) != 0 ||
+          tSimpleHashPut(pUids, &pReq->uid, sizeof(tb_uid_t), &i, sizeof(i)) != 0) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      continue;
+    }
+
+    SMetaBatchStbInfo *pStb = metaGetBatchStbInfo(pMeta, pStbs, pReq->ctb.stbName);
+    if (pStb == NULL) {
+      code = terrno;
+      goto _exit;
+    }
+    if (pStb->suid != pReq->ctb.suid) {
+      aCode[i] = TSDB_CODE_PAR_TABLE_NOT_EXIST;
+    } else if (metaGetTableEntryUidByName(pMeta, pReq->name) != 0) {
+      // the full check only if the name exists, which is rare when the tables are created in a batch
+      aCode[i] = metaCheckTableExist(pMeta, pReq);
+    }
+
+    if (aCode[i] == TSDB_CODE_SUCCESS && !pStb->sysTbl) {
+      aCode[i] = grantCheck(TSDB_GRANT_TIMESERIES);
+    }
+
+    if (aCode[i] != TSDB_CODE_SUCCESS) {
+      if (pnDone != NULL && aCode[i] != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+        nDone = i;
+        break;
+      }
+      continue;
+    }
+
+    if (tSimpleHashPut(pNames, pReq->name, strlen(pReq->name), &i, sizeof(i)) != 0 ||
+        tSimpleHashPut(pUids, &pReq->uid, sizeof(tb_uid_t), &i, sizeof(i)) != 0) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+
+    SMetaEntry *pEntry = &aEntry[nEntry];
+    pEntry->version = ver;
+    pEntry->type = TSDB_CHILD_TABLE;
+    pEntry->uid = pReq->uid;
+    pEntry->name = pReq->name;
+    pEntry->ctbEntry.btime = pReq->btime;
+    pEntry->ctbEntry.ttlDays = pReq->ttl;
+    pEntry->ctbEntry.commentLen = pReq->commentLen;
+    pEntry->ctbEntry.comment = pReq->comment;
+    pEntry->ctbEntry.suid = pReq->ctb.suid;
+    pEntry->ctbEntry.pTags = pReq->ctb.pTag;
+    aEntryReq[nEntry++] = i;
+
+    ++pStb->nNewCtbs;
+    ++pStats->numOfCTables;
+    if (!pStb->sysTbl) {
+      pStats->numOfTimeSeries += pStb->nCols - 1;
+    }
+
+    if (!TSDB_CACHE_NO(pMeta->pVnode->config)) {
+      tsdbCacheNewTable(pMeta->pVnode->pTsdb, pEntry->uid, pEntry->ctbEntry.suid, NULL);
+    }
+  }
+
+  if (nEntry > 0) {
+    int32_t            iter = 0;
+    SMetaBatchStbInfo *pStb = NULL;
+
+    // the stats and the caches of each super table are updated once
+    metaWLock(pMeta);
+    while ((pStb = tSimpleHashIterate(pStbs, pStb, &iter)) != NULL) {
+      if (pStb->nNewCtbs == 0) continue;
+
+      metaUpdateStbStats(pMeta, pStb->suid, pStb->nNewCtbs, 0);
+      metaUidCacheClear(pMeta, pStb->suid);
+      metaTbGroupCacheClear(pMeta, pStb->suid);
+    }
+    metaULock(pMeta);
+
+    if (metaHandleCtbEntries(pMeta, aEntry, nEntry) < 0) {
+      code = terrno;
+      goto _exit;
+    }
+
+    for (int32_t i = 0; i < nEntry; i++) {
+      SVCreateTbReq *pReq = ppReqs[aEntryReq[i]];
+
+      STableMetaRsp *pMetaRsp = taosMemoryCalloc(1, sizeof(STableMetaRsp));
+      if (pMetaRsp) {
+        pMetaRsp->tableType = TSDB_CHILD_TABLE;
+        pMetaRsp->tuid = pReq->uid;
+        pMetaRsp->suid = pReq->ctb.suid;
+        strcpy(pMetaRsp->tbName, pReq->name);
+      }
+      ppMetaRsps[aEntryReq[i]] = pMetaRsp;
+    }
+
+    metaTimeSeriesNotifyCheck(pMeta);
+    pMeta->changed = true;
+    metaDebug("vgId:%d, %d child tables are created in a batch, version:%" PRId64, TD_VID(pMeta->pVnode), nEntry, ver);
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pLater); i++) {
+    int32_t iReq = *(int32_t *)taosArrayGet(pLater, i);
+    if (metaCreateTable(pMeta, ver, ppReqs[iReq], &ppMetaRsps[iReq]) < 0) {
+      aCode[iReq] = terrno;
+    }
+  }
+
+_exit:
+  if (code != 0) {
+    metaError("vgId:%d, failed to create %d tables in a batch since %s", TD_VID(pMeta->pVnode), nReqs,
+              tstrerror(code));
+    for (int32_t i = 0; i < nReqs; i++) {
+      if (aCode[i] == TSDB_CODE_SUCCESS) aCode[i] = code;
+    }
+    nDone = 0;
+  }
+  if (pnDone != NULL) {
+    *pnDone = nDone;
+  }
+  tSimpleHashCleanup(pStbs);
+  tSimpleHashCleanup(pNames);
+  tSimpleHashCleanup(pUids);
+  taosMemoryFree(aEntry);
+  taosMemoryFree(aEntryReq);
+  taosArrayDestroy(pLater);
+  terrno = code;
+  return code == 0 ? 0 : -1;
+}
+
 int metaDropTable(SMeta *pMeta, int64_t version, SVDropTbReq *pReq, SArray *tbUids, tb_uid_t *tbUid) {
   void    *pData = NULL;
   int      nData = 0;
@@ -2314,13 +2534,39 @@ int metaAlterTable(SMeta *pMeta, int64_t version, SVAlterTbReq *pReq, STableMeta
   }
 }
 
+static int metaEncodeEntryToBuf(const SMetaEntry *pME, void **ppVal, int *vLen) {
+  SEncoder coder = {0};
+  int32_t  ret = 0;
+
+  *ppVal = NULL;
+  tEncodeSize(metaEncodeEntry, pME, *vLen, ret);
+  if (ret < 0) {
+    return -1;
+  }
+
+  *ppVal = taosMemoryMalloc(*vLen);
+  if (*ppVal == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  tEncoderInit(&coder, *ppVal, *vLen);
+  ret = metaEncodeEntry(&coder, pME);
+  tEncoderClear(&coder);
+  if (ret < 0) {
+    taosMemoryFreeClear(*ppVal);
+    return -1;
+  }
+
+  return 0;
+}
+
 static int metaSaveToTbDb(SMeta *pMeta, const SMetaEntry *pME) {
   STbDbKey tbDbKey;
   void    *pKey = NULL;
   void    *pVal = NULL;
   int      kLen = 0;
   int      vLen = 0;
-  SEncoder coder = {0};
 
   // set key and value
   tbDbKey.version = pME->version;
@@ -2332,26 +2578,10 @@ static int metaSaveToTbDb(SMeta *pMeta, const SMetaEntry *pME) {
   pKey = &tbDbKey;
   kLen = sizeof(tbDbKey);
 
-  int32_t ret = 0;
-  tEncodeSize(metaEncodeEntry, pME, vLen, ret);
-  if (ret < 0) {
+  if (metaEncodeEntryToBuf(pME, &pVal, &vLen) < 0) {
     goto _err;
   }
 
-  pVal = taosMemoryMalloc(vLen);
-  if (pVal == NULL) {
-    terrno = TSDB_CODE_OUT_OF_MEMORY;
-    goto _err;
-  }
-
-  tEncoderInit(&coder, pVal, vLen);
-
-  if (metaEncodeEntry(&coder, pME) < 0) {
-    goto _err;
-  }
-
-  tEncoderClear(&coder);
-
   // write to table.db
   if (tdbTbInsert(pMeta->pTbDb, pKey, kLen, pVal, vLen, pMeta->txn) < 0) {
     goto _err;
@@ -2467,32 +2697,60 @@ static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey) {
   if (pTagIdxKey) taosMemoryFree(pTagIdxKey);
 }
 
+// load the super table of a child table, and the entry is decoded from *ppData by pDc
+static int metaLoadStbEntry(SMeta *pMeta, const SMetaEntry *pCtbEntry, void **ppData, int *nData, SDecoder *pDc,
+                            SMetaEntry *pStbEntry) {
+  STbDbKey tbDbKey = {0};
+
+  if (tdbTbGet(pMeta->pUidIdx, &pCtbEntry->ctbEntry.suid, sizeof(tb_uid_t), ppData, nData) != 0) {
+    metaError("vgId:%d, failed to get stable suid for update. version:%" PRId64, TD_VID(pMeta->pVnode),
+              pCtbEntry->version);
+    terrno = TSDB_CODE_TDB_INVALID_TABLE_ID;
+    return -1;
+  }
+  tbDbKey.uid = pCtbEntry->ctbEntry.suid;
+  tbDbKey.version = ((SUidIdxVal *)*ppData)[0].version;
+  tdbTbGet(pMeta->pTbDb, &tbDbKey, sizeof(tbDbKey), ppData, nData);
+
+  tDecoderInit(pDc, *ppData, *nData);
+  return metaDecodeEntry(pDc, pStbEntry);
+}
+
+static int metaBuildTagIdxKey(const SMetaEntry *pCtbEntry, const SSchema *pTagColumn, STagIdxKey **ppTagIdxKey,
+                              int32_t *nTagIdxKey) {
+  const void *pTagData = NULL;
+  int32_t     nTagData = 0;
+
+  STagVal tagVal = {.cid = pTagColumn->colId};
+  if (tTagGet((const STag *)pCtbEntry->ctbEntry.pTags, &tagVal)) {
+    if (IS_VAR_DATA_TYPE(pTagColumn->type)) {
+      pTagData = tagVal.pData;
+      nTagData = (int32_t)tagVal.nData;
+    } else {
+      pTagData = &(tagVal.i64);
+      nTagData = tDataTypes[pTagColumn->type].bytes;
+    }
+  } else {
+    if (!IS_VAR_DATA_TYPE(pTagColumn->type)) {
+      nTagData = tDataTypes[pTagColumn->type].bytes;
+    }
+  }
+
+  return metaCreateTagIdxKey(pCtbEntry->ctbEntry.suid, pTagColumn->colId, pTagData, nTagData, pTagColumn->type,
+                             pCtbEntry->uid, ppTagIdxKey, nTagIdxKey);
+}
+
 static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
   void          *pData = NULL;
   int            nData = 0;
-  STbDbKey       tbDbKey = {0};
   SMetaEntry     stbEntry = {0};
   STagIdxKey    *pTagIdxKey = NULL;
   int32_t        nTagIdxKey;
   const SSchema *pTagColumn;
-  const void    *pTagData = NULL;
-  int32_t        nTagData = 0;
   SDecoder       dc = {0};
   int32_t        ret = 0;
   // get super table
-  if (tdbTbGet(pMeta->pUidIdx, &pCtbEntry->ctbEntry.suid, sizeof(tb_uid_t), &pData, &nData) != 0) {
-    metaError("vgId:%d, failed to get stable suid for update. version:%" PRId64, TD_VID(pMeta->pVnode),
-              pCtbEntry->version);
-    terrno = TSDB_CODE_TDB_INVALID_TABLE_ID;
-    ret = -1;
-    goto end;
-  }
-  tbDbKey.uid = pCtbEntry->ctbEntry.suid;
-  tbDbKey.version = ((SUidIdxVal *)pData)[0].version;
-  tdbTbGet(pMeta->pTbDb, &tbDbKey, sizeof(tbDbKey), &pData, &nData);
-
-  tDecoderInit(&dc, pData, nData);
-  ret = metaDecodeEntry(&dc, &stbEntry);
+  ret = metaLoadStbEntry(pMeta, pCtbEntry, &pData, &nData, &dc, &stbEntry);
   if (ret < 0) {
     goto end;
   }
@@ -2504,35 +2762,14 @@ static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
   SSchemaWrapper *pTagSchema = &stbEntry.stbEntry.schemaTag;
   if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
     pTagColumn = &stbEntry.stbEntry.schemaTag.pSchema[0];
-    STagVal tagVal = {.cid = pTagColumn->colId};
-
-    pTagData = pCtbEntry->ctbEntry.pTags;
-    nTagData = ((const STag *)pCtbEntry->ctbEntry.pTags)->len;
     ret = metaSaveJsonVarToIdx(pMeta, pCtbEntry, pTagColumn);
     goto end;
   } else {
     for (int i = 0; i < pTagSchema->nCols; i++) {
-      pTagData = NULL;
-      nTagData = 0;
       pTagColumn = &pTagSchema->pSchema[i];
       if (!IS_IDX_ON(pTagColumn)) continue;
 
-      STagVal tagVal = {.cid = pTagColumn->colId};
-      if (tTagGet((const STag *)pCtbEntry->ctbEntry.pTags, &tagVal)) {
-        if (IS_VAR_DATA_TYPE(pTagColumn->type)) {
-          pTagData = tagVal.pData;
-          nTagData = (int32_t)tagVal.nData;
-        } else {
-          pTagData = &(tagVal.i64);
-          nTagData = tDataTypes[pTagColumn->type].bytes;
-        }
-      } else {
-        if (!IS_VAR_DATA_TYPE(pTagColumn->type)) {
-          nTagData = tDataTypes[pTagColumn->type].bytes;
-        }
-      }
-      if (metaCreateTagIdxKey(pCtbEntry->ctbEntry.suid, pTagColumn->colId, pTagData, nTagData, pTagColumn->type,
-                              pCtbEntry->uid, &pTagIdxKey, &nTagIdxKey) < 0) {
+      if (metaBuildTagIdxKey(pCtbEntry, pTagColumn, &pTagIdxKey, &nTagIdxKey) < 0) {
         ret = -1;
         goto end;
       }
@@ -2665,6 +2902,179 @@ _err:
   return -1;
 }
 
+// build the keys of the indexed tags, and the keys are freed by the caller
+static int metaBuildTagIdxRecords(SMeta *pMeta, const SMetaEntry *aEntry, int32_t nEntry, SArray *pRecords) {
+  void       *pData = NULL;
+  int         nData = 0;
+  SMetaEntry  stbEntry = {0};
+  SDecoder    dc = {0};
+  tb_uid_t    suid = 0;
+  STagIdxKey *pTagIdxKey = NULL;
+  int32_t     nTagIdxKey;
+  int32_t     ret = 0;
+
+  for (int32_t i = 0; i < nEntry; i++) {
+    const SMetaEntry *pCtbEntry = &aEntry[i];
+
+    // the super table is loaded again only if it is not the one of the last child table
+    if (pCtbEntry->ctbEntry.suid != suid) {
+      tDecoderClear(&dc);
+      memset(&stbEntry, 0, sizeof(stbEntry));
+      suid = 0;
+      ret = metaLoadStbEntry(pMeta, pCtbEntry, &pData, &nData, &dc, &stbEntry);
+      if (ret < 0) {
+        goto _exit;
+      }
+      suid = pCtbEntry->ctbEntry.suid;
+    }
+
+    SSchemaWrapper *pTagSchema = &stbEntry.stbEntry.schemaTag;
+    if (pTagSchema->pSchema == NULL) {
+      continue;
+    }
+
+    if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+      ret = metaSaveJsonVarToIdx(pMeta, pCtbEntry, &pTagSchema->pSchema[0]);
+      if (ret < 0) {
+        goto _exit;
+      }
+      continue;
+    }
+
+    for (int32_t iCol = 0; iCol < pTagSchema->nCols; iCol++) {
+      const SSchema *pTagColumn = &pTagSchema->pSchema[iCol];
+      if (!IS_IDX_ON(pTagColumn)) continue;
+
+      if (metaBuildTagIdxKey(pCtbEntry, pTagColumn, &pTagIdxKey, &nTagIdxKey) < 0) {
+        ret = -1;
+        goto _exit;
+      }
+
+      STbRecord record = {.pKey = pTagIdxKey, .kLen = nTagIdxKey};
+      if (taosArrayPush(pRecords, &record) == NULL) {
+        metaDestroyTagIdxKey(pTagIdxKey);
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        ret = -1;
+        goto _exit;
+      }
+    }
+  }
+
+_exit:
+  tDecoderClear(&dc);
+  tdbFree(pData);
+  return ret;
+}
+
+// the batch version of metaHandleEntry for child tables, and each index is written in one pass of the sorted keys
+static int metaHandleCtbEntries(SMeta *pMeta, const SMetaEntry *aEntry, int32_t nEntry) {
+  int32_t       code = 0;
+  int32_t       line = 0;
+  STbRecord    *aRecord = taosMemoryMalloc(nEntry * sizeof(STbRecord));
+  STbDbKey     *aTbDbKey = taosMemoryMalloc(nEntry * sizeof(STbDbKey));
+  void        **aVal = taosMemoryCalloc(nEntry, sizeof(void *));
+  SUidIdxVal   *aUidIdxVal = taosMemoryMalloc(nEntry * sizeof(SUidIdxVal));
+  SCtbIdxKey   *aCtbIdxKey = taosMemoryMalloc(nEntry * sizeof(SCtbIdxKey));
+  SBtimeIdxKey *aBtimeKey = taosMemoryMalloc(nEntry * sizeof(SBtimeIdxKey));
+  SArray       *pTagRecords = taosArrayInit(nEntry, sizeof(STbRecord));
+
+  if (aRecord == NULL || aTbDbKey == NULL || aVal == NULL || aUidIdxVal == NULL || aCtbIdxKey == NULL ||
+      aBtimeKey == NULL || pTagRecords == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    code = -1;
+    goto _exit;
+  }
+
+  metaWLock(pMeta);
+
+  // save to table.db
+  for (int32_t i = 0; i < nEntry; i++) {
+    int vLen = 0;
+    code = metaEncodeEntryToBuf(&aEntry[i], &aVal[i], &vLen);
+    VND_CHECK_CODE(code, line, _err);
+
+    aTbDbKey[i] = (STbDbKey){.version = aEntry[i].version, .uid = aEntry[i].uid};
+    aRecord[i] = (STbRecord){.pKey = &aTbDbKey[i], .kLen = sizeof(STbDbKey), .pVal = aVal[i], .vLen = vLen};
+  }
+  code = tdbTbUpsertBatch(pMeta->pTbDb, aRecord, nEntry, pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  // update uid.idx
+  for (int32_t i = 0; i < nEntry; i++) {
+    SMetaInfo info;
+    metaGetEntryInfo(&aEntry[i], &info);
+    metaCacheUpsert(pMeta, &info);
+
+    aUidIdxVal[i] = (SUidIdxVal){.suid = info.suid, .version = info.version, .skmVer = info.skmVer};
+    aRecord[i] = (STbRecord){.pKey = &aEntry[i].uid, .kLen = sizeof(tb_uid_t), .pVal = &aUidIdxVal[i],
+                             .vLen = sizeof(SUidIdxVal)};
+  }
+  code = tdbTbUpsertBatch(pMeta->pUidIdx, aRecord, nEntry, pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  // update name.idx
+  for (int32_t i = 0; i < nEntry; i++) {
+    aRecord[i] = (STbRecord){.pKey = aEntry[i].name, .kLen = strlen(aEntry[i].name) + 1, .pVal = &aEntry[i].uid,
+                             .vLen = sizeof(tb_uid_t)};
+  }
+  code = tdbTbUpsertBatch(pMeta->pNameIdx, aRecord, nEntry, pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  // update ctb.idx
+  for (int32_t i = 0; i < nEntry; i++) {
+    aCtbIdxKey[i] = (SCtbIdxKey){.suid = aEntry[i].ctbEntry.suid, .uid = aEntry[i].uid};
+    aRecord[i] = (STbRecord){.pKey = &aCtbIdxKey[i], .kLen = sizeof(SCtbIdxKey), .pVal = aEntry[i].ctbEntry.pTags,
+                             .vLen = ((STag *)(aEntry[i].ctbEntry.pTags))->len};
+  }
+  code = tdbTbUpsertBatch(pMeta->pCtbIdx, aRecord, nEntry, pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  // update tag.idx
+  code = metaBuildTagIdxRecords(pMeta, aEntry, nEntry, pTagRecords);
+  VND_CHECK_CODE(code, line, _err);
+  code = tdbTbUpsertBatch(pMeta->pTagIdx, TARRAY_DATA(pTagRecords), TARRAY_SIZE(pTagRecords), pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  // update btime.idx
+  for (int32_t i = 0; i < nEntry; i++) {
+    aBtimeKey[i] = (SBtimeIdxKey){.btime = aEntry[i].ctbEntry.btime, .uid = aEntry[i].uid};
+    aRecord[i] = (STbRecord){.pKey = &aBtimeKey[i], .kLen = sizeof(SBtimeIdxKey)};
+  }
+  code = tdbTbUpsertBatch(pMeta->pBtimeIdx, aRecord, nEntry, pMeta->txn);
+  VND_CHECK_CODE(code, line, _err);
+
+  for (int32_t i = 0; i < nEntry; i++) {
+    code = metaUpdateTtl(pMeta, &aEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+  }
+
+  metaULock(pMeta);
+  metaDebug("vgId:%d, handle %d child table entries, ver:%" PRId64, TD_VID(pMeta->pVnode), nEntry, aEntry[0].version);
+  goto _exit;
+
+_err:
+  metaULock(pMeta);
+  metaError("vgId:%d, failed to handle %d child table entries since %s at line:%d, ver:%" PRId64,
+            TD_VID(pMeta->pVnode), nEntry, terrstr(), line, aEntry[0].version);
+  code = -1;
+
+_exit:
+  for (int32_t i = 0; aVal && i < nEntry; i++) {
+    taosMemoryFree(aVal[i]);
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(pTagRecords); i++) {
+    metaDestroyTagIdxKey((STagIdxKey *)((STbRecord *)taosArrayGet(pTagRecords, i))->pKey);
+  }
+  taosMemoryFree(aRecord);
+  taosMemoryFree(aTbDbKey);
+  taosMemoryFree(aVal);
+  taosMemoryFree(aUidIdxVal);
+  taosMemoryFree(aCtbIdxKey);
+  taosMemoryFree(aBtimeKey);
+  taosArrayDestroy(pTagRecords);
+  return code;
+}
+
 int32_t colCompressDebug(SHashObj *pColCmprObj) {
   void *p = taosHashIterate(pColCmprObj, NULL);
   while (p) {
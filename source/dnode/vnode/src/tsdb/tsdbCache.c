@@ -56,11 +56,20 @@ static void tsdbCloseBICache(STsdb *pTsdb) {
 }
 #endif
 
+// the hit ratio of the s3 caches since the vnode is opened, and how often tinylfu kept the cached entries
+static void tsdbLogS3CacheStats(STsdb *pTsdb, SLRUCache *pCache, const char *name) {
+  SLRUCacheStats stats = {0};
+  taosLRUCacheGetStats(pCache, &stats);
+  tsdbDebug("vgId:%d, %s hits:%" PRId64 " misses:%" PRId64 " evictions:%" PRId64 " rejections:%" PRId64,
+            TD_VID(pTsdb->pVnode), name, stats.hits, stats.misses, stats.evictions, stats.rejections);
+}
+
 static int32_t tsdbOpenBCache(STsdb *pTsdb) {
   int32_t    code = 0;
   int32_t    szPage = pTsdb->pVnode->config.tsdbPageSize;
   int64_t    szBlock = tsS3BlockSize <= 1024 ? 1024 : tsS3BlockSize;
-  SLRUCache *pCache = taosLRUCacheInit((int64_t)tsS3BlockCacheSize * szBlock * szPage, 0, .5);
+  SLRUCache *pCache =
+      taosLRUCacheInitWithPolicy((int64_t)tsS3BlockCacheSize * szBlock * szPage, 0, .5, TAOS_LRU_POLICY_TINYLFU);
   if (pCache == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     goto _err;
@@ -79,6 +88,8 @@ _err:
 static void tsdbCloseBCache(STsdb *pTsdb) {
   SLRUCache *pCache = pTsdb->bCache;
   if (pCache) {
+    tsdbLogS3CacheStats(pTsdb, pCache, "s3 block cache");
+
     int32_t elems = taosLRUCacheGetElems(pCache);
     tsdbTrace("vgId:%d, elems: %d", TD_VID(pTsdb->pVnode), elems);
     taosLRUCacheEraseUnrefEntries(pCache);
@@ -96,7 +107,7 @@ static int32_t tsdbOpenPgCache(STsdb *pTsdb) {
   // SLRUCache *pCache = taosLRUCacheInit(10 * 1024 * 1024, 0, .5);
   int32_t szPage = pTsdb->pVnode->config.tsdbPageSize;
 
-  SLRUCache *pCache = taosLRUCacheInit((int64_t)tsS3PageCacheSize * szPage, 0, .5);
+  SLRUCache *pCache = taosLRUCacheInitWithPolicy((int64_t)tsS3PageCacheSize * szPage, 0, .5, TAOS_LRU_POLICY_TINYLFU);
   if (pCache == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     goto _err;
@@ -114,6 +125,8 @@ _err:
 static void tsdbClosePgCache(STsdb *pTsdb) {
   SLRUCache *pCache = pTsdb->pgCache;
   if (pCache) {
+    tsdbLogS3CacheStats(pTsdb, pCache, "s3 page cache");
+
     int32_t elems = taosLRUCacheGetElems(pCache);
     tsdbTrace("vgId:%d, elems: %d", TD_VID(pTsdb->pVnode), elems);
     taosLRUCacheEraseUnrefEntries(pCache);
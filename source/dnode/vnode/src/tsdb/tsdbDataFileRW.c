@@ -510,6 +510,13 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFilePrefetchBlockData(SDataFileReader *reader, int64_t offset, int64_t size) {
+  if (reader->fd[TSDB_FTYPE_DATA] == NULL) {
+    return 0;
+  }
+  return tsdbPrefetchFile(reader->fd[TSDB_FTYPE_DATA], offset, size);
+}
+
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray) {
   int32_t  code = 0;
@@ -40,6 +40,8 @@ extern int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t
                             int32_t encryptAlgorithm, char* encryptKey);
 extern int32_t tsdbReadFileToBuffer(STsdbFD *pFD, int64_t offset, int64_t size, SBuffer *buffer, int64_t szHint,
                                     int32_t encryptAlgorithm, char* encryptKey);
+extern int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size);
+extern void    tsdbFilePagesOfRange(int32_t szPage, int64_t offset, int64_t size, int64_t *fOffset, int64_t *fSize);
 extern int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char* encryptKey);
 
 typedef struct SColCompressInfo SColCompressInfo;
@@ -14,9 +14,11 @@
  */
 
 #include "tsdb.h"
+#include "tsdbUtil2.h"
 #include "util/tsimplehash.h"
 
-#define MEM_MIN_HASH 1024
+#define MEM_MIN_HASH       1024
+#define MEM_MIN_CHUNK_ROWS 16
 #define SL_MAX_LEVEL 5
 
 // sizeof(SMemSkipListNode) + sizeof(SMemSkipListNode *) * (l) * 2
@@ -31,13 +33,42 @@
 #define SL_MOVE_BACKWARD 0x1
 #define SL_MOVE_FROM_POS 0x2
 
+#if defined(__GNUC__)
+#define SL_PREFETCH_NODE(n) __builtin_prefetch(n)
+#else
+#define SL_PREFETCH_NODE(n)
+#endif
+
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKey *pKey, int32_t flags);
+static void    tbDataChunkMoveTo(STbData *pTbData, STsdbRowKey *pKey, int8_t backward, STbDataIter *pIter);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
 
+// compare the key of the node with pKey, the row is only decoded when the table has primary keys and ts is equal
+static FORCE_INLINE int32_t tbDataNodeKeyCmpr(SMemSkipListNode *pNode, STsdbRowKey *pKey) {
+  if (pNode->key.ts < pKey->key.ts) {
+    return -1;
+  } else if (pNode->key.ts > pKey->key.ts) {
+    return 1;
+  }
+
+  if (pNode->numOfPKs == 0 && pKey->key.numOfPKs == 0) {
+    if (pNode->key.version < pKey->version) {
+      return -1;
+    } else if (pNode->key.version > pKey->version) {
+      return 1;
+    }
+    return 0;
+  }
+
+  STsdbRowKey tKey;
+  tsdbRowGetKey(&pNode->row, &tKey);
+  return tsdbRowKeyCmpr(&tKey, pKey);
+}
+
 static int32_t tTbDataCmprFn(const SRBTreeNode *n1, const SRBTreeNode *n2) {
   STbData *tbData1 = TCONTAINER_OF(n1, STbData, rbtn);
   STbData *tbData2 = TCONTAINER_OF(n2, STbData, rbtn);
@@ -89,6 +120,7 @@ _err:
 void tsdbMemTableDestroy(SMemTable *pMemTable, bool proactive) {
   if (pMemTable) {
     vnodeBufPoolUnRef(pMemTable->pPool, proactive);
+    tDestroyTSchema(pMemTable->chunkSkm.pTSchema);
     taosMemoryFree(pMemTable->aBucket);
     taosMemoryFree(pMemTable);
   }
@@ -241,6 +273,8 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
   pIter->pTbData = pTbData;
   pIter->backward = backward;
   pIter->pRow = NULL;
+  pIter->inChunk = 0;
+  tbDataChunkMoveTo(pTbData, pFrom, backward, pIter);
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
@@ -260,7 +294,52 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
   }
 }
 
+TSDBROW *tsdbTbDataIterGetMerged(STbDataIter *pIter) {
+  SMemSkipListNode *pEnd = pIter->backward ? pIter->pTbData->sl.pHead : pIter->pTbData->sl.pTail;
+
+  pIter->row = tsdbRowFromBlockData(pIter->pChunk->pBlockData, pIter->iRow);
+  pIter->inChunk = 1;
+  if (pIter->pNode != pEnd) {
+    STsdbRowKey key;
+    tsdbRowGetKey(&pIter->row, &key);
+
+    int32_t c = tbDataNodeKeyCmpr(pIter->pNode, &key);
+    if (pIter->backward ? (c >= 0) : (c <= 0)) {
+      pIter->row = pIter->pNode->row;
+      pIter->inChunk = 0;
+    }
+  }
+
+  pIter->pRow = &pIter->row;
+  return pIter->pRow;
+}
+
 bool tsdbTbDataIterNext(STbDataIter *pIter) {
+  if (pIter->pChunk) {
+    // rows of the chunks and the skiplist are merged, move the one the current row comes from
+    if (tsdbTbDataIterGet(pIter) == NULL) return false;
+
+    pIter->pRow = NULL;
+    if (pIter->inChunk) {
+      SMemColChunk *pChunk = pIter->pChunk;
+      if (pIter->backward) {
+        if (--pIter->iRow < 0) {
+          pIter->pChunk = pChunk->prev;
+          pIter->iRow = pIter->pChunk ? pIter->pChunk->pBlockData->nRow - 1 : 0;
+        }
+      } else if (++pIter->iRow >= pChunk->pBlockData->nRow) {
+        pIter->pChunk = (SMemColChunk *)atomic_load_ptr(&pChunk->next);
+        pIter->iRow = 0;
+      }
+    } else if (pIter->backward) {
+      pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
+    } else {
+      pIter->pNode = SL_GET_NODE_FORWARD(pIter->pNode, 0);
+    }
+
+    return tsdbTbDataIterGet(pIter) != NULL;
+  }
+
   pIter->pRow = NULL;
   if (pIter->backward) {
     ASSERT(pIter->pNode != pIter->pTbData->sl.pTail);
@@ -291,7 +370,7 @@ bool tsdbTbDataIterNext(STbDataIter *pIter) {
 
 int64_t tsdbCountTbDataRows(STbData *pTbData) {
   SMemSkipListNode *pNode = pTbData->sl.pHead;
-  int64_t           rowsNum = 0;
+  int64_t           rowsNum = atomic_load_64(&pTbData->cl.size);
 
   while (NULL != pNode) {
     pNode = SL_GET_NODE_FORWARD(pNode, 0);
@@ -382,6 +461,9 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->sl.size = 0;
   pTbData->sl.maxLevel = maxLevel;
   pTbData->sl.level = 0;
+  pTbData->cl.size = 0;
+  pTbData->cl.pHead = NULL;
+  pTbData->cl.pTail = NULL;
   pTbData->sl.pHead = (SMemSkipListNode *)&pTbData[1];
   pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
   pTbData->sl.pHead->level = maxLevel;
@@ -426,7 +508,6 @@ _err:
 static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKey *pKey, int32_t flags) {
   SMemSkipListNode *px;
   SMemSkipListNode *pn;
-  STsdbRowKey       tKey;
   int32_t           backward = flags & SL_MOVE_BACKWARD;
   int32_t           fromPos = flags & SL_MOVE_FROM_POS;
 
@@ -445,9 +526,9 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
       for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
         pn = SL_GET_NODE_BACKWARD(px, iLevel);
         while (pn != pTbData->sl.pHead) {
-          tsdbRowGetKey(&pn->row, &tKey);
+          SL_PREFETCH_NODE(SL_GET_NODE_BACKWARD(pn, iLevel));
 
-          int32_t c = tsdbRowKeyCmpr(&tKey, pKey);
+          int32_t c = tbDataNodeKeyCmpr(pn, pKey);
           if (c <= 0) {
             break;
           } else {
@@ -474,9 +555,9 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
       for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
         pn = SL_GET_NODE_FORWARD(px, iLevel);
         while (pn != pTbData->sl.pTail) {
-          tsdbRowGetKey(&pn->row, &tKey);
+          SL_PREFETCH_NODE(SL_GET_NODE_FORWARD(pn, iLevel));
 
-          int32_t c = tsdbRowKeyCmpr(&tKey, pKey);
+          int32_t c = tbDataNodeKeyCmpr(pn, pKey);
           if (c >= 0) {
             break;
           } else {
@@ -491,6 +572,220 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKe
   }
 }
 
+// compare the key of the row in the chunk with pKey
+static FORCE_INLINE int32_t tbDataChunkKeyCmpr(SBlockData *pBlockData, int32_t iRow, STsdbRowKey *pKey) {
+  if (pBlockData->aTSKEY[iRow] < pKey->key.ts) {
+    return -1;
+  } else if (pBlockData->aTSKEY[iRow] > pKey->key.ts) {
+    return 1;
+  }
+
+  STsdbRowKey tKey;
+  TSDBROW     row = tsdbRowFromBlockData(pBlockData, iRow);
+  tsdbRowGetKey(&row, &tKey);
+  return tsdbRowKeyCmpr(&tKey, pKey);
+}
+
+static void tbDataChunkMoveTo(STbData *pTbData, STsdbRowKey *pKey, int8_t backward, STbDataIter *pIter) {
+  SMemColChunk *pChunk;
+  int32_t       lidx, ridx;
+
+  if (backward) {
+    // move to the last row not greater than pKey
+    pChunk = (SMemColChunk *)atomic_load_ptr(&pTbData->cl.pTail);
+    while (pKey && pChunk && tbDataChunkKeyCmpr(pChunk->pBlockData, 0, pKey) > 0) {
+      pChunk = pChunk->prev;
+    }
+
+    pIter->pChunk = pChunk;
+    if (pChunk == NULL) {
+      pIter->iRow = 0;
+      return;
+    }
+
+    lidx = 0;
+    ridx = pChunk->pBlockData->nRow - 1;
+    if (pKey == NULL) lidx = ridx;
+    while (lidx < ridx) {
+      int32_t midx = (lidx + ridx + 1) >> 1;
+      if (tbDataChunkKeyCmpr(pChunk->pBlockData, midx, pKey) <= 0) {
+        lidx = midx;
+      } else {
+        ridx = midx - 1;
+      }
+    }
+    pIter->iRow = lidx;
+  } else {
+    // move to the first row not less than pKey
+    pChunk = (SMemColChunk *)atomic_load_ptr(&pTbData->cl.pHead);
+    while (pKey && pChunk && tbDataChunkKeyCmpr(pChunk->pBlockData, pChunk->pBlockData->nRow - 1, pKey) < 0) {
+      pChunk = (SMemColChunk *)atomic_load_ptr(&pChunk->next);
+    }
+
+    pIter->pChunk = pChunk;
+    if (pChunk == NULL) {
+      pIter->iRow = 0;
+      return;
+    }
+
+    lidx = 0;
+    ridx = pKey ? pChunk->pBlockData->nRow - 1 : 0;
+    while (lidx < ridx) {
+      int32_t midx = (lidx + ridx) >> 1;
+      if (tbDataChunkKeyCmpr(pChunk->pBlockData, midx, pKey) >= 0) {
+        ridx = midx;
+      } else {
+        lidx = midx + 1;
+      }
+    }
+    pIter->iRow = lidx;
+  }
+}
+
+// rows can be appended to the chunks only if the first one is greater than all rows of the table, regardless of the
+// version, so that the chunks stay in order and duplicate keys always go to the skiplist
+static bool tbDataCanAppend(STbData *pTbData, STsdbRowKey *pKey) {
+  SMemSkipListNode *pNode = SL_NODE_BACKWARD(pTbData->sl.pTail, 0);
+  STsdbRowKey       tKey;
+
+  if (pNode != pTbData->sl.pHead && pNode->key.ts >= pKey->key.ts) {
+    if (pNode->key.ts > pKey->key.ts) return false;
+
+    tsdbRowGetKey(&pNode->row, &tKey);
+    if (tRowKeyCompare(&tKey.key, &pKey->key) >= 0) return false;
+  }
+
+  if (pTbData->cl.pTail) {
+    TSDBROW row = tBlockDataLastRow(pTbData->cl.pTail->pBlockData);
+
+    if (TSDBROW_TS(&row) > pKey->key.ts) return false;
+    if (TSDBROW_TS(&row) == pKey->key.ts) {
+      tsdbRowGetKey(&row, &tKey);
+      if (tRowKeyCompare(&tKey.key, &pKey->key) >= 0) return false;
+    }
+  }
+
+  return true;
+}
+
+static bool tbDataRowsInOrder(SRow **aRow, int32_t nRow) {
+  SRowKey key1, key2;
+
+  for (int32_t iRow = 1; iRow < nRow; iRow++) {
+    if (aRow[iRow]->sver != aRow[0]->sver || aRow[iRow]->ts < aRow[iRow - 1]->ts) return false;
+    if (aRow[iRow]->ts == aRow[iRow - 1]->ts) {
+      tRowGetKey(aRow[iRow - 1], &key1);
+      tRowGetKey(aRow[iRow], &key2);
+      if (tRowKeyCompare(&key1, &key2) >= 0) return false;
+    }
+  }
+
+  return true;
+}
+
+static bool tbDataBlockInOrder(SBlockData *pBlockData) {
+  STsdbRowKey key1, key2;
+
+  for (int32_t iRow = 1; iRow < pBlockData->nRow; iRow++) {
+    if (pBlockData->aTSKEY[iRow] < pBlockData->aTSKEY[iRow - 1]) return false;
+    if (pBlockData->aTSKEY[iRow] == pBlockData->aTSKEY[iRow - 1]) {
+      TSDBROW row1 = tsdbRowFromBlockData(pBlockData, iRow - 1);
+      TSDBROW row2 = tsdbRowFromBlockData(pBlockData, iRow);
+      tsdbRowGetKey(&row1, &key1);
+      tsdbRowGetKey(&row2, &key2);
+      if (tRowKeyCompare(&key1.key, &key2.key) >= 0) return false;
+    }
+  }
+
+  return true;
+}
+
+static int32_t tbDataAppendChunk(SMemTable *pMemTable, STbData *pTbData, SBlockData *pBlockData) {
+  SVBufPool    *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemColChunk *pChunk = (SMemColChunk *)vnodeBufPoolMallocAligned(pPool, sizeof(*pChunk));
+  if (pChunk == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pChunk->pBlockData = pBlockData;
+  pChunk->prev = pTbData->cl.pTail;
+  pChunk->next = NULL;
+
+  // link the chunk after it is built, readers may be iterating the chunks
+  if (pTbData->cl.pTail) {
+    atomic_store_ptr(&pTbData->cl.pTail->next, pChunk);
+  } else {
+    atomic_store_ptr(&pTbData->cl.pHead, pChunk);
+  }
+  atomic_store_ptr(&pTbData->cl.pTail, pChunk);
+  atomic_add_fetch_64(&pTbData->cl.size, pBlockData->nRow);
+
+  return 0;
+}
+
+// transpose the rows into a column chunk in the buffer pool
+static int32_t tbDataBuildChunk(SMemTable *pMemTable, STbData *pTbData, int64_t version, SRow **aRow, int32_t nRow,
+                                SBlockData **ppBlockData) {
+  int32_t     code = 0;
+  SVBufPool  *pPool = pMemTable->pTsdb->pVnode->inUse;
+  TABLEID     id = {.suid = pTbData->suid, .uid = pTbData->uid};
+  SBlockData  bData;
+  SBlockData *pBlockData = NULL;
+  SSkmInfo    skm = {0};
+
+  // the memtable of a rsma vnode is written by more than one thread, so the schema is not cached by the memtable then
+  SSkmInfo *pSkm = VND_IS_RSMA(pMemTable->pTsdb->pVnode) ? &skm : &pMemTable->chunkSkm;
+
+  tBlockDataCreate(&bData);
+  code = tsdbUpdateSkmRow(pMemTable->pTsdb, &id, aRow[0]->sver, pSkm);
+  if (code) goto _exit;
+
+  STSchema *pTSchema = pSkm->pTSchema;
+
+  code = tBlockDataInit(&bData, &id, pTSchema, NULL, 0);
+  if (code) goto _exit;
+
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    TSDBROW row = tsdbRowFromTSRow(version, aRow[iRow]);
+    code = tBlockDataAppendRow(&bData, &row, pTSchema, id.uid);
+    if (code) goto _exit;
+  }
+
+  pBlockData = vnodeBufPoolMalloc(pPool, sizeof(*pBlockData));
+  if (pBlockData == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  pBlockData->suid = bData.suid;
+  pBlockData->uid = bData.uid;
+  pBlockData->nRow = bData.nRow;
+  pBlockData->aUid = NULL;
+  pBlockData->aVersion = vnodeBufPoolMalloc(pPool, sizeof(int64_t) * bData.nRow);
+  pBlockData->aTSKEY = vnodeBufPoolMalloc(pPool, sizeof(TSKEY) * bData.nRow);
+  pBlockData->nColData = bData.nColData;
+  pBlockData->aColData = vnodeBufPoolMalloc(pPool, sizeof(SColData) * bData.nColData);
+  if (pBlockData->aVersion == NULL || pBlockData->aTSKEY == NULL || pBlockData->aColData == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+  memcpy(pBlockData->aVersion, bData.aVersion, sizeof(int64_t) * bData.nRow);
+  memcpy(pBlockData->aTSKEY, bData.aTSKEY, sizeof(TSKEY) * bData.nRow);
+
+  for (int32_t iColData = 0; iColData < bData.nColData; ++iColData) {
+    code = tColDataCopy(&bData.aColData[iColData], &pBlockData->aColData[iColData], (xMallocFn)vnodeBufPoolMalloc,
+                        pPool);
+    if (code) goto _exit;
+  }
+
+  *ppBlockData = pBlockData;
+
+_exit:
+  tBlockDataDestroy(&bData);
+  tDestroyTSchema(skm.pTSchema);
+  return code;
+}
+
 static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   int8_t level = 1;
   int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
@@ -502,7 +797,7 @@ static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   return level;
 }
 static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
-                           int8_t forward) {
+                           STsdbRowKey *pKey, int8_t forward) {
   int32_t           code = 0;
   int8_t            level;
   SMemSkipListNode *pNode = NULL;
@@ -513,9 +808,9 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
   level = tsdbMemSkipListRandLevel(&pTbData->sl);
   nSize = SL_NODE_SIZE(level);
   if (pRow->type == TSDBROW_ROW_FMT) {
-    pNode = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, nSize + pRow->pTSRow->len);
+    pNode = (SMemSkipListNode *)vnodeBufArenaMalloc(pPool, &pMemTable->arena, nSize + pRow->pTSRow->len);
   } else if (pRow->type == TSDBROW_COL_FMT) {
-    pNode = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, nSize);
+    pNode = (SMemSkipListNode *)vnodeBufArenaMalloc(pPool, &pMemTable->arena, nSize);
   } else {
     ASSERT(0);
   }
@@ -525,6 +820,8 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
   }
 
   pNode->level = level;
+  pNode->numOfPKs = pKey->key.numOfPKs;
+  pNode->key = (TSDBKEY){.version = pKey->version, .ts = pKey->key.ts};
   pNode->row = *pRow;
   if (pRow->type == TSDBROW_ROW_FMT) {
     pNode->row.pTSRow = (SRow *)((char *)pNode + nSize);
@@ -625,15 +922,22 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
-  // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
   STsdbRowKey       key;
 
-  // first row
+  // append the block as a column chunk if the rows come in order
   tsdbRowGetKey(&tRow, &key);
+  if (pBlockData->nRow >= MEM_MIN_CHUNK_ROWS && tbDataBlockInOrder(pBlockData) && tbDataCanAppend(pTbData, &key)) {
+    if ((code = tbDataAppendChunk(pMemTable, pTbData, pBlockData))) goto _exit;
+    pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+    key.key.ts = pBlockData->aTSKEY[pBlockData->nRow - 1];
+    goto _update;
+  }
+
+  // otherwise loop to add each row to the skiplist, first row
   tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
+  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, &key, 0))) goto _exit;
   pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
 
   // remain row
@@ -650,12 +954,13 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, &key, 1))) goto _exit;
 
       ++tRow.iRow;
     }
   }
 
+_update:
   if (key.key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.key.ts;
   }
@@ -686,11 +991,26 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
 
+  // append the rows as a column chunk if they come in order
+  tRow.pTSRow = aRow[0];
+  tsdbRowGetKey(&tRow, &key);
+  if (nRow >= MEM_MIN_CHUNK_ROWS && tbDataRowsInOrder(aRow, nRow) && tbDataCanAppend(pTbData, &key)) {
+    SBlockData *pBlockData = NULL;
+
+    code = tbDataBuildChunk(pMemTable, pTbData, version, aRow, nRow, &pBlockData);
+    if (code) goto _exit;
+    code = tbDataAppendChunk(pMemTable, pTbData, pBlockData);
+    if (code) goto _exit;
+
+    pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+    key.key.ts = aRow[nRow - 1]->ts;
+    goto _update;
+  }
+
   // backward put first data
   tRow.pTSRow = aRow[iRow++];
-  tsdbRowGetKey(&tRow, &key);
   tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, &key, 0);
   if (code) goto _exit;
 
   pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
@@ -709,13 +1029,14 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
+      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, &key, 1);
       if (code) goto _exit;
 
       iRow++;
     }
   }
 
+_update:
   if (key.key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.key.ts;
   }
@@ -734,7 +1055,7 @@ _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size + atomic_load_64(&pTbData->cl.size); }
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
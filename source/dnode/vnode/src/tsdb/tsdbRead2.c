@@ -371,6 +371,7 @@ void resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool needFree)
   pIter->order = order;
   pIter->index = -1;
   pIter->numOfBlocks = 0;
+  pIter->numOfPrefetched = 0;
   if (pIter->blockList == NULL) {
     pIter->blockList = taosArrayInit(4, sizeof(SFileDataBlockInfo));
   } else {
@@ -1295,6 +1296,28 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
+static int32_t doPrefetchFileBlock(void* param, const SFileDataBlockInfo* pBlockInfo) {
+  STsdbReader* pReader = param;
+  int32_t      code = tsdbDataFilePrefetchBlockData(pReader->pFileReader, pBlockInfo->blockOffset, pBlockInfo->blockSize);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbDebug("%p failed to read ahead file block, offset:%" PRId64 ", code:%s %s", pReader, pBlockInfo->blockOffset,
+              tstrerror(code), pReader->idStr);
+  }
+  return code;
+}
+
+// Read ahead the file ranges of the following blocks, so that the disk reading of them is overlapped with the
+// decompression and merging of the current block. The read ahead is only a hint to the os, if the following block is
+// skipped later, e.g., by the block SMA, its pages are simply left in the page cache.
+static void doPrefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  if (tsReadAheadBlocks <= 0) {
+    return;
+  }
+
+  int64_t budget = (int64_t)tsReadAheadSize * 1024 * 1024;
+  pReader->cost.prefetchBlocks += prefetchDataBlocks(pBlockIter, tsReadAheadBlocks, budget, doPrefetchFileBlock, pReader);
+}
+
 static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
                                    uint64_t uid) {
   int32_t   code = 0;
@@ -1315,6 +1338,8 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  doPrefetchFileBlocks(pReader, pBlockIter);
+
   SBrinRecord tmp;
   blockInfoToRecord(&tmp, pBlockInfo, pSup);
   SBrinRecord* pRecord = &tmp;
@@ -4446,14 +4471,14 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   tsdbDebug(
       "%p :io-cost summary: head-file:%" PRIu64 ", head-file time:%.2f ms, SMA:%" PRId64
-      " SMA-time:%.2f ms, fileBlocks:%" PRId64
+      " SMA-time:%.2f ms, fileBlocks:%" PRId64 ", prefetchBlocks:%" PRId64
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initSttBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
-      pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
+      pCost->prefetchBlocks, pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
       pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
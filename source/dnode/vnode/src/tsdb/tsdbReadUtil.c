@@ -504,6 +504,7 @@ static void freePkItem(void* pItem) {
 void clearDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
   pIter->index = -1;
   pIter->numOfBlocks = 0;
+  pIter->numOfPrefetched = 0;
 
   if (needFree) {
     taosArrayClearEx(pIter->blockList, freePkItem);
@@ -515,6 +516,7 @@ void clearDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
 void cleanupDataBlockIterator(SDataBlockIter* pIter, bool needFree) {
   pIter->index = -1;
   pIter->numOfBlocks = 0;
+  pIter->numOfPrefetched = 0;
   if (needFree) {
     taosArrayDestroyEx(pIter->blockList, freePkItem);
   } else {
@@ -649,6 +651,41 @@ bool blockIteratorNext(SDataBlockIter* pBlockIter, const char* idStr) {
   return true;
 }
 
+// Call fp for at most depth blocks after the current one in traverse order, until the total size of them exceeds the
+// budget. The blocks that fp was called for before are not passed again, e.g., when the current block comes after
+// the ones skipped by the block SMA. It stops at the first failure of fp, and returns the number of calls that
+// succeeded.
+int32_t prefetchDataBlocks(SDataBlockIter* pBlockIter, int32_t depth, int64_t budget, __prefetch_block_fn_t fp,
+                           void* param) {
+  bool    asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t pos = asc ? pBlockIter->index : (pBlockIter->numOfBlocks - 1 - pBlockIter->index);
+  int32_t end = TMIN(pos + 1 + depth, pBlockIter->numOfBlocks);
+  int64_t size = 0;
+  int32_t num = 0;
+
+  for (int32_t i = pos + 1; i < end; ++i) {
+    SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, asc ? i : (pBlockIter->numOfBlocks - 1 - i));
+
+    size += pBlockInfo->blockSize;
+    if (size > budget) {
+      break;
+    }
+
+    if (i < pBlockIter->numOfPrefetched) {
+      continue;
+    }
+
+    if (fp(param, pBlockInfo) != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    pBlockIter->numOfPrefetched = i + 1;
+    num += 1;
+  }
+
+  return num;
+}
+
 typedef enum {
   BLK_CHECK_CONTINUE = 0x1,
   BLK_CHECK_QUIT = 0x2,
@@ -139,6 +139,7 @@ typedef struct SResultBlockInfo {
 
 typedef struct SReadCostSummary {
   int64_t numOfBlocks;
+  int64_t prefetchBlocks;
   double  blockLoadTime;
   double  buildmemBlock;
   int64_t headFileLoad;
@@ -241,7 +242,8 @@ typedef struct SDataBlockIter {
   int32_t    index;
   SArray*    blockList;  // SArray<SFileDataBlockInfo>
   int32_t    order;
-  SDataBlk   block;  // current SDataBlk data
+  int32_t    numOfPrefetched;  // number of blocks in traverse order whose file range have been read ahead
+  SDataBlk   block;            // current SDataBlk data
 } SDataBlockIter;
 
 typedef struct SFileBlockDumpInfo {
@@ -339,6 +341,10 @@ void         clearBrinBlockIter(SBrinRecordIter* pIter);
 int32_t initBlockIterator(STsdbReader* pReader, SDataBlockIter* pBlockIter, int32_t numOfBlocks, SArray* pTableList);
 bool    blockIteratorNext(SDataBlockIter* pBlockIter, const char* idStr);
 
+typedef int32_t (*__prefetch_block_fn_t)(void* param, const SFileDataBlockInfo* pBlockInfo);
+int32_t prefetchDataBlocks(SDataBlockIter* pBlockIter, int32_t depth, int64_t budget, __prefetch_block_fn_t fp,
+                           void* param);
+
 // load tomb data API (stt/mem only for one table each, tomb data from data files are load for all tables at one time)
 void    loadMemTombData(SArray** ppMemDelData, STbData* pMemTbData, STbData* piMemTbData, int64_t ver);
 int32_t loadDataFileTombDataForAll(STsdbReader* pReader);
@@ -158,9 +158,18 @@ _exit:
   return code;
 }
 
+static int32_t tsdbFlushFilePages(STsdbFD *pFD, bool fsync);
+
 void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
+    if (pFD->nWPage > 0) {
+      int32_t code = tsdbFlushFilePages(pFD, false);
+      if (code) {
+        tsdbError("failed to write the queued pages of file %s since %s", pFD->path, tstrerror(code));
+      }
+    }
+    taosMemoryFree(pFD->pWBuf);
     taosMemoryFree(pFD->pBuf);
     // if (!pFD->s3File) {
     taosCloseFile(&pFD->pFD);
@@ -170,73 +179,152 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   }
 }
 
-static int32_t tsdbWriteFilePage(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey) {
-  int32_t code = 0;
+static void tsdbEncryptFilePage(uint8_t *pPage, int32_t szPage, int32_t encryptAlgorithm, char *encryptKey) {
+  if (encryptAlgorithm == DND_CA_SM4) {
+    // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
+    unsigned char PacketData[128];
+    int           NewLen;
+    int32_t       count = 0;
+    while (count < szPage) {
+      SCryptOpts opts = {0};
+      opts.len = 128;
+      opts.source = pPage + count;
+      opts.result = PacketData;
+      opts.unitLen = 128;
+      // strncpy(opts.key, tsEncryptKey, 16);
+      strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
 
-  if (!pFD->pFD) {
-    code = tsdbOpenFileImpl(pFD);
-    if (code) {
-      goto _exit;
+      NewLen = CBC_Encrypt(&opts);
+
+      memcpy(pPage + count, PacketData, NewLen);
+      count += NewLen;
     }
+    // tsdbDebug("CBC_Encrypt count:%d %s", count, __FUNCTION__);
   }
+}
 
-  if (pFD->pgno > 0) {
-    int64_t offset = PAGE_OFFSET(pFD->pgno, pFD->szPage);
-    if (pFD->s3File && pFD->lcn > 1) {
-      SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
-      int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->s3ChunkSize;
-      int64_t    chunkoffset = chunksize * (pFD->lcn - 1);
+static void tsdbDecryptFilePage(uint8_t *pPage, int32_t szPage, int32_t encryptAlgorithm, char *encryptKey) {
+  if (encryptAlgorithm == DND_CA_SM4) {
+    // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
+    unsigned char PacketData[128];
+    int           NewLen;
+
+    int32_t count = 0;
+    while (count < szPage) {
+      SCryptOpts opts = {0};
+      opts.len = 128;
+      opts.source = pPage + count;
+      opts.result = PacketData;
+      opts.unitLen = 128;
+      // strncpy(opts.key, tsEncryptKey, 16);
+      strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
+
+      NewLen = CBC_Decrypt(&opts);
 
-      offset -= chunkoffset;
+      memcpy(pPage + count, PacketData, NewLen);
+      count += NewLen;
     }
-    ASSERT(offset >= 0);
+    // tsdbDebug("CBC_Decrypt count:%d %s", count, __FUNCTION__);
+  }
+}
+
+// offset of a page in the local file, which only holds the chunks from lcn on
+static int64_t tsdbFilePageOffset(STsdbFD *pFD, int64_t pgno) {
+  int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
+  if (pFD->lcn > 1) {
+    SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
+    int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->s3ChunkSize;
+    int64_t    chunkoffset = chunksize * (pFD->lcn - 1);
 
-    int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
-    if (n < 0) {
+    offset -= chunkoffset;
+  }
+  ASSERT(offset >= 0);
+  return offset;
+}
+
+// submit the pages written in one batch, with the fsync linked after them if required
+static int32_t tsdbFlushFilePages(STsdbFD *pFD, bool fsync) {
+  int32_t   code = 0;
+  STdFileIo ios[TSDB_FD_WRITE_PAGES];
+
+  if (pFD->nWPage == 0) {
+    if (fsync && taosFsyncFile(pFD->pFD) < 0) {
       code = TAOS_SYSTEM_ERROR(errno);
-      goto _exit;
     }
+    return code;
+  }
+
+  for (int32_t i = 0; i < pFD->nWPage; ++i) {
+    int64_t offset = PAGE_OFFSET(pFD->aWPgno[i], pFD->szPage);
+    if (pFD->s3File && pFD->lcn > 1) {
+      offset = tsdbFilePageOffset(pFD, pFD->aWPgno[i]);
+    }
+    ASSERT(offset >= 0);
 
-    taosCalcChecksumAppend(0, pFD->pBuf, pFD->szPage);
+    ios[i] = (STdFileIo){
+        .pFile = pFD->pFD, .buf = pFD->pWBuf + (int64_t)i * pFD->szPage, .count = pFD->szPage, .offset = offset};
+  }
 
-    if (encryptAlgorithm == DND_CA_SM4) {
-      // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
-      unsigned char PacketData[128];
-      int           NewLen;
-      int32_t       count = 0;
-      while (count < pFD->szPage) {
-        SCryptOpts opts = {0};
-        opts.len = 128;
-        opts.source = pFD->pBuf + count;
-        opts.result = PacketData;
-        opts.unitLen = 128;
-        // strncpy(opts.key, tsEncryptKey, 16);
-        strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
+  // a short write fails with EIO
+  if (taosWriteFileBatch(ios, pFD->nWPage, fsync) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  }
+  pFD->nWPage = 0;
 
-        NewLen = CBC_Encrypt(&opts);
+  return code;
+}
 
-        memcpy(pFD->pBuf + count, PacketData, NewLen);
-        count += NewLen;
-      }
-      // tsdbDebug("CBC_Encrypt count:%d %s", count, __FUNCTION__);
-    }
+// the page is sealed and queued, the queue is submitted when it is full, the file is synced or read
+static int32_t tsdbWriteFilePage(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey, bool fsync) {
+  int32_t code = 0;
 
-    n = taosWriteFile(pFD->pFD, pFD->pBuf, pFD->szPage);
-    if (n < 0) {
-      code = TAOS_SYSTEM_ERROR(errno);
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) {
       goto _exit;
     }
+  }
+
+  if (pFD->pgno > 0) {
+    if (pFD->pWBuf == NULL) {
+      pFD->maxWPage = TMAX(1, TMIN(TSDB_FD_WRITE_PAGES, TSDB_FD_WRITE_SIZE / pFD->szPage));
+      pFD->pWBuf = taosMemoryMalloc((int64_t)pFD->maxWPage * pFD->szPage);
+      if (pFD->pWBuf == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+    }
+
+    uint8_t *pPage = pFD->pWBuf + (int64_t)pFD->nWPage * pFD->szPage;
+    memcpy(pPage, pFD->pBuf, pFD->szPage);
+    taosCalcChecksumAppend(0, pPage, pFD->szPage);
+    tsdbEncryptFilePage(pPage, pFD->szPage, encryptAlgorithm, encryptKey);
+    pFD->aWPgno[pFD->nWPage++] = pFD->pgno;
 
     if (pFD->szFile < pFD->pgno) {
       pFD->szFile = pFD->pgno;
     }
+    pFD->pgno = 0;
+  }
+
+  if (fsync || pFD->nWPage >= pFD->maxWPage) {
+    code = tsdbFlushFilePages(pFD, fsync);
   }
-  pFD->pgno = 0;
 
 _exit:
   return code;
 }
 
+static int32_t tsdbCheckFilePage(uint8_t *pPage, int64_t pgno, int32_t szPage, int32_t encryptAlgorithm,
+                                 char *encryptKey) {
+  tsdbDecryptFilePage(pPage, szPage, encryptAlgorithm, encryptKey);
+
+  if (pgno > 1 && !taosCheckChecksumWhole(pPage, szPage)) {
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
+  return 0;
+}
+
 static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code = 0;
 
@@ -248,37 +336,14 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
     }
   }
 
-  int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
-  if (pFD->lcn > 1) {
-    SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
-    int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->s3ChunkSize;
-    int64_t    chunkoffset = chunksize * (pFD->lcn - 1);
-
-    offset -= chunkoffset;
+  // the page may be one of those queued
+  if (pFD->nWPage > 0) {
+    code = tsdbFlushFilePages(pFD, false);
+    if (code) goto _exit;
   }
-  ASSERT(offset >= 0);
-  /*
-  if (pFD->s3File) {
-    LRUHandle *handle = NULL;
-
-    pFD->blkno = (pgno + tsS3BlockSize - 1) / tsS3BlockSize;
-    code = tsdbCacheGetBlockS3(pFD->pTsdb->bCache, pFD, &handle);
-    if (code != TSDB_CODE_SUCCESS || handle == NULL) {
-      tsdbCacheRelease(pFD->pTsdb->bCache, handle);
-      if (code == TSDB_CODE_SUCCESS && !handle) {
-        code = TSDB_CODE_OUT_OF_MEMORY;
-      }
-      goto _exit;
-    }
 
-    uint8_t *pBlock = (uint8_t *)taosLRUCacheValue(pFD->pTsdb->bCache, handle);
+  int64_t offset = tsdbFilePageOffset(pFD, pgno);
 
-    int64_t blk_offset = (pFD->blkno - 1) * tsS3BlockSize * pFD->szPage;
-    memcpy(pFD->pBuf, pBlock + (offset - blk_offset), pFD->szPage);
-
-    tsdbCacheRelease(pFD->pTsdb->bCache, handle);
-  } else {
-  */
   // seek
   int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
   if (n < 0) {
@@ -295,40 +360,66 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
     code = TSDB_CODE_FILE_CORRUPTED;
     goto _exit;
   }
-  //}
 
-  if (encryptAlgorithm == DND_CA_SM4) {
-    // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
-    unsigned char PacketData[128];
-    int           NewLen;
+  // check
+  code = tsdbCheckFilePage(pFD->pBuf, pgno, pFD->szPage, encryptAlgorithm, encryptKey);
+  if (code) goto _exit;
 
-    int32_t count = 0;
-    while (count < pFD->szPage) {
-      SCryptOpts opts = {0};
-      opts.len = 128;
-      opts.source = pFD->pBuf + count;
-      opts.result = PacketData;
-      opts.unitLen = 128;
-      // strncpy(opts.key, tsEncryptKey, 16);
-      strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
+  pFD->pgno = pgno;
 
-      NewLen = CBC_Decrypt(&opts);
+_exit:
+  return code;
+}
 
-      memcpy(pFD->pBuf + count, PacketData, NewLen);
-      count += NewLen;
-    }
-    // tsdbDebug("CBC_Decrypt count:%d %s", count, __FUNCTION__);
+// read pages [pgno, pgno + nPage) in one batch, the last one is kept in pFD->pBuf
+static int32_t tsdbReadFilePages(STsdbFD *pFD, int64_t pgno, int32_t nPage, uint8_t *pPages,
+                                 int32_t encryptAlgorithm, char *encryptKey) {
+  int32_t    code = 0;
+  STdFileIo  stackIos[8];
+  STdFileIo *ios = stackIos;
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) return code;
   }
 
-  // check
-  if (pgno > 1 && !taosCheckChecksumWhole(pFD->pBuf, pFD->szPage)) {
-    code = TSDB_CODE_FILE_CORRUPTED;
+  if (nPage > tListLen(stackIos)) {
+    ios = taosMemoryMalloc(sizeof(STdFileIo) * nPage);
+    if (ios == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < nPage; ++i) {
+    ios[i] = (STdFileIo){.pFile = pFD->pFD,
+                         .buf = pPages + (int64_t)i * pFD->szPage,
+                         .count = pFD->szPage,
+                         .offset = tsdbFilePageOffset(pFD, pgno + i)};
+  }
+
+  if (taosReadFileBatch(ios, nPage) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
     goto _exit;
   }
 
-  pFD->pgno = pgno;
+  for (int32_t i = 0; i < nPage; ++i) {
+    if (ios[i].result < 0) {
+      code = TAOS_SYSTEM_ERROR((int32_t)-ios[i].result);
+      goto _exit;
+    } else if (ios[i].result < pFD->szPage) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    code = tsdbCheckFilePage(ios[i].buf, pgno + i, pFD->szPage, encryptAlgorithm, encryptKey);
+    if (code) goto _exit;
+  }
+
+  memcpy(pFD->pBuf, pPages + (int64_t)(nPage - 1) * pFD->szPage, pFD->szPage);
+  pFD->pgno = pgno + nPage - 1;
 
 _exit:
+  if (ios != stackIos) {
+    taosMemoryFree(ios);
+  }
   return code;
 }
 
@@ -342,7 +433,7 @@ int32_t tsdbWriteFile(STsdbFD *pFD, int64_t offset, const uint8_t *pBuf, int64_t
 
   do {
     if (pFD->pgno != pgno) {
-      code = tsdbWriteFilePage(pFD, encryptAlgorithm, encryptKey);
+      code = tsdbWriteFilePage(pFD, encryptAlgorithm, encryptKey, false);
       if (code) goto _exit;
 
       if (pgno <= pFD->szFile) {
@@ -377,6 +468,44 @@ static int32_t tsdbReadFileImp(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int6
   // ASSERT(pgno && pgno <= pFD->szFile);
   ASSERT(bOffset < szPgCont);
 
+  // with io_uring, the pages not cached are read in one batch when the range spans more than one of them, otherwise
+  // they are read one by one into the page buffer, which saves the copy from a batch buffer
+  if (taosFileIoUringEnabled()) {
+    int32_t nPage = (bOffset + size + szPgCont - 1) / szPgCont;
+    if (pFD->pgno == pgno) {
+      int64_t nRead = TMIN(szPgCont - bOffset, size);
+      memcpy(pBuf, pFD->pBuf + bOffset, nRead);
+
+      n += nRead;
+      pgno++;
+      bOffset = 0;
+      nPage--;
+    }
+
+    if (nPage > 1) {
+      uint8_t *pPages = taosMemoryMalloc((int64_t)nPage * pFD->szPage);
+      if (pPages == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+
+      code = tsdbReadFilePages(pFD, pgno, nPage, pPages, encryptAlgorithm, encryptKey);
+      if (code) {
+        taosMemoryFree(pPages);
+        goto _exit;
+      }
+
+      for (int32_t i = 0; i < nPage; ++i) {
+        int64_t nRead = TMIN(szPgCont - bOffset, size - n);
+        memcpy(pBuf + n, pPages + (int64_t)i * pFD->szPage + bOffset, nRead);
+
+        n += nRead;
+        bOffset = 0;
+      }
+      taosMemoryFree(pPages);
+    }
+  }
+
   while (n < size) {
     if (pFD->pgno != pgno) {
       code = tsdbReadFilePage(pFD, pgno, encryptAlgorithm, encryptKey);
@@ -581,6 +710,11 @@ int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size,
     }
   }
 
+  if (pFD->nWPage > 0) {
+    code = tsdbFlushFilePages(pFD, false);
+    if (code) goto _exit;
+  }
+
   if (pFD->s3File && pFD->lcn > 1 /* && tsS3BlockSize < 0*/) {
     return tsdbReadFileS3(pFD, offset, pBuf, size, szHint);
   } else {
@@ -604,6 +738,40 @@ int32_t tsdbReadFileToBuffer(STsdbFD *pFD, int64_t offset, int64_t size, SBuffer
   return code;
 }
 
+// the file range of the whole pages that hold the logic range [offset, offset + size)
+void tsdbFilePagesOfRange(int32_t szPage, int64_t offset, int64_t size, int64_t *fOffset, int64_t *fSize) {
+  int64_t fStart = PAGE_OFFSET(OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset, szPage), szPage), szPage);
+  int64_t fLast = LOGIC_TO_FILE_OFFSET(offset + size - 1, szPage);
+  int64_t fEnd = PAGE_OFFSET(OFFSET_PGNO(fLast, szPage) + 1, szPage);
+
+  *fOffset = fStart;
+  *fSize = fEnd - fStart;
+}
+
+int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size) {
+  int32_t code = 0;
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) {
+      return code;
+    }
+  }
+
+  // the remote file is loaded by chunks on demand, nothing to do with the page cache of the os
+  if (pFD->s3File && pFD->lcn > 1) {
+    return code;
+  }
+
+  int64_t fOffset = 0;
+  int64_t fSize = 0;
+  tsdbFilePagesOfRange(pFD->szPage, offset, size, &fOffset, &fSize);
+  if (taosPrefetchFile(pFD->pFD, fOffset, fSize) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  }
+
+  return code;
+}
+
 int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code = 0;
   /*
@@ -612,14 +780,9 @@ int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey)
     return code;
   }
   */
-  code = tsdbWriteFilePage(pFD, encryptAlgorithm, encryptKey);
+  code = tsdbWriteFilePage(pFD, encryptAlgorithm, encryptKey, true);
   if (code) goto _exit;
 
-  if (taosFsyncFile(pFD->pFD) < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _exit;
-  }
-
 _exit:
   return code;
 }
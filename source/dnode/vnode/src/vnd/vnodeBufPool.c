@@ -193,6 +193,36 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
   return p;
 }
 
+#define VNODE_BUF_ARENA_SIZE 4096
+
+void *vnodeBufArenaMalloc(SVBufPool *pPool, SVBufArena *pArena, int size) {
+  void *p = NULL;
+
+  size = ALIGN8(size);
+  if (size > VNODE_BUF_ARENA_SIZE / 4) {
+    // large ones go to the pool directly, so that the chunk is not wasted
+    return vnodeBufPoolMallocAligned(pPool, size);
+  } else if (pPool->lock) {
+    // the pool of a rsma vnode is shared by the threads inserting to its memtable concurrently, while the arena is not
+    // locked, so the allocations go to the locked pool
+    return vnodeBufPoolMallocAligned(pPool, size);
+  }
+
+  if (pArena->end - pArena->ptr < size) {
+    // the rest of the chunk is dropped, it is at most a quarter of the chunk
+    pArena->ptr = vnodeBufPoolMallocAligned(pPool, VNODE_BUF_ARENA_SIZE);
+    if (pArena->ptr == NULL) {
+      pArena->end = NULL;
+      return NULL;
+    }
+    pArena->end = pArena->ptr + VNODE_BUF_ARENA_SIZE;
+  }
+
+  p = pArena->ptr;
+  pArena->ptr += size;
+  return p;
+}
+
 void vnodeBufPoolFree(SVBufPool *pPool, void *p) {
   // uint8_t       *ptr = (uint8_t *)p;
   // SVBufPoolNode *pNode;
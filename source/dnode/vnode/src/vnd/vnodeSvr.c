@@ -1048,6 +1048,10 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
   STbUidStore       *pStore = NULL;
   SArray            *tbUids = NULL;
   SArray            *tbNames = NULL;
+  SVCreateTbReq    **ppCreateReqs = NULL;
+  int32_t           *aCreateCode = NULL;
+  STableMetaRsp    **ppMetaRsps = NULL;
+  int32_t            nCreateReqs = 0;
 
   pRsp->msgType = TDMT_VND_CREATE_TABLE_RSP;
   pRsp->code = TSDB_CODE_SUCCESS;
@@ -1065,16 +1069,19 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
   rsp.pArray = taosArrayInit(req.nReqs, sizeof(cRsp));
   tbUids = taosArrayInit(req.nReqs, sizeof(int64_t));
   tbNames = taosArrayInit(req.nReqs, sizeof(char *));
-  if (rsp.pArray == NULL || tbUids == NULL || tbNames == NULL) {
+  ppCreateReqs = taosMemoryMalloc(req.nReqs * sizeof(SVCreateTbReq *));
+  aCreateCode = taosMemoryMalloc(req.nReqs * sizeof(int32_t));
+  ppMetaRsps = taosMemoryMalloc(req.nReqs * sizeof(STableMetaRsp *));
+  if (rsp.pArray == NULL || tbUids == NULL || tbNames == NULL ||
+      (req.nReqs > 0 && (ppCreateReqs == NULL || aCreateCode == NULL || ppMetaRsps == NULL))) {
     rcode = -1;
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     goto _exit;
   }
 
-  // loop to create table
+  // loop to validate hash, and the tables are created in a batch
   for (int32_t iReq = 0; iReq < req.nReqs; iReq++) {
     pCreateReq = req.pReqs + iReq;
-    memset(&cRsp, 0, sizeof(cRsp));
 
     if (tsEnableAudit && tsEnableAuditCreateTable) {
       char *str = taosMemoryCalloc(1, TSDB_TABLE_FNAME_LEN);
@@ -1090,18 +1097,35 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
     // validate hash
     sprintf(tbName, "%s.%s", pVnode->config.dbname, pCreateReq->name);
     if (vnodeValidateTableHash(pVnode, tbName) < 0) {
+      vError("vgId:%d create-table:%s failed due to hash value mismatch", TD_VID(pVnode), tbName);
+      continue;
+    }
+
+    ppCreateReqs[nCreateReqs++] = pCreateReq;
+  }
+
+  // do create table
+  if (nCreateReqs > 0) {
+    metaCreateTables(pVnode->pMeta, ver, ppCreateReqs, nCreateReqs, aCreateCode, ppMetaRsps, NULL);
+  }
+
+  for (int32_t iReq = 0, iCreate = 0; iReq < req.nReqs; iReq++) {
+    pCreateReq = req.pReqs + iReq;
+    memset(&cRsp, 0, sizeof(cRsp));
+
+    if (iCreate >= nCreateReqs || ppCreateReqs[iCreate] != pCreateReq) {
       cRsp.code = TSDB_CODE_VND_HASH_MISMATCH;
       taosArrayPush(rsp.pArray, &cRsp);
-      vError("vgId:%d create-table:%s failed due to hash value mismatch", TD_VID(pVnode), tbName);
       continue;
     }
 
-    // do create table
-    if (metaCreateTable(pVnode->pMeta, ver, pCreateReq, &cRsp.pMeta) < 0) {
-      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && terrno == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+    cRsp.pMeta = ppMetaRsps[iCreate];
+    int32_t createCode = aCreateCode[iCreate++];
+    if (createCode != TSDB_CODE_SUCCESS) {
+      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && createCode == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
         cRsp.code = TSDB_CODE_SUCCESS;
       } else {
-        cRsp.code = terrno;
+        cRsp.code = createCode;
       }
     } else {
       cRsp.code = TSDB_CODE_SUCCESS;
@@ -1167,6 +1191,9 @@ _exit:
   }
   taosArrayDestroyEx(rsp.pArray, tFreeSVCreateTbRsp);
   taosArrayDestroy(tbUids);
+  taosMemoryFree(ppCreateReqs);
+  taosMemoryFree(aCreateCode);
+  taosMemoryFree(ppMetaRsps);
   tDecoderClear(&decoder);
   tEncoderClear(&encoder);
   taosArrayDestroyP(tbNames, taosMemoryFree);
@@ -1610,16 +1637,97 @@ static int32_t vnodeRebuildSubmitReqMsg(SSubmitReq2 *pSubmitReq, void **ppMsg) {
   return code;
 }
 
+// the run of child tables auto-created from the iTbData-th table of the submit are created in a batch
+static void vnodeBatchCreateSubmitTables(SVnode *pVnode, int64_t ver, SSubmitReq2 *pSubmitReq, int32_t iTbData,
+                                         SSubmitCreateCtx *pCtx) {
+  int32_t         nTbData = TARRAY_SIZE(pSubmitReq->aSubmitTbData);
+  int32_t         nReqs = 0;
+  int32_t         nDone = 0;
+  SVCreateTbReq **ppReqs = NULL;
+
+  pCtx->end = iTbData;
+  for (int32_t i = iTbData; i < nTbData; ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
+    if (pSubmitTbData->pCreateTbReq == NULL || pSubmitTbData->pCreateTbReq->type != TSDB_CHILD_TABLE) break;
+    nReqs++;
+  }
+  if (nReqs < 2) return;
+
+  if (pCtx->aCode == NULL) {
+    pCtx->aCode = taosMemoryCalloc(nTbData, sizeof(int32_t));
+    pCtx->ppMetaRsps = taosMemoryCalloc(nTbData, sizeof(STableMetaRsp *));
+  }
+  ppReqs = taosMemoryMalloc(nReqs * sizeof(SVCreateTbReq *));
+  if (pCtx->aCode == NULL || pCtx->ppMetaRsps == NULL || ppReqs == NULL) {
+    taosMemoryFree(ppReqs);
+    return;
+  }
+
+  for (int32_t i = 0; i < nReqs; ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, iTbData + i);
+    ppReqs[i] = pSubmitTbData->pCreateTbReq;
+  }
+
+  metaCreateTables(pVnode->pMeta, ver, ppReqs, nReqs, pCtx->aCode + iTbData, pCtx->ppMetaRsps + iTbData, &nDone);
+  terrno = 0;
+
+  pCtx->end = iTbData + nDone;
+  pCtx->nBatched += nDone;
+  taosMemoryFree(ppReqs);
+}
+
+/*
+ * Create the table auto-created by the iTbData-th table of the submit, the tables are handled in the order of the
+ * submit. The run of child tables auto-created from it are created in a batch, and from the first one that fails in
+ * the batch, they are created one by one, so the tables after the first error are not created.
+ */
+int32_t vnodeCreateSubmitTable(SVnode *pVnode, int64_t ver, SSubmitReq2 *pSubmitReq, int32_t iTbData,
+                               SSubmitCreateCtx *pCtx, STableMetaRsp **ppMetaRsp) {
+  SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, iTbData);
+
+  if (iTbData >= pCtx->end) {
+    vnodeBatchCreateSubmitTables(pVnode, ver, pSubmitReq, iTbData, pCtx);
+  }
+
+  if (iTbData < pCtx->end) {
+    *ppMetaRsp = pCtx->ppMetaRsps[iTbData];
+    pCtx->ppMetaRsps[iTbData] = NULL;
+    return pCtx->aCode[iTbData];
+  }
+
+  if (metaCreateTable(pVnode->pMeta, ver, pSubmitTbData->pCreateTbReq, ppMetaRsp) == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = terrno;
+  terrno = 0;
+  return code;
+}
+
+void vnodeClearSubmitCreateCtx(SSubmitCreateCtx *pCtx, int32_t nTbData) {
+  if (pCtx->ppMetaRsps != NULL) {
+    for (int32_t i = 0; i < nTbData; ++i) {
+      if (pCtx->ppMetaRsps[i] != NULL) {
+        tFreeSTableMetaRsp(pCtx->ppMetaRsps[i]);
+        taosMemoryFree(pCtx->ppMetaRsps[i]);
+      }
+    }
+  }
+  taosMemoryFreeClear(pCtx->aCode);
+  taosMemoryFreeClear(pCtx->ppMetaRsps);
+}
+
 static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, int32_t len, SRpcMsg *pRsp,
                                      SRpcMsg *pOriginalMsg) {
   int32_t code = 0;
   terrno = 0;
 
-  SSubmitReq2 *pSubmitReq = &(SSubmitReq2){0};
-  SSubmitRsp2 *pSubmitRsp = &(SSubmitRsp2){0};
-  SArray      *newTbUids = NULL;
-  int32_t      ret;
-  SEncoder     ec = {0};
+  SSubmitReq2     *pSubmitReq = &(SSubmitReq2){0};
+  SSubmitRsp2     *pSubmitRsp = &(SSubmitRsp2){0};
+  SArray          *newTbUids = NULL;
+  SSubmitCreateCtx createCtx = {0};
+  int32_t          ret;
+  SEncoder         ec = {0};
 
   pRsp->code = TSDB_CODE_SUCCESS;
 
@@ -1780,7 +1888,8 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
       SVCreateTbRsp *pCreateTbRsp = taosArrayReserve(pSubmitRsp->aCreateTbRsp, 1);
 
       // create table
-      if (metaCreateTable(pVnode->pMeta, ver, pSubmitTbData->pCreateTbReq, &pCreateTbRsp->pMeta) == 0) {
+      int32_t createCode = vnodeCreateSubmitTable(pVnode, ver, pSubmitReq, i, &createCtx, &pCreateTbRsp->pMeta);
+      if (createCode == TSDB_CODE_SUCCESS) {
         // create table success
 
         if (newTbUids == NULL &&
@@ -1795,13 +1904,12 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
           vnodeUpdateMetaRsp(pVnode, pCreateTbRsp->pMeta);
         }
       } else {  // create table failed
-        if (terrno != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
-          code = terrno;
+        if (createCode != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+          code = createCode;
           vError("vgId:%d failed to create table:%s, code:%s", TD_VID(pVnode), pSubmitTbData->pCreateTbReq->name,
-                 tstrerror(terrno));
+                 tstrerror(createCode));
           goto _exit;
         }
-        terrno = 0;
         pSubmitTbData->uid = pSubmitTbData->pCreateTbReq->uid;  // update uid if table exist for using below
       }
     }
@@ -1873,6 +1981,7 @@ _exit:
 
   // clear
   taosArrayDestroy(newTbUids);
+  vnodeClearSubmitCreateCtx(&createCtx, taosArrayGetSize(pSubmitReq->aSubmitTbData));
   tDestroySubmitReq(pSubmitReq, 0 == pMsg->version ? TSDB_MSG_FLG_CMPT : TSDB_MSG_FLG_DECODE);
   tDestroySSubmitRsp2(pSubmitRsp, TSDB_MSG_FLG_ENCODE);
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "tsdb.h"
+#include "tsdbDef.h"
+#include "vnd.h"
+
+namespace {
+
+const char *fileTestPath = "./tsdbFileTest.data";
+
+// the page-wise file of a tsdb in a vnode which only has the config
+class TsdbFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(pVnode, nullptr);
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(pTsdb, nullptr);
+    pTsdb->pVnode = pVnode;
+    setPageSize(4096);
+  }
+
+  void TearDown() override {
+    tsdbCloseFile(&pFD);
+    taosRemoveFile(fileTestPath);
+    taosMemoryFree(pTsdb);
+    taosMemoryFree(pVnode);
+  }
+
+  void setPageSize(int32_t szPage) {
+    pVnode->config.tsdbPageSize = szPage;
+    content = PAGE_CONTENT_SIZE(szPage);
+  }
+
+  void openFile(int32_t flag) {
+    tsdbCloseFile(&pFD);
+    ASSERT_EQ(tsdbOpenFile(fileTestPath, pTsdb, flag, &pFD, 0), 0);
+  }
+
+  // the size of the file on the disk, in pages
+  int64_t pagesOnDisk() {
+    int64_t size = 0;
+    EXPECT_EQ(taosStatFile(fileTestPath, &size, NULL, NULL), 0);
+    return size / pVnode->config.tsdbPageSize;
+  }
+
+  void writeFile(int64_t offset, const std::vector<uint8_t> &data, int64_t from, int64_t size) {
+    ASSERT_EQ(tsdbWriteFile(pFD, offset, data.data() + from, size, 0, NULL), 0);
+  }
+
+  void checkFile(const std::vector<uint8_t> &data, int64_t offset, int64_t size) {
+    std::vector<uint8_t> buf(size);
+    ASSERT_EQ(tsdbReadFile(pFD, offset, buf.data(), size, 0, 0, NULL), 0);
+    ASSERT_TRUE(std::equal(buf.begin(), buf.end(), data.begin() + offset));
+  }
+
+  std::vector<uint8_t> randomData(int64_t size) {
+    std::mt19937         gen(20241017);
+    std::vector<uint8_t> data(size);
+    for (auto &c : data) {
+      c = (uint8_t)gen();
+    }
+    return data;
+  }
+
+  SVnode  *pVnode = NULL;
+  STsdb   *pTsdb = NULL;
+  STsdbFD *pFD = NULL;
+  int64_t  content = 0;
+};
+
+}  // namespace
+
+TEST_F(TsdbFileTest, pagesWrittenInBatch) {
+  std::vector<uint8_t> data = randomData(40 * content);
+
+  openFile(TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+
+  // a page is queued when the write moves to the next one, and the queue is written when it is full
+  writeFile(0, data, 0, 3 * content + 10);
+  ASSERT_EQ(pFD->nWPage, 3);
+  ASSERT_EQ(pagesOnDisk(), 0);
+
+  writeFile(3 * content + 10, data, 3 * content + 10, 14 * content);
+  ASSERT_EQ(pFD->maxWPage, TSDB_FD_WRITE_PAGES);
+  ASSERT_EQ(pFD->nWPage, 1);
+  ASSERT_EQ(pagesOnDisk(), TSDB_FD_WRITE_PAGES);
+
+  // a page queued is written before it is read back to be updated, along with the others queued
+  std::vector<uint8_t> update = randomData(content);
+  std::copy(update.begin(), update.begin() + 200, data.begin() + 17 * content - 100);
+  writeFile(17 * content - 100, data, 17 * content - 100, 200);
+  ASSERT_EQ(pFD->nWPage, 0);
+  ASSERT_EQ(pagesOnDisk(), 18);
+
+  // so is the page written but not queued yet
+  writeFile(17 * content + 100, data, 17 * content + 100, 15 * content);
+  std::copy(update.begin() + 200, update.begin() + 300, data.begin() + 32 * content - 50);
+  writeFile(32 * content - 50, data, 32 * content - 50, 100);
+
+  // the fsync writes all the pages, and the current one
+  writeFile(32 * content + 50, data, 32 * content + 50, 8 * content - 50);
+  ASSERT_EQ(tsdbFsyncFile(pFD, 0, NULL), 0);
+  ASSERT_EQ(pFD->nWPage, 0);
+  ASSERT_EQ(pagesOnDisk(), 40);
+
+  openFile(TD_FILE_READ);
+  checkFile(data, 0, 40 * content);
+}
+
+TEST_F(TsdbFileTest, batchOfLargePages) {
+  // the queue holds the pages of TSDB_FD_WRITE_SIZE bytes at most, and one page at least
+  for (int32_t szPage : {256 * 1024, TSDB_FD_WRITE_SIZE, 2 * TSDB_FD_WRITE_SIZE}) {
+    setPageSize(szPage);
+    std::vector<uint8_t> data = randomData(6 * content);
+
+    openFile(TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+    writeFile(0, data, 0, 6 * content);
+    ASSERT_EQ(pFD->maxWPage, TMAX(1, TSDB_FD_WRITE_SIZE / szPage));
+    ASSERT_EQ(pagesOnDisk(), 5 / pFD->maxWPage * pFD->maxWPage);
+    ASSERT_EQ(tsdbFsyncFile(pFD, 0, NULL), 0);
+    ASSERT_EQ(pagesOnDisk(), 6);
+
+    openFile(TD_FILE_READ);
+    checkFile(data, 0, 6 * content);
+  }
+}
+
+TEST_F(TsdbFileTest, queuedPagesWrittenOnClose) {
+  std::vector<uint8_t> data = randomData(4 * content);
+
+  openFile(TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+  writeFile(0, data, 0, 4 * content);
+  ASSERT_EQ(pFD->nWPage, 3);
+  tsdbCloseFile(&pFD);
+  ASSERT_EQ(pagesOnDisk(), 3);
+
+  openFile(TD_FILE_READ);
+  checkFile(data, 0, 3 * content);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
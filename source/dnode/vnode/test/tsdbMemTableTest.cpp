@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "tsdb.h"
+#include "vnd.h"
+
+namespace {
+
+const tb_uid_t memTestUid = 10086;
+
+struct SMemTestRow {
+  TSKEY   ts;
+  int64_t version;
+  int32_t val;
+
+  bool operator<(const SMemTestRow &r) const { return ts < r.ts || (ts == r.ts && version < r.version); }
+  bool operator==(const SMemTestRow &r) const { return ts == r.ts && version == r.version && val == r.val; }
+};
+
+// a memtable in a vnode which only has the buffer pools, the rows are submitted in the column format, which goes
+// without the table schema
+class TsdbMemTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(pVnode, nullptr);
+    pVnode->config.szBuf = (int64_t)VNODE_BUFPOOL_SEGMENTS * 1024 * 1024;
+    pVnode->config.tsdbCfg.slLevel = 5;
+    taosThreadMutexInit(&pVnode->mutex, NULL);
+    taosThreadCondInit(&pVnode->poolNotEmpty, NULL);
+    ASSERT_EQ(vnodeOpenBufPool(pVnode), 0);
+    pVnode->inUse = pVnode->freeList;
+    pVnode->freeList = pVnode->inUse->freeNext;
+    pVnode->inUse->freeNext = NULL;
+    pVnode->inUse->nRef = 1;
+
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    ASSERT_NE(pTsdb, nullptr);
+    pTsdb->pVnode = pVnode;
+    ASSERT_EQ(tsdbMemTableCreate(pTsdb, &pTsdb->mem), 0);
+  }
+
+  void TearDown() override {
+    if (pTsdb) {
+      tsdbMemTableDestroy(pTsdb->mem, false);
+      taosMemoryFree(pTsdb);
+    }
+    if (pVnode) {
+      vnodeCloseBufPool(pVnode);
+      taosThreadCondDestroy(&pVnode->poolNotEmpty);
+      taosThreadMutexDestroy(&pVnode->mutex);
+      taosMemoryFree(pVnode);
+    }
+  }
+
+  void insert(int64_t version, const std::vector<TSKEY> &tsList) {
+    SSubmitTbData tbData = {0};
+    tbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    tbData.uid = memTestUid;
+    tbData.aCol = taosArrayInit(2, sizeof(SColData));
+    ASSERT_NE(tbData.aCol, nullptr);
+
+    SColData *aColData = (SColData *)taosArrayReserve(tbData.aCol, 2);
+    tColDataInit(&aColData[0], PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, 0);
+    tColDataInit(&aColData[1], PRIMARYKEY_TIMESTAMP_COL_ID + 1, TSDB_DATA_TYPE_INT, 0);
+    for (TSKEY ts : tsList) {
+      SMemTestRow row = {ts, version, (int32_t)rows.size()};
+      SValue      value = {.type = TSDB_DATA_TYPE_TIMESTAMP, .val = ts};
+      SColVal     cv = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, value);
+      ASSERT_EQ(tColDataAppendValue(&aColData[0], &cv), 0);
+
+      value = {.type = TSDB_DATA_TYPE_INT, .val = row.val};
+      cv = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID + 1, value);
+      ASSERT_EQ(tColDataAppendValue(&aColData[1], &cv), 0);
+      rows.push_back(row);
+    }
+
+    int32_t affectedRows = 0;
+    ASSERT_EQ(tsdbInsertTableData(pTsdb, version, &tbData, &affectedRows), 0);
+    ASSERT_EQ(affectedRows, (int32_t)tsList.size());
+    taosArrayDestroyEx(tbData.aCol, tColDataDestroy);
+  }
+
+  STbData *tbData() { return tsdbGetTbDataFromMemTable(pTsdb->mem, 0, memTestUid); }
+
+  // collect the rows from the iterator opened at pFrom
+  std::vector<SMemTestRow> scan(STsdbRowKey *pFrom, int8_t backward) {
+    std::vector<SMemTestRow> res;
+    STbDataIter              iter = {0};
+
+    tsdbTbDataIterOpen(tbData(), pFrom, backward, &iter);
+    for (TSDBROW *pRow = tsdbTbDataIterGet(&iter); pRow != NULL; pRow = tsdbTbDataIterGet(&iter)) {
+      SColVal cv;
+      EXPECT_EQ(pRow->type, TSDBROW_COL_FMT);
+      tColDataGetValue(&pRow->pBlockData->aColData[0], pRow->iRow, &cv);
+      res.push_back({TSDBROW_TS(pRow), TSDBROW_VERSION(pRow), (int32_t)cv.value.val});
+      if (!tsdbTbDataIterNext(&iter)) break;
+    }
+    return res;
+  }
+
+  // the merged rows of the chunks and the skiplist shall be the same as the sorted rows, from every key
+  void check(const std::vector<STsdbRowKey> &froms) {
+    std::vector<SMemTestRow> expect = rows;
+    std::sort(expect.begin(), expect.end());
+
+    ASSERT_EQ(tsdbGetNRowsInTbData(tbData()), (int32_t)expect.size());
+    ASSERT_EQ(scan(NULL, 0), expect);
+    ASSERT_EQ(scan(NULL, 1), std::vector<SMemTestRow>(expect.rbegin(), expect.rend()));
+
+    for (STsdbRowKey from : froms) {
+      SMemTestRow key = {from.key.ts, from.version, 0};
+
+      // forward from the first row not less than the key
+      std::vector<SMemTestRow> fwd(std::lower_bound(expect.begin(), expect.end(), key), expect.end());
+      ASSERT_EQ(scan(&from, 0), fwd) << "forward from ts:" << from.key.ts << " version:" << from.version;
+
+      // backward from the last row not greater than the key
+      std::vector<SMemTestRow> bwd(expect.begin(), std::upper_bound(expect.begin(), expect.end(), key));
+      std::reverse(bwd.begin(), bwd.end());
+      ASSERT_EQ(scan(&from, 1), bwd) << "backward from ts:" << from.key.ts << " version:" << from.version;
+    }
+  }
+
+  int32_t numOfChunks() {
+    int32_t n = 0;
+    for (SMemColChunk *pChunk = tbData()->cl.pHead; pChunk; pChunk = pChunk->next) ++n;
+    return n;
+  }
+
+  SVnode                  *pVnode = NULL;
+  STsdb                   *pTsdb = NULL;
+  std::vector<SMemTestRow> rows;
+};
+
+std::vector<TSKEY> memTestRange(TSKEY start, int32_t num) {
+  std::vector<TSKEY> tsList;
+  for (int32_t i = 0; i < num; ++i) tsList.push_back(start + i);
+  return tsList;
+}
+
+STsdbRowKey memTestKey(TSKEY ts, int64_t version) {
+  STsdbRowKey key = {0};
+  key.key.ts = ts;
+  key.version = version;
+  return key;
+}
+
+}  // namespace
+
+TEST_F(TsdbMemTableTest, chunksOnly) {
+  insert(1, memTestRange(100, 100));
+  insert(2, memTestRange(200, 50));
+  insert(3, memTestRange(300, 16));
+  ASSERT_EQ(numOfChunks(), 3);
+  ASSERT_EQ(tbData()->sl.size, 0);
+
+  check({memTestKey(0, 0), memTestKey(100, 1), memTestKey(150, 0), memTestKey(150, 1), memTestKey(150, 2),
+         memTestKey(199, 1), memTestKey(250, 2), memTestKey(260, 2), memTestKey(300, 3), memTestKey(315, 3),
+         memTestKey(316, 0), memTestKey(1000, 0)});
+}
+
+TEST_F(TsdbMemTableTest, chunksInterleavedWithSkiplist) {
+  insert(1, memTestRange(100, 100));    // chunk
+  insert(2, {50, 120, 150, 199, 250});  // skiplist, too few rows
+  insert(3, memTestRange(300, 20));     // chunk, after all the rows
+  insert(4, memTestRange(150, 20));     // skiplist, duplicate ts of the first chunk with newer version
+  insert(5, memTestRange(320, 20));     // chunk
+  // skiplist, across the chunks
+  insert(6, {10, 20, 30, 40, 340, 341, 342, 343, 344, 345, 350, 360, 370, 380, 390, 400});
+  insert(7, memTestRange(410, 16));  // chunk
+  insert(8, {419, 419 + 1000});      // skiplist, duplicate ts of the last chunk and after it
+  ASSERT_EQ(numOfChunks(), 4);
+  ASSERT_GT(tbData()->sl.size, 0);
+
+  std::vector<STsdbRowKey> froms;
+  for (TSKEY ts : {0, 10, 50, 99, 100, 120, 150, 151, 169, 170, 199, 200, 250, 299, 300, 339, 340, 345, 400, 419,
+                   425, 426, 1419, 2000}) {
+    for (int64_t version = 0; version <= 9; ++version) {
+      froms.push_back(memTestKey(ts, version));
+    }
+  }
+  check(froms);
+}
+
+TEST_F(TsdbMemTableTest, randomInterleaved) {
+  std::mt19937 gen(20241017);
+
+  // the rows of a batch in the column format are sorted, the batches after all the rows go to chunks, small ones and
+  // the others to the skiplist, and keys are duplicated across versions
+  TSKEY next = 0;
+  for (int64_t version = 1; version <= 60; ++version) {
+    int32_t            num = 1 + gen() % 40;
+    std::vector<TSKEY> tsList;
+    if (gen() % 2) {
+      next += gen() % 5;
+      tsList = memTestRange(next, num);
+      next += num;
+    } else {
+      for (int32_t i = 0; i < num; ++i) {
+        tsList.push_back(gen() % (next + 10));
+      }
+      std::sort(tsList.begin(), tsList.end());
+      tsList.erase(std::unique(tsList.begin(), tsList.end()), tsList.end());
+    }
+    insert(version, tsList);
+  }
+  ASSERT_GT(numOfChunks(), 1);
+  ASSERT_GT(tbData()->sl.size, 0);
+
+  std::vector<STsdbRowKey> froms;
+  for (int32_t i = 0; i < 300; ++i) {
+    froms.push_back(memTestKey(gen() % (next + 20) - 10, gen() % 62));
+  }
+  check(froms);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "tsdbDef.h"
+#include "tsdbReadUtil.h"
+
+namespace {
+
+struct SReadAheadCall {
+  int64_t offset;
+  int32_t size;
+
+  bool operator==(const SReadAheadCall &c) const { return offset == c.offset && size == c.size; }
+};
+
+// the blocks read ahead, and the index of the call that fails, -1 if none fails
+struct SReadAheadCtx {
+  std::vector<SReadAheadCall> calls;
+  int32_t                     failAt = -1;
+};
+
+int32_t readAheadRecord(void *param, const SFileDataBlockInfo *pBlockInfo) {
+  SReadAheadCtx *pCtx = (SReadAheadCtx *)param;
+  if ((int32_t)pCtx->calls.size() == pCtx->failAt) {
+    pCtx->failAt = -1;
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pCtx->calls.push_back({pBlockInfo->blockOffset, pBlockInfo->blockSize});
+  return TSDB_CODE_SUCCESS;
+}
+
+// a block iterator over blocks of the given sizes, laid one after another in the file from the offset 1000
+class TsdbReadAheadTest : public ::testing::Test {
+ protected:
+  void TearDown() override { taosArrayDestroy(iter.blockList); }
+
+  void init(const std::vector<int32_t> &sizes, int32_t order) {
+    iter.blockList = taosArrayInit(sizes.size(), sizeof(SFileDataBlockInfo));
+    ASSERT_NE(iter.blockList, nullptr);
+
+    int64_t offset = 1000;
+    for (int32_t size : sizes) {
+      SFileDataBlockInfo info = {0};
+      info.blockOffset = offset;
+      info.blockSize = size;
+      ASSERT_NE(taosArrayPush(iter.blockList, &info), nullptr);
+      offset += size;
+    }
+
+    iter.numOfBlocks = sizes.size();
+    iter.order = order;
+    iter.index = ASCENDING_TRAVERSE(order) ? 0 : iter.numOfBlocks - 1;
+    iter.numOfPrefetched = 0;
+  }
+
+  // load the block at index of the block list, as the reader does before it reads the block data
+  std::vector<SReadAheadCall> load(int32_t index, int32_t depth, int64_t budget) {
+    iter.index = index;
+    ctx.calls.clear();
+
+    int32_t num = prefetchDataBlocks(&iter, depth, budget, readAheadRecord, &ctx);
+    EXPECT_EQ(num, (int32_t)ctx.calls.size());
+    return ctx.calls;
+  }
+
+  std::vector<SReadAheadCall> blocks(const std::vector<int32_t> &indexes) {
+    std::vector<SReadAheadCall> res;
+    for (int32_t i : indexes) {
+      SFileDataBlockInfo *pInfo = (SFileDataBlockInfo *)taosArrayGet(iter.blockList, i);
+      res.push_back({pInfo->blockOffset, pInfo->blockSize});
+    }
+    return res;
+  }
+
+  SDataBlockIter iter = {0};
+  SReadAheadCtx  ctx;
+};
+
+}  // namespace
+
+TEST_F(TsdbReadAheadTest, depth) {
+  init(std::vector<int32_t>(10, 100), TSDB_ORDER_ASC);
+
+  ASSERT_EQ(load(0, 3, INT64_MAX), blocks({1, 2, 3}));
+  ASSERT_EQ(load(1, 3, INT64_MAX), blocks({4}));
+  ASSERT_EQ(load(2, 3, INT64_MAX), blocks({5}));
+
+  // only the last block is after the block 8, and nothing after the last block
+  ASSERT_EQ(load(8, 3, INT64_MAX), blocks({9}));
+  ASSERT_EQ(load(9, 3, INT64_MAX), blocks({}));
+}
+
+TEST_F(TsdbReadAheadTest, descOrder) {
+  init({100, 200, 300, 400, 500, 600}, TSDB_ORDER_DESC);
+
+  ASSERT_EQ(load(5, 2, INT64_MAX), blocks({4, 3}));
+  ASSERT_EQ(load(4, 2, INT64_MAX), blocks({2}));
+  ASSERT_EQ(load(3, 2, INT64_MAX), blocks({1}));
+  ASSERT_EQ(load(1, 2, INT64_MAX), blocks({0}));
+  ASSERT_EQ(load(0, 2, INT64_MAX), blocks({}));
+}
+
+TEST_F(TsdbReadAheadTest, budget) {
+  init({100, 100, 100, 100, 100, 100, 100, 100}, TSDB_ORDER_ASC);
+
+  // the budget is counted from the block after the current one, including the blocks read ahead before
+  ASSERT_EQ(load(0, 8, 250), blocks({1, 2}));
+  ASSERT_EQ(load(1, 8, 250), blocks({3}));
+  ASSERT_EQ(load(2, 8, 300), blocks({4, 5}));
+
+  // a block larger than the budget is not read ahead, nor the blocks after it
+  taosArrayDestroy(iter.blockList);
+  init({100, 1000, 100, 100}, TSDB_ORDER_ASC);
+  ASSERT_EQ(load(0, 8, 500), blocks({}));
+  ASSERT_EQ(load(1, 8, 500), blocks({2, 3}));
+}
+
+TEST_F(TsdbReadAheadTest, blocksSkippedBySma) {
+  init(std::vector<int32_t>(12, 100), TSDB_ORDER_ASC);
+
+  // the block 2 is answered by its SMA and not loaded, the blocks read ahead with it are not read ahead again
+  ASSERT_EQ(load(0, 3, INT64_MAX), blocks({1, 2, 3}));
+  ASSERT_EQ(load(1, 3, INT64_MAX), blocks({4}));
+  ASSERT_EQ(load(3, 3, INT64_MAX), blocks({5, 6}));
+
+  // the blocks 4 to 8 are all answered by their SMA, and the read ahead goes on after them
+  ASSERT_EQ(load(9, 3, INT64_MAX), blocks({10, 11}));
+}
+
+TEST_F(TsdbReadAheadTest, failure) {
+  init(std::vector<int32_t>(6, 100), TSDB_ORDER_ASC);
+
+  // it stops at the block that fails, which is read ahead when the next block is loaded
+  ctx.failAt = 1;
+  ASSERT_EQ(load(0, 4, INT64_MAX), blocks({1}));
+  ASSERT_EQ(load(1, 4, INT64_MAX), blocks({2, 3, 4, 5}));
+}
+
+TEST_F(TsdbReadAheadTest, filePagesOfRange) {
+  const int32_t szPage = 4096;
+  const int64_t content = PAGE_CONTENT_SIZE(szPage);
+  int64_t       fOffset = 0;
+  int64_t       fSize = 0;
+
+  tsdbFilePagesOfRange(szPage, 0, 1, &fOffset, &fSize);
+  ASSERT_EQ(fOffset, 0);
+  ASSERT_EQ(fSize, szPage);
+
+  // the last byte of a page, and the first byte of the next one
+  tsdbFilePagesOfRange(szPage, content - 1, 1, &fOffset, &fSize);
+  ASSERT_EQ(fOffset, 0);
+  ASSERT_EQ(fSize, szPage);
+  tsdbFilePagesOfRange(szPage, content, 1, &fOffset, &fSize);
+  ASSERT_EQ(fOffset, szPage);
+  ASSERT_EQ(fSize, szPage);
+
+  // a whole page, and a range across the pages
+  tsdbFilePagesOfRange(szPage, content, content, &fOffset, &fSize);
+  ASSERT_EQ(fOffset, szPage);
+  ASSERT_EQ(fSize, szPage);
+  tsdbFilePagesOfRange(szPage, content - 10, content + 20, &fOffset, &fSize);
+  ASSERT_EQ(fOffset, 0);
+  ASSERT_EQ(fSize, 3 * szPage);
+
+  // the pages of the blocks cover the file range of each block
+  for (int64_t offset = 0; offset < 5 * content; offset += 997) {
+    for (int64_t size : {1, 100, 4000, 4092, 4093, 10000}) {
+      tsdbFilePagesOfRange(szPage, offset, size, &fOffset, &fSize);
+      ASSERT_EQ(fOffset % szPage, 0);
+      ASSERT_EQ(fSize % szPage, 0);
+      ASSERT_LE(fOffset, LOGIC_TO_FILE_OFFSET(offset, szPage));
+      ASSERT_GT(fOffset + fSize, LOGIC_TO_FILE_OFFSET(offset + size - 1, szPage));
+      ASSERT_LE(fSize, (size / content + 2) * szPage);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "vnd.h"
+
+namespace {
+
+const int32_t numOfThreads = 8;
+const int32_t numOfAllocs = 20000;
+
+struct SArenaAlloc {
+  uint8_t *p;
+  int32_t  size;
+};
+
+SVnode *arenaTestOpenVnode(bool rsma) {
+  SVnode *pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+  if (pVnode == NULL) return NULL;
+
+  // large enough to take all the allocations, and small enough for some of them to go beyond the anchor node
+  pVnode->config.szBuf = (int64_t)VNODE_BUFPOOL_SEGMENTS * 4 * 1024 * 1024;
+  pVnode->config.isRsma = rsma ? 1 : 0;
+  if (vnodeOpenBufPool(pVnode) != 0) {
+    taosMemoryFree(pVnode);
+    return NULL;
+  }
+  return pVnode;
+}
+
+void arenaTestCloseVnode(SVnode *pVnode) {
+  vnodeCloseBufPool(pVnode);
+  taosMemoryFree(pVnode);
+}
+
+// the allocations are done in a tight loop once all the threads are started, to race on the arena as much as possible
+void arenaTestAlloc(SVBufPool *pPool, SVBufArena *pArena, int32_t id, std::vector<SArenaAlloc> *pAllocs,
+                    std::atomic<int32_t> *pStarted, std::atomic<int32_t> *pFailed) {
+  ++(*pStarted);
+  while (pStarted->load() < numOfThreads) {
+  }
+
+  pAllocs->reserve(numOfAllocs);
+  for (int32_t i = 0; i < numOfAllocs; ++i) {
+    int32_t  size = 8 + (i * 7 + id) % 200;
+    uint8_t *p = (uint8_t *)vnodeBufArenaMalloc(pPool, pArena, size);
+    if (p == NULL || ((uintptr_t)p & 7) != 0) {
+      ++(*pFailed);
+      return;
+    }
+    pAllocs->push_back({p, size});
+  }
+}
+
+// no two allocations shall overlap
+void arenaTestCheck(const std::vector<std::vector<SArenaAlloc>> &allocs) {
+  std::vector<SArenaAlloc> all;
+  for (const std::vector<SArenaAlloc> &v : allocs) {
+    ASSERT_EQ(v.size(), numOfAllocs);
+    all.insert(all.end(), v.begin(), v.end());
+  }
+
+  std::sort(all.begin(), all.end(), [](const SArenaAlloc &a, const SArenaAlloc &b) { return a.p < b.p; });
+  for (size_t i = 1; i < all.size(); ++i) {
+    ASSERT_GE(all[i].p, all[i - 1].p + all[i - 1].size) << "allocation " << i << " overlaps the previous one";
+  }
+}
+
+}  // namespace
+
+TEST(vnodeBufPoolTest, arenaSingleWriter) {
+  SVnode *pVnode = arenaTestOpenVnode(false);
+  ASSERT_NE(pVnode, nullptr);
+  ASSERT_EQ(pVnode->aBufPool[0]->lock, nullptr);
+
+  SVBufArena                            arena = {0};
+  std::atomic<int32_t>                  started(numOfThreads - 1);
+  std::atomic<int32_t>                  failed(0);
+  std::vector<std::vector<SArenaAlloc>> allocs(1);
+  arenaTestAlloc(pVnode->aBufPool[0], &arena, 0, &allocs[0], &started, &failed);
+  ASSERT_EQ(failed.load(), 0);
+  arenaTestCheck(allocs);
+
+  // a large one bypasses the arena and leaves the chunk in use
+  uint8_t *ptr = arena.ptr;
+  ASSERT_NE(vnodeBufArenaMalloc(pVnode->aBufPool[0], &arena, 4096), nullptr);
+  ASSERT_EQ(arena.ptr, ptr);
+
+  arenaTestCloseVnode(pVnode);
+}
+
+// the memtable of a rsma vnode is written by the executor threads concurrently, with one arena shared by all of them
+TEST(vnodeBufPoolTest, arenaConcurrentWriters) {
+  SVnode *pVnode = arenaTestOpenVnode(true);
+  ASSERT_NE(pVnode, nullptr);
+  ASSERT_NE(pVnode->aBufPool[0]->lock, nullptr);
+
+  SVBufArena                            arena = {0};
+  std::atomic<int32_t>                  started(0);
+  std::atomic<int32_t>                  failed(0);
+  std::vector<std::vector<SArenaAlloc>> allocs(numOfThreads);
+  std::vector<std::thread>              threads;
+  for (int32_t id = 0; id < numOfThreads; ++id) {
+    threads.emplace_back(arenaTestAlloc, pVnode->aBufPool[0], &arena, id, &allocs[id], &started, &failed);
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(failed.load(), 0);
+  arenaTestCheck(allocs);
+
+  // the locked pool is used instead of the arena
+  ASSERT_EQ(arena.ptr, nullptr);
+
+  arenaTestCloseVnode(pVnode);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
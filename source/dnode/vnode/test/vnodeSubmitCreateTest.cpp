@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vnd.h"
+
+namespace {
+
+const char    *submitTestPath = "./vnodeSubmitCreateTest.data";
+const tb_uid_t stbUid = 1000;
+
+// the meta of a vnode with a super table, and the child tables auto-created by a submit of it
+class VnodeSubmitCreateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    taosRemoveDir(submitTestPath);
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    ASSERT_NE(pVnode, nullptr);
+    pVnode->path = (char *)submitTestPath;
+    pVnode->config.vgId = 2;
+    pVnode->config.szPage = 4096;
+    pVnode->config.szCache = 256;
+    ASSERT_EQ(metaOpen(pVnode, &pVnode->pMeta, 0), 0);
+    ASSERT_EQ(metaBegin(pVnode->pMeta, META_BEGIN_HEAP_OS), 0);
+
+    SSchema schemaRow[] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = 1, .bytes = 8, .name = "ts"},
+                           {.type = TSDB_DATA_TYPE_INT, .colId = 2, .bytes = 4, .name = "v"}};
+    SSchema schemaTag[] = {{.type = TSDB_DATA_TYPE_INT, .colId = 3, .bytes = 4, .name = "t"}};
+    SVCreateStbReq req = {0};
+    req.name = (char *)"stb";
+    req.suid = stbUid;
+    req.schemaRow = {.nCols = 2, .version = 1, .pSchema = schemaRow};
+    req.schemaTag = {.nCols = 1, .version = 1, .pSchema = schemaTag};
+    ASSERT_EQ(metaCreateSTable(pVnode->pMeta, ++ver, &req), 0);
+  }
+
+  void TearDown() override {
+    vnodeClearSubmitCreateCtx(&ctx, submit.aSubmitTbData ? TARRAY_SIZE(submit.aSubmitTbData) : 0);
+    for (int32_t i = 0; submit.aSubmitTbData && i < TARRAY_SIZE(submit.aSubmitTbData); ++i) {
+      SSubmitTbData *pSubmitTbData = (SSubmitTbData *)taosArrayGet(submit.aSubmitTbData, i);
+      tdDestroySVCreateTbReq(pSubmitTbData->pCreateTbReq);
+      taosMemoryFree(pSubmitTbData->pCreateTbReq);
+    }
+    taosArrayDestroy(submit.aSubmitTbData);
+    metaClose(&pVnode->pMeta);
+    taosMemoryFree(pVnode);
+    taosRemoveDir(submitTestPath);
+  }
+
+  // a table of the submit which auto-creates the child table of the name and uid
+  void addCreate(const std::string &name, tb_uid_t uid, tb_uid_t suid = stbUid) {
+    if (submit.aSubmitTbData == NULL) {
+      submit.aSubmitTbData = taosArrayInit(8, sizeof(SSubmitTbData));
+      ASSERT_NE(submit.aSubmitTbData, nullptr);
+    }
+
+    SVCreateTbReq *pReq = (SVCreateTbReq *)taosMemoryCalloc(1, sizeof(SVCreateTbReq));
+    ASSERT_NE(pReq, nullptr);
+    pReq->type = TSDB_CHILD_TABLE;
+    pReq->name = taosStrdup(name.c_str());
+    pReq->uid = uid;
+    pReq->ttl = 0;
+    pReq->ctb.stbName = taosStrdup("stb");
+    pReq->ctb.suid = suid;
+    pReq->ctb.tagNum = 1;
+
+    SArray *pTagVals = taosArrayInit(1, sizeof(STagVal));
+    ASSERT_NE(pTagVals, nullptr);
+    STagVal tagVal = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+    tagVal.i64 = uid;
+    ASSERT_NE(taosArrayPush(pTagVals, &tagVal), nullptr);
+    STag *pTag = NULL;
+    ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+    taosArrayDestroy(pTagVals);
+    pReq->ctb.pTag = (uint8_t *)pTag;
+
+    SSubmitTbData tbData = {0};
+    tbData.pCreateTbReq = pReq;
+    tbData.suid = suid;
+    tbData.uid = uid;
+    ASSERT_NE(taosArrayPush(submit.aSubmitTbData, &tbData), nullptr);
+  }
+
+  // the tables of the submit are created in order, as the submit does before it inserts the rows of each
+  std::vector<int32_t> createAll() {
+    std::vector<int32_t> codes;
+    for (int32_t i = 0; i < TARRAY_SIZE(submit.aSubmitTbData); ++i) {
+      STableMetaRsp *pMetaRsp = NULL;
+      int32_t        code = vnodeCreateSubmitTable(pVnode, ver, &submit, i, &ctx, &pMetaRsp);
+      codes.push_back(code);
+      if (pMetaRsp != NULL) {
+        EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+        EXPECT_EQ(pMetaRsp->tuid, ((SSubmitTbData *)taosArrayGet(submit.aSubmitTbData, i))->uid);
+        tFreeSTableMetaRsp(pMetaRsp);
+        taosMemoryFree(pMetaRsp);
+      }
+      if (code != TSDB_CODE_SUCCESS && code != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) break;
+    }
+    return codes;
+  }
+
+  tb_uid_t uidOf(const std::string &name) { return metaGetTableEntryUidByName(pVnode->pMeta, name.c_str()); }
+
+  SVnode          *pVnode = NULL;
+  int64_t          ver = 0;
+  SSubmitReq2      submit = {0};
+  SSubmitCreateCtx ctx = {0};
+};
+
+}  // namespace
+
+TEST_F(VnodeSubmitCreateTest, runCreatedInBatch) {
+  for (int32_t i = 0; i < 10; ++i) {
+    addCreate("ctb" + std::to_string(i), 2000 + i);
+  }
+
+  ++ver;
+  STableMetaRsp *pMetaRsp = NULL;
+  ASSERT_EQ(vnodeCreateSubmitTable(pVnode, ver, &submit, 0, &ctx, &pMetaRsp), TSDB_CODE_SUCCESS);
+  tFreeSTableMetaRsp(pMetaRsp);
+  taosMemoryFree(pMetaRsp);
+
+  // the whole run is created by the first table
+  ASSERT_EQ(ctx.end, 10);
+  ASSERT_EQ(ctx.nBatched, 10);
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(uidOf("ctb" + std::to_string(i)), 2000 + i);
+  }
+
+  for (int32_t i = 1; i < 10; ++i) {
+    pMetaRsp = NULL;
+    ASSERT_EQ(vnodeCreateSubmitTable(pVnode, ver, &submit, i, &ctx, &pMetaRsp), TSDB_CODE_SUCCESS);
+    ASSERT_NE(pMetaRsp, nullptr);
+    ASSERT_EQ(pMetaRsp->tuid, 2000 + i);
+    ASSERT_EQ(pMetaRsp->suid, stbUid);
+    tFreeSTableMetaRsp(pMetaRsp);
+    taosMemoryFree(pMetaRsp);
+  }
+  ASSERT_EQ(ctx.nBatched, 10);
+}
+
+TEST_F(VnodeSubmitCreateTest, singleTableNotBatched) {
+  addCreate("ctb0", 2000);
+
+  ++ver;
+  ASSERT_EQ(createAll(), std::vector<int32_t>({TSDB_CODE_SUCCESS}));
+  ASSERT_EQ(ctx.nBatched, 0);
+  ASSERT_EQ(uidOf("ctb0"), 2000);
+}
+
+TEST_F(VnodeSubmitCreateTest, alreadyExistInBatch) {
+  addCreate("ctb0", 2000);
+  ++ver;
+  ASSERT_EQ(createAll(), std::vector<int32_t>({TSDB_CODE_SUCCESS}));
+
+  // the table existing is not created again and takes the uid existing, the others of the run are created in a batch
+  tdDestroySVCreateTbReq(((SSubmitTbData *)taosArrayGet(submit.aSubmitTbData, 0))->pCreateTbReq);
+  taosMemoryFree(((SSubmitTbData *)taosArrayGet(submit.aSubmitTbData, 0))->pCreateTbReq);
+  taosArrayClear(submit.aSubmitTbData);
+  vnodeClearSubmitCreateCtx(&ctx, 1);
+  ctx = {0};
+
+  addCreate("ctb1", 2001);
+  addCreate("ctb0", 3000);
+  addCreate("ctb2", 2002);
+  ++ver;
+  ASSERT_EQ(createAll(),
+            std::vector<int32_t>({TSDB_CODE_SUCCESS, TSDB_CODE_TDB_TABLE_ALREADY_EXIST, TSDB_CODE_SUCCESS}));
+  ASSERT_EQ(ctx.nBatched, 3);
+  ASSERT_EQ(((SSubmitTbData *)taosArrayGet(submit.aSubmitTbData, 1))->pCreateTbReq->uid, 2000);
+  ASSERT_EQ(uidOf("ctb0"), 2000);
+  ASSERT_EQ(uidOf("ctb1"), 2001);
+  ASSERT_EQ(uidOf("ctb2"), 2002);
+}
+
+TEST_F(VnodeSubmitCreateTest, firstErrorStopsCreation) {
+  addCreate("ctb0", 2000);
+  addCreate("ctb1", 2001);
+  addCreate("ctb2", 2002, stbUid + 1);
+  addCreate("ctb3", 2003);
+  addCreate("ctb4", 2004);
+
+  // the tables before the error are created in a batch, the table of the error fails as it does alone, and the
+  // tables after it are not created
+  ++ver;
+  ASSERT_EQ(createAll(),
+            std::vector<int32_t>({TSDB_CODE_SUCCESS, TSDB_CODE_SUCCESS, TSDB_CODE_PAR_TABLE_NOT_EXIST}));
+  ASSERT_EQ(ctx.nBatched, 2);
+  ASSERT_EQ(uidOf("ctb0"), 2000);
+  ASSERT_EQ(uidOf("ctb1"), 2001);
+  ASSERT_EQ(uidOf("ctb2"), 0);
+  ASSERT_EQ(uidOf("ctb3"), 0);
+  ASSERT_EQ(uidOf("ctb4"), 0);
+}
+
+TEST_F(VnodeSubmitCreateTest, duplicateNameCreatedAlone) {
+  addCreate("ctb0", 2000);
+  addCreate("ctb1", 2001);
+  addCreate("ctb0", 2002);
+  addCreate("ctb2", 2003);
+  addCreate("ctb3", 2004);
+
+  // the second table of a name ends the batch, and the run from it is created in a batch where it already exists
+  ++ver;
+  ASSERT_EQ(createAll(), std::vector<int32_t>({TSDB_CODE_SUCCESS, TSDB_CODE_SUCCESS,
+                                                TSDB_CODE_TDB_TABLE_ALREADY_EXIST, TSDB_CODE_SUCCESS,
+                                                TSDB_CODE_SUCCESS}));
+  ASSERT_EQ(ctx.nBatched, 5);
+  ASSERT_EQ(uidOf("ctb0"), 2000);
+  ASSERT_EQ(uidOf("ctb2"), 2003);
+  ASSERT_EQ(uidOf("ctb3"), 2004);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
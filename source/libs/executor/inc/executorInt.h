@@ -264,6 +264,8 @@ typedef struct STableScanBase {
   TsdReader       readerAPI;
 } STableScanBase;
 
+typedef struct STableParaScanInfo STableParaScanInfo;
+
 typedef struct STableScanInfo {
   STableScanBase  base;
   SScanInfo       scanInfo;
@@ -281,6 +283,8 @@ typedef struct STableScanInfo {
   bool            hasGroupByTag;
   bool            filesetDelimited;
   bool            needCountEmptyTable;
+  int8_t          scanParallelism;  // number of readers allowed to scan the table list concurrently
+  STableParaScanInfo* pParaScan;    // not null if the table list is scanned by concurrent readers
 } STableScanInfo;
 
 typedef enum ESubTableInputType {
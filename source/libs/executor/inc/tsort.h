@@ -23,6 +23,9 @@ extern "C" {
 #include "os.h"
 #include "tcommon.h"
 
+// max length of the normalized key of the sort columns, see tsortGetNormKeyLen
+#define SORT_NORM_KEY_MAX_LEN 32
+
 enum {
   SORT_MULTISOURCE_MERGE = 0x1,
   SORT_SINGLESOURCE_SORT = 0x2,
@@ -47,6 +50,9 @@ typedef struct SSortSource {
   };
   int64_t fetchUs;
   int64_t fetchNum;
+  // the normalized key of the row at keyRowIndex, -1 if not built yet
+  int32_t keyRowIndex;
+  char    normKey[SORT_NORM_KEY_MAX_LEN];
 } SSortSource;
 
 typedef struct SMsortComparParam {
@@ -61,6 +67,9 @@ typedef struct SMsortComparParam {
   int32_t tsOrder;
   __compar_fn_t cmpTsFn;
   void* pPkOrder; // SBlockOrderInfo*
+
+  // length of the normalized keys of the sort columns, 0 if the keys can not be normalized
+  int32_t normKeyLen;
 } SMsortComparParam;
 
 typedef struct SSortHandle  SSortHandle;
@@ -215,6 +224,12 @@ void tsortSetMergeLimitReachedFp(SSortHandle* pHandle, void (*mergeLimitReached)
 
 int tsortComparBlockCell(SSDataBlock* pLeftBlock, SSDataBlock* pRightBlock,
                       int32_t leftRowIndex, int32_t rightRowIndex, void* pOrder);
+
+/**
+ * @brief sort the rows of the block, by a radix sort on the normalized keys if all sort columns are of fixed width,
+ * otherwise by blockDataSort
+ */
+int32_t tsortSortBlock(SArray* pOrderInfo, SSDataBlock* pBlock);
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,7 @@ typedef struct SDataDispatchHandle {
   SDataSinkHandle     sink;
   SDataSinkManager*   pManager;
   SDataBlockDescNode* pSchema;
+  bool                compress;
   STaosQueue*         pDataBlocks;
   SDataDispatchBuf    nextOutput;
   int32_t             status;
@@ -70,13 +71,17 @@ static void toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData* pIn
     }
   }
   SDataCacheEntry* pEntry = (SDataCacheEntry*)pBuf->pData;
-  pEntry->compressed = 0;
+  pEntry->compressed = pHandle->compress;
   pEntry->numOfRows = pInput->pData->info.rows;
   pEntry->numOfCols = numOfCols;
   pEntry->dataLen = 0;
 
   pBuf->useSize = sizeof(SDataCacheEntry);
-  pEntry->dataLen = blockEncode(pInput->pData, pEntry->data, numOfCols);
+  if (pHandle->compress) {
+    pEntry->dataLen = blockCompressEncode(pInput->pData, pEntry->data, numOfCols);
+  } else {
+    pEntry->dataLen = blockEncode(pInput->pData, pEntry->data, numOfCols);
+  }
   //  ASSERT(pEntry->numOfRows == *(int32_t*)(pEntry->data + 8));
   //  ASSERT(pEntry->numOfCols == *(int32_t*)(pEntry->data + 8 + 4));
 
@@ -96,7 +101,8 @@ static bool allocBuf(SDataDispatchHandle* pDispatcher, const SInputData* pInput,
     }
   */
 
-  pBuf->allocSize = sizeof(SDataCacheEntry) + blockGetEncodeSize(pInput->pData);
+  pBuf->allocSize = sizeof(SDataCacheEntry) + (pDispatcher->compress ? blockGetCompressEncodeSize(pInput->pData)
+                                                                       : blockGetEncodeSize(pInput->pData));
 
   pBuf->pData = taosMemoryMalloc(pBuf->allocSize);
   if (pBuf->pData == NULL) {
@@ -260,6 +266,7 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->sink.fGetCacheSize = getCacheSize;
   dispatcher->pManager = pManager;
   dispatcher->pSchema = pDataSink->pInputDataBlockDesc;
+  dispatcher->compress = pManager->cfg.compress;
   dispatcher->status = DS_BUF_EMPTY;
   dispatcher->queryEnd = false;
   dispatcher->pDataBlocks = taosOpenQueue();
@@ -577,6 +577,9 @@ int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pCo
   if (pColList == NULL) {  // data from other sources
     blockDataCleanup(pRes);
     *pNextStart = (char*)blockDecode(pRes, pData);
+    if (*pNextStart == NULL) {
+      return terrno;
+    }
   } else {  // extract data according to pColList
     char* pStart = pData;
 
@@ -687,6 +690,7 @@ int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDa
 
     code = extractDataBlockFromFetchRsp(pb, pStart, NULL, &pStart);
     if (code != 0) {
+      blockDataDestroy(pb);
       taosMemoryFreeClear(pDataInfo->pRsp);
       return code;
     }
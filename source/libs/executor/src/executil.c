@@ -21,6 +21,7 @@
 #include "tdatablock.h"
 #include "thash.h"
 #include "tmsg.h"
+#include "troaring.h"
 #include "ttime.h"
 
 #include "executil.h"
@@ -860,16 +861,30 @@ static int32_t optimizeTbnameInCondImpl(void* pVnode, SArray* pExistedUidList, S
       return -1;
     }
 
-    SArray*   pTbList = getTableNameList(pList);
-    int32_t   numOfTables = taosArrayGetSize(pTbList);
-    SHashObj* uHash = NULL;
+    SArray*         pTbList = getTableNameList(pList);
+    int32_t         numOfTables = taosArrayGetSize(pTbList);
+    SRoaringBitmap* pExisted = NULL;
 
     size_t numOfExisted = taosArrayGetSize(pExistedUidList);  // len > 0 means there already have uids
     if (numOfExisted > 0) {
-      uHash = taosHashInit(numOfExisted / 0.7, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+      uint64_t* pUids = taosMemoryMalloc(numOfExisted * sizeof(uint64_t));
+      pExisted = tRoaringCreate();
+      if (pUids == NULL || pExisted == NULL) {
+        taosMemoryFree(pUids);
+        tRoaringDestroy(pExisted);
+        taosArrayDestroy(pTbList);
+        return -1;
+      }
+
       for (int i = 0; i < numOfExisted; i++) {
-        STUidTagInfo* pTInfo = taosArrayGet(pExistedUidList, i);
-        taosHashPut(uHash, &pTInfo->uid, sizeof(uint64_t), &i, sizeof(i));
+        pUids[i] = ((STUidTagInfo*)taosArrayGet(pExistedUidList, i))->uid;
+      }
+      int32_t code = tRoaringAddBatch(pExisted, pUids, numOfExisted);
+      taosMemoryFree(pUids);
+      if (code != TSDB_CODE_SUCCESS) {
+        tRoaringDestroy(pExisted);
+        taosArrayDestroy(pTbList);
+        return -1;
       }
     }
 
@@ -880,13 +895,13 @@ static int32_t optimizeTbnameInCondImpl(void* pVnode, SArray* pExistedUidList, S
       if (pStoreAPI->metaFn.getTableUidByName(pVnode, name, &uid) == 0) {
         ETableType tbType = TSDB_TABLE_MAX;
         if (pStoreAPI->metaFn.getTableTypeByName(pVnode, name, &tbType) == 0 && tbType == TSDB_CHILD_TABLE) {
-          if (NULL == uHash || taosHashGet(uHash, &uid, sizeof(uid)) == NULL) {
+          if (NULL == pExisted || !tRoaringContains(pExisted, uid)) {
             STUidTagInfo s = {.uid = uid, .name = name, .pTagVal = NULL};
             taosArrayPush(pExistedUidList, &s);
           }
         } else {
           taosArrayDestroy(pTbList);
-          taosHashCleanup(uHash);
+          tRoaringDestroy(pExisted);
           return -1;
         }
       } else {
@@ -895,7 +910,7 @@ static int32_t optimizeTbnameInCondImpl(void* pVnode, SArray* pExistedUidList, S
       }
     }
 
-    taosHashCleanup(uHash);
+    tRoaringDestroy(pExisted);
     taosArrayDestroy(pTbList);
     return 0;
   }
@@ -1134,6 +1149,53 @@ end:
   return code;
 }
 
+// the uid list in the meta cache is
+// | number of uids (int32_t) | length of the roaring bitmap, or 0 if the uids are kept as they are (int32_t) | data |
+// and the bitmap is used if it is smaller, which is the case when the uids of the tables are close to each other
+static int32_t buildUidListCachePayload(const SArray* pUidList, char** ppPayload, int32_t* pSize) {
+  int32_t         numOfTables = taosArrayGetSize(pUidList);
+  int32_t         bitmapLen = 0;
+  SRoaringBitmap* pBitmap = NULL;
+
+  if (numOfTables > 0) {
+    pBitmap = tRoaringCreate();
+    if (pBitmap == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    int32_t code = tRoaringAddBatch(pBitmap, taosArrayGet(pUidList, 0), numOfTables);
+    if (code != TSDB_CODE_SUCCESS) {
+      tRoaringDestroy(pBitmap);
+      return code;
+    }
+
+    bitmapLen = tRoaringGetEncodeSize(pBitmap);
+    if (bitmapLen >= numOfTables * sizeof(uint64_t)) {
+      bitmapLen = 0;
+    }
+  }
+
+  int32_t size = sizeof(int32_t) * 2 + ((bitmapLen > 0) ? bitmapLen : numOfTables * sizeof(uint64_t));
+  char*   pPayload = taosMemoryMalloc(size);
+  if (pPayload == NULL) {
+    tRoaringDestroy(pBitmap);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  *(int32_t*)pPayload = numOfTables;
+  *(int32_t*)(pPayload + sizeof(int32_t)) = bitmapLen;
+  if (bitmapLen > 0) {
+    (void)tRoaringEncode(pBitmap, pPayload + sizeof(int32_t) * 2);
+  } else if (numOfTables > 0) {
+    memcpy(pPayload + sizeof(int32_t) * 2, taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
+  }
+
+  tRoaringDestroy(pBitmap);
+  *ppPayload = pPayload;
+  *pSize = size;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, SNode* pTagIndexCond,
                      STableListInfo* pListInfo, uint8_t* digest, const char* idstr, SStorageAPI* pStorageAPI) {
   int32_t code = TSDB_CODE_SUCCESS;
@@ -1204,12 +1266,11 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
     numOfTables = taosArrayGetSize(pUidList);
 
     if (tsTagFilterCache) {
-      size_t size = numOfTables * sizeof(uint64_t) + sizeof(int32_t);
-      char*  pPayload = taosMemoryMalloc(size);
-
-      *(int32_t*)pPayload = numOfTables;
-      if (numOfTables > 0) {
-        memcpy(pPayload + sizeof(int32_t), taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
+      char*   pPayload = NULL;
+      int32_t size = 0;
+      code = buildUidListCachePayload(pUidList, &pPayload, &size);
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _end;
       }
 
       pStorageAPI->metaFn.putCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest),
@@ -1827,6 +1888,32 @@ void cleanupQueryTableDataCond(SQueryTableDataCond* pCond) {
   taosMemoryFreeClear(pCond->pSlotList);
 }
 
+int32_t copyQueryTableDataCond(const SQueryTableDataCond* pSrc, SQueryTableDataCond* pDst) {
+  *pDst = *pSrc;
+  pDst->colList = NULL;
+  pDst->pSlotList = NULL;
+
+  if (pSrc->numOfCols <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pDst->colList = taosMemoryMalloc(sizeof(SColumnInfo) * pSrc->numOfCols);
+  pDst->pSlotList = taosMemoryMalloc(sizeof(int32_t) * pSrc->numOfCols);
+  if (pDst->colList == NULL || pDst->pSlotList == NULL) {
+    cleanupQueryTableDataCond(pDst);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memcpy(pDst->colList, pSrc->colList, sizeof(SColumnInfo) * pSrc->numOfCols);
+  if (pSrc->pSlotList != NULL) {
+    memcpy(pDst->pSlotList, pSrc->pSlotList, sizeof(int32_t) * pSrc->numOfCols);
+  } else {
+    taosMemoryFreeClear(pDst->pSlotList);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t convertFillType(int32_t mode) {
   int32_t type = TSDB_FILL_NONE;
   switch (mode) {
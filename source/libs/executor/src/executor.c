@@ -537,7 +537,10 @@ int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId,
   }
 
   if (handle) {
-    SDataSinkMgtCfg cfg = {.maxDataBlockNum = 500, .maxDataBlockNumPerQuery = 50};
+    // only the root subplan sends its results to the client, which reads the blocks as they are
+    SDataSinkMgtCfg cfg = {.maxDataBlockNum = 500,
+                           .maxDataBlockNumPerQuery = 50,
+                           .compress = tsCompressFetchRsp && pSubplan->level > 0};
     void* pSinkManager = NULL;
     code = dsDataSinkMgtInit(&cfg, &(*pTask)->storageAPI, &pSinkManager);
     if (code != TSDB_CODE_SUCCESS) {
@@ -612,6 +612,14 @@ void copyResultrowToDataBlock(SExprInfo* pExprInfo, int32_t numOfExprs, SResultR
         qError("%s build result data block error, code %s", GET_TASKID(pTaskInfo), tstrerror(code));
         T_LONG_JMP(pTaskInfo->env, code);
       }
+
+      // the rows of the functions that output more rows than this one, e.g. the points of _percentile_partial, are
+      // null for this one
+      int32_t numOfRes = TMAX(1, pCtx[j].resultInfo->numOfRes);
+      if (numOfRes < pRow->numOfRows) {
+        colDataSetNNULL(taosArrayGet(pBlock->pDataBlock, slotId), pBlock->info.rows + numOfRes,
+                        pRow->numOfRows - numOfRes);
+      }
     } else if (strcmp(pCtx[j].pExpr->pExpr->_function.functionName, "_select_value") == 0) {
       // do nothing
     } else {
@@ -28,16 +28,46 @@
 #include "thash.h"
 #include "ttypes.h"
 
+/**
+ * Open-addressing group key table used by the batch group by path. All group by columns are fixed-width, so the
+ * keys of a whole block are encoded into a vector with a fixed stride, hashed and probed in batch, and then the rows
+ * are applied to the aggregate state of their groups in runs.
+ *
+ * the layout of an encoded key is the same as the one of buildGroupKeys, except that the value of a NULL column is
+ * zero-filled instead of skipped.
+ * +--------------------+--------------------------------+
+ * | null flag per col  |  fixed-width value per col     |
+ * +--------------------+--------------------------------+
+ */
+typedef struct SGroupKeyTable {
+  int32_t             keyLen;      // encoded key width
+  int32_t             numOfCols;   // number of group by columns
+  int32_t*            pColOffset;  // value offset of each group by column in the encoded key
+  uint32_t            mask;        // number of slots - 1
+  int32_t*            pSlots;      // slot -> group index, -1 denotes an empty slot
+  int32_t             numOfGroups;
+  int32_t             groupCapacity;
+  uint32_t*           pHash;       // hash value of each group
+  uint64_t*           pGroupId;    // block group id of each group
+  char*               pKeys;       // encoded key of each group
+  SResultRowPosition* pPos;        // result row position of each group
+  int32_t             rowCapacity;
+  char*               pRowKeys;    // encoded keys of the rows in current block
+  uint32_t*           pRowHash;    // hash value of the rows in current block
+  int32_t*            pRowGroup;   // group index of the rows in current block
+} SGroupKeyTable;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
+  SOptrBasicInfo  binfo;
+  SAggSupporter   aggSup;
+  SArray*         pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*         pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool            isInit;         // denote if current val is initialized or not
+  char*           keyBuf;         // group by keys for hash
+  int32_t         groupKeyLen;    // total group by column width
+  SGroupResInfo   groupResInfo;
+  SExprSupp       scalarSup;
+  SGroupKeyTable* pKeyTable;  // batch group key table, only available for fixed-width group by columns
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -67,6 +97,7 @@ static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity
 static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
                                         int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
+static void     destroyGroupKeyTable(SGroupKeyTable* pTable);
 
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
@@ -84,6 +115,7 @@ static void destroyGroupOperatorInfo(void* param) {
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
   cleanupExprSupp(&pInfo->scalarSup);
+  destroyGroupKeyTable(pInfo->pKeyTable);
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   cleanupAggSup(&pInfo->aggSup);
@@ -272,6 +304,341 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static bool isFixedWidthGroupKeys(const SArray* pGroupCols) {
+  int32_t numOfGroupCols = taosArrayGetSize(pGroupCols);
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn* pCol = taosArrayGet(pGroupCols, i);
+    if (IS_VAR_DATA_TYPE(pCol->type) || pCol->type == TSDB_DATA_TYPE_JSON) {
+      return false;
+    }
+  }
+
+  return numOfGroupCols > 0;
+}
+
+static void destroyGroupKeyTable(SGroupKeyTable* pTable) {
+  if (pTable == NULL) {
+    return;
+  }
+
+  taosMemoryFree(pTable->pColOffset);
+  taosMemoryFree(pTable->pSlots);
+  taosMemoryFree(pTable->pHash);
+  taosMemoryFree(pTable->pGroupId);
+  taosMemoryFree(pTable->pKeys);
+  taosMemoryFree(pTable->pPos);
+  taosMemoryFree(pTable->pRowKeys);
+  taosMemoryFree(pTable->pRowHash);
+  taosMemoryFree(pTable->pRowGroup);
+  taosMemoryFree(pTable);
+}
+
+static SGroupKeyTable* createGroupKeyTable(const SArray* pGroupCols, int32_t keyLen) {
+  SGroupKeyTable* pTable = taosMemoryCalloc(1, sizeof(SGroupKeyTable));
+  if (pTable == NULL) {
+    return NULL;
+  }
+
+  pTable->keyLen = keyLen;
+  pTable->numOfCols = taosArrayGetSize(pGroupCols);
+  pTable->pColOffset = taosMemoryCalloc(pTable->numOfCols, sizeof(int32_t));
+
+  const int32_t initSlots = 1024;
+  pTable->mask = initSlots - 1;
+  pTable->pSlots = taosMemoryMalloc(initSlots * sizeof(int32_t));
+  if (pTable->pColOffset == NULL || pTable->pSlots == NULL) {
+    destroyGroupKeyTable(pTable);
+    return NULL;
+  }
+
+  memset(pTable->pSlots, 0xFF, initSlots * sizeof(int32_t));
+
+  int32_t offset = sizeof(int8_t) * pTable->numOfCols;
+  for (int32_t i = 0; i < pTable->numOfCols; ++i) {
+    SColumn* pCol = taosArrayGet(pGroupCols, i);
+    pTable->pColOffset[i] = offset;
+    offset += pCol->bytes;
+  }
+
+  ASSERT(offset == keyLen);
+  return pTable;
+}
+
+static int32_t ensureGroupKeyTableRowCapacity(SGroupKeyTable* pTable, int32_t rows) {
+  if (rows <= pTable->rowCapacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  char*     pKeys = taosMemoryRealloc(pTable->pRowKeys, (int64_t)rows * pTable->keyLen);
+  uint32_t* pHash = taosMemoryRealloc(pTable->pRowHash, rows * sizeof(uint32_t));
+  int32_t*  pGroup = taosMemoryRealloc(pTable->pRowGroup, rows * sizeof(int32_t));
+  if (pKeys != NULL) pTable->pRowKeys = pKeys;
+  if (pHash != NULL) pTable->pRowHash = pHash;
+  if (pGroup != NULL) pTable->pRowGroup = pGroup;
+  if (pKeys == NULL || pHash == NULL || pGroup == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pTable->rowCapacity = rows;
+  return TSDB_CODE_SUCCESS;
+}
+
+// encode the group keys of all rows in the block column by column, with the fixed stride of keyLen.
+static void encodeFixedGroupKeys(SGroupKeyTable* pTable, const SArray* pGroupCols, SSDataBlock* pBlock) {
+  int32_t rows = pBlock->info.rows;
+  int32_t keyLen = pTable->keyLen;
+
+  for (int32_t i = 0; i < pTable->numOfCols; ++i) {
+    SColumn*         pCol = taosArrayGet(pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+    SColumnDataAgg*  pColAgg = (pBlock->pBlockAgg != NULL) ? pBlock->pBlockAgg[pCol->slotId] : NULL;
+
+    char*       pDst = pTable->pRowKeys + pTable->pColOffset[i];
+    char*       pNull = pTable->pRowKeys + i;
+    const char* pSrc = pColInfoData->pData;
+
+    if (!pColInfoData->hasNull) {
+      switch (pCol->bytes) {
+        case sizeof(int8_t):
+          for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+            *pNull = 0;
+            *(int8_t*)pDst = ((const int8_t*)pSrc)[j];
+          }
+          break;
+        case sizeof(int16_t):
+          for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+            *pNull = 0;
+            memcpy(pDst, pSrc + j * sizeof(int16_t), sizeof(int16_t));
+          }
+          break;
+        case sizeof(int32_t):
+          for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+            *pNull = 0;
+            memcpy(pDst, pSrc + j * sizeof(int32_t), sizeof(int32_t));
+          }
+          break;
+        case sizeof(int64_t):
+          for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+            *pNull = 0;
+            memcpy(pDst, pSrc + j * sizeof(int64_t), sizeof(int64_t));
+          }
+          break;
+        default:
+          for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+            *pNull = 0;
+            memcpy(pDst, pSrc + (int64_t)j * pCol->bytes, pCol->bytes);
+          }
+          break;
+      }
+    } else {
+      for (int32_t j = 0; j < rows; ++j, pDst += keyLen, pNull += keyLen) {
+        if (colDataIsNull(pColInfoData, rows, j, pColAgg)) {
+          *pNull = 1;
+          memset(pDst, 0, pCol->bytes);
+        } else {
+          *pNull = 0;
+          memcpy(pDst, pSrc + (int64_t)j * pCol->bytes, pCol->bytes);
+        }
+      }
+    }
+  }
+}
+
+static FORCE_INLINE uint32_t fixedGroupKeyHash(const char* pKey, int32_t keyLen, uint64_t groupId) {
+  uint64_t h = groupId ^ ((uint64_t)keyLen * 0x9E3779B97F4A7C15ULL);
+
+  int32_t i = 0;
+  for (; i + (int32_t)sizeof(uint64_t) <= keyLen; i += sizeof(uint64_t)) {
+    uint64_t v;
+    memcpy(&v, pKey + i, sizeof(v));
+    h = (h ^ v) * 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 32;
+  }
+
+  if (i < keyLen) {
+    uint64_t v = 0;
+    memcpy(&v, pKey + i, keyLen - i);
+    h = (h ^ v) * 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 32;
+  }
+
+  return (uint32_t)h;
+}
+
+static int32_t growGroupKeyTableSlots(SGroupKeyTable* pTable) {
+  uint32_t numOfSlots = (pTable->mask + 1) << 1;
+  int32_t* pSlots = taosMemoryMalloc(numOfSlots * sizeof(int32_t));
+  if (pSlots == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memset(pSlots, 0xFF, numOfSlots * sizeof(int32_t));
+
+  uint32_t mask = numOfSlots - 1;
+  for (int32_t i = 0; i < pTable->numOfGroups; ++i) {
+    uint32_t slot = pTable->pHash[i] & mask;
+    while (pSlots[slot] != -1) {
+      slot = (slot + 1) & mask;
+    }
+    pSlots[slot] = i;
+  }
+
+  taosMemoryFree(pTable->pSlots);
+  pTable->pSlots = pSlots;
+  pTable->mask = mask;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t addGroupToKeyTable(SGroupKeyTable* pTable, uint32_t slot, const char* pKey, uint32_t hash,
+                                  uint64_t groupId, SResultRowPosition* pPos) {
+  if (pTable->numOfGroups >= pTable->groupCapacity) {
+    int32_t cap = (pTable->groupCapacity == 0) ? 256 : pTable->groupCapacity * 2;
+
+    uint32_t*           pHash = taosMemoryRealloc(pTable->pHash, cap * sizeof(uint32_t));
+    uint64_t*           pGroupId = taosMemoryRealloc(pTable->pGroupId, cap * sizeof(uint64_t));
+    char*               pKeys = taosMemoryRealloc(pTable->pKeys, (int64_t)cap * pTable->keyLen);
+    SResultRowPosition* pPosList = taosMemoryRealloc(pTable->pPos, cap * sizeof(SResultRowPosition));
+    if (pHash != NULL) pTable->pHash = pHash;
+    if (pGroupId != NULL) pTable->pGroupId = pGroupId;
+    if (pKeys != NULL) pTable->pKeys = pKeys;
+    if (pPosList != NULL) pTable->pPos = pPosList;
+    if (pHash == NULL || pGroupId == NULL || pKeys == NULL || pPosList == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    pTable->groupCapacity = cap;
+  }
+
+  int32_t index = pTable->numOfGroups++;
+  pTable->pHash[index] = hash;
+  pTable->pGroupId[index] = groupId;
+  pTable->pPos[index] = *pPos;
+  memcpy(pTable->pKeys + (int64_t)index * pTable->keyLen, pKey, pTable->keyLen);
+  pTable->pSlots[slot] = index;
+
+  // keep the load factor below 0.5
+  if ((uint32_t)pTable->numOfGroups * 2 > pTable->mask + 1) {
+    return growGroupKeyTableSlots(pTable);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// switch the current result row to an existed group, the same as doSetResultOutBufByKey without the hash lookup.
+static void setGroupResultOutputBufByPos(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, SResultRowPosition* pPos,
+                                         SDiskbasedBuf* pBuf) {
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+  SResultRowInfo* pResultRowInfo = &binfo->resultRowInfo;
+
+  SResultRow* pResult = getResultRowByPos(pBuf, pPos, true);
+  if (NULL == pResult) {
+    T_LONG_JMP(pTaskInfo->env, terrno);
+  }
+
+  if (pResultRowInfo->cur.pageId != -1 && pResultRowInfo->cur.pageId != pPos->pageId) {
+    SFilePage* pPage = getBufPage(pBuf, pResultRowInfo->cur.pageId);
+    if (pPage == NULL) {
+      qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+    releaseBufPage(pBuf, pPage);
+  }
+
+  pResultRowInfo->cur = *pPos;
+  setResultRowInitCtx(pResult, pOperator->exprSupp.pCtx, pOperator->exprSupp.numOfExprs,
+                      pOperator->exprSupp.rowEntryInfoOffset);
+}
+
+// hash and probe the encoded keys of the whole block, and assign a group index to each row.
+static void probeFixedGroupKeys(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupKeyTable*       pTable = pInfo->pKeyTable;
+
+  int32_t  rows = pBlock->info.rows;
+  int32_t  keyLen = pTable->keyLen;
+  uint64_t groupId = pBlock->info.id.groupId;
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pTable->pRowHash[j] = fixedGroupKeyHash(pTable->pRowKeys + (int64_t)j * keyLen, keyLen, groupId);
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    const char* pKey = pTable->pRowKeys + (int64_t)j * keyLen;
+
+    // rows of the same group are usually adjacent in the block
+    if (j > 0 && pTable->pRowHash[j] == pTable->pRowHash[j - 1] && memcmp(pKey, pKey - keyLen, keyLen) == 0) {
+      pTable->pRowGroup[j] = pTable->pRowGroup[j - 1];
+      continue;
+    }
+
+    uint32_t hash = pTable->pRowHash[j];
+    uint32_t slot = hash & pTable->mask;
+    int32_t  index = -1;
+
+    while (pTable->pSlots[slot] != -1) {
+      int32_t g = pTable->pSlots[slot];
+      if (pTable->pHash[g] == hash && pTable->pGroupId[g] == groupId &&
+          memcmp(pTable->pKeys + (int64_t)g * keyLen, pKey, keyLen) == 0) {
+        index = g;
+        break;
+      }
+      slot = (slot + 1) & pTable->mask;
+    }
+
+    if (index == -1) {
+      // a new group, create the result row and register it into the result row hash table for output
+      SResultRow* pRow = doSetResultOutBufByKey(pInfo->aggSup.pResultBuf, &pInfo->binfo.resultRowInfo, (char*)pKey,
+                                                keyLen, true, groupId, pTaskInfo, false, &pInfo->aggSup, false);
+
+      SResultRowPosition pos = {.pageId = pRow->pageId, .offset = pRow->offset};
+      index = pTable->numOfGroups;
+
+      int32_t code = addGroupToKeyTable(pTable, slot, pKey, hash, groupId, &pos);
+      if (code != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    }
+
+    pTable->pRowGroup[j] = index;
+  }
+}
+
+static void doBatchHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupKeyTable*       pTable = pInfo->pKeyTable;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+
+  int32_t rows = pBlock->info.rows;
+  if (rows == 0) {
+    return;
+  }
+
+  int32_t code = ensureGroupKeyTableRowCapacity(pTable, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  encodeFixedGroupKeys(pTable, pInfo->pGroupCols, pBlock);
+  probeFixedGroupKeys(pOperator, pBlock);
+
+  // scatter the rows to the aggregate states, one run of adjacent rows of the same group at a time
+  int32_t start = 0;
+  for (int32_t j = 1; j <= rows; ++j) {
+    if (j < rows && pTable->pRowGroup[j] == pTable->pRowGroup[start]) {
+      continue;
+    }
+
+    int32_t num = j - start;
+    setGroupResultOutputBufByPos(pOperator, &pInfo->binfo, &pTable->pPos[pTable->pRowGroup[start]],
+                                 pInfo->aggSup.pResultBuf);
+    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, start, num, rows, pOperator->exprSupp.numOfExprs);
+    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, rows, start);
+    start = j;
+  }
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
@@ -472,7 +839,11 @@ static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
       }
     }
 
-    doHashGroupbyAgg(pOperator, pBlock);
+    if (pInfo->pKeyTable != NULL) {
+      doBatchHashGroupbyAgg(pOperator, pBlock);
+    } else {
+      doHashGroupbyAgg(pOperator, pBlock);
+    }
   }
 
   pOperator->status = OP_RES_TO_RETURN;
@@ -525,6 +896,15 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  // var-length and json group keys are handled row by row.
+  if (isFixedWidthGroupKeys(pInfo->pGroupCols)) {
+    pInfo->pKeyTable = createGroupKeyTable(pInfo->pGroupCols, pInfo->groupKeyLen);
+    if (pInfo->pKeyTable == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _error;
+    }
+  }
+
   int32_t    num = 0;
   SExprInfo* pExprInfo = createExprInfo(pAggNode->pAggFuncs, pAggNode->pGroupKeys, &num);
   code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen, pTaskInfo->id.str,
@@ -533,6 +913,14 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  // the number of groups may be huge, use the open addressing hash table to avoid walking through the bucket chains
+  tSimpleHashCleanup(pInfo->aggSup.pResultRowHashTable);
+  pInfo->aggSup.pResultRowHashTable = tSimpleHashInitEx(100, taosFastHash, SHASH_TYPE_OPEN_ADDR);
+  if (pInfo->aggSup.pResultRowHashTable == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _error;
+  }
+
   code = filterInitFromNode((SNode*)pAggNode->node.pConditions, &pOperator->exprSupp.pFilterInfo, 0);
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
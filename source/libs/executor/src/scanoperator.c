@@ -31,6 +31,7 @@
 #include "ttypes.h"
 #include "operator.h"
 #include "querytask.h"
+#include "tglobal.h"
 
 #include "storageapi.h"
 #include "wal.h"
@@ -1057,6 +1058,363 @@ static SSDataBlock* groupSeqTableScan(SOperatorInfo* pOperator) {
   return result;
 }
 
+// The table list of a vnode is split into morsels of adjacent tables, and each worker thread claims the next
+// morsel, opens a reader on it and hands the loaded data blocks over to the operator thread via a bounded queue.
+// The tag columns, the filter and the limit/offset are still applied in the operator thread, since they rely on
+// the meta cache and the operator states that are not thread safe.
+// The workers of all the scans in a dnode are bounded by numOfParaScanThreads. A scan starts the workers it can
+// reserve, and scans the tables in the operator thread if it gets less than two.
+#define PARA_SCAN_MORSELS_PER_WORKER 4
+#define PARA_SCAN_QUEUED_PER_WORKER  2
+
+static int32_t tableParaScanWorkers = 0;  // the workers running in the dnode
+
+struct STableParaScanInfo {
+  SOperatorInfo* pOperator;
+  STableKeyInfo* pTableList;
+  int32_t        numOfTables;
+  int32_t        morselSize;
+  int32_t        numOfMorsels;
+  int32_t        nextMorsel;  // claimed by the workers atomically
+  int32_t        numOfWorkers;
+  int32_t        runningWorkers;
+  TdThread*      pWorkers;
+  TdThreadMutex  lock;
+  TdThreadCond   notEmpty;
+  TdThreadCond   notFull;
+  SSDataBlock**  pQueue;  // ring buffer of the loaded data blocks
+  int32_t        queueCap;
+  int32_t        queueHead;
+  int32_t        queueSize;
+  int32_t        code;
+  bool           quit;
+  SSDataBlock*   pCurBlock;  // the block returned to the downstream operator
+};
+
+static bool isTableParaScanAllowed(SOperatorInfo* pOperator) {
+  STableScanInfo* pInfo = pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+
+  return pInfo->scanParallelism > 1 && pTaskInfo->execModel == OPTR_EXEC_MODEL_BATCH && !pOperator->dynamicTask &&
+         pInfo->scanMode != TABLE_SCAN__TABLE_ORDER && pInfo->scanInfo.numOfAsc == 1 &&
+         pInfo->scanInfo.numOfDesc == 0 && pInfo->base.cond.order == TSDB_ORDER_ASC &&
+         pInfo->base.dataBlockLoadFlag == FUNC_DATA_REQUIRED_DATA_LOAD && pInfo->base.pdInfo.pExprSup == NULL &&
+         !pInfo->needCountEmptyTable && tableListGetOutputGroups(pInfo->base.pTableListInfo) == 1 &&
+         !pInfo->base.pTableListInfo->oneTableForEachGroup && tableListGetSize(pInfo->base.pTableListInfo) > 1;
+}
+
+// reserve at most num workers, and return the number reserved
+static int32_t reserveTableParaScanWorkers(int32_t num) {
+  while (1) {
+    int32_t running = atomic_load_32(&tableParaScanWorkers);
+    int32_t reserved = TMIN(num, tsNumOfParaScanThreads - running);
+    if (reserved <= 0) {
+      return 0;
+    }
+    if (atomic_val_compare_exchange_32(&tableParaScanWorkers, running, running + reserved) == running) {
+      return reserved;
+    }
+  }
+}
+
+static void releaseTableParaScanWorkers(int32_t num) { atomic_sub_fetch_32(&tableParaScanWorkers, num); }
+
+static int32_t pushTableParaScanBlock(STableParaScanInfo* pPara, SSDataBlock* pBlock) {
+  taosThreadMutexLock(&pPara->lock);
+  while (pPara->queueSize >= pPara->queueCap && !pPara->quit) {
+    taosThreadCondWait(&pPara->notFull, &pPara->lock);
+  }
+
+  if (pPara->quit) {
+    taosThreadMutexUnlock(&pPara->lock);
+    blockDataDestroy(pBlock);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pPara->pQueue[(pPara->queueHead + pPara->queueSize) % pPara->queueCap] = pBlock;
+  pPara->queueSize += 1;
+  taosThreadCondSignal(&pPara->notEmpty);
+  taosThreadMutexUnlock(&pPara->lock);
+  return TSDB_CODE_SUCCESS;
+}
+
+// return NULL in *ppBlock if all workers are done and all the loaded blocks are consumed
+static int32_t popTableParaScanBlock(STableParaScanInfo* pPara, SSDataBlock** ppBlock) {
+  *ppBlock = NULL;
+
+  taosThreadMutexLock(&pPara->lock);
+  while (pPara->queueSize == 0 && pPara->runningWorkers > 0 && pPara->code == TSDB_CODE_SUCCESS) {
+    taosThreadCondWait(&pPara->notEmpty, &pPara->lock);
+  }
+
+  int32_t code = pPara->code;
+  if (code == TSDB_CODE_SUCCESS && pPara->queueSize > 0) {
+    *ppBlock = pPara->pQueue[pPara->queueHead];
+    pPara->queueHead = (pPara->queueHead + 1) % pPara->queueCap;
+    pPara->queueSize -= 1;
+    taosThreadCondSignal(&pPara->notFull);
+  }
+  taosThreadMutexUnlock(&pPara->lock);
+  return code;
+}
+
+static int32_t doTableParaScanMorsel(STableParaScanInfo* pPara, int32_t index, SSDataBlock* pResBlock) {
+  STableScanInfo* pInfo = pPara->pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pPara->pOperator->pTaskInfo;
+  TsdReader*      pAPI = &pInfo->base.readerAPI;
+  STsdbReader*    pReader = NULL;
+  SHashObj*       pIgnoreTables = NULL;
+
+  int32_t start = index * pPara->morselSize;
+  int32_t num = TMIN(pPara->morselSize, pPara->numOfTables - start);
+
+  // the reader may update the cond when it is opened, so each reader gets a copy of its own.
+  SQueryTableDataCond cond = {0};
+  int32_t             code = copyQueryTableDataCond(&pInfo->base.cond, &cond);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  code = pAPI->tsdReaderOpen(pInfo->base.readHandle.vnode, &cond, pPara->pTableList + start, num, pResBlock,
+                             (void**)&pReader, GET_TASKID(pTaskInfo), &pIgnoreTables);
+  while (code == TSDB_CODE_SUCCESS) {
+    bool hasNext = false;
+    code = pAPI->tsdNextDataBlock(pReader, &hasNext);
+    if (code != TSDB_CODE_SUCCESS || !hasNext) {
+      break;
+    }
+
+    if (atomic_load_8((int8_t*)&pPara->quit) || isTaskKilled(pTaskInfo)) {
+      pAPI->tsdReaderReleaseDataBlock(pReader);
+      break;
+    }
+
+    SSDataBlock* p = pAPI->tsdReaderRetrieveDataBlock(pReader, NULL);
+    if (p == NULL) {
+      code = terrno;
+      break;
+    }
+
+    if (p->info.rows == 0) {
+      continue;
+    }
+
+    SSDataBlock* pBlock = createOneDataBlock(p, true);
+    if (pBlock == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+
+    code = pushTableParaScanBlock(pPara, pBlock);
+  }
+
+  pAPI->tsdReaderClose(pReader);
+  taosHashCleanup(pIgnoreTables);
+  cleanupQueryTableDataCond(&cond);
+  return code;
+}
+
+static void* tableParaScanWorker(void* param) {
+  STableParaScanInfo* pPara = param;
+  STableScanInfo*     pInfo = pPara->pOperator->info;
+  int32_t             code = TSDB_CODE_SUCCESS;
+
+  setThreadName("para-scan");
+
+  SSDataBlock* pResBlock = createOneDataBlock(pInfo->pResBlock, false);
+  if (pResBlock == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  while (code == TSDB_CODE_SUCCESS && !atomic_load_8((int8_t*)&pPara->quit)) {
+    int32_t index = atomic_fetch_add_32(&pPara->nextMorsel, 1);
+    if (index >= pPara->numOfMorsels) {
+      break;
+    }
+    code = doTableParaScanMorsel(pPara, index, pResBlock);
+  }
+
+  blockDataDestroy(pResBlock);
+
+  taosThreadMutexLock(&pPara->lock);
+  if (code != TSDB_CODE_SUCCESS && pPara->code == TSDB_CODE_SUCCESS) {
+    pPara->code = code;
+  }
+  pPara->runningWorkers -= 1;
+  taosThreadCondBroadcast(&pPara->notEmpty);
+  taosThreadMutexUnlock(&pPara->lock);
+
+  releaseTableParaScanWorkers(1);
+  return NULL;
+}
+
+// ask the workers to stop, the blocks that are being pushed are discarded
+static void stopTableParaScan(STableParaScanInfo* pPara) {
+  taosThreadMutexLock(&pPara->lock);
+  pPara->quit = true;
+  taosThreadCondBroadcast(&pPara->notFull);
+  taosThreadMutexUnlock(&pPara->lock);
+}
+
+static void destroyTableParaScanInfo(STableParaScanInfo* pPara) {
+  if (pPara == NULL) {
+    return;
+  }
+
+  stopTableParaScan(pPara);
+  for (int32_t i = 0; i < pPara->numOfWorkers; ++i) {
+    taosThreadJoin(pPara->pWorkers[i], NULL);
+  }
+
+  for (int32_t i = 0; i < pPara->queueSize; ++i) {
+    blockDataDestroy(pPara->pQueue[(pPara->queueHead + i) % pPara->queueCap]);
+  }
+
+  blockDataDestroy(pPara->pCurBlock);
+  taosThreadCondDestroy(&pPara->notFull);
+  taosThreadCondDestroy(&pPara->notEmpty);
+  taosThreadMutexDestroy(&pPara->lock);
+  taosMemoryFree(pPara->pQueue);
+  taosMemoryFree(pPara->pWorkers);
+  taosMemoryFree(pPara->pTableList);
+  taosMemoryFree(pPara);
+}
+
+// *ppPara is NULL if less than two workers can be reserved, and the tables are scanned by the operator thread then
+static int32_t createTableParaScanInfo(SOperatorInfo* pOperator, STableParaScanInfo** ppPara) {
+  STableScanInfo* pInfo = pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+
+  int32_t numOfWorkers = reserveTableParaScanWorkers(pInfo->scanParallelism);
+  if (numOfWorkers < 2) {
+    releaseTableParaScanWorkers(numOfWorkers);
+    qDebug("%s no readers available for the parallel scan, scan the tables serially", GET_TASKID(pTaskInfo));
+    return TSDB_CODE_SUCCESS;
+  }
+
+  STableParaScanInfo* pPara = taosMemoryCalloc(1, sizeof(STableParaScanInfo));
+  if (pPara == NULL) {
+    releaseTableParaScanWorkers(numOfWorkers);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  taosThreadMutexInit(&pPara->lock, NULL);
+  taosThreadCondInit(&pPara->notEmpty, NULL);
+  taosThreadCondInit(&pPara->notFull, NULL);
+
+  taosRLockLatch(&pTaskInfo->lock);
+  pPara->numOfTables = tableListGetSize(pInfo->base.pTableListInfo);
+  pPara->pTableList = taosMemoryMalloc(sizeof(STableKeyInfo) * pPara->numOfTables);
+  if (pPara->pTableList != NULL) {
+    memcpy(pPara->pTableList, tableListGetInfo(pInfo->base.pTableListInfo, 0),
+           sizeof(STableKeyInfo) * pPara->numOfTables);
+  }
+  taosRUnLockLatch(&pTaskInfo->lock);
+
+  if (numOfWorkers > pPara->numOfTables) {
+    releaseTableParaScanWorkers(numOfWorkers - pPara->numOfTables);
+    numOfWorkers = pPara->numOfTables;
+  }
+
+  pPara->pOperator = pOperator;
+  pPara->morselSize = TMAX(1, pPara->numOfTables / (numOfWorkers * PARA_SCAN_MORSELS_PER_WORKER));
+  pPara->numOfMorsels = (pPara->numOfTables + pPara->morselSize - 1) / pPara->morselSize;
+  pPara->queueCap = numOfWorkers * PARA_SCAN_QUEUED_PER_WORKER;
+  pPara->pQueue = taosMemoryCalloc(pPara->queueCap, POINTER_BYTES);
+  pPara->pWorkers = taosMemoryCalloc(numOfWorkers, sizeof(TdThread));
+  if (pPara->pTableList == NULL || pPara->pQueue == NULL || pPara->pWorkers == NULL) {
+    releaseTableParaScanWorkers(numOfWorkers);
+    destroyTableParaScanInfo(pPara);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pPara->runningWorkers = numOfWorkers;
+  for (int32_t i = 0; i < numOfWorkers; ++i) {
+    if (taosThreadCreate(&pPara->pWorkers[i], NULL, tableParaScanWorker, pPara) != 0) {
+      int32_t code = TAOS_SYSTEM_ERROR(errno);
+      taosThreadMutexLock(&pPara->lock);
+      pPara->runningWorkers -= (numOfWorkers - i);
+      taosThreadMutexUnlock(&pPara->lock);
+      releaseTableParaScanWorkers(numOfWorkers - i);
+      destroyTableParaScanInfo(pPara);
+      return code;
+    }
+    pPara->numOfWorkers += 1;
+  }
+
+  qDebug("%s start to scan %d tables with %d readers, morsel size:%d", GET_TASKID(pTaskInfo), pPara->numOfTables,
+         numOfWorkers, pPara->morselSize);
+  *ppPara = pPara;
+  return TSDB_CODE_SUCCESS;
+}
+
+static SSDataBlock* doTableParaScan(SOperatorInfo* pOperator) {
+  STableScanInfo*     pInfo = pOperator->info;
+  STableParaScanInfo* pPara = pInfo->pParaScan;
+  SExecTaskInfo*      pTaskInfo = pOperator->pTaskInfo;
+
+  SFileBlockLoadRecorder* pCost = &pInfo->base.readRecorder;
+  int64_t                 st = taosGetTimestampUs();
+
+  blockDataDestroy(pPara->pCurBlock);
+  pPara->pCurBlock = NULL;
+
+  while (pOperator->status != OP_EXEC_DONE) {
+    if (isTaskKilled(pTaskInfo)) {
+      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+    }
+
+    SSDataBlock* pBlock = NULL;
+    int32_t      code = popTableParaScanBlock(pPara, &pBlock);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    if (pBlock == NULL) {
+      setOperatorCompleted(pOperator);
+      break;
+    }
+
+    pPara->pCurBlock = pBlock;
+    pBlock->info.id.groupId = tableListGetTableGroupId(pInfo->base.pTableListInfo, pBlock->info.id.uid);
+
+    pCost->totalBlocks += 1;
+    pCost->loadBlocks += 1;
+    pCost->totalCheckedRows += pBlock->info.rows;
+    doSetTagColumnData(&pInfo->base, pBlock, pTaskInfo, pBlock->info.rows);
+
+    if (pOperator->exprSupp.pFilterInfo != NULL) {
+      code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pInfo->base.matchInfo);
+      if (code != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+
+      if (pBlock->info.rows == 0) {
+        pCost->filterOutBlocks += 1;
+        continue;
+      }
+    }
+
+    if (applyLimitOffset(&pInfo->base.limitInfo, pBlock, pTaskInfo)) {
+      setOperatorCompleted(pOperator);
+      stopTableParaScan(pPara);
+    }
+
+    if (pBlock->info.rows == 0) {
+      continue;
+    }
+
+    pCost->totalRows += pBlock->info.rows;
+    pCost->elapsedTime += (taosGetTimestampUs() - st) / 1000.0;
+    pOperator->resultInfo.totalRows = pCost->totalRows;
+    pOperator->cost.totalCost = pCost->elapsedTime;
+    pBlock->info.scanFlag = pInfo->base.scanFlag;
+    return pBlock;
+  }
+
+  return NULL;
+}
+
 static SSDataBlock* doTableScan(SOperatorInfo* pOperator) {
   STableScanInfo* pInfo = pOperator->info;
   SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
@@ -1084,6 +1442,20 @@ static SSDataBlock* doTableScan(SOperatorInfo* pOperator) {
     }
   }
 
+  if (pInfo->pParaScan == NULL && pOperator->status != OP_EXEC_DONE && isTableParaScanAllowed(pOperator)) {
+    int32_t code = createTableParaScanInfo(pOperator, &pInfo->pParaScan);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+    if (pInfo->pParaScan == NULL) {
+      pInfo->scanParallelism = 1;
+    }
+  }
+
+  if (pInfo->pParaScan != NULL) {
+    return doTableParaScan(pOperator);
+  }
+
   // scan table one by one sequentially
   if (pInfo->scanMode == TABLE_SCAN__TABLE_ORDER) {
     int32_t       numOfTables = 0;  // tableListGetSize(pTaskInfo->pTableListInfo);
@@ -1149,6 +1521,7 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
 
 static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
+  destroyTableParaScanInfo(pTableScanInfo->pParaScan);
   blockDataDestroy(pTableScanInfo->pResBlock);
   taosHashCleanup(pTableScanInfo->pIgnoreTables);
   destroyTableScanBase(&pTableScanInfo->base, &pTableScanInfo->base.readerAPI);
@@ -1227,6 +1600,7 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
   }
 
   pInfo->filesetDelimited = pTableScanNode->filesetDelimited;
+  pInfo->scanParallelism = pTableScanNode->scanParallelism;
 
   taosLRUCacheSetStrictCapacity(pInfo->base.metaCache.pTableMetaEntryCache, false);
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doTableScan, NULL, destroyTableScanOperatorInfo,
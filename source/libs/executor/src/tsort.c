@@ -450,6 +450,167 @@ static void setCurrentSourceDone(SSortSource* pSource, SSortHandle* pHandle) {
   ++pHandle->numOfCompletedSources;
 }
 
+/*
+ * Normalized sort keys. Each sort column is encoded into a null byte followed by the value in big endian, so that
+ * the rows are ordered by memcmp of their keys:
+ *   - the null byte is 0 for the nulls placed first, 1 for the values and 2 for the nulls placed last
+ *   - the sign bit of the integers is flipped
+ *   - the value bytes are inverted for the descending order
+ * Only the integer, bool and timestamp columns are normalized. The float and double values are compared with the
+ * tolerance of FLT_EQUAL, which no byte order can keep. The in-memory blocks are sorted on these keys by a radix sort,
+ * and the sources of the merge tree cache the key of their current row.
+ */
+#define SORT_RADIX_SORT_MIN_ROWS 256
+
+static int32_t tsortGetNormKeyLen(SArray* pOrderInfo, const SSDataBlock* pBlock) {
+  int32_t len = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pOrder->slotId);
+    if (pCol == NULL) {
+      return 0;
+    }
+
+    int32_t type = pCol->info.type;
+    if (!IS_INTEGER_TYPE(type) && type != TSDB_DATA_TYPE_TIMESTAMP && type != TSDB_DATA_TYPE_BOOL) {
+      return 0;
+    }
+
+    len += 1 + tDataTypes[type].bytes;
+  }
+
+  return (len <= SORT_NORM_KEY_MAX_LEN) ? len : 0;
+}
+
+static char* tsortEncodeNormKey(const SColumnInfoData* pCol, int32_t rowIndex, const SBlockOrderInfo* pOrder,
+                                char* pKey) {
+  int32_t type = pCol->info.type;
+  int32_t bytes = tDataTypes[type].bytes;
+
+  if (colDataIsNull_s(pCol, rowIndex)) {
+    *pKey = pOrder->nullFirst ? 0 : 2;
+    memset(pKey + 1, 0, bytes);
+    return pKey + 1 + bytes;
+  }
+
+  const char* p = colDataGetNumData(pCol, rowIndex);
+  uint64_t    v = 0;
+  if (IS_SIGNED_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP || type == TSDB_DATA_TYPE_BOOL) {
+    int64_t iv = 0;
+    GET_TYPED_DATA(iv, int64_t, type, p);
+    v = ((uint64_t)iv) ^ (1ULL << (bytes * 8 - 1));
+  } else {
+    GET_TYPED_DATA(v, uint64_t, type, p);
+  }
+
+  if (pOrder->order == TSDB_ORDER_DESC) {
+    v = ~v;
+  }
+
+  *pKey++ = 1;
+  for (int32_t i = bytes - 1; i >= 0; --i) {
+    *pKey++ = (char)(v >> (i * 8));
+  }
+  return pKey;
+}
+
+static void tsortBuildNormKey(SArray* pOrderInfo, const SSDataBlock* pBlock, int32_t rowIndex, char* pKey) {
+  char* p = pKey;
+  for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
+    SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pOrderInfo, i);
+    SColumnInfoData* pCol = TARRAY_GET_ELEM(pBlock->pDataBlock, pOrder->slotId);
+    p = tsortEncodeNormKey(pCol, rowIndex, pOrder, p);
+  }
+}
+
+static const char* tsortGetSourceNormKey(SMsortComparParam* pParam, SSortSource* pSource) {
+  if (pSource->keyRowIndex != pSource->src.rowIndex) {
+    tsortBuildNormKey(pParam->orderInfo, pSource->src.pBlock, pSource->src.rowIndex, pSource->normKey);
+    pSource->keyRowIndex = pSource->src.rowIndex;
+  }
+
+  return pSource->normKey;
+}
+
+/*
+ * LSD radix sort of the rows on their normalized keys. The key and the row index are moved together, one byte a
+ * pass, and the bytes that are the same for all rows, e.g. the high bytes of timestamps, are skipped.
+ */
+static int32_t tsortRadixSortBlock(SArray* pOrderInfo, SSDataBlock* pBlock, bool* pSorted) {
+  *pSorted = false;
+
+  int32_t rows = pBlock->info.rows;
+  int32_t keyLen = tsortGetNormKeyLen(pOrderInfo, pBlock);
+  if (keyLen == 0 || rows < SORT_RADIX_SORT_MIN_ROWS) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t  stride = keyLen + sizeof(int32_t);
+  char*    pBuf = taosMemoryMalloc((size_t)rows * stride * 2);
+  int32_t* pHist = taosMemoryCalloc(keyLen * 256, sizeof(int32_t));
+  int32_t* index = taosMemoryMalloc(rows * sizeof(int32_t));
+  if (pBuf == NULL || pHist == NULL || index == NULL) {
+    taosMemoryFree(pBuf);
+    taosMemoryFree(pHist);
+    taosMemoryFree(index);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return terrno;
+  }
+
+  char* pSrc = pBuf;
+  char* pDst = pBuf + (size_t)rows * stride;
+  for (int32_t r = 0; r < rows; ++r) {
+    char* pEntry = pSrc + (size_t)r * stride;
+    tsortBuildNormKey(pOrderInfo, pBlock, r, pEntry);
+    memcpy(pEntry + keyLen, &r, sizeof(int32_t));
+    for (int32_t b = 0; b < keyLen; ++b) {
+      pHist[b * 256 + (uint8_t)pEntry[b]] += 1;
+    }
+  }
+
+  for (int32_t b = keyLen - 1; b >= 0; --b) {
+    int32_t* pCount = pHist + b * 256;
+    if (pCount[(uint8_t)pSrc[b]] == rows) {
+      continue;
+    }
+
+    int32_t offset = 0;
+    for (int32_t d = 0; d < 256; ++d) {
+      int32_t c = pCount[d];
+      pCount[d] = offset;
+      offset += c;
+    }
+
+    for (int32_t r = 0; r < rows; ++r) {
+      char* pEntry = pSrc + (size_t)r * stride;
+      memcpy(pDst + (size_t)(pCount[(uint8_t)pEntry[b]]++) * stride, pEntry, stride);
+    }
+    TSWAP(pSrc, pDst);
+  }
+
+  for (int32_t r = 0; r < rows; ++r) {
+    memcpy(&index[r], pSrc + (size_t)r * stride + keyLen, sizeof(int32_t));
+  }
+
+  int32_t code = blockDataReorderRows(pBlock, index);
+  taosMemoryFree(pBuf);
+  taosMemoryFree(pHist);
+  taosMemoryFree(index);
+
+  *pSorted = (code == TSDB_CODE_SUCCESS);
+  return code;
+}
+
+int32_t tsortSortBlock(SArray* pOrderInfo, SSDataBlock* pBlock) {
+  bool    sorted = false;
+  int32_t code = tsortRadixSortBlock(pOrderInfo, pBlock, &sorted);
+  if (code != TSDB_CODE_SUCCESS || sorted) {
+    return code;
+  }
+
+  return blockDataSort(pBlock, pOrderInfo);
+}
+
 static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32_t startIndex, int32_t endIndex,
                               SSortHandle* pHandle) {
   pParam->pSources = taosArrayGet(pSources, startIndex);
@@ -517,6 +678,15 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
     qDebug("init for merge sort completed, elapsed time:%.2f ms, %s", (et - st) / 1000.0, pHandle->idStr);
   }
 
+  pParam->normKeyLen = 0;
+  for (int32_t i = 0; i < pParam->numOfSources; ++i) {
+    SSortSource* pSource = pParam->pSources[i];
+    pSource->keyRowIndex = -1;
+    if (pParam->normKeyLen == 0 && pParam->sortType != SORT_BLOCK_TS_MERGE && pSource->src.pBlock != NULL) {
+      pParam->normKeyLen = tsortGetNormKeyLen(pParam->orderInfo, pSource->src.pBlock);
+    }
+  }
+
   return code;
 }
 
@@ -547,6 +717,7 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
    */
   if (pSource->src.rowIndex >= pSource->src.pBlock->info.rows) {
     pSource->src.rowIndex = 0;
+    pSource->keyRowIndex = -1;
 
     if (pHandle->type == SORT_SINGLESOURCE_SORT) {
       pSource->pageIndex++;
@@ -728,6 +899,13 @@ int32_t msortComparFn(const void* pLeft, const void* pRight, void* param) {
     }
     return ret;
   } else {
+    // the cached keys decide the comparison without going through the columns
+    if (pParam->normKeyLen > 0 && pLeftBlock->pBlockAgg == NULL && pRightBlock->pBlockAgg == NULL) {
+      int32_t ret = memcmp(tsortGetSourceNormKey(pParam, pLeftSource), tsortGetSourceNormKey(pParam, pRightSource),
+                           pParam->normKeyLen);
+      return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
+    }
+
     bool isVarType;
     for (int32_t i = 0; i < pInfo->size; ++i) {
       SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pInfo, i);
@@ -1931,7 +2109,7 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     if (size > sortBufSize) {
       // Perform the in-memory sort and then flush data in the buffer into disk.
       int64_t p = taosGetTimestampUs();
-      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+      code = tsortSortBlock(pHandle->pSortInfo, pHandle->pDataBlock);
       if (code != 0) {
         freeSSortSource(source);
         return code;
@@ -1956,7 +2134,7 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     // Perform the in-memory sort and then flush data in the buffer into disk.
     int64_t p = taosGetTimestampUs();
 
-    code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+    code = tsortSortBlock(pHandle->pSortInfo, pHandle->pDataBlock);
     if (code != 0) {
       return code;
     }
@@ -2164,6 +2342,106 @@ static int32_t tupleComparFn(const void* pLeft, const void* pRight, void* param)
   return 0;
 }
 
+/*
+ * Once the bounded queue is full, its top is the worst row kept. The rows whose first sort key is already worse than
+ * that of the top can never get into the queue, so they are dropped by a typed loop over the column before any tuple
+ * is compared or allocated. The threshold only gets tighter, and it is refreshed for every SORT_PQ_FILTER_ROWS rows.
+ */
+#define SORT_PQ_FILTER_ROWS 1024
+
+#define PQ_INT_GREATER(_v, _t) ((_v) > (_t))
+#define PQ_FLT_GREATER(_v, _t) (!isnan(_v) && (isnan(_t) || FLT_GREATER((_v), (_t))))
+
+#define PQ_SELECT_NOT_WORSE(_type, _greater)        \
+  do {                                              \
+    const _type* pv = (const _type*)pCol->pData;    \
+    _type        t = *(const _type*)pThreshold;     \
+    if (pOrder->order == TSDB_ORDER_DESC) {         \
+      for (int32_t i = start; i < end; ++i) {       \
+        pSel[num] = i;                              \
+        num += !_greater(t, pv[i]);                 \
+      }                                             \
+    } else {                                        \
+      for (int32_t i = start; i < end; ++i) {       \
+        pSel[num] = i;                              \
+        num += !_greater(pv[i], t);                 \
+      }                                             \
+    }                                               \
+  } while (0)
+
+static int32_t tsortPQSelectRows(SSortHandle* pHandle, SSDataBlock* pBlock, int32_t start, int32_t end,
+                                 int32_t* pSel) {
+  SBlockOrderInfo* pOrder = taosArrayGet(pHandle->pSortInfo, 0);
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pOrder->slotId);
+  int32_t          type = pCol->info.type;
+  int32_t          num = 0;
+
+  PriorityQueueNode* pTop = taosBQTop(pHandle->pBoundedQueue);
+  void*              pThreshold = tupleDescGetField(pTop->data, pOrder->slotId, blockDataGetNumOfCols(pBlock));
+
+  // nothing is worse than a null placed last
+  if ((pThreshold == NULL && !pOrder->nullFirst) || IS_VAR_DATA_TYPE(type) || type == TSDB_DATA_TYPE_JSON) {
+    for (int32_t i = start; i < end; ++i) {
+      pSel[num++] = i;
+    }
+    return num;
+  }
+
+  if (pThreshold == NULL || pCol->hasNull) {
+    __compar_fn_t fn = getKeyComparFunc(type, pOrder->order);
+    for (int32_t i = start; i < end; ++i) {
+      if (colDataIsNull_s(pCol, i)) {
+        if (pOrder->nullFirst) pSel[num++] = i;
+      } else if (pThreshold != NULL && fn(colDataGetNumData(pCol, i), pThreshold) <= 0) {
+        pSel[num++] = i;
+      }
+    }
+    return num;
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      PQ_SELECT_NOT_WORSE(int8_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      PQ_SELECT_NOT_WORSE(uint8_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      PQ_SELECT_NOT_WORSE(int16_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      PQ_SELECT_NOT_WORSE(uint16_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      PQ_SELECT_NOT_WORSE(int32_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      PQ_SELECT_NOT_WORSE(uint32_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      PQ_SELECT_NOT_WORSE(int64_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      PQ_SELECT_NOT_WORSE(uint64_t, PQ_INT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      PQ_SELECT_NOT_WORSE(float, PQ_FLT_GREATER);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      PQ_SELECT_NOT_WORSE(double, PQ_FLT_GREATER);
+      break;
+    default:
+      for (int32_t i = start; i < end; ++i) {
+        pSel[num++] = i;
+      }
+      break;
+  }
+
+  return num;
+}
+
 static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
   pHandle->pBoundedQueue = createBoundedQueue(pHandle->pqMaxRows, tsortPQCompFn, destroyTuple, pHandle);
   if (NULL == pHandle->pBoundedQueue) return TSDB_CODE_OUT_OF_MEMORY;
@@ -2200,15 +2478,28 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
       }
     }
     ReferencedTuple refTuple = {.desc.data = (char*)pBlock, .desc.type = ReferencedTupleType, .rowIndex = 0};
-    for (size_t rowIdx = 0; rowIdx < pBlock->info.rows; ++rowIdx) {
-      refTuple.rowIndex = rowIdx;
-      pqNode.data = &refTuple;
-      PriorityQueueNode* pPushedNode = taosBQPush(pHandle->pBoundedQueue, &pqNode);
-      if (!pPushedNode) {
-        // do nothing if push failed
+    int32_t         sel[SORT_PQ_FILTER_ROWS];
+    for (int32_t start = 0; start < pBlock->info.rows; start += SORT_PQ_FILTER_ROWS) {
+      int32_t end = TMIN(start + SORT_PQ_FILTER_ROWS, pBlock->info.rows);
+      int32_t num = 0;
+      if (taosBQSize(pHandle->pBoundedQueue) == taosBQMaxSize(pHandle->pBoundedQueue) + 1) {
+        num = tsortPQSelectRows(pHandle, pBlock, start, end, sel);
       } else {
-        pPushedNode->data = createAllocatedTuple(pBlock, colNum, tupleLen, rowIdx);
-        if (pPushedNode->data == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+        for (int32_t i = start; i < end; ++i) {
+          sel[num++] = i;
+        }
+      }
+
+      for (int32_t i = 0; i < num; ++i) {
+        refTuple.rowIndex = sel[i];
+        pqNode.data = &refTuple;
+        PriorityQueueNode* pPushedNode = taosBQPush(pHandle->pBoundedQueue, &pqNode);
+        if (!pPushedNode) {
+          // do nothing if push failed
+        } else {
+          pPushedNode->data = createAllocatedTuple(pBlock, colNum, tupleLen, sel[i]);
+          if (pPushedNode->data == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+        }
       }
     }
   }
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+// the input block of the group by operator:
+// k1 int, k2 bigint, s1 varchar (k1 as string), s2 varchar (k2 as string), v bigint
+enum {
+  GT_SLOT_K1 = 0,
+  GT_SLOT_K2,
+  GT_SLOT_S1,
+  GT_SLOT_S2,
+  GT_SLOT_V,
+  GT_INPUT_SLOT_NUM,
+};
+
+#define GT_INPUT_BLK_ID 0
+#define GT_RES_BLK_ID   1
+#define GT_VAR_BYTES    (VARSTR_HEADER_SIZE + 24)
+
+typedef struct {
+  int32_t k1;
+  int64_t k2;
+  bool    k1Null;
+  bool    k2Null;
+  int64_t v;
+} SGroupTestRow;
+
+typedef std::map<std::string, std::pair<int64_t, int64_t>> SGroupTestRes;  // key -> (count(v), sum(v))
+
+struct SGroupTestCtx {
+  std::vector<SGroupTestRow> rows;
+  SArray*                    pBlocks;
+  int32_t                    readIdx;
+} gtCtx;
+
+int8_t gtSlotType(int32_t slotId) {
+  switch (slotId) {
+    case GT_SLOT_K1:
+      return TSDB_DATA_TYPE_INT;
+    case GT_SLOT_S1:
+    case GT_SLOT_S2:
+      return TSDB_DATA_TYPE_VARCHAR;
+    default:
+      return TSDB_DATA_TYPE_BIGINT;
+  }
+}
+
+int32_t gtSlotBytes(int32_t slotId) {
+  int8_t type = gtSlotType(slotId);
+  return IS_VAR_DATA_TYPE(type) ? GT_VAR_BYTES : tDataTypes[type].bytes;
+}
+
+bool gtSlotIsNull(const SGroupTestRow* pRow, int32_t slotId) {
+  switch (slotId) {
+    case GT_SLOT_K1:
+    case GT_SLOT_S1:
+      return pRow->k1Null;
+    case GT_SLOT_K2:
+    case GT_SLOT_S2:
+      return pRow->k2Null;
+    default:
+      return false;
+  }
+}
+
+std::string gtSlotString(const SGroupTestRow* pRow, int32_t slotId) {
+  if (gtSlotIsNull(pRow, slotId)) {
+    return "NULL";
+  }
+
+  switch (slotId) {
+    case GT_SLOT_K1:
+    case GT_SLOT_S1:
+      return std::to_string(pRow->k1);
+    default:
+      return std::to_string(pRow->k2);
+  }
+}
+
+// rows of the same key come in short runs, so that both the adjacent-row shortcut and the probing are exercised.
+void createInputRows(int32_t numOfRows, int32_t k1Range, int32_t k2Range, int32_t nullPercent) {
+  gtCtx.rows.clear();
+
+  while (gtCtx.rows.size() < (size_t)numOfRows) {
+    SGroupTestRow row = {0};
+    row.k1Null = (taosRand() % 100) < nullPercent;
+    row.k2Null = (taosRand() % 100) < nullPercent;
+    row.k1 = row.k1Null ? 0 : (int32_t)(taosRand() % k1Range) - k1Range / 2;
+    row.k2 = row.k2Null ? 0 : ((int64_t)(taosRand() % k2Range) << 33) - 1;
+
+    int32_t runLen = 1 + taosRand() % 4;
+    for (int32_t i = 0; i < runLen && gtCtx.rows.size() < (size_t)numOfRows; ++i) {
+      row.v = taosRand() % 1000;
+      gtCtx.rows.push_back(row);
+    }
+  }
+}
+
+SSDataBlock* createInputBlock(int32_t start, int32_t num) {
+  SSDataBlock* pBlock = createDataBlock();
+  pBlock->info.id.blockId = GT_INPUT_BLK_ID;
+
+  for (int32_t i = 0; i < GT_INPUT_SLOT_NUM; ++i) {
+    SColumnInfoData col = createColumnInfoData(gtSlotType(i), gtSlotBytes(i), i);
+    blockDataAppendColInfo(pBlock, &col);
+  }
+
+  blockDataEnsureCapacity(pBlock, num);
+
+  char buf[GT_VAR_BYTES];
+  for (int32_t r = 0; r < num; ++r) {
+    const SGroupTestRow* pRow = &gtCtx.rows[start + r];
+    for (int32_t i = 0; i < GT_INPUT_SLOT_NUM; ++i) {
+      SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, i);
+      if (gtSlotIsNull(pRow, i)) {
+        colDataSetNULL(pCol, r);
+      } else if (i == GT_SLOT_K1) {
+        colDataSetVal(pCol, r, (const char*)&pRow->k1, false);
+      } else if (i == GT_SLOT_K2) {
+        colDataSetVal(pCol, r, (const char*)&pRow->k2, false);
+      } else if (i == GT_SLOT_V) {
+        colDataSetVal(pCol, r, (const char*)&pRow->v, false);
+      } else {
+        std::string s = gtSlotString(pRow, i);
+        STR_WITH_SIZE_TO_VARSTR(buf, s.c_str(), s.size());
+        colDataSetVal(pCol, r, buf, false);
+      }
+    }
+  }
+
+  pBlock->info.rows = num;
+  return pBlock;
+}
+
+void createInputBlocks(int32_t blockRows) {
+  gtCtx.pBlocks = taosArrayInit(8, POINTER_BYTES);
+  gtCtx.readIdx = 0;
+
+  for (int32_t start = 0; start < (int32_t)gtCtx.rows.size(); start += blockRows) {
+    int32_t      num = TMIN(blockRows, (int32_t)gtCtx.rows.size() - start);
+    SSDataBlock* pBlock = createInputBlock(start, num);
+    taosArrayPush(gtCtx.pBlocks, &pBlock);
+  }
+}
+
+void destroyInputBlocks() {
+  for (int32_t i = 0; i < taosArrayGetSize(gtCtx.pBlocks); ++i) {
+    blockDataDestroy((SSDataBlock*)taosArrayGetP(gtCtx.pBlocks, i));
+  }
+  taosArrayDestroy(gtCtx.pBlocks);
+  gtCtx.pBlocks = NULL;
+}
+
+SSDataBlock* getDummyInputBlock(SOperatorInfo* pOperator) {
+  if (gtCtx.readIdx >= taosArrayGetSize(gtCtx.pBlocks)) {
+    return NULL;
+  }
+  return (SSDataBlock*)taosArrayGetP(gtCtx.pBlocks, gtCtx.readIdx++);
+}
+
+SNode* createInputColumn(int32_t slotId) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->node.resType.type = gtSlotType(slotId);
+  pCol->node.resType.bytes = gtSlotBytes(slotId);
+  pCol->dataBlockId = GT_INPUT_BLK_ID;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return (SNode*)pCol;
+}
+
+SNode* createTarget(int32_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = GT_RES_BLK_ID;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  return (SNode*)pTarget;
+}
+
+SNode* createAggFunc(const char* pName) {
+  SFunctionNode* pFunc = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  tstrncpy(pFunc->functionName, pName, sizeof(pFunc->functionName));
+  nodesListMakeStrictAppend(&pFunc->pParameterList, createInputColumn(GT_SLOT_V));
+
+  char msg[128] = {0};
+  EXPECT_EQ(fmGetFuncInfo(pFunc, msg, sizeof(msg)), TSDB_CODE_SUCCESS);
+  return (SNode*)pFunc;
+}
+
+void appendOutputSlot(SDataBlockDescNode* pDesc, int32_t slotId, int8_t type, int32_t bytes) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType.type = type;
+  pSlot->dataType.bytes = bytes;
+  pSlot->output = true;
+  nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot);
+
+  pDesc->totalRowSize += bytes;
+  pDesc->outputRowSize += bytes;
+}
+
+// select count(v), sum(v), <keys> from input group by <keys>
+SAggPhysiNode* createGroupbyPhysiNode(const std::vector<int32_t>& keySlots) {
+  SAggPhysiNode* pNode = (SAggPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG);
+  pNode->node.inputTsOrder = ORDER_ASC;
+  pNode->node.outputTsOrder = ORDER_ASC;
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = GT_RES_BLK_ID;
+
+  nodesListMakeStrictAppend(&pNode->pAggFuncs, createTarget(0, createAggFunc("count")));
+  nodesListMakeStrictAppend(&pNode->pAggFuncs, createTarget(1, createAggFunc("sum")));
+  appendOutputSlot(pDesc, 0, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t));
+  appendOutputSlot(pDesc, 1, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t));
+
+  for (int32_t i = 0; i < (int32_t)keySlots.size(); ++i) {
+    nodesListMakeStrictAppend(&pNode->pGroupKeys, createTarget(2 + i, createInputColumn(keySlots[i])));
+    appendOutputSlot(pDesc, 2 + i, gtSlotType(keySlots[i]), gtSlotBytes(keySlots[i]));
+  }
+
+  pNode->node.pOutputDataBlockDesc = pDesc;
+  return pNode;
+}
+
+std::string getResultKey(SSDataBlock* pRes, int32_t numOfKeys, int32_t row) {
+  std::string key;
+  for (int32_t i = 0; i < numOfKeys; ++i) {
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 2 + i);
+    if (i > 0) {
+      key += "|";
+    }
+
+    if (colDataIsNull_s(pCol, row)) {
+      key += "NULL";
+    } else if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+      char* p = colDataGetData(pCol, row);
+      key += std::string(varDataVal(p), varDataLen(p));
+    } else if (pCol->info.type == TSDB_DATA_TYPE_INT) {
+      key += std::to_string(*(int32_t*)colDataGetData(pCol, row));
+    } else {
+      key += std::to_string(*(int64_t*)colDataGetData(pCol, row));
+    }
+  }
+
+  return key;
+}
+
+SGroupTestRes runGroupby(const std::vector<int32_t>& keySlots, int32_t blockRows) {
+  SGroupTestRes  res;
+  SExecTaskInfo* pTask = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pTask->id.str = "groupbyTest";
+
+  createInputBlocks(blockRows);
+
+  SOperatorInfo* pDownstream = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pDownstream->fpSet.getNextFn = getDummyInputBlock;
+  pDownstream->resultDataBlockId = GT_INPUT_BLK_ID;
+
+  SAggPhysiNode* pNode = createGroupbyPhysiNode(keySlots);
+  SOperatorInfo* pOperator = createGroupOperatorInfo(pDownstream, pNode, pTask);
+  EXPECT_TRUE(pOperator != NULL) << tstrerror(pTask->code);
+  if (pOperator == NULL) {
+    return res;
+  }
+
+  while (1) {
+    SSDataBlock* pRes = pOperator->fpSet.getNextFn(pOperator);
+    if (pRes == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pCount = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0);
+    SColumnInfoData* pSum = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1);
+    for (int32_t r = 0; r < pRes->info.rows; ++r) {
+      std::string key = getResultKey(pRes, keySlots.size(), r);
+      EXPECT_TRUE(res.find(key) == res.end()) << "duplicated group " << key;
+      res[key] = std::make_pair(*(int64_t*)colDataGetData(pCount, r), *(int64_t*)colDataGetData(pSum, r));
+    }
+  }
+
+  destroyOperator(pOperator);
+  nodesDestroyNode((SNode*)pNode);
+  destroyInputBlocks();
+  taosMemoryFree(pTask);
+  return res;
+}
+
+// the expected groups, built row by row from the generated input
+SGroupTestRes buildExpectedResult(const std::vector<int32_t>& keySlots) {
+  SGroupTestRes res;
+  for (const SGroupTestRow& row : gtCtx.rows) {
+    std::string key;
+    for (int32_t i = 0; i < (int32_t)keySlots.size(); ++i) {
+      key += (i > 0 ? "|" : "") + gtSlotString(&row, keySlots[i]);
+    }
+
+    std::pair<int64_t, int64_t>& v = res[key];
+    v.first += 1;
+    v.second += row.v;
+  }
+
+  return res;
+}
+
+// group by the fixed-width keys takes the batch path, and group by the same keys as strings takes the per-row path.
+void checkGroupbyResult(const std::vector<int32_t>& fixedKeys, const std::vector<int32_t>& varKeys,
+                        int32_t blockRows) {
+  SGroupTestRes expect = buildExpectedResult(fixedKeys);
+  SGroupTestRes batchRes = runGroupby(fixedKeys, blockRows);
+  SGroupTestRes rowRes = runGroupby(varKeys, blockRows);
+
+  ASSERT_EQ(batchRes.size(), expect.size());
+  ASSERT_EQ(rowRes.size(), expect.size());
+  EXPECT_TRUE(batchRes == rowRes);
+  EXPECT_TRUE(batchRes == expect);
+}
+
+}  // namespace
+
+TEST(groupbyTest, singleKeyWithNull) {
+  createInputRows(10000, 100, 1, 10);
+  checkGroupbyResult({GT_SLOT_K1}, {GT_SLOT_S1}, 4096);
+
+  createInputRows(10000, 100, 1, 100);
+  checkGroupbyResult({GT_SLOT_K1}, {GT_SLOT_S1}, 4096);
+}
+
+TEST(groupbyTest, multiKeysWithNull) {
+  createInputRows(20000, 50, 8, 5);
+  checkGroupbyResult({GT_SLOT_K1, GT_SLOT_K2}, {GT_SLOT_S1, GT_SLOT_S2}, 1000);
+  checkGroupbyResult({GT_SLOT_K2, GT_SLOT_K1}, {GT_SLOT_S2, GT_SLOT_S1}, 333);
+}
+
+TEST(groupbyTest, manyGroups) {
+  // more groups than the initial slots of the key table, so that it grows several times
+  createInputRows(50000, 4000, 4, 1);
+  checkGroupbyResult({GT_SLOT_K1, GT_SLOT_K2}, {GT_SLOT_S1, GT_SLOT_S2}, 4096);
+}
+
+TEST(groupbyTest, mixedVarKeys) {
+  createInputRows(10000, 30, 6, 10);
+  checkGroupbyResult({GT_SLOT_K1, GT_SLOT_S2}, {GT_SLOT_S1, GT_SLOT_K2}, 1024);
+}
+
+int main(int argc, char** argv) {
+  taosSeedRand(taosGetTimestampSec());
+  osDefaultInit();
+  osUpdate();
+  fmFuncMgtInit();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tcompare.h"
+#include "tdatablock.h"
+#include "tsort.h"
+
+/*
+ * rows/s of the sort on numeric and timestamp columns:
+ *   run:   the in-memory sort of one block, blockDataSort vs the radix sort of tsortSortBlock
+ *   merge: the external sort by tsort, merging with a plain column comparator vs the cached normalized keys
+ *   topn:  the first rows of the external sort vs the bounded queue of tsort, which skips the rows that can not
+ *          get into it, and both must return the same keys
+ */
+#define BENCH_MAX_KEYS   3
+#define BENCH_BLOCK_ROWS 4096
+
+typedef struct {
+  const char* name;
+  int32_t     numOfKeys;
+  int16_t     types[BENCH_MAX_KEYS];
+  int32_t     orders[BENCH_MAX_KEYS];
+  int32_t     nullPercent;
+} SBenchCase;
+
+static const SBenchCase benchCase[] = {
+    {"ts", 1, {TSDB_DATA_TYPE_TIMESTAMP}, {TSDB_ORDER_ASC}, 0},
+    {"bigint_desc_null", 1, {TSDB_DATA_TYPE_BIGINT}, {TSDB_ORDER_DESC}, 5},
+    {"double", 1, {TSDB_DATA_TYPE_DOUBLE}, {TSDB_ORDER_ASC}, 0},
+    {"int_ts", 2, {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_TIMESTAMP}, {TSDB_ORDER_ASC, TSDB_ORDER_DESC}, 0},
+    {"tinyint_int_double",
+     3,
+     {TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_DOUBLE},
+     {TSDB_ORDER_ASC, TSDB_ORDER_DESC, TSDB_ORDER_ASC},
+     1},
+};
+
+typedef struct {
+  char v[BENCH_MAX_KEYS][8];
+  bool isNull[BENCH_MAX_KEYS];
+} SBenchKey;
+
+typedef struct {
+  const SBenchCase* pCase;
+  SSDataBlock*      pBlock;
+  int64_t           numOfRows;
+  uint32_t          seed;
+} SBenchSource;
+
+static uint32_t benchRand(uint32_t* seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 1) & 0x7fffffff;
+}
+
+static void genBenchValue(int32_t key, int16_t type, uint32_t* seed, char* buf) {
+  int64_t r = ((int64_t)benchRand(seed) << 31) | benchRand(seed);
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      *(int8_t*)buf = (int8_t)(r % 16);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      // a low cardinality leading key, or a wide one after it
+      *(int32_t*)buf = (key == 0) ? (int32_t)(r % 1000) : (int32_t)(r % 2000000) - 1000000;
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      *(int64_t*)buf = r - (1LL << 61);
+      break;
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      *(int64_t*)buf = 1700000000000LL + r % (86400000LL * 30);
+      break;
+    default:
+      *(double*)buf = (r % 2000000) / 1000.0 - 1000.0;
+      break;
+  }
+}
+
+static SSDataBlock* createBenchBlock(const SBenchCase* pCase, int32_t capacity) {
+  SSDataBlock* pBlock = createDataBlock();
+  for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+    SColumnInfoData col = createColumnInfoData(pCase->types[i], tDataTypes[pCase->types[i]].bytes, i + 1);
+    blockDataAppendColInfo(pBlock, &col);
+  }
+
+  // the payload column
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), pCase->numOfKeys + 1);
+  blockDataAppendColInfo(pBlock, &col);
+  blockDataEnsureCapacity(pBlock, capacity);
+  return pBlock;
+}
+
+static void fillBenchBlock(const SBenchCase* pCase, SSDataBlock* pBlock, int32_t rows, uint32_t* seed) {
+  blockDataCleanup(pBlock);
+  for (int32_t r = 0; r < rows; ++r) {
+    for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+      char             buf[8] = {0};
+      genBenchValue(i, pCase->types[i], seed, buf);
+      colDataSetVal(pCol, r, buf, (benchRand(seed) % 100) < pCase->nullPercent);
+    }
+
+    int64_t v = r;
+    colDataSetVal(taosArrayGet(pBlock->pDataBlock, pCase->numOfKeys), r, (const char*)&v, false);
+  }
+  pBlock->info.rows = rows;
+}
+
+static SArray* createBenchOrderInfo(const SBenchCase* pCase) {
+  SArray* pOrderInfo = taosArrayInit(pCase->numOfKeys, sizeof(SBlockOrderInfo));
+  for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+    SBlockOrderInfo oi = {.order = pCase->orders[i], .slotId = i, .nullFirst = (pCase->orders[i] == TSDB_ORDER_ASC)};
+    taosArrayPush(pOrderInfo, &oi);
+  }
+  return pOrderInfo;
+}
+
+static int32_t compareBenchValue(const SBlockOrderInfo* pOrder, int16_t type, bool leftNull, const void* pLeft,
+                                 bool rightNull, const void* pRight) {
+  if (leftNull || rightNull) {
+    if (leftNull && rightNull) return 0;
+    if (leftNull) return pOrder->nullFirst ? -1 : 1;
+    return pOrder->nullFirst ? 1 : -1;
+  }
+
+  __compar_fn_t fn = getKeyComparFunc(type, pOrder->order);
+  return fn(pLeft, pRight);
+}
+
+// the comparison of the merge tree column by column, as msortComparFn does without the normalized keys
+static int32_t benchMergeComparFn(const void* pLeft, const void* pRight, void* param) {
+  SMsortComparParam* pParam = param;
+  SSortSource*       pLeftSource = pParam->pSources[*(int32_t*)pLeft];
+  SSortSource*       pRightSource = pParam->pSources[*(int32_t*)pRight];
+
+  if (pLeftSource->src.rowIndex == -1) return 1;
+  if (pRightSource->src.rowIndex == -1) return -1;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pParam->orderInfo); ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pParam->orderInfo, i);
+    SColumnInfoData* pLeftCol = taosArrayGet(pLeftSource->src.pBlock->pDataBlock, pOrder->slotId);
+    SColumnInfoData* pRightCol = taosArrayGet(pRightSource->src.pBlock->pDataBlock, pOrder->slotId);
+    int32_t          lr = pLeftSource->src.rowIndex;
+    int32_t          rr = pRightSource->src.rowIndex;
+
+    int32_t ret = compareBenchValue(pOrder, pLeftCol->info.type, colDataIsNull_s(pLeftCol, lr),
+                                    colDataGetNumData(pLeftCol, lr), colDataIsNull_s(pRightCol, rr),
+                                    colDataGetNumData(pRightCol, rr));
+    if (ret != 0) return ret;
+  }
+  return 0;
+}
+
+static bool checkBlockSorted(const SBenchCase* pCase, SArray* pOrderInfo, SSDataBlock* pBlock) {
+  for (int32_t r = 1; r < pBlock->info.rows; ++r) {
+    for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+      SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+
+      int32_t ret = compareBenchValue(pOrder, pCase->types[i], colDataIsNull_s(pCol, r - 1),
+                                      colDataGetNumData(pCol, r - 1), colDataIsNull_s(pCol, r),
+                                      colDataGetNumData(pCol, r));
+      if (ret > 0) return false;
+      if (ret < 0) break;
+    }
+  }
+  return true;
+}
+
+static SSDataBlock* fetchBenchBlock(void* param) {
+  SBenchSource* pSource = param;
+  if (pSource->numOfRows <= 0) {
+    return NULL;
+  }
+
+  int32_t rows = (int32_t)TMIN(pSource->numOfRows, BENCH_BLOCK_ROWS);
+  fillBenchBlock(pSource->pCase, pSource->pBlock, rows, &pSource->seed);
+  pSource->numOfRows -= rows;
+  return pSource->pBlock;
+}
+
+// the sort of one block, returns the time used in us
+static int64_t benchRunSort(const SBenchCase* pCase, SArray* pOrderInfo, SSDataBlock* pOrigin, bool radix) {
+  SSDataBlock* pBlock = createOneDataBlock(pOrigin, true);
+
+  int64_t st = taosGetTimestampUs();
+  int32_t code = radix ? tsortSortBlock(pOrderInfo, pBlock) : blockDataSort(pBlock, pOrderInfo);
+  int64_t used = taosGetTimestampUs() - st;
+
+  if (code != TSDB_CODE_SUCCESS || !checkBlockSorted(pCase, pOrderInfo, pBlock)) {
+    printf("%s: the block is not sorted, code:%d\n", pCase->name, code);
+    used = -1;
+  }
+
+  blockDataDestroy(pBlock);
+  return used;
+}
+
+// the external sort of numOfRows rows, returns the time used in us
+static int64_t benchMergeSort(const SBenchCase* pCase, SArray* pOrderInfo, int64_t numOfRows, bool normKey) {
+  SBenchSource src = {.pCase = pCase, .numOfRows = numOfRows, .seed = 20240601};
+  src.pBlock = createBenchBlock(pCase, BENCH_BLOCK_ROWS);
+
+  SSortHandle* pHandle =
+      tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, DEFAULT_PAGESIZE, 1024, NULL, "sortBench", 0, 0, 0);
+  tsortSetFetchRawDataFp(pHandle, fetchBenchBlock, NULL, NULL);
+  if (!normKey) {
+    tsortSetComparFp(pHandle, benchMergeComparFn);
+  }
+
+  // the source is released by tsort, and the param is owned here
+  SSortSource* pSource = taosMemoryCalloc(1, sizeof(SSortSource));
+  pSource->param = &src;
+  pSource->onlyRef = true;
+  tsortAddSource(pHandle, pSource);
+
+  int64_t st = taosGetTimestampUs();
+  int64_t rows = 0;
+  int32_t code = tsortOpen(pHandle);
+
+  // keep the keys of the last tuple to check the order
+  char prev[BENCH_MAX_KEYS][8] = {0};
+  bool prevNull[BENCH_MAX_KEYS] = {0};
+  bool sorted = true;
+  while (code == TSDB_CODE_SUCCESS) {
+    STupleHandle* pTuple = tsortNextTuple(pHandle);
+    if (pTuple == NULL) {
+      break;
+    }
+
+    for (int32_t i = 0; i < pCase->numOfKeys && rows > 0; ++i) {
+      bool    isNull = tsortIsNullVal(pTuple, i);
+      int32_t ret = compareBenchValue(taosArrayGet(pOrderInfo, i), pCase->types[i], prevNull[i], prev[i], isNull,
+                                      isNull ? prev[i] : tsortGetValue(pTuple, i));
+      if (ret > 0) sorted = false;
+      if (ret != 0) break;
+    }
+
+    for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+      prevNull[i] = tsortIsNullVal(pTuple, i);
+      if (!prevNull[i]) memcpy(prev[i], tsortGetValue(pTuple, i), tDataTypes[pCase->types[i]].bytes);
+    }
+    rows += 1;
+  }
+  int64_t used = taosGetTimestampUs() - st;
+
+  if (code != TSDB_CODE_SUCCESS || !sorted || rows != numOfRows) {
+    printf("%s: the rows are not sorted, code:%d rows:%" PRId64 "\n", pCase->name, code, rows);
+    used = -1;
+  }
+
+  tsortDestroySortHandle(pHandle);
+  blockDataDestroy(src.pBlock);
+  return used;
+}
+
+// the first limit rows of numOfRows rows, by the external sort or by the bounded queue, returns the time used in us
+static int64_t benchTopN(const SBenchCase* pCase, SArray* pOrderInfo, int64_t numOfRows, int32_t limit, bool heap,
+                         SBenchKey* pKeys) {
+  SBenchSource src = {.pCase = pCase, .numOfRows = numOfRows, .seed = 20240601};
+  src.pBlock = createBenchBlock(pCase, BENCH_BLOCK_ROWS);
+
+  uint32_t     tupleLen = blockDataGetRowSize(src.pBlock) + sizeof(int32_t) * taosArrayGetSize(src.pBlock->pDataBlock);
+  SSortHandle* pHandle = tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, DEFAULT_PAGESIZE, 1024, NULL,
+                                               "sortBench", heap ? limit : 0, tupleLen, 512 * 1024 * 1024);
+  tsortSetFetchRawDataFp(pHandle, fetchBenchBlock, NULL, NULL);
+
+  SSortSource* pSource = taosMemoryCalloc(1, sizeof(SSortSource));
+  pSource->param = &src;
+  pSource->onlyRef = true;
+  tsortAddSource(pHandle, pSource);
+
+  int64_t st = taosGetTimestampUs();
+  int32_t rows = 0;
+  int32_t code = tsortOpen(pHandle);
+  while (code == TSDB_CODE_SUCCESS && rows < limit) {
+    STupleHandle* pTuple = tsortNextTuple(pHandle);
+    if (pTuple == NULL) {
+      break;
+    }
+
+    for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+      pKeys[rows].isNull[i] = tsortIsNullVal(pTuple, i);
+      if (!pKeys[rows].isNull[i]) memcpy(pKeys[rows].v[i], tsortGetValue(pTuple, i), tDataTypes[pCase->types[i]].bytes);
+    }
+    rows += 1;
+  }
+  int64_t used = taosGetTimestampUs() - st;
+
+  if (code != TSDB_CODE_SUCCESS || rows != TMIN(limit, numOfRows)) {
+    printf("%s: failed to get the first rows, code:%d rows:%d\n", pCase->name, code, rows);
+    used = -1;
+  }
+
+  tsortDestroySortHandle(pHandle);
+  blockDataDestroy(src.pBlock);
+  return used;
+}
+
+static bool checkTopNKeys(const SBenchCase* pCase, SArray* pOrderInfo, SBenchKey* pLeft, SBenchKey* pRight,
+                          int32_t rows) {
+  for (int32_t r = 0; r < rows; ++r) {
+    for (int32_t i = 0; i < pCase->numOfKeys; ++i) {
+      if (compareBenchValue(taosArrayGet(pOrderInfo, i), pCase->types[i], pLeft[r].isNull[i], pLeft[r].v[i],
+                            pRight[r].isNull[i], pRight[r].v[i]) != 0) {
+        printf("%s: the keys of row %d are different\n", pCase->name, r);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  int32_t numOfRunRows = 1000000;
+  int64_t numOfMergeRows = 10000000;
+  int32_t limit = 100;
+  int32_t loops = 3;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfRunRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-m") == 0 && i < argc - 1) {
+      numOfMergeRows = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      loops = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-k") == 0 && i < argc - 1) {
+      limit = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n]: number of rows of the in-memory block sort, default: %d\n", numOfRunRows);
+      printf("  [-m]: number of rows of the external sort, 0 to skip it, default: %" PRId64 "\n", numOfMergeRows);
+      printf("  [-k]: number of rows kept by the top-N phase on the merge rows, default: %d\n", limit);
+      printf("  [-l]: number of loops for each case, the best one is reported, default: %d\n", loops);
+      exit(0);
+    }
+  }
+
+  if (numOfRunRows <= 0 || numOfMergeRows < 0 || limit <= 0 || loops <= 0) {
+    printf("invalid options, rows:%d merge rows:%" PRId64 " limit:%d loops:%d\n", numOfRunRows, numOfMergeRows, limit,
+           loops);
+    return -1;
+  }
+
+  SBenchKey* pKeys[2] = {taosMemoryCalloc(limit, sizeof(SBenchKey)), taosMemoryCalloc(limit, sizeof(SBenchKey))};
+  if (pKeys[0] == NULL || pKeys[1] == NULL) {
+    printf("out of memory, limit:%d\n", limit);
+    return -1;
+  }
+
+  osDefaultInit();
+  osUpdate();
+
+  // csv output
+  printf("case,phase,mode,rows,ms,rows_per_sec\n");
+  for (int32_t c = 0; c < tListLen(benchCase); ++c) {
+    const SBenchCase* pCase = &benchCase[c];
+    SArray*           pOrderInfo = createBenchOrderInfo(pCase);
+
+    uint32_t     seed = 20240601;
+    SSDataBlock* pOrigin = createBenchBlock(pCase, numOfRunRows);
+    fillBenchBlock(pCase, pOrigin, numOfRunRows, &seed);
+
+    for (int32_t mode = 0; mode < 2; ++mode) {
+      int64_t best = INT64_MAX;
+      for (int32_t l = 0; l < loops; ++l) {
+        int64_t used = benchRunSort(pCase, pOrderInfo, pOrigin, mode != 0);
+        if (used < 0) return -1;
+        best = TMIN(best, used);
+      }
+
+      best = TMAX(best, 1);
+      printf("%s,run,%s,%d,%.2f,%.0f\n", pCase->name, mode ? "radix" : "compar", numOfRunRows, best / 1000.0,
+             numOfRunRows * 1000000.0 / best);
+    }
+    blockDataDestroy(pOrigin);
+
+    for (int32_t mode = 0; mode < 2 && numOfMergeRows > 0; ++mode) {
+      int64_t best = INT64_MAX;
+      for (int32_t l = 0; l < loops; ++l) {
+        int64_t used = benchMergeSort(pCase, pOrderInfo, numOfMergeRows, mode != 0);
+        if (used < 0) return -1;
+        best = TMIN(best, used);
+      }
+
+      best = TMAX(best, 1);
+      printf("%s,merge,%s,%" PRId64 ",%.2f,%.0f\n", pCase->name, mode ? "normkey" : "compar", numOfMergeRows,
+             best / 1000.0, numOfMergeRows * 1000000.0 / best);
+    }
+
+    for (int32_t mode = 0; mode < 2 && numOfMergeRows > 0; ++mode) {
+      int64_t best = INT64_MAX;
+      for (int32_t l = 0; l < loops; ++l) {
+        int64_t used = benchTopN(pCase, pOrderInfo, numOfMergeRows, limit, mode != 0, pKeys[mode]);
+        if (used < 0) return -1;
+        best = TMIN(best, used);
+      }
+
+      if (mode != 0 && !checkTopNKeys(pCase, pOrderInfo, pKeys[0], pKeys[1], (int32_t)TMIN(limit, numOfMergeRows))) {
+        return -1;
+      }
+
+      best = TMAX(best, 1);
+      printf("%s,topn,%s,%" PRId64 ",%.2f,%.0f\n", pCase->name, mode ? "heap" : "merge", numOfMergeRows,
+             best / 1000.0, numOfMergeRows * 1000000.0 / best);
+    }
+
+    taosArrayDestroy(pOrderInfo);
+  }
+
+  taosMemoryFree(pKeys[0]);
+  taosMemoryFree(pKeys[1]);
+  return 0;
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "tcompare.h"
+#include "tdatablock.h"
+#include "tsort.h"
+
+namespace {
+
+const int32_t sortKeyMaxCols = 6;
+
+struct SSortKeyCol {
+  int16_t type;
+  int32_t order;
+  bool    nullFirst;
+};
+
+// the keys of a row, and the id of the row to check that the rows of the sorted block are the origin ones
+struct SSortKeyRow {
+  bool    isNull[sortKeyMaxCols];
+  char    v[sortKeyMaxCols][8];
+  int32_t id;
+};
+
+SArray *sortKeyOrderInfo(const std::vector<SSortKeyCol> &cols) {
+  SArray *pOrderInfo = taosArrayInit(cols.size(), sizeof(SBlockOrderInfo));
+  for (size_t i = 0; i < cols.size(); ++i) {
+    SBlockOrderInfo oi = {0};
+    oi.order = cols[i].order;
+    oi.slotId = i;
+    oi.nullFirst = cols[i].nullFirst;
+    taosArrayPush(pOrderInfo, &oi);
+  }
+  return pOrderInfo;
+}
+
+// the key columns, and the id column at last
+SSDataBlock *sortKeyCreateBlock(const std::vector<SSortKeyCol> &cols, int32_t rows) {
+  SSDataBlock *pBlock = createDataBlock();
+  for (size_t i = 0; i <= cols.size(); ++i) {
+    int16_t         type = (i < cols.size()) ? cols[i].type : TSDB_DATA_TYPE_INT;
+    SColumnInfoData colInfo = createColumnInfoData(type, tDataTypes[type].bytes, i + 1);
+    blockDataAppendColInfo(pBlock, &colInfo);
+  }
+  blockDataEnsureCapacity(pBlock, rows);
+  return pBlock;
+}
+
+void sortKeyFillBlock(SSDataBlock *pBlock, const std::vector<SSortKeyRow> &rows, int32_t start, int32_t num,
+                      int32_t numOfCols) {
+  blockDataCleanup(pBlock);
+  for (int32_t r = 0; r < num; ++r) {
+    const SSortKeyRow &row = rows[start + r];
+    for (int32_t i = 0; i < numOfCols; ++i) {
+      colDataSetVal((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, i), r, row.v[i], row.isNull[i]);
+    }
+    colDataSetVal((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, numOfCols), r, (const char *)&row.id, false);
+  }
+  pBlock->info.rows = num;
+}
+
+std::vector<SSortKeyRow> sortKeyGetRows(SSDataBlock *pBlock, int32_t numOfCols) {
+  std::vector<SSortKeyRow> rows(pBlock->info.rows);
+  for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+    for (int32_t i = 0; i < numOfCols; ++i) {
+      SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, i);
+      rows[r].isNull[i] = colDataIsNull_s(pCol, r);
+      if (!rows[r].isNull[i]) memcpy(rows[r].v[i], colDataGetNumData(pCol, r), tDataTypes[pCol->info.type].bytes);
+    }
+    rows[r].id = *(int32_t *)colDataGetNumData((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, numOfCols), r);
+  }
+  return rows;
+}
+
+// the order of the rows by the comparators of the column types, the same as blockDataSort
+int32_t sortKeyCompare(const std::vector<SSortKeyCol> &cols, const SSortKeyRow &left, const SSortKeyRow &right) {
+  for (size_t i = 0; i < cols.size(); ++i) {
+    if (left.isNull[i] && right.isNull[i]) continue;
+    if (left.isNull[i]) return cols[i].nullFirst ? -1 : 1;
+    if (right.isNull[i]) return cols[i].nullFirst ? 1 : -1;
+
+    int32_t ret = getKeyComparFunc(cols[i].type, cols[i].order)(left.v[i], right.v[i]);
+    if (ret != 0) return ret;
+  }
+  return 0;
+}
+
+// the values are in a small range to have many duplicates, half of them negative
+std::vector<SSortKeyRow> sortKeyGenRows(const std::vector<SSortKeyCol> &cols, int32_t num, int32_t nullPercent,
+                                        uint32_t seed) {
+  std::mt19937             gen(seed);
+  std::vector<SSortKeyRow> rows(num);
+  for (int32_t r = 0; r < num; ++r) {
+    SSortKeyRow &row = rows[r];
+    memset(&row, 0, sizeof(row));
+    row.id = r;
+    for (size_t i = 0; i < cols.size(); ++i) {
+      row.isNull[i] = (int32_t)(gen() % 100) < nullPercent;
+
+      int64_t iv = (int64_t)(gen() % 64) - 32;
+      switch (cols[i].type) {
+        case TSDB_DATA_TYPE_BOOL:
+          *(int8_t *)row.v[i] = iv > 0;
+          break;
+        case TSDB_DATA_TYPE_TINYINT:
+        case TSDB_DATA_TYPE_UTINYINT:
+          *(int8_t *)row.v[i] = (int8_t)(iv * 4);
+          break;
+        case TSDB_DATA_TYPE_SMALLINT:
+        case TSDB_DATA_TYPE_USMALLINT:
+          *(int16_t *)row.v[i] = (int16_t)(iv * 1000);
+          break;
+        case TSDB_DATA_TYPE_INT:
+        case TSDB_DATA_TYPE_UINT:
+          *(int32_t *)row.v[i] = (int32_t)(iv * 60000000);
+          break;
+        case TSDB_DATA_TYPE_FLOAT:
+          // NaN, the infinities, and the values close enough to be equal by FLT_EQUAL
+          *(float *)row.v[i] = (iv == -32)   ? NAN
+                               : (iv == -31) ? -INFINITY
+                               : (iv == 31)  ? INFINITY
+                                             : (float)(iv / 8) + ((iv % 2) ? FLT_EPSILON : 0);
+          break;
+        case TSDB_DATA_TYPE_DOUBLE:
+          *(double *)row.v[i] = (iv == -32)   ? NAN
+                                : (iv == -31) ? -INFINITY
+                                : (iv == 31)  ? INFINITY
+                                              : (double)(iv / 8) + ((iv % 2) ? FLT_EPSILON : 0);
+          break;
+        default:
+          *(int64_t *)row.v[i] = iv * 1000000000000LL + (int64_t)(gen() % 3);
+          break;
+      }
+    }
+  }
+  return rows;
+}
+
+void sortKeyCheckSorted(const std::vector<SSortKeyCol> &cols, const std::vector<SSortKeyRow> &sorted, int32_t num) {
+  ASSERT_EQ(sorted.size(), (size_t)num);
+  for (size_t r = 1; r < sorted.size(); ++r) {
+    ASSERT_LE(sortKeyCompare(cols, sorted[r - 1], sorted[r]), 0) << "row " << r << " is less than the previous one";
+  }
+
+  std::vector<int32_t> ids;
+  for (const SSortKeyRow &row : sorted) ids.push_back(row.id);
+  std::sort(ids.begin(), ids.end());
+  for (int32_t r = 0; r < num; ++r) {
+    ASSERT_EQ(ids[r], r);
+  }
+}
+
+// one block, large enough to be sorted by the radix sort on the normalized keys
+void sortKeyCheckBlock(const std::vector<SSortKeyCol> &cols, int32_t nullPercent) {
+  const int32_t            num = 5000;
+  std::vector<SSortKeyRow> rows = sortKeyGenRows(cols, num, nullPercent, 20241017);
+  SArray                  *pOrderInfo = sortKeyOrderInfo(cols);
+  SSDataBlock             *pBlock = sortKeyCreateBlock(cols, num);
+  sortKeyFillBlock(pBlock, rows, 0, num, cols.size());
+
+  ASSERT_EQ(tsortSortBlock(pOrderInfo, pBlock), TSDB_CODE_SUCCESS);
+  sortKeyCheckSorted(cols, sortKeyGetRows(pBlock, cols.size()), num);
+
+  blockDataDestroy(pBlock);
+  taosArrayDestroy(pOrderInfo);
+}
+
+struct SSortKeySource {
+  const std::vector<SSortKeyRow> *pRows;
+  int32_t                         numOfCols;
+  int32_t                         next;
+  SSDataBlock                    *pBlock;
+};
+
+SSDataBlock *sortKeyFetch(void *param) {
+  SSortKeySource *pSource = (SSortKeySource *)param;
+  int32_t         num = std::min<int32_t>(pSource->pRows->size() - pSource->next, 1000);
+  if (num <= 0) {
+    return NULL;
+  }
+
+  sortKeyFillBlock(pSource->pBlock, *pSource->pRows, pSource->next, num, pSource->numOfCols);
+  pSource->next += num;
+  return pSource->pBlock;
+}
+
+// the rows sorted by a single source sort handle, which is the external sort, or the bounded queue of the first
+// maxRows rows if maxRows is not 0
+std::vector<SSortKeyRow> sortKeySortBySource(const std::vector<SSortKeyCol> &cols,
+                                             const std::vector<SSortKeyRow> &rows, uint64_t maxRows) {
+  SArray        *pOrderInfo = sortKeyOrderInfo(cols);
+  SSortKeySource src = {&rows, (int32_t)cols.size(), 0, sortKeyCreateBlock(cols, 1000)};
+
+  uint32_t     tupleLen = (cols.size() + 1) * sizeof(int64_t);
+  SSortHandle *pHandle = tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, DEFAULT_PAGESIZE, 4, NULL,
+                                               "sortKeyTests", maxRows, tupleLen, 0);
+  EXPECT_NE(pHandle, nullptr);
+  tsortSetFetchRawDataFp(pHandle, sortKeyFetch, NULL, NULL);
+  if (maxRows > 0) {
+    tsortSetForceUsePQSort(pHandle);
+  }
+
+  // the source is released by tsort, and the param is owned here
+  SSortSource *pSource = (SSortSource *)taosMemoryCalloc(1, sizeof(SSortSource));
+  pSource->param = &src;
+  pSource->onlyRef = true;
+  tsortAddSource(pHandle, pSource);
+  EXPECT_EQ(tsortOpen(pHandle), TSDB_CODE_SUCCESS);
+
+  std::vector<SSortKeyRow> sorted;
+  for (STupleHandle *pTuple = tsortNextTuple(pHandle); pTuple != NULL; pTuple = tsortNextTuple(pHandle)) {
+    SSortKeyRow row;
+    memset(&row, 0, sizeof(row));
+    for (size_t i = 0; i < cols.size(); ++i) {
+      row.isNull[i] = tsortIsNullVal(pTuple, i);
+      if (!row.isNull[i]) memcpy(row.v[i], tsortGetValue(pTuple, i), tDataTypes[cols[i].type].bytes);
+    }
+    row.id = *(int32_t *)tsortGetValue(pTuple, cols.size());
+    sorted.push_back(row);
+  }
+
+  tsortDestroySortHandle(pHandle);
+  blockDataDestroy(src.pBlock);
+  taosArrayDestroy(pOrderInfo);
+  return sorted;
+}
+
+// the external sort, the runs are sorted in memory and then merged with the keys cached in the sources
+void sortKeyCheckMerge(const std::vector<SSortKeyCol> &cols, int32_t nullPercent) {
+  const int32_t            num = 30000;
+  std::vector<SSortKeyRow> rows = sortKeyGenRows(cols, num, nullPercent, 1017);
+  sortKeyCheckSorted(cols, sortKeySortBySource(cols, rows, 0), num);
+}
+
+// the bounded queue keeps the first rows of a full sort, the rows that can't get into it are dropped by the typed
+// filter of the first key once it is full. The rows of the same keys are in any order, so are the ones tied with
+// the last row kept, the keys of each row are the same as the full sort and the rows are the origin ones.
+void sortKeyCheckPQSort(const std::vector<SSortKeyCol> &cols, int32_t nullPercent) {
+  const int32_t            num = 30000;
+  std::vector<SSortKeyRow> rows = sortKeyGenRows(cols, num, nullPercent, 2024);
+  std::vector<SSortKeyRow> full = rows;
+  std::stable_sort(full.begin(), full.end(), [&cols](const SSortKeyRow &left, const SSortKeyRow &right) {
+    return sortKeyCompare(cols, left, right) < 0;
+  });
+
+  // a limit tied with the row after it on all the keys
+  int32_t tied = 0;
+  for (int32_t r = num / 3; r < num && tied == 0; ++r) {
+    if (sortKeyCompare(cols, full[r - 1], full[r]) == 0) tied = r;
+  }
+  ASSERT_GT(tied, 0);
+
+  for (int32_t limit : {1, 7, 1000, 1500, tied, num - 1, num, num + 10}) {
+    std::vector<SSortKeyRow> sorted = sortKeySortBySource(cols, rows, limit);
+    ASSERT_EQ(sorted.size(), (size_t)std::min(limit, num)) << "limit " << limit;
+
+    std::vector<bool> seen(num, false);
+    for (size_t r = 0; r < sorted.size(); ++r) {
+      ASSERT_EQ(sortKeyCompare(cols, sorted[r], full[r]), 0) << "limit " << limit << ", row " << r;
+      ASSERT_EQ(sortKeyCompare(cols, sorted[r], rows[sorted[r].id]), 0) << "limit " << limit << ", row " << r;
+      ASSERT_FALSE(seen[sorted[r].id]) << "limit " << limit << ", row " << r;
+      seen[sorted[r].id] = true;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(sortKeyTest, nullsFirst) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_ASC, true}};
+  sortKeyCheckBlock(cols, 10);
+  sortKeyCheckMerge(cols, 10);
+}
+
+TEST(sortKeyTest, nullsLast) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_ASC, false}};
+  sortKeyCheckBlock(cols, 10);
+  sortKeyCheckMerge(cols, 10);
+}
+
+TEST(sortKeyTest, desc) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_TIMESTAMP, TSDB_ORDER_DESC, false},
+                                   {TSDB_DATA_TYPE_INT, TSDB_ORDER_DESC, true}};
+  sortKeyCheckBlock(cols, 5);
+  sortKeyCheckMerge(cols, 5);
+}
+
+TEST(sortKeyTest, negativeAndUnsigned) {
+  // the unsigned values are generated from negative ones, so that the high bit is set
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_TINYINT, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_UINT, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_SMALLINT, TSDB_ORDER_DESC, false},
+                                   {TSDB_DATA_TYPE_UBIGINT, TSDB_ORDER_DESC, true}};
+  sortKeyCheckBlock(cols, 0);
+  sortKeyCheckMerge(cols, 0);
+}
+
+TEST(sortKeyTest, mixedWidths) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_BOOL, TSDB_ORDER_DESC, true},
+                                   {TSDB_DATA_TYPE_UTINYINT, TSDB_ORDER_ASC, false},
+                                   {TSDB_DATA_TYPE_USMALLINT, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_INT, TSDB_ORDER_ASC, false},
+                                   {TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_DESC, true},
+                                   {TSDB_DATA_TYPE_TIMESTAMP, TSDB_ORDER_ASC, false}};
+  sortKeyCheckBlock(cols, 20);
+  sortKeyCheckMerge(cols, 20);
+}
+
+// the floats are not normalized, NaN is the smallest and the values equal by FLT_EQUAL go by the next column
+TEST(sortKeyTest, floatNaN) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_DOUBLE, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_INT, TSDB_ORDER_DESC, false}};
+  sortKeyCheckBlock(cols, 5);
+  sortKeyCheckMerge(cols, 5);
+
+  cols = {{TSDB_DATA_TYPE_FLOAT, TSDB_ORDER_DESC, false}, {TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_ASC, true}};
+  sortKeyCheckBlock(cols, 5);
+  sortKeyCheckMerge(cols, 5);
+}
+
+TEST(sortKeyTest, pqSortNullsFirst) {
+  // the rows kept are all null when the limit is less than the nulls
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_INT, TSDB_ORDER_DESC, false}};
+  sortKeyCheckPQSort(cols, 10);
+  sortKeyCheckPQSort(cols, 0);
+}
+
+TEST(sortKeyTest, pqSortNullsLast) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_INT, TSDB_ORDER_ASC, false},
+                                   {TSDB_DATA_TYPE_SMALLINT, TSDB_ORDER_ASC, true}};
+  sortKeyCheckPQSort(cols, 10);
+  sortKeyCheckPQSort(cols, 0);
+}
+
+TEST(sortKeyTest, pqSortDesc) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_TIMESTAMP, TSDB_ORDER_DESC, false},
+                                   {TSDB_DATA_TYPE_UTINYINT, TSDB_ORDER_DESC, true}};
+  sortKeyCheckPQSort(cols, 5);
+  sortKeyCheckPQSort(cols, 0);
+
+  cols = {{TSDB_DATA_TYPE_UBIGINT, TSDB_ORDER_DESC, true}, {TSDB_DATA_TYPE_TINYINT, TSDB_ORDER_ASC, false}};
+  sortKeyCheckPQSort(cols, 0);
+}
+
+TEST(sortKeyTest, pqSortFloatNaNAndInf) {
+  std::vector<SSortKeyCol> cols = {{TSDB_DATA_TYPE_DOUBLE, TSDB_ORDER_ASC, true},
+                                   {TSDB_DATA_TYPE_INT, TSDB_ORDER_DESC, false}};
+  sortKeyCheckPQSort(cols, 5);
+  sortKeyCheckPQSort(cols, 0);
+
+  cols = {{TSDB_DATA_TYPE_FLOAT, TSDB_ORDER_DESC, false}, {TSDB_DATA_TYPE_BIGINT, TSDB_ORDER_ASC, true}};
+  sortKeyCheckPQSort(cols, 5);
+  sortKeyCheckPQSort(cols, 0);
+
+  cols = {{TSDB_DATA_TYPE_DOUBLE, TSDB_ORDER_DESC, true}, {TSDB_DATA_TYPE_FLOAT, TSDB_ORDER_ASC, false}};
+  sortKeyCheckPQSort(cols, 0);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
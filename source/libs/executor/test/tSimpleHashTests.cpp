@@ -137,4 +137,117 @@ TEST(testCase, tSimpleHashTest_binaryKey) {
   tSimpleHashCleanup(pHashObj);
 }
 
+TEST(testCase, tSimpleHashTest_openAddrIntKey) {
+  SSHashObj *pHashObj = tSimpleHashInitEx(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), SHASH_TYPE_OPEN_ADDR);
+
+  assert(pHashObj != nullptr);
+
+  ASSERT_EQ(0, tSimpleHashGetSize(pHashObj));
+
+  size_t keyLen = sizeof(int64_t);
+  size_t dataLen = sizeof(int64_t);
+
+  // large enough to go through several incremental resizes
+  const int64_t num = 100000;
+  int64_t       originKeySum = 0;
+  for (int64_t i = 1; i <= num; ++i) {
+    originKeySum += i;
+    tSimpleHashPut(pHashObj, (const void *)&i, keyLen, (const void *)&i, dataLen);
+    ASSERT_EQ(i, tSimpleHashGetSize(pHashObj));
+  }
+
+  for (int64_t i = 1; i <= num; ++i) {
+    void *data = tSimpleHashGet(pHashObj, (const void *)&i, keyLen);
+    ASSERT_EQ(i, *(int64_t *)data);
+  }
+
+  int64_t missKey = num + 1;
+  ASSERT_EQ(nullptr, tSimpleHashGet(pHashObj, (const void *)&missKey, keyLen));
+
+  void   *data = NULL;
+  int32_t iter = 0;
+  int64_t keySum = 0;
+  int64_t dataSum = 0;
+  size_t  kLen = 0;
+  while ((data = tSimpleHashIterate(pHashObj, data, &iter))) {
+    void *key = tSimpleHashGetKey(data, &kLen);
+    ASSERT_EQ(keyLen, kLen);
+    keySum += *(int64_t *)key;
+    dataSum += *(int64_t *)data;
+  }
+
+  ASSERT_EQ(keySum, dataSum);
+  ASSERT_EQ(keySum, originKeySum);
+
+  // remove the odd keys, and put them back with new data
+  for (int64_t i = 1; i <= num; i += 2) {
+    ASSERT_EQ(TSDB_CODE_SUCCESS, tSimpleHashRemove(pHashObj, (const void *)&i, keyLen));
+  }
+  ASSERT_EQ(num / 2, tSimpleHashGetSize(pHashObj));
+
+  for (int64_t i = 1; i <= num; i += 2) {
+    ASSERT_EQ(nullptr, tSimpleHashGet(pHashObj, (const void *)&i, keyLen));
+    int64_t v = -i;
+    tSimpleHashPut(pHashObj, (const void *)&i, keyLen, (const void *)&v, dataLen);
+  }
+  ASSERT_EQ(num, tSimpleHashGetSize(pHashObj));
+
+  for (int64_t i = 1; i <= num; ++i) {
+    void *d = tSimpleHashGet(pHashObj, (const void *)&i, keyLen);
+    ASSERT_EQ((i % 2 == 1) ? -i : i, *(int64_t *)d);
+  }
+
+  // remove all items during iterating
+  data = NULL;
+  iter = 0;
+  int64_t removed = 0;
+  while ((data = tSimpleHashIterate(pHashObj, data, &iter))) {
+    void *key = tSimpleHashGetKey(data, &kLen);
+    tSimpleHashIterateRemove(pHashObj, key, kLen, &data, &iter);
+    removed += 1;
+  }
+
+  ASSERT_EQ(num, removed);
+  ASSERT_EQ(0, tSimpleHashGetSize(pHashObj));
+
+  tSimpleHashCleanup(pHashObj);
+}
+
+TEST(testCase, tSimpleHashTest_openAddrBinaryKey) {
+  SSHashObj *pHashObj = tSimpleHashInitEx(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), SHASH_TYPE_OPEN_ADDR);
+
+  assert(pHashObj != nullptr);
+
+  char    key[64] = {0};
+  int64_t num = 10000;
+  for (int64_t i = 0; i < num; ++i) {
+    int32_t len = snprintf(key, sizeof(key), "d%" PRId64, i * 13);
+    tSimpleHashPut(pHashObj, key, len, (const void *)&i, sizeof(int64_t));
+  }
+  ASSERT_EQ(num, tSimpleHashGetSize(pHashObj));
+
+  for (int64_t i = 0; i < num; ++i) {
+    int32_t len = snprintf(key, sizeof(key), "d%" PRId64, i * 13);
+    void   *data = tSimpleHashGet(pHashObj, key, len);
+    ASSERT_EQ(i, *(int64_t *)data);
+
+    size_t kLen = 0;
+    char  *pKey = (char *)tSimpleHashGetKey(data, &kLen);
+    ASSERT_EQ(len, kLen);
+    ASSERT_EQ(0, memcmp(pKey, key, len));
+
+    // the same prefix with different length is a different key
+    key[len] = 'x';
+    ASSERT_EQ(nullptr, tSimpleHashGet(pHashObj, key, len + 1));
+  }
+
+  tSimpleHashClear(pHashObj);
+  ASSERT_EQ(0, tSimpleHashGetSize(pHashObj));
+
+  int32_t len = snprintf(key, sizeof(key), "d%d", 13);
+  ASSERT_EQ(nullptr, tSimpleHashGet(pHashObj, key, len));
+
+  tSimpleHashCleanup(pHashObj);
+}
+
 #pragma GCC diagnostic pop
\ No newline at end of file
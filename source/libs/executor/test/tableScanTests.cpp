@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+// the table scan reads from a fake tsdb reader: every table has tsCtx.rowsPerTable rows of (ts, uid), which are
+// returned in blocks of at most tsCtx.blockRows rows.
+#define TS_SCAN_BLK_ID    0
+#define TS_BASE_UID       10000
+#define TS_SCAN_SKEY      1000
+#define TS_SCAN_EKEY      INT64_MAX
+
+typedef struct {
+  SQueryTableDataCond* pCond;
+  STableKeyInfo*       pTableList;
+  int32_t              numOfTables;
+  int32_t              curTable;
+  int32_t              curRow;
+  SSDataBlock*         pResBlock;
+} SFakeReader;
+
+struct STableScanTestCtx {
+  int32_t                        rowsPerTable;
+  int32_t                        blockRows;
+  TdThreadMutex                  lock;
+  std::set<SQueryTableDataCond*> openConds;  // the conds of the readers that are open
+  int32_t                        numOfReaders;
+  int32_t                        maxOpenReaders;  // the most readers that were open at the same time
+  int32_t                        sharedConds;  // readers that were opened on a cond in use by another reader
+  int32_t                        dirtyConds;   // readers that were opened on a cond updated by another reader
+} tsCtx;
+
+int32_t fakeReaderOpen(void* pVnode, SQueryTableDataCond* pCond, void* pTableList, int32_t numOfTables,
+                       SSDataBlock* pResBlock, void** ppReader, const char* idstr, SHashObj** pIgnoreTables) {
+  taosThreadMutexLock(&tsCtx.lock);
+  tsCtx.numOfReaders += 1;
+  if (tsCtx.openConds.count(pCond) > 0) {
+    tsCtx.sharedConds += 1;
+  }
+  if (pCond->twindows.skey != TS_SCAN_SKEY || pCond->twindows.ekey != TS_SCAN_EKEY ||
+      pCond->order != TSDB_ORDER_ASC) {
+    tsCtx.dirtyConds += 1;
+  }
+  tsCtx.openConds.insert(pCond);
+  tsCtx.maxOpenReaders = TMAX(tsCtx.maxOpenReaders, (int32_t)tsCtx.openConds.size());
+  taosThreadMutexUnlock(&tsCtx.lock);
+
+  // update the cond like tsdbReaderOpen2 does for TIMEWINDOW_RANGE_EXTERNAL
+  pCond->twindows.skey = INT64_MIN;
+  pCond->twindows.ekey = TS_SCAN_SKEY - 1;
+  pCond->order = TSDB_ORDER_DESC;
+  taosMsleep(1);
+  pCond->twindows.skey = TS_SCAN_EKEY;
+  pCond->order = TSDB_ORDER_ASC;
+
+  SFakeReader* pReader = (SFakeReader*)taosMemoryCalloc(1, sizeof(SFakeReader));
+  pReader->pCond = pCond;
+  pReader->pTableList = (STableKeyInfo*)pTableList;
+  pReader->numOfTables = numOfTables;
+  pReader->pResBlock = pResBlock;
+  *ppReader = pReader;
+  return TSDB_CODE_SUCCESS;
+}
+
+void fakeReaderClose(SFakeReader* pReader) {
+  if (pReader == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&tsCtx.lock);
+  tsCtx.openConds.erase(pReader->pCond);
+  taosThreadMutexUnlock(&tsCtx.lock);
+  taosMemoryFree(pReader);
+}
+
+int32_t fakeReaderNextBlock(SFakeReader* pReader, bool* hasNext) {
+  if (pReader->curRow >= tsCtx.rowsPerTable) {
+    pReader->curTable += 1;
+    pReader->curRow = 0;
+  }
+
+  *hasNext = pReader->curTable < pReader->numOfTables;
+  if (!*hasNext) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SSDataBlock* pBlock = pReader->pResBlock;
+  int64_t      uid = pReader->pTableList[pReader->curTable].uid;
+  int32_t      rows = TMIN(tsCtx.blockRows, tsCtx.rowsPerTable - pReader->curRow);
+
+  blockDataCleanup(pBlock);
+  blockDataEnsureCapacity(pBlock, rows);
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pUid = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t ts = TS_SCAN_SKEY + pReader->curRow + i;
+    colDataSetVal(pTs, i, (const char*)&ts, false);
+    colDataSetVal(pUid, i, (const char*)&uid, false);
+  }
+
+  pBlock->info.rows = rows;
+  pBlock->info.id.uid = uid;
+  pReader->curRow += rows;
+  return TSDB_CODE_SUCCESS;
+}
+
+SSDataBlock* fakeReaderRetrieveBlock(SFakeReader* pReader, SArray* pIdList) { return pReader->pResBlock; }
+
+void fakeReaderReleaseBlock(SFakeReader* pReader) {}
+
+SNode* createScanColumn(int32_t slotId, col_id_t colId, int8_t type) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = tDataTypes[type].bytes;
+  pCol->dataBlockId = TS_SCAN_BLK_ID;
+  pCol->slotId = slotId;
+  pCol->colId = colId;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = TS_SCAN_BLK_ID;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = (SNode*)pCol;
+  return (SNode*)pTarget;
+}
+
+SNode* createSlotDesc(int32_t slotId, int8_t type) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType.type = type;
+  pSlot->dataType.bytes = tDataTypes[type].bytes;
+  pSlot->output = true;
+  return (SNode*)pSlot;
+}
+
+// select ts, v from the super table, v is the uid of the child table
+STableScanPhysiNode* createTableScanPhysiNode(int8_t parallelism, int64_t limit) {
+  STableScanPhysiNode* pNode = (STableScanPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN);
+  pNode->scanSeq[0] = 1;
+  pNode->scanSeq[1] = 0;
+  pNode->scanRange.skey = TS_SCAN_SKEY;
+  pNode->scanRange.ekey = TS_SCAN_EKEY;
+  pNode->dataRequired = FUNC_DATA_REQUIRED_DATA_LOAD;
+  pNode->scanParallelism = parallelism;
+  pNode->scan.suid = TS_BASE_UID;
+
+  nodesListMakeStrictAppend(&pNode->scan.pScanCols, createScanColumn(0, PRIMARYKEY_TIMESTAMP_COL_ID,
+                                                                     TSDB_DATA_TYPE_TIMESTAMP));
+  nodesListMakeStrictAppend(&pNode->scan.pScanCols, createScanColumn(1, 2, TSDB_DATA_TYPE_BIGINT));
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = TS_SCAN_BLK_ID;
+  nodesListMakeStrictAppend(&pDesc->pSlots, createSlotDesc(0, TSDB_DATA_TYPE_TIMESTAMP));
+  nodesListMakeStrictAppend(&pDesc->pSlots, createSlotDesc(1, TSDB_DATA_TYPE_BIGINT));
+  pNode->scan.node.pOutputDataBlockDesc = pDesc;
+
+  if (limit > 0) {
+    SLimitNode* pLimit = (SLimitNode*)nodesMakeNode(QUERY_NODE_LIMIT);
+    pLimit->limit = limit;
+    pNode->scan.node.pLimit = (SNode*)pLimit;
+  }
+
+  return pNode;
+}
+
+SExecTaskInfo* createDummyTaskInfo() {
+  SExecTaskInfo* pTask = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pTask->id.str = "tableScanTest";
+  pTask->execModel = OPTR_EXEC_MODEL_BATCH;
+
+  TsdReader* pAPI = &pTask->storageAPI.tsdReader;
+  pAPI->tsdReaderOpen = fakeReaderOpen;
+  pAPI->tsdReaderClose = (void (*)())fakeReaderClose;
+  pAPI->tsdNextDataBlock = (int32_t(*)())fakeReaderNextBlock;
+  pAPI->tsdReaderRetrieveDataBlock = (SSDataBlock * (*)()) fakeReaderRetrieveBlock;
+  pAPI->tsdReaderReleaseDataBlock = (void (*)())fakeReaderReleaseBlock;
+  return pTask;
+}
+
+struct STableScanTestOp {
+  SExecTaskInfo*       pTask;
+  STableScanPhysiNode* pNode;
+  SOperatorInfo*       pOperator;
+};
+
+STableScanTestOp createTableScan(int32_t numOfTables, int8_t parallelism, int64_t limit) {
+  STableScanTestOp op = {0};
+  op.pTask = createDummyTaskInfo();
+  STableListInfo* pTableList = tableListCreate();
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    tableListAddTableInfo(pTableList, TS_BASE_UID + 1 + i, 0);
+  }
+
+  SReadHandle handle = {0};
+  op.pNode = createTableScanPhysiNode(parallelism, limit);
+  op.pOperator = createTableScanOperatorInfo(op.pNode, &handle, pTableList, op.pTask);
+  EXPECT_TRUE(op.pOperator != NULL) << tstrerror(op.pTask->code);
+  return op;
+}
+
+// add the rows of the block to the rows of each table, checking that each row belongs to the block's table
+void countBlockRows(SSDataBlock* pBlock, std::map<int64_t, int64_t>& rows) {
+  SColumnInfoData* pUid = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    int64_t uid = *(int64_t*)colDataGetData(pUid, i);
+    EXPECT_EQ(uid, pBlock->info.id.uid);
+    rows[uid] += 1;
+  }
+}
+
+void destroyTableScan(STableScanTestOp& op) {
+  if (op.pOperator != NULL) {
+    destroyOperator(op.pOperator);
+  }
+  nodesDestroyNode((SNode*)op.pNode);
+  taosMemoryFree(op.pTask);
+}
+
+// scan the tables and return the number of rows of each table
+std::map<int64_t, int64_t> runTableScan(int32_t numOfTables, int8_t parallelism, int64_t limit) {
+  std::map<int64_t, int64_t> rows;
+
+  tsCtx.numOfReaders = 0;
+  tsCtx.maxOpenReaders = 0;
+  tsCtx.sharedConds = 0;
+  tsCtx.dirtyConds = 0;
+
+  STableScanTestOp op = createTableScan(numOfTables, parallelism, limit);
+  if (op.pOperator == NULL) {
+    destroyTableScan(op);
+    return rows;
+  }
+
+  while (1) {
+    SSDataBlock* pBlock = op.pOperator->fpSet.getNextFn(op.pOperator);
+    if (pBlock == NULL) {
+      break;
+    }
+    countBlockRows(pBlock, rows);
+  }
+
+  destroyTableScan(op);
+
+  EXPECT_EQ(tsCtx.sharedConds, 0);
+  EXPECT_EQ(tsCtx.dirtyConds, 0);
+  EXPECT_TRUE(tsCtx.openConds.empty());
+  return rows;
+}
+
+}  // namespace
+
+TEST(tableScanTest, paraScanAllRows) {
+  tsCtx.rowsPerTable = 1000;
+  tsCtx.blockRows = 128;
+
+  for (int8_t parallelism : {2, 4, 8}) {
+    std::map<int64_t, int64_t> rows = runTableScan(37, parallelism, 0);
+    ASSERT_EQ(rows.size(), 37);
+    for (auto& it : rows) {
+      EXPECT_GT(it.first, TS_BASE_UID);
+      EXPECT_LE(it.first, TS_BASE_UID + 37);
+      EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+    }
+    EXPECT_GT(tsCtx.numOfReaders, 1);
+  }
+}
+
+TEST(tableScanTest, paraScanMoreReadersThanTables) {
+  tsCtx.rowsPerTable = 10;
+  tsCtx.blockRows = 4;
+
+  std::map<int64_t, int64_t> rows = runTableScan(3, 8, 0);
+  ASSERT_EQ(rows.size(), 3);
+  for (auto& it : rows) {
+    EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+  }
+}
+
+TEST(tableScanTest, paraScanLimit) {
+  tsCtx.rowsPerTable = 1000;
+  tsCtx.blockRows = 100;
+
+  // the workers are still loading blocks when the limit is reached, and are stopped when the operator is destroyed
+  std::map<int64_t, int64_t> rows = runTableScan(64, 4, 250);
+
+  int64_t total = 0;
+  for (auto& it : rows) {
+    total += it.second;
+  }
+  EXPECT_EQ(total, 250);
+}
+
+// the readers of all the scans are bounded by numOfParaScanThreads, and a scan that can not get two of them scans
+// the tables serially
+TEST(tableScanTest, paraScanThreadsLimit) {
+  int32_t numOfParaScanThreads = tsNumOfParaScanThreads;
+  tsCtx.rowsPerTable = 1000;
+  tsCtx.blockRows = 100;
+
+  tsNumOfParaScanThreads = 3;
+  std::map<int64_t, int64_t> rows = runTableScan(37, 8, 0);
+  ASSERT_EQ(rows.size(), 37);
+  for (auto& it : rows) {
+    EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+  }
+  EXPECT_LE(tsCtx.maxOpenReaders, 3);
+  EXPECT_GT(tsCtx.numOfReaders, 1);
+
+  tsNumOfParaScanThreads = 1;
+  rows = runTableScan(37, 8, 0);
+  ASSERT_EQ(rows.size(), 37);
+  EXPECT_EQ(tsCtx.maxOpenReaders, 1);
+
+  // the workers of the first scan wait for the queue to be consumed and keep their readers, so the second scan gets
+  // none and scans serially
+  tsNumOfParaScanThreads = 4;
+  STableScanTestOp first = createTableScan(64, 4, 0);
+  ASSERT_NE(first.pOperator, nullptr);
+
+  std::map<int64_t, int64_t> firstRows;
+  SSDataBlock*               pBlock = first.pOperator->fpSet.getNextFn(first.pOperator);
+  ASSERT_NE(pBlock, nullptr);
+  countBlockRows(pBlock, firstRows);
+
+  tsCtx.maxOpenReaders = 0;
+  STableScanTestOp second = createTableScan(5, 4, 0);
+  ASSERT_NE(second.pOperator, nullptr);
+
+  rows.clear();
+  while ((pBlock = second.pOperator->fpSet.getNextFn(second.pOperator)) != NULL) {
+    countBlockRows(pBlock, rows);
+  }
+  destroyTableScan(second);
+  ASSERT_EQ(rows.size(), 5);
+  for (auto& it : rows) {
+    EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+  }
+  EXPECT_LE(tsCtx.maxOpenReaders, 4 + 1);
+
+  while ((pBlock = first.pOperator->fpSet.getNextFn(first.pOperator)) != NULL) {
+    countBlockRows(pBlock, firstRows);
+  }
+  destroyTableScan(first);
+  ASSERT_EQ(firstRows.size(), 64);
+  for (auto& it : firstRows) {
+    EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+  }
+  EXPECT_TRUE(tsCtx.openConds.empty());
+
+  tsNumOfParaScanThreads = numOfParaScanThreads;
+}
+
+TEST(tableScanTest, serialScan) {
+  tsCtx.rowsPerTable = 100;
+  tsCtx.blockRows = 64;
+
+  std::map<int64_t, int64_t> rows = runTableScan(5, 1, 0);
+  ASSERT_EQ(rows.size(), 5);
+  for (auto& it : rows) {
+    EXPECT_EQ(it.second, tsCtx.rowsPerTable);
+  }
+}
+
+int main(int argc, char** argv) {
+  taosThreadMutexInit(&tsCtx.lock, NULL);
+  testing::InitGoogleTest(&argc, argv);
+  int32_t code = RUN_ALL_TESTS();
+  taosThreadMutexDestroy(&tsCtx.lock);
+  return code;
+}
+
+#pragma GCC diagnostic pop
@@ -120,6 +120,13 @@ bool    getPercentileFuncEnv(struct SFunctionNode* pFunc, SFuncExecEnv* pEnv);
 bool    percentileFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo);
 int32_t percentileFunction(SqlFunctionCtx* pCtx);
 int32_t percentileFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock);
+bool    getPercentilePointsFuncEnv(struct SFunctionNode* pFunc, SFuncExecEnv* pEnv);
+bool    percentilePointsFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo);
+int32_t percentilePartialFunction(SqlFunctionCtx* pCtx);
+int32_t percentilePartialFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock);
+int32_t percentileFunctionMerge(SqlFunctionCtx* pCtx);
+int32_t percentileMergeFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock);
+int32_t getPercentileMaxSize();
 
 bool    getApercentileFuncEnv(struct SFunctionNode* pFunc, SFuncExecEnv* pEnv);
 bool    apercentileFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo);
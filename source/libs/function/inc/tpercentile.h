@@ -65,6 +65,10 @@ typedef struct tMemBucket {
   SDiskbasedBuf     *pBuffer;
   __perc_hash_func_t hashFunc;
   SHashObj          *groupPagesMap;  // disk page map for different groups;
+  int32_t            sortedSlot;     // the slot whose data are kept sorted in pSortedData
+  SFilePage         *pSortedData;
+  int32_t            childSlot;      // the slot split into the buckets of pChild
+  struct tMemBucket *pChild;
 } tMemBucket;
 
 tMemBucket *tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval, double maxval);
@@ -75,6 +79,19 @@ int32_t tMemBucketPut(tMemBucket *pBucket, const void *data, size_t size);
 
 int32_t getPercentile(tMemBucket *pMemBucket, double percent, double *result);
 
+// a distinct value and its number of occurrences, the values of a vgroup are merged this way
+typedef struct SPercentilePoint {
+  double  val;
+  int64_t count;
+} SPercentilePoint;
+
+// sort the points and combine the ones of the same value, return the number of points left
+int32_t tPercentilePointsCompact(SPercentilePoint *pPoints, int32_t num);
+
+// get the percentile of the compacted points, of which the sum of the counts is total
+int32_t tPercentilePointsGet(const SPercentilePoint *pPoints, int32_t num, int64_t total, double percent,
+                             double *result);
+
 #endif  // TDENGINE_TPERCENTILE_H
 
 #ifdef __cplusplus
@@ -579,14 +579,15 @@ static int32_t translateTimezone(SFunctionNode* pFunc, char* pErrBuf, int32_t le
   return TSDB_CODE_SUCCESS;
 }
 
-static int32_t translatePercentile(SFunctionNode* pFunc, char* pErrBuf, int32_t len) {
+static int32_t translatePercentileImpl(SFunctionNode* pFunc, char* pErrBuf, int32_t len, bool isMerge) {
   int32_t numOfParams = LIST_LENGTH(pFunc->pParameterList);
   if (numOfParams < 2 || numOfParams > 11) {
     return invaildFuncParaNumErrMsg(pErrBuf, len, pFunc->functionName);
   }
 
+  // the first param of the merge function is the partial result
   uint8_t para1Type = getSDataTypeFromNode(nodesListGetNode(pFunc->pParameterList, 0))->type;
-  if (!IS_NUMERIC_TYPE(para1Type)) {
+  if (isMerge ? (TSDB_DATA_TYPE_BINARY != para1Type) : !IS_NUMERIC_TYPE(para1Type)) {
     return invaildFuncParaTypeErrMsg(pErrBuf, len, pFunc->functionName);
   }
 
@@ -623,6 +624,23 @@ static int32_t translatePercentile(SFunctionNode* pFunc, char* pErrBuf, int32_t
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t translatePercentile(SFunctionNode* pFunc, char* pErrBuf, int32_t len) {
+  return translatePercentileImpl(pFunc, pErrBuf, len, false);
+}
+
+static int32_t translatePercentilePartial(SFunctionNode* pFunc, char* pErrBuf, int32_t len) {
+  int32_t code = translatePercentileImpl(pFunc, pErrBuf, len, false);
+  if (TSDB_CODE_SUCCESS == code) {
+    pFunc->node.resType =
+        (SDataType){.bytes = getPercentileMaxSize() + VARSTR_HEADER_SIZE, .type = TSDB_DATA_TYPE_BINARY};
+  }
+  return code;
+}
+
+static int32_t translatePercentileMerge(SFunctionNode* pFunc, char* pErrBuf, int32_t len) {
+  return translatePercentileImpl(pFunc, pErrBuf, len, true);
+}
+
 static bool validateApercentileAlgo(const SValueNode* pVal) {
   if (TSDB_DATA_TYPE_BINARY != pVal->node.resType.type) {
     return false;
@@ -831,6 +849,15 @@ int32_t topBotCreateMergeParam(SNodeList* pRawParameters, SNode* pPartialRes, SN
   return reserveFirstMergeParam(pRawParameters, pPartialRes, pParameters);
 }
 
+// all the percents are kept, the same as the raw params
+int32_t percentileCreateMergeParam(SNodeList* pRawParameters, SNode* pPartialRes, SNodeList** pParameters) {
+  int32_t code = nodesListMakeAppend(pParameters, pPartialRes);
+  for (int32_t i = 1; TSDB_CODE_SUCCESS == code && i < pRawParameters->length; ++i) {
+    code = nodesListStrictAppend(*pParameters, nodesCloneNode(nodesListGetNode(pRawParameters, i)));
+  }
+  return code;
+}
+
 int32_t apercentileCreateMergeParam(SNodeList* pRawParameters, SNode* pPartialRes, SNodeList** pParameters) {
   int32_t code = reserveFirstMergeParam(pRawParameters, pPartialRes, pParameters);
   if (TSDB_CODE_SUCCESS == code && pRawParameters->length >= 3) {
@@ -2722,6 +2749,9 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .invertFunc   = NULL,
 #endif
     .combineFunc  = NULL,
+    .pPartialFunc = "_percentile_partial",
+    .pMergeFunc   = "_percentile_merge",
+    .createMergeParaFuc = percentileCreateMergeParam
   },
   {
     .name = "apercentile",
@@ -4116,6 +4146,26 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .sprocessFunc = md5Function,
     .finalizeFunc = NULL
   },
+  {
+    .name = "_percentile_partial",
+    .type = FUNCTION_TYPE_PERCENTILE_PARTIAL,
+    .classification = FUNC_MGT_AGG_FUNC | FUNC_MGT_FORBID_STREAM_FUNC,
+    .translateFunc = translatePercentilePartial,
+    .getEnvFunc   = getPercentilePointsFuncEnv,
+    .initFunc     = percentilePointsFunctionSetup,
+    .processFunc  = percentilePartialFunction,
+    .finalizeFunc = percentilePartialFinalize,
+  },
+  {
+    .name = "_percentile_merge",
+    .type = FUNCTION_TYPE_PERCENTILE_MERGE,
+    .classification = FUNC_MGT_AGG_FUNC | FUNC_MGT_FORBID_STREAM_FUNC,
+    .translateFunc = translatePercentileMerge,
+    .getEnvFunc   = getPercentilePointsFuncEnv,
+    .initFunc     = percentilePointsFunctionSetup,
+    .processFunc  = percentileFunctionMerge,
+    .finalizeFunc = percentileMergeFinalize,
+  },
 };
 // clang-format on
 
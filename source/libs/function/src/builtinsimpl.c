@@ -31,6 +31,9 @@
 #define TAIL_MAX_POINTS_NUM    100
 #define TAIL_MAX_OFFSET        100
 
+#define PERCENTILE_POINTS_PER_ROW 4000               // the points in a binary column of one row
+#define PERCENTILE_POINTS_MAX_NUM (16 * 1024 * 1024)  // the distinct values kept in memory, 256MB of points
+
 #define HLL_BUCKET_BITS 14  // The bits of the bucket
 #define HLL_DATA_BITS   (64 - HLL_BUCKET_BITS)
 #define HLL_BUCKETS     (1 << HLL_BUCKET_BITS)
@@ -95,6 +98,14 @@ typedef struct SPercentileInfo {
   int64_t     numOfElems;
 } SPercentileInfo;
 
+// the distinct values and their counts, the values of all vgroups are merged to get the exact percentile
+typedef struct SPercentilePointsInfo {
+  double  result;
+  SArray* pPoints;    // SPercentilePoint
+  int64_t total;
+  int32_t threshold;  // the points are combined when there are as many
+} SPercentilePointsInfo;
+
 typedef struct SAPercentileInfo {
   double          result;
   double          percent;
@@ -1971,63 +1982,270 @@ int32_t percentileFunction(SqlFunctionCtx* pCtx) {
   return TSDB_CODE_SUCCESS;
 }
 
+typedef int32_t (*FPercentileGet)(void* param, double percent, double* result);
+
+// output the percentile of each percent param, as a string of all of them when more than one are given
+static int32_t percentileSetResult(SqlFunctionCtx* pCtx, SSDataBlock* pBlock, double* pResult, FPercentileGet fp,
+                                   void* param) {
+  SResultRowEntryInfo* pResInfo = GET_RES_INFO(pCtx);
+
+  int32_t code = 0;
+  double  v = 0;
+
+  if (pCtx->numOfParams > 2) {
+    char   buf[512] = {0};
+    size_t len = 1;
+
+    varDataVal(buf)[0] = '[';
+    for (int32_t i = 1; i < pCtx->numOfParams; ++i) {
+      SVariant* pVal = &pCtx->param[i].param;
+
+      GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
+
+      code = fp(param, v, pResult);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+
+      if (i == pCtx->numOfParams - 1) {
+        len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf]", *pResult);
+      } else {
+        len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf, ", *pResult);
+      }
+    }
+
+    int32_t          slotId = pCtx->pExpr->base.resSchema.slotId;
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, slotId);
+
+    varDataSetLen(buf, len);
+    colDataSetVal(pCol, pBlock->info.rows, buf, false);
+
+    return pResInfo->numOfRes;
+  } else {
+    SVariant* pVal = &pCtx->param[1].param;
+
+    GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
+
+    code = fp(param, v, pResult);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    return functionFinalize(pCtx, pBlock);
+  }
+}
+
+static int32_t percentileGetFromBucket(void* param, double percent, double* result) {
+  return getPercentile((tMemBucket*)param, percent, result);
+}
+
 int32_t percentileFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
   SResultRowEntryInfo* pResInfo = GET_RES_INFO(pCtx);
   SPercentileInfo*     ppInfo = (SPercentileInfo*)GET_ROWCELL_INTERBUF(pResInfo);
 
   int32_t code = 0;
-  double  v = 0;
 
   tMemBucket* pMemBucket = ppInfo->pMemBucket;
   if (pMemBucket != NULL && pMemBucket->total > 0) {  // check for null
-    if (pCtx->numOfParams > 2) {
-      char   buf[512] = {0};
-      size_t len = 1;
+    code = percentileSetResult(pCtx, pBlock, &ppInfo->result, percentileGetFromBucket, pMemBucket);
+  }
 
-      varDataVal(buf)[0] = '[';
-      for (int32_t i = 1; i < pCtx->numOfParams; ++i) {
-        SVariant* pVal = &pCtx->param[i].param;
+  tMemBucketDestroy(pMemBucket);
+  return code;
+}
 
-        GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
+bool getPercentilePointsFuncEnv(SFunctionNode* pFunc, SFuncExecEnv* pEnv) {
+  pEnv->calcMemSize = sizeof(SPercentilePointsInfo);
+  return true;
+}
 
-        code = getPercentile(pMemBucket, v, &ppInfo->result);
-        if (code != TSDB_CODE_SUCCESS) {
-          goto _fin_error;
-        }
+int32_t getPercentileMaxSize() { return PERCENTILE_POINTS_PER_ROW * sizeof(SPercentilePoint); }
 
-        if (i == pCtx->numOfParams - 1) {
-          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf]", ppInfo->result);
-        } else {
-          len += snprintf(varDataVal(buf) + len, sizeof(buf) - VARSTR_HEADER_SIZE - len, "%.6lf, ", ppInfo->result);
-        }
-      }
+bool percentilePointsFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo) {
+  if (!functionSetup(pCtx, pResultInfo)) {
+    return false;
+  }
 
-      int32_t          slotId = pCtx->pExpr->base.resSchema.slotId;
-      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, slotId);
+  SPercentilePointsInfo* pInfo = GET_ROWCELL_INTERBUF(pResultInfo);
+  pInfo->pPoints = taosArrayInit(16, sizeof(SPercentilePoint));
+  pInfo->total = 0;
+  pInfo->threshold = 2 * PERCENTILE_POINTS_PER_ROW;
+  return pInfo->pPoints != NULL;
+}
 
-      varDataSetLen(buf, len);
-      colDataSetVal(pCol, pBlock->info.rows, buf, false);
+// combine the duplicated values, and combine them again once there are twice as many points
+static int32_t percentileCompactPoints(SPercentilePointsInfo* pInfo) {
+  int32_t num = (int32_t)taosArrayGetSize(pInfo->pPoints);
+  int32_t left = tPercentilePointsCompact(TARRAY_DATA(pInfo->pPoints), num);
+  taosArrayPopTailBatch(pInfo->pPoints, num - left);
 
-      tMemBucketDestroy(pMemBucket);
-      return pResInfo->numOfRes;
-    } else {
-      SVariant* pVal = &pCtx->param[1].param;
+  if (left > PERCENTILE_POINTS_MAX_NUM) {
+    return TSDB_CODE_FUNC_PERCENTILE_TOO_MANY_VALUES;
+  }
 
-      GET_TYPED_DATA(v, double, pVal->nType, &pVal->i);
+  pInfo->threshold = TMIN(TMAX(2 * left, 2 * PERCENTILE_POINTS_PER_ROW), PERCENTILE_POINTS_MAX_NUM);
+  return TSDB_CODE_SUCCESS;
+}
+
+static void percentileDestroyPoints(SPercentilePointsInfo* pInfo) {
+  taosArrayDestroy(pInfo->pPoints);
+  pInfo->pPoints = NULL;
+}
+
+// the distinct values of a vgroup in ascending order, in rows of PERCENTILE_POINTS_PER_ROW points at most, which
+// are merged by _percentile_merge, so the result is exact
+int32_t percentilePartialFunction(SqlFunctionCtx* pCtx) {
+  int32_t              numOfElems = 0;
+  SResultRowEntryInfo* pResInfo = GET_RES_INFO(pCtx);
+
+  SInputColumnInfoData* pInput = &pCtx->input;
+  SColumnInfoData*      pCol = pInput->pData[0];
+  int32_t               type = pCol->info.type;
+
+  SPercentilePointsInfo* pInfo = GET_ROWCELL_INTERBUF(pResInfo);
 
-      code = getPercentile(pMemBucket, v, &ppInfo->result);
+  int32_t start = pInput->startRowIndex;
+  for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
+    if (colDataIsNull_f(pCol->nullbitmap, i)) {
+      continue;
+    }
+
+    SPercentilePoint point = {.count = 1};
+    GET_TYPED_DATA(point.val, double, type, colDataGetData(pCol, i));
+    if (taosArrayPush(pInfo->pPoints, &point) == NULL) {
+      percentileDestroyPoints(pInfo);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    numOfElems += 1;
+
+    if (taosArrayGetSize(pInfo->pPoints) >= pInfo->threshold) {
+      int32_t code = percentileCompactPoints(pInfo);
       if (code != TSDB_CODE_SUCCESS) {
-        goto _fin_error;
+        percentileDestroyPoints(pInfo);
+        return code;
       }
+    }
+  }
+
+  // the rows needed by the points not combined yet, which are at most twice as many as the distinct values
+  int32_t numOfRows = ((int32_t)taosArrayGetSize(pInfo->pPoints) + PERCENTILE_POINTS_PER_ROW - 1) /
+                      PERCENTILE_POINTS_PER_ROW;
+
+  pInfo->total += numOfElems;
+  SET_VAL(pResInfo, numOfElems, TMAX(1, numOfRows));
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t percentilePartialFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
+  SResultRowEntryInfo*   pResInfo = GET_RES_INFO(pCtx);
+  SPercentilePointsInfo* pInfo = (SPercentilePointsInfo*)GET_ROWCELL_INTERBUF(pResInfo);
+
+  int32_t code = percentileCompactPoints(pInfo);
+  if (code != TSDB_CODE_SUCCESS) {
+    percentileDestroyPoints(pInfo);
+    return code;
+  }
+
+  char* res = taosMemoryCalloc(getPercentileMaxSize() + VARSTR_HEADER_SIZE, sizeof(char));
+  if (res == NULL) {
+    percentileDestroyPoints(pInfo);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t          slotId = pCtx->pExpr->base.resSchema.slotId;
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, slotId);
+
+  // the rows left by the points combined in the end are null
+  int32_t num = (int32_t)taosArrayGetSize(pInfo->pPoints);
+  int32_t numOfRows = TMAX(1, (int32_t)pResInfo->numOfRes);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t offset = i * PERCENTILE_POINTS_PER_ROW;
+    if (i > 0 && offset >= num) {
+      colDataSetNULL(pCol, pBlock->info.rows + i);
+      continue;
+    }
+
+    int32_t resultBytes = TMIN(num - offset, PERCENTILE_POINTS_PER_ROW) * sizeof(SPercentilePoint);
+    memcpy(varDataVal(res), taosArrayGet(pInfo->pPoints, offset), resultBytes);
+    varDataSetLen(res, resultBytes);
 
-      tMemBucketDestroy(pMemBucket);
-      return functionFinalize(pCtx, pBlock);
+    code = colDataSetVal(pCol, pBlock->info.rows + i, res, false);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
     }
   }
 
-_fin_error:
+  taosMemoryFree(res);
+  percentileDestroyPoints(pInfo);
+  return (code != TSDB_CODE_SUCCESS) ? code : pResInfo->numOfRes;
+}
+
+int32_t percentileFunctionMerge(SqlFunctionCtx* pCtx) {
+  SResultRowEntryInfo* pResInfo = GET_RES_INFO(pCtx);
 
-  tMemBucketDestroy(pMemBucket);
+  SInputColumnInfoData* pInput = &pCtx->input;
+
+  SColumnInfoData* pCol = pInput->pData[0];
+  if (pCol->info.type != TSDB_DATA_TYPE_BINARY) {
+    return TSDB_CODE_FUNC_FUNTION_PARA_TYPE;
+  }
+
+  SPercentilePointsInfo* pInfo = GET_ROWCELL_INTERBUF(pResInfo);
+
+  int64_t numOfElems = 0;
+  int32_t start = pInput->startRowIndex;
+  for (int32_t i = start; i < start + pInput->numOfRows; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
+    char*             data = colDataGetData(pCol, i);
+    SPercentilePoint* pPoints = (SPercentilePoint*)varDataVal(data);
+    int32_t           num = varDataLen(data) / sizeof(SPercentilePoint);
+    for (int32_t j = 0; j < num; ++j) {
+      numOfElems += pPoints[j].count;
+    }
+
+    if (num > 0 && taosArrayAddBatch(pInfo->pPoints, pPoints, num) == NULL) {
+      percentileDestroyPoints(pInfo);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    if (taosArrayGetSize(pInfo->pPoints) >= pInfo->threshold) {
+      int32_t code = percentileCompactPoints(pInfo);
+      if (code != TSDB_CODE_SUCCESS) {
+        percentileDestroyPoints(pInfo);
+        return code;
+      }
+    }
+  }
+
+  pInfo->total += numOfElems;
+  SET_VAL(pResInfo, pInfo->total, 1);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t percentileGetFromPoints(void* param, double percent, double* result) {
+  SPercentilePointsInfo* pInfo = (SPercentilePointsInfo*)param;
+  return tPercentilePointsGet(TARRAY_DATA(pInfo->pPoints), (int32_t)taosArrayGetSize(pInfo->pPoints), pInfo->total,
+                              percent, result);
+}
+
+int32_t percentileMergeFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
+  SResultRowEntryInfo*   pResInfo = GET_RES_INFO(pCtx);
+  SPercentilePointsInfo* pInfo = (SPercentilePointsInfo*)GET_ROWCELL_INTERBUF(pResInfo);
+
+  int32_t code = 0;
+  if (pInfo->total > 0) {
+    code = percentileCompactPoints(pInfo);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = percentileSetResult(pCtx, pBlock, &pInfo->result, percentileGetFromPoints, pInfo);
+    }
+  } else {
+    code = functionFinalize(pCtx, pBlock);
+  }
+
+  percentileDestroyPoints(pInfo);
   return code;
 }
 
@@ -2235,6 +2453,10 @@ int32_t apercentileFunctionMerge(SqlFunctionCtx* pCtx) {
   bool hasRes = false;
   int32_t start = pInput->startRowIndex;
   for (int32_t i = start; i < start + pInput->numOfRows; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
     char* data = colDataGetData(pCol, i);
 
     SAPercentileInfo* pInputInfo = (SAPercentileInfo*)varDataVal(data);
@@ -4386,6 +4608,10 @@ int32_t histogramFunctionMerge(SqlFunctionCtx* pCtx) {
   int32_t start = pInput->startRowIndex;
 
   for (int32_t i = start; i < start + pInput->numOfRows; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
     char*           data = colDataGetData(pCol, i);
     SHistoFuncInfo* pInputInfo = (SHistoFuncInfo*)varDataVal(data);
     histogramTransferInfo(pInputInfo, pInfo);
@@ -6409,6 +6635,10 @@ int32_t irateFunctionMerge(SqlFunctionCtx* pCtx) {
 
   int32_t start = pInput->startRowIndex;
   for (int32_t i = start; i < start + pInput->numOfRows; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
     char*        data = colDataGetData(pCol, i);
     SRateInfo*   pInputInfo = (SRateInfo*)varDataVal(data);
     initializeRateInfo(pCtx, pInfo, true);
@@ -55,6 +55,7 @@ static SFilePage *loadDataFromFilePage(tMemBucket *pMemBucket, int32_t slotIdx)
 
     memcpy(buffer->data + offset, pg->data, (size_t)(pg->num * pMemBucket->bytes));
     offset += (int32_t)(pg->num * pMemBucket->bytes);
+    releaseBufPage(pMemBucket->pBuffer, pg);
   }
 
   taosSort(buffer->data, pMemBucket->pSlots[slotIdx].info.size, pMemBucket->bytes, pMemBucket->comparFn);
@@ -123,6 +124,7 @@ int32_t findOnlyResult(tMemBucket *pMemBucket, double *result) {
       ASSERT(pPage->num == 1);
 
       GET_TYPED_DATA(*result, double, pMemBucket->type, pPage->data);
+      releaseBufPage(pMemBucket->pBuffer, pPage);
       return TSDB_CODE_SUCCESS;
     }
   }
@@ -202,16 +204,16 @@ int32_t tBucketDoubleHash(tMemBucket *pBucket, const void *value) {
     return index;
   }
 
-  // divide a range of [dMinVal, dMaxVal] into 1024 buckets
+  // divide a range of [dMinVal, dMaxVal] into 1024 buckets, a narrow range is divided as well, so that the data of a
+  // heavy slot are spread over the buckets of the next round
   double span = pBucket->range.dMaxVal - pBucket->range.dMinVal;
-  if (span < pBucket->numOfSlots) {
-    int32_t delta = (int32_t)(v - pBucket->range.dMinVal);
-    index = (delta % pBucket->numOfSlots);
+  if (span <= 0) {
+    index = 0;
   } else {
     double slotSpan = span / pBucket->numOfSlots;
     index = (int32_t)((v - pBucket->range.dMinVal) / slotSpan);
-    if (v == pBucket->range.dMaxVal) {
-      index -= 1;
+    if (v == pBucket->range.dMaxVal || index >= pBucket->numOfSlots) {
+      index = pBucket->numOfSlots - 1;
     }
   }
 
@@ -253,6 +255,8 @@ tMemBucket *tMemBucketCreate(int32_t nElemSize, int16_t dataType, double minval,
   pBucket->times = 1;
 
   pBucket->maxCapacity = 200000;
+  pBucket->sortedSlot = -1;
+  pBucket->childSlot = -1;
   pBucket->groupPagesMap = taosHashInit(128, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), false, HASH_NO_LOCK);
   if (setBoundingBox(&pBucket->range, pBucket->type, minval, maxval) != 0) {
     //    qError("MemBucket:%p, invalid value range: %f-%f", pBucket, minval, maxval);
@@ -307,6 +311,8 @@ void tMemBucketDestroy(tMemBucket *pBucket) {
     taosArrayDestroy(*p1);
   }
 
+  tMemBucketDestroy(pBucket->pChild);
+  taosMemoryFreeClear(pBucket->pSortedData);
   destroyDiskbasedBuf(pBucket->pBuffer);
   taosMemoryFreeClear(pBucket->pSlots);
   taosHashCleanup(pBucket->groupPagesMap);
@@ -411,6 +417,21 @@ int32_t tMemBucketPut(tMemBucket *pBucket, const void *data, size_t size) {
   return TSDB_CODE_SUCCESS;
 }
 
+/*
+ * the pages being filled are kept in memory during put, release them before the data are read, so that every page
+ * can be flushed to disk when the slots loaded for percentiles need memory
+ */
+static void tMemBucketReleaseSlotPages(tMemBucket *pBucket) {
+  for (int32_t i = 0; i < pBucket->numOfSlots; ++i) {
+    tMemBucketSlot *pSlot = &pBucket->pSlots[i];
+    if (pSlot->info.data != NULL) {
+      setBufPageDirty(pSlot->info.data, true);
+      releaseBufPage(pBucket->pBuffer, pSlot->info.data);
+      pSlot->info.data = NULL;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 /*
  *
@@ -419,16 +440,89 @@ int32_t tMemBucketPut(tMemBucket *pBucket, const void *data, size_t size) {
  * j is the last slot of current segment, we need to get the first
  * slot of the next segment.
  */
-static MinMaxEntry getMinMaxEntryOfNextSlotWithData(tMemBucket *pMemBucket, int32_t slotIdx) {
+static MinMaxEntry getMinMaxEntryOfNextSlotWithData(tMemBucket *pMemBucket, int32_t slotIdx,
+                                                    const MinMaxEntry *pNextRange) {
   int32_t j = slotIdx + 1;
   while (j < pMemBucket->numOfSlots && (pMemBucket->pSlots[j].info.size == 0)) {
     ++j;
   }
 
-  ASSERT(j < pMemBucket->numOfSlots);
+  if (j == pMemBucket->numOfSlots) {
+    ASSERT(pNextRange != NULL);
+    return *pNextRange;
+  }
   return pMemBucket->pSlots[j].range;
 }
 
+// the sorted data of the slot are kept, so that the percentiles falling into the same slot do not load it again
+static SFilePage *getSortedSlotData(tMemBucket *pMemBucket, int32_t slotIdx) {
+  if (pMemBucket->sortedSlot == slotIdx) {
+    return pMemBucket->pSortedData;
+  }
+
+  taosMemoryFreeClear(pMemBucket->pSortedData);
+  pMemBucket->sortedSlot = -1;
+
+  pMemBucket->pSortedData = loadDataFromFilePage(pMemBucket, slotIdx);
+  if (pMemBucket->pSortedData != NULL) {
+    pMemBucket->sortedSlot = slotIdx;
+  }
+
+  return pMemBucket->pSortedData;
+}
+
+// split the data of a slot that is too large to be sorted into the buckets of a child, which is kept for the
+// following percentiles. The buckets of this level are left untouched.
+static int32_t getSlotChildBucket(tMemBucket *pMemBucket, int32_t slotIdx, tMemBucket **ppChild) {
+  if (pMemBucket->childSlot == slotIdx) {
+    *ppChild = pMemBucket->pChild;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  tMemBucketDestroy(pMemBucket->pChild);
+  pMemBucket->pChild = NULL;
+  pMemBucket->childSlot = -1;
+
+  tMemBucketSlot *pSlot = &pMemBucket->pSlots[slotIdx];
+  tMemBucket     *pChild = tMemBucketCreate(pMemBucket->bytes, pMemBucket->type, 0, 0);
+  if (pChild == NULL) {
+    return terrno ? terrno : TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // the range is copied, since converting the integer bounds to double may lose precision
+  pChild->range = pSlot->range;
+
+  int32_t groupId = getGroupId(pMemBucket->numOfSlots, slotIdx, pMemBucket->times);
+  void   *p = taosHashGet(pMemBucket->groupPagesMap, &groupId, sizeof(groupId));
+  SArray *list = (p != NULL) ? *(SArray **)p : NULL;
+  if (list == NULL || list->size <= 0) {
+    tMemBucketDestroy(pChild);
+    return TSDB_CODE_FAILED;
+  }
+
+  for (int32_t f = 0; f < list->size; ++f) {
+    int32_t   *pageId = taosArrayGet(list, f);
+    SFilePage *pg = getBufPage(pMemBucket->pBuffer, *pageId);
+    if (pg == NULL) {
+      tMemBucketDestroy(pChild);
+      return terrno;
+    }
+
+    int32_t code = tMemBucketPut(pChild, pg->data, (int32_t)pg->num);
+    releaseBufPage(pMemBucket->pBuffer, pg);
+    if (code != TSDB_CODE_SUCCESS) {
+      tMemBucketDestroy(pChild);
+      return code;
+    }
+  }
+
+  tMemBucketReleaseSlotPages(pChild);
+  pMemBucket->pChild = pChild;
+  pMemBucket->childSlot = slotIdx;
+  *ppChild = pChild;
+  return TSDB_CODE_SUCCESS;
+}
+
 static bool isIdenticalData(tMemBucket *pMemBucket, int32_t index);
 
 static double getIdenticalDataVal(tMemBucket *pMemBucket, int32_t slotIndex) {
@@ -448,7 +542,8 @@ static double getIdenticalDataVal(tMemBucket *pMemBucket, int32_t slotIndex) {
   return finalResult;
 }
 
-int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction, double *result) {
+static int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction, const MinMaxEntry *pNextRange,
+                                 double *result) {
   int32_t num = 0;
 
   for (int32_t i = 0; i < pMemBucket->numOfSlots; ++i) {
@@ -464,7 +559,7 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
          * now, we need to find the minimum value of the next slot for interpolating the percentile value
          * j is the last slot of current segment, we need to get the first slot of the next segment.
          */
-        MinMaxEntry next = getMinMaxEntryOfNextSlotWithData(pMemBucket, i);
+        MinMaxEntry next = getMinMaxEntryOfNextSlotWithData(pMemBucket, i, pNextRange);
 
         double maxOfThisSlot = 0;
         double minOfNextSlot = 0;
@@ -487,7 +582,7 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
 
       if (pSlot->info.size <= pMemBucket->maxCapacity) {
         // data in buffer and file are merged together to be processed.
-        SFilePage *buffer = loadDataFromFilePage(pMemBucket, i);
+        SFilePage *buffer = getSortedSlotData(pMemBucket, i);
         if (buffer == NULL) {
           return terrno;
         }
@@ -502,8 +597,6 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
         GET_TYPED_DATA(nd, double, pMemBucket->type, nextVal);
 
         *result = (1 - fraction) * td + fraction * nd;
-        taosMemoryFreeClear(buffer);
-
         return TSDB_CODE_SUCCESS;
       } else {  // incur a second round bucket split
         if (isIdenticalData(pMemBucket, i)) {
@@ -512,43 +605,25 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
         }
 
         // try next round
-        pMemBucket->times += 1;
-        //       qDebug("MemBucket:%p, start next round data bucketing, time:%d", pMemBucket, pMemBucket->times);
-
-        pMemBucket->range = pSlot->range;
-        pMemBucket->total = 0;
-
-        resetSlotInfo(pMemBucket);
-
-        int32_t groupId = getGroupId(pMemBucket->numOfSlots, i, pMemBucket->times - 1);
-
-        SArray* list;
-        void *p = taosHashGet(pMemBucket->groupPagesMap, &groupId, sizeof(groupId));
-        if (p != NULL) {
-          list = *(SArray **)p;
-          if (list == NULL || list->size <= 0) {
-            return -1;
-          }
-        } else {
-          return -1;
+        tMemBucket *pChild = NULL;
+        int32_t     code = getSlotChildBucket(pMemBucket, i, &pChild);
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
         }
 
-        for (int32_t f = 0; f < list->size; ++f) {
-          int32_t *pageId = taosArrayGet(list, f);
-          SFilePage *pg = getBufPage(pMemBucket->pBuffer, *pageId);
-          if (pg == NULL) {
-            return terrno;
-          }
-
-          int32_t code = tMemBucketPut(pMemBucket, pg->data, (int32_t)pg->num);
-          if (code != TSDB_CODE_SUCCESS) {
-            return code;
-          }
-          setBufPageDirty(pg, true);
-          releaseBufPage(pMemBucket->pBuffer, pg);
+        // the value next to the largest one of this slot is the smallest one of the following slot
+        MinMaxEntry        next = {0};
+        const MinMaxEntry *pNext = pNextRange;
+        int32_t            j = i + 1;
+        while (j < pMemBucket->numOfSlots && (pMemBucket->pSlots[j].info.size == 0)) {
+          ++j;
+        }
+        if (j < pMemBucket->numOfSlots) {
+          next = pMemBucket->pSlots[j].range;
+          pNext = &next;
         }
 
-        return getPercentileImpl(pMemBucket, count - num, fraction, result);
+        return getPercentileImpl(pChild, count - num, fraction, pNext, result);
       }
     } else {
       num += pSlot->info.size;
@@ -560,6 +635,8 @@ int32_t getPercentileImpl(tMemBucket *pMemBucket, int32_t count, double fraction
 }
 
 int32_t getPercentile(tMemBucket *pMemBucket, double percent, double *result) {
+  tMemBucketReleaseSlotPages(pMemBucket);
+
   if (pMemBucket->total == 0) {
     *result = 0.0;
     return TSDB_CODE_SUCCESS;
@@ -591,7 +668,7 @@ int32_t getPercentile(tMemBucket *pMemBucket, double percent, double *result) {
 
   // do put data by using buckets
   int32_t orderIdx = (int32_t)percentVal;
-  return getPercentileImpl(pMemBucket, orderIdx, percentVal - orderIdx, result);
+  return getPercentileImpl(pMemBucket, orderIdx, percentVal - orderIdx, NULL, result);
 }
 
 /*
@@ -606,3 +683,62 @@ bool isIdenticalData(tMemBucket *pMemBucket, int32_t index) {
     return pSeg->range.dMinVal == pSeg->range.dMaxVal;
   }
 }
+
+static int32_t comparePercentilePoint(const void *p1, const void *p2) {
+  double v1 = ((const SPercentilePoint *)p1)->val;
+  double v2 = ((const SPercentilePoint *)p2)->val;
+  return (v1 < v2) ? -1 : ((v1 > v2) ? 1 : 0);
+}
+
+int32_t tPercentilePointsCompact(SPercentilePoint *pPoints, int32_t num) {
+  if (num <= 1) {
+    return num;
+  }
+
+  taosSort(pPoints, num, sizeof(SPercentilePoint), comparePercentilePoint);
+
+  int32_t n = 0;
+  for (int32_t i = 1; i < num; ++i) {
+    if (pPoints[i].val == pPoints[n].val) {
+      pPoints[n].count += pPoints[i].count;
+    } else {
+      pPoints[++n] = pPoints[i];
+    }
+  }
+  return n + 1;
+}
+
+/*
+ * the same interpolation as getPercentile() does with the raw values, so that the percentile merged from the points
+ * of all vgroups is identical to the one of a single table
+ */
+int32_t tPercentilePointsGet(const SPercentilePoint *pPoints, int32_t num, int64_t total, double percent,
+                             double *result) {
+  if (num <= 0 || total <= 0) {
+    *result = 0.0;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  percent = fabs(percent);
+  if (fabs(percent - 100.0) < DBL_EPSILON || (percent < DBL_EPSILON) || total == 1) {
+    *result = (percent < DBL_EPSILON || total == 1) ? pPoints[0].val : pPoints[num - 1].val;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  double  percentVal = (percent * (total - 1)) / ((double)100.0);
+  int64_t orderIdx = (int64_t)percentVal;
+  double  fraction = percentVal - orderIdx;
+
+  // the point holding the value of orderIdx, and the value next to it may be in the following point
+  int64_t num0 = 0;
+  int32_t i = 0;
+  while (i < num - 1 && num0 + pPoints[i].count <= orderIdx) {
+    num0 += pPoints[i].count;
+    ++i;
+  }
+
+  double td = pPoints[i].val;
+  double nd = (orderIdx + 1 < num0 + pPoints[i].count || i == num - 1) ? td : pPoints[i + 1].val;
+  *result = (1 - fraction) * td + fraction * nd;
+  return TSDB_CODE_SUCCESS;
+}
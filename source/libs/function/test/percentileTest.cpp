@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "builtinsimpl.h"
+#include "tdatablock.h"
+#include "tpercentile.h"
+#include "ttypes.h"
+
+namespace {
+
+const double percents[] = {1, 10, 25, 33.3, 50, 50, 75, 90, 99, 99.9, 0.5, 0, 100};
+
+// the percentile of the sorted values, interpolated between the two values around it
+double percentileOf(const std::vector<double> &sorted, double percent) {
+  double  v = percent * (sorted.size() - 1) / 100.0;
+  int64_t k = (int64_t)v;
+  if (k + 1 >= (int64_t)sorted.size()) {
+    return sorted.back();
+  }
+  return (1 - (v - k)) * sorted[k] + (v - k) * sorted[k + 1];
+}
+
+// the bucket is created with the min and max value, as the first scan of percentile gets them
+tMemBucket *createBucket(int16_t type, const std::vector<double> &values) {
+  double minVal = *std::min_element(values.begin(), values.end());
+  double maxVal = *std::max_element(values.begin(), values.end());
+  return tMemBucketCreate(tDataTypes[type].bytes, type, minVal, maxVal);
+}
+
+void checkBucket(tMemBucket *pBucket, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  for (double percent : percents) {
+    double result = 0;
+    ASSERT_EQ(getPercentile(pBucket, percent, &result), TSDB_CODE_SUCCESS);
+    ASSERT_NEAR(result, percentileOf(values, percent), 1e-6 * std::max(1.0, std::abs(result)))
+        << "percent:" << percent;
+  }
+}
+
+// the points of each vgroup are compacted alone, and then merged the way _percentile_merge does
+std::vector<SPercentilePoint> mergePoints(const std::vector<std::vector<double>> &vgroups, int64_t *total) {
+  std::vector<SPercentilePoint> merged;
+  *total = 0;
+  for (const std::vector<double> &values : vgroups) {
+    std::vector<SPercentilePoint> points;
+    for (double v : values) {
+      points.push_back({v, 1});
+    }
+    points.resize(tPercentilePointsCompact(points.data(), (int32_t)points.size()));
+    for (size_t i = 1; i < points.size(); ++i) {
+      EXPECT_LT(points[i - 1].val, points[i].val);
+    }
+    merged.insert(merged.end(), points.begin(), points.end());
+    *total += values.size();
+  }
+  merged.resize(tPercentilePointsCompact(merged.data(), (int32_t)merged.size()));
+  return merged;
+}
+
+// the context of _percentile_partial or _percentile_merge, of which the result is in the first column of a block
+struct SPercentileCtx {
+  SqlFunctionCtx    ctx = {0};
+  SExprInfo         expr = {0};
+  SFunctParam       params[2] = {0};
+  std::vector<char> buf = std::vector<char>(1024);
+
+  explicit SPercentileCtx(double percent) {
+    ctx.resultInfo = (SResultRowEntryInfo *)buf.data();
+    ctx.pExpr = &expr;
+    ctx.numOfParams = 2;
+    ctx.param = params;
+    params[1].param.nType = TSDB_DATA_TYPE_DOUBLE;
+    params[1].param.d = percent;
+    EXPECT_TRUE(percentilePointsFunctionSetup(&ctx, ctx.resultInfo));
+  }
+
+  int32_t process(SColumnInfoData *pCol, int32_t start, int32_t rows, bool merge) {
+    ctx.input.pData = &pCol;
+    ctx.input.startRowIndex = start;
+    ctx.input.numOfRows = rows;
+    return merge ? percentileFunctionMerge(&ctx) : percentilePartialFunction(&ctx);
+  }
+};
+
+SSDataBlock *createBlock(int32_t type, int32_t bytes, int32_t rows) {
+  SSDataBlock    *pBlock = createDataBlock();
+  SColumnInfoData col = createColumnInfoData(type, bytes, 1);
+  EXPECT_EQ(blockDataAppendColInfo(pBlock, &col), 0);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, rows), 0);
+  return pBlock;
+}
+
+}  // namespace
+
+// the heavy slot is split into a child bucket, and the parent is kept for the following percents
+TEST(percentileTest, multiPercentsWithChildBucket) {
+  std::mt19937 gen(20241017);
+
+  std::vector<int64_t> data;
+  for (int32_t i = 0; i < 20000; ++i) {
+    data.push_back((i % 10 == 0) ? (int64_t)(gen() % 2000000) - 1000000 : (int64_t)(gen() % 500));
+  }
+  std::vector<double> values(data.begin(), data.end());
+
+  tMemBucket *pBucket = createBucket(TSDB_DATA_TYPE_BIGINT, values);
+  ASSERT_NE(pBucket, nullptr);
+  pBucket->maxCapacity = 1000;
+  for (int64_t v : data) {
+    ASSERT_EQ(tMemBucketPut(pBucket, &v, 1), TSDB_CODE_SUCCESS);
+  }
+
+  checkBucket(pBucket, values);
+  ASSERT_GE(pBucket->childSlot, 0);
+  ASSERT_NE(pBucket->pChild, nullptr);
+
+  // the same percents again, from the child that is kept
+  checkBucket(pBucket, values);
+  tMemBucketDestroy(pBucket);
+}
+
+// the percents falling into the same slot are got from the sorted data of the slot that is cached
+TEST(percentileTest, multiPercentsWithSortedSlot) {
+  std::mt19937 gen(1017);
+
+  // half of the values are in a narrow range, which is only a few slots
+  std::vector<double> values;
+  for (int32_t i = 0; i < 5000; ++i) {
+    values.push_back((i % 2 == 0) ? 500 + (gen() % 1000) / 100.0 : (gen() % 100000) / 100.0);
+  }
+
+  tMemBucket *pBucket = createBucket(TSDB_DATA_TYPE_DOUBLE, values);
+  ASSERT_NE(pBucket, nullptr);
+  for (double v : values) {
+    ASSERT_EQ(tMemBucketPut(pBucket, &v, 1), TSDB_CODE_SUCCESS);
+  }
+
+  checkBucket(pBucket, values);
+  ASSERT_GE(pBucket->sortedSlot, 0);
+  ASSERT_NE(pBucket->pSortedData, nullptr);
+  ASSERT_EQ(pBucket->pChild, nullptr);
+
+  double result = 0;
+  ASSERT_EQ(getPercentile(pBucket, 50, &result), TSDB_CODE_SUCCESS);
+  std::sort(values.begin(), values.end());
+  ASSERT_DOUBLE_EQ(result, percentileOf(values, 50));
+
+  SFilePage *pSortedData = pBucket->pSortedData;
+  int32_t    sortedSlot = pBucket->sortedSlot;
+  ASSERT_EQ(getPercentile(pBucket, 50.01, &result), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(pBucket->sortedSlot, sortedSlot);
+  ASSERT_EQ(pBucket->pSortedData, pSortedData);
+  ASSERT_DOUBLE_EQ(result, percentileOf(values, 50.01));
+  tMemBucketDestroy(pBucket);
+}
+
+// the points merged from all the vgroups give the same percentile as all the values in one place
+TEST(percentileTest, mergedPoints) {
+  std::mt19937 gen(4000);
+
+  std::vector<std::vector<double>> vgroups(5);
+  std::vector<double>              values;
+  for (int32_t i = 0; i < 30000; ++i) {
+    double v = (double)(int32_t)(gen() % 3000) - 1500;
+    if (i % 7 == 0) v += 0.25;
+    vgroups[gen() % vgroups.size()].push_back(v);
+    values.push_back(v);
+  }
+  vgroups.push_back({});  // a vgroup without any rows
+
+  int64_t                       total = 0;
+  std::vector<SPercentilePoint> points = mergePoints(vgroups, &total);
+  ASSERT_EQ(total, (int64_t)values.size());
+
+  int64_t count = 0;
+  for (const SPercentilePoint &p : points) count += p.count;
+  ASSERT_EQ(count, total);
+
+  std::sort(values.begin(), values.end());
+  for (double percent : percents) {
+    double result = 0;
+    ASSERT_EQ(tPercentilePointsGet(points.data(), (int32_t)points.size(), total, percent, &result), 0);
+    ASSERT_DOUBLE_EQ(result, percentileOf(values, percent)) << "percent:" << percent;
+  }
+}
+
+TEST(percentileTest, mergedPointsOfFewValues) {
+  int64_t total = 0;
+  double  result = 0;
+
+  std::vector<SPercentilePoint> points = mergePoints({{-1.5}}, &total);
+  ASSERT_EQ(tPercentilePointsGet(points.data(), (int32_t)points.size(), total, 60, &result), 0);
+  ASSERT_DOUBLE_EQ(result, -1.5);
+
+  // the values next to each other are in the same point and in the following one
+  points = mergePoints({{3, 3, 3}, {1}, {3, 7}}, &total);
+  ASSERT_EQ(points.size(), (size_t)3);
+  std::vector<double> values = {1, 3, 3, 3, 3, 7};
+  for (double percent : {0.0, 10.0, 20.0, 40.0, 70.0, 80.0, 90.0, 100.0}) {
+    ASSERT_EQ(tPercentilePointsGet(points.data(), (int32_t)points.size(), total, percent, &result), 0);
+    ASSERT_DOUBLE_EQ(result, percentileOf(values, percent)) << "percent:" << percent;
+  }
+}
+
+// the distinct values of a vgroup are sent to the merge in several rows, and the result is still exact
+TEST(percentileTest, partialAndMergeOfManyDistinctValues) {
+  const int32_t numOfVgroups = 3;
+  const int32_t numOfRows = 120000;
+  const int32_t rowsOfBlock = 4096;
+
+  std::mt19937                     gen(100000);
+  std::uniform_real_distribution<> dist(-1e6, 1e6);
+
+  std::vector<std::vector<double>> vgroups(numOfVgroups);
+  std::vector<double>              values;
+  for (std::vector<double> &vgroup : vgroups) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      // a few values appear in all the vgroups
+      vgroup.push_back((i % 1000 == 0) ? (double)(i / 1000) : dist(gen));
+    }
+    values.insert(values.end(), vgroup.begin(), vgroup.end());
+  }
+  std::sort(values.begin(), values.end());
+
+  for (double percent : {0.0, 0.1, 25.0, 50.0, 99.99, 100.0}) {
+    SSDataBlock *pPartial = createBlock(TSDB_DATA_TYPE_BINARY, getPercentileMaxSize() + VARSTR_HEADER_SIZE, 16);
+
+    for (const std::vector<double> &vgroup : vgroups) {
+      SPercentileCtx   partial(percent);
+      SSDataBlock     *pBlock = createBlock(TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowsOfBlock);
+      SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+      for (int32_t i = 0; i < numOfRows; i += rowsOfBlock - 1) {
+        // the null at the start of each block is skipped
+        int32_t rows = std::min(rowsOfBlock - 1, numOfRows - i);
+        colDataSetNULL(pCol, 0);
+        for (int32_t j = 0; j < rows; ++j) {
+          ASSERT_EQ(colDataSetVal(pCol, j + 1, (const char *)&vgroup[i + j], false), 0);
+        }
+        ASSERT_EQ(partial.process(pCol, 0, rows + 1, false), 0);
+      }
+      blockDataDestroy(pBlock);
+
+      // the rows are allocated by the executor before the finalize, as many as the function asks for
+      int32_t numOfRes = partial.ctx.resultInfo->numOfRes;
+      ASSERT_GE(numOfRes, numOfRows / 4000);
+      ASSERT_EQ(blockDataEnsureCapacity(pPartial, pPartial->info.rows + numOfRes), 0);
+      ASSERT_EQ(percentilePartialFinalize(&partial.ctx, pPartial), numOfRes);
+
+      // the points of all the rows are in ascending order
+      SColumnInfoData *pRes = (SColumnInfoData *)taosArrayGet(pPartial->pDataBlock, 0);
+      double           last = -DBL_MAX;
+      int64_t          count = 0;
+      for (int32_t i = pPartial->info.rows; i < pPartial->info.rows + numOfRes; ++i) {
+        if (colDataIsNull_s(pRes, i)) {
+          continue;
+        }
+        char             *data = colDataGetData(pRes, i);
+        SPercentilePoint *pPoints = (SPercentilePoint *)varDataVal(data);
+        int32_t           num = varDataLen(data) / sizeof(SPercentilePoint);
+        ASSERT_LE(num, 4000);
+        for (int32_t j = 0; j < num; ++j) {
+          ASSERT_LT(last, pPoints[j].val);
+          last = pPoints[j].val;
+          count += pPoints[j].count;
+        }
+      }
+      ASSERT_EQ(count, numOfRows);
+      pPartial->info.rows += numOfRes;
+    }
+
+    // the rows of the vgroups are merged in two blocks
+    SPercentileCtx   merge(percent);
+    SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pPartial->pDataBlock, 0);
+    int32_t          half = pPartial->info.rows / 2;
+    ASSERT_EQ(merge.process(pCol, 0, half, true), 0);
+    ASSERT_EQ(merge.process(pCol, half, pPartial->info.rows - half, true), 0);
+
+    SSDataBlock *pResult = createBlock(TSDB_DATA_TYPE_DOUBLE, sizeof(double), 1);
+    ASSERT_EQ(percentileMergeFinalize(&merge.ctx, pResult), 1);
+    double result = *(double *)colDataGetData((SColumnInfoData *)taosArrayGet(pResult->pDataBlock, 0), 0);
+    ASSERT_DOUBLE_EQ(result, percentileOf(values, percent)) << "percent:" << percent;
+
+    blockDataDestroy(pResult);
+    blockDataDestroy(pPartial);
+  }
+}
+
+int main(int argc, char **argv) {
+  osDefaultInit();
+  osUpdate();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -83,6 +83,12 @@ void iUnion(SArray *in, SArray *out);
 
 void iExcept(SArray *total, SArray *except);
 
+/* sort the uids and remove the duplicated ones, by a roaring bitmap
+ * input:  [5, 1, 4, 1, 2]
+ * output: [1, 2, 4, 5]
+ */
+int32_t iUnique(SArray *uids);
+
 int uidCompare(const void *a, const void *b);
 
 // data with ver
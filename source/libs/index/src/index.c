@@ -23,6 +23,7 @@
 #include "tdataformat.h"
 #include "tdef.h"
 #include "tref.h"
+#include "troaring.h"
 #include "tsched.h"
 
 #define INDEX_NUM_OF_THREADS 5
@@ -458,23 +459,45 @@ static void idxInterRsltDestroy(SArray* results) {
 }
 
 static int idxMergeFinalResults(SArray* in, EIndexOperatorType oType, SArray* out) {
-  // refactor, merge interResults into fResults by oType
-  for (int i = 0; i < taosArrayGetSize(in); i++) {
-    SArray* t = taosArrayGetP(in, i);
-    taosArraySort(t, uidCompare);
-    taosArrayRemoveDuplicate(t, uidCompare, NULL);
-  }
-
-  if (oType == MUST) {
-    iIntersection(in, out);
-  } else if (oType == SHOULD) {
-    iUnion(in, out);
-  } else if (oType == NOT) {
+  // merge interResults into fResults by oType, the uids of each term are in any order and may be duplicated
+  int32_t sz = (int32_t)taosArrayGetSize(in);
+  if (sz <= 0 || oType == NOT) {
     // just one column index, enhance later
-    // taosArrayAddAll(fResults, interResults);
     // not use currently
+    return 0;
   }
-  return 0;
+
+  int32_t         code = 0;
+  SRoaringBitmap* pRslt = tRoaringCreate();
+  SRoaringBitmap* pTerm = tRoaringCreate();
+  if (pRslt == NULL || pTerm == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < sz; i++) {
+    SArray*         t = taosArrayGetP(in, i);
+    int32_t         num = (int32_t)taosArrayGetSize(t);
+    SRoaringBitmap* pDst = (i == 0) ? pRslt : pTerm;
+
+    tRoaringClear(pTerm);
+    code = tRoaringAddBatch(pDst, num > 0 ? taosArrayGet(t, 0) : NULL, num);
+    if (code == 0 && i > 0) {
+      code = (oType == MUST) ? tRoaringAnd(pRslt, pTerm) : tRoaringOr(pRslt, pTerm);
+    }
+    if (code != 0 || (oType == MUST && tRoaringCardinality(pRslt) == 0)) {
+      break;
+    }
+  }
+
+  if (code == 0) {
+    code = tRoaringToArray(pRslt, out);
+  }
+
+_end:
+  tRoaringDestroy(pRslt);
+  tRoaringDestroy(pTerm);
+  return code;
 }
 
 static void idxMayMergeTempToFinalRslt(SArray* result, TFileValue* tfv, SIdxTRslt* tr) {
@@ -671,8 +671,7 @@ static int32_t sifDoIndex(SIFParam *left, SIFParam *right, int8_t operType, SIFP
     }
     ret = left->api.metaFilterTableIds(arg->metaEx, &param, output->result);
     if (ret == 0) {
-      taosArraySort(output->result, uidCompare);
-      taosArrayRemoveDuplicate(output->result, uidCompare, NULL);
+      ret = iUnique(output->result);
     }
   }
   return ret;
@@ -872,6 +871,7 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
   SIF_ERR_RET(sifInitParamList(&params, node->pParameterList, ctx));
 
   if (ctx->noExec == false) {
+    // the results are coarse, and the union of the params is taken for AND as well
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
       if (node->condType == LOGIC_COND_TYPE_AND) {
         taosArrayAddAll(output->result, params[m].result);
@@ -880,9 +880,8 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
       } else if (node->condType == LOGIC_COND_TYPE_NOT) {
         // taosArrayAddAll(output->result, params[m].result);
       }
-      taosArraySort(output->result, uidCompare);
-      taosArrayRemoveDuplicate(output->result, uidCompare, NULL);
     }
+    SIF_ERR_JRET(iUnique(output->result));
   } else {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
       output->status = sifMergeCond(node->condType, output->status, params[m].status);
@@ -15,6 +15,7 @@
 #include "indexUtil.h"
 #include "index.h"
 #include "tcompare.h"
+#include "troaring.h"
 
 typedef struct MergeIndex {
   int idx;
@@ -137,6 +138,28 @@ void iExcept(SArray *total, SArray *except) {
   taosArrayPopTailBatch(total, tsz - vIdx);
 }
 
+int32_t iUnique(SArray *uids) {
+  int32_t num = (int32_t)taosArrayGetSize(uids);
+  if (num <= 1) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SRoaringBitmap *pBitmap = tRoaringCreate();
+  if (pBitmap == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = tRoaringAddBatch(pBitmap, taosArrayGet(uids, 0), num);
+  if (code == TSDB_CODE_SUCCESS) {
+    // the unique uids are no more than the input ones, so the array is not enlarged
+    taosArrayClear(uids);
+    code = tRoaringToArray(pBitmap, uids);
+  }
+
+  tRoaringDestroy(pBitmap);
+  return code;
+}
+
 int uidCompare(const void *a, const void *b) {
   // add more version compare
   uint64_t u1 = *(uint64_t *)a;
@@ -2101,63 +2101,324 @@ static int32_t parseValuesClause(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   return code;
 }
 
-static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
-                            int32_t* pNumOfRows) {
-  int32_t code = TSDB_CODE_SUCCESS;
-  (*pNumOfRows) = 0;
-  char*   pLine = NULL;
-  int64_t readLen = 0;
-  bool    firstLine = (pStmt->fileProcessing == false);
-  pStmt->fileProcessing = false;
-  while (TSDB_CODE_SUCCESS == code && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
-    if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
-      pLine[--readLen] = '\0';
+// the csv file is read block by block, and the complete lines in the buffer are parsed a round at a time
+#define CSV_READ_BLOCK_SIZE  (4 * 1024 * 1024)
+#define CSV_LINES_PER_ROUND  65536
+#define CSV_LINES_PER_WORKER 4096  // a worker is not worth starting for fewer lines
+
+typedef struct SCsvReader {
+  TdFilePtr fp;
+  char*     pBuf;
+  int64_t   cap;
+  int64_t   len;     // bytes of data in the buffer
+  int64_t   pos;     // the first byte not consumed
+  int64_t   offset;  // file offset of the first byte in the buffer
+  bool      eof;
+} SCsvReader;
+
+typedef struct SCsvParseWorker {
+  SInsertParseContext cxt;
+  STableDataCxt       tableCxt;
+  SSubmitTbData       data;
+  char**              pLines;
+  int32_t             numOfLines;
+  int32_t             numOfRows;
+  int32_t             code;
+} SCsvParseWorker;
+
+// move the data not consumed to the head of the buffer, and fill the rest of the buffer from the file
+static int32_t csvReaderFill(SCsvReader* pReader) {
+  pReader->len -= pReader->pos;
+  memmove(pReader->pBuf, pReader->pBuf + pReader->pos, pReader->len);
+  pReader->offset += pReader->pos;
+  pReader->pos = 0;
+
+  // a line is longer than the buffer
+  if (pReader->len == pReader->cap) {
+    char* pBuf = taosMemoryRealloc(pReader->pBuf, pReader->cap * 2 + 1);
+    if (NULL == pBuf) {
+      return TSDB_CODE_OUT_OF_MEMORY;
     }
+    pReader->pBuf = pBuf;
+    pReader->cap *= 2;
+  }
 
-    if (readLen == 0) {
-      firstLine = false;
-      continue;
+  int64_t size = pReader->cap - pReader->len;
+  int64_t readLen = taosReadFile(pReader->fp, pReader->pBuf + pReader->len, size);
+  if (readLen < 0) {
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  pReader->len += readLen;
+  pReader->eof = (readLen < size);
+  return TSDB_CODE_SUCCESS;
+}
+
+// split at most maxLines non-empty lines off the buffer, which are terminated in place
+static int32_t csvReaderSplitLines(SCsvReader* pReader, char** pLines, int32_t maxLines, bool* pFirstLine) {
+  int32_t numOfLines = 0;
+  while (numOfLines < maxLines && pReader->pos < pReader->len) {
+    char*   pLine = pReader->pBuf + pReader->pos;
+    int64_t left = pReader->len - pReader->pos;
+    char*   pEnd = memchr(pLine, '\n', left);
+    int64_t lineLen = 0;
+    if (NULL != pEnd) {
+      lineLen = pEnd - pLine;
+      pReader->pos += lineLen + 1;
+    } else if (pReader->eof) {
+      // the last line without the line break
+      lineLen = left;
+      pReader->pos = pReader->len;
+    } else {
+      break;
     }
 
-    bool gotRow = false;
-    if (TSDB_CODE_SUCCESS == code) {
-      SToken token;
-      strtolower(pLine, pLine);
-      const char* pRow = pLine;
-      if (!pStmt->stbSyntax) {
-        code = parseOneRow(pCxt, (const char**)&pRow, rowsDataCxt.pTableDataCxt, &gotRow, &token);
-      } else {
-        STableDataCxt* pTableDataCxt = NULL;
-        code =
-            parseOneStbRow(pCxt, pStmt, (const char**)&pRow, rowsDataCxt.pStbRowsCxt, &gotRow, &token, &pTableDataCxt);
-        if (code == TSDB_CODE_SUCCESS) {
-          SStbRowsDataContext* pStbRowsCxt = rowsDataCxt.pStbRowsCxt;
-          void*                pData = pTableDataCxt;
-          taosHashPut(pStmt->pTableCxtHashObj, &pStbRowsCxt->pCtbMeta->uid, sizeof(pStbRowsCxt->pCtbMeta->uid), &pData,
-                      POINTER_BYTES);
-        }
+    // a line ends with "\r\n" on windows, so that an empty line is skipped as well
+    if (lineLen > 0 && '\r' == pLine[lineLen - 1]) {
+      --lineLen;
+    }
+    pLine[lineLen] = '\0';
+    if (0 == lineLen) {
+      if (0 == numOfLines) {
+        *pFirstLine = false;
       }
-      if (code && firstLine) {
-        firstLine = false;
-        code = 0;
-        continue;
+      continue;
+    }
+    pLines[numOfLines++] = pLine;
+  }
+
+  return numOfLines;
+}
+
+static int32_t parseCsvLine(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                            char* pLine, bool* pGotRow) {
+  SToken token;
+  strtolower(pLine, pLine);
+  const char* pRow = pLine;
+  if (!pStmt->stbSyntax) {
+    return parseOneRow(pCxt, (const char**)&pRow, rowsDataCxt.pTableDataCxt, pGotRow, &token);
+  }
+
+  STableDataCxt* pTableDataCxt = NULL;
+  int32_t code =
+      parseOneStbRow(pCxt, pStmt, (const char**)&pRow, rowsDataCxt.pStbRowsCxt, pGotRow, &token, &pTableDataCxt);
+  if (code == TSDB_CODE_SUCCESS) {
+    SStbRowsDataContext* pStbRowsCxt = rowsDataCxt.pStbRowsCxt;
+    void*                pData = pTableDataCxt;
+    taosHashPut(pStmt->pTableCxtHashObj, &pStbRowsCxt->pCtbMeta->uid, sizeof(pStbRowsCxt->pCtbMeta->uid), &pData,
+                POINTER_BYTES);
+  }
+  return code;
+}
+
+static void* parseCsvLinesWorker(void* param) {
+  SCsvParseWorker* pWorker = param;
+  for (int32_t i = 0; i < pWorker->numOfLines && TSDB_CODE_SUCCESS == pWorker->code; ++i) {
+    SToken token;
+    bool   gotRow = false;
+    char*  pLine = pWorker->pLines[i];
+    strtolower(pLine, pLine);
+    const char* pRow = pLine;
+    pWorker->code = parseOneRow(&pWorker->cxt, &pRow, &pWorker->tableCxt, &gotRow, &token);
+    if (TSDB_CODE_SUCCESS == pWorker->code && gotRow) {
+      pWorker->numOfRows++;
+    }
+  }
+  return NULL;
+}
+
+static void* parseCsvLinesThreadFp(void* param) {
+  setThreadName("csvParse");
+  parseCsvLinesWorker(param);
+  destroyThreadLocalGeosCtx();
+  return NULL;
+}
+
+// only the rows of a normal table or a child table are built in parallel, since each row of the super table syntax
+// may need the meta of a new child table
+static int32_t getNumOfCsvParseWorkers(SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt, int32_t numOfLines) {
+  if (pStmt->stbSyntax || NULL == rowsDataCxt.pTableDataCxt->pData->aRowP) {
+    return 1;
+  }
+  return TMAX(1, TMIN(tsNumOfCsvParseThreads, numOfLines / CSV_LINES_PER_WORKER));
+}
+
+static int32_t initCsvParseWorker(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, SCsvParseWorker* pWorker) {
+  pWorker->cxt = *pCxt;
+  pWorker->cxt.msg.buf = taosMemoryCalloc(1, pCxt->msg.len);
+  pWorker->tableCxt = *pTableCxt;
+  pWorker->tableCxt.pValues = taosArrayDup(pTableCxt->pValues, NULL);
+  pWorker->tableCxt.pData = &pWorker->data;
+  pWorker->data.aRowP = taosArrayInit(pWorker->numOfLines, POINTER_BYTES);
+  if (NULL == pWorker->cxt.msg.buf || NULL == pWorker->tableCxt.pValues || NULL == pWorker->data.aRowP) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static void destroyCsvParseWorker(SCsvParseWorker* pWorker) {
+  taosMemoryFree(pWorker->cxt.msg.buf);
+  taosArrayDestroy(pWorker->tableCxt.pValues);
+  taosArrayDestroyP(pWorker->data.aRowP, (FDelete)tRowDestroy);
+}
+
+// the lines are divided into continuous ranges, and the rows built by the workers are appended in the order of lines
+static int32_t parseCsvLinesInParallel(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, char** pLines,
+                                       int32_t numOfLines, int32_t numOfWorkers, int32_t* pNumOfRows) {
+  SCsvParseWorker* pWorkers = taosMemoryCalloc(numOfWorkers, sizeof(SCsvParseWorker));
+  TdThread*        pThreads = taosMemoryCalloc(numOfWorkers, sizeof(TdThread));
+  bool*            pStarted = taosMemoryCalloc(numOfWorkers, sizeof(bool));
+  if (NULL == pWorkers || NULL == pThreads || NULL == pStarted) {
+    taosMemoryFree(pWorkers);
+    taosMemoryFree(pThreads);
+    taosMemoryFree(pStarted);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t linesPerWorker = (numOfLines + numOfWorkers - 1) / numOfWorkers;
+  for (int32_t i = 0; i < numOfWorkers && TSDB_CODE_SUCCESS == code; ++i) {
+    SCsvParseWorker* pWorker = &pWorkers[i];
+    pWorker->pLines = pLines + i * linesPerWorker;
+    pWorker->numOfLines = TMIN(linesPerWorker, numOfLines - i * linesPerWorker);
+    code = initCsvParseWorker(pCxt, pTableCxt, pWorker);
+  }
+
+  // the calling thread takes the first range, and a range is parsed in place if its thread fails to start
+  for (int32_t i = 1; i < numOfWorkers && TSDB_CODE_SUCCESS == code; ++i) {
+    pStarted[i] = (taosThreadCreate(&pThreads[i], NULL, parseCsvLinesThreadFp, &pWorkers[i]) == 0);
+    if (!pStarted[i]) {
+      parserWarn("0x%" PRIx64 " failed to start csv parse thread since %s", pCxt->pComCxt->requestId, strerror(errno));
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    for (int32_t i = 0; i < numOfWorkers; ++i) {
+      if (!pStarted[i]) {
+        parseCsvLinesWorker(&pWorkers[i]);
       }
     }
+  }
+  for (int32_t i = 1; i < numOfWorkers; ++i) {
+    if (pStarted[i]) {
+      taosThreadJoin(pThreads[i], NULL);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfWorkers && TSDB_CODE_SUCCESS == code; ++i) {
+    SCsvParseWorker* pWorker = &pWorkers[i];
+    SArray*          aRowP = pWorker->data.aRowP;
+    int32_t          numOfRows = taosArrayGetSize(aRowP);
+    if (numOfRows > 0 && NULL == taosArrayAddAll(pTableCxt->pData->aRowP, aRowP)) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+    // the rows are owned by the table data now
+    taosArrayClear(aRowP);
+
+    int32_t start = taosArrayGetSize(pTableCxt->pData->aRowP) - numOfRows;
+    for (int32_t j = 0; j < numOfRows; ++j) {
+      SRowKey key;
+      tRowGetKey(*(SRow**)taosArrayGet(pTableCxt->pData->aRowP, start + j), &key);
+      insCheckTableDataOrder(pTableCxt, &key);
+    }
+    (*pNumOfRows) += pWorker->numOfRows;
+
+    if (TSDB_CODE_SUCCESS != pWorker->code) {
+      code = pWorker->code;
+      tstrncpy(pCxt->msg.buf, pWorker->cxt.msg.buf, pCxt->msg.len);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfWorkers; ++i) {
+    destroyCsvParseWorker(&pWorkers[i]);
+  }
+  taosMemoryFree(pWorkers);
+  taosMemoryFree(pThreads);
+  taosMemoryFree(pStarted);
+  return code;
+}
+
+static int32_t parseCsvLines(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                             char** pLines, int32_t numOfLines, bool* pFirstLine, int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t i = 0;
+
+  // the first line of the file is skipped if it can not be parsed, which may be the header of the columns
+  if (*pFirstLine) {
+    bool gotRow = false;
+    code = parseCsvLine(pCxt, pStmt, rowsDataCxt, pLines[i++], &gotRow);
+    if (TSDB_CODE_SUCCESS != code) {
+      code = TSDB_CODE_SUCCESS;
+    } else if (gotRow) {
+      (*pNumOfRows)++;
+    }
+    *pFirstLine = false;
+  }
+
+  int32_t numOfWorkers = getNumOfCsvParseWorkers(pStmt, rowsDataCxt, numOfLines - i);
+  if (numOfWorkers > 1) {
+    return parseCsvLinesInParallel(pCxt, rowsDataCxt.pTableDataCxt, pLines + i, numOfLines - i, numOfWorkers,
+                                   pNumOfRows);
+  }
 
+  for (; i < numOfLines && TSDB_CODE_SUCCESS == code; ++i) {
+    bool gotRow = false;
+    code = parseCsvLine(pCxt, pStmt, rowsDataCxt, pLines[i], &gotRow);
     if (TSDB_CODE_SUCCESS == code && gotRow) {
       (*pNumOfRows)++;
     }
+  }
+  return code;
+}
 
+static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                            int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  (*pNumOfRows) = 0;
+  bool    firstLine = (pStmt->fileProcessing == false);
+  pStmt->fileProcessing = false;
+  int64_t st = taosGetTimestampUs();
+
+  SCsvReader reader = {.fp = pStmt->fp, .cap = CSV_READ_BLOCK_SIZE};
+  reader.offset = taosLSeekFile(pStmt->fp, 0, SEEK_CUR);
+  reader.pBuf = taosMemoryMalloc(reader.cap + 1);
+  char** pLines = taosMemoryMalloc(CSV_LINES_PER_ROUND * POINTER_BYTES);
+  if (reader.offset < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  } else if (NULL == reader.pBuf || NULL == pLines) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  while (TSDB_CODE_SUCCESS == code) {
+    int32_t maxLines = TMIN(CSV_LINES_PER_ROUND, tsMaxInsertBatchRows - (*pNumOfRows));
+    int32_t numOfLines = csvReaderSplitLines(&reader, pLines, maxLines, &firstLine);
+    if (0 == numOfLines) {
+      if (reader.eof) {
+        break;
+      }
+      code = csvReaderFill(&reader);
+      continue;
+    }
+
+    code = parseCsvLines(pCxt, pStmt, rowsDataCxt, pLines, numOfLines, &firstLine, pNumOfRows);
     if (TSDB_CODE_SUCCESS == code && (*pNumOfRows) >= tsMaxInsertBatchRows) {
-      pStmt->fileProcessing = true;
+      // the next batch starts from the first line not parsed
+      if (taosLSeekFile(pStmt->fp, reader.offset + reader.pos, SEEK_SET) < 0) {
+        code = TAOS_SYSTEM_ERROR(errno);
+      } else {
+        pStmt->fileProcessing = true;
+      }
       break;
     }
-
-    firstLine = false;
   }
-  taosMemoryFree(pLine);
+  taosMemoryFree(reader.pBuf);
+  taosMemoryFree(pLines);
 
-  parserDebug("0x%" PRIx64 " %d rows have been parsed", pCxt->pComCxt->requestId, *pNumOfRows);
+  int64_t elapsed = TMAX(1, taosGetTimestampUs() - st);
+  parserInfo("0x%" PRIx64 " %d rows have been parsed from csv in %" PRId64 "us, %.0f rows/s, file offset:%" PRId64
+             ", total rows:%d",
+             pCxt->pComCxt->requestId, *pNumOfRows, elapsed, (*pNumOfRows) * 1000000.0 / elapsed,
+             reader.offset + reader.pos, pStmt->totalRowsNum + (*pNumOfRows));
 
   if (TSDB_CODE_SUCCESS == code && 0 == (*pNumOfRows) && 0 == pStmt->totalRowsNum &&
       (!TSDB_QUERY_HAS_TYPE(pStmt->insertType, TSDB_QUERY_TYPE_STMT_INSERT)) && !pStmt->fileProcessing) {
@@ -2209,7 +2470,7 @@ static int32_t parseDataFromFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   } else {
     strncpy(filePathStr, pFilePath->z, pFilePath->n);
   }
-  pStmt->fp = taosOpenFile(filePathStr, TD_FILE_READ | TD_FILE_STREAM);
+  pStmt->fp = taosOpenFile(filePathStr, TD_FILE_READ);
   if (NULL == pStmt->fp) {
     return TAOS_SYSTEM_ERROR(errno);
   }
@@ -2358,10 +2358,16 @@ static int32_t translateRepeatScanFunc(STranslateContext* pCxt, SFunctionNode* p
   }
   SSelectStmt* pSelect = (SSelectStmt*)pCxt->pCurrStmt;
   SNode*       pTable = pSelect->pFromTable;
+  // the one split into partial and merge functions is also valid for a super table, with a single group
+  bool isDistSuperTable = NULL != pTable && QUERY_NODE_REAL_TABLE == nodeType(pTable) &&
+                          TSDB_SUPER_TABLE == ((SRealTableNode*)pTable)->pMeta->tableType &&
+                          fmIsDistExecFunc(pFunc->funcId) && NULL == pSelect->pGroupByList &&
+                          NULL == pSelect->pWindow;
   // select percentile() without from clause is also valid
-  if ((NULL != pTable && (QUERY_NODE_REAL_TABLE != nodeType(pTable) ||
-                          (TSDB_CHILD_TABLE != ((SRealTableNode*)pTable)->pMeta->tableType &&
-                           TSDB_NORMAL_TABLE != ((SRealTableNode*)pTable)->pMeta->tableType)))) {
+  if ((NULL != pTable && !isDistSuperTable &&
+       (QUERY_NODE_REAL_TABLE != nodeType(pTable) ||
+        (TSDB_CHILD_TABLE != ((SRealTableNode*)pTable)->pMeta->tableType &&
+         TSDB_NORMAL_TABLE != ((SRealTableNode*)pTable)->pMeta->tableType)))) {
     return generateSyntaxErrMsgExt(&pCxt->msgBuf, TSDB_CODE_PAR_ONLY_SUPPORT_SINGLE_TABLE,
                                    "%s is only supported in single table query", pFunc->functionName);
   }
@@ -3387,6 +3393,40 @@ static int32_t checkAggColCoexist(STranslateContext* pCxt, SSelectStmt* pSelect)
   return TSDB_CODE_SUCCESS;
 }
 
+static EDealRes searchNonDistAggFuncNode(SNode* pNode, void* pContext) {
+  if (QUERY_NODE_FUNCTION == nodeType(pNode)) {
+    SFunctionNode* pFunc = (SFunctionNode*)pNode;
+    if (fmIsAggFunc(pFunc->funcId) && !fmIsDistExecFunc(pFunc->funcId)) {
+      *(SFunctionNode**)pContext = pFunc;
+      return DEAL_RES_END;
+    }
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+// the rows of a super table are only scanned repeatedly in the vgroups when all the agg functions are split
+static int32_t checkRepeatScanFuncOfSuperTable(STranslateContext* pCxt, SSelectStmt* pSelect) {
+  SNode* pTable = pSelect->pFromTable;
+  if (!pSelect->hasRepeatScanFuncs || NULL == pTable || QUERY_NODE_REAL_TABLE != nodeType(pTable) ||
+      TSDB_SUPER_TABLE != ((SRealTableNode*)pTable)->pMeta->tableType) {
+    return TSDB_CODE_SUCCESS;
+  }
+  SFunctionNode* pFunc = NULL;
+  nodesWalkExprs(pSelect->pProjectionList, searchNonDistAggFuncNode, &pFunc);
+  if (NULL == pFunc) {
+    nodesWalkExpr(pSelect->pHaving, searchNonDistAggFuncNode, &pFunc);
+  }
+  if (NULL == pFunc) {
+    nodesWalkExprs(pSelect->pOrderByList, searchNonDistAggFuncNode, &pFunc);
+  }
+  if (NULL != pFunc) {
+    return generateSyntaxErrMsgExt(&pCxt->msgBuf, TSDB_CODE_PAR_NOT_ALLOWED_FUNC,
+                                   "%s function is not supported with percentile in super table query",
+                                   pFunc->functionName);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t checkWinJoinAggColCoexist(STranslateContext* pCxt, SSelectStmt* pSelect) {
   if (!isWindowJoinStmt(pSelect) ||
       (!pSelect->hasAggFuncs && !pSelect->hasIndefiniteRowsFunc && !pSelect->hasInterpFunc)) {
@@ -6143,6 +6183,9 @@ static int32_t translateSelectFrom(STranslateContext* pCxt, SSelectStmt* pSelect
     resetSelectFuncNumWithoutDup(pSelect);
     code = checkAggColCoexist(pCxt, pSelect);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = checkRepeatScanFuncOfSuperTable(pCxt, pSelect);
+  }
   /*
     if (TSDB_CODE_SUCCESS == code) {
       code = checkWinJoinAggColCoexist(pCxt, pSelect);
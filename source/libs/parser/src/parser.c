@@ -48,6 +48,29 @@ bool qIsInsertValuesSql(const char* pStr, size_t length) {
   return false;
 }
 
+// the table name of the insert statement is in placeholder, as 'INSERT INTO ? ...'
+bool qIsInsertTbNameInPlaceholder(const char* pStr, size_t length) {
+  if (NULL == pStr) {
+    return false;
+  }
+
+  const char* pSql = pStr;
+  int32_t     expect[] = {TK_INSERT, TK_INTO, TK_NK_QUESTION};
+  for (int32_t i = 0; i < tListLen(expect); ++i) {
+    if (pStr - pSql >= length) {
+      return false;
+    }
+
+    int32_t index = 0;
+    SToken  t = tStrGetToken((char*)pStr, &index, false, NULL);
+    if (expect[i] != t.type && !(TK_INSERT == expect[i] && TK_IMPORT == t.type)) {
+      return false;
+    }
+    pStr += index;
+  }
+  return true;
+}
+
 static int32_t analyseSemantic(SParseContext* pCxt, SQuery* pQuery, SParseMetaCache* pMetaCache) {
   int32_t code = authenticate(pCxt, pQuery, pMetaCache);
 
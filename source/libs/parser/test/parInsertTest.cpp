@@ -15,8 +15,15 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+
 #include "parTestUtil.h"
 
+extern "C" {
+#include "parInsertUtil.h"
+}
+#include "parser.h"
+
 using namespace std;
 
 namespace ParserTest {
@@ -64,6 +71,105 @@ TEST_F(ParserInsertTest, multiTableMultiRowTest) {
       "st1s2 VALUES (now, 10, '131028')(now+1s, 20, '132028')");
 }
 
+// INSERT INTO tb_name FILE csv_file_path
+TEST_F(ParserInsertTest, singleTableCsvFileTest) {
+  useDb("root", "test");
+
+  auto writeCsv = [](const string& path, int32_t numOfRows, const char* lineBreak) {
+    TdFilePtr pFile = taosOpenFile(path.c_str(), TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+    ASSERT_NE(pFile, nullptr);
+    string header = string("ts,c1,c2,c3,c4,c5") + lineBreak + lineBreak;
+    ASSERT_EQ(taosWriteFile(pFile, header.c_str(), header.size()), header.size());
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      char    line[128] = {0};
+      int32_t len = snprintf(line, sizeof(line), "%" PRId64 ",%d,'beijing',%d,%d.5,%d%s", 1700000000000 + i, i, i, i, i,
+                             (i == numOfRows - 1) ? "" : lineBreak);
+      ASSERT_EQ(taosWriteFile(pFile, line, len), len);
+    }
+    taosCloseFile(&pFile);
+  };
+
+  // parse the file batch by batch as the client does, the rows of each batch are checked against the lines of the file
+  auto checkCsv = [](const string& sql, int32_t numOfRows, const vector<int32_t>& batchRows) {
+    string            sqlBuf(sql);
+    array<char, 1024> msgBuf = {0};
+    SParseContext     cxt = {0};
+    cxt.acctId = 0;
+    cxt.db = "test";
+    cxt.pUser = "root";
+    cxt.isSuperUser = true;
+    cxt.enableSysInfo = true;
+    cxt.pSql = sqlBuf.c_str();
+    cxt.sqlLen = sqlBuf.length();
+    cxt.pMsg = msgBuf.data();
+    cxt.msgLen = msgBuf.max_size();
+    cxt.svrVer = "3.0.0.0";
+
+    SQuery*         pQuery = NULL;
+    STSchema*       pTSchema = NULL;
+    vector<int32_t> actualBatchRows;
+    int32_t         nextRow = 0;
+    do {
+      ASSERT_EQ(qParseSql(&cxt, &pQuery), TSDB_CODE_SUCCESS) << msgBuf.data();
+      SVnodeModifyOpStmt* pStmt = (SVnodeModifyOpStmt*)pQuery->pRoot;
+      if (NULL == pTSchema) {
+        pTSchema = tBuildTSchema(pStmt->pTableMeta->schema, pStmt->pTableMeta->tableInfo.numOfColumns,
+                                 pStmt->pTableMeta->sversion);
+        ASSERT_NE(pTSchema, nullptr);
+      }
+
+      int32_t rows = 0;
+      for (int32_t i = 0; i < taosArrayGetSize(pStmt->pVgDataBlocks); ++i) {
+        SVgroupDataCxt* pVgCxt = (SVgroupDataCxt*)taosArrayGetP(pStmt->pVgDataBlocks, i);
+        ASSERT_EQ(taosArrayGetSize(pVgCxt->pData->aSubmitTbData), 1);
+        SSubmitTbData* pTbData = (SSubmitTbData*)taosArrayGet(pVgCxt->pData->aSubmitTbData, 0);
+        for (int32_t j = 0; j < taosArrayGetSize(pTbData->aRowP); ++j, ++rows, ++nextRow) {
+          SRow*   pRow = (SRow*)taosArrayGetP(pTbData->aRowP, j);
+          SColVal cv;
+          ASSERT_EQ(pRow->ts, 1700000000000 + nextRow);
+          ASSERT_EQ(tRowGet(pRow, pTSchema, 1, &cv), TSDB_CODE_SUCCESS);
+          ASSERT_EQ((int32_t)cv.value.val, nextRow);
+        }
+      }
+      actualBatchRows.push_back(rows);
+    } while (((SVnodeModifyOpStmt*)pQuery->pRoot)->fileProcessing);
+
+    ASSERT_EQ(nextRow, numOfRows);
+    ASSERT_EQ(((SVnodeModifyOpStmt*)pQuery->pRoot)->totalRowsNum, numOfRows);
+    ASSERT_EQ(actualBatchRows, batchRows);
+    taosMemoryFree(pTSchema);
+    qDestroyQuery(pQuery);
+  };
+
+  taosMulMkDir(TD_TMP_DIR_PATH);
+  string path = string(TD_TMP_DIR_PATH) + "parInsertTest.csv";
+  string sql = "INSERT INTO t1 FILE '" + path + "'";
+
+  // the lines of a small file are parsed by the calling thread
+  writeCsv(path, 10, "\n");
+  run(sql);
+  checkCsv(sql, 10, {10});
+
+  // the lines of a large file are parsed by several threads
+  writeCsv(path, 50000, "\r\n");
+  run(sql);
+  checkCsv(sql, 50000, {50000});
+
+  // a file beyond the rows of a batch is inserted in several batches, each one starts from the first line not parsed
+  int32_t maxInsertBatchRows = tsMaxInsertBatchRows;
+  tsMaxInsertBatchRows = 20000;
+  checkCsv(sql, 50000, {20000, 20000, 10000});
+  tsMaxInsertBatchRows = 7;
+  writeCsv(path, 10, "\n");
+  checkCsv(sql, 10, {7, 3});
+  // the last batch ends at the end of the file, and the one after it has nothing to insert
+  tsMaxInsertBatchRows = 5;
+  checkCsv(sql, 10, {5, 5, 0});
+  tsMaxInsertBatchRows = maxInsertBatchRows;
+
+  taosRemoveFile(path.c_str());
+}
+
 // INSERT INTO
 //    tb1_name USING st1_name [(tag1_name, ...)] TAGS (tag1_value, ...) VALUES (field1_value, ...)
 //    tb2_name USING st2_name [(tag1_name, ...)] TAGS (tag1_value, ...) VALUES (field1_value, ...)
@@ -84,4 +190,20 @@ TEST_F(ParserInsertTest, autoCreateTableTest) {
       "st1s2 (ts, c1, c2) USING st1 TAGS(2, 'abc', now) VALUES (now+1s, 2, 'shanghai')");
 }
 
+// INSERT INTO ? ..., the statement binds the rows of many tables
+TEST_F(ParserInsertTest, tbNameInPlaceholderTest) {
+  auto check = [](const string& sql) { return qIsInsertTbNameInPlaceholder(sql.c_str(), sql.length()); };
+
+  ASSERT_TRUE(check("INSERT INTO ? VALUES (?, ?)"));
+  ASSERT_TRUE(check("insert into ? using st1 tags(?, ?) values(?, ?)"));
+  ASSERT_TRUE(check("  IMPORT\n INTO\t? VALUES (?, ?)"));
+
+  ASSERT_FALSE(check("INSERT INTO t1 VALUES (?, ?)"));
+  ASSERT_FALSE(check("INSERT INTO st1s1 USING st1 TAGS(?) VALUES (?, ?)"));
+  ASSERT_FALSE(check("SELECT * FROM t1 WHERE c1 = ?"));
+  ASSERT_FALSE(check("INSERT INTO"));
+  ASSERT_FALSE(qIsInsertTbNameInPlaceholder("INSERT INTO ? VALUES (?, ?)", strlen("INSERT INTO")));
+  ASSERT_FALSE(qIsInsertTbNameInPlaceholder(NULL, 0));
+}
+
 }  // namespace ParserTest
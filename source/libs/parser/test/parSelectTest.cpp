@@ -95,6 +95,28 @@ TEST_F(ParserSelectTest, aggFunc) {
   run("SELECT LEASTSQUARES(c1, -1, 1) FROM t1");
 }
 
+TEST_F(ParserSelectTest, percentileFunc) {
+  useDb("root", "test");
+
+  run("SELECT PERCENTILE(c1, 50) FROM t1 GROUP BY c2");
+
+  run("SELECT PERCENTILE(c1, 50) FROM st1");
+
+  run("SELECT PERCENTILE(c1, 10, 90), COUNT(*) FROM st1 WHERE tag1 > 0");
+}
+
+TEST_F(ParserSelectTest, percentileFuncSemanticCheck) {
+  useDb("root", "test");
+
+  run("SELECT PERCENTILE(c1, 50) FROM st1 GROUP BY tag1", TSDB_CODE_PAR_ONLY_SUPPORT_SINGLE_TABLE);
+
+  run("SELECT PERCENTILE(c1, 50) FROM st1 INTERVAL(10s)", TSDB_CODE_PAR_ONLY_SUPPORT_SINGLE_TABLE);
+
+  run("SELECT PERCENTILE(c1, 50) FROM st1 PARTITION BY tag1", TSDB_CODE_PAR_NOT_ALLOWED_FUNC);
+
+  run("SELECT PERCENTILE(c1, 50), LEASTSQUARES(c1, -1, 1) FROM st1", TSDB_CODE_PAR_NOT_ALLOWED_FUNC);
+}
+
 TEST_F(ParserSelectTest, multiResFunc) {
   useDb("root", "test");
 
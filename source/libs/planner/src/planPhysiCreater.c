@@ -624,6 +624,19 @@ static int32_t createTableCountScanPhysiNode(SPhysiPlanContext* pCxt, SSubplan*
   return createScanPhysiNodeFinalize(pCxt, pSubplan, pScanLogicNode, (SScanPhysiNode*)pScan, pPhyNode);
 }
 
+// The tables of a vnode may be read by several readers concurrently only if nobody cares about the order of the
+// output rows beyond a single block, and all the rows belong to the same group.
+static int8_t getTableScanParallelism(SPhysiPlanContext* pCxt, SScanLogicNode* pScanLogicNode) {
+  if (tsQueryScanParallelism <= 1 || pCxt->pPlanCxt->streamQuery || pCxt->pPlanCxt->rSmaQuery ||
+      SCAN_TYPE_TABLE != pScanLogicNode->scanType || TSDB_SUPER_TABLE != pScanLogicNode->tableType ||
+      pScanLogicNode->node.resultDataOrder > DATA_ORDER_LEVEL_IN_BLOCK || NULL != pScanLogicNode->pGroupTags ||
+      pScanLogicNode->groupSort || pScanLogicNode->isCountByTag || 1 != pScanLogicNode->scanSeq[0] ||
+      0 != pScanLogicNode->scanSeq[1]) {
+    return 1;
+  }
+  return (int8_t)tsQueryScanParallelism;
+}
+
 static int32_t createTableScanPhysiNode(SPhysiPlanContext* pCxt, SSubplan* pSubplan, SScanLogicNode* pScanLogicNode,
                                         SPhysiNode** pPhyNode) {
   STableScanPhysiNode* pTableScan = (STableScanPhysiNode*)makePhysiNode(pCxt, (SLogicNode*)pScanLogicNode,
@@ -663,6 +676,7 @@ static int32_t createTableScanPhysiNode(SPhysiPlanContext* pCxt, SSubplan* pSubp
   pTableScan->needCountEmptyTable = pScanLogicNode->isCountByTag;
   pTableScan->paraTablesSort = pScanLogicNode->paraTablesSort;
   pTableScan->smallDataTsSort = pScanLogicNode->smallDataTsSort;
+  pTableScan->scanParallelism = getTableScanParallelism(pCxt, pScanLogicNode);
 
   int32_t code = createScanPhysiNodeFinalize(pCxt, pSubplan, pScanLogicNode, (SScanPhysiNode*)pTableScan, pPhyNode);
   if (TSDB_CODE_SUCCESS == code) {
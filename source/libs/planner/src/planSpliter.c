@@ -994,6 +994,20 @@ static int32_t stbSplSplitWindowNode(SSplitContext* pCxt, SStableSplitInfo* pInf
   }
 }
 
+// the partial functions of the repeat scan functions, e.g. percentile, only need the rows once
+static void stbSplResetRepeatScan(SAggLogicNode* pPartAgg) {
+  SNode* pFunc = NULL;
+  FOREACH(pFunc, pPartAgg->pAggFuncs) {
+    if (fmIsRepeatScanFunc(((SFunctionNode*)pFunc)->funcId)) {
+      return;
+    }
+  }
+  SNode* pChild = nodesListGetNode(pPartAgg->node.pChildren, 0);
+  if (NULL != pChild && QUERY_NODE_LOGIC_PLAN_SCAN == nodeType(pChild) && ((SScanLogicNode*)pChild)->scanSeq[0] > 1) {
+    ((SScanLogicNode*)pChild)->scanSeq[0] = 1;
+  }
+}
+
 static int32_t stbSplCreatePartAggNode(SAggLogicNode* pMergeAgg, SLogicNode** pOutput) {
   SNodeList* pFunc = pMergeAgg->pAggFuncs;
   pMergeAgg->pAggFuncs = NULL;
@@ -1039,6 +1053,7 @@ static int32_t stbSplCreatePartAggNode(SAggLogicNode* pMergeAgg, SLogicNode** pO
 
   nodesDestroyList(pFunc);
   if (TSDB_CODE_SUCCESS == code) {
+    stbSplResetRepeatScan(pPartAgg);
     *pOutput = (SLogicNode*)pPartAgg;
   } else {
     nodesDestroyNode((SNode*)pPartAgg);
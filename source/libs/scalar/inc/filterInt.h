@@ -23,6 +23,7 @@ extern "C" {
 #include "query.h"
 #include "querynodes.h"
 #include "scalar.h"
+#include "sclInt.h"
 #include "tcommon.h"
 #include "tdatablock.h"
 #include "thash.h"
@@ -267,6 +268,7 @@ struct SFilterInfo {
   int8_t           *blkUnitRes;
   void             *pTable;
   SArray           *blkList;
+  SSclScratch       scratch;  // for the match/nmatch of nchar
 
   SFilterPCtx pctx;
 };
@@ -274,6 +276,8 @@ struct SFilterInfo {
 #define FILTER_NO_MERGE_DATA_TYPE(t)                                                            \
   ((t) == TSDB_DATA_TYPE_BINARY || (t) == TSDB_DATA_TYPE_VARBINARY || (t) == TSDB_DATA_TYPE_NCHAR || (t) == TSDB_DATA_TYPE_JSON || \
    (t) == TSDB_DATA_TYPE_GEOMETRY)
+#define FILTER_NCHAR_MATCH_UNIT(c) \
+  ((c)->dataType == TSDB_DATA_TYPE_NCHAR && ((c)->optr == OP_TYPE_MATCH || (c)->optr == OP_TYPE_NMATCH))
 #define FILTER_NO_MERGE_OPTR(o) ((o) == OP_TYPE_IS_NULL || (o) == OP_TYPE_IS_NOT_NULL || (o) == FILTER_DUMMY_EMPTY_OPTR)
 
 #define MR_EMPTY_RES(ctx) (ctx->rs == NULL)
@@ -496,6 +500,12 @@ struct SFilterInfo {
 extern bool          filterDoCompare(__compar_fn_t func, uint8_t optr, void *left, void *right);
 extern __compar_fn_t filterGetCompFunc(int32_t type, int32_t optr);
 extern __compar_fn_t filterGetCompFuncEx(int32_t lType, int32_t rType, int32_t optr);
+extern rangeCompFunc gRangeCompare[];
+
+// column at a time kernels, return the number of qualified rows, or -1 if the filter is not supported by the kernels
+extern int32_t filterExecuteByKernel(SFilterInfo *info, int32_t numOfRows, int8_t *p);
+extern int32_t filterRangeKernel(SColumnInfoData *pCol, int32_t numOfRows, int8_t rfunc, const void *minr,
+                                 const void *maxr, int8_t *p);
 
 #ifdef __cplusplus
 }
@@ -95,6 +95,16 @@ int32_t sclConvertToTsValueNode(int8_t precision, SValueNode* valueNode);
 #define GET_PARAM_PRECISON(_c) ((_c)->columnData->info.precision)
 
 void sclFreeParam(SScalarParam* param);
+
+// a buffer reused by the rows of one operator, instead of a malloc for each row
+typedef struct SSclScratch {
+  char*   buf;
+  int32_t size;
+} SSclScratch;
+
+char* sclScratchGet(SSclScratch* pScratch, int32_t size);
+void  sclScratchFree(SSclScratch* pScratch);
+
 void doVectorCompare(SScalarParam* pLeft, SScalarParam* pRight, SScalarParam *pOut, int32_t startIndex, int32_t numOfRows, 
                      int32_t _ord, int32_t optr);
 void vectorCompareImpl(SScalarParam* pLeft, SScalarParam* pRight, SScalarParam *pOut, int32_t startIndex, int32_t numOfRows, 
@@ -1890,6 +1890,7 @@ void filterFreeInfo(SFilterInfo *info) {
 
   taosMemoryFreeClear(info->cunits);
   taosMemoryFreeClear(info->blkUnitRes);
+  sclScratchFree(&info->scratch);
   taosMemoryFreeClear(info->blkUnits);
 
   for (int32_t i = 0; i < FLD_TYPE_MAX; ++i) {
@@ -3176,6 +3177,12 @@ bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRe
 
   int8_t *p = (int8_t *)pRes->pData;
 
+  int32_t num = filterExecuteByKernel(info, numOfRows, p);
+  if (num >= 0) {
+    *numOfQualified += num;
+    return num == numOfRows;
+  }
+
   for (int32_t i = 0; i < numOfRows; ++i) {
     SColumnInfoData *pData = info->cunits[0].colData;
 
@@ -3198,6 +3205,23 @@ bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRe
   return all;
 }
 
+// match/nmatch for nchar type need convert from ucs4 to mbs, the buffer is shared by all the rows
+static bool filterDoCompareNcharMatch(SFilterInfo *info, SFilterComUnit *cunit, void *colData) {
+  char *newColData = sclScratchGet(&info->scratch, cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE);
+  if (newColData == NULL) {
+    return false;
+  }
+
+  int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
+  if (len < 0) {
+    qError("castConvert1 taosUcs4ToMbs error");
+    return false;
+  }
+
+  varDataSetLen(newColData, len);
+  return filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
+}
+
 bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
                            int16_t numOfCols, int32_t *numOfQualified) {
   SFilterInfo *info = (SFilterInfo *)pinfo;
@@ -3218,19 +3242,8 @@ bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes
     }
 
     void *colData = colDataGetData((SColumnInfoData *)info->cunits[uidx].colData, i);
-    // match/nmatch for nchar type need convert from ucs4 to mbs
-    if (info->cunits[uidx].dataType == TSDB_DATA_TYPE_NCHAR &&
-        (info->cunits[uidx].optr == OP_TYPE_MATCH || info->cunits[uidx].optr == OP_TYPE_NMATCH)) {
-      char   *newColData = taosMemoryCalloc(info->cunits[uidx].dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
-      int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
-      if (len < 0) {
-        qError("castConvert1 taosUcs4ToMbs error");
-      } else {
-        varDataSetLen(newColData, len);
-        p[i] = filterDoCompare(gDataCompare[info->cunits[uidx].func], info->cunits[uidx].optr, newColData,
-                               info->cunits[uidx].valData);
-      }
-      taosMemoryFreeClear(newColData);
+    if (FILTER_NCHAR_MATCH_UNIT(&info->cunits[uidx])) {
+      p[i] = filterDoCompareNcharMatch(info, &info->cunits[uidx], colData);
     } else {
       p[i] = filterDoCompare(gDataCompare[info->cunits[uidx].func], info->cunits[uidx].optr, colData,
                              info->cunits[uidx].valData);
@@ -3257,6 +3270,12 @@ bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SC
 
   int8_t *p = (int8_t *)pRes->pData;
 
+  int32_t num = filterExecuteByKernel(info, numOfRows, p);
+  if (num >= 0) {
+    *numOfQualified += num;
+    return num == numOfRows;
+  }
+
   for (int32_t i = 0; i < numOfRows; ++i) {
     // FILTER_UNIT_CLR_F(info);
 
@@ -3287,17 +3306,8 @@ bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SC
             p[i] = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2,
                                                   gDataCompare[cunit->func]);
           } else {
-            if (cunit->dataType == TSDB_DATA_TYPE_NCHAR &&
-                (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
-              char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
-              int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
-              if (len < 0) {
-                qError("castConvert1 taosUcs4ToMbs error");
-              } else {
-                varDataSetLen(newColData, len);
-                p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
-              }
-              taosMemoryFreeClear(newColData);
+            if (FILTER_NCHAR_MATCH_UNIT(cunit)) {
+              p[i] = filterDoCompareNcharMatch(info, cunit, colData);
             } else {
               p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
             }
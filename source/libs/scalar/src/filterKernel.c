@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filterInt.h"
+#include "tcompare.h"
+
+// Column at a time kernels of the range units (>, >=, <, <=, and the two side ranges) and the null tests on fixed
+// length columns. The result of each row is written as 0/1 into the int8 result column, the nulls are cleared with
+// the null bitmap afterwards, which is skipped a word at a time. The generic row at a time paths in filter.c are
+// still taken for the other types and operators.
+//
+// Integer bounds are turned into a closed range [lo, hi] in the signed order, unsigned values are moved into it by
+// flipping the sign bit. Float and double bounds keep the tolerance of compareFloatVal/compareDoubleVal: with
+// d = v - bound, v > bound iff d > eps, v >= bound iff d >= -eps, where nan and inf - inf sort as the smallest.
+
+typedef struct {
+  int8_t   type;
+  int8_t   bytes;
+  bool     empty;
+  bool     hasLo;
+  bool     hasHi;
+  uint64_t bias;  // sign bit of the unsigned types
+  int64_t  lo;
+  int64_t  hi;
+  double   dlo;
+  double   dhi;
+  double   tlo;  // v - dlo > tlo
+  double   thi;  // !(v - dhi > thi)
+} SFltRangeCtx;
+
+enum { FLT_BOUND_NONE = 0, FLT_BOUND_EXCL, FLT_BOUND_INCL };
+
+// bounds of each range function in gRangeCompare, which compares the value with minr and maxr
+static const int8_t fltRangeLoBound[] = {FLT_BOUND_EXCL, FLT_BOUND_EXCL, FLT_BOUND_INCL, FLT_BOUND_INCL,
+                                         FLT_BOUND_EXCL, FLT_BOUND_INCL, FLT_BOUND_NONE, FLT_BOUND_NONE};
+static const int8_t fltRangeHiBound[] = {FLT_BOUND_EXCL, FLT_BOUND_INCL, FLT_BOUND_EXCL, FLT_BOUND_INCL,
+                                         FLT_BOUND_NONE, FLT_BOUND_NONE, FLT_BOUND_EXCL, FLT_BOUND_INCL};
+
+static bool fltRangeIntPrepare(SFltRangeCtx *ctx, int8_t loBound, int8_t hiBound, int64_t a, int64_t b) {
+  int64_t smax = (ctx->bytes == 8) ? INT64_MAX : (((int64_t)1 << (ctx->bytes * 8 - 1)) - 1);
+  int64_t smin = -smax - 1;
+
+  ctx->lo = smin;
+  if (loBound == FLT_BOUND_EXCL) {
+    if (a == smax) ctx->empty = true;
+    ctx->lo = a + (ctx->empty ? 0 : 1);
+  } else if (loBound == FLT_BOUND_INCL) {
+    ctx->lo = a;
+  }
+
+  ctx->hi = smax;
+  if (hiBound == FLT_BOUND_EXCL) {
+    if (b == smin) ctx->empty = true;
+    ctx->hi = b - (ctx->empty ? 0 : 1);
+  } else if (hiBound == FLT_BOUND_INCL) {
+    ctx->hi = b;
+  }
+
+  if (ctx->lo > ctx->hi) ctx->empty = true;
+  return true;
+}
+
+static bool fltRangePrepare(SFltRangeCtx *ctx, int32_t type, int8_t rfunc, const void *minr, const void *maxr) {
+  if (rfunc < 0 || rfunc >= tListLen(fltRangeLoBound)) return false;
+
+  int8_t loBound = fltRangeLoBound[rfunc];
+  int8_t hiBound = fltRangeHiBound[rfunc];
+
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->type = type;
+  ctx->hasLo = (loBound != FLT_BOUND_NONE);
+  ctx->hasHi = (hiBound != FLT_BOUND_NONE);
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      ctx->bytes = 1;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, *(int8_t *)minr, *(int8_t *)maxr);
+    case TSDB_DATA_TYPE_SMALLINT:
+      ctx->bytes = 2;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, *(int16_t *)minr, *(int16_t *)maxr);
+    case TSDB_DATA_TYPE_INT:
+      ctx->bytes = 4;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, *(int32_t *)minr, *(int32_t *)maxr);
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      ctx->bytes = 8;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, *(int64_t *)minr, *(int64_t *)maxr);
+    case TSDB_DATA_TYPE_UTINYINT:
+      ctx->bytes = 1;
+      ctx->bias = 0x80;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, (int8_t)(*(uint8_t *)minr ^ 0x80),
+                                (int8_t)(*(uint8_t *)maxr ^ 0x80));
+    case TSDB_DATA_TYPE_USMALLINT:
+      ctx->bytes = 2;
+      ctx->bias = 0x8000;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, (int16_t)(*(uint16_t *)minr ^ 0x8000),
+                                (int16_t)(*(uint16_t *)maxr ^ 0x8000));
+    case TSDB_DATA_TYPE_UINT:
+      ctx->bytes = 4;
+      ctx->bias = 0x80000000;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, (int32_t)(*(uint32_t *)minr ^ 0x80000000u),
+                                (int32_t)(*(uint32_t *)maxr ^ 0x80000000u));
+    case TSDB_DATA_TYPE_UBIGINT:
+      ctx->bytes = 8;
+      ctx->bias = 0x8000000000000000ull;
+      return fltRangeIntPrepare(ctx, loBound, hiBound, (int64_t)(*(uint64_t *)minr ^ 0x8000000000000000ull),
+                                (int64_t)(*(uint64_t *)maxr ^ 0x8000000000000000ull));
+    case TSDB_DATA_TYPE_FLOAT: {
+      float eps = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;
+      float below = nextafterf(-eps, -INFINITY);  // d >= -eps iff d > below
+
+      ctx->bytes = 4;
+      ctx->dlo = *(float *)minr;
+      ctx->dhi = *(float *)maxr;
+      ctx->tlo = (loBound == FLT_BOUND_EXCL) ? eps : below;
+      ctx->thi = (hiBound == FLT_BOUND_INCL) ? eps : below;
+      break;
+    }
+    case TSDB_DATA_TYPE_DOUBLE: {
+      double eps = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;
+      double below = nextafter(-eps, -INFINITY);
+
+      ctx->bytes = 8;
+      ctx->dlo = *(double *)minr;
+      ctx->dhi = *(double *)maxr;
+      ctx->tlo = (loBound == FLT_BOUND_EXCL) ? eps : below;
+      ctx->thi = (hiBound == FLT_BOUND_INCL) ? eps : below;
+      break;
+    }
+    default:
+      return false;
+  }
+
+  // a nan bound is compared as equal to the nan values, which is left to the generic path
+  return !(ctx->hasLo && isnan(ctx->dlo)) && !(ctx->hasHi && isnan(ctx->dhi));
+}
+
+/* ------------------------------------------------ scalar kernels ------------------------------------------------ */
+#define FLT_RANGE_INT_SCALAR(S, U)                     \
+  do {                                                 \
+    const U *v = (const U *)pData;                     \
+    S        lo = (S)ctx->lo, hi = (S)ctx->hi;         \
+    U        bias = (U)ctx->bias;                      \
+    for (; i < numOfRows; ++i) {                       \
+      S x = (S)(U)(v[i] ^ bias);                       \
+      p[i] = (int8_t)((x >= lo) & (x <= hi));          \
+    }                                                  \
+  } while (0)
+
+#define FLT_RANGE_FLOAT_SCALAR(T)                                           \
+  do {                                                                      \
+    const T *v = (const T *)pData;                                          \
+    T        lo = (T)ctx->dlo, hi = (T)ctx->dhi;                            \
+    T        tlo = (T)ctx->tlo, thi = (T)ctx->thi;                          \
+    for (; i < numOfRows; ++i) {                                            \
+      bool ok = !ctx->hasLo || ((T)(v[i] - lo) > tlo);                      \
+      p[i] = (int8_t)(ok && (!ctx->hasHi || !((T)(v[i] - hi) > thi)));      \
+    }                                                                       \
+  } while (0)
+
+static void fltRangeScalar(const SFltRangeCtx *ctx, const void *pData, int32_t i, int32_t numOfRows, int8_t *p) {
+  if (ctx->type == TSDB_DATA_TYPE_FLOAT) {
+    FLT_RANGE_FLOAT_SCALAR(float);
+  } else if (ctx->type == TSDB_DATA_TYPE_DOUBLE) {
+    FLT_RANGE_FLOAT_SCALAR(double);
+  } else if (ctx->bytes == 1) {
+    FLT_RANGE_INT_SCALAR(int8_t, uint8_t);
+  } else if (ctx->bytes == 2) {
+    FLT_RANGE_INT_SCALAR(int16_t, uint16_t);
+  } else if (ctx->bytes == 4) {
+    FLT_RANGE_INT_SCALAR(int32_t, uint32_t);
+  } else {
+    FLT_RANGE_INT_SCALAR(int64_t, uint64_t);
+  }
+}
+
+/* ------------------------------------------------- AVX2 kernels ------------------------------------------------- */
+#if __AVX2__
+// write the 8 lanes of the 32 bits mask as 0/1 bytes
+static FORCE_INLINE void fltStoreMask32x8(__m256i m, int8_t *p) {
+  __m128i w = _mm_packs_epi32(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+  __m128i b = _mm_packs_epi16(w, w);
+  _mm_storel_epi64((__m128i *)p, _mm_and_si128(b, _mm_set1_epi8(1)));
+}
+
+// write the lanes of two 64 bits masks as 8 0/1 bytes
+static FORCE_INLINE void fltStoreMask64x4x2(__m256i m0, __m256i m1, int8_t *p) {
+  __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  __m256i m = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(m0, idx), _mm256_permutevar8x32_epi32(m1, idx), 0xF0);
+  fltStoreMask32x8(m, p);
+}
+
+static int32_t fltRangeIntAvx2(const SFltRangeCtx *ctx, const void *pData, int32_t numOfRows, int8_t *p) {
+  const char *pc = (const char *)pData;
+  int32_t     i = 0;
+
+  switch (ctx->bytes) {
+    case 1: {
+      __m256i lo = _mm256_set1_epi8((int8_t)ctx->lo), hi = _mm256_set1_epi8((int8_t)ctx->hi);
+      __m256i bias = _mm256_set1_epi8((int8_t)ctx->bias), one = _mm256_set1_epi8(1);
+      for (; i + 32 <= numOfRows; i += 32) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pc + i)), bias);
+        __m256i out = _mm256_or_si256(_mm256_cmpgt_epi8(lo, v), _mm256_cmpgt_epi8(v, hi));
+        _mm256_storeu_si256((__m256i *)(p + i), _mm256_andnot_si256(out, one));
+      }
+      break;
+    }
+    case 2: {
+      __m256i lo = _mm256_set1_epi16((int16_t)ctx->lo), hi = _mm256_set1_epi16((int16_t)ctx->hi);
+      __m256i bias = _mm256_set1_epi16((int16_t)ctx->bias);
+      for (; i + 16 <= numOfRows; i += 16) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pc + i * 2)), bias);
+        __m256i out = _mm256_or_si256(_mm256_cmpgt_epi16(lo, v), _mm256_cmpgt_epi16(v, hi));
+        __m128i b = _mm_packs_epi16(_mm256_castsi256_si128(out), _mm256_extracti128_si256(out, 1));
+        _mm_storeu_si128((__m128i *)(p + i), _mm_andnot_si128(b, _mm_set1_epi8(1)));
+      }
+      break;
+    }
+    case 4: {
+      __m256i lo = _mm256_set1_epi32((int32_t)ctx->lo), hi = _mm256_set1_epi32((int32_t)ctx->hi);
+      __m256i bias = _mm256_set1_epi32((int32_t)ctx->bias), ones = _mm256_set1_epi32(-1);
+      for (; i + 8 <= numOfRows; i += 8) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pc + i * 4)), bias);
+        __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(lo, v), _mm256_cmpgt_epi32(v, hi));
+        fltStoreMask32x8(_mm256_andnot_si256(out, ones), p + i);
+      }
+      break;
+    }
+    default: {
+      __m256i lo = _mm256_set1_epi64x(ctx->lo), hi = _mm256_set1_epi64x(ctx->hi);
+      __m256i bias = _mm256_set1_epi64x((int64_t)ctx->bias), ones = _mm256_set1_epi64x(-1);
+      for (; i + 8 <= numOfRows; i += 8) {
+        __m256i v0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pc + i * 8)), bias);
+        __m256i v1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pc + i * 8 + 32)), bias);
+        __m256i out0 = _mm256_or_si256(_mm256_cmpgt_epi64(lo, v0), _mm256_cmpgt_epi64(v0, hi));
+        __m256i out1 = _mm256_or_si256(_mm256_cmpgt_epi64(lo, v1), _mm256_cmpgt_epi64(v1, hi));
+        fltStoreMask64x4x2(_mm256_andnot_si256(out0, ones), _mm256_andnot_si256(out1, ones), p + i);
+      }
+      break;
+    }
+  }
+
+  return i;
+}
+
+static int32_t fltRangeFloatAvx2(const SFltRangeCtx *ctx, const void *pData, int32_t numOfRows, int8_t *p) {
+  int32_t i = 0;
+
+  if (ctx->type == TSDB_DATA_TYPE_FLOAT) {
+    const float *v = (const float *)pData;
+    __m256       lo = _mm256_set1_ps((float)ctx->dlo), hi = _mm256_set1_ps((float)ctx->dhi);
+    __m256       tlo = _mm256_set1_ps((float)ctx->tlo), thi = _mm256_set1_ps((float)ctx->thi);
+    __m256       ones = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (; i + 8 <= numOfRows; i += 8) {
+      __m256 x = _mm256_loadu_ps(v + i);
+      __m256 in = ctx->hasLo ? _mm256_cmp_ps(_mm256_sub_ps(x, lo), tlo, _CMP_GT_OQ) : ones;
+      if (ctx->hasHi) in = _mm256_andnot_ps(_mm256_cmp_ps(_mm256_sub_ps(x, hi), thi, _CMP_GT_OQ), in);
+      fltStoreMask32x8(_mm256_castps_si256(in), p + i);
+    }
+  } else {
+    const double *v = (const double *)pData;
+    __m256d       lo = _mm256_set1_pd(ctx->dlo), hi = _mm256_set1_pd(ctx->dhi);
+    __m256d       tlo = _mm256_set1_pd(ctx->tlo), thi = _mm256_set1_pd(ctx->thi);
+    __m256d       ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (; i + 8 <= numOfRows; i += 8) {
+      __m256d x0 = _mm256_loadu_pd(v + i), x1 = _mm256_loadu_pd(v + i + 4);
+      __m256d in0 = ctx->hasLo ? _mm256_cmp_pd(_mm256_sub_pd(x0, lo), tlo, _CMP_GT_OQ) : ones;
+      __m256d in1 = ctx->hasLo ? _mm256_cmp_pd(_mm256_sub_pd(x1, lo), tlo, _CMP_GT_OQ) : ones;
+      if (ctx->hasHi) {
+        in0 = _mm256_andnot_pd(_mm256_cmp_pd(_mm256_sub_pd(x0, hi), thi, _CMP_GT_OQ), in0);
+        in1 = _mm256_andnot_pd(_mm256_cmp_pd(_mm256_sub_pd(x1, hi), thi, _CMP_GT_OQ), in1);
+      }
+      fltStoreMask64x4x2(_mm256_castpd_si256(in0), _mm256_castpd_si256(in1), p + i);
+    }
+  }
+
+  return i;
+}
+#endif
+
+/* ----------------------------------------------- AVX-512 kernels ----------------------------------------------- */
+#if __AVX512F__
+// only the 32/64 bits lanes, the byte and word compares need AVX512BW which is not enabled by the build
+static int32_t fltRangeAvx512(const SFltRangeCtx *ctx, const void *pData, int32_t numOfRows, int8_t *p) {
+  const char *pc = (const char *)pData;
+  int32_t     i = 0;
+
+  if (ctx->type == TSDB_DATA_TYPE_FLOAT) {
+    __m512 lo = _mm512_set1_ps((float)ctx->dlo), hi = _mm512_set1_ps((float)ctx->dhi);
+    __m512 tlo = _mm512_set1_ps((float)ctx->tlo), thi = _mm512_set1_ps((float)ctx->thi);
+    for (; i + 16 <= numOfRows; i += 16) {
+      __m512    x = _mm512_loadu_ps(pc + i * 4);
+      __mmask16 in = ctx->hasLo ? _mm512_cmp_ps_mask(_mm512_sub_ps(x, lo), tlo, _CMP_GT_OQ) : 0xFFFF;
+      if (ctx->hasHi) in &= ~_mm512_cmp_ps_mask(_mm512_sub_ps(x, hi), thi, _CMP_GT_OQ);
+      _mm_storeu_si128((__m128i *)(p + i), _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(in, _mm512_set1_epi32(1))));
+    }
+  } else if (ctx->type == TSDB_DATA_TYPE_DOUBLE) {
+    __m512d lo = _mm512_set1_pd(ctx->dlo), hi = _mm512_set1_pd(ctx->dhi);
+    __m512d tlo = _mm512_set1_pd(ctx->tlo), thi = _mm512_set1_pd(ctx->thi);
+    for (; i + 8 <= numOfRows; i += 8) {
+      __m512d  x = _mm512_loadu_pd(pc + i * 8);
+      __mmask8 in = ctx->hasLo ? _mm512_cmp_pd_mask(_mm512_sub_pd(x, lo), tlo, _CMP_GT_OQ) : 0xFF;
+      if (ctx->hasHi) in &= ~_mm512_cmp_pd_mask(_mm512_sub_pd(x, hi), thi, _CMP_GT_OQ);
+      _mm_storel_epi64((__m128i *)(p + i), _mm512_cvtepi64_epi8(_mm512_maskz_mov_epi64(in, _mm512_set1_epi64(1))));
+    }
+  } else if (ctx->bytes == 4) {
+    __m512i lo = _mm512_set1_epi32((int32_t)ctx->lo), hi = _mm512_set1_epi32((int32_t)ctx->hi);
+    __m512i bias = _mm512_set1_epi32((int32_t)ctx->bias);
+    for (; i + 16 <= numOfRows; i += 16) {
+      __m512i   x = _mm512_xor_si512(_mm512_loadu_si512(pc + i * 4), bias);
+      __mmask16 in = _mm512_cmpge_epi32_mask(x, lo) & _mm512_cmple_epi32_mask(x, hi);
+      _mm_storeu_si128((__m128i *)(p + i), _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(in, _mm512_set1_epi32(1))));
+    }
+  } else if (ctx->bytes == 8) {
+    __m512i lo = _mm512_set1_epi64(ctx->lo), hi = _mm512_set1_epi64(ctx->hi);
+    __m512i bias = _mm512_set1_epi64((int64_t)ctx->bias);
+    for (; i + 8 <= numOfRows; i += 8) {
+      __m512i  x = _mm512_xor_si512(_mm512_loadu_si512(pc + i * 8), bias);
+      __mmask8 in = _mm512_cmpge_epi64_mask(x, lo) & _mm512_cmple_epi64_mask(x, hi);
+      _mm_storel_epi64((__m128i *)(p + i), _mm512_cvtepi64_epi8(_mm512_maskz_mov_epi64(in, _mm512_set1_epi64(1))));
+    }
+  }
+
+  return i;
+}
+#endif
+
+static void fltRangeRun(const SFltRangeCtx *ctx, const void *pData, int32_t numOfRows, int8_t *p) {
+  int32_t i = 0;
+
+  if (ctx->empty) {
+    memset(p, 0, numOfRows);
+    return;
+  }
+
+  if (tsSIMDEnable && tsAVX512Enable) {
+#if __AVX512F__
+    i = fltRangeAvx512(ctx, pData, numOfRows, p);
+#endif
+  }
+
+  if (i == 0 && tsSIMDEnable && tsAVX2Enable) {
+#if __AVX2__
+    if (IS_FLOAT_TYPE(ctx->type)) {
+      i = fltRangeFloatAvx2(ctx, pData, numOfRows, p);
+    } else {
+      i = fltRangeIntAvx2(ctx, pData, numOfRows, p);
+    }
+#endif
+  }
+
+  fltRangeScalar(ctx, pData, i, numOfRows, p);
+}
+
+/* ------------------------------------------------- null handling ------------------------------------------------- */
+static void fltClearNullRows(const SColumnInfoData *pCol, int32_t numOfRows, int8_t *p) {
+  if (!pCol->hasNull || pCol->nullbitmap == NULL) return;
+
+  const uint8_t *bm = (const uint8_t *)pCol->nullbitmap;
+  int32_t        nBytes = BitmapLen(numOfRows);
+
+  for (int32_t i = 0; i < nBytes; i += sizeof(uint64_t)) {
+    if (i + (int32_t)sizeof(uint64_t) <= nBytes) {
+      uint64_t w;
+      memcpy(&w, bm + i, sizeof(w));
+      if (w == 0) continue;
+    }
+
+    int32_t end = TMIN(i + (int32_t)sizeof(uint64_t), nBytes);
+    for (int32_t j = i; j < end; ++j) {
+      if (bm[j] == 0) continue;
+      for (int32_t k = 0; k < 8; ++k) {
+        int32_t row = (j << 3) + k;
+        if ((bm[j] & (0x80u >> k)) && row < numOfRows) p[row] = 0;
+      }
+    }
+  }
+}
+
+static void fltNullRows(const SColumnInfoData *pCol, int32_t numOfRows, bool isNull, int8_t *p) {
+  if (!pCol->hasNull) {
+    memset(p, !isNull, numOfRows);
+  } else if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      p[i] = (int8_t)((pCol->varmeta.offset[i] == -1) == isNull);
+    }
+  } else if (pCol->nullbitmap == NULL) {
+    memset(p, !isNull, numOfRows);
+  } else {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      p[i] = (int8_t)(colDataIsNull_f(pCol->nullbitmap, i) == isNull);
+    }
+  }
+}
+
+static int32_t fltCountRows(const int8_t *p, int32_t numOfRows) {
+  int32_t num = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    num += p[i];
+  }
+  return num;
+}
+
+int32_t filterRangeKernel(SColumnInfoData *pCol, int32_t numOfRows, int8_t rfunc, const void *minr, const void *maxr,
+                          int8_t *p) {
+  SFltRangeCtx ctx;
+  if (!fltRangePrepare(&ctx, pCol->info.type, rfunc, minr, maxr)) {
+    return -1;
+  }
+
+  fltRangeRun(&ctx, pCol->pData, numOfRows, p);
+  fltClearNullRows(pCol, numOfRows, p);
+  return fltCountRows(p, numOfRows);
+}
+
+static bool fltUnitHasKernel(SFilterComUnit *cunit, SFltRangeCtx *ctx) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  if (pCol == NULL || pCol->info.type != cunit->dataType) {
+    return false;
+  }
+
+  if (cunit->optr == OP_TYPE_IS_NULL || cunit->optr == OP_TYPE_IS_NOT_NULL) {
+    return pCol->info.type != TSDB_DATA_TYPE_JSON;
+  }
+
+  return cunit->valData && fltRangePrepare(ctx, pCol->info.type, cunit->rfunc, cunit->valData, cunit->valData2);
+}
+
+static void fltUnitRun(SFilterComUnit *cunit, const SFltRangeCtx *ctx, int32_t numOfRows, int8_t *p) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+
+  if (cunit->optr == OP_TYPE_IS_NULL || cunit->optr == OP_TYPE_IS_NOT_NULL) {
+    fltNullRows(pCol, numOfRows, cunit->optr == OP_TYPE_IS_NULL, p);
+  } else {
+    fltRangeRun(ctx, pCol->pData, numOfRows, p);
+    fltClearNullRows(pCol, numOfRows, p);
+  }
+}
+
+int32_t filterExecuteByKernel(SFilterInfo *info, int32_t numOfRows, int8_t *p) {
+  int32_t       code = 0;
+  uint32_t      maxUnitNum = 0;
+  SFltRangeCtx *aCtx = NULL;
+  int8_t       *pUnit = NULL;
+  int8_t       *pGroup = NULL;
+
+  if (numOfRows <= 0 || info->unitNum == 0) {
+    return -1;
+  }
+
+  // every unit in the groups shall have a kernel, otherwise the whole filter goes to the generic path
+  aCtx = taosMemoryMalloc(sizeof(SFltRangeCtx) * info->unitNum);
+  if (aCtx == NULL) {
+    return -1;
+  }
+
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      uint32_t uidx = group->unitIdxs[u];
+      if (!fltUnitHasKernel(&info->cunits[uidx], &aCtx[uidx])) {
+        code = -1;
+        goto _return;
+      }
+    }
+    maxUnitNum = TMAX(maxUnitNum, group->unitNum);
+  }
+
+  if (maxUnitNum > 1 && (pUnit = taosMemoryMalloc(numOfRows)) == NULL) {
+    code = -1;
+    goto _return;
+  }
+  if (info->groupNum > 1 && (pGroup = taosMemoryMalloc(numOfRows)) == NULL) {
+    code = -1;
+    goto _return;
+  }
+
+  // units in a group are and-ed, and the groups are or-ed
+  memset(p, 0, numOfRows);
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    int8_t       *pg = (g == 0) ? p : pGroup;
+
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      uint32_t uidx = group->unitIdxs[u];
+      int8_t  *pu = (u == 0) ? pg : pUnit;
+
+      fltUnitRun(&info->cunits[uidx], &aCtx[uidx], numOfRows, pu);
+      if (u > 0) {
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          pg[i] &= pu[i];
+        }
+      }
+    }
+
+    if (g > 0) {
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        p[i] |= pg[i];
+      }
+    }
+  }
+
+  code = fltCountRows(p, numOfRows);
+
+_return:
+  taosMemoryFree(aCtx);
+  taosMemoryFree(pUnit);
+  taosMemoryFree(pGroup);
+  return code;
+}
@@ -217,6 +217,28 @@ void sclFreeParam(SScalarParam *param) {
   }
 }
 
+char *sclScratchGet(SSclScratch *pScratch, int32_t size) {
+  if (pScratch->size < size) {
+    int32_t newSize = TMAX(size, pScratch->size * 2);
+    char   *buf = taosMemoryRealloc(pScratch->buf, newSize);
+    if (NULL == buf) {
+      sclError("realloc %d failed", newSize);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+
+    pScratch->buf = buf;
+    pScratch->size = newSize;
+  }
+
+  return pScratch->buf;
+}
+
+void sclScratchFree(SSclScratch *pScratch) {
+  taosMemoryFreeClear(pScratch->buf);
+  pScratch->size = 0;
+}
+
 int32_t sclCopyValueNodeValue(SValueNode *pNode, void **res) {
   if (TSDB_DATA_TYPE_NULL == pNode->node.resType.type) {
     return TSDB_CODE_SUCCESS;
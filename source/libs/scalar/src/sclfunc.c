@@ -379,16 +379,14 @@ static int32_t doLengthFunction(SScalarParam *pInput, int32_t inputNum, SScalarP
 
 static int32_t concatCopyHelper(const char *input, char *output, bool hasNchar, int32_t type, VarDataLenT *dataLen) {
   if (hasNchar && type == TSDB_DATA_TYPE_VARCHAR) {
-    TdUcs4 *newBuf = taosMemoryCalloc((varDataLen(input) + 1) * TSDB_NCHAR_SIZE, 1);
+    // one byte is converted to one ucs4 char at most, so that it is converted into the output buffer directly
     int32_t len = varDataLen(input);
-    bool    ret = taosMbsToUcs4(varDataVal(input), len, newBuf, (varDataLen(input) + 1) * TSDB_NCHAR_SIZE, &len);
+    bool    ret = taosMbsToUcs4(varDataVal(input), len, (TdUcs4 *)(varDataVal(output) + *dataLen),
+                                varDataLen(input) * TSDB_NCHAR_SIZE, &len);
     if (!ret) {
-      taosMemoryFree(newBuf);
       return TSDB_CODE_FAILED;
     }
-    memcpy(varDataVal(output) + *dataLen, newBuf, varDataLen(input) * TSDB_NCHAR_SIZE);
     *dataLen += varDataLen(input) * TSDB_NCHAR_SIZE;
-    taosMemoryFree(newBuf);
   } else {
     memcpy(varDataVal(output) + *dataLen, varDataVal(input), varDataLen(input));
     *dataLen += varDataLen(input);
@@ -96,11 +96,21 @@ void convertNumberToNumber(const void *inData, void *outData, int8_t inType, int
   }
 }
 
+// a numeric string fits in the stack buffer in almost all cases, so that no malloc is needed for each value
+#define SCL_NUM_STR_BUF_LEN 128
+
 void convertNcharToDouble(const void *inData, void *outData) {
-  char *tmp = taosMemoryMalloc(varDataTLen(inData));
-  int   len = taosUcs4ToMbs((TdUcs4 *)varDataVal(inData), varDataLen(inData), tmp);
+  char  buf[SCL_NUM_STR_BUF_LEN];
+  char *tmp = (varDataTLen(inData) <= sizeof(buf)) ? buf : taosMemoryMalloc(varDataTLen(inData));
+  if (tmp == NULL) {
+    *((double *)outData) = 0.;
+    return;
+  }
+
+  int len = taosUcs4ToMbs((TdUcs4 *)varDataVal(inData), varDataLen(inData), tmp);
   if (len < 0) {
     sclError("castConvert taosUcs4ToMbs error 1");
+    len = 0;
   }
 
   tmp[len] = 0;
@@ -108,18 +118,24 @@ void convertNcharToDouble(const void *inData, void *outData) {
   double value = taosStr2Double(tmp, NULL);
 
   *((double *)outData) = value;
-  taosMemoryFreeClear(tmp);
+  if (tmp != buf) {
+    taosMemoryFreeClear(tmp);
+  }
 }
 
 void convertBinaryToDouble(const void *inData, void *outData) {
-  char *tmp = taosMemoryCalloc(1, varDataTLen(inData));
+  char  buf[SCL_NUM_STR_BUF_LEN];
+  char *tmp = (varDataTLen(inData) <= sizeof(buf)) ? buf : taosMemoryMalloc(varDataTLen(inData));
   if (tmp == NULL) {
     *((double *)outData) = 0.;
     return;
   }
   memcpy(tmp, varDataVal(inData), varDataLen(inData));
+  tmp[varDataLen(inData)] = 0;
   double ret = taosStr2Double(tmp, NULL);
-  taosMemoryFree(tmp);
+  if (tmp != buf) {
+    taosMemoryFree(tmp);
+  }
   *((double *)outData) = ret;
 }
 
@@ -190,7 +206,8 @@ _getBigintValue_fn_t getVectorBigintValueFn(int32_t srcType) {
   return p;
 }
 
-static FORCE_INLINE void varToTimestamp(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToTimestamp(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                        SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   int64_t value = 0;
@@ -202,7 +219,8 @@ static FORCE_INLINE void varToTimestamp(char *buf, SScalarParam *pOut, int32_t r
   colDataSetInt64(pOut->columnData, rowIndex, &value);
 }
 
-static FORCE_INLINE void varToSigned(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToSigned(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                     SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   if (overflow) {
@@ -245,7 +263,8 @@ static FORCE_INLINE void varToSigned(char *buf, SScalarParam *pOut, int32_t rowI
   }
 }
 
-static FORCE_INLINE void varToUnsigned(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToUnsigned(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                       SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   if (overflow) {
@@ -287,7 +306,8 @@ static FORCE_INLINE void varToUnsigned(char *buf, SScalarParam *pOut, int32_t ro
   }
 }
 
-static FORCE_INLINE void varToFloat(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToFloat(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                    SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   if (TSDB_DATA_TYPE_FLOAT == pOut->columnData->info.type) {
@@ -300,7 +320,8 @@ static FORCE_INLINE void varToFloat(char *buf, SScalarParam *pOut, int32_t rowIn
   colDataSetDouble(pOut->columnData, rowIndex, &value);
 }
 
-static FORCE_INLINE void varToBool(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToBool(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                   SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   int64_t value = taosStr2Int64(buf, NULL, 10);
@@ -308,8 +329,8 @@ static FORCE_INLINE void varToBool(char *buf, SScalarParam *pOut, int32_t rowInd
   colDataSetInt8(pOut->columnData, rowIndex, (int8_t *)&v);
 }
 
-// todo remove this malloc
-static FORCE_INLINE void varToVarbinary(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToVarbinary(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                        SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   if(isHex(varDataVal(buf), varDataLen(buf))){
@@ -324,72 +345,69 @@ static FORCE_INLINE void varToVarbinary(char *buf, SScalarParam *pOut, int32_t r
       terrno = TSDB_CODE_OUT_OF_MEMORY;
       return;
     }
-    int32_t inputLen = size + VARSTR_HEADER_SIZE;
-    char   *t = taosMemoryCalloc(1, inputLen);
+    char *t = sclScratchGet(pScratch, size + VARSTR_HEADER_SIZE);
     if (t == NULL) {
-      sclError("Out of memory");
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
       taosMemoryFree(data);
       return;
     }
     varDataSetLen(t, size);
     memcpy(varDataVal(t), data, size);
     colDataSetVal(pOut->columnData, rowIndex, t, false);
-    taosMemoryFree(t);
     taosMemoryFree(data);
   }else{
-    int32_t inputLen = varDataTLen(buf);
-    char   *t = taosMemoryCalloc(1, inputLen);
-    if (t == NULL) {
-      sclError("Out of memory");
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
-      return;
-    }
-    memcpy(t, buf, inputLen);
-    colDataSetVal(pOut->columnData, rowIndex, t, false);
-    taosMemoryFree(t);
+    // buf is a copy of the var data already
+    colDataSetVal(pOut->columnData, rowIndex, buf, false);
   }
 }
 
-static FORCE_INLINE void varToNchar(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToNchar(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                    SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   int32_t len = 0;
   int32_t inputLen = varDataLen(buf);
   int32_t outputMaxLen = (inputLen + 1) * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE;
 
-  char   *t = taosMemoryCalloc(1, outputMaxLen);
+  char *t = sclScratchGet(pScratch, outputMaxLen);
+  if (t == NULL) {
+    return;
+  }
+
   int32_t ret =
       taosMbsToUcs4(varDataVal(buf), inputLen, (TdUcs4 *)varDataVal(t), outputMaxLen - VARSTR_HEADER_SIZE, &len);
   if (!ret) {
     sclError("failed to convert to NCHAR");
     terrno = TSDB_CODE_SCALAR_CONVERT_ERROR;
+    len = 0;
   }
   varDataSetLen(t, len);
 
   colDataSetVal(pOut->columnData, rowIndex, t, false);
-  taosMemoryFree(t);
 }
 
-static FORCE_INLINE void ncharToVar(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void ncharToVar(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                    SSclScratch *pScratch) {
   terrno = TSDB_CODE_SUCCESS;
 
   int32_t inputLen = varDataLen(buf);
 
-  char   *t = taosMemoryCalloc(1, inputLen + VARSTR_HEADER_SIZE);
+  char *t = sclScratchGet(pScratch, inputLen + VARSTR_HEADER_SIZE);
+  if (t == NULL) {
+    return;
+  }
+
   int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(buf), varDataLen(buf), varDataVal(t));
   if (len < 0) {
     terrno = TSDB_CODE_SCALAR_CONVERT_ERROR;
-    taosMemoryFree(t);
     return;
   }
   varDataSetLen(t, len);
 
   colDataSetVal(pOut->columnData, rowIndex, t, false);
-  taosMemoryFree(t);
 }
 
-static FORCE_INLINE void varToGeometry(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow) {
+static FORCE_INLINE void varToGeometry(char *buf, SScalarParam *pOut, int32_t rowIndex, int32_t *overflow,
+                                       SSclScratch *pScratch) {
   //[ToDo] support to parse WKB as well as WKT
   terrno = TSDB_CODE_SUCCESS;
 
@@ -408,13 +426,16 @@ static FORCE_INLINE void varToGeometry(char *buf, SScalarParam *pOut, int32_t ro
     goto _err;
   }
 
-  output = taosMemoryCalloc(1, len + VARSTR_HEADER_SIZE);
+  output = sclScratchGet(pScratch, len + VARSTR_HEADER_SIZE);
+  if (output == NULL) {
+    geosFreeBuffer(t);
+    return;
+  }
   memcpy(output + VARSTR_HEADER_SIZE, t, len);
   varDataSetLen(output, len);
 
   colDataSetVal(pOut->columnData, rowIndex, output, false);
 
-  taosMemoryFree(output);
   geosFreeBuffer(t);
 
   return;
@@ -462,7 +483,8 @@ int32_t vectorConvertFromVarData(SSclVectorConvCtx *pCtx, int32_t *overflow) {
   }
 
   pCtx->pOut->numOfRows = pCtx->pIn->numOfRows;
-  char* tmp = NULL;
+  char*       tmp = NULL;
+  SSclScratch scratch = {0};
 
   for (int32_t i = pCtx->startIndex; i <= pCtx->endIndex; ++i) {
     if (IS_HELPER_NULL(pCtx->pIn->columnData, i)) {
@@ -520,7 +542,7 @@ int32_t vectorConvertFromVarData(SSclVectorConvCtx *pCtx, int32_t *overflow) {
       }
     }
 
-    (*func)(tmp, pCtx->pOut, i, overflow);
+    (*func)(tmp, pCtx->pOut, i, overflow, &scratch);
     if (terrno != TSDB_CODE_SUCCESS) {
       goto _err;
     }
@@ -530,6 +552,7 @@ _err:
   if (tmp != NULL) {
     taosMemoryFreeClear(tmp);
   }
+  sclScratchFree(&scratch);
   return terrno;
 }
 
@@ -660,6 +683,7 @@ int32_t vectorConvertToVarData(SSclVectorConvCtx *pCtx) {
   SColumnInfoData *pInputCol = pCtx->pIn->columnData;
   SColumnInfoData *pOutputCol = pCtx->pOut->columnData;
   char             tmp[128] = {0};
+  SSclScratch      scratch = {0};
 
   if (IS_SIGNED_NUMERIC_TYPE(pCtx->inType) || pCtx->inType == TSDB_DATA_TYPE_BOOL ||
       pCtx->inType == TSDB_DATA_TYPE_TIMESTAMP) {
@@ -674,7 +698,7 @@ int32_t vectorConvertToVarData(SSclVectorConvCtx *pCtx) {
       int32_t len = sprintf(varDataVal(tmp), "%" PRId64, value);
       varDataLen(tmp) = len;
       if (pCtx->outType == TSDB_DATA_TYPE_NCHAR) {
-        varToNchar(tmp, pCtx->pOut, i, NULL);
+        varToNchar(tmp, pCtx->pOut, i, NULL, &scratch);
       } else {
         colDataSetVal(pOutputCol, i, (char *)tmp, false);
       }
@@ -691,7 +715,7 @@ int32_t vectorConvertToVarData(SSclVectorConvCtx *pCtx) {
       int32_t len = sprintf(varDataVal(tmp), "%" PRIu64, value);
       varDataLen(tmp) = len;
       if (pCtx->outType == TSDB_DATA_TYPE_NCHAR) {
-        varToNchar(tmp, pCtx->pOut, i, NULL);
+        varToNchar(tmp, pCtx->pOut, i, NULL, &scratch);
       } else {
         colDataSetVal(pOutputCol, i, (char *)tmp, false);
       }
@@ -708,7 +732,7 @@ int32_t vectorConvertToVarData(SSclVectorConvCtx *pCtx) {
       int32_t len = sprintf(varDataVal(tmp), "%lf", value);
       varDataLen(tmp) = len;
       if (pCtx->outType == TSDB_DATA_TYPE_NCHAR) {
-        varToNchar(tmp, pCtx->pOut, i, NULL);
+        varToNchar(tmp, pCtx->pOut, i, NULL, &scratch);
       } else {
         colDataSetVal(pOutputCol, i, (char *)tmp, false);
       }
@@ -718,6 +742,7 @@ int32_t vectorConvertToVarData(SSclVectorConvCtx *pCtx) {
     return TSDB_CODE_APP_ERROR;
   }
 
+  sclScratchFree(&scratch);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1145,6 +1170,264 @@ static void doReleaseVec(SColumnInfoData *pCol, int32_t type) {
   }
 }
 
+// Typed kernels of the math operators on the numeric columns. The output is double as in the generic path, but the
+// kernel of a (type, operator, shape) is looked up once per block, so the inner loops have neither the per row value
+// getter calls nor the null checks, and can be vectorized by the compiler. The nulls are merged from the null bitmaps
+// afterwards. Mixed type columns, json and the descending order are left to the generic path.
+enum {
+  SCL_MATH_ADD = 0,
+  SCL_MATH_SUB,
+  SCL_MATH_MULTI,
+  SCL_MATH_DIV,
+  SCL_MATH_OP_NUM,
+};
+
+enum {
+  SCL_MATH_VV = 0,  // column op column of the same type
+  SCL_MATH_VS,      // column op scalar
+  SCL_MATH_SV,      // scalar op column
+  SCL_MATH_SHAPE_NUM,
+};
+
+// the scalar operand of the VS and SV kernels is passed as a double
+typedef void (*_math_kernel_fn_t)(const void *pLeft, const void *pRight, double *pOut, int32_t numOfRows);
+typedef void (*_math_unary_fn_t)(const void *pIn, double *pOut, int32_t numOfRows);
+typedef void (*_math_zero_fn_t)(const void *pIn, SColumnInfoData *pOutputCol, int32_t numOfRows);
+
+#define SCL_MATH_KERNEL_VV(_name, _type, _op)                                                       \
+  static void _name(const void *pLeft, const void *pRight, double *pOut, int32_t numOfRows) {      \
+    const _type *l = (const _type *)pLeft;                                                          \
+    const _type *r = (const _type *)pRight;                                                         \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                       \
+      pOut[i] = (double)l[i] _op(double) r[i];                                                      \
+    }                                                                                               \
+  }
+
+#define SCL_MATH_KERNEL_VS(_name, _type, _op)                                                       \
+  static void _name(const void *pLeft, const void *pRight, double *pOut, int32_t numOfRows) {      \
+    const _type *l = (const _type *)pLeft;                                                          \
+    double       r = *(const double *)pRight;                                                       \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                       \
+      pOut[i] = (double)l[i] _op r;                                                                 \
+    }                                                                                               \
+  }
+
+#define SCL_MATH_KERNEL_SV(_name, _type, _op)                                                       \
+  static void _name(const void *pLeft, const void *pRight, double *pOut, int32_t numOfRows) {      \
+    double       l = *(const double *)pLeft;                                                        \
+    const _type *r = (const _type *)pRight;                                                         \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                       \
+      pOut[i] = l _op(double) r[i];                                                                 \
+    }                                                                                               \
+  }
+
+#define SCL_MATH_KERNELS(_tname, _type)                                                             \
+  SCL_MATH_KERNEL_VV(vectorMathAdd_##_tname##_VV, _type, +)                                         \
+  SCL_MATH_KERNEL_VS(vectorMathAdd_##_tname##_VS, _type, +)                                         \
+  SCL_MATH_KERNEL_SV(vectorMathAdd_##_tname##_SV, _type, +)                                         \
+  SCL_MATH_KERNEL_VV(vectorMathSub_##_tname##_VV, _type, -)                                         \
+  SCL_MATH_KERNEL_VS(vectorMathSub_##_tname##_VS, _type, -)                                         \
+  SCL_MATH_KERNEL_SV(vectorMathSub_##_tname##_SV, _type, -)                                         \
+  SCL_MATH_KERNEL_VV(vectorMathMulti_##_tname##_VV, _type, *)                                       \
+  SCL_MATH_KERNEL_VS(vectorMathMulti_##_tname##_VS, _type, *)                                       \
+  SCL_MATH_KERNEL_SV(vectorMathMulti_##_tname##_SV, _type, *)                                       \
+  SCL_MATH_KERNEL_VV(vectorMathDiv_##_tname##_VV, _type, /)                                         \
+  SCL_MATH_KERNEL_VS(vectorMathDiv_##_tname##_VS, _type, /)                                         \
+  SCL_MATH_KERNEL_SV(vectorMathDiv_##_tname##_SV, _type, /)                                         \
+  static void vectorMathMinus_##_tname(const void *pIn, double *pOut, int32_t numOfRows) {          \
+    const _type *v = (const _type *)pIn;                                                            \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                       \
+      pOut[i] = (v[i] == 0) ? 0 : -(double)v[i];                                                    \
+    }                                                                                               \
+  }                                                                                                 \
+  static void vectorMathZero_##_tname(const void *pIn, SColumnInfoData *pOutputCol, int32_t numOfRows) { \
+    const _type *v = (const _type *)pIn;                                                            \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                       \
+      if (v[i] == 0) {                                                                              \
+        colDataSetNULL(pOutputCol, i);                                                              \
+      }                                                                                             \
+    }                                                                                               \
+  }
+
+SCL_MATH_KERNELS(BOOL, bool)
+SCL_MATH_KERNELS(TINYINT, int8_t)
+SCL_MATH_KERNELS(UTINYINT, uint8_t)
+SCL_MATH_KERNELS(SMALLINT, int16_t)
+SCL_MATH_KERNELS(USMALLINT, uint16_t)
+SCL_MATH_KERNELS(INT, int32_t)
+SCL_MATH_KERNELS(UINT, uint32_t)
+SCL_MATH_KERNELS(BIGINT, int64_t)
+SCL_MATH_KERNELS(UBIGINT, uint64_t)
+SCL_MATH_KERNELS(FLOAT, float)
+SCL_MATH_KERNELS(DOUBLE, double)
+
+typedef struct {
+  _math_kernel_fn_t kernel[SCL_MATH_OP_NUM][SCL_MATH_SHAPE_NUM];
+  _math_unary_fn_t  minus;
+  _math_zero_fn_t   zero;
+} SSclMathKernels;
+
+#define SCL_MATH_KERNEL_ENTRY(_tname)                                                                      \
+  {                                                                                                        \
+    .kernel = {{vectorMathAdd_##_tname##_VV, vectorMathAdd_##_tname##_VS, vectorMathAdd_##_tname##_SV},     \
+               {vectorMathSub_##_tname##_VV, vectorMathSub_##_tname##_VS, vectorMathSub_##_tname##_SV},     \
+               {vectorMathMulti_##_tname##_VV, vectorMathMulti_##_tname##_VS, vectorMathMulti_##_tname##_SV}, \
+               {vectorMathDiv_##_tname##_VV, vectorMathDiv_##_tname##_VS, vectorMathDiv_##_tname##_SV}},    \
+    .minus = vectorMathMinus_##_tname, .zero = vectorMathZero_##_tname,                                    \
+  }
+
+static const SSclMathKernels sclMathKernels[TSDB_DATA_TYPE_UBIGINT + 1] = {
+    [TSDB_DATA_TYPE_BOOL] = SCL_MATH_KERNEL_ENTRY(BOOL),
+    [TSDB_DATA_TYPE_TINYINT] = SCL_MATH_KERNEL_ENTRY(TINYINT),
+    [TSDB_DATA_TYPE_SMALLINT] = SCL_MATH_KERNEL_ENTRY(SMALLINT),
+    [TSDB_DATA_TYPE_INT] = SCL_MATH_KERNEL_ENTRY(INT),
+    [TSDB_DATA_TYPE_BIGINT] = SCL_MATH_KERNEL_ENTRY(BIGINT),
+    [TSDB_DATA_TYPE_FLOAT] = SCL_MATH_KERNEL_ENTRY(FLOAT),
+    [TSDB_DATA_TYPE_DOUBLE] = SCL_MATH_KERNEL_ENTRY(DOUBLE),
+    [TSDB_DATA_TYPE_TIMESTAMP] = SCL_MATH_KERNEL_ENTRY(BIGINT),
+    [TSDB_DATA_TYPE_UTINYINT] = SCL_MATH_KERNEL_ENTRY(UTINYINT),
+    [TSDB_DATA_TYPE_USMALLINT] = SCL_MATH_KERNEL_ENTRY(USMALLINT),
+    [TSDB_DATA_TYPE_UINT] = SCL_MATH_KERNEL_ENTRY(UINT),
+    [TSDB_DATA_TYPE_UBIGINT] = SCL_MATH_KERNEL_ENTRY(UBIGINT),
+};
+
+static const SSclMathKernels *vectorGetMathKernels(int32_t type) {
+  if (type <= TSDB_DATA_TYPE_NULL || type > TSDB_DATA_TYPE_UBIGINT || sclMathKernels[type].minus == NULL) {
+    return NULL;
+  }
+  return &sclMathKernels[type];
+}
+
+// the null rows of the input are the null rows of the output, with the value set to 0 as colDataSetNULL does
+static void vectorMathMergeNull(SColumnInfoData *pOutputCol, const SColumnInfoData *pInputCol, int32_t numOfRows) {
+  if (!pInputCol->hasNull || numOfRows <= 0) {
+    return;
+  }
+
+  const uint8_t *src = (const uint8_t *)pInputCol->nullbitmap;
+  uint8_t       *dst = (uint8_t *)pOutputCol->nullbitmap;
+  int32_t        len = BitmapLen(numOfRows);
+  for (int32_t j = 0; j < len; ++j) {
+    uint8_t b = src[j];
+    if (j == len - 1 && (numOfRows & 0x7) != 0) {
+      b &= (uint8_t)(0xFF << (8 - (numOfRows & 0x7)));
+    }
+    if (b == 0) {
+      continue;
+    }
+
+    dst[j] |= b;
+    for (int32_t k = 0; k < 8; ++k) {
+      if (b & (0x80u >> k)) {
+        memset(pOutputCol->pData + ((j << 3) + k) * pOutputCol->info.bytes, 0, pOutputCol->info.bytes);
+      }
+    }
+    pOutputCol->hasNull = true;
+  }
+}
+
+// return false if the operands are not supported by the typed kernels, and the generic path shall be taken
+static bool vectorMathByKernel(SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pLeftCol,
+                               SColumnInfoData *pRightCol, SColumnInfoData *pOutputCol, int32_t op, int32_t _ord) {
+  if (_ord != TSDB_ORDER_ASC || pOutputCol->info.type != TSDB_DATA_TYPE_DOUBLE) {
+    return false;
+  }
+
+  const SSclMathKernels *pLeftKernels = vectorGetMathKernels(pLeftCol->info.type);
+  const SSclMathKernels *pRightKernels = vectorGetMathKernels(pRightCol->info.type);
+  if (pLeftKernels == NULL || pRightKernels == NULL) {
+    return false;
+  }
+
+  double *output = (double *)pOutputCol->pData;
+  if (pRight->numOfRows == 1) {
+    if (colDataIsNull_s(pRightCol, 0)) {
+      colDataSetNNULL(pOutputCol, 0, pLeft->numOfRows);
+      return true;
+    }
+
+    double rx = getVectorDoubleValueFn(pRightCol->info.type)(pRightCol->pData, 0);
+    if (op == SCL_MATH_DIV && rx == 0) {  // divide by 0 check
+      colDataSetNNULL(pOutputCol, 0, pLeft->numOfRows);
+      return true;
+    }
+
+    pLeftKernels->kernel[op][SCL_MATH_VS](pLeftCol->pData, &rx, output, pLeft->numOfRows);
+    vectorMathMergeNull(pOutputCol, pLeftCol, pLeft->numOfRows);
+  } else if (pLeft->numOfRows == 1) {
+    if (colDataIsNull_s(pLeftCol, 0)) {
+      colDataSetNNULL(pOutputCol, 0, pRight->numOfRows);
+      return true;
+    }
+
+    double lx = getVectorDoubleValueFn(pLeftCol->info.type)(pLeftCol->pData, 0);
+    pRightKernels->kernel[op][SCL_MATH_SV](&lx, pRightCol->pData, output, pRight->numOfRows);
+    vectorMathMergeNull(pOutputCol, pRightCol, pRight->numOfRows);
+    if (op == SCL_MATH_DIV) {
+      pRightKernels->zero(pRightCol->pData, pOutputCol, pRight->numOfRows);
+    }
+  } else if (pLeft->numOfRows == pRight->numOfRows && pLeftKernels == pRightKernels) {
+    pLeftKernels->kernel[op][SCL_MATH_VV](pLeftCol->pData, pRightCol->pData, output, pLeft->numOfRows);
+    vectorMathMergeNull(pOutputCol, pLeftCol, pLeft->numOfRows);
+    vectorMathMergeNull(pOutputCol, pRightCol, pRight->numOfRows);
+    if (op == SCL_MATH_DIV) {
+      pRightKernels->zero(pRightCol->pData, pOutputCol, pRight->numOfRows);
+    }
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+// timestamp plus/minus an integer column or a duration without the calendar units, in int64
+static bool vectorMathTsByKernel(SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pLeftCol,
+                                 SColumnInfoData *pRightCol, SColumnInfoData *pOutputCol, int32_t op, int32_t _ord) {
+  int32_t lType = pLeftCol->info.type, rType = pRightCol->info.type;
+  if (_ord != TSDB_ORDER_ASC || (lType != TSDB_DATA_TYPE_TIMESTAMP && lType != TSDB_DATA_TYPE_BIGINT) ||
+      (rType != TSDB_DATA_TYPE_TIMESTAMP && rType != TSDB_DATA_TYPE_BIGINT)) {
+    return false;
+  }
+
+  // the overflow wraps around as the generic path does, without the undefined behavior of the signed overflow
+  uint64_t *output = (uint64_t *)pOutputCol->pData;
+  if (pRight->numOfRows == 1 && pLeft->numOfRows > 1) {
+    if (IS_CALENDAR_TIME_DURATION(pRightCol->info.scale)) {
+      return false;
+    }
+    if (colDataIsNull_s(pRightCol, 0)) {
+      colDataSetNNULL(pOutputCol, 0, pLeft->numOfRows);
+      return true;
+    }
+
+    const uint64_t *l = (const uint64_t *)pLeftCol->pData;
+    uint64_t        r = *(uint64_t *)pRightCol->pData;
+    r = (op == SCL_MATH_ADD) ? r : -r;
+    for (int32_t i = 0; i < pLeft->numOfRows; ++i) {
+      output[i] = l[i] + r;
+    }
+    vectorMathMergeNull(pOutputCol, pLeftCol, pLeft->numOfRows);
+  } else if (pLeft->numOfRows == pRight->numOfRows && pLeft->numOfRows > 1) {
+    const uint64_t *l = (const uint64_t *)pLeftCol->pData;
+    const uint64_t *r = (const uint64_t *)pRightCol->pData;
+    if (op == SCL_MATH_ADD) {
+      for (int32_t i = 0; i < pLeft->numOfRows; ++i) {
+        output[i] = l[i] + r[i];
+      }
+    } else {
+      for (int32_t i = 0; i < pLeft->numOfRows; ++i) {
+        output[i] = l[i] - r[i];
+      }
+    }
+    vectorMathMergeNull(pOutputCol, pLeftCol, pLeft->numOfRows);
+    vectorMathMergeNull(pOutputCol, pRightCol, pRight->numOfRows);
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
 void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t _ord) {
   SColumnInfoData *pOutputCol = pOut->columnData;
 
@@ -1162,6 +1445,10 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
       (GET_PARAM_TYPE(pLeft) == TSDB_DATA_TYPE_TIMESTAMP && GET_PARAM_TYPE(pRight) == TSDB_DATA_TYPE_BOOL) ||
       (GET_PARAM_TYPE(pRight) == TSDB_DATA_TYPE_TIMESTAMP &&
        GET_PARAM_TYPE(pLeft) == TSDB_DATA_TYPE_BOOL)) {  // timestamp plus duration
+    if (vectorMathTsByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_ADD, _ord)) {
+      goto _return;
+    }
+
     int64_t             *output = (int64_t *)pOutputCol->pData;
     _getBigintValue_fn_t getVectorBigintValueFnLeft = getVectorBigintValueFn(pLeftCol->info.type);
     _getBigintValue_fn_t getVectorBigintValueFnRight = getVectorBigintValueFn(pRightCol->info.type);
@@ -1186,6 +1473,10 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
       }
     }
   } else {
+    if (vectorMathByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_ADD, _ord)) {
+      goto _return;
+    }
+
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1205,6 +1496,7 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
     }
   }
 
+_return:
   doReleaseVec(pLeftCol, leftConvert);
   doReleaseVec(pRightCol, rightConvert);
 }
@@ -1267,6 +1559,10 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
   if ((GET_PARAM_TYPE(pLeft) == TSDB_DATA_TYPE_TIMESTAMP && GET_PARAM_TYPE(pRight) == TSDB_DATA_TYPE_BIGINT) ||
       (GET_PARAM_TYPE(pRight) == TSDB_DATA_TYPE_TIMESTAMP &&
        GET_PARAM_TYPE(pLeft) == TSDB_DATA_TYPE_BIGINT)) {  // timestamp minus duration
+    if (vectorMathTsByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_SUB, _ord)) {
+      goto _return;
+    }
+
     int64_t             *output = (int64_t *)pOutputCol->pData;
     _getBigintValue_fn_t getVectorBigintValueFnLeft = getVectorBigintValueFn(pLeftCol->info.type);
     _getBigintValue_fn_t getVectorBigintValueFnRight = getVectorBigintValueFn(pRightCol->info.type);
@@ -1287,6 +1583,10 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
       }
     }
   } else {
+    if (vectorMathByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_SUB, _ord)) {
+      goto _return;
+    }
+
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1306,6 +1606,7 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
     }
   }
 
+_return:
   doReleaseVec(pLeftCol, leftConvert);
   doReleaseVec(pRightCol, rightConvert);
 }
@@ -1342,6 +1643,10 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
   SColumnInfoData *pRightCol = vectorConvertVarToDouble(pRight, &rightConvert);
 
+  if (vectorMathByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_MULTI, _ord)) {
+    goto _return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
@@ -1360,6 +1665,7 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
     vectorMathMultiplyHelper(pLeftCol, pRightCol, pOutputCol, pLeft->numOfRows, step, i);
   }
 
+_return:
   doReleaseVec(pLeftCol, leftConvert);
   doReleaseVec(pRightCol, rightConvert);
 }
@@ -1375,6 +1681,10 @@ void vectorMathDivide(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *p
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
   SColumnInfoData *pRightCol = vectorConvertVarToDouble(pRight, &rightConvert);
 
+  if (vectorMathByKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, SCL_MATH_DIV, _ord)) {
+    goto _return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
@@ -1414,6 +1724,7 @@ void vectorMathDivide(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *p
     }
   }
 
+_return:
   doReleaseVec(pLeftCol, leftConvert);
   doReleaseVec(pRightCol, rightConvert);
 }
@@ -1507,6 +1818,14 @@ void vectorMathMinus(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pO
   int32_t          leftConvert = 0;
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
 
+  const SSclMathKernels *pKernels = vectorGetMathKernels(pLeftCol->info.type);
+  if (_ord == TSDB_ORDER_ASC && pKernels != NULL && pOutputCol->info.type == TSDB_DATA_TYPE_DOUBLE) {
+    pKernels->minus(pLeftCol->pData, (double *)pOutputCol->pData, pLeft->numOfRows);
+    vectorMathMergeNull(pOutputCol, pLeftCol, pLeft->numOfRows);
+    doReleaseVec(pLeftCol, leftConvert);
+    return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
 
   double *output = (double *)pOutputCol->pData;
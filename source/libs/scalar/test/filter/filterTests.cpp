@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -38,6 +40,7 @@
 #include "scalar.h"
 #include "stub.h"
 #include "taos.h"
+#include "tcompare.h"
 #include "tdatablock.h"
 #include "tdef.h"
 #include "tglobal.h"
@@ -617,6 +620,56 @@ TEST(columnTest, binary_column_like_binary) {
   blockDataDestroy(src);
 }
 
+TEST(columnTest, nchar_column_match_binary) {
+  SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
+  char         rightv[64] = {0};
+  char         leftv[5][3 * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE] = {0};
+  SSDataBlock *src = NULL;
+  SScalarParam res;
+  initScalarParam(&res);
+  bool eRes[5] = {true, false, true, false, true};
+
+  for (int32_t i = 0; i < 5; ++i) {
+    char    str[4] = {'a', 'a', (char)('0' + i % 2), 0};
+    int32_t len = 0;
+    ASSERT_TRUE(taosMbsToUcs4(str, 3, (TdUcs4 *)varDataVal(leftv[i]), 3 * TSDB_NCHAR_SIZE, &len));
+    varDataSetLen(leftv[i], len);
+  }
+
+  int32_t rowNum = sizeof(leftv) / sizeof(leftv[0]);
+  flttMakeColumnNode(&pLeft, &src, TSDB_DATA_TYPE_NCHAR, 3 * TSDB_NCHAR_SIZE, rowNum, leftv);
+
+  sprintf(&rightv[2], "%s", "a0$");
+  varDataSetLen(rightv, strlen(&rightv[2]));
+  flttMakeValueNode(&pRight, TSDB_DATA_TYPE_BINARY, rightv);
+  flttMakeOpNode(&opNode, OP_TYPE_MATCH, TSDB_DATA_TYPE_BOOL, pLeft, pRight);
+
+  SFilterInfo *filter = NULL;
+  int32_t      code = filterInitFromNode(opNode, &filter, 0);
+  ASSERT_EQ(code, 0);
+
+  SColumnDataAgg     stat = {0};
+  SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+  code = filterSetDataFromSlotId(filter, &param);
+  ASSERT_EQ(code, 0);
+
+  stat.max = 5;
+  stat.min = 1;
+  stat.numOfNull = 0;
+  int8_t *rowRes = NULL;
+  bool    keep = filterExecute(filter, src, &rowRes, &stat, (int32_t)taosArrayGetSize(src->pDataBlock));
+  ASSERT_EQ(keep, false);
+
+  // the rows are converted in the same buffer, and the result of one row is not affected by the others
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(*((int8_t *)rowRes + i), eRes[i]);
+  }
+  taosMemoryFreeClear(rowRes);
+  filterFreeInfo(filter);
+  nodesDestroyNode(opNode);
+  blockDataDestroy(src);
+}
+
 TEST(columnTest, binary_column_is_null) {
   SNode       *pLeft = NULL, *opNode = NULL;
   char         leftv[5][5] = {0};
@@ -1415,6 +1468,143 @@ void doCompareWithValueRange_OnlyLeftType(__compar_fn_t fp, int32_t rType) {
   }
 }
 
+namespace {
+
+enum { FLTT_KERNEL_SCALAR = 0, FLTT_KERNEL_AVX2, FLTT_KERNEL_AVX512 };
+
+struct SFlttSimdEnv {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  char simdEnable, avx2Enable, avx512Enable;
+
+  SFlttSimdEnv() : simdEnable(tsSIMDEnable), avx2Enable(tsAVX2Enable), avx512Enable(tsAVX512Enable) {
+    taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+  }
+  ~SFlttSimdEnv() {
+    tsSIMDEnable = simdEnable;
+    tsAVX2Enable = avx2Enable;
+    tsAVX512Enable = avx512Enable;
+  }
+
+  bool set(int32_t mode) {
+    tsSIMDEnable = (mode != FLTT_KERNEL_SCALAR);
+    tsAVX2Enable = (mode == FLTT_KERNEL_AVX2) ? avx2 : 0;
+    tsAVX512Enable = (mode == FLTT_KERNEL_AVX512) ? avx512 : 0;
+    return mode == FLTT_KERNEL_SCALAR || tsAVX2Enable || tsAVX512Enable;
+  }
+};
+
+const int32_t flttKernelRows[] = {1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 4096};
+
+// the kernel of every range function shall give the same result as the row at a time range compare
+template <typename T>
+void flttCheckRangeKernel(int32_t type, const std::vector<T> &values, const std::vector<T> &bounds) {
+  SFlttSimdEnv  env;
+  __compar_fn_t func = filterGetCompFunc(type, OP_TYPE_GREATER_THAN);
+
+  for (int32_t rows : flttKernelRows) {
+    SColumnInfoData col = {0};
+    col.info.type = type;
+    col.info.bytes = sizeof(T);
+    col.pData = (char *)taosMemoryMalloc(rows * sizeof(T));
+    col.nullbitmap = (char *)taosMemoryCalloc(1, BitmapLen(rows));
+    for (int32_t i = 0; i < rows; ++i) {
+      ((T *)col.pData)[i] = values[taosRand() % values.size()];
+      if (taosRand() % 5 == 0) {
+        colDataSetNull_f(col.nullbitmap, i);
+        col.hasNull = true;
+      }
+    }
+
+    std::vector<int8_t> expect(rows), res(rows + 1);
+    for (int8_t rfunc = 0; rfunc < 8; ++rfunc) {
+      T minr = bounds[taosRand() % bounds.size()];
+      T maxr = bounds[taosRand() % bounds.size()];
+
+      int32_t num = 0;
+      for (int32_t i = 0; i < rows; ++i) {
+        void *v = col.pData + i * sizeof(T);
+        expect[i] = colDataIsNull_f(col.nullbitmap, i) ? 0 : (*gRangeCompare[rfunc])(v, v, &minr, &maxr, func);
+        num += expect[i];
+      }
+
+      for (int32_t mode = FLTT_KERNEL_SCALAR; mode <= FLTT_KERNEL_AVX512; ++mode) {
+        if (!env.set(mode)) {
+          continue;
+        }
+
+        res[rows] = 0x5a;
+        ASSERT_EQ(filterRangeKernel(&col, rows, rfunc, &minr, &maxr, res.data()), num);
+        ASSERT_EQ(memcmp(res.data(), expect.data(), rows), 0)
+            << "type:" << type << " rfunc:" << (int32_t)rfunc << " mode:" << mode << " rows:" << rows;
+        ASSERT_EQ(res[rows], 0x5a);
+      }
+    }
+
+    taosMemoryFree(col.pData);
+    taosMemoryFree(col.nullbitmap);
+  }
+}
+
+template <typename T>
+void flttCheckIntRangeKernel(int32_t type) {
+  T vmin = std::numeric_limits<T>::min(), vmax = std::numeric_limits<T>::max();
+
+  std::vector<T> values = {vmin, (T)(vmin + 1), (T)-1, 0, 1, 2, 3, 5, 100, (T)(vmax - 1), vmax};
+  for (int32_t i = 0; i < 16; ++i) {
+    values.push_back((T)taosRand());
+  }
+  std::vector<T> bounds = {vmin, (T)(vmin + 1), 0, 1, 3, 100, (T)(vmax - 1), vmax};
+  flttCheckRangeKernel<T>(type, values, bounds);
+}
+
+template <typename T>
+void flttCheckFloatRangeKernel(int32_t type) {
+  T inf = std::numeric_limits<T>::infinity(), nan = std::numeric_limits<T>::quiet_NaN();
+  T eps = FLT_COMPAR_TOL_FACTOR * FLT_EPSILON;
+
+  std::vector<T> values = {-inf, inf, nan, 0, (T)-0.0, 1, (T)(1 + eps), (T)(1 - eps), (T)(1 + 2 * eps), 2.5, -3.75,
+                           std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()};
+  for (int32_t i = 0; i < 16; ++i) {
+    values.push_back((T)((int32_t)(taosRand() % 2001) - 1000) / 100);
+  }
+  std::vector<T> bounds = {-inf, inf, 0, 1, 2.5, -3.75, std::numeric_limits<T>::max()};
+  flttCheckRangeKernel<T>(type, values, bounds);
+}
+
+}  // namespace
+
+TEST(filterKernelTest, integer_range) {
+  flttCheckIntRangeKernel<int8_t>(TSDB_DATA_TYPE_TINYINT);
+  flttCheckIntRangeKernel<int16_t>(TSDB_DATA_TYPE_SMALLINT);
+  flttCheckIntRangeKernel<int32_t>(TSDB_DATA_TYPE_INT);
+  flttCheckIntRangeKernel<int64_t>(TSDB_DATA_TYPE_BIGINT);
+  flttCheckIntRangeKernel<int64_t>(TSDB_DATA_TYPE_TIMESTAMP);
+  flttCheckIntRangeKernel<uint8_t>(TSDB_DATA_TYPE_UTINYINT);
+  flttCheckIntRangeKernel<uint16_t>(TSDB_DATA_TYPE_USMALLINT);
+  flttCheckIntRangeKernel<uint32_t>(TSDB_DATA_TYPE_UINT);
+  flttCheckIntRangeKernel<uint64_t>(TSDB_DATA_TYPE_UBIGINT);
+}
+
+TEST(filterKernelTest, float_range) {
+  flttCheckFloatRangeKernel<float>(TSDB_DATA_TYPE_FLOAT);
+  flttCheckFloatRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE);
+}
+
+TEST(filterKernelTest, unsupported) {
+  SColumnInfoData col = {0};
+  int8_t          res[4] = {0};
+  double          nan = std::numeric_limits<double>::quiet_NaN(), one = 1;
+
+  col.info.type = TSDB_DATA_TYPE_DOUBLE;
+  col.info.bytes = sizeof(double);
+  col.pData = (char *)&one;
+  // the nan bounds and the other types are left to the row at a time compare
+  ASSERT_EQ(filterRangeKernel(&col, 1, 3, &nan, &one, res), -1);
+  ASSERT_EQ(filterRangeKernel(&col, 1, -1, &one, &one, res), -1);
+  col.info.type = TSDB_DATA_TYPE_BOOL;
+  ASSERT_EQ(filterRangeKernel(&col, 1, 3, &one, &one, res), -1);
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -36,6 +37,7 @@
 #include "nodes.h"
 #include "parUtil.h"
 #include "scalar.h"
+#include "sclvector.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -2008,7 +2010,8 @@ void scltMakeDataBlock(SScalarParam **pInput, int32_t type, void *pVal, int32_t
       bytes = sizeof(int32_t);
       break;
     }
-    case TSDB_DATA_TYPE_BIGINT: {
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP: {
       bytes = sizeof(int64_t);
       break;
     }
@@ -3631,6 +3634,153 @@ TEST(ScalarFunctionTest, powFunction_column) {
   taosMemoryFree(pInput);
 }
 
+namespace {
+
+// expected result of the math operators: the double of the operands, null if any of them is null or divided by 0
+double scltMathExpect(int32_t optr, double l, double r, bool *isNull) {
+  switch (optr) {
+    case OP_TYPE_ADD:
+      return l + r;
+    case OP_TYPE_SUB:
+      return l - r;
+    case OP_TYPE_MULTI:
+      return l * r;
+    default:
+      *isNull = *isNull || (r == 0);
+      return l / r;
+  }
+}
+
+// the operands are columns of rowNum rows, or a value if its rowNum is 1
+template <typename T>
+void scltCheckMathOperator(int32_t type, int32_t optr, int32_t leftRows, int32_t rightRows) {
+  int32_t       rowNum = TMAX(leftRows, rightRows);
+  SScalarParam *pLeft = NULL, *pRight = NULL, *pOutput = NULL;
+  scltMakeDataBlock(&pLeft, type, 0, leftRows, false);
+  scltMakeDataBlock(&pRight, type, 0, rightRows, false);
+  scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_DOUBLE, 0, rowNum, false);
+
+  std::vector<T>    lv(leftRows), rv(rightRows);
+  std::vector<bool> ln(leftRows), rn(rightRows);
+  for (int32_t i = 0; i < leftRows; ++i) {
+    lv[i] = (T)(taosRand() % 200 - 100) / (T)((type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE) ? 4 : 1);
+    ln[i] = (leftRows > 1 && taosRand() % 7 == 0);
+    if (ln[i]) {
+      colDataSetNULL(pLeft->columnData, i);
+    } else {
+      colDataSetVal(pLeft->columnData, i, (const char *)&lv[i], false);
+    }
+  }
+  for (int32_t i = 0; i < rightRows; ++i) {
+    rv[i] = (T)(taosRand() % 9 - 4);
+    rn[i] = (rightRows > 1 && taosRand() % 5 == 0);
+    if (rn[i]) {
+      colDataSetNULL(pRight->columnData, i);
+    } else {
+      colDataSetVal(pRight->columnData, i, (const char *)&rv[i], false);
+    }
+  }
+
+  getBinScalarOperatorFn(optr)(pLeft, pRight, pOutput, TSDB_ORDER_ASC);
+  ASSERT_EQ(pOutput->numOfRows, rowNum);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    int32_t li = (leftRows == 1) ? 0 : i, ri = (rightRows == 1) ? 0 : i;
+    bool    isNull = ln[li] || rn[ri];
+    double  expect = scltMathExpect(optr, (double)lv[li], (double)rv[ri], &isNull);
+
+    ASSERT_EQ(colDataIsNull_f(pOutput->columnData->nullbitmap, i), isNull) << "optr:" << optr << " row:" << i;
+    if (isNull) {
+      ASSERT_EQ(*((double *)colDataGetData(pOutput->columnData, i)), 0);
+    } else {
+      ASSERT_EQ(*((double *)colDataGetData(pOutput->columnData, i)), expect) << "optr:" << optr << " row:" << i;
+    }
+  }
+
+  scltDestroyDataBlock(pLeft);
+  scltDestroyDataBlock(pRight);
+  scltDestroyDataBlock(pOutput);
+}
+
+template <typename T>
+void scltCheckMathOperators(int32_t type) {
+  const int32_t optrs[] = {OP_TYPE_ADD, OP_TYPE_SUB, OP_TYPE_MULTI, OP_TYPE_DIV};
+  for (int32_t optr : optrs) {
+    for (int32_t rowNum : {1, 7, 8, 9, 33, 100}) {
+      scltCheckMathOperator<T>(type, optr, rowNum, rowNum);
+      scltCheckMathOperator<T>(type, optr, rowNum, 1);
+      scltCheckMathOperator<T>(type, optr, 1, rowNum);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(columnTest, typed_math_operator) {
+  scltCheckMathOperators<int8_t>(TSDB_DATA_TYPE_TINYINT);
+  scltCheckMathOperators<int16_t>(TSDB_DATA_TYPE_SMALLINT);
+  scltCheckMathOperators<int32_t>(TSDB_DATA_TYPE_INT);
+  scltCheckMathOperators<int64_t>(TSDB_DATA_TYPE_BIGINT);
+  scltCheckMathOperators<float>(TSDB_DATA_TYPE_FLOAT);
+  scltCheckMathOperators<double>(TSDB_DATA_TYPE_DOUBLE);
+}
+
+TEST(columnTest, typed_math_minus_and_timestamp) {
+  int32_t       rowNum = 20;
+  SScalarParam *pInput = NULL, *pDuration = NULL, *pOutput = NULL;
+
+  // minus of an int column with nulls
+  scltMakeDataBlock(&pInput, TSDB_DATA_TYPE_INT, 0, rowNum, false);
+  scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_DOUBLE, 0, rowNum, false);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    int32_t v = i - 10;
+    if (i % 3 == 0) {
+      colDataSetNULL(pInput->columnData, i);
+    } else {
+      colDataSetVal(pInput->columnData, i, (const char *)&v, false);
+    }
+  }
+  getBinScalarOperatorFn(OP_TYPE_MINUS)(pInput, NULL, pOutput, TSDB_ORDER_ASC);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(colDataIsNull_f(pOutput->columnData->nullbitmap, i), i % 3 == 0);
+    if (i % 3 != 0) {
+      ASSERT_EQ(*((double *)colDataGetData(pOutput->columnData, i)), (double)(10 - i));
+    }
+  }
+  scltDestroyDataBlock(pInput);
+  scltDestroyDataBlock(pOutput);
+
+  // timestamp column plus and minus a duration of 1s in ms
+  int64_t duration = 1000;
+  scltMakeDataBlock(&pInput, TSDB_DATA_TYPE_TIMESTAMP, 0, rowNum, false);
+  scltMakeDataBlock(&pDuration, TSDB_DATA_TYPE_BIGINT, &duration, 1, true);
+  pDuration->columnData->info.scale = 's';
+  for (int32_t i = 0; i < rowNum; ++i) {
+    int64_t ts = 1700000000000 + i;
+    if (i == 5) {
+      colDataSetNULL(pInput->columnData, i);
+    } else {
+      colDataSetVal(pInput->columnData, i, (const char *)&ts, false);
+    }
+  }
+
+  const int32_t optrs[] = {OP_TYPE_ADD, OP_TYPE_SUB};
+  for (int32_t optr : optrs) {
+    scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_TIMESTAMP, 0, rowNum, false);
+    getBinScalarOperatorFn(optr)(pInput, pDuration, pOutput, TSDB_ORDER_ASC);
+    for (int32_t i = 0; i < rowNum; ++i) {
+      ASSERT_EQ(colDataIsNull_f(pOutput->columnData->nullbitmap, i), i == 5);
+      if (i != 5) {
+        ASSERT_EQ(*((int64_t *)colDataGetData(pOutput->columnData, i)),
+                  1700000000000 + i + (optr == OP_TYPE_ADD ? duration : -duration));
+      }
+    }
+    scltDestroyDataBlock(pOutput);
+  }
+
+  scltDestroyDataBlock(pInput);
+  scltDestroyDataBlock(pDuration);
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
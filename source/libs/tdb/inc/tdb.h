@@ -31,6 +31,13 @@ typedef struct STTB TTB;
 typedef struct STBC TBC;
 typedef struct STxn TXN;
 
+typedef struct {
+  const void *pKey;
+  int         kLen;
+  const void *pVal;
+  int         vLen;
+} STbRecord;
+
 // TDB
 int32_t tdbOpen(const char *dbname, int szPage, int pages, TDB **ppDb, int8_t rollback, int32_t encryptAlgorithm,
                 char *encryptKey);
@@ -53,6 +60,7 @@ int32_t tdbTbDrop(TTB *pTb);
 int32_t tdbTbInsert(TTB *pTb, const void *pKey, int keyLen, const void *pVal, int valLen, TXN *pTxn);
 int32_t tdbTbDelete(TTB *pTb, const void *pKey, int kLen, TXN *pTxn);
 int32_t tdbTbUpsert(TTB *pTb, const void *pKey, int kLen, const void *pVal, int vLen, TXN *pTxn);
+int32_t tdbTbUpsertBatch(TTB *pTb, const STbRecord *pRecords, int32_t nRecords, TXN *pTxn);
 int32_t tdbTbGet(TTB *pTb, const void *pKey, int kLen, void **ppVal, int *vLen);
 int32_t tdbTbPGet(TTB *pTb, const void *pKey, int kLen, void **ppKey, int *pkLen, void **ppVal, int *vLen);
 int32_t tdbTbTraversal(TTB *pTb, void *data,
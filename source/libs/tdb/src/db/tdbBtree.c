@@ -14,6 +14,7 @@
  */
 
 #include "tdbInt.h"
+#include "talgo.h"
 
 #define TDB_BTREE_ROOT 0x1
 #define TDB_BTREE_LEAF 0x2
@@ -274,6 +275,167 @@ int tdbBtreeDelete(SBTree *pBt, const void *pKey, int kLen, TXN *pTxn) {
   return 0;
 }
 
+typedef struct {
+  const STbRecord *pRecords;
+  tdb_cmpr_fn_t    kcmpr;
+} SBtreeBatchCmprArg;
+
+static int32_t tdbBtreeBatchCmprFn(const void *p1, const void *p2, const void *param) {
+  const SBtreeBatchCmprArg *pArg = (const SBtreeBatchCmprArg *)param;
+  int32_t                   i1 = *(const int32_t *)p1;
+  int32_t                   i2 = *(const int32_t *)p2;
+  const STbRecord          *pRecord1 = pArg->pRecords + i1;
+  const STbRecord          *pRecord2 = pArg->pRecords + i2;
+
+  int c = pArg->kcmpr(pRecord1->pKey, pRecord1->kLen, pRecord2->pKey, pRecord2->kLen);
+  if (c != 0) return c;
+
+  // the records of the same key keep their order, so the last one wins as upserted one by one
+  return i1 < i2 ? -1 : (i1 > i2 ? 1 : 0);
+}
+
+// return the pages of the cursor, and keep the txn for the next move
+static void tdbBtcReset(SBTC *pBtc) {
+  while (pBtc->iPage >= 0) {
+    tdbPagerReturnPage(pBtc->pBt->pPager, pBtc->pPage, pBtc->pTxn);
+
+    pBtc->iPage--;
+    if (pBtc->iPage < 0) break;
+
+    pBtc->pPage = pBtc->pgStack[pBtc->iPage];
+  }
+
+  pBtc->pPage = NULL;
+  pBtc->idx = -1;
+}
+
+// move the cursor to the position of the key, and the leaf page the cursor is on is searched first. The key falls into
+// the leaf if it is between the first and the last cells, or after the last cell of the right-most leaf.
+static int tdbBtcMoveToNearby(SBTC *pBtc, const void *pKey, int kLen, int *pCRst) {
+  SBTree     *pBt = pBtc->pBt;
+  const void *pTKey;
+  int         tkLen;
+  int         nCells;
+  int         lidx, ridx;
+  int         c;
+
+  if (pBtc->iPage < 0 || !TDB_BTREE_PAGE_IS_LEAF(pBtc->pPage) || (nCells = TDB_PAGE_TOTAL_CELLS(pBtc->pPage)) == 0) {
+    goto _search_from_root;
+  }
+
+  // compare the last cell
+  pBtc->idx = nCells - 1;
+  tdbBtcGet(pBtc, &pTKey, &tkLen, NULL, NULL);
+  c = pBt->kcmpr(pKey, kLen, pTKey, tkLen);
+  if (c > 0) {
+    for (int iPage = 0; iPage < pBtc->iPage; iPage++) {
+      if (pBtc->idxStack[iPage] < TDB_PAGE_TOTAL_CELLS(pBtc->pgStack[iPage])) {
+        goto _search_from_root;
+      }
+    }
+
+    *pCRst = c;
+    return 0;
+  } else if (c == 0) {
+    *pCRst = c;
+    return 0;
+  }
+
+  // compare the first cell
+  pBtc->idx = 0;
+  tdbBtcGet(pBtc, &pTKey, &tkLen, NULL, NULL);
+  c = pBt->kcmpr(pKey, kLen, pTKey, tkLen);
+  if (c < 0) {
+    goto _search_from_root;
+  }
+
+  // binary search between the first and the last cells
+  lidx = 1;
+  ridx = nCells - 2;
+  while (c != 0 && lidx <= ridx) {
+    pBtc->idx = (lidx + ridx) >> 1;
+    tdbBtcGet(pBtc, &pTKey, &tkLen, NULL, NULL);
+    c = pBt->kcmpr(pKey, kLen, pTKey, tkLen);
+    if (c < 0) {
+      ridx = pBtc->idx - 1;
+    } else if (c > 0) {
+      lidx = pBtc->idx + 1;
+    }
+  }
+
+  *pCRst = c;
+  return 0;
+
+_search_from_root:
+  tdbBtcReset(pBtc);
+  return tdbBtcMoveTo(pBtc, pKey, kLen, pCRst);
+}
+
+int tdbBtreeUpsertBatch(SBTree *pBt, const STbRecord *pRecords, int32_t nRecords, TXN *pTxn) {
+  SBTC     btc;
+  int32_t *aIdx;
+  SPage   *pLeaf;
+  i8       iLeaf;
+  int      ret = 0;
+  int      c;
+
+  if (nRecords <= 0) return 0;
+
+  // sort the records by the key of the tree, so the records next to each other go to the same leaf mostly
+  aIdx = (int32_t *)tdbOsMalloc(sizeof(int32_t) * nRecords);
+  if (aIdx == NULL) {
+    tdbError("tdb/btree-upsert-batch: malloc failed, nRecords: %d.", nRecords);
+    return -1;
+  }
+  for (int32_t i = 0; i < nRecords; i++) {
+    aIdx[i] = i;
+  }
+  SBtreeBatchCmprArg arg = {.pRecords = pRecords, .kcmpr = pBt->kcmpr};
+  taosqsort(aIdx, nRecords, sizeof(int32_t), &arg, tdbBtreeBatchCmprFn);
+
+  tdbBtcOpen(&btc, pBt, pTxn);
+
+  for (int32_t i = 0; i < nRecords; i++) {
+    const STbRecord *pRecord = pRecords + aIdx[i];
+
+    ret = tdbBtcMoveToNearby(&btc, pRecord->pKey, pRecord->kLen, &c);
+    if (ret < 0) {
+      tdbError("tdb/btree-upsert-batch: btc move to failed with ret: %d.", ret);
+      break;
+    }
+
+    if (btc.idx == -1) {
+      btc.idx = 0;
+    } else if (c > 0) {
+      btc.idx++;
+    } else if (c == 0) {
+      // replace the existing key as tdbTbUpsert does, which is rare for a batch
+      tdbBtcReset(&btc);
+      tdbBtreeDelete(pBt, pRecord->pKey, pRecord->kLen, pTxn);
+      ret = tdbBtreeInsert(pBt, pRecord->pKey, pRecord->kLen, pRecord->pVal, pRecord->vLen, pTxn);
+      if (ret < 0) break;
+      continue;
+    }
+
+    pLeaf = btc.pPage;
+    iLeaf = btc.iPage;
+    ret = tdbBtcUpsert(&btc, pRecord->pKey, pRecord->kLen, pRecord->pVal, pRecord->vLen, 1);
+    if (ret < 0) {
+      tdbError("tdb/btree-upsert-batch: btc upsert failed with ret: %d.", ret);
+      break;
+    }
+
+    // the pages on the cursor are changed by the balance, so search from the root for the next key
+    if (btc.iPage != iLeaf || btc.pPage != pLeaf || !TDB_BTREE_PAGE_IS_LEAF(btc.pPage)) {
+      tdbBtcReset(&btc);
+    }
+  }
+
+  tdbBtcClose(&btc);
+  tdbOsFree(aIdx);
+  return ret;
+}
+
 #if 0
 int tdbBtreeUpsert(SBTree *pBt, const void *pKey, int nKey, const void *pData, int nData, TXN *pTxn) {
   SBTC btc = {0};
@@ -17,18 +17,41 @@
 // #include <sys/types.h>
 // #include <unistd.h>
 
+/*
+ * The pages are partitioned into shards by the hash of the pgid, and each shard has its own lock, free list, lru list
+ * and hash table, so the readers of the different pages do not serialize on one lock. A page stays in the shard it is
+ * assigned to when the cache is opened or altered.
+ *
+ * A page pinned by others can be fetched without the lock: the reader walks the hash chain, increases the nRef only
+ * if it is not zero, and checks the pgid and the nMod of the shard. The nMod is increased before and after a local
+ * page is removed from the hash, so an even and unchanged nMod means the page stays in the hash during the lookup.
+ * Hence the local pages are only destroyed when the cache is closed, and the pages allocated by the txns are kept in
+ * another hash table that is never accessed without the lock.
+ */
+#define TDB_PCACHE_MAX_SHARDS      16
+#define TDB_PCACHE_MIN_SHARD_PAGES 64
+
+typedef struct {
+  tdb_mutex_t  mutex;
+  volatile i32 nMod;
+  int          nFree;
+  SPage       *pFree;
+  SPage       *pRetired;  // the local pages beyond nPages after the cache is shrunk
+  int          nPage;
+  int          nHash;
+  SPage      **pgHash;
+  SPage      **pgHashTxn;
+  int          nRecyclable;
+  SPage        lru;
+} SPCacheShard;
+
 struct SPCache {
-  int         szPage;
-  int         nPages;
-  SPage     **aPage;
-  tdb_mutex_t mutex;
-  int         nFree;
-  SPage      *pFree;
-  int         nPage;
-  int         nHash;
-  SPage     **pgHash;
-  int         nRecyclable;
-  SPage       lru;
+  int           szPage;
+  int           nPages;
+  int           nAlloc;
+  SPage       **aPage;
+  int           nShard;
+  SPCacheShard *aShard;
 };
 
 static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
@@ -36,25 +59,65 @@ static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
   return (uint32_t)(t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + (pPgid)->pgno);
 }
 
+#define TDB_PCACHE_SHARD(pCache, h)   (&(pCache)->aShard[(h) % (pCache)->nShard])
+#define TDB_PCACHE_BUCKET(pCache, pShard, h) (((h) / (pCache)->nShard) % (pShard)->nHash)
+
+static inline bool tdbPCachePgidEqual(const SPgid *pPgid1, const SPgid *pPgid2) {
+  return pPgid1->pgno == pPgid2->pgno && memcmp(pPgid1->fileid, pPgid2->fileid, TDB_FILE_ID_LEN) == 0;
+}
+
 static int    tdbPCacheOpenImpl(SPCache *pCache);
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
-static void   tdbPCachePinPage(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage);
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h, TXN *pTxn);
+static SPage *tdbPCacheFetchPinned(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h, TXN *pTxn);
+static SPage *tdbPCacheFindPage(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h);
+static void   tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheAddPageToHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
 static int    tdbPCacheCloseImpl(SPCache *pCache);
 
-static void tdbPCacheInitLock(SPCache *pCache) { tdbMutexInit(&(pCache->mutex), NULL); }
-static void tdbPCacheDestroyLock(SPCache *pCache) { tdbMutexDestroy(&(pCache->mutex)); }
-static void tdbPCacheLock(SPCache *pCache) { tdbMutexLock(&(pCache->mutex)); }
-static void tdbPCacheUnlock(SPCache *pCache) { tdbMutexUnlock(&(pCache->mutex)); }
+static void tdbPCacheInitLock(SPCacheShard *pShard) { tdbMutexInit(&(pShard->mutex), NULL); }
+static void tdbPCacheDestroyLock(SPCacheShard *pShard) { tdbMutexDestroy(&(pShard->mutex)); }
+static void tdbPCacheLock(SPCacheShard *pShard) { tdbMutexLock(&(pShard->mutex)); }
+static void tdbPCacheUnlock(SPCacheShard *pShard) { tdbMutexUnlock(&(pShard->mutex)); }
+
+static SPCacheShard *tdbPCachePageShard(SPCache *pCache, SPage *pPage) {
+  return TDB_PCACHE_SHARD(pCache, tdbPCachePageHash(&(pPage->pgid)));
+}
+
+static int tdbPCacheNewLocalPage(SPCache *pCache, int32_t iPage) {
+  SPage *pPage;
+
+  if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
+    return -1;
+  }
+
+  // pPage->pgid = 0;
+  pPage->isAnchor = 0;
+  pPage->isLocal = 1;
+  pPage->nRef = 0;
+  pPage->pHashNext = NULL;
+  pPage->pLruNext = NULL;
+  pPage->pLruPrev = NULL;
+  pPage->pDirtyNext = NULL;
+
+  // add to local list
+  pPage->id = iPage;
+  pCache->aPage[iPage] = pPage;
+
+  // add page to the free list of its shard
+  SPCacheShard *pShard = &pCache->aShard[iPage % pCache->nShard];
+  pPage->pFreeNext = pShard->pFree;
+  pShard->pFree = pPage;
+  pShard->nFree++;
+
+  return 0;
+}
 
 int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
   SPCache *pCache;
-  void    *pPtr;
-  SPage   *pPgHdr;
 
-  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache) + sizeof(SPage *) * cacheSize);
+  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache));
   if (pCache == NULL) {
     return -1;
   }
@@ -67,7 +130,22 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
     return -1;
   }
 
+  // small caches keep one shard, so that a shard does not run out of pages easily
+  pCache->nShard = 1;
+  while (pCache->nShard < TDB_PCACHE_MAX_SHARDS && cacheSize / (pCache->nShard * 2) >= TDB_PCACHE_MIN_SHARD_PAGES) {
+    pCache->nShard *= 2;
+  }
+  pCache->aShard = (SPCacheShard *)tdbOsCalloc(pCache->nShard, sizeof(SPCacheShard));
+  if (pCache->aShard == NULL) {
+    tdbOsFree(pCache->aPage);
+    tdbOsFree(pCache);
+    return -1;
+  }
+
   if (tdbPCacheOpenImpl(pCache) < 0) {
+    tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aShard);
+    tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
     return -1;
   }
@@ -79,74 +157,70 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
 int tdbPCacheClose(SPCache *pCache) {
   if (pCache) {
     tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aShard);
     tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
   }
   return 0;
 }
 
-// TODO:
-// if (pPage->id >= pCache->nPages) {
-//   free(pPage);
-//   pCache->aPage[pPage->id] = NULL;
-// } else {
-//   add to free list
-// }
-
 static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
   if (pCache->nPages == nPage) {
     return 0;
   } else if (pCache->nPages < nPage) {
-    SPage **aPage = tdbOsCalloc(nPage, sizeof(SPage *));
-    if (aPage == NULL) {
-      return -1;
-    }
-
-    for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      if (tdbPageCreate(pCache->szPage, &aPage[iPage], tdbDefaultMalloc, NULL) < 0) {
-        // TODO: handle error
-        tdbOsFree(aPage);
+    if (pCache->nAlloc < nPage) {
+      SPage **aPage = tdbOsCalloc(nPage, sizeof(SPage *));
+      if (aPage == NULL) {
         return -1;
       }
 
-      // pPage->pgid = 0;
-      aPage[iPage]->isAnchor = 0;
-      aPage[iPage]->isLocal = 1;
-      aPage[iPage]->nRef = 0;
-      aPage[iPage]->pHashNext = NULL;
-      aPage[iPage]->pLruNext = NULL;
-      aPage[iPage]->pLruPrev = NULL;
-      aPage[iPage]->pDirtyNext = NULL;
-
-      // add to local list
-      aPage[iPage]->id = iPage;
-    }
+      for (int32_t iPage = 0; iPage < pCache->nAlloc; iPage++) {
+        aPage[iPage] = pCache->aPage[iPage];
+      }
 
-    // add page to free list
-    for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      aPage[iPage]->pFreeNext = pCache->pFree;
-      pCache->pFree = aPage[iPage];
-      pCache->nFree++;
+      tdbOsFree(pCache->aPage);
+      pCache->aPage = aPage;
     }
 
-    for (int32_t iPage = 0; iPage < pCache->nPages; iPage++) {
-      aPage[iPage] = pCache->aPage[iPage];
+    // reuse the retired pages first
+    for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+      SPCacheShard *pShard = &pCache->aShard[iShard];
+      for (SPage **ppPage = &pShard->pRetired; *ppPage;) {
+        SPage *pPage = *ppPage;
+
+        if (pPage->id < nPage) {
+          *ppPage = pPage->pFreeNext;
+          pPage->pFreeNext = pShard->pFree;
+          pShard->pFree = pPage;
+          pShard->nFree++;
+        } else {
+          ppPage = &pPage->pFreeNext;
+        }
+      }
     }
 
-    tdbOsFree(pCache->aPage);
-    pCache->aPage = aPage;
+    for (int32_t iPage = pCache->nAlloc; iPage < nPage; iPage++) {
+      if (tdbPCacheNewLocalPage(pCache, iPage) < 0) {
+        pCache->nPages = TMAX(pCache->nPages, iPage);
+        return -1;
+      }
+      pCache->nAlloc = iPage + 1;
+    }
   } else {
-    for (SPage **ppPage = &pCache->pFree; *ppPage;) {
-      int32_t iPage = (*ppPage)->id;
-
-      if (iPage >= nPage) {
+    // the pages may still be accessed by the lock-free lookups, so they are retired instead of destroyed
+    for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+      SPCacheShard *pShard = &pCache->aShard[iShard];
+      for (SPage **ppPage = &pShard->pFree; *ppPage;) {
         SPage *pPage = *ppPage;
-        *ppPage = pPage->pFreeNext;
-        pCache->aPage[pPage->id] = NULL;
-        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-        pCache->nFree--;
-      } else {
-        ppPage = &(*ppPage)->pFreeNext;
+
+        if (pPage->id >= nPage) {
+          *ppPage = pPage->pFreeNext;
+          pPage->pFreeNext = pShard->pRetired;
+          pShard->pRetired = pPage;
+          pShard->nFree--;
+        } else {
+          ppPage = &pPage->pFreeNext;
+        }
       }
     }
   }
@@ -158,27 +232,41 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
 int tdbPCacheAlter(SPCache *pCache, int32_t nPage) {
   int ret = 0;
 
-  tdbPCacheLock(pCache);
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    tdbPCacheLock(&pCache->aShard[iShard]);
+  }
 
   ret = tdbPCacheAlterImpl(pCache, nPage);
 
-  tdbPCacheUnlock(pCache);
+  for (int32_t iShard = pCache->nShard - 1; iShard >= 0; iShard--) {
+    tdbPCacheUnlock(&pCache->aShard[iShard]);
+  }
 
   return ret;
 }
 
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  SPage *pPage;
-  i32    nRef = 0;
+  SPage        *pPage;
+  i32           nRef = 0;
+  uint32_t      h = tdbPCachePageHash(pPgid);
+  SPCacheShard *pShard = TDB_PCACHE_SHARD(pCache, h);
+
+  if (pTxn) {
+    pPage = tdbPCacheFetchPinned(pCache, pShard, pPgid, h, pTxn);
+    if (pPage) {
+      tdbTrace("pcache/fetch pinned page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
+      return pPage;
+    }
+  }
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLock(pShard);
 
-  pPage = tdbPCacheFetchImpl(pCache, pPgid, pTxn);
+  pPage = tdbPCacheFetchImpl(pCache, pShard, pPgid, h, pTxn);
   if (pPage) {
     nRef = tdbRefPage(pPage);
   }
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 
   // printf("thread %" PRId64 " fetch page %d pgno %d pPage %p nRef %d\n", taosGetSelfPthreadId(), pPage->id,
   //        TDB_PAGE_PGNO(pPage), pPage, nRef);
@@ -193,92 +281,147 @@ SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
 }
 
 void tdbPCacheMarkFree(SPCache *pCache, SPage *pPage) {
-  tdbPCacheLock(pCache);
-  tdbPCacheRemovePageFromHash(pCache, pPage);
+  SPCacheShard *pShard = tdbPCachePageShard(pCache, pPage);
+
+  tdbPCacheLock(pShard);
+  tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
   pPage->isFree = 1;
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
-static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheFreePage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
+  tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
+  pPage->isFree = 0;
+
   if (pPage->id < pCache->nPages) {
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pPage->isFree = 0;
-    ++pCache->nFree;
+    pPage->pFreeNext = pShard->pFree;
+    pShard->pFree = pPage;
+    ++pShard->nFree;
     tdbTrace("pcache/free page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   } else {
     tdbTrace("pcache/free2 page: %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+    pPage->pFreeNext = pShard->pRetired;
+    pShard->pRetired = pPage;
   }
 }
 
 void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
-  SPgid        pgid;
-  const SPgid *pPgid = &pgid;
-  SPage       *pPage = NULL;
+  SPgid         pgid;
+  SPage        *pPage = NULL;
+  uint32_t      h;
+  SPCacheShard *pShard;
 
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
+  h = tdbPCachePageHash(&pgid);
+  pShard = TDB_PCACHE_SHARD(pCache, h);
 
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
+  tdbPCacheLock(pShard);
 
+  pPage = tdbPCacheFindPage(pCache, pShard, &pgid, h);
   if (pPage) {
-    bool moveToFreeList = false;
     if (pPage->pLruNext) {
-      tdbPCachePinPage(pCache, pPage);
-      moveToFreeList = true;
-    }
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    if (moveToFreeList) {
-      tdbPCacheFreePage(pCache, pPage);
+      tdbPCachePinPage(pShard, pPage);
+      tdbPCacheFreePage(pCache, pShard, pPage);
+    } else {
+      tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
     }
   }
+
+  tdbPCacheUnlock(pShard);
 }
 
 void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
-  i32 nRef;
+  i32           nRef;
+  SPCacheShard *pShard;
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, release failed.");
     return;
   }
 
-  tdbPCacheLock(pCache);
+  pShard = tdbPCachePageShard(pCache, pPage);
+
+  tdbPCacheLock(pShard);
   nRef = tdbUnrefPage(pPage);
   tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
   if (nRef == 0) {
-    // test the nRef again to make sure
-    // it is safe th handle the page
-    // nRef = tdbGetPageRef(pPage);
-    // if (nRef == 0) {
+    // the lock-free lookups never increase a zero nRef, so it is safe to handle the page
     if (pPage->isLocal) {
       if (!pPage->isFree) {
-        tdbPCacheUnpinPage(pCache, pPage);
+        tdbPCacheUnpinPage(pCache, pShard, pPage);
       } else {
-        tdbPCacheFreePage(pCache, pPage);
+        tdbPCacheFreePage(pCache, pShard, pPage);
       }
     } else {
       if (TDB_TXN_IS_WRITE(pTxn)) {
         // remove from hash
-        tdbPCacheRemovePageFromHash(pCache, pPage);
+        tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
       }
 
       tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
     }
-    // }
   }
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
 int tdbPCacheGetPageSize(SPCache *pCache) { return pCache->szPage; }
 
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
+static SPage *tdbPCacheFetchPinned(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h, TXN *pTxn) {
+  SPage *pPage;
+  i32    nMod = atomic_load_32(&pShard->nMod);
+  i32    nRef;
+
+  if (nMod & 1) {
+    return NULL;
+  }
+
+  pPage = atomic_load_ptr(&pShard->pgHash[TDB_PCACHE_BUCKET(pCache, pShard, h)]);
+  while (pPage) {
+    if (tdbPCachePgidEqual(&pPage->pgid, pPgid)) break;
+    // a removal may link the page to another chain, so stop the walk then
+    if (atomic_load_32(&pShard->nMod) != nMod) return NULL;
+    pPage = atomic_load_ptr(&pPage->pHashNext);
+  }
+
+  if (pPage == NULL) {
+    return NULL;
+  }
+
+  // only the pages pinned by others, the ones in the lru list need the lock to be pinned
+  do {
+    nRef = tdbGetPageRef(pPage);
+    if (nRef <= 0) {
+      return NULL;
+    }
+  } while (atomic_val_compare_exchange_32(&pPage->nRef, nRef, nRef + 1) != nRef);
+
+  // the page can not be recycled now, but it may be removed from the hash after it is found
+  if (atomic_load_32(&pShard->nMod) != nMod || !tdbPCachePgidEqual(&pPage->pgid, pPgid) || !pPage->isLocal ||
+      pPage->isFree) {
+    tdbPCacheRelease(pCache, pPage, pTxn);
+    return NULL;
+  }
+
+  return pPage;
+}
+
+static SPage *tdbPCacheFindPage(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h) {
+  uint32_t bucket = TDB_PCACHE_BUCKET(pCache, pShard, h);
+
+  for (SPage *pPage = pShard->pgHash[bucket]; pPage; pPage = pPage->pHashNext) {
+    if (tdbPCachePgidEqual(&pPage->pgid, pPgid)) return pPage;
+  }
+
+  for (SPage *pPage = pShard->pgHashTxn[bucket]; pPage; pPage = pPage->pHashNext) {
+    if (tdbPCachePgidEqual(&pPage->pgid, pPgid)) return pPage;
+  }
+
+  return NULL;
+}
+
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, uint32_t h, TXN *pTxn) {
   int    ret = 0;
   SPage *pPage = NULL;
   SPage *pPageH = NULL;
@@ -289,15 +432,11 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   }
 
   // 1. Search the hash table
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
+  pPage = tdbPCacheFindPage(pCache, pShard, pPgid, h);
 
   if (pPage) {
     if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-      tdbPCachePinPage(pCache, pPage);
+      tdbPCachePinPage(pShard, pPage);
       return pPage;
     }
   }
@@ -308,18 +447,18 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   pPage = NULL;
 
   // 2. Try to allocate a new page from the free list
-  if (pCache->pFree) {
-    pPage = pCache->pFree;
-    pCache->pFree = pPage->pFreeNext;
-    pCache->nFree--;
+  if (pShard->pFree) {
+    pPage = pShard->pFree;
+    pShard->pFree = pPage->pFreeNext;
+    pShard->nFree--;
     pPage->pLruNext = NULL;
   }
 
   // 3. Try to Recycle a page
-  if (!pPageH && !pPage && !pCache->lru.pLruPrev->isAnchor) {
-    pPage = pCache->lru.pLruPrev;
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPCachePinPage(pCache, pPage);
+  if (!pPageH && !pPage && !pShard->lru.pLruPrev->isAnchor) {
+    pPage = pShard->lru.pLruPrev;
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
+    tdbPCachePinPage(pShard, pPage);
   }
 
   // 4. Try a create new page
@@ -371,7 +510,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
       pPage->pPager = NULL;
 
       if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-        tdbPCacheAddPageToHash(pCache, pPage);
+        tdbPCacheAddPageToHash(pCache, pShard, pPage);
       }
     }
   }
@@ -379,7 +518,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   return pPage;
 }
 
-static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage) {
   if (pPage->pLruNext != NULL) {
     int32_t nRef = tdbGetPageRef(pPage);
     if (nRef != 0) {
@@ -391,13 +530,13 @@ static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
     pPage->pLruNext->pLruPrev = pPage->pLruPrev;
     pPage->pLruNext = NULL;
 
-    pCache->nRecyclable--;
+    pShard->nRecyclable--;
 
     tdbTrace("pcache/pin page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   }
 }
 
-static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
   i32 nRef = tdbGetPageRef(pPage);
   if (nRef != 0) {
     tdbError("tdb/pcache: unpin page's ref not zero: %" PRId32, nRef);
@@ -419,121 +558,121 @@ static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
   tdbTrace("pCache:%p unpin page %p/%d, nPages:%d, pgno:%d, ", pCache, pPage, pPage->id, pCache->nPages,
            TDB_PAGE_PGNO(pPage));
   if (pPage->id < pCache->nPages) {
-    pPage->pLruPrev = &(pCache->lru);
-    pPage->pLruNext = pCache->lru.pLruNext;
-    pCache->lru.pLruNext->pLruPrev = pPage;
-    pCache->lru.pLruNext = pPage;
+    pPage->pLruPrev = &(pShard->lru);
+    pPage->pLruNext = pShard->lru.pLruNext;
+    pShard->lru.pLruNext->pLruPrev = pPage;
+    pShard->lru.pLruNext = pPage;
 
-    pCache->nRecyclable++;
+    pShard->nRecyclable++;
 
     // printf("unpin page %d pgno %d pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
     tdbTrace("pcache/unpin page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
   } else {
-    tdbTrace("pcache destroy page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
+    tdbTrace("pcache retire page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+    tdbPCacheRemovePageFromHash(pCache, pShard, pPage);
+    pPage->pFreeNext = pShard->pRetired;
+    pShard->pRetired = pPage;
   }
 }
 
-static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = TDB_PCACHE_BUCKET(pCache, pShard, tdbPCachePageHash(&(pPage->pgid)));
 
-  SPage **ppPage = &(pCache->pgHash[h]);
+  SPage **ppPage = pPage->isLocal ? &(pShard->pgHash[h]) : &(pShard->pgHashTxn[h]);
   for (; (*ppPage) && *ppPage != pPage; ppPage = &((*ppPage)->pHashNext))
     ;
 
   if (*ppPage) {
-    *ppPage = pPage->pHashNext;
-    pCache->nPage--;
+    if (pPage->isLocal) {
+      // make the lock-free lookups in this shard retry with the lock
+      (void)atomic_add_fetch_32(&pShard->nMod, 1);
+      atomic_store_ptr(ppPage, pPage->pHashNext);
+      (void)atomic_add_fetch_32(&pShard->nMod, 1);
+    } else {
+      *ppPage = pPage->pHashNext;
+    }
+    pShard->nPage--;
     // printf("rmv page %d to hash, pgno %d, pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
   }
 
   tdbTrace("pcache/remove page %p/%d from hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
-static void tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheAddPageToHash(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = TDB_PCACHE_BUCKET(pCache, pShard, tdbPCachePageHash(&(pPage->pgid)));
 
-  pPage->pHashNext = pCache->pgHash[h];
-  pCache->pgHash[h] = pPage;
+  if (pPage->isLocal) {
+    atomic_store_ptr(&pPage->pHashNext, pShard->pgHash[h]);
+    atomic_store_ptr(&pShard->pgHash[h], pPage);
+  } else {
+    pPage->pHashNext = pShard->pgHashTxn[h];
+    pShard->pgHashTxn[h] = pPage;
+  }
 
-  pCache->nPage++;
+  pShard->nPage++;
 
   tdbTrace("pcache/add page %p/%d to hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
 static int tdbPCacheOpenImpl(SPCache *pCache) {
-  SPage *pPage;
-  u8    *pPtr;
-  int    tsize;
-  int    ret;
+  int nHash = pCache->nPages / pCache->nShard;
 
-  tdbPCacheInitLock(pCache);
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
 
-  // Open the free list
-  pCache->nFree = 0;
-  pCache->pFree = NULL;
-  for (int i = 0; i < pCache->nPages; i++) {
-    if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
-      // TODO: handle error
+    tdbPCacheInitLock(pShard);
+
+    // Open the hash tables
+    pShard->nPage = 0;
+    pShard->nHash = nHash < 8 ? 8 : nHash;
+    pShard->pgHash = (SPage **)tdbOsCalloc(pShard->nHash, sizeof(SPage *));
+    pShard->pgHashTxn = (SPage **)tdbOsCalloc(pShard->nHash, sizeof(SPage *));
+    if (pShard->pgHash == NULL || pShard->pgHashTxn == NULL) {
       return -1;
     }
 
-    // pPage->pgid = 0;
-    pPage->isAnchor = 0;
-    pPage->isLocal = 1;
-    pPage->nRef = 0;
-    pPage->pHashNext = NULL;
-    pPage->pLruNext = NULL;
-    pPage->pLruPrev = NULL;
-    pPage->pDirtyNext = NULL;
-
-    // add page to free list
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pCache->nFree++;
-
-    // add to local list
-    pPage->id = i;
-    pCache->aPage[i] = pPage;
+    // Open LRU list
+    pShard->nRecyclable = 0;
+    pShard->lru.isAnchor = 1;
+    pShard->lru.pLruNext = &(pShard->lru);
+    pShard->lru.pLruPrev = &(pShard->lru);
   }
 
-  // Open the hash table
-  pCache->nPage = 0;
-  pCache->nHash = pCache->nPages < 8 ? 8 : pCache->nPages;
-  pCache->pgHash = (SPage **)tdbOsCalloc(pCache->nHash, sizeof(SPage *));
-  if (pCache->pgHash == NULL) {
-    // TODO
-    return -1;
+  // Open the free lists
+  for (int i = 0; i < pCache->nPages; i++) {
+    if (tdbPCacheNewLocalPage(pCache, i) < 0) {
+      return -1;
+    }
+    pCache->nAlloc = i + 1;
   }
 
-  // Open LRU list
-  pCache->nRecyclable = 0;
-  pCache->lru.isAnchor = 1;
-  pCache->lru.pLruNext = &(pCache->lru);
-  pCache->lru.pLruPrev = &(pCache->lru);
-
   return 0;
 }
 
 static int tdbPCacheCloseImpl(SPCache *pCache) {
-  // free free page
-  for (SPage *pPage = pCache->pFree; pPage;) {
-    SPage *pPageT = pPage->pFreeNext;
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-    pPage = pPageT;
-  }
-
-  for (int32_t iBucket = 0; iBucket < pCache->nHash; iBucket++) {
-    for (SPage *pPage = pCache->pgHash[iBucket]; pPage;) {
-      SPage *pPageT = pPage->pHashNext;
-      tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-      pPage = pPageT;
+  // all the local pages are in aPage, whether they are free, in the lru list, pinned or retired
+  for (int32_t iPage = 0; iPage < pCache->nAlloc; iPage++) {
+    tdbPageDestroy(pCache->aPage[iPage], tdbDefaultFree, NULL);
+  }
+
+  for (int32_t iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
+
+    if (pShard->pgHashTxn) {
+      for (int32_t iBucket = 0; iBucket < pShard->nHash; iBucket++) {
+        for (SPage *pPage = pShard->pgHashTxn[iBucket]; pPage;) {
+          SPage *pPageT = pPage->pHashNext;
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+          pPage = pPageT;
+        }
+      }
     }
+
+    tdbOsFree(pShard->pgHash);
+    tdbOsFree(pShard->pgHashTxn);
+    tdbPCacheDestroyLock(pShard);
   }
 
-  tdbOsFree(pCache->pgHash);
-  tdbPCacheDestroyLock(pCache);
   return 0;
 }
@@ -206,6 +206,10 @@ int tdbTbUpsert(TTB *pTb, const void *pKey, int kLen, const void *pVal, int vLen
   return tdbTbInsert(pTb, pKey, kLen, pVal, vLen, pTxn);
 }
 
+int tdbTbUpsertBatch(TTB *pTb, const STbRecord *pRecords, int32_t nRecords, TXN *pTxn) {
+  return tdbBtreeUpsertBatch(pTb->pBt, pRecords, nRecords, pTxn);
+}
+
 int tdbTbGet(TTB *pTb, const void *pKey, int kLen, void **ppVal, int *vLen) {
   return tdbBtreeGet(pTb->pBt, pKey, kLen, ppVal, vLen);
 }
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdb.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Concurrent point lookups on one table, like the meta readers of a vnode that fetch the same b-tree pages from many
+// query threads, to compare the throughput of the page cache with the different number of threads.
+
+static const int nKeys = 200000;
+
+static void buildKey(char *key, int i) { sprintf(key, "key%08d", i); }
+static void buildVal(char *val, int i) { sprintf(val, "value%08d", i); }
+
+static void *benchMalloc(void *arg, size_t size) { return taosMemoryMalloc(size); }
+static void  benchFree(void *arg, void *ptr) { taosMemoryFree(ptr); }
+
+static TDB *openBenchEnv(int pageSize, int cacheSize, TTB **ppTb) {
+  TDB *pEnv = NULL;
+  TXN *txn = NULL;
+  char key[64];
+  char val[64];
+
+  taosRemoveDir("tdb_pcache_bench");
+  if (tdbOpen("tdb_pcache_bench", pageSize, cacheSize, &pEnv, 0, 0, NULL) < 0) {
+    return NULL;
+  }
+
+  if (tdbTbOpen("bench.db", -1, -1, NULL, pEnv, ppTb, 0) < 0) {
+    tdbClose(pEnv);
+    return NULL;
+  }
+
+  if (tdbBegin(pEnv, &txn, benchMalloc, benchFree, NULL, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED) < 0) {
+    tdbClose(pEnv);
+    return NULL;
+  }
+
+  for (int i = 0; i < nKeys; i++) {
+    buildKey(key, i);
+    buildVal(val, i);
+    if (tdbTbInsert(*ppTb, key, strlen(key), val, strlen(val), txn) < 0) {
+      tdbAbort(pEnv, txn);
+      tdbClose(pEnv);
+      return NULL;
+    }
+  }
+
+  if (tdbCommit(pEnv, txn) < 0 || tdbPostCommit(pEnv, txn) < 0) {
+    tdbClose(pEnv);
+    return NULL;
+  }
+
+  return pEnv;
+}
+
+// each thread looks up nGets random keys, and the number of the wrong values is returned
+static int64_t runGets(TTB *pTb, int nThreads, int nGets, double *pOps) {
+  std::atomic<int64_t>     nWrong(0);
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int iThread = 0; iThread < nThreads; iThread++) {
+    threads.emplace_back([pTb, nGets, iThread, &nWrong]() {
+      std::mt19937 rng(iThread + 1);
+      char         key[64];
+      char         val[64];
+      void        *pVal = NULL;
+      int          vLen = 0;
+
+      for (int iGet = 0; iGet < nGets; iGet++) {
+        int i = rng() % nKeys;
+        buildKey(key, i);
+        buildVal(val, i);
+        if (tdbTbGet(pTb, key, strlen(key), &pVal, &vLen) < 0 || vLen != (int)strlen(val) ||
+            memcmp(pVal, val, vLen) != 0) {
+          nWrong++;
+        }
+      }
+      tdbFree(pVal);
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  *pOps = (double)nThreads * nGets / seconds;
+  return nWrong.load();
+}
+
+TEST(TdbPCacheBenchTest, concurrent_get) {
+  TTB *pTb = NULL;
+  TDB *pEnv = openBenchEnv(4096, 1024, &pTb);
+  ASSERT_NE(pEnv, nullptr);
+
+  int nGets = 50000;
+  for (int nThreads = 1; nThreads <= 16; nThreads *= 2) {
+    double ops = 0;
+    GTEST_ASSERT_EQ(runGets(pTb, nThreads, nGets, &ops), 0);
+    printf("tdbTbGet threads:%2d, %.0f ops/s\n", nThreads, ops);
+  }
+
+  tdbTbClose(pTb);
+  tdbClose(pEnv);
+  taosRemoveDir("tdb_pcache_bench");
+}
+
+// the cache is much smaller than the table, so that the pages are recycled all the time during the lookups
+TEST(TdbPCacheBenchTest, concurrent_get_recycle) {
+  TTB *pTb = NULL;
+  TDB *pEnv = openBenchEnv(1024, 256, &pTb);
+  ASSERT_NE(pEnv, nullptr);
+
+  std::atomic<bool> stop(false);
+  std::thread       alter([pEnv, &stop]() {
+    for (int i = 0; !stop.load(); i++) {
+      GTEST_ASSERT_EQ(tdbAlter(pEnv, (i % 2) ? 256 : 160), 0);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  double ops = 0;
+  GTEST_ASSERT_EQ(runGets(pTb, 8, 50000, &ops), 0);
+  printf("tdbTbGet with recycling threads:8, %.0f ops/s\n", ops);
+
+  stop = true;
+  alter.join();
+
+  tdbTbClose(pTb);
+  tdbClose(pEnv);
+  taosRemoveDir("tdb_pcache_bench");
+}
@@ -4,6 +4,8 @@
 #include "os.h"
 #include "tdb.h"
 
+#include <map>
+#include <random>
 #include <shared_mutex>
 #include <string>
 #include <thread>
@@ -518,6 +520,98 @@ TEST(tdb_test, simple_upsert2) {
   tdbClose(pEnv);
 }
 
+TEST(tdb_test, upsert_batch) {
+  int          ret;
+  TDB         *pEnv;
+  TTB         *pDb;
+  int          nData = 100000;
+  int          nBatch = 1000;
+  SPoolMem    *pPool;
+  TXN         *txn;
+  std::mt19937 rng(2024);
+
+  taosRemoveDir("tdb");
+
+  // open env
+  ret = tdbOpen("tdb", 4096, 64, &pEnv, 0, 0, NULL);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  // open database
+  ret = tdbTbOpen("db.db", -1, -1, tKeyCmpr, pEnv, &pDb, 0);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  pPool = openPool();
+  tdbBegin(pEnv, &txn, poolMalloc, poolFree, pPool, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+
+  // the first half is appended in ascending order, the other half and the updates are in random order, and the
+  // same key may appear twice in a batch
+  std::vector<int> keys;
+  for (int iData = 0; iData < nData; iData++) {
+    keys.push_back(iData < nData / 2 ? iData : nData / 2 + rng() % nData);
+  }
+  for (int iData = 0; iData < nData / 10; iData++) {
+    keys.push_back(rng() % nData);
+  }
+
+  std::map<int, std::string> expect;
+  for (int start = 0; start < (int)keys.size(); start += nBatch) {
+    int                      end = std::min(start + nBatch, (int)keys.size());
+    std::vector<std::string> aKey, aVal;
+    std::vector<STbRecord>   records;
+
+    for (int i = start; i < end; i++) {
+      aKey.push_back("key" + std::to_string(keys[i]));
+      aVal.push_back("data" + std::to_string(i) + std::string(rng() % 8 == 0 ? 1000 : 0, 'x'));
+      expect[keys[i]] = aVal.back();
+    }
+    for (int i = 0; i < end - start; i++) {
+      records.push_back({aKey[i].c_str(), (int)aKey[i].size(), aVal[i].c_str(), (int)aVal[i].size()});
+    }
+
+    ret = tdbTbUpsertBatch(pDb, records.data(), records.size(), txn);
+    GTEST_ASSERT_EQ(ret, 0);
+  }
+
+  tdbCommit(pEnv, txn);
+  tdbPostCommit(pEnv, txn);
+
+  // query the data
+  void *pData = NULL;
+  int   vLen = 0;
+  for (auto &kv : expect) {
+    std::string key = "key" + std::to_string(kv.first);
+    ret = tdbTbGet(pDb, key.c_str(), key.size(), &pData, &vLen);
+    GTEST_ASSERT_EQ(ret, 0);
+    GTEST_ASSERT_EQ(std::string((char *)pData, vLen), kv.second);
+  }
+  tdbFree(pData);
+  pData = NULL;
+
+  // the keys are in order
+  TBC  *pDBC;
+  void *pKey = NULL;
+  int   kLen = 0;
+  ret = tdbTbcOpen(pDb, &pDBC, NULL);
+  GTEST_ASSERT_EQ(ret, 0);
+  tdbTbcMoveToFirst(pDBC);
+
+  auto iter = expect.begin();
+  while (tdbTbcNext(pDBC, &pKey, &kLen, &pData, &vLen) == 0) {
+    GTEST_ASSERT_NE(iter, expect.end());
+    GTEST_ASSERT_EQ(std::string((char *)pKey, kLen), "key" + std::to_string(iter->first));
+    ++iter;
+  }
+  GTEST_ASSERT_EQ(iter, expect.end());
+
+  tdbTbcClose(pDBC);
+  tdbFree(pKey);
+  tdbFree(pData);
+
+  closePool(pPool);
+  tdbTbClose(pDb);
+  tdbClose(pEnv);
+}
+
 TEST(tdb_test, multi_thread_query) {
   int           ret;
   TDB          *pEnv;
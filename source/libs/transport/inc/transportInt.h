@@ -69,6 +69,7 @@ typedef struct {
   int8_t        connLimitLock;  // 0: no lock. 1. lock
   int8_t        supportBatch;   // 0: no batch, 1: support batch
   int32_t       batchSize;
+  int32_t       muxWindow;  // 0: no multiplexing, n: max in-flight requests on the mux conn of a peer
   int32_t       timeToGetConn;
   int           index;
   void*         parent;
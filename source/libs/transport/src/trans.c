@@ -76,6 +76,7 @@ void* rpcOpen(const SRpcInit* pInit) {
   pRpc->connLimitLock = pInit->connLimitLock;
   pRpc->supportBatch = pInit->supportBatch;
   pRpc->batchSize = pInit->batchSize;
+  pRpc->muxWindow = pInit->muxWindow > 1 ? pInit->muxWindow : 0;
 
   pRpc->numOfThreads = pInit->numOfThreads > TSDB_MAX_RPC_THREADS ? TSDB_MAX_RPC_THREADS : pInit->numOfThreads;
   if (pRpc->numOfThreads <= 0) {
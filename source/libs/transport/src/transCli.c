@@ -26,6 +26,8 @@ typedef struct SConnList {
   queue     conns;
   int32_t   size;
   SMsgList* list;
+
+  struct SCliConn* muxConn;  // conn shared by the multiplexed requests to the peer
 } SConnList;
 
 typedef struct {
@@ -81,6 +83,12 @@ typedef struct SCliConn {
   char  dst[32];
 
   int64_t refId;
+
+  // mux conn, the requests in flight are the head of cliMsgs, and their responses are matched by seq
+  bool     mux;
+  bool     writing;  // a write is in progress, or the conn is connecting
+  int32_t  inflight;
+  uint64_t seq;
 } SCliConn;
 
 typedef struct SCliMsg {
@@ -93,6 +101,7 @@ typedef struct SCliMsg {
   uint64_t st;
   int      sent;  //(0: no send, 1: alread sent)
   queue    seqq;
+  uint64_t seq;  // seq on the mux conn
 } SCliMsg;
 
 typedef struct SCliThrd {
@@ -148,6 +157,15 @@ static SCliConn* getConnFromPool(SCliThrd* thread, char* key, bool* exceed);
 static void      addConnToPool(void* pool, SCliConn* conn);
 static void      doCloseIdleConn(void* param);
 
+// mux conn, one conn of each peer carries many requests in flight
+static FORCE_INLINE bool cliMuxEnabled(STrans* pTransInst, SCliMsg* pMsg);
+static SCliConn*         cliGetMuxConn(SCliThrd* pThrd, char* key);
+static void              cliMuxAttach(SCliThrd* pThrd, SCliConn* conn, char* key);
+static void              cliMuxFlush(SCliConn* conn);
+static void              cliMuxSendCb(uv_write_t* req, int status);
+static bool              cliHandleMuxResp(SCliConn* conn);
+static void              cliHandleMuxExcept(SCliConn* conn, int32_t code);
+
 // register conn timer
 static void cliConnTimeout(uv_timer_t* handle);
 // register timer for read
@@ -182,6 +200,7 @@ static void      cliDestroyConn(SCliConn* pConn, bool clear /*clear tcp handle o
 static void      cliDestroy(uv_handle_t* handle);
 static void      cliSend(SCliConn* pConn);
 static void      cliSendBatch(SCliConn* pConn);
+static int32_t   cliPrepareMsgHead(STrans* pTransInst, SCliMsg* pCliMsg);
 static void      cliDestroyConnMsgs(SCliConn* conn, bool destroy);
 
 static void    doFreeTimeoutMsg(void* param);
@@ -502,6 +521,10 @@ static void cliDestroyMsgInExhandle(int64_t refId) {
 }
 
 void cliHandleExceptImpl(SCliConn* pConn, int32_t code) {
+  if (pConn->mux) {
+    cliHandleMuxExcept(pConn, code);
+    return;
+  }
   if (transQueueEmpty(&pConn->cliMsgs)) {
     if (pConn->broken == true && CONN_NO_PERSIST_BY_APP(pConn)) {
       tTrace("%s conn %p handle except, persist:0", CONN_GET_INST_LABEL(pConn), pConn);
@@ -606,6 +629,11 @@ void* destroyConnPool(SCliThrd* pThrd) {
   void*      pool = pThrd->pool;
   SConnList* connList = taosHashIterate((SHashObj*)pool, NULL);
   while (connList != NULL) {
+    // the mux conn is closed with the other handles of the loop
+    if (connList->muxConn != NULL) {
+      connList->muxConn->list = NULL;
+      connList->muxConn = NULL;
+    }
     while (!QUEUE_IS_EMPTY(&connList->conns)) {
       queue*    h = QUEUE_HEAD(&connList->conns);
       SCliConn* c = QUEUE_DATA(h, SCliConn, q);
@@ -633,9 +661,7 @@ void* destroyConnPool(SCliThrd* pThrd) {
   return NULL;
 }
 
-static SCliConn* getConnFromPool(SCliThrd* pThrd, char* key, bool* exceed) {
-  void*      pool = pThrd->pool;
-  STrans*    pTranInst = pThrd->pTransInst;
+static SConnList* cliGetConnList(void* pool, char* key) {
   size_t     klen = strlen(key);
   SConnList* plist = taosHashGet((SHashObj*)pool, key, klen);
   if (plist == NULL) {
@@ -650,6 +676,12 @@ static SCliConn* getConnFromPool(SCliThrd* pThrd, char* key, bool* exceed) {
     QUEUE_INIT(&plist->conns);
     plist->list = nList;
   }
+  return plist;
+}
+
+static SCliConn* getConnFromPool(SCliThrd* pThrd, char* key, bool* exceed) {
+  STrans*    pTranInst = pThrd->pTransInst;
+  SConnList* plist = cliGetConnList(pThrd->pool, key);
 
   if (QUEUE_IS_EMPTY(&plist->conns)) {
     if (plist->list->numOfConn >= pTranInst->connLimitNum) {
@@ -675,22 +707,8 @@ static SCliConn* getConnFromPool(SCliThrd* pThrd, char* key, bool* exceed) {
 }
 
 static SCliConn* getConnFromPool2(SCliThrd* pThrd, char* key, SCliMsg** pMsg) {
-  void*      pool = pThrd->pool;
   STrans*    pTransInst = pThrd->pTransInst;
-  size_t     klen = strlen(key);
-  SConnList* plist = taosHashGet((SHashObj*)pool, key, klen);
-  if (plist == NULL) {
-    SConnList list = {0};
-    taosHashPut((SHashObj*)pool, key, klen, (void*)&list, sizeof(list));
-    plist = taosHashGet(pool, key, klen);
-
-    SMsgList* nList = taosMemoryCalloc(1, sizeof(SMsgList));
-    QUEUE_INIT(&nList->msgQ);
-    nList->numOfConn++;
-
-    QUEUE_INIT(&plist->conns);
-    plist->list = nList;
-  }
+  SConnList* plist = cliGetConnList(pThrd->pool, key);
 
   STraceId* trace = &(*pMsg)->msg.info.traceId;
   // no avaliable conn in pool
@@ -757,7 +775,8 @@ static SCliConn* getConnFromPool2(SCliThrd* pThrd, char* key, SCliMsg** pMsg) {
   return conn;
 }
 static void addConnToPool(void* pool, SCliConn* conn) {
-  if (conn->status == ConnInPool) {
+  // the mux conn is kept by its peer, not by the pool
+  if (conn->status == ConnInPool || conn->mux) {
     return;
   }
   allocConnRef(conn, true);
@@ -876,6 +895,8 @@ static void cliRecvCb(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
       if (pBuf->invalid) {
         cliHandleExcept(conn);
         break;
+      } else if (conn->mux) {
+        if (!cliHandleMuxResp(conn)) break;
       } else {
         cliHandleResp(conn);
       }
@@ -947,6 +968,9 @@ static void cliDestroyConn(SCliConn* conn, bool clear) {
     if (conn->status == ConnInPool) {
       list->size--;
     }
+    if (list->muxConn == conn) {
+      list->muxConn = NULL;
+    }
   }
 
   conn->list = NULL;
@@ -1053,6 +1077,43 @@ static void cliSendCb(uv_write_t* req, int status) {
   }
   uv_read_start((uv_stream_t*)pConn->stream, cliAllocRecvBufferCb, cliRecvCb);
 }
+static int32_t cliPrepareMsgHead(STrans* pTransInst, SCliMsg* pCliMsg) {
+  STransConnCtx* pCtx = pCliMsg->ctx;
+
+  STransMsg* pMsg = (STransMsg*)(&pCliMsg->msg);
+  if (pMsg->pCont == 0) {
+    pMsg->pCont = (void*)rpcMallocCont(0);
+    pMsg->contLen = 0;
+  }
+
+  int            msgLen = transMsgLenFromCont(pMsg->contLen);
+  STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
+
+  if (pHead->comp == 0) {
+    pHead->ahandle = pCtx != NULL ? (uint64_t)pCtx->ahandle : 0;
+    pHead->noResp = REQUEST_NO_RESP(pMsg) ? 1 : 0;
+    pHead->persist = REQUEST_PERSIS_HANDLE(pMsg) ? 1 : 0;
+    pHead->msgType = pMsg->msgType;
+    pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
+    pHead->release = REQUEST_RELEASE_HANDLE(pCliMsg) ? 1 : 0;
+    memcpy(pHead->user, pTransInst->user, strlen(pTransInst->user));
+    pHead->traceId = pMsg->info.traceId;
+    pHead->magicNum = htonl(TRANS_MAGIC_NUM);
+    pHead->version = TRANS_VER;
+    pHead->compatibilityVer = htonl(pTransInst->compatibilityVer);
+  }
+  pHead->timestamp = taosHton64(taosGetTimestampUs());
+
+  if (pHead->comp == 0) {
+    if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
+      msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+      pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
+    }
+  } else {
+    msgLen = (int32_t)ntohl((uint32_t)(pHead->msgLen));
+  }
+  return msgLen;
+}
 void cliSendBatch(SCliConn* pConn) {
   SCliThrd* pThrd = pConn->hostThrd;
   STrans*   pTransInst = pThrd->pTransInst;
@@ -1069,41 +1130,8 @@ void cliSendBatch(SCliConn* pConn) {
   QUEUE_FOREACH(h, &pBatch->wq) {
     SCliMsg* pCliMsg = QUEUE_DATA(h, SCliMsg, q);
 
-    STransConnCtx* pCtx = pCliMsg->ctx;
-
-    STransMsg* pMsg = (STransMsg*)(&pCliMsg->msg);
-    if (pMsg->pCont == 0) {
-      pMsg->pCont = (void*)rpcMallocCont(0);
-      pMsg->contLen = 0;
-    }
-
-    int            msgLen = transMsgLenFromCont(pMsg->contLen);
-    STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
-
-    if (pHead->comp == 0) {
-      pHead->ahandle = pCtx != NULL ? (uint64_t)pCtx->ahandle : 0;
-      pHead->noResp = REQUEST_NO_RESP(pMsg) ? 1 : 0;
-      pHead->persist = REQUEST_PERSIS_HANDLE(pMsg) ? 1 : 0;
-      pHead->msgType = pMsg->msgType;
-      pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
-      pHead->release = REQUEST_RELEASE_HANDLE(pCliMsg) ? 1 : 0;
-      memcpy(pHead->user, pTransInst->user, strlen(pTransInst->user));
-      pHead->traceId = pMsg->info.traceId;
-      pHead->magicNum = htonl(TRANS_MAGIC_NUM);
-      pHead->version = TRANS_VER;
-      pHead->compatibilityVer = htonl(pTransInst->compatibilityVer);
-    }
-    pHead->timestamp = taosHton64(taosGetTimestampUs());
-
-    if (pHead->comp == 0) {
-      if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-        msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
-        pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
-      }
-    } else {
-      msgLen = (int32_t)ntohl((uint32_t)(pHead->msgLen));
-    }
-    wb[i++] = uv_buf_init((char*)pHead, msgLen);
+    int32_t msgLen = cliPrepareMsgHead(pTransInst, pCliMsg);
+    wb[i++] = uv_buf_init((char*)transHeadFromCont(pCliMsg->msg.pCont), msgLen);
   }
 
   uv_write_t* req = taosMemoryCalloc(1, sizeof(uv_write_t));
@@ -1127,33 +1155,10 @@ void cliSend(SCliConn* pConn) {
   CONN_GET_NEXT_SENDMSG(pConn);
   pCliMsg->sent = 1;
 
-  STransConnCtx* pCtx = pCliMsg->ctx;
-
-  STransMsg* pMsg = (STransMsg*)(&pCliMsg->msg);
-  if (pMsg->pCont == 0) {
-    pMsg->pCont = (void*)rpcMallocCont(0);
-    tDebug("malloc memory: %p", pMsg->pCont);
-    pMsg->contLen = 0;
-  }
-
-  int            msgLen = transMsgLenFromCont(pMsg->contLen);
+  STransMsg*     pMsg = (STransMsg*)(&pCliMsg->msg);
+  int32_t        msgLen = cliPrepareMsgHead(pTransInst, pCliMsg);
   STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
 
-  if (pHead->comp == 0) {
-    pHead->ahandle = pCtx != NULL ? (uint64_t)pCtx->ahandle : 0;
-    pHead->noResp = REQUEST_NO_RESP(pMsg) ? 1 : 0;
-    pHead->persist = REQUEST_PERSIS_HANDLE(pMsg) ? 1 : 0;
-    pHead->msgType = pMsg->msgType;
-    pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
-    pHead->release = REQUEST_RELEASE_HANDLE(pCliMsg) ? 1 : 0;
-    memcpy(pHead->user, pTransInst->user, strlen(pTransInst->user));
-    pHead->traceId = pMsg->info.traceId;
-    pHead->magicNum = htonl(TRANS_MAGIC_NUM);
-    pHead->version = TRANS_VER;
-    pHead->compatibilityVer = htonl(pTransInst->compatibilityVer);
-  }
-  pHead->timestamp = taosHton64(taosGetTimestampUs());
-
   if (pHead->persist == 1) {
     CONN_SET_PERSIST_BY_APP(pConn);
   }
@@ -1174,15 +1179,6 @@ void cliSend(SCliConn* pConn) {
     uv_timer_start((uv_timer_t*)pConn->timer, cliReadTimeoutCb, TRANS_READ_TIMEOUT, 0);
   }
 
-  if (pHead->comp == 0) {
-    if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-      msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
-      pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
-    }
-  } else {
-    msgLen = (int32_t)ntohl((uint32_t)(pHead->msgLen));
-  }
-
   tGDebug("%s conn %p %s is sent to %s, local info %s, len:%d", CONN_GET_INST_LABEL(pConn), pConn,
           TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, msgLen);
 
@@ -1199,6 +1195,177 @@ void cliSend(SCliConn* pConn) {
 _RETURN:
   return;
 }
+static FORCE_INLINE bool cliMuxEnabled(STrans* pTransInst, SCliMsg* pMsg) {
+  if (pTransInst->muxWindow == 0 || pMsg->type != Normal || pMsg->msg.info.handle != 0) {
+    return false;
+  }
+  if (REQUEST_NO_RESP(&pMsg->msg) || REQUEST_PERSIS_HANDLE(&pMsg->msg)) {
+    return false;
+  }
+  // the read timer belongs to the conn, and the server drops some resp of drop_task by the last msg type of the conn
+  if (pTransInst->startTimer != NULL && pTransInst->startTimer(0, pMsg->msg.msgType)) {
+    return false;
+  }
+  return pMsg->msg.msgType != TDMT_SCH_DROP_TASK;
+}
+static SCliConn* cliGetMuxConn(SCliThrd* pThrd, char* key) {
+  SConnList* plist = cliGetConnList(pThrd->pool, key);
+  return plist->muxConn;
+}
+static void cliMuxAttach(SCliThrd* pThrd, SCliConn* conn, char* key) {
+  SConnList* plist = cliGetConnList(pThrd->pool, key);
+
+  conn->mux = true;
+  conn->writing = true;
+  conn->list = plist;
+  plist->muxConn = conn;
+  plist->list->numOfConn++;
+  tDebug("%s conn %p shared by the requests to %s", CONN_GET_INST_LABEL(conn), conn, key);
+}
+static void cliMuxFlush(SCliConn* pConn) {
+  SCliThrd* pThrd = pConn->hostThrd;
+  STrans*   pTransInst = pThrd->pTransInst;
+
+  // the msgs queued during a write are sent together by the next one
+  if (pConn->writing || pConn->broken) {
+    return;
+  }
+  int32_t nSend = TMIN(transQueueSize(&pConn->cliMsgs), pTransInst->muxWindow) - pConn->inflight;
+  if (nSend <= 0) {
+    return;
+  }
+
+  uv_buf_t* wb = taosMemoryCalloc(nSend, sizeof(uv_buf_t));
+  int32_t   totalLen = 0;
+  for (int32_t i = 0; i < nSend; i++) {
+    SCliMsg* pCliMsg = transQueueGet(&pConn->cliMsgs, pConn->inflight + i);
+    pCliMsg->sent = 1;
+    pCliMsg->seq = ++pConn->seq;
+
+    int32_t        msgLen = cliPrepareMsgHead(pTransInst, pCliMsg);
+    STransMsgHead* pHead = transHeadFromCont(pCliMsg->msg.pCont);
+    // echoed by the server as the ahandle of resp
+    pHead->ahandle = pCliMsg->seq;
+
+    STraceId* trace = &pCliMsg->msg.info.traceId;
+    tGDebug("%s conn %p %s is sent to %s, local info %s, len:%d, seq:%" PRIu64, CONN_GET_INST_LABEL(pConn), pConn,
+            TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, msgLen, pCliMsg->seq);
+    wb[i] = uv_buf_init((char*)pHead, msgLen);
+    totalLen += msgLen;
+  }
+  pConn->inflight += nSend;
+  pConn->writing = true;
+
+  tDebug("%s conn %p start to send %d msgs, msgLen:%d, in flight:%d", CONN_GET_INST_LABEL(pConn), pConn, nSend,
+         totalLen, pConn->inflight);
+  uv_write_t* req = transReqQueuePush(&pConn->wreqQueue);
+  int         status = uv_write(req, (uv_stream_t*)pConn->stream, wb, nSend, cliMuxSendCb);
+  taosMemoryFree(wb);
+  if (status != 0) {
+    tError("%s conn %p failed to send %d msgs, errmsg:%s", CONN_GET_INST_LABEL(pConn), pConn, nSend,
+           uv_err_name(status));
+    cliHandleExcept(pConn);
+  }
+}
+static void cliMuxSendCb(uv_write_t* req, int status) {
+  SCliConn* pConn = transReqQueueRemove(req);
+  if (pConn == NULL) return;
+
+  pConn->writing = false;
+  if (status != 0) {
+    if (!uv_is_closing((uv_handle_t*)pConn->stream)) {
+      tError("%s conn %p failed to write:%s", CONN_GET_INST_LABEL(pConn), pConn, uv_err_name(status));
+      cliHandleExcept(pConn);
+    }
+    return;
+  }
+  cliMuxFlush(pConn);
+}
+static bool cliHandleMuxResp(SCliConn* conn) {
+  STransMsgHead* pHead = NULL;
+
+  int32_t msgLen = transDumpFromBuffer(&conn->readBuf, (char**)&pHead, 1);
+  if (msgLen <= 0) {
+    taosMemoryFree(pHead);
+    tDebug("%s conn %p recv invalid packet ", CONN_GET_INST_LABEL(conn), conn);
+    return true;
+  }
+  if (transDecompressMsg((char**)&pHead, msgLen) < 0) {
+    tDebug("%s conn %p recv invalid packet, failed to decompress", CONN_GET_INST_LABEL(conn), conn);
+  }
+  pHead->code = htonl(pHead->code);
+  pHead->msgLen = htonl(pHead->msgLen);
+
+  SCliMsg* pMsg = NULL;
+  for (int32_t i = 0; i < conn->inflight; i++) {
+    SCliMsg* p = transQueueGet(&conn->cliMsgs, i);
+    if (p->seq == pHead->ahandle) {
+      pMsg = transQueueRm(&conn->cliMsgs, i);
+      break;
+    }
+  }
+  if (pMsg == NULL) {
+    tError("%s conn %p recv resp with unknown seq:%" PRIu64 ", close it", CONN_GET_INST_LABEL(conn), conn,
+           pHead->ahandle);
+    transFreeMsg(transContFromHead((char*)pHead));
+    cliHandleExcept(conn);
+    return false;
+  }
+  conn->inflight--;
+
+  STransMsg transMsg = {0};
+  transMsg.contLen = transContLenFromMsg(pHead->msgLen);
+  transMsg.pCont = transContFromHead((char*)pHead);
+  transMsg.code = pHead->code;
+  // the type of resp is filled by the server with the last req of the conn if the app not, so take it from the req
+  transMsg.msgType = pMsg->msg.msgType + 1;
+  transMsg.info.ahandle = pMsg->ctx->ahandle;
+  transMsg.info.traceId = pHead->traceId;
+  transMsg.info.hasEpSet = pHead->hasEpSet;
+  transMsg.info.cliVer = htonl(pHead->compatibilityVer);
+
+  STraceId* trace = &transMsg.info.traceId;
+  tGDebug("%s conn %p %s received from %s, local info:%s, len:%d, seq:%" PRIu64 ", code str:%s",
+          CONN_GET_INST_LABEL(conn), conn, TMSG_INFO(transMsg.msgType), conn->dst, conn->src, pHead->msgLen,
+          pMsg->seq, tstrerror(transMsg.code));
+
+  if (cliAppCb(conn, &transMsg, pMsg) == 0) {
+    destroyCmsg(pMsg);
+  }
+  cliMuxFlush(conn);
+  return true;
+}
+static void cliHandleMuxExcept(SCliConn* conn, int32_t code) {
+  SCliThrd* pThrd = conn->hostThrd;
+  STrans*   pTransInst = pThrd->pTransInst;
+
+  if (code == -1) {
+    code = conn->broken ? TSDB_CODE_RPC_BROKEN_LINK : TSDB_CODE_RPC_NETWORK_UNAVAIL;
+  }
+  tDebug("%s conn %p handle except, in flight:%d, to send:%d", CONN_GET_INST_LABEL(conn), conn, conn->inflight,
+         transQueueSize(&conn->cliMsgs) - conn->inflight);
+
+  // the following requests to the peer go to a new conn
+  if (conn->list != NULL && conn->list->muxConn == conn) {
+    conn->list->muxConn = NULL;
+  }
+  conn->broken = true;
+
+  SCliMsg* pMsg = NULL;
+  while ((pMsg = transQueuePop(&conn->cliMsgs)) != NULL) {
+    STransMsg transMsg = {0};
+    transMsg.code = code;
+    transMsg.msgType = pMsg->msg.msgType + 1;
+    transMsg.info.ahandle = pMsg->ctx->ahandle;
+    transMsg.info.traceId = pMsg->msg.info.traceId;
+    transMsg.info.cliVer = pTransInst->compatibilityVer;
+    if (cliAppCb(conn, &transMsg, pMsg) == 0) {
+      destroyCmsg(pMsg);
+    }
+  }
+  conn->inflight = 0;
+  transUnrefCliHandle(conn);
+}
 
 static void cliDestroyBatch(SCliBatch* pBatch) {
   if (pBatch == NULL) return;
@@ -1406,7 +1573,11 @@ void cliConnCb(uv_connect_t* req, int status) {
   transSockInfo2Str(&sockname, pConn->src);
 
   tTrace("%s conn %p connect to server successfully", CONN_GET_INST_LABEL(pConn), pConn);
-  if (pConn->pBatch != NULL) {
+  if (pConn->mux) {
+    pConn->writing = false;
+    uv_read_start((uv_stream_t*)pConn->stream, cliAllocRecvBufferCb, cliRecvCb);
+    cliMuxFlush(pConn);
+  } else if (pConn->pBatch != NULL) {
     cliSendBatch(pConn);
   } else {
     cliSend(pConn);
@@ -1619,7 +1790,8 @@ void cliHandleReq(SCliMsg* pMsg, SCliThrd* pThrd) {
   CONN_CONSTRUCT_HASH_KEY(addr, fqdn, port);
 
   bool      ignore = false;
-  SCliConn* conn = cliGetConn(&pMsg, pThrd, &ignore, addr);
+  bool      mux = cliMuxEnabled(pTransInst, pMsg);
+  SCliConn* conn = mux ? cliGetMuxConn(pThrd, addr) : cliGetConn(&pMsg, pThrd, &ignore, addr);
   if (ignore == true) {
     // persist conn already release by server
     STransMsg resp;
@@ -1641,9 +1813,14 @@ void cliHandleReq(SCliMsg* pMsg, SCliThrd* pThrd) {
   if (conn != NULL) {
     transCtxMerge(&conn->ctx, &pMsg->ctx->appCtx);
     transQueuePush(&conn->cliMsgs, pMsg);
-    cliSend(conn);
+    if (mux) {
+      cliMuxFlush(conn);
+    } else {
+      cliSend(conn);
+    }
   } else {
     conn = cliCreateConn(pThrd);
+    if (mux) cliMuxAttach(pThrd, conn, addr);
 
     int64_t refId = (int64_t)pMsg->msg.info.handle;
     if (refId != 0) specifyConnRef(conn, true, refId);
@@ -2358,7 +2535,7 @@ bool cliGenRetryRule(SCliConn* pConn, STransMsg* pResp, SCliMsg* pMsg) {
     tTrace("code str %s, contlen:%d 0", tstrerror(code), pResp->contLen);
     noDelay = cliResetEpset(pCtx, pResp, false);
     transFreeMsg(pResp->pCont);
-    transUnrefCliHandle(pConn);
+    if (!pConn->mux) transUnrefCliHandle(pConn);
   } else if (code == TSDB_CODE_SYN_NOT_LEADER || code == TSDB_CODE_SYN_INTERNAL_ERROR ||
              code == TSDB_CODE_SYN_PROPOSE_NOT_READY || code == TSDB_CODE_VND_STOPPED ||
              code == TSDB_CODE_MNODE_NOT_FOUND || code == TSDB_CODE_APP_IS_STARTING ||
@@ -31,8 +31,20 @@ typedef struct {
   tsem_t  *pOverSem;
   TdThread thread;
   void    *pRpc;
+  int32_t  nRsp;
+  int32_t  nFail;
+  int64_t *latency;  // us, one per response
 } SInfo;
 
+// a request waiting for the response, it is the ahandle of the request
+typedef struct {
+  SInfo  *pInfo;
+  int64_t startTime;
+} SReq;
+
+static int waitRsp = 0;      // send requests with response, and measure the latency
+static int concurrency = 1;  // max outstanding requests per app thread
+
 void initLogEnv() {
   const char   *logDir = "/tmp/trans_cli";
   const char   *defaultLogFileNamePrefix = "taoslog";
@@ -49,16 +61,54 @@ void initLogEnv() {
 }
 
 static void processResponse(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
-  SInfo *pInfo = (SInfo *)pMsg->info.ahandle;
+  SReq  *pReq = (SReq *)pMsg->info.ahandle;
+  SInfo *pInfo = pReq->pInfo;
   tDebug("thread:%d, response is received, type:%d contLen:%d code:0x%x", pInfo->index, pMsg->msgType, pMsg->contLen,
          pMsg->code);
 
   if (pEpSet) pInfo->epSet = *pEpSet;
+  if (pMsg->code != 0) atomic_add_fetch_32(&pInfo->nFail, 1);
+
+  // the responses of a thread may come from different rpc threads
+  int32_t idx = atomic_fetch_add_32(&pInfo->nRsp, 1);
+  if (pInfo->latency != NULL && idx < pInfo->numOfReqs) {
+    pInfo->latency[idx] = taosGetTimestampUs() - pReq->startTime;
+  }
+  taosMemoryFree(pReq);
 
   rpcFreeCont(pMsg->pCont);
   tsem_post(&pInfo->rspSem);
 }
 
+static int compareLatency(const void *a, const void *b) {
+  int64_t l = *(int64_t *)a, r = *(int64_t *)b;
+  return l < r ? -1 : (l > r ? 1 : 0);
+}
+
+static void printLatency(SInfo *pInfo, int appThreads) {
+  int64_t  num = 0;
+  int64_t *latency = taosMemoryMalloc(sizeof(int64_t) * pInfo->numOfReqs * appThreads);
+  for (int i = 0; i < appThreads; ++i) {
+    int32_t n = TMIN(pInfo[i].nRsp, pInfo[i].numOfReqs);
+    memcpy(latency + num, pInfo[i].latency, sizeof(int64_t) * n);
+    num += n;
+  }
+  if (num == 0) {
+    taosMemoryFree(latency);
+    return;
+  }
+
+  taosSort(latency, num, sizeof(int64_t), compareLatency);
+  int64_t sum = 0;
+  for (int64_t i = 0; i < num; ++i) sum += latency[i];
+
+  tInfo("Latency(us): avg:%" PRId64 ", p50:%" PRId64 ", p90:%" PRId64 ", p99:%" PRId64 ", p999:%" PRId64
+        ", max:%" PRId64,
+        sum / num, latency[num * 50 / 100], latency[num * 90 / 100], latency[num * 99 / 100],
+        latency[num * 999 / 1000], latency[num - 1]);
+  taosMemoryFree(latency);
+}
+
 static int tcount = 0;
 
 static void *sendRequest(void *param) {
@@ -74,10 +124,22 @@ static void *sendRequest(void *param) {
     rpcMsg.info.ahandle = pInfo;
     rpcMsg.info.noResp = 1;
     rpcMsg.msgType = 1;
+    if (waitRsp) {
+      // at most concurrency requests are outstanding
+      tsem_wait(&pInfo->rspSem);
+      SReq *pReq = taosMemoryMalloc(sizeof(SReq));
+      pReq->pInfo = pInfo;
+      pReq->startTime = taosGetTimestampUs();
+      rpcMsg.info.ahandle = pReq;
+      rpcMsg.info.noResp = 0;
+    }
     tDebug("thread:%d, send request, contLen:%d num:%d", pInfo->index, pInfo->msgSize, pInfo->num);
     rpcSendRequest(pInfo->pRpc, &pInfo->epSet, &rpcMsg, NULL);
     if (pInfo->num % 20000 == 0) tInfo("thread:%d, %d requests have been sent", pInfo->index, pInfo->num);
-    // tsem_wait(&pInfo->rspSem);
+  }
+
+  for (int i = 0; waitRsp && i < concurrency; ++i) {
+    tsem_wait(&pInfo->rspSem);
   }
 
   tDebug("thread:%d, it is over", pInfo->index);
@@ -136,6 +198,12 @@ int main(int argc, char *argv[]) {
       appThreads = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-o") == 0 && i < argc - 1) {
       tsCompressMsgSize = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i < argc - 1) {
+      waitRsp = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0 && i < argc - 1) {
+      concurrency = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-x") == 0 && i < argc - 1) {
+      rpcInit.muxWindow = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-u") == 0 && i < argc - 1) {
     } else if (strcmp(argv[i], "-k") == 0 && i < argc - 1) {
     } else if (strcmp(argv[i], "-spi") == 0 && i < argc - 1) {
@@ -148,6 +216,11 @@ int main(int argc, char *argv[]) {
       printf("  [-m msgSize]: message body size, default is:%d\n", msgSize);
       printf("  [-a threads]: number of app threads, default is:%d\n", appThreads);
       printf("  [-n requests]: number of requests per thread, default is:%d\n", numOfReqs);
+      printf("  [-r response]: wait for the response and measure the latency(0, 1), default is:%d\n", waitRsp);
+      printf("  [-c concurrency]: outstanding requests per app thread with response, default is:%d\n", concurrency);
+      printf("  [-x window]: requests in flight on the conn shared by a server, 0 for one request per conn, "
+             "default is:%d\n",
+             rpcInit.muxWindow);
       printf("  [-u user]: user name for the connection, default is:%s\n", rpcInit.user);
       printf("  [-d debugFlag]: debug flag, default:%d\n", rpcDebugFlag);
       printf("  [-h help]: print out this help\n\n");
@@ -164,7 +237,8 @@ int main(int argc, char *argv[]) {
   }
 
   tInfo("client is initialized");
-  tInfo("threads:%d msgSize:%d requests:%d", appThreads, msgSize, numOfReqs);
+  tInfo("threads:%d msgSize:%d requests:%d response:%d concurrency:%d muxWindow:%d", appThreads, msgSize, numOfReqs,
+        waitRsp, concurrency, rpcInit.muxWindow);
 
   int64_t now = taosGetTimestampUs();
 
@@ -175,8 +249,11 @@ int main(int argc, char *argv[]) {
     pInfo->epSet = epSet;
     pInfo->numOfReqs = numOfReqs;
     pInfo->msgSize = msgSize;
-    tsem_init(&pInfo->rspSem, 0, 0);
+    tsem_init(&pInfo->rspSem, 0, concurrency);
     pInfo->pRpc = pRpc;
+    if (waitRsp && numOfReqs > 0) {
+      pInfo->latency = taosMemoryCalloc(numOfReqs, sizeof(int64_t));
+    }
 
     taosThreadCreate(&pInfo->thread, NULL, sendRequest, pInfo);
     pInfo++;
@@ -190,6 +267,12 @@ int main(int argc, char *argv[]) {
 
   tInfo("it takes %.3f mseconds to send %d requests to server", usedTime, numOfReqs * appThreads);
   tInfo("Performance: %.3f requests per second, msgSize:%d bytes", 1000.0 * numOfReqs * appThreads / usedTime, msgSize);
+  if (waitRsp) {
+    int32_t nFail = 0;
+    for (int i = 0; i < appThreads; i++) nFail += p[i].nFail;
+    tInfo("%d requests failed", nFail);
+    printLatency(p, appThreads);
+  }
 
   for (int i = 0; i < appThreads; i++) {
     SInfo *pInfo = p;
@@ -29,6 +29,19 @@ STaosQset  *qset = NULL;
 
 int32_t balance = 0;
 
+// service time of each batch of requests read by a worker, to simulate the query and write of vnode
+int32_t procDelay = 0;
+
+// request rate and the latency from receiving a request to sending its response, reported every second
+int64_t numOfReqs = 0;
+int64_t totalLatency = 0;
+int64_t maxLatency = 0;
+
+typedef struct {
+  SRpcMsg msg;
+  int64_t recvTime;
+} SSvrReq;
+
 typedef struct {
   int32_t      numOfThread;
   STaosQueue **qhandle;
@@ -95,11 +108,18 @@ void *processShellMsg(void *arg) {
       }
     }
 
+    if (procDelay > 0) taosUsleep(procDelay);
+
     taosResetQitems(qall);
     for (int i = 0; i < numOfMsgs; ++i) {
       taosGetQitem(qall, (void **)&pRpcMsg);
       rpcFreeCont(pRpcMsg->pCont);
 
+      int64_t latency = taosGetTimestampUs() - ((SSvrReq *)pRpcMsg)->recvTime;
+      atomic_add_fetch_64(&numOfReqs, 1);
+      atomic_add_fetch_64(&totalLatency, latency);
+      if (latency > atomic_load_64(&maxLatency)) atomic_store_64(&maxLatency, latency);
+
       memset(&rpcMsg, 0, sizeof(rpcMsg));
       rpcMsg.pCont = rpcMallocCont(msgSize);
       rpcMsg.contLen = msgSize;
@@ -126,11 +146,26 @@ void *processShellMsg(void *arg) {
   return NULL;
 }
 
+void *reportStat(void *arg) {
+  while (1) {
+    taosSsleep(1);
+    int64_t num = atomic_exchange_64(&numOfReqs, 0);
+    int64_t total = atomic_exchange_64(&totalLatency, 0);
+    int64_t max = atomic_exchange_64(&maxLatency, 0);
+    if (num > 0) {
+      tInfo("%" PRId64 " requests per second, latency in server(us) avg:%" PRId64 ", max:%" PRId64, num, total / num,
+            max);
+    }
+  }
+  return NULL;
+}
+
 void processRequestMsg(void *pParent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   SRpcMsg *pTemp;
 
-  pTemp = taosAllocateQitem(sizeof(SRpcMsg), DEF_QITEM, 0);
+  pTemp = taosAllocateQitem(sizeof(SSvrReq), DEF_QITEM, 0);
   memcpy(pTemp, pMsg, sizeof(SRpcMsg));
+  ((SSvrReq *)pTemp)->recvTime = taosGetTimestampUs();
 
   int32_t idx = balance % multiQ->numOfThread;
   tDebug("request is received, type:%d, contLen:%d, item:%p", pMsg->msgType, pMsg->contLen, pTemp);
@@ -169,6 +204,8 @@ int main(int argc, char *argv[]) {
       tsCompressMsgSize = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-w") == 0 && i < argc - 1) {
       commit = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      procDelay = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-d") == 0 && i < argc - 1) {
       rpcDebugFlag = atoi(argv[++i]);
       dDebugFlag = rpcDebugFlag;
@@ -181,6 +218,7 @@ int main(int argc, char *argv[]) {
       printf("  [-m msgSize]: message body size, default is:%d\n", msgSize);
       printf("  [-o compSize]: compression message size, default is:%d\n", tsCompressMsgSize);
       printf("  [-w write]: write received data to file(0, 1, 2), default is:%d\n", commit);
+      printf("  [-l delay]: service time(us) of each batch of requests, default is:%d\n", procDelay);
       printf("  [-d debugFlag]: debug flag, default:%d\n", rpcDebugFlag);
       printf("  [-h help]: print out this help\n\n");
       exit(0);
@@ -206,7 +244,7 @@ int main(int argc, char *argv[]) {
   }
 
   int32_t numOfAthread = 5;
-  multiQ = taosMemoryMalloc(sizeof(numOfAthread));
+  multiQ = taosMemoryMalloc(sizeof(MultiThreadQhandle));
   multiQ->numOfThread = numOfAthread;
   multiQ->qhandle = (STaosQueue **)taosMemoryMalloc(sizeof(STaosQueue *) * numOfAthread);
   multiQ->qset = (STaosQset **)taosMemoryMalloc(sizeof(STaosQset *) * numOfAthread);
@@ -221,6 +259,8 @@ int main(int argc, char *argv[]) {
     threads[i].idx = i;
     taosThreadCreate(&(threads[i].thread), NULL, processShellMsg, (void *)&threads[i]);
   }
+  TdThread statThread;
+  taosThreadCreate(&statThread, NULL, reportStat, NULL);
   // qhandle = taosOpenQueue();
   // qset = taosOpenQset();
   // taosAddIntoQset(qset, qhandle, NULL);
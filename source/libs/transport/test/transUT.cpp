@@ -15,6 +15,10 @@
 #include <gtest/gtest.h>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "tdatablock.h"
 #include "tglobal.h"
 #include "tlog.h"
@@ -42,6 +46,8 @@ static void processRegisterFailure(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 static void processReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 // client process;
 static void processResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
+static void processMuxResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
+static bool muxRetrySubmit(int32_t code, tmsg_t msgType);
 class Client {
  public:
   void Init(int nThread) {
@@ -71,6 +77,15 @@ class Client {
     taosVersionStrToInt(version, &(rpcInit_.compatibilityVer));
     this->transCli = rpcOpen(&rpcInit_);
   }
+  void SetMuxWindow(int32_t window, CB cb, RpcRfp rfp) {
+    rpcInit_.muxWindow = window;
+    rpcInit_.rfp = rfp;
+    rpcInit_.retryMinInterval = 100;
+    rpcInit_.retryStepFactor = 2;
+    rpcInit_.retryMaxInterval = 500;
+    rpcInit_.retryMaxTimeout = 10 * 1000;
+    Restart(cb);
+  }
   void Stop() {
     rpcClose(this->transCli);
     this->transCli = NULL;
@@ -85,6 +100,13 @@ class Client {
     SemWait();
     *resp = this->resp;
   }
+  void Send(SRpcMsg *req) {
+    SEpSet epSet = {0};
+    epSet.inUse = 0;
+    addEpIntoEpSet(&epSet, "127.0.0.1", 7000);
+
+    rpcSendRequest(this->transCli, &epSet, req, NULL);
+  }
   void SendAndRecvNoHandle(SRpcMsg *req, SRpcMsg *resp) {
     if (req->info.handle != NULL) {
       rpcReleaseHandle(req->info.handle, TAOS_CONN_CLIENT);
@@ -93,9 +115,10 @@ class Client {
     SendAndRecv(req, resp);
   }
 
-  void SemWait() { tsem_wait(&this->sem); }
-  void SemPost() { tsem_post(&this->sem); }
-  void Reset() {}
+  void    SemWait() { tsem_wait(&this->sem); }
+  int32_t SemTimedWait(int64_t ms) { return tsem_timewait(&this->sem, ms); }
+  void    SemPost() { tsem_post(&this->sem); }
+  void    Reset() {}
 
   ~Client() {
     if (this->transCli) rpcClose(this->transCli);
@@ -201,6 +224,15 @@ static void processRegisterFailure(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet)
   rpcMsg.code = 0;
   rpcSendResponse(&rpcMsg);
 }
+// resp with the type filled by server and the content of req
+static void sendEchoResp(SRpcMsg *pReq) {
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.pCont = pReq->pCont;
+  rpcMsg.contLen = pReq->contLen;
+  rpcMsg.info = pReq->info;
+  rpcMsg.code = 0;
+  rpcSendResponse(&rpcMsg);
+}
 // client process;
 static void processResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   Client *client = (Client *)parent;
@@ -209,6 +241,84 @@ static void processResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   tDebug("received resp");
 }
 
+// the server of the mux tests holds the requests, they are answered by muxAnswerHeld, so the requests in flight on
+// the conn are those held
+static struct {
+  std::mutex           mutex;
+  std::vector<SRpcMsg> held;
+  std::set<uint16_t>   ports;  // the client port of each conn the requests come from
+  int32_t              maxHeld;
+  bool                 echo;  // answer the requests at once
+} muxSrv;
+static void processMuxReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  std::lock_guard<std::mutex> lock(muxSrv.mutex);
+  muxSrv.ports.insert(pMsg->info.conn.clientPort);
+  if (muxSrv.echo) {
+    sendEchoResp(pMsg);
+    return;
+  }
+  muxSrv.held.push_back(*pMsg);
+  muxSrv.maxHeld = TMAX(muxSrv.maxHeld, (int32_t)muxSrv.held.size());
+}
+static int32_t muxHeldNum() {
+  std::lock_guard<std::mutex> lock(muxSrv.mutex);
+  return muxSrv.held.size();
+}
+// the requests held are answered in reverse order once no more arrives for a while, until num are answered
+static void muxAnswerHeld(int32_t num) {
+  int32_t last = 0;
+  for (int32_t answered = 0; answered < num;) {
+    taosMsleep(20);
+    std::vector<SRpcMsg> reqs;
+    {
+      std::lock_guard<std::mutex> lock(muxSrv.mutex);
+      if (muxSrv.held.size() != last) {
+        last = muxSrv.held.size();
+        continue;
+      }
+      reqs.swap(muxSrv.held);
+      last = 0;
+    }
+    for (auto it = reqs.rbegin(); it != reqs.rend(); ++it) {
+      sendEchoResp(&*it);
+    }
+    answered += reqs.size();
+  }
+}
+
+static int32_t              muxRespErr = 0;
+static std::vector<int32_t> muxRespCode;  // the code of the resp of each request, -1 if not received yet
+static void                 muxReset(int32_t num) {
+  std::lock_guard<std::mutex> lock(muxSrv.mutex);
+  muxSrv.held.clear();
+  muxSrv.ports.clear();
+  muxSrv.maxHeld = 0;
+  muxSrv.echo = false;
+  muxRespErr = 0;
+  muxRespCode.assign(num, -1);
+}
+static tmsg_t muxReqType(int32_t idx) { return idx % 2 ? TDMT_VND_SUBMIT : TDMT_SCH_QUERY; }
+static bool   muxRetrySubmit(int32_t code, tmsg_t msgType) {
+  return msgType == TDMT_VND_SUBMIT && (code == TSDB_CODE_RPC_BROKEN_LINK || code == TSDB_CODE_RPC_NETWORK_UNAVAIL);
+}
+// the codes of a request failed by the conn, which are turned to the SOMENODE ones when no other ep is left
+static bool muxLinkBroken(int32_t code) {
+  return code == TSDB_CODE_RPC_BROKEN_LINK || code == TSDB_CODE_RPC_NETWORK_UNAVAIL ||
+         code == TSDB_CODE_RPC_SOMENODE_BROKEN_LINK || code == TSDB_CODE_RPC_SOMENODE_NOT_CONNECTED;
+}
+static void processMuxResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  Client *client = (Client *)parent;
+  int32_t idx = (int32_t)(int64_t)pMsg->info.ahandle;
+  if (idx < 0 || idx >= muxRespCode.size() || muxRespCode[idx] != -1 || pMsg->msgType != muxReqType(idx) + 1 ||
+      (pMsg->code == 0 && (pMsg->contLen != sizeof(int32_t) || *(int32_t *)pMsg->pCont != idx))) {
+    atomic_add_fetch_32(&muxRespErr, 1);
+  } else {
+    muxRespCode[idx] = pMsg->code;
+  }
+  rpcFreeCont(pMsg->pCont);
+  client->SemPost();
+}
+
 static void initEnv() {
   dDebugFlag = 143;
   vDebugFlag = 0;
@@ -249,6 +359,7 @@ class TransObj {
     //
     cli->Restart(cb);
   }
+  void RestartCliWithMux(int32_t window, CB cb, RpcRfp rfp = NULL) { cli->SetMuxWindow(window, cb, rfp); }
   void StopSrv() {
     //
     srv->Stop();
@@ -263,8 +374,11 @@ class TransObj {
     ///////
     cli->Stop();
   }
-  void cliSendAndRecv(SRpcMsg *req, SRpcMsg *resp) { cli->SendAndRecv(req, resp); }
-  void cliSendAndRecvNoHandle(SRpcMsg *req, SRpcMsg *resp) { cli->SendAndRecvNoHandle(req, resp); }
+  void    cliSendAndRecv(SRpcMsg *req, SRpcMsg *resp) { cli->SendAndRecv(req, resp); }
+  void    cliSend(SRpcMsg *req) { cli->Send(req); }
+  void    cliSemWait() { cli->SemWait(); }
+  int32_t cliSemTimedWait(int64_t ms) { return cli->SemTimedWait(ms); }
+  void    cliSendAndRecvNoHandle(SRpcMsg *req, SRpcMsg *resp) { cli->SendAndRecvNoHandle(req, resp); }
 
   ~TransObj() {
     delete cli;
@@ -320,6 +434,88 @@ TEST_F(TransEnv, 02StopServer) {
   tr->cliSendAndRecv(&req, &resp);
   assert(resp.code != 0);
 }
+static void muxSend(TransObj *tr, int32_t num) {
+  for (int32_t i = 0; i < num; i++) {
+    SRpcMsg req = {0};
+    req.msgType = muxReqType(i);
+    req.pCont = rpcMallocCont(sizeof(int32_t));
+    req.contLen = sizeof(int32_t);
+    *(int32_t *)req.pCont = i;
+    req.info.ahandle = (void *)(int64_t)i;
+    tr->cliSend(&req);
+  }
+}
+TEST_F(TransEnv, 03muxSendAndRecv) {
+  int32_t window = 16, num = 100;
+  muxReset(num);
+  tr->SetSrvContinueSend(processMuxReq);
+  tr->RestartCliWithMux(window, processMuxResp);
+
+  // more requests than the window, and the resp of each is matched by seq
+  std::thread answer(muxAnswerHeld, num);
+  muxSend(tr, num);
+  for (int32_t i = 0; i < num; i++) {
+    ASSERT_EQ(tr->cliSemTimedWait(10 * 1000), 0);
+  }
+  answer.join();
+  EXPECT_EQ(muxRespErr, 0);
+  for (int32_t i = 0; i < num; i++) {
+    EXPECT_EQ(muxRespCode[i], 0);
+  }
+
+  // all sent on one conn, with a full window in flight and never more
+  EXPECT_EQ(muxSrv.ports.size(), 1);
+  EXPECT_EQ(muxSrv.maxHeld, window);
+}
+TEST_F(TransEnv, 04muxStopServer) {
+  int32_t window = 16, num = 3 * window;
+  muxReset(num);
+  tr->SetSrvContinueSend(processMuxReq);
+  tr->RestartCliWithMux(window, processMuxResp, muxRetrySubmit);
+
+  // the server holds a window of requests, and the others are queued by the client
+  muxSend(tr, num);
+  for (int32_t i = 0; i < 500 && muxHeldNum() < window; i++) {
+    taosMsleep(10);
+  }
+  taosMsleep(100);
+  ASSERT_EQ(muxHeldNum(), window);
+
+  tr->StopSrv();
+  {
+    std::lock_guard<std::mutex> lock(muxSrv.mutex);
+    for (auto &req : muxSrv.held) {
+      rpcFreeCont(req.pCont);
+    }
+    muxSrv.held.clear();
+    muxSrv.echo = true;
+  }
+
+  // the queries in flight or queued fail by the broken link, and the submits are retried
+  for (int32_t i = 0; i < num / 2; i++) {
+    ASSERT_EQ(tr->cliSemTimedWait(10 * 1000), 0);
+  }
+  for (int32_t i = 0; i < num; i++) {
+    if (muxReqType(i) == TDMT_VND_SUBMIT) {
+      EXPECT_EQ(muxRespCode[i], -1);
+    } else {
+      EXPECT_TRUE(muxLinkBroken(muxRespCode[i])) << i << " " << tstrerror(muxRespCode[i]);
+    }
+  }
+
+  // the submits retried are answered by the server started again, on a new conn
+  tr->RestartSrv();
+  for (int32_t i = 0; i < num / 2; i++) {
+    ASSERT_EQ(tr->cliSemTimedWait(10 * 1000), 0);
+  }
+  EXPECT_EQ(muxRespErr, 0);
+  EXPECT_EQ(muxSrv.ports.size(), 2);
+  for (int32_t i = 0; i < num; i++) {
+    if (muxReqType(i) == TDMT_VND_SUBMIT) {
+      EXPECT_EQ(muxRespCode[i], 0) << i << " " << tstrerror(muxRespCode[i]);
+    }
+  }
+}
 TEST_F(TransEnv, clientUserDefined) {
   tr->RestartSrv();
   for (int i = 0; i < 10; i++) {
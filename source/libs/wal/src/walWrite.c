@@ -463,21 +463,7 @@ END:
   return code;
 }
 
-static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
-  SWalIdxEntry  entry = {.ver = ver, .offset = offset};
-  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
-
-  int64_t idxOffset = (entry.ver - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
-  wDebug("vgId:%d, write index, index:%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId, ver, offset,
-         idxOffset);
-
-  int64_t size = taosWriteFile(pWal->pIdxFile, &entry, sizeof(SWalIdxEntry));
-  if (size != sizeof(SWalIdxEntry)) {
-    wError("vgId:%d, failed to write idx entry due to %s. ver:%" PRId64, pWal->cfg.vgId, strerror(errno), ver);
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return -1;
-  }
-
+static void walCheckIndexFile(SWal *pWal, int64_t ver) {
   // check alignment of idx entries
   int64_t endOffset = taosLSeekFile(pWal->pIdxFile, 0, SEEK_END);
   if (endOffset < 0) {
@@ -486,7 +472,6 @@ static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
     taosMsleep(100);
     exit(EXIT_FAILURE);
   }
-  return 0;
 }
 
 static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
@@ -510,19 +495,6 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId, index,
          TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
 
-  code = walWriteIndex(pWal, index, offset);
-  if (code < 0) {
-    goto END;
-  }
-
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
-
   int32_t cyptedBodyLen = plainBodyLen;
   char* buf = (char*)body;
   char* newBody = NULL;
@@ -565,7 +537,18 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     buf = newBodyEncrypted;
   }
   
-  if (taosWriteFile(pWal->pLogFile, (char *)buf, cyptedBodyLen) != cyptedBodyLen) {
+  // the idx entry, the head and the body are appended in one batch
+  SWalIdxEntry entry = {.ver = index, .offset = offset};
+  STdFileIo    ios[3] = {
+      {.pFile = pWal->pIdxFile, .buf = &entry, .count = sizeof(SWalIdxEntry), .offset = -1},
+      {.pFile = pWal->pLogFile, .buf = &pWal->writeHead, .count = sizeof(SWalCkHead), .offset = -1},
+      {.pFile = pWal->pLogFile, .buf = buf, .count = cyptedBodyLen, .offset = -1},
+  };
+  wDebug("vgId:%d, write index, index:%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId, index, offset,
+         (index - pFileInfo->firstVer) * (int64_t)sizeof(SWalIdxEntry));
+
+  // errno is set by the batch on failure, a short write fails with EIO
+  if (taosWriteFileBatch(ios, tListLen(ios), false) != 0) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
            strerror(errno));
@@ -577,6 +560,8 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     goto END;
   }
 
+  walCheckIndexFile(pWal, index);
+
   if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
     taosMemoryFreeClear(newBody);
     taosMemoryFreeClear(newBodyEncrypted); 
@@ -1196,6 +1196,24 @@ int32_t taosFsyncFile(TdFilePtr pFile) {
   return 0;
 }
 
+// hint the kernel to read the range in background, it is a no-op if the platform has no such facility
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t len) {
+  if (pFile == NULL || len <= 0) {
+    return 0;
+  }
+
+#if defined(LINUX)
+  if (pFile->fd >= 0) {
+    int32_t code = posix_fadvise(pFile->fd, offset, len, POSIX_FADV_WILLNEED);
+    if (code != 0) {
+      errno = code;
+      return -1;
+    }
+  }
+#endif
+  return 0;
+}
+
 void taosFprintfFile(TdFilePtr pFile, const char *format, ...) {
   if (pFile == NULL || pFile->fp == NULL) {
     return;
@@ -1435,4 +1453,374 @@ int taosSetAutoDelFile(char* path) {
 #else
   return unlink(path);
 #endif  
-}
\ No newline at end of file
+}
+// =============== BATCHED FILE IO ===============
+// The batched reads/writes are submitted to the io_uring instance of the calling thread if it is enabled and
+// supported by the running kernel, otherwise they fall back to be issued by pread/pwrite one by one.
+#if defined(LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define USE_IO_URING
+#endif
+#endif
+#endif
+
+static bool fileIoIsFirstOfFile(STdFileIo *pIos, int32_t i) {
+  for (int32_t j = 0; j < i; ++j) {
+    if (pIos[j].pFile == pIos[i].pFile) return false;
+  }
+  return true;
+}
+
+// a short write is reported as EIO, while a short read only means the end of the file is reached
+static int32_t fileIoSetError(STdFileIo *pIos, int32_t num, bool write) {
+  for (int32_t i = 0; i < num; ++i) {
+    if (pIos[i].result < 0) {
+      errno = (int32_t)(-pIos[i].result);
+      return -1;
+    }
+  }
+  for (int32_t i = 0; write && i < num; ++i) {
+    if (pIos[i].result < pIos[i].count) {
+      errno = EIO;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// continue the io until it is done, fails or reaches the end of the file
+static void fileIoDoOne(STdFileIo *pIo, bool write) {
+  while (pIo->result < pIo->count) {
+    char   *buf = (char *)pIo->buf + pIo->result;
+    int64_t count = pIo->count - pIo->result;
+    int64_t ret = 0;
+    if (write) {
+      ret = (pIo->offset < 0) ? taosWriteFile(pIo->pFile, buf, count)
+                              : taosPWriteFile(pIo->pFile, buf, count, pIo->offset + pIo->result);
+    } else {
+      ret = (pIo->offset < 0) ? taosReadFile(pIo->pFile, buf, count)
+                              : taosPReadFile(pIo->pFile, buf, count, pIo->offset + pIo->result);
+    }
+
+    if (ret < 0) {
+      pIo->result = -errno;
+      return;
+    } else if (ret == 0) {
+      return;
+    }
+    pIo->result += ret;
+  }
+}
+
+static void fileIoDoSync(STdFileIo *pIos, int32_t num, bool write, bool fsync) {
+  for (int32_t i = 0; i < num; ++i) {
+    fileIoDoOne(&pIos[i], write);
+  }
+
+  for (int32_t i = 0; fsync && i < num; ++i) {
+    if (fileIoIsFirstOfFile(pIos, i) && taosFsyncFile(pIos[i].pFile) < 0) {
+      pIos[i].result = -errno;
+    }
+  }
+}
+
+#ifdef USE_IO_URING
+#define FILE_IO_RING_ENTRIES 64
+#define FILE_IO_FSYNC_FLAG   (1ULL << 63)
+
+typedef struct SFileIoRing {
+  int32_t              fd;
+  uint32_t             entries;
+  uint32_t            *sqHead;
+  uint32_t            *sqTail;
+  uint32_t            *sqMask;
+  uint32_t            *sqArray;
+  struct io_uring_sqe *sqes;
+  uint32_t            *cqHead;
+  uint32_t            *cqTail;
+  uint32_t            *cqMask;
+  struct io_uring_cqe *cqes;
+  void                *pSqRing;
+  size_t               sqRingSize;
+  void                *pCqRing;
+  size_t               cqRingSize;
+  size_t               sqesSize;
+} SFileIoRing;
+
+static bool                     tsFileIoUring = false;
+static TdThreadOnce             tsFileIoRingKeyInit = PTHREAD_ONCE_INIT;
+static int32_t                  tsFileIoRingKeyCode = -1;
+static TdThreadKey              tsFileIoRingKey;
+static threadlocal SFileIoRing *tsFileIoRing = NULL;
+
+static void fileIoRingDestroy(void *param) {
+  SFileIoRing *pRing = param;
+  if (pRing == NULL) {
+    return;
+  }
+
+  if (pRing->sqes != NULL) munmap(pRing->sqes, pRing->sqesSize);
+  if (pRing->pCqRing != NULL && pRing->pCqRing != pRing->pSqRing) munmap(pRing->pCqRing, pRing->cqRingSize);
+  if (pRing->pSqRing != NULL) munmap(pRing->pSqRing, pRing->sqRingSize);
+  if (pRing->fd >= 0) close(pRing->fd);
+  taosMemoryFree(pRing);
+}
+
+static void fileIoRingKeyCreate() { tsFileIoRingKeyCode = taosThreadKeyCreate(&tsFileIoRingKey, fileIoRingDestroy); }
+
+static void *fileIoRingMap(SFileIoRing *pRing, size_t size, int64_t offset) {
+  void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->fd, offset);
+  return (p == MAP_FAILED) ? NULL : p;
+}
+
+static SFileIoRing *fileIoRingCreate(uint32_t entries) {
+  struct io_uring_params p = {0};
+
+  SFileIoRing *pRing = taosMemoryCalloc(1, sizeof(SFileIoRing));
+  if (pRing == NULL) {
+    return NULL;
+  }
+
+  pRing->fd = (int32_t)syscall(__NR_io_uring_setup, entries, &p);
+  if (pRing->fd < 0 || (p.features & IORING_FEAT_RW_CUR_POS) == 0) {
+    fileIoRingDestroy(pRing);
+    return NULL;
+  }
+
+  pRing->entries = p.sq_entries;
+  pRing->sqRingSize = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+  pRing->cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    pRing->sqRingSize = TMAX(pRing->sqRingSize, pRing->cqRingSize);
+    pRing->cqRingSize = pRing->sqRingSize;
+  }
+
+  pRing->pSqRing = fileIoRingMap(pRing, pRing->sqRingSize, IORING_OFF_SQ_RING);
+  if (pRing->pSqRing == NULL) {
+    fileIoRingDestroy(pRing);
+    return NULL;
+  }
+
+  pRing->pCqRing = (p.features & IORING_FEAT_SINGLE_MMAP) ? pRing->pSqRing
+                                                          : fileIoRingMap(pRing, pRing->cqRingSize, IORING_OFF_CQ_RING);
+  if (pRing->pCqRing == NULL) {
+    fileIoRingDestroy(pRing);
+    return NULL;
+  }
+
+  pRing->sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+  pRing->sqes = fileIoRingMap(pRing, pRing->sqesSize, IORING_OFF_SQES);
+  if (pRing->sqes == NULL) {
+    fileIoRingDestroy(pRing);
+    return NULL;
+  }
+
+  char *sq = pRing->pSqRing;
+  char *cq = pRing->pCqRing;
+  pRing->sqHead = (uint32_t *)(sq + p.sq_off.head);
+  pRing->sqTail = (uint32_t *)(sq + p.sq_off.tail);
+  pRing->sqMask = (uint32_t *)(sq + p.sq_off.ring_mask);
+  pRing->sqArray = (uint32_t *)(sq + p.sq_off.array);
+  pRing->cqHead = (uint32_t *)(cq + p.cq_off.head);
+  pRing->cqTail = (uint32_t *)(cq + p.cq_off.tail);
+  pRing->cqMask = (uint32_t *)(cq + p.cq_off.ring_mask);
+  pRing->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+  return pRing;
+}
+
+static SFileIoRing *fileIoRingGet() {
+  if (tsFileIoRing == NULL) {
+    tsFileIoRing = fileIoRingCreate(FILE_IO_RING_ENTRIES);
+    if (tsFileIoRing != NULL) {
+      taosThreadSetSpecific(tsFileIoRingKey, tsFileIoRing);
+    }
+  }
+  return tsFileIoRing;
+}
+
+static void fileIoRingPrepare(SFileIoRing *pRing, uint32_t idx, uint8_t opcode, int32_t fd, void *buf, uint32_t len,
+                              int64_t offset, uint8_t flags, uint64_t userData) {
+  uint32_t             slot = (*pRing->sqTail + idx) & *pRing->sqMask;
+  struct io_uring_sqe *sqe = &pRing->sqes[slot];
+
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->flags = flags;
+  sqe->fd = fd;
+  sqe->addr = (uint64_t)(uintptr_t)buf;
+  sqe->len = len;
+  sqe->off = (uint64_t)offset;
+  sqe->user_data = userData;
+  pRing->sqArray[slot] = slot;
+}
+
+// submit the prepared entries and wait for all of them to complete, the canceled fsync is reported by pSyncCanceled
+static int32_t fileIoRingSubmit(SFileIoRing *pRing, uint32_t num, STdFileIo *pIos, bool *pSyncCanceled) {
+  __atomic_store_n(pRing->sqTail, *pRing->sqTail + num, __ATOMIC_RELEASE);
+
+  uint32_t toSubmit = num;
+  uint32_t completed = 0;
+  while (completed < num) {
+    int32_t ret = (int32_t)syscall(__NR_io_uring_enter, pRing->fd, toSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    if (ret < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    toSubmit -= TMIN((uint32_t)ret, toSubmit);
+
+    uint32_t head = *pRing->cqHead;
+    uint32_t tail = __atomic_load_n(pRing->cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head, ++completed) {
+      struct io_uring_cqe *cqe = &pRing->cqes[head & *pRing->cqMask];
+      if ((cqe->user_data & FILE_IO_FSYNC_FLAG) == 0) {
+        pIos[cqe->user_data].result = cqe->res;
+      } else if (cqe->res == -ECANCELED) {
+        *pSyncCanceled = true;
+      } else if (cqe->res < 0) {
+        pIos[cqe->user_data & ~FILE_IO_FSYNC_FLAG].result = cqe->res;
+      }
+    }
+    __atomic_store_n(pRing->cqHead, head, __ATOMIC_RELEASE);
+  }
+
+  return 0;
+}
+
+static void fileIoLock(STdFileIo *pIos, int32_t num, bool write, bool lock) {
+#if FILE_WITH_LOCK
+  for (int32_t i = 0; i < num; ++i) {
+    if (!fileIoIsFirstOfFile(pIos, i)) {
+      continue;
+    }
+
+    if (!lock) {
+      taosThreadRwlockUnlock(&pIos[i].pFile->rwlock);
+    } else if (write) {
+      taosThreadRwlockWrlock(&pIos[i].pFile->rwlock);
+    } else {
+      taosThreadRwlockRdlock(&pIos[i].pFile->rwlock);
+    }
+  }
+#endif
+}
+
+static int32_t fileIoDoRing(SFileIoRing *pRing, STdFileIo *pIos, int32_t num, bool write, bool fsync) {
+  int32_t numOfSync = 0;
+  bool    linked = false;
+  for (int32_t i = 0; i < num; ++i) {
+    numOfSync += (fsync && fileIoIsFirstOfFile(pIos, i)) ? 1 : 0;
+    // the ones using the current file position must be done in order
+    linked = linked || (pIos[i].offset < 0);
+  }
+
+  if (num + numOfSync > pRing->entries) {
+    fileIoDoSync(pIos, num, write, fsync);
+    return fileIoSetError(pIos, num, write);
+  }
+
+  // the fsync of each file is linked after all the writes, and is canceled if any of the writes fails
+  uint8_t opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+  uint8_t flags = (linked || numOfSync > 0) ? IOSQE_IO_LINK : 0;
+  for (int32_t i = 0; i < num; ++i) {
+    uint8_t f = (i == num - 1 && numOfSync == 0) ? 0 : flags;
+    fileIoRingPrepare(pRing, i, opcode, pIos[i].pFile->fd, pIos[i].buf, (uint32_t)pIos[i].count, pIos[i].offset, f, i);
+  }
+
+  for (int32_t i = 0, k = 0; k < numOfSync; ++i) {
+    if (!fileIoIsFirstOfFile(pIos, i)) continue;
+
+    k += 1;
+    fileIoRingPrepare(pRing, num + k - 1, IORING_OP_FSYNC, pIos[i].pFile->fd, NULL, 0, 0,
+                      (k < numOfSync) ? IOSQE_IO_LINK : 0, FILE_IO_FSYNC_FLAG | i);
+  }
+
+  fileIoLock(pIos, num, write, true);
+  bool    syncCanceled = false;
+  int32_t code = fileIoRingSubmit(pRing, num + numOfSync, pIos, &syncCanceled);
+  fileIoLock(pIos, num, write, false);
+  if (code != 0) {
+    return -1;
+  }
+
+  // finish the short and the canceled ones in order, it seldom happens on regular files
+  bool redone = false;
+  for (int32_t i = 0; i < num; ++i) {
+    STdFileIo *pIo = &pIos[i];
+    if (pIo->result == -ECANCELED && (linked || numOfSync > 0)) {
+      pIo->result = 0;
+    } else if (pIo->result < 0 || pIo->result >= pIo->count || (!write && pIo->result == 0)) {
+      continue;
+    }
+
+    fileIoDoOne(pIo, write);
+    redone = true;
+  }
+
+  for (int32_t i = 0; (redone || syncCanceled) && fsync && i < num; ++i) {
+    if (fileIoIsFirstOfFile(pIos, i) && pIos[i].result >= 0 && taosFsyncFile(pIos[i].pFile) < 0) {
+      pIos[i].result = -errno;
+    }
+  }
+
+  return fileIoSetError(pIos, num, write);
+}
+#endif
+
+int32_t taosInitFileIoUring(bool enable) {
+#ifdef USE_IO_URING
+  tsFileIoUring = false;
+  if (!enable) {
+    return 0;
+  }
+
+  // probe in the calling thread, the kernel may not support io_uring, or it may be forbidden by the seccomp rules
+  SFileIoRing *pRing = fileIoRingCreate(FILE_IO_RING_ENTRIES);
+  if (pRing == NULL) {
+    return -1;
+  }
+  fileIoRingDestroy(pRing);
+
+  // the option may be applied more than once, but the key of the rings is only created once
+  taosThreadOnce(&tsFileIoRingKeyInit, fileIoRingKeyCreate);
+  if (tsFileIoRingKeyCode != 0) {
+    return -1;
+  }
+
+  tsFileIoUring = true;
+  return 0;
+#else
+  return enable ? -1 : 0;
+#endif
+}
+
+static int32_t fileIoBatch(STdFileIo *pIos, int32_t num, bool write, bool fsync) {
+  for (int32_t i = 0; i < num; ++i) {
+    pIos[i].result = 0;
+  }
+
+#ifdef USE_IO_URING
+  SFileIoRing *pRing = (tsFileIoUring && num > 0) ? fileIoRingGet() : NULL;
+  if (pRing != NULL) {
+    return fileIoDoRing(pRing, pIos, num, write, fsync);
+  }
+#endif
+
+  fileIoDoSync(pIos, num, write, fsync);
+  return fileIoSetError(pIos, num, write);
+}
+
+bool taosFileIoUringEnabled() {
+#ifdef USE_IO_URING
+  return tsFileIoUring;
+#else
+  return false;
+#endif
+}
+
+int32_t taosReadFileBatch(STdFileIo *pIos, int32_t num) { return fileIoBatch(pIos, num, false, false); }
+
+int32_t taosWriteFileBatch(STdFileIo *pIos, int32_t num, bool fsync) { return fileIoBatch(pIos, num, true, fsync); }
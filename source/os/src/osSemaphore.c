@@ -100,10 +100,26 @@ int tsem_destroy(tsem_t* sem) {
   return -1;
 }
 
+// no futex here, the waiter polls and the wake up is a no-op
+int32_t taosFutexWait(int32_t volatile* addr, int32_t val) {
+  if (atomic_load_32(addr) == val) Sleep(1);
+  return 0;
+}
+
+int32_t taosFutexWake(int32_t volatile* addr, int32_t num) { return 0; }
+
 #elif defined(_TD_DARWIN_64)
 
 #include <libproc.h>
 
+// no futex here, the waiter polls and the wake up is a no-op
+int32_t taosFutexWait(int32_t volatile *addr, int32_t val) {
+  if (atomic_load_32(addr) == val) usleep(100);
+  return 0;
+}
+
+int32_t taosFutexWake(int32_t volatile *addr, int32_t num) { return 0; }
+
 int tsem_init(tsem_t *psem, int flags, unsigned int count) {
   *psem = dispatch_semaphore_create(count);
   if (*psem == NULL) return -1;
@@ -167,6 +183,7 @@ int32_t taosGetAppName(char *name, int32_t *len) {
  * linux implementation
  */
 
+#include <linux/futex.h>
 #include <sys/syscall.h>
 #include <unistd.h>
 
@@ -241,6 +258,17 @@ int32_t tsem_wait(tsem_t* sem) {
   return ret;
 }
 
+int32_t taosFutexWait(int32_t volatile* addr, int32_t val) {
+  if (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0) != 0 && errno != EAGAIN && errno != EINTR) {
+    return -1;
+  }
+  return 0;
+}
+
+int32_t taosFutexWake(int32_t volatile* addr, int32_t num) {
+  return (int32_t)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, num, NULL, NULL, 0);
+}
+
 int tsem2_init(tsem2_t* sem, int pshared, unsigned int value) {
   int ret = taosThreadMutexInit(&sem->mutex, NULL);
   if (ret != 0) return ret;
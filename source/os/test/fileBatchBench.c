@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+
+// the page writes of a file commit followed by one fsync, as the tsdb does: written one by one, or in batches of
+// taosWriteFileBatch with and without io_uring
+typedef enum {
+  BENCH_PER_PAGE = 0,
+  BENCH_BATCH,
+  BENCH_BATCH_URING,
+} EBenchMode;
+
+static const char *modeName[] = {"per_page", "batch", "batch_uring"};
+
+static int32_t benchOnce(EBenchMode mode, const char *fname, char *pPages, int32_t szPage, int32_t numOfPages,
+                         int32_t batch, STdFileIo *ios, int64_t *pUs) {
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    return -1;
+  }
+
+  int32_t code = 0;
+  int64_t st = taosGetTimestampUs();
+  if (mode == BENCH_PER_PAGE) {
+    for (int32_t i = 0; i < numOfPages && code == 0; ++i) {
+      int64_t offset = (int64_t)i * szPage;
+      if (taosPWriteFile(pFile, pPages + offset % (batch * szPage), szPage, offset) != szPage) {
+        code = -1;
+      }
+    }
+    if (code == 0 && taosFsyncFile(pFile) < 0) {
+      code = -1;
+    }
+  } else {
+    // the fsync is linked after the last batch
+    for (int32_t i = 0; i < numOfPages && code == 0; i += batch) {
+      int32_t num = TMIN(batch, numOfPages - i);
+      for (int32_t j = 0; j < num; ++j) {
+        ios[j] = (STdFileIo){
+            .pFile = pFile, .buf = pPages + j * szPage, .count = szPage, .offset = (int64_t)(i + j) * szPage};
+      }
+      code = taosWriteFileBatch(ios, num, i + num >= numOfPages);
+    }
+  }
+  *pUs = taosGetTimestampUs() - st;
+
+  taosCloseFile(&pFile);
+  taosRemoveFile(fname);
+  return code;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t szPage = 4096;
+  int32_t numOfPages = 16384;
+  int32_t batch = 16;
+  int32_t loops = 3;
+  char   *fname = "./fileBatchBench.data";
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-p") == 0 && i < argc - 1) {
+      szPage = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfPages = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i < argc - 1) {
+      batch = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      loops = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-f") == 0 && i < argc - 1) {
+      fname = argv[++i];
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-p]: page size in bytes, default: %d\n", szPage);
+      printf("  [-n]: number of pages written before the fsync, default: %d\n", numOfPages);
+      printf("  [-b]: number of pages in one batch, default: %d\n", batch);
+      printf("  [-l]: number of loops for each case, the best one is reported, default: %d\n", loops);
+      printf("  [-f]: the file written, default: %s\n", fname);
+      exit(0);
+    }
+  }
+
+  if (szPage <= 0 || numOfPages <= 0 || batch <= 0 || loops <= 0) {
+    printf("invalid options, page:%d pages:%d batch:%d loops:%d\n", szPage, numOfPages, batch, loops);
+    return -1;
+  }
+
+  char      *pPages = taosMemoryMalloc((int64_t)batch * szPage);
+  STdFileIo *ios = taosMemoryCalloc(batch, sizeof(STdFileIo));
+  if (pPages == NULL || ios == NULL) {
+    printf("out of memory, page:%d batch:%d\n", szPage, batch);
+    return -1;
+  }
+  for (int64_t i = 0; i < (int64_t)batch * szPage; ++i) {
+    pPages[i] = (char)(taosRand() & 0xFF);
+  }
+
+  // csv output
+  printf("mode,page_bytes,pages,batch,best_us,mb_per_sec\n");
+  for (EBenchMode mode = BENCH_PER_PAGE; mode <= BENCH_BATCH_URING; ++mode) {
+    if (taosInitFileIoUring(mode == BENCH_BATCH_URING) != 0) {
+      printf("%s,,,,,io_uring not supported\n", modeName[mode]);
+      continue;
+    }
+
+    int64_t best = INT64_MAX;
+    for (int32_t l = 0; l < loops; ++l) {
+      int64_t us = 0;
+      if (benchOnce(mode, fname, pPages, szPage, numOfPages, batch, ios, &us) != 0) {
+        printf("failed to run benchmark, mode:%s since %s\n", modeName[mode], strerror(errno));
+        return -1;
+      }
+      best = TMIN(best, us);
+    }
+
+    double mbps = (best == 0) ? 0 : ((double)szPage * numOfPages) / best;
+    printf("%s,%d,%d,%d,%" PRId64 ",%.1f\n", modeName[mode], szPage, numOfPages, batch, best, mbps);
+  }
+  taosInitFileIoUring(false);
+
+  taosMemoryFree(pPages);
+  taosMemoryFree(ios);
+  return 0;
+}
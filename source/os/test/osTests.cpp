@@ -168,6 +168,99 @@ TEST(osTest, osFile) {
   //printf("remove file success");
 }
 
+static void osFileBatchCheck() {
+  const int32_t numOfPages = 8;
+  const int32_t szPage = 4096;
+  char         *fname = "./osfilebatchtest.txt";
+  char         *wbuf = (char *)taosMemoryMalloc(numOfPages * szPage);
+  char         *rbuf = (char *)taosMemoryCalloc(1, numOfPages * szPage);
+  STdFileIo     ios[8] = {0};
+
+  for (int32_t i = 0; i < numOfPages * szPage; ++i) {
+    wbuf[i] = (char)(taosRand() & 0xFF);
+  }
+
+  // pages are written in reversed order with explicit offsets
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    int32_t pgno = numOfPages - 1 - i;
+    ios[i] = (STdFileIo){.pFile = pFile, .buf = wbuf + pgno * szPage, .count = szPage, .offset = pgno * szPage};
+  }
+  ASSERT_EQ(taosWriteFileBatch(ios, numOfPages, true), 0);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    ASSERT_EQ(ios[i].result, szPage);
+  }
+
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    ios[i] = (STdFileIo){.pFile = pFile, .buf = rbuf + i * szPage, .count = szPage, .offset = i * szPage};
+  }
+  ASSERT_EQ(taosReadFileBatch(ios, numOfPages), 0);
+  ASSERT_EQ(memcmp(wbuf, rbuf, numOfPages * szPage), 0);
+
+  // read beyond the end of file
+  STdFileIo io = {.pFile = pFile, .buf = rbuf, .count = szPage, .offset = numOfPages * szPage};
+  ASSERT_EQ(taosReadFileBatch(&io, 1), 0);
+  ASSERT_EQ(io.result, 0);
+
+  // a read across the end of file is short but not failed
+  io = (STdFileIo){.pFile = pFile, .buf = rbuf, .count = szPage, .offset = numOfPages * szPage - 100};
+  ASSERT_EQ(taosReadFileBatch(&io, 1), 0);
+  ASSERT_EQ(io.result, 100);
+  ASSERT_EQ(memcmp(wbuf + numOfPages * szPage - 100, rbuf, 100), 0);
+  taosCloseFile(&pFile);
+
+  // the failure of a write is reported by both the return value and the result
+  pFile = taosOpenFile(fname, TD_FILE_READ);
+  ASSERT_NE(pFile, nullptr);
+  io = (STdFileIo){.pFile = pFile, .buf = wbuf, .count = szPage, .offset = 0};
+  ASSERT_EQ(taosWriteFileBatch(&io, 1, false), -1);
+  ASSERT_LT(io.result, 0);
+  ASSERT_EQ(errno, (int32_t)-io.result);
+  taosCloseFile(&pFile);
+
+  // appended in order by the current file position
+  pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_APPEND | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    ios[i] = (STdFileIo){.pFile = pFile, .buf = wbuf + i * szPage, .count = szPage - i, .offset = -1};
+  }
+  ASSERT_EQ(taosWriteFileBatch(ios, numOfPages, false), 0);
+  taosCloseFile(&pFile);
+
+  pFile = taosOpenFile(fname, TD_FILE_READ);
+  ASSERT_NE(pFile, nullptr);
+  int64_t offset = 0;
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    ASSERT_EQ(taosPReadFile(pFile, rbuf, szPage - i, offset), szPage - i);
+    ASSERT_EQ(memcmp(wbuf + i * szPage, rbuf, szPage - i), 0);
+    offset += szPage - i;
+  }
+  taosCloseFile(&pFile);
+
+  taosRemoveFile(fname);
+  taosMemoryFree(wbuf);
+  taosMemoryFree(rbuf);
+}
+
+TEST(osTest, osFileBatch) {
+  ASSERT_EQ(taosInitFileIoUring(false), 0);
+  ASSERT_FALSE(taosFileIoUringEnabled());
+  osFileBatchCheck();
+
+  // falls back to the synchronous reads/writes if io_uring is not supported
+  int32_t code = taosInitFileIoUring(true);
+  printf("io_uring is %s\n", (code == 0) ? "enabled" : "not supported");
+  ASSERT_EQ(taosFileIoUringEnabled(), code == 0);
+  osFileBatchCheck();
+
+  // the option can be applied again, as the server config is
+  ASSERT_EQ(taosInitFileIoUring(true), code);
+  osFileBatchCheck();
+  taosInitFileIoUring(false);
+  ASSERT_FALSE(taosFileIoUringEnabled());
+}
+
 #ifndef OSFILE_PERFORMANCE_TEST
 
 #define MAX_WORDS          100
@@ -152,7 +152,9 @@ int32_t compareFloatVal(const void *pLeft, const void *pRight) {
   if (isnan(p2)) {
     return 1;
   }
-  if (FLT_EQUAL(p1, p2)) {
+
+  // the infinities of the same sign are equal, which FLT_EQUAL does not tell
+  if (p1 == p2 || FLT_EQUAL(p1, p2)) {
     return 0;
   }
   return FLT_GREATER(p1, p2) ? 1 : -1;
@@ -176,7 +178,7 @@ int32_t compareDoubleVal(const void *pLeft, const void *pRight) {
     return 1;
   }
 
-  if (FLT_EQUAL(p1, p2)) {
+  if (p1 == p2 || FLT_EQUAL(p1, p2)) {
     return 0;
   }
   return FLT_GREATER(p1, p2) ? 1 : -1;
@@ -1257,43 +1259,50 @@ static int32_t doExecRegexMatch(const char *pString, const char *pPattern) {
   return (ret == 0) ? 0 : 1;
 }
 
+// the strings of most rows fit in the stack buffers, so that the match of one row needs no malloc
+#define REGEX_MATCH_BUF_LEN 256
+
 int32_t comparestrRegexMatch(const void *pLeft, const void *pRight) {
+  char   patternBuf[REGEX_MATCH_BUF_LEN];
+  char   strBuf[REGEX_MATCH_BUF_LEN];
   size_t sz = varDataLen(pRight);
-  char  *pattern = taosMemoryMalloc(sz + 1);
+  char  *pattern = (sz < sizeof(patternBuf)) ? patternBuf : taosMemoryMalloc(sz + 1);
   memcpy(pattern, varDataVal(pRight), varDataLen(pRight));
   pattern[sz] = 0;
 
   sz = varDataLen(pLeft);
-  char *str = taosMemoryMalloc(sz + 1);
+  char *str = (sz < sizeof(strBuf)) ? strBuf : taosMemoryMalloc(sz + 1);
   memcpy(str, varDataVal(pLeft), sz);
   str[sz] = 0;
 
   int32_t ret = doExecRegexMatch(str, pattern);
 
-  taosMemoryFree(str);
-  taosMemoryFree(pattern);
+  if (str != strBuf) taosMemoryFree(str);
+  if (pattern != patternBuf) taosMemoryFree(pattern);
 
   return (ret == 0) ? 0 : 1;
 }
 
 int32_t comparewcsRegexMatch(const void *pString, const void *pPattern) {
+  char   patternBuf[REGEX_MATCH_BUF_LEN];
+  char   strBuf[REGEX_MATCH_BUF_LEN];
   size_t len = varDataLen(pPattern);
-  char  *pattern = taosMemoryMalloc(len + 1);
+  char  *pattern = (len < sizeof(patternBuf)) ? patternBuf : taosMemoryMalloc(len + 1);
 
   int convertLen = taosUcs4ToMbs((TdUcs4 *)varDataVal(pPattern), len, pattern);
   if (convertLen < 0) {
-    taosMemoryFree(pattern);
+    if (pattern != patternBuf) taosMemoryFree(pattern);
     return TSDB_CODE_APP_ERROR;
   }
 
   pattern[convertLen] = 0;
 
   len = varDataLen(pString);
-  char *str = taosMemoryMalloc(len + 1);
+  char *str = (len < sizeof(strBuf)) ? strBuf : taosMemoryMalloc(len + 1);
   convertLen = taosUcs4ToMbs((TdUcs4 *)varDataVal(pString), len, str);
   if (convertLen < 0) {
-    taosMemoryFree(str);
-    taosMemoryFree(pattern);
+    if (str != strBuf) taosMemoryFree(str);
+    if (pattern != patternBuf) taosMemoryFree(pattern);
 
     return TSDB_CODE_APP_ERROR;
   }
@@ -1302,8 +1311,8 @@ int32_t comparewcsRegexMatch(const void *pString, const void *pPattern) {
 
   int32_t ret = doExecRegexMatch(str, pattern);
 
-  taosMemoryFree(str);
-  taosMemoryFree(pattern);
+  if (str != strBuf) taosMemoryFree(str);
+  if (pattern != patternBuf) taosMemoryFree(pattern);
 
   return (ret == 0) ? 0 : 1;
 }
@@ -567,6 +567,12 @@ int32_t tsCompressBoolImp(const char *const input, const int32_t nelements, char
 }
 
 int32_t tsDecompressBoolImp(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX2__
+  if (tsSIMDEnable && (tsAVX2Enable || tsAVX512Enable)) {
+    return tsDecompressBoolImplAvx2(input, nelements, output);
+  }
+#endif
+
   int32_t ipos = -1, opos = 0;
   int32_t ele_per_byte = BITS_PER_BYTE / 2;
 
@@ -822,11 +828,17 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
     memcpy(output, input + 1, nelements * longBytes);
     return nelements * longBytes;
   } else if (input[0] == 1) {  // Decompress
+#if __AVX512F__
     if (tsSIMDEnable && tsAVX512Enable) {
-      tsDecompressTimestampAvx512(input, nelements, output, false);
-    } else if (tsSIMDEnable && tsAVX2Enable) {
-      tsDecompressTimestampAvx2(input, nelements, output, false);
-    } else {
+      return tsDecompressTimestampAvx512(input, nelements, output, false);
+    }
+#endif
+#if __AVX2__
+    if (tsSIMDEnable && tsAVX2Enable) {
+      return tsDecompressTimestampAvx2(input, nelements, output, false);
+    }
+#endif
+    {
       int64_t *ostream = (int64_t *)output;
 
       int32_t ipos = 1, opos = 0;
@@ -1030,6 +1042,17 @@ int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements,
     return nelements * DOUBLE_BYTES;
   }
 
+#if __AVX512F__
+  if (tsSIMDEnable && tsAVX512Enable) {
+    return tsDecompressDoubleImplAvx512(input, nelements, output);
+  }
+#endif
+#if __AVX2__
+  if (tsSIMDEnable && tsAVX2Enable) {
+    return tsDecompressDoubleImplAvx2(input, nelements, output);
+  }
+#endif
+
   uint8_t  flags = 0;
   int32_t  ipos = 1;
   int32_t  opos = 0;
@@ -1198,14 +1221,19 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
     return nelements * FLOAT_BYTES;
   }
 
+#if __AVX512F__
+  if (tsSIMDEnable && tsAVX512Enable) {
+    return tsDecompressFloatImplAvx512(input, nelements, output);
+  }
+#endif
+#if __AVX2__
   if (tsSIMDEnable && tsAVX2Enable) {
-    tsDecompressFloatImplAvx2(input, nelements, output);
-  } else if (tsSIMDEnable && tsAVX512Enable) {
-    tsDecompressFloatImplAvx512(input, nelements, output);
-  } else {  // alternative implementation without SIMD instructions.
-    tsDecompressFloatHelper(input, nelements, (float *)output);
+    return tsDecompressFloatImplAvx2(input, nelements, output);
   }
+#endif
 
+  // alternative implementation without SIMD instructions.
+  tsDecompressFloatHelper(input, nelements, (float *)output);
   return nelements * FLOAT_BYTES;
 }
 
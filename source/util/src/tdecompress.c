@@ -40,553 +40,499 @@ int32_t getWordLength(char type) {
   return wordLength;
 }
 
-int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type) {
-  int32_t word_length = getWordLength(type);
+// The decoders below work column at a time: the variable length part of a codec is parsed by a scalar loop into the
+// output buffer, and the serial dependency (prefix sum or prefix xor) is then resolved in vector registers.
 
-  // Selector value:           0  1   2   3   4   5   6   7   8  9  10  11 12  13  14  15
-  char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
-  int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+/* ------------------------------------------- prefix sum/xor kernels ------------------------------------------- */
+#if __AVX2__
+// p[i] = init + p[0] + ... + p[i]
+static int64_t prefixSumInt64Avx2(int64_t *p, int32_t num, int64_t init) {
+  int32_t batch = num >> 2;
+  __m256i carry = _mm256_set1_epi64x(init);
+
+  for (int32_t i = 0; i < batch; ++i) {
+    __m256i x = _mm256_loadu_si256((__m256i *)&p[i << 2]);
+
+    // [d0, d0+d1 | d2, d2+d3]
+    x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+    // [d0, d0+d1 | d0+d1+d2, d0+d1+d2+d3]
+    x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_setzero_si256(), _mm256_permute4x64_epi64(x, 0x55), 0xF0));
+    x = _mm256_add_epi64(x, carry);
+
+    _mm256_storeu_si256((__m256i *)&p[i << 2], x);
+    carry = _mm256_permute4x64_epi64(x, 0xFF);
+  }
 
-  const char *ip = input + 1;
-  int32_t     count = 0;
-  int32_t     _pos = 0;
-  int64_t     prevValue = 0;
+  int64_t prev = (batch > 0) ? p[(batch << 2) - 1] : init;
+  for (int32_t i = batch << 2; i < num; ++i) {
+    prev += p[i];
+    p[i] = prev;
+  }
 
-#if __AVX2__ || __AVX512F__
-  while (_pos < nelements) {
-    uint64_t w = *(uint64_t*) ip;
+  return prev;
+}
 
-    char    selector = (char)(w & INT64MASK(4));       // selector = 4
-    char    bit = bit_per_integer[(int32_t)selector];  // bit = 3
-    int32_t elems = selector_to_elems[(int32_t)selector];
+// p[i] = init ^ p[0] ^ ... ^ p[i]
+static uint64_t prefixXorInt64Avx2(uint64_t *p, int32_t num, uint64_t init) {
+  int32_t batch = num >> 2;
+  __m256i carry = _mm256_set1_epi64x(init);
 
-    // Optimize the performance, by remove the constantly switch operation.
-    int32_t  v = 4;
-    uint64_t zigzag_value = 0;
-    uint64_t mask = INT64MASK(bit);
+  for (int32_t i = 0; i < batch; ++i) {
+    __m256i x = _mm256_loadu_si256((__m256i *)&p[i << 2]);
 
-    switch (type) {
-      case TSDB_DATA_TYPE_BIGINT: {
-        int64_t* p = (int64_t*) output;
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 8));
+    x = _mm256_xor_si256(x, _mm256_blend_epi32(_mm256_setzero_si256(), _mm256_permute4x64_epi64(x, 0x55), 0xF0));
+    x = _mm256_xor_si256(x, carry);
 
-        int32_t gRemainder = (nelements - _pos);
-        int32_t num = (gRemainder > elems)? elems:gRemainder;
+    _mm256_storeu_si256((__m256i *)&p[i << 2], x);
+    carry = _mm256_permute4x64_epi64(x, 0xFF);
+  }
 
-        int32_t batch = 0;
-        int32_t remain = 0;
-        if (tsSIMDEnable && tsAVX512Enable) {
-#if __AVX512F__
-        batch = num >> 3;
-        remain = num & 0x07;
-#endif
-        } else if (tsSIMDEnable && tsAVX2Enable) {
-#if __AVX2__
-        batch = num >> 2;
-        remain = num & 0x03;
-#endif
-        }
+  uint64_t prev = (batch > 0) ? p[(batch << 2) - 1] : init;
+  for (int32_t i = batch << 2; i < num; ++i) {
+    prev ^= p[i];
+    p[i] = prev;
+  }
 
-        if (selector == 0 || selector == 1) {
-          if (tsSIMDEnable && tsAVX512Enable) {
-#if __AVX512F__
-            for (int32_t i = 0; i < batch; ++i) {
-            __m512i prev = _mm512_set1_epi64(prevValue);
-            _mm512_storeu_si512((__m512i *)&p[_pos], prev);
-            _pos += 8;	//handle 64bit x 8 = 512bit
-            }
-            for (int32_t i = 0; i < remain; ++i) {
-            p[_pos++] = prevValue;
-            }
-#endif
-          } else if (tsSIMDEnable && tsAVX2Enable) {
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i prev = _mm256_set1_epi64x(prevValue);
-              _mm256_storeu_si256((__m256i *)&p[_pos], prev);
-              _pos += 4;
-            }
-
-            for (int32_t i = 0; i < remain; ++i) {
-              p[_pos++] = prevValue;
-            }
-
-          } else { // alternative implementation without SIMD instructions.
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          }
-        } else {
-          if (tsSIMDEnable && tsAVX512Enable) {
- #if __AVX512F__
-            __m512i sum_mask1 = _mm512_set_epi64(6, 6, 4, 4, 2, 2, 0, 0);
-            __m512i sum_mask2 = _mm512_set_epi64(5, 5, 5, 5, 1, 1, 1, 1);
-            __m512i sum_mask3 = _mm512_set_epi64(3, 3, 3, 3, 3, 3, 3, 3);
-            __m512i base = _mm512_set1_epi64(w);
-            __m512i maskVal = _mm512_set1_epi64(mask);
-            __m512i shiftBits = _mm512_set_epi64(bit * 7 + 4, bit * 6 + 4, bit * 5 + 4, bit * 4 + 4, bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
-            __m512i inc = _mm512_set1_epi64(bit << 3);
-
-            for (int32_t i = 0; i < batch; ++i) {
-
-            __m512i after = _mm512_srlv_epi64(base, shiftBits);
-            __m512i zigzagVal = _mm512_and_si512(after, maskVal);
-
-            // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-            __m512i signmask = _mm512_and_si512(_mm512_set1_epi64(1), zigzagVal);
-            signmask = _mm512_sub_epi64(_mm512_setzero_si512(), signmask);
-            __m512i delta = _mm512_xor_si512(_mm512_srli_epi64(zigzagVal, 1), signmask);
-
-            // calculate the cumulative sum (prefix sum) for each number
-            // decode[0] =  prevValue + final[0]
-            // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
-            // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
-            // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
-
-
-            //7		6		5		4		3		2		1		0
-            //D7		D6		D5		D4		D3		D2		D1		D0
-            //D6		0		D4		0		D2		0		D0		0
-            //D7+D6		D6		D5+D4		D4		D3+D2		D2		D1+D0		D0
-            //13		6		9		4		5		2		1		0
-            __m512i prev = _mm512_set1_epi64(prevValue);
-            __m512i cum_sum = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xaa, sum_mask1, delta));
-            cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xcc, sum_mask2, cum_sum));
-            cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xf0, sum_mask3, cum_sum));
-
-
-
-            //13		6		9		4		5		2		1		0
-            //D7,D6		D6		D5,D4		D4		D3,D2		D2		D1,D0		D0
-            //+D5,D4	D5,D4,		0		0		D1,D0		D1,D0		0		0
-            //D7~D4		D6~D4		D5~D4		D4		D3~D0		D2~D0		D1~D0		D0
-            //22		15		9		4		6		3		1		0
-            //
-            //D3~D0		D3~D0		D3~D0		D3~D0		0		0		0		0
-            //28		21		15		10		6		3		1		0
-
-
-            cum_sum = _mm512_add_epi64(cum_sum, prev);
-            _mm512_storeu_si512((__m512i *)&p[_pos], cum_sum);
-
-            shiftBits = _mm512_add_epi64(shiftBits, inc);
-            prevValue = p[_pos + 7];
-            _pos += 8;
-
-            }
-            // handle the remain value
-            for (int32_t i = 0; i < remain; i++) {
-            zigzag_value = ((w >> (v + (batch * bit * 8))) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = prevValue;
-            v += bit;
-            }
-#endif
-          } else if (tsSIMDEnable && tsAVX2Enable) {
-            __m256i base = _mm256_set1_epi64x(w);
-            __m256i maskVal = _mm256_set1_epi64x(mask);
-
-            __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
-            __m256i inc = _mm256_set1_epi64x(bit << 2);
-
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i after = _mm256_srlv_epi64(base, shiftBits);
-              __m256i zigzagVal = _mm256_and_si256(after, maskVal);
-
-              // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-              __m256i signmask = _mm256_and_si256(_mm256_set1_epi64x(1), zigzagVal);
-              signmask = _mm256_sub_epi64(_mm256_setzero_si256(), signmask);
-
-              // get four zigzag values here
-              __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
-
-              // calculate the cumulative sum (prefix sum) for each number
-              // decode[0] = prevValue + final[0]
-              // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
-              // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
-              // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
-
-              //  1, 2, 3, 4
-              //+ 0, 1, 0, 3
-              //  1, 3, 3, 7
-              // shift and add for the first round
-              __m128i prev = _mm_set1_epi64x(prevValue);
-              __m256i x = _mm256_slli_si256(delta, 8);
-
-              delta = _mm256_add_epi64(delta, x);
-              _mm256_storeu_si256((__m256i *)&p[_pos], delta);
-
-              //  1, 3, 3, 7
-              //+ 0, 0, 3, 3
-              //  1, 3, 6, 10
-              // shift and add operation for the second round
-              __m128i firstPart = _mm_loadu_si128((__m128i *)&p[_pos]);
-              __m128i secondItem = _mm_set1_epi64x(p[_pos + 1]);
-              __m128i secPart = _mm_add_epi64(_mm_loadu_si128((__m128i *)&p[_pos + 2]), secondItem);
-              firstPart = _mm_add_epi64(firstPart, prev);
-              secPart = _mm_add_epi64(secPart, prev);
-
-              // save it in the memory
-              _mm_storeu_si128((__m128i *)&p[_pos], firstPart);
-              _mm_storeu_si128((__m128i *)&p[_pos + 2], secPart);
-
-              shiftBits = _mm256_add_epi64(shiftBits, inc);
-              prevValue = p[_pos + 3];
-              _pos += 4;
-            }
-
-            // handle the remain value
-            for (int32_t i = 0; i < remain; i++) {
-              zigzag_value = ((w >> (v + (batch * bit * 4))) & mask);
-              prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          } else {  // alternative implementation without SIMD instructions.
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              zigzag_value = ((w >> v) & mask);
-              prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          }
-        }
-      } break;
-      case TSDB_DATA_TYPE_INT: {
-        int32_t* p = (int32_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int32_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int32_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
-      case TSDB_DATA_TYPE_SMALLINT: {
-        int16_t* p = (int16_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int16_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int16_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
+  return prev;
+}
 
-      case TSDB_DATA_TYPE_TINYINT: {
-        int8_t *p = (int8_t *)output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int8_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int8_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
-    }
+static uint32_t prefixXorInt32Avx2(uint32_t *p, int32_t num, uint32_t init) {
+  int32_t batch = num >> 3;
+  __m256i carry = _mm256_set1_epi32(init);
+  __m256i last = _mm256_set1_epi32(3);
 
-    ip += LONG_BYTES;
+  for (int32_t i = 0; i < batch; ++i) {
+    __m256i x = _mm256_loadu_si256((__m256i *)&p[i << 3]);
+
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 4));
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 8));
+    x = _mm256_xor_si256(x, _mm256_blend_epi32(_mm256_setzero_si256(), _mm256_permutevar8x32_epi32(x, last), 0xF0));
+    x = _mm256_xor_si256(x, carry);
+
+    _mm256_storeu_si256((__m256i *)&p[i << 3], x);
+    carry = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
   }
 
-#endif
-  return nelements * word_length;
-}
+  uint32_t prev = (batch > 0) ? p[(batch << 3) - 1] : init;
+  for (int32_t i = batch << 3; i < num; ++i) {
+    prev ^= p[i];
+    p[i] = prev;
+  }
 
-int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output) {
-#if __AVX512F__
-    // todo add it
-#endif
-  return 0;
+  return prev;
 }
-
-// todo add later
-int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output) {
-#if __AVX2__
 #endif
-  return 0;
-}
-
-int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output,
-                                  bool bigEndian) {
-#if 0
-  int64_t *ostream = (int64_t *)output;
-  int32_t  ipos = 1, opos = 0;
-  __m128i  prevVal = _mm_setzero_si128();
-  __m128i  prevDelta = _mm_setzero_si128();
 
-#if __AVX2__
-  int32_t batch = nelements >> 1;
-  int32_t remainder = nelements & 0x01;
-  __mmask16 mask2[16] = {0, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff};
+#if __AVX512F__
+// the lanes are shifted up by s with zeros shifted in
+#define SHIFT_UP_EPI64(x, s) _mm512_alignr_epi64((x), _mm512_setzero_si512(), 8 - (s))
+#define SHIFT_UP_EPI32(x, s) _mm512_alignr_epi32((x), _mm512_setzero_si512(), 16 - (s))
 
-  int32_t i = 0;
-  if (batch > 1) {
-    // first loop
-    uint8_t flags = input[ipos++];
+static int64_t prefixSumInt64Avx512(int64_t *p, int32_t num, int64_t init) {
+  int32_t batch = num >> 3;
+  __m512i carry = _mm512_set1_epi64(init);
 
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
+  for (int32_t i = 0; i < batch; ++i) {
+    __m512i x = _mm512_loadu_si512((__m512i *)&p[i << 3]);
 
-    __m128i data1;
-    if (nbytes1 == 0) {
-      data1 = _mm_setzero_si128();
-    } else {
-      memcpy(&data1, (const void*) (input + ipos), nbytes1);
-    }
+    x = _mm512_add_epi64(x, SHIFT_UP_EPI64(x, 1));
+    x = _mm512_add_epi64(x, SHIFT_UP_EPI64(x, 2));
+    x = _mm512_add_epi64(x, SHIFT_UP_EPI64(x, 4));
+    x = _mm512_add_epi64(x, carry);
 
-    __m128i data2;
-    if (nbytes2 == 0) {
-      data2 = _mm_setzero_si128();
-    } else {
-      memcpy(&data2, (const void*) (input + ipos + nbytes1), nbytes2);
-    }
-
-    data2 = _mm_broadcastq_epi64(data2);
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+    _mm512_storeu_si512((__m512i *)&p[i << 3], x);
+    carry = _mm512_permutexvar_epi64(_mm512_set1_epi64(7), x);
+  }
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+  int64_t prev = (batch > 0) ? p[(batch << 3) - 1] : init;
+  for (int32_t i = batch << 3; i < num; ++i) {
+    prev += p[i];
+    p[i] = prev;
+  }
 
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+  return prev;
+}
 
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
+static uint64_t prefixXorInt64Avx512(uint64_t *p, int32_t num, uint64_t init) {
+  int32_t batch = num >> 3;
+  __m512i carry = _mm512_set1_epi64(init);
 
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+  for (int32_t i = 0; i < batch; ++i) {
+    __m512i x = _mm512_loadu_si512((__m512i *)&p[i << 3]);
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI64(x, 1));
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI64(x, 2));
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI64(x, 4));
+    x = _mm512_xor_si512(x, carry);
 
-    // keep the previous delta of delta, for the first item
-    prevDelta = _mm_shuffle_epi32(deltaOfDelta, 0xEE);
+    _mm512_storeu_si512((__m512i *)&p[i << 3], x);
+    carry = _mm512_permutexvar_epi64(_mm512_set1_epi64(7), x);
+  }
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
-    i += 1;
+  uint64_t prev = (batch > 0) ? p[(batch << 3) - 1] : init;
+  for (int32_t i = batch << 3; i < num; ++i) {
+    prev ^= p[i];
+    p[i] = prev;
   }
 
-  // the remain
-  for(; i < batch; ++i) {
-    uint8_t flags = input[ipos++];
+  return prev;
+}
 
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
+static uint32_t prefixXorInt32Avx512(uint32_t *p, int32_t num, uint32_t init) {
+  int32_t batch = num >> 4;
+  __m512i carry = _mm512_set1_epi32(init);
 
-//    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-//    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    __m128i data1;
-    if (nbytes1 == 0) {
-      data1 = _mm_setzero_si128();
-    } else {
-      int64_t dd = 0;
-      memcpy(&dd, (const void*) (input + ipos), nbytes1);
-      data1 = _mm_loadu_si64(&dd);
-    }
+  for (int32_t i = 0; i < batch; ++i) {
+    __m512i x = _mm512_loadu_si512((__m512i *)&p[i << 4]);
 
-    __m128i data2;
-    if (nbytes2 == 0) {
-      data2 = _mm_setzero_si128();
-    } else {
-      int64_t dd = 0;
-      memcpy(&dd, (const void*) (input + ipos + nbytes1), nbytes2);
-      data2 = _mm_loadu_si64(&dd);
-    }
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI32(x, 1));
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI32(x, 2));
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI32(x, 4));
+    x = _mm512_xor_si512(x, SHIFT_UP_EPI32(x, 8));
+    x = _mm512_xor_si512(x, carry);
 
-    data2 = _mm_broadcastq_epi64(data2);
+    _mm512_storeu_si512((__m512i *)&p[i << 4], x);
+    carry = _mm512_permutexvar_epi32(_mm512_set1_epi32(15), x);
+  }
 
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+  uint32_t prev = (batch > 0) ? p[(batch << 4) - 1] : init;
+  for (int32_t i = batch << 4; i < num; ++i) {
+    prev ^= p[i];
+    p[i] = prev;
+  }
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+  return prev;
+}
+#endif
 
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+/* ------------------------------------------------ simple8b ------------------------------------------------ */
+// Selector value:                          0    1    2   3   4   5   6   7   8  9  10  11 12  13  14  15
+static const char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
+static const int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+
+// decode the first num values packed in the word w, starting from the value prev, and return the last one
+static FORCE_INLINE int64_t decodeSimple8bWord(uint64_t w, int32_t bit, int32_t num, int64_t prev, int64_t *p) {
+  uint64_t mask = INT64MASK(bit);
+  int32_t  v = 4;
+
+  for (int32_t i = 0; i < num; ++i) {
+    uint64_t zigzag_value = ((w >> v) & mask);
+    prev += ZIGZAG_DECODE(int64_t, zigzag_value);
+    p[i] = prev;
+    v += bit;
+  }
 
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
+  return prev;
+}
 
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+#if __AVX2__
+static int64_t decodeSimple8bWordAvx2(uint64_t w, int32_t bit, int32_t num, int64_t prev, int64_t *p) {
+  int32_t batch = num >> 2;
+  __m256i base = _mm256_set1_epi64x(w);
+  __m256i maskVal = _mm256_set1_epi64x(INT64MASK(bit));
+  __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
+  __m256i inc = _mm256_set1_epi64x(bit << 2);
+  __m256i one = _mm256_set1_epi64x(1);
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+  for (int32_t i = 0; i < batch; ++i) {
+    __m256i zigzagVal = _mm256_and_si256(_mm256_srlv_epi64(base, shiftBits), maskVal);
 
-    // keep the previous delta of delta
-    __m128i delta = _mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta);
-    prevDelta = _mm_shuffle_epi32(_mm_add_epi64(delta, prevDelta), 0xEE);
+    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+    __m256i signmask = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(zigzagVal, one));
+    __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
+    _mm256_storeu_si256((__m256i *)&p[i << 2], delta);
+    shiftBits = _mm256_add_epi64(shiftBits, inc);
   }
 
-  if (remainder > 0) {
-    uint64_t dd = 0;
-    uint8_t  flags = input[ipos++];
+  prev = prefixSumInt64Avx2(p, batch << 2, prev);
 
-    int32_t nbytes = flags & INT8MASK(4);
-    int64_t deltaOfDelta = 0;
-    if (nbytes == 0) {
-      deltaOfDelta = 0;
-    } else {
-      //      if (is_bigendian()) {
-      //        memcpy(((char *)(&dd1)) + longBytes - nbytes, input + ipos, nbytes);
-      //      } else {
-      memcpy(&dd, input + ipos, nbytes);
-      //      }
-      deltaOfDelta = ZIGZAG_DECODE(int64_t, dd);
-    }
-
-    ipos += nbytes;
-    if (opos == 0) {
-      ostream[opos++] = deltaOfDelta;
-    } else {
-      int64_t prevDeltaX = deltaOfDelta + prevDelta[1];
-      ostream[opos++] = prevVal[1] + prevDeltaX;
-    }
+  // handle the remain value
+  uint64_t mask = INT64MASK(bit);
+  int32_t  v = 4 + (batch << 2) * bit;
+  for (int32_t i = batch << 2; i < num; ++i) {
+    uint64_t zigzag_value = ((w >> v) & mask);
+    prev += ZIGZAG_DECODE(int64_t, zigzag_value);
+    p[i] = prev;
+    v += bit;
   }
-#endif
-#endif
-  return 0;
-}
 
-int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
-                                    bool UNUSED_PARAM(bigEndian)) {
-  int64_t *ostream = (int64_t *)output;
-  int32_t  ipos = 1, opos = 0;
+  return prev;
+}
+#endif
 
-#if __AVX512VL__
+#if __AVX512F__
+static int64_t decodeSimple8bWordAvx512(uint64_t w, int32_t bit, int32_t num, int64_t prev, int64_t *p) {
+  int32_t batch = num >> 3;
+  __m512i base = _mm512_set1_epi64(w);
+  __m512i maskVal = _mm512_set1_epi64(INT64MASK(bit));
+  __m512i shiftBits = _mm512_set_epi64(bit * 7 + 4, bit * 6 + 4, bit * 5 + 4, bit * 4 + 4, bit * 3 + 4, bit * 2 + 4,
+                                       bit + 4, 4);
+  __m512i inc = _mm512_set1_epi64(bit << 3);
+  __m512i one = _mm512_set1_epi64(1);
+
+  for (int32_t i = 0; i < batch; ++i) {
+    __m512i zigzagVal = _mm512_and_si512(_mm512_srlv_epi64(base, shiftBits), maskVal);
 
-  __m128i  prevVal = _mm_setzero_si128();
-  __m128i  prevDelta = _mm_setzero_si128();
+    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+    __m512i signmask = _mm512_sub_epi64(_mm512_setzero_si512(), _mm512_and_si512(zigzagVal, one));
+    __m512i delta = _mm512_xor_si512(_mm512_srli_epi64(zigzagVal, 1), signmask);
 
-  int32_t   numOfBatch = nelements >> 1;
-  int32_t   remainder = nelements & 0x01;
-  __mmask16 mask2[16] = {0, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff};
+    _mm512_storeu_si512((__m512i *)&p[i << 3], delta);
+    shiftBits = _mm512_add_epi64(shiftBits, inc);
+  }
 
-  int32_t i = 0;
-  if (numOfBatch > 1) {
-    // first loop
-    uint8_t flags = input[ipos++];
+  prev = prefixSumInt64Avx512(p, batch << 3, prev);
 
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
+  // handle the remain value
+  uint64_t mask = INT64MASK(bit);
+  int32_t  v = 4 + (batch << 3) * bit;
+  for (int32_t i = batch << 3; i < num; ++i) {
+    uint64_t zigzag_value = ((w >> v) & mask);
+    prev += ZIGZAG_DECODE(int64_t, zigzag_value);
+    p[i] = prev;
+    v += bit;
+  }
 
-    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    data2 = _mm_broadcastq_epi64(data2);
+  return prev;
+}
+#endif
 
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type) {
+  int32_t word_length = getWordLength(type);
+  if (word_length == -1) {
+    return word_length;
+  }
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+  const char *ip = input + 1;
+  int32_t     _pos = 0;
+  int64_t     prevValue = 0;
 
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+  // the narrower types are decoded into int64 first, one word at a time
+  int64_t buf[240];
 
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
+  while (_pos < nelements) {
+    uint64_t w = 0;
+    memcpy(&w, ip, LONG_BYTES);
 
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+    char    selector = (char)(w & INT64MASK(4));
+    char    bit = bit_per_integer[(int32_t)selector];
+    int32_t elems = selector_to_elems[(int32_t)selector];
+    int32_t num = TMIN(elems, nelements - _pos);
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+    int64_t *p = (type == TSDB_DATA_TYPE_BIGINT) ? ((int64_t *)output) + _pos : buf;
+    if (selector == 0 || selector == 1) {
+      for (int32_t i = 0; i < num; ++i) {
+        p[i] = prevValue;
+      }
+    } else {
+#if __AVX512F__
+      if (tsSIMDEnable && tsAVX512Enable) {
+        prevValue = decodeSimple8bWordAvx512(w, bit, num, prevValue, p);
+      } else
+#endif
+#if __AVX2__
+      if (tsSIMDEnable && tsAVX2Enable) {
+        prevValue = decodeSimple8bWordAvx2(w, bit, num, prevValue, p);
+      } else
+#endif
+      {
+        prevValue = decodeSimple8bWord(w, bit, num, prevValue, p);
+      }
+    }
 
-    // keep the previous delta of delta, for the first item
-    prevDelta = _mm_shuffle_epi32(deltaOfDelta, 0xEE);
+    switch (type) {
+      case TSDB_DATA_TYPE_INT: {
+        int32_t *o = ((int32_t *)output) + _pos;
+        for (int32_t i = 0; i < num; ++i) {
+          o[i] = (int32_t)p[i];
+        }
+      } break;
+      case TSDB_DATA_TYPE_SMALLINT: {
+        int16_t *o = ((int16_t *)output) + _pos;
+        for (int32_t i = 0; i < num; ++i) {
+          o[i] = (int16_t)p[i];
+        }
+      } break;
+      case TSDB_DATA_TYPE_TINYINT: {
+        int8_t *o = ((int8_t *)output) + _pos;
+        for (int32_t i = 0; i < num; ++i) {
+          o[i] = (int8_t)p[i];
+        }
+      } break;
+      default:
+        break;
+    }
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
-    i += 1;
+    _pos += num;
+    ip += LONG_BYTES;
   }
 
-  // the remain
-  for(; i < numOfBatch; ++i) {
+  return nelements * word_length;
+}
+
+/* ------------------------------------------- delta of delta timestamp ------------------------------------------- */
+// the parsing is scalar, and is shared by the AVX2 and the AVX-512 decoders
+#if __AVX2__ || __AVX512F__
+// parse the delta of delta values, the first one is the start value and is taken out of the delta chain
+static int64_t parseTimestampDeltaOfDelta(const char *const input, const int32_t nelements, int64_t *ostream) {
+  int32_t ipos = 1;
+
+  for (int32_t opos = 0; opos < nelements; opos += 2) {
     uint8_t flags = input[ipos++];
 
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
+    uint64_t dd1 = 0;
+    int8_t   nbytes1 = flags & INT8MASK(4);
+    memcpy(&dd1, input + ipos, nbytes1);
+    ipos += nbytes1;
+    ostream[opos] = ZIGZAG_DECODE(int64_t, dd1);
+
+    if (opos + 1 < nelements) {
+      uint64_t dd2 = 0;
+      int8_t   nbytes2 = (flags >> 4) & INT8MASK(4);
+      memcpy(&dd2, input + ipos, nbytes2);
+      ipos += nbytes2;
+      ostream[opos + 1] = ZIGZAG_DECODE(int64_t, dd2);
+    }
+  }
 
-    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    data2 = _mm_broadcastq_epi64(data2);
+  int64_t start = ostream[0];
+  ostream[0] = 0;
+  return start;
+}
+#endif
 
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output,
+                                  bool UNUSED_PARAM(bigEndian)) {
+#if __AVX2__
+  int64_t *ostream = (int64_t *)output;
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+  // delta of delta -> delta -> value
+  int64_t start = parseTimestampDeltaOfDelta(input, nelements, ostream);
+  prefixSumInt64Avx2(ostream, nelements, 0);
+  prefixSumInt64Avx2(ostream, nelements, start);
+#endif
+  return nelements * LONG_BYTES;
+}
 
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
+                                    bool UNUSED_PARAM(bigEndian)) {
+#if __AVX512F__
+  int64_t *ostream = (int64_t *)output;
 
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
+  // delta of delta -> delta -> value
+  int64_t start = parseTimestampDeltaOfDelta(input, nelements, ostream);
+  prefixSumInt64Avx512(ostream, nelements, 0);
+  prefixSumInt64Avx512(ostream, nelements, start);
+#endif
+  return nelements * LONG_BYTES;
+}
 
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+/* ------------------------------------------------ xor float/double ------------------------------------------------ */
+#if __AVX2__ || __AVX512F__
+static void parseFloatXorDiff(const char *const input, const int32_t nelements, uint32_t *ostream) {
+  uint8_t flags = 0;
+  int32_t ipos = 1;
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+  for (int32_t i = 0; i < nelements; i++) {
+    if ((i & 0x01) == 0) {
+      flags = input[ipos++];
+    }
 
-    // keep the previous delta of delta
-    __m128i delta = _mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta);
-    prevDelta = _mm_shuffle_epi32(_mm_add_epi64(delta, prevDelta), 0xEE);
+    uint8_t  flag = flags & INT8MASK(4);
+    int32_t  nbytes = (flag & INT8MASK(3)) + 1;
+    uint32_t diff = 0;
+    memcpy(&diff, input + ipos, nbytes);
+    ipos += nbytes;
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
+    flags >>= 4;
+    ostream[i] = diff << ((FLOAT_BYTES - nbytes) * BITS_PER_BYTE * (flag >> 3));
   }
+}
 
-  if (remainder > 0) {
-    uint64_t dd = 0;
-    uint8_t  flags = input[ipos++];
+static void parseDoubleXorDiff(const char *const input, const int32_t nelements, uint64_t *ostream) {
+  uint8_t flags = 0;
+  int32_t ipos = 1;
 
-    int32_t nbytes = flags & INT8MASK(4);
-    int64_t deltaOfDelta = 0;
-    if (nbytes == 0) {
-      deltaOfDelta = 0;
-    } else {
-      memcpy(&dd, input + ipos, nbytes);
-      deltaOfDelta = ZIGZAG_DECODE(int64_t, dd);
+  for (int32_t i = 0; i < nelements; i++) {
+    if ((i & 0x01) == 0) {
+      flags = input[ipos++];
     }
 
+    uint8_t  flag = flags & 0x0f;
+    int32_t  nbytes = (flag & 0x7) + 1;
+    uint64_t diff = 0;
+    memcpy(&diff, input + ipos, nbytes);
     ipos += nbytes;
-    if (opos == 0) {
-      ostream[opos++] = deltaOfDelta;
-    } else {
-      int64_t prevDeltaX = deltaOfDelta + prevDelta[1];
-      ostream[opos++] = prevVal[1] + prevDeltaX;
-    }
+
+    flags >>= 4;
+    ostream[i] = diff << ((LONG_BYTES - nbytes) * BITS_PER_BYTE * (flag >> 3));
   }
+}
+#endif
+
+int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX512F__
+  parseFloatXorDiff(input, nelements, (uint32_t *)output);
+  prefixXorInt32Avx512((uint32_t *)output, nelements, 0);
+#endif
+  return nelements * FLOAT_BYTES;
+}
+
+int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX2__
+  parseFloatXorDiff(input, nelements, (uint32_t *)output);
+  prefixXorInt32Avx2((uint32_t *)output, nelements, 0);
+#endif
+  return nelements * FLOAT_BYTES;
+}
 
+int32_t tsDecompressDoubleImplAvx512(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX512F__
+  parseDoubleXorDiff(input, nelements, (uint64_t *)output);
+  prefixXorInt64Avx512((uint64_t *)output, nelements, 0);
 #endif
-  return 0;
+  return nelements * DOUBLE_BYTES;
+}
+
+int32_t tsDecompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX2__
+  parseDoubleXorDiff(input, nelements, (uint64_t *)output);
+  prefixXorInt64Avx2((uint64_t *)output, nelements, 0);
+#endif
+  return nelements * DOUBLE_BYTES;
+}
+
+/* ------------------------------------------------ bit-packing bool ------------------------------------------------ */
+// AVX-512 has no byte shuffle without AVX512BW, which is not enabled in the build, so there is only an AVX2 version.
+int32_t tsDecompressBoolImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+  int32_t i = 0;
+#if __AVX2__
+  // output j is taken from the 2 bits at (j % 4) * 2 of the input byte j / 4, and 1 -> 1, 2 -> null, 0/3 -> 0
+  __m256i shuffle = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6,
+                                     6, 7, 7, 7, 7);
+  __m256i posMask = _mm256_set1_epi32(0xC0300C03);
+  __m256i trueVal = _mm256_set1_epi32(0x40100401);
+  __m256i nullVal = _mm256_set1_epi32(0x80200802);
+  __m256i one = _mm256_set1_epi8(1);
+  __m256i null = _mm256_set1_epi8(TSDB_DATA_BOOL_NULL);
+
+  for (; i + 32 <= nelements; i += 32) {
+    __m128i bytes = _mm_loadl_epi64((const __m128i *)(input + (i >> 2)));
+    __m256i x = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(bytes), shuffle);
+
+    x = _mm256_and_si256(x, posMask);
+    __m256i res = _mm256_or_si256(_mm256_and_si256(_mm256_cmpeq_epi8(x, trueVal), one),
+                                  _mm256_and_si256(_mm256_cmpeq_epi8(x, nullVal), null));
+    _mm256_storeu_si256((__m256i *)(output + i), res);
+  }
+#endif
+
+  for (; i < nelements; ++i) {
+    uint8_t ele = (input[i >> 2] >> ((i & 0x03) << 1)) & INT8MASK(2);
+    output[i] = (ele == 1) ? 1 : ((ele == 2) ? TSDB_DATA_BOOL_NULL : 0);
+  }
+
+  return nelements;
 }
@@ -34,6 +34,8 @@ enum {
   TAOS_LRU_IN_HIGH_PRI_POOL = (1 << 2),  // Whether this entry is in high-pri pool.
 
   TAOS_LRU_HAS_HIT = (1 << 3),  // Whether this entry has had any lookups (hits).
+
+  TAOS_LRU_IN_WINDOW = (1 << 4),  // Whether this entry is in the admission window of tinylfu.
 };
 
 struct SLRUEntry {
@@ -55,6 +57,7 @@ struct SLRUEntry {
 #define TAOS_LRU_ENTRY_IN_HIGH_POOL(h) ((h)->flags & TAOS_LRU_IN_HIGH_PRI_POOL)
 #define TAOS_LRU_ENTRY_IS_HIGH_PRI(h)  ((h)->flags & TAOS_LRU_IS_HIGH_PRI)
 #define TAOS_LRU_ENTRY_HAS_HIT(h)      ((h)->flags & TAOS_LRU_HAS_HIT)
+#define TAOS_LRU_ENTRY_IN_WINDOW(h)    ((h)->flags & TAOS_LRU_IN_WINDOW)
 
 #define TAOS_LRU_ENTRY_SET_IN_CACHE(h, inCache) \
   do {                                          \
@@ -241,6 +244,91 @@ static SLRUEntry *taosLRUEntryTableRemove(SLRUEntryTable *table, const void *key
   return result;
 }
 
+/*
+ * The count-min sketch of tinylfu, with saturating 4 bit counters of the lookups of each key. All the counters are
+ * halved after 10 lookups per counter, so that the keys once hot fade out.
+ */
+#define TAOS_LRU_SKETCH_DEPTH       4
+#define TAOS_LRU_SKETCH_MIN_BITS    8
+#define TAOS_LRU_SKETCH_MAX_BITS    20
+#define TAOS_LRU_SKETCH_MAX_COUNTER 15
+#define TAOS_LRU_WINDOW_RATIO       0.01
+
+typedef struct {
+  uint8_t *counters;
+  int      widthBits;
+  uint32_t additions;
+} SLRUSketch;
+
+static const uint32_t lruSketchSeeds[TAOS_LRU_SKETCH_DEPTH] = {0x9E3779B1, 0x85EBCA77, 0xC2B2AE3D, 0x27D4EB2F};
+
+#define TAOS_LRU_SKETCH_INDEX(sketch, hash, i) \
+  (((i) << (sketch)->widthBits) + (((hash)*lruSketchSeeds[i]) >> (32 - (sketch)->widthBits)))
+
+static int taosLRUSketchInit(SLRUSketch *sketch, int widthBits) {
+  uint8_t *counters = taosMemoryCalloc(TAOS_LRU_SKETCH_DEPTH << widthBits, sizeof(uint8_t));
+  if (!counters) {
+    return -1;
+  }
+
+  taosMemoryFree(sketch->counters);
+  sketch->counters = counters;
+  sketch->widthBits = widthBits;
+  sketch->additions = 0;
+
+  return 0;
+}
+
+static void taosLRUSketchCleanup(SLRUSketch *sketch) {
+  taosMemoryFreeClear(sketch->counters);
+}
+
+// the width follows the number of entries, and the counts are dropped when it grows
+static void taosLRUSketchEnsureWidth(SLRUSketch *sketch, uint32_t elems) {
+  int widthBits = sketch->widthBits;
+  while ((elems >> widthBits) > 0 && widthBits < TAOS_LRU_SKETCH_MAX_BITS) {
+    ++widthBits;
+  }
+
+  if (widthBits != sketch->widthBits) {
+    (void)taosLRUSketchInit(sketch, widthBits);
+  }
+}
+
+static void taosLRUSketchIncrement(SLRUSketch *sketch, uint32_t hash) {
+  if (!sketch->counters) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < TAOS_LRU_SKETCH_DEPTH; ++i) {
+    uint8_t *counter = &sketch->counters[TAOS_LRU_SKETCH_INDEX(sketch, hash, i)];
+    if (*counter < TAOS_LRU_SKETCH_MAX_COUNTER) {
+      ++(*counter);
+    }
+  }
+
+  if (++sketch->additions >= (10u << sketch->widthBits)) {
+    int32_t size = TAOS_LRU_SKETCH_DEPTH << sketch->widthBits;
+    for (int32_t i = 0; i < size; ++i) {
+      sketch->counters[i] >>= 1;
+    }
+    sketch->additions >>= 1;
+  }
+}
+
+static uint8_t taosLRUSketchEstimate(SLRUSketch *sketch, uint32_t hash) {
+  if (!sketch->counters) {
+    return 0;
+  }
+
+  uint8_t freq = TAOS_LRU_SKETCH_MAX_COUNTER;
+  for (uint32_t i = 0; i < TAOS_LRU_SKETCH_DEPTH; ++i) {
+    freq = TMIN(freq, sketch->counters[TAOS_LRU_SKETCH_INDEX(sketch, hash, i)]);
+  }
+
+  return freq;
+}
+
 struct SLRUCacheShard {
   size_t         capacity;
   size_t         highPriPoolUsage;
@@ -252,6 +340,15 @@ struct SLRUCacheShard {
   SLRUEntryTable table;
   size_t         usage;     // Memory size for entries residing in the cache.
   size_t         lruUsage;  // Memory size for entries residing only in the LRU list.
+  LRUPolicy      policy;
+  SLRUEntry      window;  // tinylfu: the LRU list of the new entries, not yet admitted into lru.
+  size_t         windowUsage;
+  size_t         windowCapacity;
+  SLRUSketch     sketch;
+  int64_t        hits;
+  int64_t        misses;
+  int64_t        evictions;
+  int64_t        rejections;
   TdThreadMutex  mutex;
 };
 
@@ -271,7 +368,15 @@ static void taosLRUCacheShardMaintainPoolSize(SLRUCacheShard *shard) {
 static void taosLRUCacheShardLRUInsert(SLRUCacheShard *shard, SLRUEntry *e) {
   ASSERT(e->next == NULL && e->prev == NULL);
 
-  if (shard->highPriPoolRatio > 0 && (TAOS_LRU_ENTRY_IS_HIGH_PRI(e) || TAOS_LRU_ENTRY_HAS_HIT(e))) {
+  if (TAOS_LRU_ENTRY_IN_WINDOW(e)) {
+    e->next = &shard->window;
+    e->prev = shard->window.prev;
+
+    e->prev->next = e;
+    e->next->prev = e;
+
+    shard->windowUsage += e->totalCharge;
+  } else if (shard->highPriPoolRatio > 0 && (TAOS_LRU_ENTRY_IS_HIGH_PRI(e) || TAOS_LRU_ENTRY_HAS_HIT(e))) {
     e->next = &shard->lru;
     e->prev = shard->lru.prev;
 
@@ -311,21 +416,72 @@ static void taosLRUCacheShardLRURemove(SLRUCacheShard *shard, SLRUEntry *e) {
     ASSERT(shard->highPriPoolUsage >= e->totalCharge);
     shard->highPriPoolUsage -= e->totalCharge;
   }
+  if (TAOS_LRU_ENTRY_IN_WINDOW(e)) {
+    ASSERT(shard->windowUsage >= e->totalCharge);
+    shard->windowUsage -= e->totalCharge;
+  }
 }
 
-static void taosLRUCacheShardEvictLRU(SLRUCacheShard *shard, size_t charge, SArray *deleted) {
-  while (shard->usage + charge > shard->capacity && shard->lru.next != &shard->lru) {
-    SLRUEntry *old = shard->lru.next;
-    ASSERT(TAOS_LRU_ENTRY_IN_CACHE(old) && !TAOS_LRU_ENTRY_HAS_REFS(old));
+static void taosLRUCacheShardRemoveUnref(SLRUCacheShard *shard, SLRUEntry *old, SArray *deleted) {
+  ASSERT(TAOS_LRU_ENTRY_IN_CACHE(old) && !TAOS_LRU_ENTRY_HAS_REFS(old));
 
-    taosLRUCacheShardLRURemove(shard, old);
-    taosLRUEntryTableRemove(&shard->table, old->keyData, old->keyLength, old->hash);
+  taosLRUCacheShardLRURemove(shard, old);
+  taosLRUEntryTableRemove(&shard->table, old->keyData, old->keyLength, old->hash);
 
-    TAOS_LRU_ENTRY_SET_IN_CACHE(old, false);
-    ASSERT(shard->usage >= old->totalCharge);
-    shard->usage -= old->totalCharge;
+  TAOS_LRU_ENTRY_SET_IN_CACHE(old, false);
+  ASSERT(shard->usage >= old->totalCharge);
+  shard->usage -= old->totalCharge;
+
+  taosArrayPush(deleted, &old);
+}
 
-    taosArrayPush(deleted, &old);
+// moves the oldest entry of the window into the probation part of lru
+static void taosLRUCacheShardAdmit(SLRUCacheShard *shard, SLRUEntry *e) {
+  taosLRUCacheShardLRURemove(shard, e);
+  e->flags &= ~(TAOS_LRU_IN_WINDOW | TAOS_LRU_HAS_HIT);
+  taosLRUCacheShardLRUInsert(shard, e);
+}
+
+static void taosLRUCacheShardEvictTinyLFU(SLRUCacheShard *shard, size_t charge, SArray *deleted) {
+  while (shard->windowUsage > shard->windowCapacity && shard->usage + charge <= shard->capacity) {
+    taosLRUCacheShardAdmit(shard, shard->window.next);
+  }
+
+  while (shard->usage + charge > shard->capacity) {
+    SLRUEntry *candidate = (shard->window.next != &shard->window) ? shard->window.next : NULL;
+    SLRUEntry *victim = (shard->lru.next != &shard->lru) ? shard->lru.next : NULL;
+    if (candidate == NULL && victim == NULL) {
+      break;
+    }
+
+    if (candidate != NULL && (victim == NULL || shard->windowUsage > shard->windowCapacity)) {
+      if (victim != NULL && taosLRUSketchEstimate(&shard->sketch, candidate->hash) >
+                                taosLRUSketchEstimate(&shard->sketch, victim->hash)) {
+        taosLRUCacheShardRemoveUnref(shard, victim, deleted);
+        taosLRUCacheShardAdmit(shard, candidate);
+      } else {
+        taosLRUCacheShardRemoveUnref(shard, candidate, deleted);
+        if (victim != NULL) {
+          ++shard->rejections;
+        }
+      }
+    } else {
+      taosLRUCacheShardRemoveUnref(shard, victim, deleted);
+    }
+
+    ++shard->evictions;
+  }
+}
+
+static void taosLRUCacheShardEvictLRU(SLRUCacheShard *shard, size_t charge, SArray *deleted) {
+  if (shard->policy == TAOS_LRU_POLICY_TINYLFU) {
+    taosLRUCacheShardEvictTinyLFU(shard, charge, deleted);
+    return;
+  }
+
+  while (shard->usage + charge > shard->capacity && shard->lru.next != &shard->lru) {
+    taosLRUCacheShardRemoveUnref(shard, shard->lru.next, deleted);
+    ++shard->evictions;
   }
 }
 
@@ -336,6 +492,7 @@ static void taosLRUCacheShardSetCapacity(SLRUCacheShard *shard, size_t capacity)
 
   shard->capacity = capacity;
   shard->highPriPoolCapacity = capacity * shard->highPriPoolRatio;
+  shard->windowCapacity = capacity * TAOS_LRU_WINDOW_RATIO;
   taosLRUCacheShardEvictLRU(shard, 0, lastReferenceList);
 
   taosThreadMutexUnlock(&shard->mutex);
@@ -348,11 +505,16 @@ static void taosLRUCacheShardSetCapacity(SLRUCacheShard *shard, size_t capacity)
 }
 
 static int taosLRUCacheShardInit(SLRUCacheShard *shard, size_t capacity, bool strict, double highPriPoolRatio,
-                                 int maxUpperHashBits) {
+                                 int maxUpperHashBits, LRUPolicy policy) {
   if (taosLRUEntryTableInit(&shard->table, maxUpperHashBits) < 0) {
     return -1;
   }
 
+  // without the sketch, tinylfu admits no new entry while lru has any
+  if (policy == TAOS_LRU_POLICY_TINYLFU) {
+    (void)taosLRUSketchInit(&shard->sketch, TAOS_LRU_SKETCH_MIN_BITS);
+  }
+
   taosThreadMutexInit(&shard->mutex, NULL);
 
   taosThreadMutexLock(&shard->mutex);
@@ -368,6 +530,12 @@ static int taosLRUCacheShardInit(SLRUCacheShard *shard, size_t capacity, bool st
   shard->lru.next = &shard->lru;
   shard->lru.prev = &shard->lru;
   shard->lruLowPri = &shard->lru;
+
+  shard->policy = policy;
+  shard->window.next = &shard->window;
+  shard->window.prev = &shard->window;
+  shard->windowUsage = 0;
+  shard->windowCapacity = 0;
   taosThreadMutexUnlock(&shard->mutex);
 
   taosLRUCacheShardSetCapacity(shard, capacity);
@@ -379,6 +547,7 @@ static void taosLRUCacheShardCleanup(SLRUCacheShard *shard) {
   taosThreadMutexDestroy(&shard->mutex);
 
   taosLRUEntryTableCleanup(&shard->table);
+  taosLRUSketchCleanup(&shard->sketch);
 }
 
 static LRUStatus taosLRUCacheShardInsertEntry(SLRUCacheShard *shard, SLRUEntry *e, LRUHandle **handle,
@@ -406,6 +575,9 @@ static LRUStatus taosLRUCacheShardInsertEntry(SLRUCacheShard *shard, SLRUEntry *
   } else {
     SLRUEntry *old = taosLRUEntryTableInsert(&shard->table, e);
     shard->usage += e->totalCharge;
+    if (shard->policy == TAOS_LRU_POLICY_TINYLFU) {
+      taosLRUSketchEnsureWidth(&shard->sketch, shard->table.elems);
+    }
     if (old != NULL) {
       status = TAOS_LRU_STATUS_OK_OVERWRITTEN;
 
@@ -459,6 +631,9 @@ static LRUStatus taosLRUCacheShardInsert(SLRUCacheShard *shard, const void *key,
   e->refs = 0;
   e->next = e->prev = NULL;
   TAOS_LRU_ENTRY_SET_IN_CACHE(e, true);
+  if (shard->policy == TAOS_LRU_POLICY_TINYLFU) {
+    e->flags |= TAOS_LRU_IN_WINDOW;
+  }
 
   TAOS_LRU_ENTRY_SET_PRIORITY(e, priority);
   memcpy(e->keyData, key, keyLen);
@@ -480,6 +655,12 @@ static LRUHandle *taosLRUCacheShardLookup(SLRUCacheShard *shard, const void *key
     }
     TAOS_LRU_ENTRY_REF(e);
     TAOS_LRU_ENTRY_SET_HIT(e);
+    ++shard->hits;
+  } else {
+    ++shard->misses;
+  }
+  if (shard->policy == TAOS_LRU_POLICY_TINYLFU) {
+    taosLRUSketchIncrement(&shard->sketch, hash);
   }
 
   taosThreadMutexUnlock(&shard->mutex);
@@ -529,15 +710,10 @@ static void taosLRUCacheShardEraseUnrefEntries(SLRUCacheShard *shard) {
   taosThreadMutexLock(&shard->mutex);
 
   while (shard->lru.next != &shard->lru) {
-    SLRUEntry *old = shard->lru.next;
-    ASSERT(TAOS_LRU_ENTRY_IN_CACHE(old) && !TAOS_LRU_ENTRY_HAS_REFS(old));
-    taosLRUCacheShardLRURemove(shard, old);
-    taosLRUEntryTableRemove(&shard->table, old->keyData, old->keyLength, old->hash);
-    TAOS_LRU_ENTRY_SET_IN_CACHE(old, false);
-    ASSERT(shard->usage >= old->totalCharge);
-    shard->usage -= old->totalCharge;
-
-    taosArrayPush(lastReferenceList, &old);
+    taosLRUCacheShardRemoveUnref(shard, shard->lru.next, lastReferenceList);
+  }
+  while (shard->window.next != &shard->window) {
+    taosLRUCacheShardRemoveUnref(shard, shard->window.next, lastReferenceList);
   }
 
   taosThreadMutexUnlock(&shard->mutex);
@@ -634,6 +810,18 @@ static size_t taosLRUCacheShardGetPinnedUsage(SLRUCacheShard *shard) {
   return usage;
 }
 
+static void taosLRUCacheShardGetStats(SLRUCacheShard *shard, SLRUCacheStats *stats) {
+  taosThreadMutexLock(&shard->mutex);
+
+  stats->hits += shard->hits;
+  stats->misses += shard->misses;
+  stats->evictions += shard->evictions;
+  stats->rejections += shard->rejections;
+  stats->windowUsage += shard->windowUsage;
+
+  taosThreadMutexUnlock(&shard->mutex);
+}
+
 static void taosLRUCacheShardSetStrictCapacity(SLRUCacheShard *shard, bool strict) {
   taosThreadMutexLock(&shard->mutex);
 
@@ -670,6 +858,10 @@ static int getDefaultCacheShardBits(size_t capacity) {
 }
 
 SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio) {
+  return taosLRUCacheInitWithPolicy(capacity, numShardBits, highPriPoolRatio, TAOS_LRU_POLICY_LRU);
+}
+
+SLRUCache *taosLRUCacheInitWithPolicy(size_t capacity, int numShardBits, double highPriPoolRatio, LRUPolicy policy) {
   if (numShardBits >= 20) {
     terrno = TSDB_CODE_INVALID_PARA;
     return NULL;
@@ -699,7 +891,7 @@ SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoo
   bool   strictCapacity = 1;
   size_t perShard = (capacity + (numShards - 1)) / numShards;
   for (int i = 0; i < numShards; ++i) {
-    taosLRUCacheShardInit(&cache->shards[i], perShard, strictCapacity, highPriPoolRatio, 32 - numShardBits);
+    taosLRUCacheShardInit(&cache->shards[i], perShard, strictCapacity, highPriPoolRatio, 32 - numShardBits, policy);
   }
 
   cache->numShards = numShards;
@@ -815,6 +1007,14 @@ int32_t taosLRUCacheGetElems(SLRUCache *cache) {
   return elems;
 }
 
+void taosLRUCacheGetStats(SLRUCache *cache, SLRUCacheStats *stats) {
+  memset(stats, 0, sizeof(SLRUCacheStats));
+
+  for (int i = 0; i < cache->numShards; ++i) {
+    taosLRUCacheShardGetStats(&cache->shards[i], stats);
+  }
+}
+
 size_t taosLRUCacheGetPinnedUsage(SLRUCache *cache) {
   size_t usage = 0;
 
@@ -24,6 +24,7 @@ int64_t tsRpcQueueMemoryUsed = 0;
 struct STaosQueue {
   STaosQnode   *head;
   STaosQnode   *tail;
+  STaosQnode   *stack;    // for lock free queue, items pushed by the writers, the latest one first
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
@@ -35,6 +36,7 @@ struct STaosQueue {
   int64_t       threadId;
   int64_t       memLimit;
   int64_t       itemLimit;
+  int8_t        mode;
 };
 
 struct STaosQset {
@@ -44,6 +46,10 @@ struct STaosQset {
   tsem_t        sem;
   int32_t       numOfQueues;
   int32_t       numOfItems;
+  int8_t        mode;
+  int32_t       waiters;  // for lock free qset, number of readers going to park on the futex
+  int32_t       seq;      // for lock free qset, the futex word, bumped to wake up the parked reader
+  int32_t       resumes;  // for lock free qset, number of taosQsetThreadResume not consumed yet
 };
 
 struct STaosQall {
@@ -55,10 +61,225 @@ struct STaosQall {
   int64_t     unAccessMemOfItems;
 };
 
+/*
+ * The lock free queue: writers push the items onto queue->stack with a CAS, and the only reader swaps the whole
+ * stack out at a time, reverses it and appends it to queue->head/tail, which are then owned by the reader. Since
+ * the stack is never popped one by one, there is no ABA problem. The counters are updated with atomic operations,
+ * and the limits are checked with a CAS loop, so memOfItems and numOfItems never exceed them even transiently.
+ *
+ * The reader of a lock free qset parks on qset->seq when all the queues are empty. It increases qset->waiters and
+ * scans the queues once more before it sleeps, and the writers bump qset->seq only if someone is waiting, so that
+ * no futex call is made as long as the reader is busy.
+ */
+static bool taosQueueReserve64(int64_t *pVal, int64_t delta, int64_t limit) {
+  if (limit <= 0) {
+    atomic_add_fetch_64(pVal, delta);
+    return true;
+  }
+
+  int64_t val = atomic_load_64(pVal);
+  while (val + delta <= limit) {
+    int64_t old = atomic_val_compare_exchange_64(pVal, val, val + delta);
+    if (old == val) return true;
+    val = old;
+  }
+  return false;
+}
+
+static bool taosQueueReserve32(int32_t *pVal, int32_t delta, int64_t limit) {
+  if (limit <= 0) {
+    atomic_add_fetch_32(pVal, delta);
+    return true;
+  }
+
+  int32_t val = atomic_load_32(pVal);
+  while ((int64_t)val + delta <= limit) {
+    int32_t old = atomic_val_compare_exchange_32(pVal, val, val + delta);
+    if (old == val) return true;
+    val = old;
+  }
+  return false;
+}
+
+static void taosQsetWakeUp(STaosQset *qset) {
+  if (atomic_load_32(&qset->waiters) > 0) {
+    atomic_add_fetch_32(&qset->seq, 1);
+    taosFutexWake(&qset->seq, 1);
+  }
+}
+
+static int32_t taosWriteQitemLockFree(STaosQueue *queue, STaosQnode *pNode) {
+  int32_t code = 0;
+  int64_t size = pNode->size + pNode->dataSize;
+
+  if (!taosQueueReserve64(&queue->memOfItems, size, queue->memLimit)) {
+    code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
+    uError("item:%p failed to put into queue:%p, queue mem limit: %" PRId64 ", reason: %s", pNode->item, queue,
+           queue->memLimit, tstrerror(code));
+    return code;
+  }
+
+  if (!taosQueueReserve32(&queue->numOfItems, 1, queue->itemLimit)) {
+    atomic_sub_fetch_64(&queue->memOfItems, size);
+    code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
+    uError("item:%p failed to put into queue:%p, queue size limit: %" PRId64 ", reason: %s", pNode->item, queue,
+           queue->itemLimit, tstrerror(code));
+    return code;
+  }
+
+  while (1) {
+    STaosQnode *top = atomic_load_ptr(&queue->stack);
+    pNode->next = top;
+    if (atomic_val_compare_exchange_ptr(&queue->stack, top, pNode) == top) break;
+  }
+
+  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pNode->item, queue, queue->numOfItems,
+         queue->memOfItems);
+
+  STaosQset *qset = atomic_load_ptr(&queue->qset);
+  if (qset) {
+    atomic_add_fetch_32(&qset->numOfItems, 1);
+    taosQsetWakeUp(qset);
+  }
+  return code;
+}
+
+// move the items pushed by the writers to the list owned by the reader, in the order they were written
+static void taosQueueCollect(STaosQueue *queue) {
+  STaosQnode *pNode = atomic_exchange_ptr(&queue->stack, NULL);
+  if (pNode == NULL) return;
+
+  STaosQnode *head = NULL;
+  STaosQnode *tail = pNode;
+  while (pNode) {
+    STaosQnode *next = pNode->next;
+    pNode->next = head;
+    head = pNode;
+    pNode = next;
+  }
+
+  if (queue->tail) {
+    queue->tail->next = head;
+  } else {
+    queue->head = head;
+  }
+  queue->tail = tail;
+}
+
+static bool taosQueueHasItems(STaosQueue *queue) {
+  return queue->head != NULL || atomic_load_ptr(&queue->stack) != NULL;
+}
+
+// numOfItems is left to the caller, since the workers decrease it with taosUpdateItemSize after the items are handled
+static STaosQnode *taosQueuePop(STaosQueue *queue) {
+  if (queue->head == NULL) taosQueueCollect(queue);
+
+  STaosQnode *pNode = queue->head;
+  if (pNode == NULL) return NULL;
+
+  queue->head = pNode->next;
+  if (queue->head == NULL) queue->tail = NULL;
+  pNode->next = NULL;
+
+  atomic_sub_fetch_64(&queue->memOfItems, pNode->size + pNode->dataSize);
+  STaosQset *qset = atomic_load_ptr(&queue->qset);
+  if (qset) atomic_sub_fetch_32(&qset->numOfItems, 1);
+  return pNode;
+}
+
+static int32_t taosQueueTakeAll(STaosQueue *queue, STaosQall *qall) {
+  taosQueueCollect(queue);
+
+  int32_t numOfItems = 0;
+  int64_t memOfItems = 0;
+  for (STaosQnode *pNode = queue->head; pNode != NULL; pNode = pNode->next) {
+    numOfItems++;
+    memOfItems += pNode->size + pNode->dataSize;
+  }
+
+  qall->current = queue->head;
+  qall->start = queue->head;
+  qall->numOfItems = numOfItems;
+  qall->memOfItems = memOfItems;
+  queue->head = NULL;
+  queue->tail = NULL;
+
+  if (numOfItems > 0) {
+    atomic_sub_fetch_64(&queue->memOfItems, memOfItems);
+    STaosQset *qset = atomic_load_ptr(&queue->qset);
+    if (qset) atomic_sub_fetch_32(&qset->numOfItems, numOfItems);
+    uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
+           queue->memOfItems);
+  }
+  return numOfItems;
+}
+
+// read one item into ppItem or all the items of a queue into qall, from the queues in turn
+static int32_t taosScanQsetLockFree(STaosQset *qset, void **ppItem, STaosQall *qall, SQueueInfo *qinfo) {
+  int32_t code = 0;
+
+  taosThreadMutexLock(&qset->mutex);
+  for (int32_t i = 0; i < qset->numOfQueues; ++i) {
+    if (qset->current == NULL) qset->current = qset->head;
+    STaosQueue *queue = qset->current;
+    if (queue) qset->current = queue->next;
+    if (queue == NULL) break;
+    if (!taosQueueHasItems(queue)) continue;
+
+    if (qall != NULL) {
+      code = taosQueueTakeAll(queue, qall);
+      if (code == 0) continue;
+      qinfo->fp = queue->itemsFp;
+      qinfo->timestamp = qall->start->timestamp;
+    } else {
+      STaosQnode *pNode = taosQueuePop(queue);
+      if (pNode == NULL) continue;
+      *ppItem = pNode->item;
+      qinfo->fp = queue->itemFp;
+      qinfo->timestamp = pNode->timestamp;
+      code = 1;
+    }
+
+    qinfo->ahandle = queue->ahandle;
+    qinfo->queue = queue;
+    break;
+  }
+  taosThreadMutexUnlock(&qset->mutex);
+
+  return code;
+}
+
+static int32_t taosReadFromQsetLockFree(STaosQset *qset, void **ppItem, STaosQall *qall, SQueueInfo *qinfo) {
+  while (1) {
+    int32_t code = taosScanQsetLockFree(qset, ppItem, qall, qinfo);
+    if (code != 0) return code;
+
+    // the resume is taken only when there is nothing to read, so the worker exits after the queues are drained
+    if (atomic_load_32(&qset->resumes) > 0) {
+      atomic_sub_fetch_32(&qset->resumes, 1);
+      return 0;
+    }
+
+    // the writers bump seq after they push the item and see the waiter, so an item written after the scan below
+    // either is found by it, or changes seq before the futex wait
+    atomic_add_fetch_32(&qset->waiters, 1);
+    int32_t seq = atomic_load_32(&qset->seq);
+    code = taosScanQsetLockFree(qset, ppItem, qall, qinfo);
+    if (code == 0 && atomic_load_32(&qset->resumes) == 0) {
+      taosFutexWait(&qset->seq, seq);
+    }
+    atomic_sub_fetch_32(&qset->waiters, 1);
+
+    if (code != 0) return code;
+  }
+}
+
 void taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t cap) { queue->memLimit = cap; }
 void taosSetQueueCapacity(STaosQueue *queue, int64_t size) { queue->itemLimit = size; }
 
-STaosQueue *taosOpenQueue() {
+STaosQueue *taosOpenQueue() { return taosOpenQueueEx(QUEUE_MODE_MUTEX); }
+
+STaosQueue *taosOpenQueueEx(EQueueMode mode) {
   STaosQueue *queue = taosMemoryCalloc(1, sizeof(STaosQueue));
   if (queue == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -66,11 +287,13 @@ STaosQueue *taosOpenQueue() {
   }
 
   if (taosThreadMutexInit(&queue->mutex, NULL) != 0) {
+    taosMemoryFree(queue);
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
   }
 
-  uDebug("queue:%p is opened", queue);
+  queue->mode = mode;
+  uDebug("queue:%p is opened, mode:%d", queue, mode);
   return queue;
 }
 
@@ -86,6 +309,7 @@ void taosCloseQueue(STaosQueue *queue) {
   STaosQset  *qset;
 
   taosThreadMutexLock(&queue->mutex);
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) taosQueueCollect(queue);
   STaosQnode *pNode = queue->head;
   queue->head = NULL;
   qset = queue->qset;
@@ -95,10 +319,11 @@ void taosCloseQueue(STaosQueue *queue) {
     taosRemoveFromQset(qset, queue);
   }
 
+  // free the items left through taosFreeQitem, so that tsRpcQueueMemoryUsed is released as well
   while (pNode) {
     pTemp = pNode;
     pNode = pNode->next;
-    taosMemoryFree(pTemp);
+    taosFreeQitem(pTemp->item);
   }
 
   taosThreadMutexDestroy(&queue->mutex);
@@ -110,6 +335,8 @@ void taosCloseQueue(STaosQueue *queue) {
 bool taosQueueEmpty(STaosQueue *queue) {
   if (queue == NULL) return true;
 
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) return atomic_load_32(&queue->numOfItems) == 0;
+
   bool empty = false;
   taosThreadMutexLock(&queue->mutex);
   if (queue->head == NULL && queue->tail == NULL && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
@@ -122,6 +349,10 @@ bool taosQueueEmpty(STaosQueue *queue) {
 
 void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
   if (queue == NULL) return;
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) {
+    atomic_sub_fetch_32(&queue->numOfItems, items);
+    return;
+  }
 
   taosThreadMutexLock(&queue->mutex);
   queue->numOfItems -= items;
@@ -130,6 +361,7 @@ void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
 
 int32_t taosQueueItemSize(STaosQueue *queue) {
   if (queue == NULL) return 0;
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) return atomic_load_32(&queue->numOfItems);
 
   taosThreadMutexLock(&queue->mutex);
   int32_t numOfItems = queue->numOfItems;
@@ -140,6 +372,8 @@ int32_t taosQueueItemSize(STaosQueue *queue) {
 }
 
 int64_t taosQueueMemorySize(STaosQueue *queue) {
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) return atomic_load_64(&queue->memOfItems);
+
   taosThreadMutexLock(&queue->mutex);
   int64_t memOfItems = queue->memOfItems;
   taosThreadMutexUnlock(&queue->mutex);
@@ -196,6 +430,8 @@ int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   pNode->timestamp = taosGetTimestampUs();
   pNode->next = NULL;
 
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) return taosWriteQitemLockFree(queue, pNode);
+
   taosThreadMutexLock(&queue->mutex);
   if (queue->memLimit > 0 && (queue->memOfItems + pNode->size + pNode->dataSize) > queue->memLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
@@ -235,6 +471,17 @@ int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
   STaosQnode *pNode = NULL;
   int32_t     code = 0;
 
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) {
+    pNode = taosQueuePop(queue);
+    if (pNode == NULL) return 0;
+
+    *ppItem = pNode->item;
+    atomic_sub_fetch_32(&queue->numOfItems, 1);
+    uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems,
+           queue->memOfItems);
+    return 1;
+  }
+
   taosThreadMutexLock(&queue->mutex);
 
   if (queue->head) {
@@ -269,6 +516,15 @@ int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
   int32_t numOfItems = 0;
   bool    empty;
 
+  if (queue->mode == QUEUE_MODE_LOCK_FREE) {
+    memset(qall, 0, sizeof(STaosQall));
+    numOfItems = taosQueueTakeAll(queue, qall);
+    qall->unAccessedNumOfItems = qall->numOfItems;
+    qall->unAccessMemOfItems = qall->memOfItems;
+    atomic_sub_fetch_32(&queue->numOfItems, numOfItems);
+    return numOfItems;
+  }
+
   taosThreadMutexLock(&queue->mutex);
 
   empty = queue->head == NULL;
@@ -326,7 +582,9 @@ int32_t taosGetQitem(STaosQall *qall, void **ppItem) {
   return num;
 }
 
-STaosQset *taosOpenQset() {
+STaosQset *taosOpenQset() { return taosOpenQsetEx(QUEUE_MODE_MUTEX); }
+
+STaosQset *taosOpenQsetEx(EQueueMode mode) {
   STaosQset *qset = taosMemoryCalloc(sizeof(STaosQset), 1);
   if (qset == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -335,8 +593,9 @@ STaosQset *taosOpenQset() {
 
   taosThreadMutexInit(&qset->mutex, NULL);
   tsem_init(&qset->sem, 0, 0);
+  qset->mode = mode;
 
-  uDebug("qset:%p is opened", qset);
+  uDebug("qset:%p is opened, mode:%d", qset, mode);
   return qset;
 }
 
@@ -365,11 +624,23 @@ void taosCloseQset(STaosQset *qset) {
 // thread to exit.
 void taosQsetThreadResume(STaosQset *qset) {
   uDebug("qset:%p, it will exit", qset);
+  if (qset->mode == QUEUE_MODE_LOCK_FREE) {
+    atomic_add_fetch_32(&qset->resumes, 1);
+    atomic_add_fetch_32(&qset->seq, 1);
+    taosFutexWake(&qset->seq, INT32_MAX);
+    return;
+  }
+
   tsem_post(&qset->sem);
 }
 
 int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
   if (queue->qset) return -1;
+  if (queue->mode != qset->mode) {
+    uError("queue:%p mode:%d can not be added into qset:%p mode:%d", queue, queue->mode, qset, qset->mode);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
 
   taosThreadMutexLock(&qset->mutex);
 
@@ -379,8 +650,8 @@ int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
   qset->numOfQueues++;
 
   taosThreadMutexLock(&queue->mutex);
-  atomic_add_fetch_32(&qset->numOfItems, queue->numOfItems);
-  queue->qset = qset;
+  atomic_add_fetch_32(&qset->numOfItems, atomic_load_32(&queue->numOfItems));
+  atomic_store_ptr(&queue->qset, qset);
   taosThreadMutexUnlock(&queue->mutex);
 
   taosThreadMutexUnlock(&qset->mutex);
@@ -417,8 +688,8 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
       qset->numOfQueues--;
 
       taosThreadMutexLock(&queue->mutex);
-      atomic_sub_fetch_32(&qset->numOfItems, queue->numOfItems);
-      queue->qset = NULL;
+      atomic_sub_fetch_32(&qset->numOfItems, atomic_load_32(&queue->numOfItems));
+      atomic_store_ptr(&queue->qset, NULL);
       queue->next = NULL;
       taosThreadMutexUnlock(&queue->mutex);
     }
@@ -433,6 +704,8 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
   STaosQnode *pNode = NULL;
   int32_t     code = 0;
 
+  if (qset->mode == QUEUE_MODE_LOCK_FREE) return taosReadFromQsetLockFree(qset, ppItem, NULL, qinfo);
+
   tsem_wait(&qset->sem);
 
   taosThreadMutexLock(&qset->mutex);
@@ -477,6 +750,8 @@ int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *
   STaosQueue *queue;
   int32_t     code = 0;
 
+  if (qset->mode == QUEUE_MODE_LOCK_FREE) return taosReadFromQsetLockFree(qset, NULL, qall, qinfo);
+
   tsem_wait(&qset->sem);
   taosThreadMutexLock(&qset->mutex);
 
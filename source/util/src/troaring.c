@@ -0,0 +1,779 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "troaring.h"
+#include "taoserror.h"
+#include "taos.h"
+#include "thash.h"
+#include "tsimplehash.h"
+
+#define ROARING_KEY(_v)         ((_v) >> 16)
+#define ROARING_LOW(_v)         ((uint16_t)((_v)&0xFFFF))
+#define ROARING_IS_BITMAP(_c)   ((_c)->cap == 0)
+#define ROARING_BIT_GET(_w, _v) (((_w)[(_v) >> 6] >> ((_v)&63)) & 1)
+#define ROARING_BITMAP_SIZE     (ROARING_BITMAP_WORDS * sizeof(uint64_t))
+#define ROARING_MIN_ARRAY_CAP   4
+#define ROARING_GALLOP_RATIO    32
+
+static FORCE_INLINE int32_t roaringPopcount(uint64_t w) {
+#ifdef WINDOWS
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((w * 0x0101010101010101ULL) >> 56);
+#else
+  return __builtin_popcountll(w);
+#endif
+}
+
+// the first position in [s, e) whose value is not less than v
+static int32_t roaringArrayLowerBound(const uint16_t *p, int32_t s, int32_t e, uint16_t v) {
+  while (s < e) {
+    int32_t m = s + ((e - s) >> 1);
+    if (p[m] < v) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static int32_t roaringBitmapExtract(const uint64_t *pWords, uint16_t *pOut) {
+  int32_t n = 0;
+  for (int32_t i = 0; i < ROARING_BITMAP_WORDS; ++i) {
+    uint64_t w = pWords[i];
+    while (w != 0) {
+      pOut[n++] = (uint16_t)((i << 6) + BUILDIN_CTZL(w));
+      w &= w - 1;
+    }
+  }
+  return n;
+}
+
+static int32_t roaringContainerInit(SRoaringContainer *c, uint64_t key) {
+  c->pData = taosMemoryMalloc(ROARING_MIN_ARRAY_CAP * sizeof(uint16_t));
+  if (c->pData == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  c->key = key;
+  c->num = 0;
+  c->cap = ROARING_MIN_ARRAY_CAP;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t roaringContainerCopy(SRoaringContainer *pDst, const SRoaringContainer *pSrc) {
+  size_t size = ROARING_IS_BITMAP(pSrc) ? ROARING_BITMAP_SIZE : pSrc->cap * sizeof(uint16_t);
+  pDst->pData = taosMemoryMalloc(size);
+  if (pDst->pData == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memcpy(pDst->pData, pSrc->pData, ROARING_IS_BITMAP(pSrc) ? size : pSrc->num * sizeof(uint16_t));
+  pDst->key = pSrc->key;
+  pDst->num = pSrc->num;
+  pDst->cap = pSrc->cap;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t roaringContainerToBitmap(SRoaringContainer *c) {
+  uint64_t *pWords = taosMemoryCalloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+  if (pWords == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  const uint16_t *p = c->pData;
+  for (int32_t i = 0; i < c->num; ++i) {
+    pWords[p[i] >> 6] |= 1ULL << (p[i] & 63);
+  }
+
+  taosMemoryFree(c->pData);
+  c->pData = pWords;
+  c->cap = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
+// a bitmap container that has become small enough is converted to an array one
+static int32_t roaringContainerShrink(SRoaringContainer *c) {
+  if (!ROARING_IS_BITMAP(c) || c->num > ROARING_ARRAY_MAX_SIZE) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t   cap = TMAX(c->num, ROARING_MIN_ARRAY_CAP);
+  uint16_t *p = taosMemoryMalloc(cap * sizeof(uint16_t));
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  (void)roaringBitmapExtract(c->pData, p);
+  taosMemoryFree(c->pData);
+  c->pData = p;
+  c->cap = cap;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t roaringContainerAdd(SRoaringContainer *c, uint16_t v) {
+  if (ROARING_IS_BITMAP(c)) {
+    uint64_t *pWords = c->pData;
+    if (!ROARING_BIT_GET(pWords, v)) {
+      pWords[v >> 6] |= 1ULL << (v & 63);
+      c->num += 1;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  uint16_t *p = c->pData;
+  int32_t   pos = c->num;
+  if (c->num > 0 && p[c->num - 1] >= v) {  // not appended in order
+    pos = roaringArrayLowerBound(p, 0, c->num, v);
+    if (p[pos] == v) {
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  if (c->num == ROARING_ARRAY_MAX_SIZE) {
+    int32_t code = roaringContainerToBitmap(c);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    return roaringContainerAdd(c, v);
+  }
+
+  if (c->num == c->cap) {
+    int32_t cap = TMIN(c->cap * 2, ROARING_ARRAY_MAX_SIZE);
+    void   *tmp = taosMemoryRealloc(c->pData, cap * sizeof(uint16_t));
+    if (tmp == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    c->pData = tmp;
+    c->cap = cap;
+    p = c->pData;
+  }
+
+  memmove(p + pos + 1, p + pos, (c->num - pos) * sizeof(uint16_t));
+  p[pos] = v;
+  c->num += 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool roaringContainerContains(const SRoaringContainer *c, uint16_t v) {
+  if (ROARING_IS_BITMAP(c)) {
+    return ROARING_BIT_GET((const uint64_t *)c->pData, v);
+  }
+
+  int32_t pos = roaringArrayLowerBound(c->pData, 0, c->num, v);
+  return pos < c->num && ((const uint16_t *)c->pData)[pos] == v;
+}
+
+static int32_t roaringContainerAnd(SRoaringContainer *pDst, const SRoaringContainer *pSrc) {
+  if (ROARING_IS_BITMAP(pDst) && ROARING_IS_BITMAP(pSrc)) {
+    uint64_t       *pw = pDst->pData;
+    const uint64_t *qw = pSrc->pData;
+    int32_t         n = 0;
+    for (int32_t i = 0; i < ROARING_BITMAP_WORDS; ++i) {
+      pw[i] &= qw[i];
+      n += roaringPopcount(pw[i]);
+    }
+    pDst->num = n;
+    return roaringContainerShrink(pDst);
+  }
+
+  if (ROARING_IS_BITMAP(pDst)) {  // the result is the values of the array in pSrc that are in the bitmap
+    int32_t   cap = TMAX(pSrc->num, ROARING_MIN_ARRAY_CAP);
+    uint16_t *p = taosMemoryMalloc(cap * sizeof(uint16_t));
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    const uint64_t *pw = pDst->pData;
+    const uint16_t *q = pSrc->pData;
+    int32_t         n = 0;
+    for (int32_t i = 0; i < pSrc->num; ++i) {
+      p[n] = q[i];
+      n += ROARING_BIT_GET(pw, q[i]);
+    }
+
+    taosMemoryFree(pDst->pData);
+    pDst->pData = p;
+    pDst->num = n;
+    pDst->cap = cap;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the values are kept in place, since the n-th value of the result is never behind the n-th one of pDst
+  uint16_t *p = pDst->pData;
+  int32_t   n = 0;
+  if (ROARING_IS_BITMAP(pSrc)) {
+    const uint64_t *qw = pSrc->pData;
+    for (int32_t i = 0; i < pDst->num; ++i) {
+      p[n] = p[i];
+      n += ROARING_BIT_GET(qw, p[i]);
+    }
+  } else {
+    const uint16_t *q = pSrc->pData;
+    if (pDst->num > pSrc->num * ROARING_GALLOP_RATIO) {
+      for (int32_t i = 0, j = 0; j < pSrc->num; ++j) {
+        i = roaringArrayLowerBound(p, i, pDst->num, q[j]);
+        if (i == pDst->num) break;
+        if (p[i] == q[j]) p[n++] = q[j];
+      }
+    } else {
+      bool gallop = pSrc->num > pDst->num * ROARING_GALLOP_RATIO;
+      for (int32_t i = 0, j = 0; i < pDst->num; ++i) {
+        if (gallop) {
+          j = roaringArrayLowerBound(q, j, pSrc->num, p[i]);
+        } else {
+          while (j < pSrc->num && q[j] < p[i]) ++j;
+        }
+        if (j == pSrc->num) break;
+        if (q[j] == p[i]) p[n++] = p[i];
+      }
+    }
+  }
+
+  pDst->num = n;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t roaringContainerOr(SRoaringContainer *pDst, const SRoaringContainer *pSrc) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  if (!ROARING_IS_BITMAP(pDst) && !ROARING_IS_BITMAP(pSrc)) {
+    int32_t   cap = TMAX(pDst->num + pSrc->num, ROARING_MIN_ARRAY_CAP);
+    uint16_t *r = taosMemoryMalloc(cap * sizeof(uint16_t));
+    if (r == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    const uint16_t *p = pDst->pData;
+    const uint16_t *q = pSrc->pData;
+    int32_t         i = 0, j = 0, n = 0;
+    while (i < pDst->num && j < pSrc->num) {
+      uint16_t v = TMIN(p[i], q[j]);
+      i += (p[i] == v);
+      j += (q[j] == v);
+      r[n++] = v;
+    }
+    while (i < pDst->num) r[n++] = p[i++];
+    while (j < pSrc->num) r[n++] = q[j++];
+
+    taosMemoryFree(pDst->pData);
+    pDst->pData = r;
+    pDst->num = n;
+    pDst->cap = cap;
+    return (n > ROARING_ARRAY_MAX_SIZE) ? roaringContainerToBitmap(pDst) : TSDB_CODE_SUCCESS;
+  }
+
+  if (!ROARING_IS_BITMAP(pDst)) {
+    code = roaringContainerToBitmap(pDst);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  uint64_t *pw = pDst->pData;
+  if (ROARING_IS_BITMAP(pSrc)) {
+    const uint64_t *qw = pSrc->pData;
+    int32_t         n = 0;
+    for (int32_t i = 0; i < ROARING_BITMAP_WORDS; ++i) {
+      pw[i] |= qw[i];
+      n += roaringPopcount(pw[i]);
+    }
+    pDst->num = n;
+  } else {
+    const uint16_t *q = pSrc->pData;
+    for (int32_t i = 0; i < pSrc->num; ++i) {
+      pDst->num += !ROARING_BIT_GET(pw, q[i]);
+      pw[q[i] >> 6] |= 1ULL << (q[i] & 63);
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t roaringContainerAndNot(SRoaringContainer *pDst, const SRoaringContainer *pSrc) {
+  if (ROARING_IS_BITMAP(pDst)) {
+    uint64_t *pw = pDst->pData;
+    if (ROARING_IS_BITMAP(pSrc)) {
+      const uint64_t *qw = pSrc->pData;
+      int32_t         n = 0;
+      for (int32_t i = 0; i < ROARING_BITMAP_WORDS; ++i) {
+        pw[i] &= ~qw[i];
+        n += roaringPopcount(pw[i]);
+      }
+      pDst->num = n;
+    } else {
+      const uint16_t *q = pSrc->pData;
+      for (int32_t i = 0; i < pSrc->num; ++i) {
+        pDst->num -= ROARING_BIT_GET(pw, q[i]);
+        pw[q[i] >> 6] &= ~(1ULL << (q[i] & 63));
+      }
+    }
+    return roaringContainerShrink(pDst);
+  }
+
+  uint16_t *p = pDst->pData;
+  int32_t   n = 0;
+  if (ROARING_IS_BITMAP(pSrc)) {
+    const uint64_t *qw = pSrc->pData;
+    for (int32_t i = 0; i < pDst->num; ++i) {
+      p[n] = p[i];
+      n += !ROARING_BIT_GET(qw, p[i]);
+    }
+  } else {
+    const uint16_t *q = pSrc->pData;
+    bool            gallop = pSrc->num > pDst->num * ROARING_GALLOP_RATIO;
+    for (int32_t i = 0, j = 0; i < pDst->num; ++i) {
+      if (gallop) {
+        j = roaringArrayLowerBound(q, j, pSrc->num, p[i]);
+      } else {
+        while (j < pSrc->num && q[j] < p[i]) ++j;
+      }
+      if (j == pSrc->num || q[j] != p[i]) p[n++] = p[i];
+    }
+  }
+
+  pDst->num = n;
+  return TSDB_CODE_SUCCESS;
+}
+
+// the first container whose key is not less than the given one
+static int32_t roaringLowerBound(const SRoaringBitmap *pBitmap, uint64_t key) {
+  int32_t s = 0, e = pBitmap->size;
+  if (e > 0 && pBitmap->pContainers[e - 1].key < key) {
+    return e;
+  }
+
+  while (s < e) {
+    int32_t m = s + ((e - s) >> 1);
+    if (pBitmap->pContainers[m].key < key) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static int32_t roaringInsertContainer(SRoaringBitmap *pBitmap, int32_t idx, uint64_t key) {
+  if (pBitmap->size == pBitmap->cap) {
+    int32_t cap = TMAX(pBitmap->cap * 2, 4);
+    void   *tmp = taosMemoryRealloc(pBitmap->pContainers, cap * sizeof(SRoaringContainer));
+    if (tmp == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pBitmap->pContainers = tmp;
+    pBitmap->cap = cap;
+  }
+
+  SRoaringContainer c = {0};
+  int32_t           code = roaringContainerInit(&c, key);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  memmove(&pBitmap->pContainers[idx + 1], &pBitmap->pContainers[idx],
+          (pBitmap->size - idx) * sizeof(SRoaringContainer));
+  pBitmap->pContainers[idx] = c;
+  pBitmap->size += 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+SRoaringBitmap *tRoaringCreate() {
+  SRoaringBitmap *pBitmap = taosMemoryCalloc(1, sizeof(SRoaringBitmap));
+  if (pBitmap == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return pBitmap;
+}
+
+void tRoaringClear(SRoaringBitmap *pBitmap) {
+  if (pBitmap == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < pBitmap->size; ++i) {
+    taosMemoryFree(pBitmap->pContainers[i].pData);
+  }
+  pBitmap->size = 0;
+  pBitmap->lastIdx = 0;
+}
+
+void tRoaringDestroy(SRoaringBitmap *pBitmap) {
+  if (pBitmap == NULL) {
+    return;
+  }
+
+  tRoaringClear(pBitmap);
+  taosMemoryFree(pBitmap->pContainers);
+  taosMemoryFree(pBitmap);
+}
+
+int32_t tRoaringAdd(SRoaringBitmap *pBitmap, uint64_t val) {
+  uint64_t key = ROARING_KEY(val);
+  int32_t  idx = pBitmap->lastIdx;
+
+  if (idx >= pBitmap->size || pBitmap->pContainers[idx].key != key) {
+    idx = roaringLowerBound(pBitmap, key);
+    if (idx == pBitmap->size || pBitmap->pContainers[idx].key != key) {
+      int32_t code = roaringInsertContainer(pBitmap, idx, key);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    }
+    pBitmap->lastIdx = idx;
+  }
+
+  return roaringContainerAdd(&pBitmap->pContainers[idx], ROARING_LOW(val));
+}
+
+static int32_t roaringContainerCompare(const void *p1, const void *p2) {
+  uint64_t k1 = ((const SRoaringContainer *)p1)->key;
+  uint64_t k2 = ((const SRoaringContainer *)p2)->key;
+  return (k1 < k2) ? -1 : (k1 > k2);
+}
+
+// the values may be in any order: the containers of the new keys are appended, and are sorted at last
+int32_t tRoaringAddBatch(SRoaringBitmap *pBitmap, const uint64_t *pVals, int32_t num) {
+  int32_t    code = TSDB_CODE_SUCCESS;
+  int32_t    numOfSorted = pBitmap->size;  // the containers in [0, numOfSorted) are sorted by the key
+  SSHashObj *pNewKeys = NULL;               // key -> index of the appended containers
+
+  for (int32_t i = 0; i < num; ++i) {
+    uint64_t key = ROARING_KEY(pVals[i]);
+    int32_t  idx = pBitmap->lastIdx;
+
+    if (idx >= pBitmap->size || pBitmap->pContainers[idx].key != key) {
+      if (numOfSorted == pBitmap->size && (numOfSorted == 0 || pBitmap->pContainers[numOfSorted - 1].key < key)) {
+        idx = numOfSorted++;
+        code = roaringInsertContainer(pBitmap, idx, key);
+      } else {
+        int32_t s = 0, e = numOfSorted;
+        while (s < e) {
+          int32_t m = s + ((e - s) >> 1);
+          if (pBitmap->pContainers[m].key < key) {
+            s = m + 1;
+          } else {
+            e = m;
+          }
+        }
+
+        idx = s;
+        if (idx == numOfSorted || pBitmap->pContainers[idx].key != key) {
+          if (pNewKeys == NULL) {
+            pNewKeys = tSimpleHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT));
+            if (pNewKeys == NULL) {
+              code = TSDB_CODE_OUT_OF_MEMORY;
+              break;
+            }
+          }
+
+          int32_t *pIdx = tSimpleHashGet(pNewKeys, &key, sizeof(uint64_t));
+          if (pIdx != NULL) {
+            idx = *pIdx;
+          } else {
+            idx = pBitmap->size;
+            code = roaringInsertContainer(pBitmap, idx, key);
+            if (code == TSDB_CODE_SUCCESS) {
+              code = tSimpleHashPut(pNewKeys, &key, sizeof(uint64_t), &idx, sizeof(int32_t));
+            }
+          }
+        }
+      }
+
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      pBitmap->lastIdx = idx;
+    }
+
+    code = roaringContainerAdd(&pBitmap->pContainers[idx], ROARING_LOW(pVals[i]));
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+  if (pBitmap->size > numOfSorted) {
+    taosSort(pBitmap->pContainers, pBitmap->size, sizeof(SRoaringContainer), roaringContainerCompare);
+    pBitmap->lastIdx = 0;
+  }
+
+  tSimpleHashCleanup(pNewKeys);
+  return code;
+}
+
+bool tRoaringContains(const SRoaringBitmap *pBitmap, uint64_t val) {
+  uint64_t key = ROARING_KEY(val);
+  int32_t  idx = roaringLowerBound(pBitmap, key);
+  if (idx == pBitmap->size || pBitmap->pContainers[idx].key != key) {
+    return false;
+  }
+  return roaringContainerContains(&pBitmap->pContainers[idx], ROARING_LOW(val));
+}
+
+int64_t tRoaringCardinality(const SRoaringBitmap *pBitmap) {
+  int64_t num = 0;
+  for (int32_t i = 0; i < pBitmap->size; ++i) {
+    num += pBitmap->pContainers[i].num;
+  }
+  return num;
+}
+
+int32_t tRoaringAnd(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t i = 0, j = 0, n = 0;
+
+  for (; i < pDst->size; ++i) {
+    SRoaringContainer *c = &pDst->pContainers[i];
+    while (j < pSrc->size && pSrc->pContainers[j].key < c->key) ++j;
+
+    if (j < pSrc->size && pSrc->pContainers[j].key == c->key) {
+      code = roaringContainerAnd(c, &pSrc->pContainers[j]);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      if (c->num > 0) {
+        pDst->pContainers[n++] = *c;
+        continue;
+      }
+    }
+    taosMemoryFree(c->pData);
+  }
+
+  // keep the containers not handled yet, if it failed
+  memmove(&pDst->pContainers[n], &pDst->pContainers[i], (pDst->size - i) * sizeof(SRoaringContainer));
+  pDst->size = n + (pDst->size - i);
+  pDst->lastIdx = 0;
+  return code;
+}
+
+int32_t tRoaringOr(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc) {
+  if (pSrc->size == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SRoaringContainer *p = taosMemoryMalloc((pDst->size + pSrc->size) * sizeof(SRoaringContainer));
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t i = 0, j = 0, n = 0;
+  while (i < pDst->size || j < pSrc->size) {
+    SRoaringContainer *c = (i < pDst->size) ? &pDst->pContainers[i] : NULL;
+    SRoaringContainer *s = (j < pSrc->size) ? &pSrc->pContainers[j] : NULL;
+
+    if (s == NULL || (c != NULL && c->key < s->key)) {
+      p[n++] = *c;
+      ++i;
+    } else if (c == NULL || s->key < c->key) {
+      code = roaringContainerCopy(&p[n], s);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      ++n;
+      ++j;
+    } else {
+      code = roaringContainerOr(c, s);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      p[n++] = *c;
+      ++i;
+      ++j;
+    }
+  }
+
+  // keep the containers not handled yet, if it failed
+  memcpy(&p[n], &pDst->pContainers[i], (pDst->size - i) * sizeof(SRoaringContainer));
+  n += pDst->size - i;
+
+  taosMemoryFree(pDst->pContainers);
+  pDst->pContainers = p;
+  pDst->size = n;
+  pDst->cap = pDst->size + pSrc->size;
+  pDst->lastIdx = 0;
+  return code;
+}
+
+int32_t tRoaringAndNot(SRoaringBitmap *pDst, const SRoaringBitmap *pSrc) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t i = 0, j = 0, n = 0;
+
+  for (; i < pDst->size; ++i) {
+    SRoaringContainer *c = &pDst->pContainers[i];
+    while (j < pSrc->size && pSrc->pContainers[j].key < c->key) ++j;
+
+    if (j < pSrc->size && pSrc->pContainers[j].key == c->key) {
+      code = roaringContainerAndNot(c, &pSrc->pContainers[j]);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      if (c->num == 0) {
+        taosMemoryFree(c->pData);
+        continue;
+      }
+    }
+    pDst->pContainers[n++] = *c;
+  }
+
+  memmove(&pDst->pContainers[n], &pDst->pContainers[i], (pDst->size - i) * sizeof(SRoaringContainer));
+  pDst->size = n + (pDst->size - i);
+  pDst->lastIdx = 0;
+  return code;
+}
+
+int32_t tRoaringToArray(const SRoaringBitmap *pBitmap, SArray *pArray) {
+  int64_t num = tRoaringCardinality(pBitmap);
+  if (num == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  uint64_t *pOut = taosArrayReserve(pArray, (int32_t)num);
+  if (pOut == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < pBitmap->size; ++i) {
+    const SRoaringContainer *c = &pBitmap->pContainers[i];
+    uint64_t                 high = c->key << 16;
+    if (ROARING_IS_BITMAP(c)) {
+      const uint64_t *pw = c->pData;
+      for (int32_t k = 0; k < ROARING_BITMAP_WORDS; ++k) {
+        uint64_t w = pw[k];
+        while (w != 0) {
+          *pOut++ = high | ((k << 6) + BUILDIN_CTZL(w));
+          w &= w - 1;
+        }
+      }
+    } else {
+      const uint16_t *p = c->pData;
+      for (int32_t k = 0; k < c->num; ++k) {
+        *pOut++ = high | p[k];
+      }
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * | number of containers (int32_t) | container 1 | container 2 | ...
+ * and each container is
+ * | key (uint64_t) | number of values (int32_t) | uint16_t array, or the bitmap if there are too many values |
+ */
+int32_t tRoaringGetEncodeSize(const SRoaringBitmap *pBitmap) {
+  int32_t size = sizeof(int32_t);
+  for (int32_t i = 0; i < pBitmap->size; ++i) {
+    const SRoaringContainer *c = &pBitmap->pContainers[i];
+    size += sizeof(uint64_t) + sizeof(int32_t);
+    size += (c->num > ROARING_ARRAY_MAX_SIZE) ? ROARING_BITMAP_SIZE : c->num * sizeof(uint16_t);
+  }
+  return size;
+}
+
+int32_t tRoaringEncode(const SRoaringBitmap *pBitmap, char *buf) {
+  char *p = buf;
+
+  *(int32_t *)p = pBitmap->size;
+  p += sizeof(int32_t);
+
+  for (int32_t i = 0; i < pBitmap->size; ++i) {
+    const SRoaringContainer *c = &pBitmap->pContainers[i];
+    *(uint64_t *)p = c->key;
+    p += sizeof(uint64_t);
+    *(int32_t *)p = c->num;
+    p += sizeof(int32_t);
+
+    if (c->num > ROARING_ARRAY_MAX_SIZE) {
+      memcpy(p, c->pData, ROARING_BITMAP_SIZE);
+      p += ROARING_BITMAP_SIZE;
+    } else if (ROARING_IS_BITMAP(c)) {
+      p += roaringBitmapExtract(c->pData, (uint16_t *)p) * sizeof(uint16_t);
+    } else {
+      memcpy(p, c->pData, c->num * sizeof(uint16_t));
+      p += c->num * sizeof(uint16_t);
+    }
+  }
+
+  return (int32_t)(p - buf);
+}
+
+SRoaringBitmap *tRoaringDecode(const char *buf, int32_t len) {
+  const char *p = buf;
+  const char *pEnd = buf + len;
+
+  SRoaringBitmap *pBitmap = tRoaringCreate();
+  if (pBitmap == NULL) {
+    return NULL;
+  }
+
+  if (len < sizeof(int32_t)) {
+    goto _err;
+  }
+
+  int32_t size = *(int32_t *)p;
+  p += sizeof(int32_t);
+  if (size < 0) {
+    goto _err;
+  }
+
+  pBitmap->pContainers = taosMemoryCalloc(TMAX(size, 1), sizeof(SRoaringContainer));
+  if (pBitmap->pContainers == NULL) {
+    tRoaringDestroy(pBitmap);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+  pBitmap->cap = TMAX(size, 1);
+
+  for (int32_t i = 0; i < size; ++i) {
+    if (pEnd - p < sizeof(uint64_t) + sizeof(int32_t)) {
+      goto _err;
+    }
+
+    SRoaringContainer *c = &pBitmap->pContainers[i];
+    c->key = *(uint64_t *)p;
+    p += sizeof(uint64_t);
+    c->num = *(int32_t *)p;
+    p += sizeof(int32_t);
+
+    bool   isBitmap = c->num > ROARING_ARRAY_MAX_SIZE;
+    size_t dataLen = isBitmap ? ROARING_BITMAP_SIZE : c->num * sizeof(uint16_t);
+    if (c->num <= 0 || c->num > ROARING_BITMAP_WORDS * 64 || pEnd - p < dataLen) {
+      goto _err;
+    }
+
+    c->cap = isBitmap ? 0 : c->num;
+    c->pData = taosMemoryMalloc(dataLen);
+    if (c->pData == NULL) {
+      tRoaringDestroy(pBitmap);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    pBitmap->size = i + 1;
+
+    memcpy(c->pData, p, dataLen);
+    p += dataLen;
+  }
+
+  return pBitmap;
+
+_err:
+  tRoaringDestroy(pBitmap);
+  terrno = TSDB_CODE_INVALID_DATA_FMT;
+  return NULL;
+}
@@ -45,8 +45,363 @@ struct SSHashObj {
   _hash_free_fn_t freeFp;    // free function
   SArray         *pHashNodeBuf;  // hash node allocation buffer, 1k size of each page by default
   int32_t         offset;        // allocation offset in current page
+
+  // the following fields are only used by the open addressing hash table
+  ESHashType          type;
+  struct SHSlotArray *pSlots;           // current slot array
+  struct SHSlotArray *pOldSlots;        // slot array before resize, not NULL during incremental resize
+  size_t              migrateIdx;       // next slot of the old slot array to be migrated
+  int64_t             numOfDeleted;     // number of deleted slots
+  int64_t             numOfNewDeleted;  // number of deleted slots of the current slot array during resize
 };
 
+static SHNode *doCreateHashNode(SSHashObj *pHashObj, const void *key, size_t keyLen, const void *data, size_t dataLen,
+                                uint32_t hashVal);
+
+/*
+ * Open addressing hash table.
+ *
+ * The slots are organized into groups of SHASH_GROUP_WIDTH. Each slot owns one control byte, which is either
+ * SHASH_CTRL_EMPTY, SHASH_CTRL_DELETED or the 7-bit tag of the hash value of the element in this slot. A lookup
+ * compares the tag with all control bytes of a group at once, and only visits the slots with matched tags. Keys no
+ * longer than 8 bytes are copied into the slot, so the lookup of small keys only touches the hash node when it hits.
+ *
+ * The resize is incremental: the old slot array is kept after resize, and SHASH_MIGRATE_GROUPS groups of it are
+ * moved to the new slot array in each following put operation.
+ */
+#define SHASH_GROUP_WIDTH        16
+#define SHASH_CTRL_EMPTY         ((int8_t)-128)  // 0b10000000
+#define SHASH_CTRL_DELETED       ((int8_t)-2)    // 0b11111110
+#define SHASH_MIGRATE_GROUPS     4
+#define SHASH_SHORT_KEY_LEN      sizeof(uint64_t)
+#define SHASH_OA_NEED_RESIZE(_h) (((_h)->size + (_h)->numOfDeleted) * 8 >= (int64_t)(_h)->capacity * 7)
+
+// the hash value is mixed before use, since the hash functions of small keys are usually weak in the low bits.
+static FORCE_INLINE uint32_t shashMix(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+#define SHASH_H1(_v) (shashMix(_v) >> 7)
+#define SHASH_H2(_v) ((int8_t)(shashMix(_v) & 0x7F))
+
+typedef struct SHSlot {
+  SHNode  *pNode;
+  uint64_t shortKey;  // copy of the key if it is not longer than SHASH_SHORT_KEY_LEN
+} SHSlot;
+
+typedef struct SHSlotArray {
+  int8_t *ctrl;      // control byte of each slot
+  SHSlot *slots;
+  size_t  capacity;  // number of slots, power of 2 and multiple of SHASH_GROUP_WIDTH
+} SHSlotArray;
+
+static FORCE_INLINE uint64_t shortKeyOf(const void *key, size_t keyLen) {
+  uint64_t v = 0;
+  if (keyLen <= SHASH_SHORT_KEY_LEN) {
+    memcpy(&v, key, keyLen);
+  }
+  return v;
+}
+
+// bit i of the returned mask is set if the control byte i of the group equals to the tag
+static FORCE_INLINE uint32_t groupMatch(const int8_t *ctrl, int8_t tag) {
+#if __SSE4_2__
+  __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+  uint32_t mask = 0;
+  for (int32_t i = 0; i < SHASH_GROUP_WIDTH; ++i) {
+    mask |= (uint32_t)(ctrl[i] == tag) << i;
+  }
+  return mask;
+#endif
+}
+
+// both of the empty and the deleted control bytes have the highest bit set
+static FORCE_INLINE uint32_t groupMatchEmptyOrDeleted(const int8_t *ctrl) {
+#if __SSE4_2__
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+  uint32_t mask = 0;
+  for (int32_t i = 0; i < SHASH_GROUP_WIDTH; ++i) {
+    mask |= (uint32_t)(ctrl[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+static FORCE_INLINE uint32_t groupMatchEmpty(const int8_t *ctrl) { return groupMatch(ctrl, SHASH_CTRL_EMPTY); }
+
+static int32_t slotArrayInit(SHSlotArray *pArray, size_t capacity) {
+  pArray->ctrl = taosMemoryMalloc(capacity);
+  pArray->slots = taosMemoryMalloc(capacity * sizeof(SHSlot));
+  if (pArray->ctrl == NULL || pArray->slots == NULL) {
+    taosMemoryFreeClear(pArray->ctrl);
+    taosMemoryFreeClear(pArray->slots);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memset(pArray->ctrl, SHASH_CTRL_EMPTY, capacity);
+  pArray->capacity = capacity;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void slotArrayDestroy(SHSlotArray *pArray) {
+  taosMemoryFreeClear(pArray->ctrl);
+  taosMemoryFreeClear(pArray->slots);
+  pArray->capacity = 0;
+}
+
+// return the index of the slot that holds the key, or -1 if not found
+static int64_t slotArrayFind(const SHSlotArray *pArray, const void *key, size_t keyLen, uint32_t hashVal) {
+  if (pArray->capacity == 0) {
+    return -1;
+  }
+
+  size_t   groupMask = pArray->capacity / SHASH_GROUP_WIDTH - 1;
+  size_t   g = SHASH_H1(hashVal) & groupMask;
+  int8_t   tag = SHASH_H2(hashVal);
+  uint64_t shortKey = shortKeyOf(key, keyLen);
+
+  for (size_t i = 1;; ++i) {
+    const int8_t *ctrl = pArray->ctrl + g * SHASH_GROUP_WIDTH;
+
+    uint32_t mask = groupMatch(ctrl, tag);
+    while (mask != 0) {
+      int64_t       idx = g * SHASH_GROUP_WIDTH + __builtin_ctz(mask);
+      const SHSlot *pSlot = &pArray->slots[idx];
+      if (keyLen <= SHASH_SHORT_KEY_LEN) {
+        // the node is only visited when the short key matches, which is the hit case in most time
+        if (pSlot->shortKey == shortKey && pSlot->pNode->keyLen == keyLen) {
+          return idx;
+        }
+      } else if (pSlot->pNode->hashVal == hashVal && pSlot->pNode->keyLen == keyLen &&
+                 memcmp(GET_SHASH_NODE_KEY(pSlot->pNode, pSlot->pNode->dataLen), key, keyLen) == 0) {
+        return idx;
+      }
+      mask &= (mask - 1);
+    }
+
+    if (groupMatchEmpty(ctrl) != 0 || i > groupMask) {
+      return -1;
+    }
+
+    // triangular probing visits all groups when the number of groups is power of 2
+    g = (g + i) & groupMask;
+  }
+}
+
+static int64_t slotArrayFindFree(const SHSlotArray *pArray, uint32_t hashVal) {
+  size_t groupMask = pArray->capacity / SHASH_GROUP_WIDTH - 1;
+  size_t g = SHASH_H1(hashVal) & groupMask;
+
+  for (size_t i = 1;; ++i) {
+    uint32_t mask = groupMatchEmptyOrDeleted(pArray->ctrl + g * SHASH_GROUP_WIDTH);
+    if (mask != 0) {
+      return g * SHASH_GROUP_WIDTH + __builtin_ctz(mask);
+    }
+
+    g = (g + i) & groupMask;
+  }
+}
+
+static FORCE_INLINE void slotArraySet(SHSlotArray *pArray, int64_t idx, SHNode *pNode) {
+  SHSlot *pSlot = &pArray->slots[idx];
+  pSlot->pNode = pNode;
+  pSlot->shortKey = shortKeyOf(GET_SHASH_NODE_KEY(pNode, pNode->dataLen), pNode->keyLen);
+  pArray->ctrl[idx] = SHASH_H2(pNode->hashVal);
+}
+
+// move at most numOfGroups groups from the old slot array to the current one
+static void doMigrateSlots(SSHashObj *pHashObj, size_t numOfGroups) {
+  SHSlotArray *pOld = pHashObj->pOldSlots;
+  SHSlotArray *pNew = pHashObj->pSlots;
+
+  size_t end = TMIN(pHashObj->migrateIdx + numOfGroups * SHASH_GROUP_WIDTH, pOld->capacity);
+  for (size_t i = pHashObj->migrateIdx; i < end; ++i) {
+    if (pOld->ctrl[i] < 0) {
+      continue;
+    }
+
+    SHNode *pNode = pOld->slots[i].pNode;
+    slotArraySet(pNew, slotArrayFindFree(pNew, pNode->hashVal), pNode);
+
+    // the migrated slot is marked as deleted, so the lookups in the old slot array can still go through it
+    pOld->ctrl[i] = SHASH_CTRL_DELETED;
+  }
+
+  pHashObj->migrateIdx = end;
+  if (end >= pOld->capacity) {
+    slotArrayDestroy(pOld);
+    taosMemoryFreeClear(pHashObj->pOldSlots);
+    pHashObj->numOfDeleted = pHashObj->numOfNewDeleted;
+    pHashObj->numOfNewDeleted = 0;
+    pHashObj->migrateIdx = 0;
+  }
+}
+
+static int32_t doOpenAddrResize(SSHashObj *pHashObj) {
+  // finish the previous resize before starting a new one
+  if (pHashObj->pOldSlots != NULL) {
+    doMigrateSlots(pHashObj, pHashObj->pOldSlots->capacity / SHASH_GROUP_WIDTH);
+  }
+
+  // do not grow if most of the used slots are deleted ones
+  size_t newCapacity = pHashObj->capacity;
+  if (pHashObj->size * 2 >= pHashObj->numOfDeleted) {
+    newCapacity <<= 1u;
+  }
+
+  SHSlotArray *pOld = taosMemoryMalloc(sizeof(SHSlotArray));
+  if (pOld == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  *pOld = *pHashObj->pSlots;
+  if (slotArrayInit(pHashObj->pSlots, newCapacity) != TSDB_CODE_SUCCESS) {
+    *pHashObj->pSlots = *pOld;
+    taosMemoryFree(pOld);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pHashObj->pOldSlots = pOld;
+  pHashObj->capacity = newCapacity;
+  pHashObj->migrateIdx = 0;
+  pHashObj->numOfNewDeleted = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
+// find the slot of the key in both of the current and the old slot array
+static FORCE_INLINE SHSlotArray *doOpenAddrFind(SSHashObj *pHashObj, const void *key, size_t keyLen, uint32_t hashVal,
+                                                int64_t *idx) {
+  *idx = slotArrayFind(pHashObj->pSlots, key, keyLen, hashVal);
+  if (*idx >= 0) {
+    return pHashObj->pSlots;
+  }
+
+  if (pHashObj->pOldSlots != NULL) {
+    *idx = slotArrayFind(pHashObj->pOldSlots, key, keyLen, hashVal);
+    if (*idx >= 0) {
+      return pHashObj->pOldSlots;
+    }
+  }
+
+  return NULL;
+}
+
+static int32_t doOpenAddrPut(SSHashObj *pHashObj, const void *key, size_t keyLen, const void *data, size_t dataLen,
+                             uint32_t hashVal) {
+  int64_t      idx = -1;
+  SHSlotArray *pArray = doOpenAddrFind(pHashObj, key, keyLen, hashVal, &idx);
+  if (pArray != NULL) {
+    if (data) {  // update data
+      memcpy(GET_SHASH_NODE_DATA(pArray->slots[idx].pNode), data, dataLen);
+    }
+    return 0;
+  }
+
+  if (pHashObj->pOldSlots != NULL) {
+    doMigrateSlots(pHashObj, SHASH_MIGRATE_GROUPS);
+  }
+
+  if (SHASH_OA_NEED_RESIZE(pHashObj) && doOpenAddrResize(pHashObj) != TSDB_CODE_SUCCESS) {
+    uWarn("hash resize failed due to out of memory, capacity remain:%zu", pHashObj->capacity);
+    if (pHashObj->size >= (int64_t)pHashObj->capacity) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+  }
+
+  SHNode *pNewNode = doCreateHashNode(pHashObj, key, keyLen, data, dataLen, hashVal);
+  if (!pNewNode) {
+    return -1;
+  }
+
+  idx = slotArrayFindFree(pHashObj->pSlots, hashVal);
+  if (pHashObj->pSlots->ctrl[idx] == SHASH_CTRL_DELETED) {
+    if (pHashObj->pOldSlots != NULL) {
+      pHashObj->numOfNewDeleted -= 1;
+    }
+    pHashObj->numOfDeleted -= 1;
+  }
+
+  slotArraySet(pHashObj->pSlots, idx, pNewNode);
+  pHashObj->size += 1;
+  return 0;
+}
+
+static void doOpenAddrRemoveSlot(SSHashObj *pHashObj, SHSlotArray *pArray, int64_t idx) {
+  SHNode *pNode = pArray->slots[idx].pNode;
+
+  // the slot can be reset to empty directly if no probe sequence goes through its group
+  const int8_t *ctrl = pArray->ctrl + (idx / SHASH_GROUP_WIDTH) * SHASH_GROUP_WIDTH;
+  if (groupMatchEmpty(ctrl) != 0) {
+    pArray->ctrl[idx] = SHASH_CTRL_EMPTY;
+  } else {
+    pArray->ctrl[idx] = SHASH_CTRL_DELETED;
+    pHashObj->numOfDeleted += 1;
+    if (pArray == pHashObj->pSlots && pHashObj->pOldSlots != NULL) {
+      pHashObj->numOfNewDeleted += 1;
+    }
+  }
+
+  FREE_HASH_NODE(pNode, pHashObj->freeFp);
+  pHashObj->size -= 1;
+}
+
+static void doOpenAddrClear(SSHashObj *pHashObj) {
+  SHSlotArray *arrays[2] = {pHashObj->pOldSlots, pHashObj->pSlots};
+  for (int32_t k = 0; k < tListLen(arrays); ++k) {
+    SHSlotArray *pArray = arrays[k];
+    if (pArray == NULL) {
+      continue;
+    }
+
+    for (size_t i = 0; i < pArray->capacity; ++i) {
+      if (pArray->ctrl[i] >= 0) {
+        FREE_HASH_NODE(pArray->slots[i].pNode, pHashObj->freeFp);
+      }
+    }
+    memset(pArray->ctrl, SHASH_CTRL_EMPTY, pArray->capacity);
+  }
+
+  if (pHashObj->pOldSlots != NULL) {
+    slotArrayDestroy(pHashObj->pOldSlots);
+    taosMemoryFreeClear(pHashObj->pOldSlots);
+  }
+
+  pHashObj->migrateIdx = 0;
+  pHashObj->numOfDeleted = 0;
+  pHashObj->numOfNewDeleted = 0;
+  pHashObj->size = 0;
+}
+
+/*
+ * The iterator of the open addressing table walks through the old slot array first, and then the current one.
+ * *iter is the index of the slot of the returned element in such order.
+ */
+static void *doOpenAddrIterate(const SSHashObj *pHashObj, void *data, int32_t *iter) {
+  size_t oldCapacity = (pHashObj->pOldSlots != NULL) ? pHashObj->pOldSlots->capacity : 0;
+  size_t total = oldCapacity + pHashObj->pSlots->capacity;
+
+  size_t i = (size_t)(*iter) + ((data != NULL) ? 1 : 0);
+  for (; i < total; ++i) {
+    const SHSlotArray *pArray = (i < oldCapacity) ? pHashObj->pOldSlots : pHashObj->pSlots;
+    size_t             idx = (i < oldCapacity) ? i : i - oldCapacity;
+    if (pArray->ctrl[idx] >= 0) {
+      *iter = (int32_t)i;
+      return GET_SHASH_NODE_DATA(pArray->slots[idx].pNode);
+    }
+  }
+
+  return NULL;
+}
+
 static FORCE_INLINE int32_t taosHashCapacity(int32_t length) {
   int32_t len = (length < HASH_MAX_CAPACITY ? length : HASH_MAX_CAPACITY);
 
@@ -56,6 +411,10 @@ static FORCE_INLINE int32_t taosHashCapacity(int32_t length) {
 }
 
 SSHashObj *tSimpleHashInit(size_t capacity, _hash_fn_t fn) {
+  return tSimpleHashInitEx(capacity, fn, SHASH_TYPE_CHAINED);
+}
+
+SSHashObj *tSimpleHashInitEx(size_t capacity, _hash_fn_t fn, ESHashType type) {
   if (fn == NULL) {
     return NULL;
   }
@@ -78,7 +437,28 @@ SSHashObj *tSimpleHashInit(size_t capacity, _hash_fn_t fn) {
   pHashObj->freeFp = NULL;
   pHashObj->offset = 0;
   pHashObj->size = 0;
-  
+
+  pHashObj->type = type;
+  pHashObj->pSlots = NULL;
+  pHashObj->pOldSlots = NULL;
+  pHashObj->migrateIdx = 0;
+  pHashObj->numOfDeleted = 0;
+  pHashObj->numOfNewDeleted = 0;
+
+  if (type == SHASH_TYPE_OPEN_ADDR) {
+    pHashObj->hashList = NULL;
+    pHashObj->capacity = TMAX(pHashObj->capacity, SHASH_GROUP_WIDTH);
+    pHashObj->pSlots = taosMemoryCalloc(1, sizeof(SHSlotArray));
+    if (!pHashObj->pSlots || slotArrayInit(pHashObj->pSlots, pHashObj->capacity) != TSDB_CODE_SUCCESS) {
+      taosMemoryFree(pHashObj->pSlots);
+      taosMemoryFree(pHashObj);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+
+    return pHashObj;
+  }
+
   pHashObj->hashList = (SHNode **)taosMemoryCalloc(pHashObj->capacity, sizeof(void *));
   if (!pHashObj->hashList) {
     taosMemoryFree(pHashObj);
@@ -214,6 +594,9 @@ int32_t tSimpleHashPut(SSHashObj *pHashObj, const void *key, size_t keyLen, cons
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    return doOpenAddrPut(pHashObj, key, keyLen, data, dataLen, hashVal);
+  }
 
   // need the resize process, write lock applied
   if (SHASH_NEED_RESIZE(pHashObj)) {
@@ -279,6 +662,11 @@ void *tSimpleHashGet(SSHashObj *pHashObj, const void *key, size_t keyLen) {
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    int64_t      idx = -1;
+    SHSlotArray *pArray = doOpenAddrFind(pHashObj, key, keyLen, hashVal, &idx);
+    return (pArray != NULL) ? GET_SHASH_NODE_DATA(pArray->slots[idx].pNode) : NULL;
+  }
 
   int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
   SHNode *pNode = pHashObj->hashList[slot];
@@ -302,6 +690,15 @@ int32_t tSimpleHashRemove(SSHashObj *pHashObj, const void *key, size_t keyLen) {
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    int64_t      idx = -1;
+    SHSlotArray *pArray = doOpenAddrFind(pHashObj, key, keyLen, hashVal, &idx);
+    if (pArray != NULL) {
+      doOpenAddrRemoveSlot(pHashObj, pArray, idx);
+      code = TSDB_CODE_SUCCESS;
+    }
+    return code;
+  }
 
   int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
 
@@ -333,6 +730,18 @@ int32_t tSimpleHashIterateRemove(SSHashObj *pHashObj, const void *key, size_t ke
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    int64_t      idx = -1;
+    SHSlotArray *pArray = doOpenAddrFind(pHashObj, key, keyLen, hashVal, &idx);
+    if (pArray != NULL) {
+      // the removed slot is skipped when the iteration restarts from *iter
+      if (*pIter == (void *)GET_SHASH_NODE_DATA(pArray->slots[idx].pNode)) {
+        *pIter = NULL;
+      }
+      doOpenAddrRemoveSlot(pHashObj, pArray, idx);
+    }
+    return TSDB_CODE_SUCCESS;
+  }
 
   int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
 
@@ -366,6 +775,11 @@ void tSimpleHashClear(SSHashObj *pHashObj) {
     return;
   }
 
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    doOpenAddrClear(pHashObj);
+    return;
+  }
+
   SHNode *pNode = NULL, *pNext = NULL;
   for (int32_t i = 0; i < pHashObj->capacity; ++i) {
     pNode = pHashObj->hashList[i];
@@ -393,6 +807,10 @@ void tSimpleHashCleanup(SSHashObj *pHashObj) {
 
   tSimpleHashClear(pHashObj);
   taosMemoryFreeClear(pHashObj->hashList);
+  if (pHashObj->pSlots != NULL) {
+    slotArrayDestroy(pHashObj->pSlots);
+    taosMemoryFreeClear(pHashObj->pSlots);
+  }
   taosMemoryFree(pHashObj);
 }
 
@@ -401,6 +819,12 @@ size_t tSimpleHashGetMemSize(const SSHashObj *pHashObj) {
     return 0;
   }
 
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    size_t numOfSlots = pHashObj->capacity + ((pHashObj->pOldSlots != NULL) ? pHashObj->pOldSlots->capacity : 0);
+    return numOfSlots * (sizeof(SHSlot) + sizeof(int8_t)) + sizeof(SHNode) * tSimpleHashGetSize(pHashObj) +
+           sizeof(SSHashObj);
+  }
+
   return (pHashObj->capacity * sizeof(void *)) + sizeof(SHNode) * tSimpleHashGetSize(pHashObj) + sizeof(SSHashObj);
 }
 
@@ -409,6 +833,10 @@ void *tSimpleHashIterate(const SSHashObj *pHashObj, void *data, int32_t *iter) {
     return NULL;
   }
 
+  if (pHashObj->type == SHASH_TYPE_OPEN_ADDR) {
+    return doOpenAddrIterate(pHashObj, data, iter);
+  }
+
   SHNode *pNode = NULL;
 
   if (!data) {
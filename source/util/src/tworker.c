@@ -305,7 +305,7 @@ int32_t tWWorkerInit(SWWorkerPool *pool) {
     worker->pool = pool;
   }
 
-  uInfo("worker:%s is initialized, max:%d", pool->name, pool->max);
+  uInfo("worker:%s is initialized, max:%d queueMode:%d", pool->name, pool->max, pool->queueMode);
   return 0;
 }
 
@@ -380,12 +380,12 @@ STaosQueue *tWWorkerAllocQueue(SWWorkerPool *pool, void *ahandle, FItems fp) {
   SWWorker *worker = pool->workers + pool->nextId;
   int32_t   code = -1;
 
-  STaosQueue *queue = taosOpenQueue();
+  STaosQueue *queue = taosOpenQueueEx(pool->queueMode);
   if (queue == NULL) goto _OVER;
 
   taosSetQueueFp(queue, NULL, fp);
   if (worker->qset == NULL) {
-    worker->qset = taosOpenQset();
+    worker->qset = taosOpenQsetEx(pool->queueMode);
     if (worker->qset == NULL) goto _OVER;
 
     taosAddIntoQset(worker->qset, queue, ahandle);
@@ -461,6 +461,7 @@ int32_t tMultiWorkerInit(SMultiWorker *pWorker, const SMultiWorkerCfg *pCfg) {
   SWWorkerPool *pPool = &pWorker->pool;
   pPool->name = pCfg->name;
   pPool->max = pCfg->max;
+  pPool->queueMode = pCfg->queueMode;
   if (tWWorkerInit(pPool) != 0) return -1;
 
   pWorker->queue = tWWorkerAllocQueue(pPool, pCfg->param, pCfg->fp);
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tcol.h"
+#include "tcompression.h"
+#include "ttypes.h"
+
+// compress/decompress throughput and ratio of every encode x compress x level combination on time-series shaped data
+typedef struct {
+  const char *name;
+  int8_t      type;
+} SBenchData;
+
+static const SBenchData benchData[] = {
+    {"ts_jitter", TSDB_DATA_TYPE_TIMESTAMP},  // monotonic timestamps with a jittered interval
+    {"float_drift", TSDB_DATA_TYPE_FLOAT},    // slowly drifting sensor readings
+    {"double_drift", TSDB_DATA_TYPE_DOUBLE},
+    {"int_lowcard", TSDB_DATA_TYPE_INT},  // a few distinct status codes
+    {"bool_sparse", TSDB_DATA_TYPE_BOOL},
+    {"string_random", TSDB_DATA_TYPE_VARCHAR},  // random strings over a small alphabet
+};
+
+static const char *l2Name[] = {"disabled", "lz4", "zlib", "zstd", "tsz", "xz"};
+static const char *lvlName[] = {"", "low", "medium", "high"};
+
+static double gbps(int64_t bytes, int64_t us) { return (us == 0) ? 0 : ((double)bytes) / us / 1000; }
+
+static uint32_t benchRand(uint32_t *seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 1) & 0x7fffffff;
+}
+
+// generate one column of num rows, and return its size in bytes
+static int32_t genBenchData(int8_t type, int32_t num, char *pBuf) {
+  uint32_t seed = 20240601;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TIMESTAMP: {
+      int64_t *p = (int64_t *)pBuf;
+      int64_t  ts = 1700000000000;
+      for (int32_t i = 0; i < num; ++i) {
+        ts += 1000 + (int32_t)(benchRand(&seed) % 21) - 10;
+        p[i] = ts;
+      }
+      return num * sizeof(int64_t);
+    }
+    case TSDB_DATA_TYPE_FLOAT: {
+      float *p = (float *)pBuf;
+      float  v = 25.0f;
+      for (int32_t i = 0; i < num; ++i) {
+        v += ((int32_t)(benchRand(&seed) % 201) - 100) * 0.001f;
+        p[i] = v;
+      }
+      return num * sizeof(float);
+    }
+    case TSDB_DATA_TYPE_DOUBLE: {
+      double *p = (double *)pBuf;
+      double  v = 220.0;
+      for (int32_t i = 0; i < num; ++i) {
+        v += ((int32_t)(benchRand(&seed) % 201) - 100) * 0.0001;
+        p[i] = v;
+      }
+      return num * sizeof(double);
+    }
+    case TSDB_DATA_TYPE_INT: {
+      int32_t      *p = (int32_t *)pBuf;
+      const int32_t codes[] = {200, 200, 200, 200, 200, 200, 301, 404, 500, 503};
+      for (int32_t i = 0; i < num; ++i) {
+        p[i] = codes[benchRand(&seed) % tListLen(codes)];
+      }
+      return num * sizeof(int32_t);
+    }
+    case TSDB_DATA_TYPE_BOOL: {
+      int8_t *p = (int8_t *)pBuf;
+      for (int32_t i = 0; i < num; ++i) {
+        p[i] = (benchRand(&seed) % 16 == 0);
+      }
+      return num;
+    }
+    default: {
+      // var data laid out as in a block: the strings are stored back to back
+      int32_t len = 0;
+      for (int32_t i = 0; i < num; ++i) {
+        int32_t n = 8 + benchRand(&seed) % 24;
+        for (int32_t j = 0; j < n; ++j) {
+          pBuf[len++] = 'a' + benchRand(&seed) % 16;
+        }
+      }
+      return len;
+    }
+  }
+}
+
+typedef struct {
+  int32_t cmprSize;
+  double  cmprGbps;
+  double  decmprGbps;
+  bool    verified;
+} SBenchResult;
+
+static int32_t benchOnce(int8_t type, uint32_t cmprAlg, const char *pData, int32_t nData, int32_t num, int32_t rounds,
+                         char *pOut, char *pDecmpr, char *pBuf, int32_t nBuf, SBenchResult *pRes) {
+  tDataTypeCompress *pCompress = &tDataCompress[type];
+
+  int32_t len = 0;
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < rounds; ++i) {
+    len = pCompress->compFunc((void *)pData, nData, num, pOut, nBuf, cmprAlg, pBuf, nBuf);
+    if (len <= 0) return -1;
+  }
+  pRes->cmprGbps = gbps((int64_t)nData * rounds, taosGetTimestampUs() - st);
+  pRes->cmprSize = len;
+
+  int32_t size = 0;
+  st = taosGetTimestampUs();
+  for (int32_t i = 0; i < rounds; ++i) {
+    size = pCompress->decompFunc(pOut, len, num, pDecmpr, nBuf, cmprAlg, pBuf, nBuf);
+    if (size < 0) return -1;
+  }
+  pRes->decmprGbps = gbps((int64_t)nData * rounds, taosGetTimestampUs() - st);
+
+  // the lossy tsz mode is only taken when lossy float/double columns are configured, which is not the case here
+  pRes->verified = (size == nData) && (memcmp(pData, pDecmpr, nData) == 0);
+  return 0;
+}
+
+#ifdef BUILD_NO_CALL
+// the streaming compressor feeds the values one by one
+static void benchStream(const SBenchData *pData, const char *pCol, int32_t nData, int32_t num, int32_t loops) {
+  if (IS_VAR_DATA_TYPE(pData->type)) return;
+
+  int32_t bytes = tDataTypes[pData->type].bytes;
+  for (int8_t cmprAlg = ONE_STAGE_COMP; cmprAlg <= TWO_STAGE_COMP; ++cmprAlg) {
+    SCompressor *pCmprsor = NULL;
+    if (tCompressorCreate(&pCmprsor) != 0) return;
+
+    double         best = 0;
+    const uint8_t *pOut = NULL;
+    int32_t        nOut = 0;
+    for (int32_t l = 0; l < loops; ++l) {
+      int64_t st = taosGetTimestampUs();
+      tCompressStart(pCmprsor, pData->type, cmprAlg);
+      for (int32_t i = 0; i < num; ++i) {
+        tCompress(pCmprsor, pCol + (int64_t)i * bytes, bytes);
+      }
+      tCompressEnd(pCmprsor, &pOut, &nOut, NULL);
+      best = TMAX(best, gbps(nData, taosGetTimestampUs() - st));
+    }
+
+    printf("%s,%s,stream,%s,,%d,%d,%d,%.3f,%.3f,,\n", pData->name, tDataTypes[pData->type].name,
+           (cmprAlg == ONE_STAGE_COMP) ? "one_stage" : "two_stage", num, nData, nOut,
+           (nOut == 0) ? 0 : ((double)nData) / nOut, best);
+    tCompressorDestroy(pCmprsor);
+  }
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  int32_t num = 4096;
+  int32_t rounds = 100;
+  int32_t loops = 3;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      num = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i < argc - 1) {
+      rounds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      loops = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n]: number of rows in one block, default: %d\n", num);
+      printf("  [-r]: number of rounds timed in each loop, default: %d\n", rounds);
+      printf("  [-l]: number of loops for each case, the best one is reported, default: %d\n", loops);
+      exit(0);
+    }
+  }
+
+  if (num <= 0 || rounds <= 0 || loops <= 0) {
+    printf("invalid options, rows:%d rounds:%d loops:%d\n", num, rounds, loops);
+    return -1;
+  }
+
+  // the strings are at most 32 bytes, and the compressed output may exceed the input by a few bytes
+  int32_t nBuf = num * 32 + 1024;
+  char   *pCol = taosMemoryMalloc(nBuf);
+  char   *pOut = taosMemoryMalloc(nBuf);
+  char   *pDecmpr = taosMemoryMalloc(nBuf);
+  char   *pBuf = taosMemoryMalloc(nBuf);
+  if (pCol == NULL || pOut == NULL || pDecmpr == NULL || pBuf == NULL) {
+    printf("out of memory, rows:%d\n", num);
+    return -1;
+  }
+
+  // csv output
+  printf("data,type,encode,compress,level,rows,raw_bytes,cmpr_bytes,ratio,cmpr_gbps,decmpr_gbps,verified\n");
+  for (int32_t d = 0; d < tListLen(benchData); ++d) {
+    const SBenchData *pData = &benchData[d];
+    int32_t           nData = genBenchData(pData->type, num, pCol);
+
+    // the default encode of the type, and the encode disabled
+    uint8_t l1List[] = {getDefaultEncode(pData->type), L1_DISABLED};
+    for (int32_t e = 0; e < tListLen(l1List); ++e) {
+      uint8_t l1 = l1List[e];
+      if (e > 0 && l1 == l1List[0]) continue;
+
+      for (uint8_t l2 = L2_UNKNOWN; l2 <= L2_XZ; ++l2) {
+        // no encode and no compress is not a valid combination
+        if (l1 == L1_DISABLED && l2 == L2_UNKNOWN) continue;
+
+        for (uint8_t lvl = L2_LVL_LOW; lvl <= L2_LVL_HIGH; ++lvl) {
+          uint32_t cmprAlg = 0;
+          SET_COMPRESS(l1, (l2 == L2_UNKNOWN) ? L2_DISABLED : l2, lvl, cmprAlg);
+
+          SBenchResult best = {0};
+          for (int32_t l = 0; l < loops; ++l) {
+            SBenchResult res = {0};
+            if (benchOnce(pData->type, cmprAlg, pCol, nData, num, rounds, pOut, pDecmpr, pBuf, nBuf, &res) != 0) {
+              printf("failed to run benchmark, data:%s encode:%s compress:%s\n", pData->name, columnEncodeStr(l1),
+                     l2Name[l2]);
+              return -1;
+            }
+
+            best.cmprSize = res.cmprSize;
+            best.verified = res.verified;
+            best.cmprGbps = TMAX(best.cmprGbps, res.cmprGbps);
+            best.decmprGbps = TMAX(best.decmprGbps, res.decmprGbps);
+          }
+
+          printf("%s,%s,%s,%s,%s,%d,%d,%d,%.3f,%.3f,%.3f,%d\n", pData->name, tDataTypes[pData->type].name,
+                 (l1 == L1_DISABLED) ? "disabled" : columnEncodeStr(l1), l2Name[l2], lvlName[lvl], num, nData,
+                 best.cmprSize, ((double)nData) / best.cmprSize, best.cmprGbps, best.decmprGbps, best.verified);
+
+          // the level makes no difference without the compress
+          if (l2 == L2_UNKNOWN) break;
+        }
+      }
+    }
+
+#ifdef BUILD_NO_CALL
+    benchStream(pData, pCol, nData, num, loops);
+#endif
+  }
+
+  taosMemoryFree(pCol);
+  taosMemoryFree(pOut);
+  taosMemoryFree(pDecmpr);
+  taosMemoryFree(pBuf);
+  return 0;
+}
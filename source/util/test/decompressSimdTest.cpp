@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <tcompression.h>
+#include <random>
+#include "ttypes.h"
+
+namespace {
+
+enum { DECOMP_SCALAR = 0, DECOMP_AVX2, DECOMP_AVX512 };
+
+struct SSimdEnv {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  char simdEnable, avx2Enable, avx512Enable;
+
+  SSimdEnv() : simdEnable(tsSIMDEnable), avx2Enable(tsAVX2Enable), avx512Enable(tsAVX512Enable) {
+    taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+  }
+  ~SSimdEnv() {
+    tsSIMDEnable = simdEnable;
+    tsAVX2Enable = avx2Enable;
+    tsAVX512Enable = avx512Enable;
+  }
+
+  bool set(int32_t mode) {
+    tsSIMDEnable = (mode != DECOMP_SCALAR);
+    tsAVX2Enable = (mode == DECOMP_AVX2) ? avx2 : 0;
+    tsAVX512Enable = (mode == DECOMP_AVX512) ? avx512 : 0;
+    return mode == DECOMP_SCALAR || tsAVX2Enable || tsAVX512Enable;
+  }
+};
+
+typedef int32_t (*FCompress)(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg,
+                             void *pBuf, int32_t nBuf);
+
+const int32_t numList[] = {1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 239, 240, 241, 1000, 4096};
+
+// decode the data with the scalar and every SIMD version and compare the outputs byte by byte
+void checkDecompress(FCompress compFn, FCompress decompFn, const void *pIn, int32_t bytes, int32_t nEle,
+                     bool lossless) {
+  int32_t nOut = bytes * 2 + 64;
+  char   *pCompressed = (char *)taosMemoryMalloc(nOut);
+  char   *pExpect = (char *)taosMemoryCalloc(1, bytes + 64);
+  char   *pOutput = (char *)taosMemoryCalloc(1, bytes + 64);
+  ASSERT_NE(pCompressed, nullptr);
+
+  int32_t len = compFn((void *)pIn, bytes, nEle, pCompressed, nOut, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_GT(len, 0);
+
+  SSimdEnv env;
+  ASSERT_TRUE(env.set(DECOMP_SCALAR));
+  ASSERT_EQ(decompFn(pCompressed, len, nEle, pExpect, bytes + 64, ONE_STAGE_COMP, NULL, 0), bytes);
+  if (lossless) {
+    ASSERT_EQ(memcmp(pExpect, pIn, bytes), 0);
+  }
+
+  for (int32_t mode = DECOMP_AVX2; mode <= DECOMP_AVX512; ++mode) {
+    if (!env.set(mode)) {
+      continue;
+    }
+
+    memset(pOutput, 0xcd, bytes + 64);
+    ASSERT_EQ(decompFn(pCompressed, len, nEle, pOutput, bytes + 64, ONE_STAGE_COMP, NULL, 0), bytes);
+    ASSERT_EQ(memcmp(pExpect, pOutput, bytes), 0) << "mode:" << mode << " num:" << nEle;
+    // nothing is written out of the range
+    ASSERT_EQ((uint8_t)pOutput[bytes], 0xcd) << "mode:" << mode << " num:" << nEle;
+  }
+
+  taosMemoryFree(pCompressed);
+  taosMemoryFree(pExpect);
+  taosMemoryFree(pOutput);
+}
+
+template <typename T>
+void genIntData(T *p, int32_t num, int32_t pattern, std::mt19937_64 &rng) {
+  int64_t v = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    switch (pattern) {
+      case 0:  // random in the full range
+        p[i] = (T)rng();
+        break;
+      case 1:  // small deltas
+        v += (int64_t)(rng() % 17) - 8;
+        p[i] = (T)v;
+        break;
+      case 2:  // constant, encoded with the selector 0/1
+        p[i] = (T)1234567;
+        break;
+      case 3:  // runs of the same value with jumps
+        if (i % 300 == 0) v = (int64_t)(rng() % 100000);
+        p[i] = (T)v;
+        break;
+      default:  // the extreme values
+        p[i] = (i & 1) ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+        break;
+    }
+  }
+}
+
+template <typename T>
+void checkIntType(FCompress compFn, FCompress decompFn) {
+  std::mt19937_64 rng(20240601);
+  for (int32_t pattern = 0; pattern < 5; ++pattern) {
+    for (int32_t num : numList) {
+      T *p = (T *)taosMemoryMalloc(num * sizeof(T));
+      genIntData<T>(p, num, pattern, rng);
+      checkDecompress(compFn, decompFn, p, num * sizeof(T), num, true);
+      taosMemoryFree(p);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(decompressSimdTest, integer) {
+  checkIntType<int8_t>(tsCompressTinyint, tsDecompressTinyint);
+  checkIntType<int16_t>(tsCompressSmallint, tsDecompressSmallint);
+  checkIntType<int32_t>(tsCompressInt, tsDecompressInt);
+  checkIntType<int64_t>(tsCompressBigint, tsDecompressBigint);
+}
+
+TEST(decompressSimdTest, timestamp) {
+  std::mt19937_64 rng(1700000000);
+  for (int32_t pattern = 0; pattern < 4; ++pattern) {
+    for (int32_t num : numList) {
+      int64_t *p = (int64_t *)taosMemoryMalloc(num * sizeof(int64_t));
+      int64_t  ts = 1700000000000;
+      for (int32_t i = 0; i < num; ++i) {
+        if (pattern == 0) {  // fixed interval
+          ts += 1000;
+        } else if (pattern == 1) {  // jittered interval
+          ts += 1000 + (int64_t)(rng() % 21) - 10;
+        } else if (pattern == 2) {  // random, falls back to no compression for large deltas
+          ts = (int64_t)(rng() >> 2);
+        } else {  // disordered
+          ts += (int64_t)(rng() % 2001) - 1000;
+        }
+        p[i] = ts;
+      }
+
+      checkDecompress(tsCompressTimestamp, tsDecompressTimestamp, p, num * sizeof(int64_t), num, true);
+      taosMemoryFree(p);
+    }
+  }
+}
+
+TEST(decompressSimdTest, floatDouble) {
+  std::mt19937_64 rng(42);
+  for (int32_t pattern = 0; pattern < 3; ++pattern) {
+    for (int32_t num : numList) {
+      float  *pf = (float *)taosMemoryMalloc(num * sizeof(float));
+      double *pd = (double *)taosMemoryMalloc(num * sizeof(double));
+      for (int32_t i = 0; i < num; ++i) {
+        if (pattern == 0) {
+          pd[i] = (double)(int64_t)rng() / 3;
+        } else if (pattern == 1) {
+          pd[i] = 25.0 + (i % 100) * 0.01;
+        } else {
+          pd[i] = (i % 7 == 0) ? 0.0 : -1.5e300 / (i + 1);
+        }
+        pf[i] = (float)(pattern == 2 ? (double)i * 0.25f : pd[i]);
+      }
+
+      checkDecompress(tsCompressFloat, tsDecompressFloat, pf, num * sizeof(float), num, true);
+      checkDecompress(tsCompressDouble, tsDecompressDouble, pd, num * sizeof(double), num, true);
+      taosMemoryFree(pf);
+      taosMemoryFree(pd);
+    }
+  }
+}
+
+TEST(decompressSimdTest, boolean) {
+  std::mt19937_64 rng(7);
+  for (int32_t num : numList) {
+    int8_t *p = (int8_t *)taosMemoryMalloc(num);
+    for (int32_t i = 0; i < num; ++i) {
+      int32_t r = rng() % 3;
+      p[i] = (r == 2) ? TSDB_DATA_BOOL_NULL : r;
+    }
+
+    checkDecompress(tsCompressBool, tsDecompressBool, p, num, num, true);
+    taosMemoryFree(p);
+  }
+}
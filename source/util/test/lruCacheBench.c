@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "thash.h"
+#include "tlrucache.h"
+
+/*
+ * hit ratio of the lru cache with the lru and the tinylfu policy, replaying a trace of keys: each key is looked up,
+ * and inserted with charge 1 on a miss, so the capacity is in entries
+ *   zipf:      skewed lookups of 20 * capacity keys
+ *   zipf_scan: the same, with a scan of 2 * capacity keys never looked up again after every 50000 lookups
+ *   loop:      lookups of 1.5 * capacity keys in turn
+ *   file:      the lines of the file given by -f, one key per line
+ */
+static const char *policyName[] = {"lru", "tinylfu"};
+
+static uint32_t benchRand(uint32_t *seed) {
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 1) & 0x7fffffff;
+}
+
+static double benchRandUnit(uint32_t *seed) {
+  uint64_t r = ((uint64_t)benchRand(seed) << 31) | benchRand(seed);
+  return (double)r / (double)(1ULL << 62);
+}
+
+static int64_t sampleZipf(const double *cdf, int64_t numOfKeys, uint32_t *seed) {
+  double  u = benchRandUnit(seed);
+  int64_t lo = 0, hi = numOfKeys - 1;
+  while (lo < hi) {
+    int64_t mid = (lo + hi) / 2;
+    if (cdf[mid] < u) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+static int32_t genZipfTrace(uint64_t *trace, int64_t num, int64_t capacity, bool scan) {
+  int64_t numOfKeys = capacity * 20;
+  double *cdf = taosMemoryMalloc(numOfKeys * sizeof(double));
+  if (cdf == NULL) {
+    return -1;
+  }
+
+  double sum = 0;
+  for (int64_t i = 0; i < numOfKeys; ++i) {
+    sum += 1.0 / pow(i + 1, 0.99);
+    cdf[i] = sum;
+  }
+  for (int64_t i = 0; i < numOfKeys; ++i) {
+    cdf[i] /= sum;
+  }
+
+  uint32_t seed = 20240601;
+  uint64_t scanKey = numOfKeys;
+  for (int64_t i = 0; i < num;) {
+    trace[i++] = sampleZipf(cdf, numOfKeys, &seed);
+    if (scan && i % 50000 == 0) {
+      for (int64_t j = 0; j < capacity * 2 && i < num; ++j) {
+        trace[i++] = scanKey++;
+      }
+    }
+  }
+
+  taosMemoryFree(cdf);
+  return 0;
+}
+
+static int64_t loadFileTrace(const char *path, uint64_t **ppTrace) {
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_READ | TD_FILE_STREAM);
+  if (pFile == NULL) {
+    printf("failed to open trace file:%s\n", path);
+    return -1;
+  }
+
+  int64_t num = 0, cap = 0;
+  char   *line = NULL;
+  int64_t len = 0;
+  while ((len = taosGetLineFile(pFile, &line)) != -1) {
+    while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+      --len;
+    }
+    if (len == 0) continue;
+
+    if (num == cap) {
+      cap = TMAX(cap * 2, 1024);
+      uint64_t *p = taosMemoryRealloc(*ppTrace, cap * sizeof(uint64_t));
+      if (p == NULL) {
+        num = -1;
+        break;
+      }
+      *ppTrace = p;
+    }
+    (*ppTrace)[num++] = MurmurHash3_64(line, len);
+  }
+
+  taosMemoryFreeClear(line);
+  taosCloseFile(&pFile);
+  return num;
+}
+
+// replays the trace once, and returns the time used in us
+static int64_t benchReplay(const uint64_t *trace, int64_t num, int64_t capacity, int32_t shardBits, LRUPolicy policy,
+                           SLRUCacheStats *pStats) {
+  SLRUCache *pCache = taosLRUCacheInitWithPolicy(capacity, shardBits, 0.5, policy);
+  if (pCache == NULL) {
+    return -1;
+  }
+
+  int64_t st = taosGetTimestampUs();
+  for (int64_t i = 0; i < num; ++i) {
+    LRUHandle *h = taosLRUCacheLookup(pCache, &trace[i], sizeof(uint64_t));
+    if (h != NULL) {
+      taosLRUCacheRelease(pCache, h, false);
+    } else {
+      taosLRUCacheInsert(pCache, &trace[i], sizeof(uint64_t), (void *)trace, 1, NULL, NULL, TAOS_LRU_PRIORITY_LOW,
+                         NULL);
+    }
+  }
+  int64_t used = taosGetTimestampUs() - st;
+
+  taosLRUCacheGetStats(pCache, pStats);
+  taosLRUCacheCleanup(pCache);
+  return used;
+}
+
+static int32_t benchTrace(const char *name, const uint64_t *trace, int64_t num, int64_t capacity, int32_t shardBits) {
+  for (int32_t p = 0; p < tListLen(policyName); ++p) {
+    SLRUCacheStats stats = {0};
+    int64_t        used = benchReplay(trace, num, capacity, shardBits, (LRUPolicy)p, &stats);
+    if (used < 0) {
+      printf("failed to create the cache, capacity:%" PRId64 "\n", capacity);
+      return -1;
+    }
+
+    used = TMAX(used, 1);
+    printf("%s,%s,%" PRId64 ",%" PRId64 ",%.4f,%" PRId64 ",%" PRId64 ",%.2f\n", name, policyName[p], capacity, num,
+           ((double)stats.hits) / TMAX(stats.hits + stats.misses, 1), stats.evictions, stats.rejections,
+           ((double)num) / used);
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  int64_t     num = 2000000;
+  int64_t     capacity = 10000;
+  int32_t     shardBits = 0;
+  const char *path = NULL;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      num = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0 && i < argc - 1) {
+      capacity = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0 && i < argc - 1) {
+      shardBits = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-f") == 0 && i < argc - 1) {
+      path = argv[++i];
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n]: number of lookups of the generated traces, default: %" PRId64 "\n", num);
+      printf("  [-c]: capacity of the cache in entries, default: %" PRId64 "\n", capacity);
+      printf("  [-s]: number of shard bits of the cache, default: %d\n", shardBits);
+      printf("  [-f]: trace file to replay besides the generated ones, one key per line\n");
+      exit(0);
+    }
+  }
+
+  if (num <= 0 || capacity <= 0 || shardBits < 0 || shardBits >= 20) {
+    printf("invalid options, lookups:%" PRId64 " capacity:%" PRId64 " shard bits:%d\n", num, capacity, shardBits);
+    return -1;
+  }
+
+  uint64_t *trace = taosMemoryMalloc(num * sizeof(uint64_t));
+  if (trace == NULL) {
+    printf("out of memory, lookups:%" PRId64 "\n", num);
+    return -1;
+  }
+
+  // csv output
+  printf("trace,policy,capacity,lookups,hit_ratio,evictions,rejections,mops\n");
+  for (int32_t t = 0; t < 2; ++t) {
+    if (genZipfTrace(trace, num, capacity, t != 0) != 0) {
+      printf("out of memory, capacity:%" PRId64 "\n", capacity);
+      return -1;
+    }
+    if (benchTrace(t != 0 ? "zipf_scan" : "zipf", trace, num, capacity, shardBits) != 0) return -1;
+  }
+
+  int64_t numOfLoopKeys = capacity * 3 / 2;
+  for (int64_t i = 0; i < num; ++i) {
+    trace[i] = i % numOfLoopKeys;
+  }
+  if (benchTrace("loop", trace, num, capacity, shardBits) != 0) return -1;
+  taosMemoryFree(trace);
+
+  if (path != NULL) {
+    uint64_t *pFileTrace = NULL;
+    int64_t   numOfFile = loadFileTrace(path, &pFileTrace);
+    if (numOfFile < 0 || benchTrace("file", pFileTrace, numOfFile, capacity, shardBits) != 0) {
+      taosMemoryFree(pFileTrace);
+      return -1;
+    }
+    taosMemoryFree(pFileTrace);
+  }
+
+  return 0;
+}
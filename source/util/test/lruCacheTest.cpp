@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "tlrucache.h"
+
+namespace {
+
+// the value is not used, and an entry with a null value is not counted out of the usage when it is released
+int32_t lruTestValue = 0;
+
+// looks the key up as a reader of the cache does, and inserts it on a miss
+bool lruTestAccess(SLRUCache *pCache, int64_t key) {
+  LRUHandle *h = taosLRUCacheLookup(pCache, &key, sizeof(key));
+  if (h != NULL) {
+    taosLRUCacheRelease(pCache, h, false);
+    return true;
+  }
+
+  taosLRUCacheInsert(pCache, &key, sizeof(key), &lruTestValue, 1, NULL, NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+  return false;
+}
+
+bool lruTestContains(SLRUCache *pCache, int64_t key) {
+  LRUHandle *h = taosLRUCacheLookup(pCache, &key, sizeof(key));
+  if (h == NULL) {
+    return false;
+  }
+
+  taosLRUCacheRelease(pCache, h, false);
+  return true;
+}
+
+// the hot keys that are still cached after a scan over many more cold keys than the cache holds, with the hot keys
+// accessed in turn during the scan
+int32_t lruTestHotKeysAfterScan(LRUPolicy policy, SLRUCacheStats *pStats) {
+  SLRUCache *pCache = taosLRUCacheInitWithPolicy(100, 0, .5, policy);
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  for (int32_t round = 0; round < 5; ++round) {
+    for (int64_t key = 0; key < 90; ++key) {
+      lruTestAccess(pCache, key);
+    }
+  }
+  for (int64_t key = 1000; key < 3000; ++key) {
+    lruTestAccess(pCache, key);
+    lruTestAccess(pCache, key % 90);
+  }
+  taosLRUCacheGetStats(pCache, pStats);
+
+  int32_t num = 0;
+  for (int64_t key = 0; key < 90; ++key) {
+    num += lruTestContains(pCache, key) ? 1 : 0;
+  }
+
+  taosLRUCacheCleanup(pCache);
+  return num;
+}
+
+size_t lruTestWindowUsage(SLRUCache *pCache) {
+  SLRUCacheStats stats = {0};
+  taosLRUCacheGetStats(pCache, &stats);
+  return stats.windowUsage;
+}
+
+}  // namespace
+
+TEST(lruCacheTest, tinylfuAdmission) {
+  SLRUCacheStats lru = {0};
+  SLRUCacheStats tinylfu = {0};
+  int32_t        lruHot = lruTestHotKeysAfterScan(TAOS_LRU_POLICY_LRU, &lru);
+  int32_t        tinylfuHot = lruTestHotKeysAfterScan(TAOS_LRU_POLICY_TINYLFU, &tinylfu);
+
+  // the hot keys out of the high pool are flushed by the scan in lru, and kept by the frequency of their lookups in
+  // tinylfu, where the cold keys only pass through the window
+  ASSERT_LT(lruHot, 90);
+  ASSERT_EQ(tinylfuHot, 90);
+
+  ASSERT_EQ(lru.hits + lru.misses, tinylfu.hits + tinylfu.misses);
+  ASSERT_GT(tinylfu.hits, lru.hits);
+  ASSERT_GE(tinylfu.hits, 4 * 90 + 2000 - 10);
+  ASSERT_EQ(lru.rejections, 0);
+  ASSERT_GT(tinylfu.rejections, 1900);
+  ASSERT_EQ(lru.windowUsage, 0);
+  ASSERT_GT(tinylfu.windowUsage, 0);
+}
+
+TEST(lruCacheTest, tinylfuWindowWithErase) {
+  SLRUCache *pCache = taosLRUCacheInitWithPolicy(1000, 0, .5, TAOS_LRU_POLICY_TINYLFU);
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  // the window is 1% of the capacity, and takes one more entry before it gives one up
+  for (int64_t key = 0; key < 2000; ++key) {
+    lruTestAccess(pCache, key);
+  }
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 1000);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 11);
+
+  // the newest entries are in the window, and a pinned one leaves it until it is released
+  int64_t    key = 1999;
+  LRUHandle *h = taosLRUCacheLookup(pCache, &key, sizeof(key));
+  ASSERT_NE(h, nullptr);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 10);
+
+  taosLRUCacheErase(pCache, &key, sizeof(key));
+  ASSERT_EQ(lruTestWindowUsage(pCache), 10);
+  ASSERT_EQ(taosLRUCacheGetPinnedUsage(pCache), 1);
+  taosLRUCacheRelease(pCache, h, false);
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 999);
+
+  for (key = 1998; key >= 1990; --key) {
+    taosLRUCacheErase(pCache, &key, sizeof(key));
+  }
+  ASSERT_EQ(lruTestWindowUsage(pCache), 1);
+
+  for (key = 0; key < 2000; ++key) {
+    taosLRUCacheErase(pCache, &key, sizeof(key));
+  }
+  ASSERT_EQ(lruTestWindowUsage(pCache), 0);
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 0);
+  ASSERT_EQ(taosLRUCacheGetElems(pCache), 0);
+
+  // the cache works the same once emptied
+  for (key = 0; key < 2000; ++key) {
+    lruTestAccess(pCache, key);
+  }
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 1000);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 11);
+
+  taosLRUCacheCleanup(pCache);
+}
+
+TEST(lruCacheTest, tinylfuWindowWithCapacity) {
+  SLRUCache *pCache = taosLRUCacheInitWithPolicy(1000, 0, .5, TAOS_LRU_POLICY_TINYLFU);
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  for (int64_t key = 0; key < 2000; ++key) {
+    lruTestAccess(pCache, key);
+  }
+  ASSERT_EQ(lruTestWindowUsage(pCache), 11);
+
+  // the window shrinks with the capacity, by the entries given up to lru or rejected
+  taosLRUCacheSetCapacity(pCache, 100);
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 100);
+  ASSERT_EQ(taosLRUCacheGetElems(pCache), 100);
+  ASSERT_LE(lruTestWindowUsage(pCache), 1);
+
+  // the window grows back with the capacity, and the new entries go to lru while there is room
+  taosLRUCacheSetCapacity(pCache, 2000);
+  for (int64_t key = 5000; key < 5500; ++key) {
+    lruTestAccess(pCache, key);
+  }
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 600);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 21);
+
+  for (int64_t key = 6000; key < 8000; ++key) {
+    lruTestAccess(pCache, key);
+  }
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 2000);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 21);
+
+  taosLRUCacheEraseUnrefEntries(pCache);
+  ASSERT_EQ(lruTestWindowUsage(pCache), 0);
+  ASSERT_EQ(taosLRUCacheGetUsage(pCache), 0);
+
+  taosLRUCacheCleanup(pCache);
+}
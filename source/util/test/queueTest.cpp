@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "tglobal.h"
+#include "tqueue.h"
+#include "tworker.h"
+
+extern "C" int64_t tsRpcQueueMemoryUsed;
+
+namespace {
+
+typedef struct {
+  int32_t producer;
+  int32_t seq;
+} SQueueTestItem;
+
+const int32_t numOfProducers = 4;
+const int32_t numOfItemsEach = 20000;
+
+void writeItems(STaosQueue *queue, int32_t producer, int32_t first, int32_t num, EQItype itype) {
+  for (int32_t i = first; i < first + num; ++i) {
+    SQueueTestItem *pItem = (SQueueTestItem *)taosAllocateQitem(sizeof(SQueueTestItem), itype, 100);
+    ASSERT_NE(pItem, nullptr);
+    pItem->producer = producer;
+    pItem->seq = i;
+    ASSERT_EQ(taosWriteQitem(queue, pItem), 0);
+  }
+}
+
+typedef struct {
+  int32_t next[numOfProducers];
+  int32_t numOfItems;
+  bool    ordered;
+} SQueueTestResult;
+
+// the items of one producer shall be read in the order they are written
+void checkItem(SQueueTestResult *pRes, SQueueTestItem *pItem) {
+  if (pItem->seq != pRes->next[pItem->producer]) pRes->ordered = false;
+  pRes->next[pItem->producer] = pItem->seq + 1;
+  pRes->numOfItems++;
+}
+
+void processItems(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfItems) {
+  SQueueTestResult *pRes = (SQueueTestResult *)pInfo->ahandle;
+  for (int32_t i = 0; i < numOfItems; ++i) {
+    SQueueTestItem *pItem = NULL;
+    if (taosGetQitem(qall, (void **)&pItem) == 0) break;
+    checkItem(pRes, pItem);
+    taosFreeQitem(pItem);
+  }
+}
+
+}  // namespace
+
+TEST(queueTest, lockFreeReadWrite) {
+  STaosQueue *queue = taosOpenQueueEx(QUEUE_MODE_LOCK_FREE);
+  ASSERT_NE(queue, nullptr);
+  ASSERT_TRUE(taosQueueEmpty(queue));
+
+  std::vector<std::thread> producers;
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    producers.emplace_back(writeItems, queue, i, 0, numOfItemsEach, DEF_QITEM);
+  }
+
+  SQueueTestResult res = {{0}, 0, true};
+  STaosQall       *qall = taosAllocateQall();
+  int32_t          total = numOfProducers * numOfItemsEach;
+  while (res.numOfItems < total) {
+    // read one item and a batch by turns
+    SQueueTestItem *pItem = NULL;
+    if (taosReadQitem(queue, (void **)&pItem) == 1) {
+      checkItem(&res, pItem);
+      taosFreeQitem(pItem);
+    }
+
+    int32_t num = taosReadAllQitems(queue, qall);
+    ASSERT_EQ(num, taosQallItemSize(qall));
+    ASSERT_EQ(taosQallMemSize(qall), num * (int64_t)(sizeof(SQueueTestItem) + 100));
+    for (int32_t i = 0; i < num; ++i) {
+      ASSERT_EQ(taosGetQitem(qall, (void **)&pItem), 1);
+      checkItem(&res, pItem);
+      taosFreeQitem(pItem);
+    }
+    ASSERT_EQ(taosGetQitem(qall, (void **)&pItem), 0);
+  }
+
+  for (auto &t : producers) t.join();
+
+  ASSERT_TRUE(res.ordered);
+  ASSERT_EQ(res.numOfItems, total);
+  ASSERT_TRUE(taosQueueEmpty(queue));
+  ASSERT_EQ(taosQueueItemSize(queue), 0);
+  ASSERT_EQ(taosQueueMemorySize(queue), 0);
+
+  taosFreeQall(qall);
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, lockFreeCapacity) {
+  STaosQueue *queue = taosOpenQueueEx(QUEUE_MODE_LOCK_FREE);
+  ASSERT_NE(queue, nullptr);
+
+  int64_t itemMem = sizeof(SQueueTestItem) + 100;
+  taosSetQueueCapacity(queue, 10);
+  for (int32_t i = 0; i < 12; ++i) {
+    void   *pItem = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 100);
+    int32_t code = taosWriteQitem(queue, pItem);
+    if (i < 10) {
+      ASSERT_EQ(code, 0);
+    } else {
+      ASSERT_EQ(code, TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY);
+      taosFreeQitem(pItem);
+    }
+  }
+  ASSERT_EQ(taosQueueItemSize(queue), 10);
+  ASSERT_EQ(taosQueueMemorySize(queue), 10 * itemMem);
+
+  // a write rejected by the memory limit leaves the counters untouched
+  taosSetQueueCapacity(queue, 0);
+  taosSetQueueMemoryCapacity(queue, 11 * itemMem);
+  void *pItem = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 100);
+  ASSERT_EQ(taosWriteQitem(queue, pItem), 0);
+  pItem = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 100);
+  ASSERT_EQ(taosWriteQitem(queue, pItem), TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY);
+  taosFreeQitem(pItem);
+  ASSERT_EQ(taosQueueItemSize(queue), 11);
+  ASSERT_EQ(taosQueueMemorySize(queue), 11 * itemMem);
+
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, lockFreeQsetMode) {
+  STaosQset  *qset = taosOpenQsetEx(QUEUE_MODE_LOCK_FREE);
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(qset, nullptr);
+  ASSERT_NE(queue, nullptr);
+
+  ASSERT_NE(taosAddIntoQset(qset, queue, NULL), 0);
+  ASSERT_EQ(taosGetQueueNumber(qset), 0);
+
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+}
+
+TEST(queueTest, lockFreeWorker) {
+  tsRpcQueueMemoryAllowed = INT64_MAX;
+  int64_t memUsed = atomic_load_64(&tsRpcQueueMemoryUsed);
+
+  SQueueTestResult res = {{0}, 0, true};
+  SMultiWorker     worker = {0};
+  SMultiWorkerCfg  cfg = {.name = "queue-test",
+                          .max = 1,
+                          .fp = (FItems)processItems,
+                          .param = &res,
+                          .queueMode = QUEUE_MODE_LOCK_FREE};
+  ASSERT_EQ(tMultiWorkerInit(&worker, &cfg), 0);
+
+  std::vector<std::thread> producers;
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    producers.emplace_back(writeItems, worker.queue, i, 0, numOfItemsEach, RPC_QITEM);
+  }
+  for (auto &t : producers) t.join();
+
+  // the worker parks on the empty queue and shall be woken up by each of the writes
+  for (int32_t i = 0; i < 100; ++i) {
+    while (!taosQueueEmpty(worker.queue)) taosMsleep(1);
+    writeItems(worker.queue, 0, numOfItemsEach + i, 1, RPC_QITEM);
+  }
+
+  tMultiWorkerCleanup(&worker);
+
+  ASSERT_TRUE(res.ordered);
+  ASSERT_EQ(res.numOfItems, numOfProducers * numOfItemsEach + 100);
+  ASSERT_EQ(atomic_load_64(&tsRpcQueueMemoryUsed), memUsed);
+}
+
+TEST(queueTest, closeReleaseRpcMemory) {
+  tsRpcQueueMemoryAllowed = INT64_MAX;
+  int64_t memUsed = atomic_load_64(&tsRpcQueueMemoryUsed);
+
+  for (int32_t mode = QUEUE_MODE_MUTEX; mode <= QUEUE_MODE_LOCK_FREE; ++mode) {
+    STaosQueue *queue = taosOpenQueueEx((EQueueMode)mode);
+    ASSERT_NE(queue, nullptr);
+    writeItems(queue, 0, 0, 10, RPC_QITEM);
+    ASSERT_GT(atomic_load_64(&tsRpcQueueMemoryUsed), memUsed);
+
+    taosCloseQueue(queue);
+    ASSERT_EQ(atomic_load_64(&tsRpcQueueMemoryUsed), memUsed);
+  }
+}
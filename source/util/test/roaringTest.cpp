@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "taoserror.h"
+#include "troaring.h"
+
+using namespace std;
+
+namespace {
+
+// clustered values are like the uids of the tables created together, and the others fall into their own containers
+vector<uint64_t> genValues(mt19937_64 &rng, int32_t num, uint64_t base, int32_t span, bool clustered) {
+  vector<uint64_t> vals;
+  for (int32_t i = 0; i < num; ++i) {
+    if (clustered) {
+      vals.push_back(base + rng() % span);
+    } else {
+      vals.push_back(rng());
+    }
+  }
+  return vals;
+}
+
+SRoaringBitmap *buildBitmap(const vector<uint64_t> &vals) {
+  SRoaringBitmap *pBitmap = tRoaringCreate();
+  EXPECT_NE(pBitmap, nullptr);
+  EXPECT_EQ(tRoaringAddBatch(pBitmap, vals.data(), vals.size()), TSDB_CODE_SUCCESS);
+  return pBitmap;
+}
+
+void checkBitmap(const SRoaringBitmap *pBitmap, const set<uint64_t> &expect) {
+  ASSERT_EQ(tRoaringCardinality(pBitmap), (int64_t)expect.size());
+
+  SArray *pArray = taosArrayInit(8, sizeof(uint64_t));
+  ASSERT_EQ(tRoaringToArray(pBitmap, pArray), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(taosArrayGetSize(pArray), expect.size());
+
+  int32_t i = 0;
+  for (uint64_t v : expect) {
+    ASSERT_EQ(*(uint64_t *)taosArrayGet(pArray, i++), v);
+  }
+  taosArrayDestroy(pArray);
+
+  int32_t len = tRoaringGetEncodeSize(pBitmap);
+  char   *buf = (char *)taosMemoryMalloc(len);
+  ASSERT_EQ(tRoaringEncode(pBitmap, buf), len);
+
+  SRoaringBitmap *pDecoded = tRoaringDecode(buf, len);
+  ASSERT_NE(pDecoded, nullptr);
+  ASSERT_EQ(tRoaringCardinality(pDecoded), (int64_t)expect.size());
+  for (uint64_t v : expect) {
+    ASSERT_TRUE(tRoaringContains(pDecoded, v));
+  }
+  tRoaringDestroy(pDecoded);
+
+  ASSERT_EQ(tRoaringDecode(buf, len - 1), nullptr);
+  taosMemoryFree(buf);
+}
+
+}  // namespace
+
+TEST(TD_UTIL_ROARING_TEST, add_contains) {
+  SRoaringBitmap *pBitmap = tRoaringCreate();
+  ASSERT_NE(pBitmap, nullptr);
+
+  set<uint64_t> expect;
+  mt19937_64    rng(20240601);
+  // array containers, bitmap containers, and values in descending order
+  for (int32_t i = 0; i < 30000; ++i) {
+    uint64_t v = (i % 3 == 0) ? (1ULL << 40) + rng() % 20000 : (i % 3 == 1) ? rng() : UINT64_MAX - i;
+    ASSERT_EQ(tRoaringAdd(pBitmap, v), TSDB_CODE_SUCCESS);
+    expect.insert(v);
+  }
+
+  for (uint64_t v : expect) {
+    ASSERT_TRUE(tRoaringContains(pBitmap, v));
+  }
+  for (int32_t i = 0; i < 10000; ++i) {
+    uint64_t v = rng();
+    ASSERT_EQ(tRoaringContains(pBitmap, v), expect.count(v) > 0);
+  }
+
+  checkBitmap(pBitmap, expect);
+
+  tRoaringClear(pBitmap);
+  ASSERT_EQ(tRoaringCardinality(pBitmap), 0);
+  checkBitmap(pBitmap, set<uint64_t>());
+  tRoaringDestroy(pBitmap);
+}
+
+TEST(TD_UTIL_ROARING_TEST, set_operations) {
+  mt19937_64 rng(20240602);
+
+  // the number of values per container goes from a few to the bitmap ones
+  int32_t nums[] = {10, 3000, 50000};
+  for (int32_t n1 : nums) {
+    for (int32_t n2 : nums) {
+      for (int32_t clustered = 0; clustered < 2; ++clustered) {
+        vector<uint64_t> v1 = genValues(rng, n1, 1ULL << 50, 1 << 18, clustered);
+        vector<uint64_t> v2 = genValues(rng, n2, 1ULL << 50, 1 << 18, clustered);
+        v2.insert(v2.end(), v1.begin(), v1.begin() + v1.size() / 4);
+
+        set<uint64_t> s1(v1.begin(), v1.end()), s2(v2.begin(), v2.end()), expect;
+
+        SRoaringBitmap *pSrc = buildBitmap(v2);
+
+        SRoaringBitmap *pDst = buildBitmap(v1);
+        ASSERT_EQ(tRoaringAnd(pDst, pSrc), TSDB_CODE_SUCCESS);
+        set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(), inserter(expect, expect.begin()));
+        checkBitmap(pDst, expect);
+        tRoaringDestroy(pDst);
+
+        expect.clear();
+        pDst = buildBitmap(v1);
+        ASSERT_EQ(tRoaringOr(pDst, pSrc), TSDB_CODE_SUCCESS);
+        set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), inserter(expect, expect.begin()));
+        checkBitmap(pDst, expect);
+        tRoaringDestroy(pDst);
+
+        expect.clear();
+        pDst = buildBitmap(v1);
+        ASSERT_EQ(tRoaringAndNot(pDst, pSrc), TSDB_CODE_SUCCESS);
+        set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(), inserter(expect, expect.begin()));
+        checkBitmap(pDst, expect);
+        tRoaringDestroy(pDst);
+
+        tRoaringDestroy(pSrc);
+      }
+    }
+  }
+}
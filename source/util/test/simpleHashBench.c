@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "thash.h"
+#include "tsimplehash.h"
+
+// insert/probe/iterate throughput of the chained and the open addressing simple hash table
+typedef struct {
+  double insert;
+  double probeHit;
+  double probeMiss;
+  double iterate;
+} SBenchResult;
+
+static double mops(int64_t num, int64_t us) { return (us == 0) ? 0 : ((double)num) / us; }
+
+static void shuffleKeys(int64_t *keys, int64_t num) {
+  for (int64_t i = num - 1; i > 0; --i) {
+    int64_t j = taosRand() % (i + 1);
+    int64_t t = keys[i];
+    keys[i] = keys[j];
+    keys[j] = t;
+  }
+}
+
+static int32_t benchOnce(ESHashType type, const int64_t *keys, int64_t num, SBenchResult *pRes) {
+  SSHashObj *pHashObj = tSimpleHashInitEx(8, MurmurHash3_32, type);
+  if (pHashObj == NULL) {
+    return -1;
+  }
+
+  int64_t st = taosGetTimestampUs();
+  for (int64_t i = 0; i < num; ++i) {
+    if (tSimpleHashPut(pHashObj, &keys[i], sizeof(int64_t), &i, sizeof(int64_t)) != 0) {
+      tSimpleHashCleanup(pHashObj);
+      return -1;
+    }
+  }
+  pRes->insert = mops(num, taosGetTimestampUs() - st);
+
+  int64_t sum = 0;
+  st = taosGetTimestampUs();
+  for (int64_t i = 0; i < num; ++i) {
+    int64_t *p = tSimpleHashGet(pHashObj, &keys[i], sizeof(int64_t));
+    sum += *p;
+  }
+  pRes->probeHit = mops(num, taosGetTimestampUs() - st);
+
+  // keys are all positive, so the negative ones are never found
+  st = taosGetTimestampUs();
+  for (int64_t i = 0; i < num; ++i) {
+    int64_t k = -keys[i];
+    sum += (tSimpleHashGet(pHashObj, &k, sizeof(int64_t)) != NULL);
+  }
+  pRes->probeMiss = mops(num, taosGetTimestampUs() - st);
+
+  void   *pIte = NULL;
+  int32_t iter = 0;
+  st = taosGetTimestampUs();
+  while ((pIte = tSimpleHashIterate(pHashObj, pIte, &iter)) != NULL) {
+    sum += *(int64_t *)pIte;
+  }
+  pRes->iterate = mops(num, taosGetTimestampUs() - st);
+
+  tSimpleHashCleanup(pHashObj);
+  return (sum == 0 && num > 1) ? -1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+  int64_t maxKeys = 10000000;
+  int32_t loops = 3;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      maxKeys = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "-l") == 0 && i < argc - 1) {
+      loops = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n]: maximum number of keys, from 1e3 up to it by power of 10, default: %" PRId64 "\n", maxKeys);
+      printf("  [-l]: number of loops for each case, the best one is reported, default: %d\n", loops);
+      exit(0);
+    }
+  }
+
+  const char *typeName[] = {"chained", "open_addr"};
+
+  // csv output
+  printf("type,keys,insert_mops,probe_hit_mops,probe_miss_mops,iterate_mops\n");
+  for (int64_t num = 1000; num <= maxKeys; num *= 10) {
+    int64_t *keys = taosMemoryMalloc(num * sizeof(int64_t));
+    if (keys == NULL) {
+      printf("out of memory, keys:%" PRId64 "\n", num);
+      return -1;
+    }
+
+    for (int64_t i = 0; i < num; ++i) {
+      keys[i] = i * 7 + 1;
+    }
+    shuffleKeys(keys, num);
+
+    for (int32_t type = SHASH_TYPE_CHAINED; type <= SHASH_TYPE_OPEN_ADDR; ++type) {
+      SBenchResult best = {0};
+      for (int32_t i = 0; i < loops; ++i) {
+        SBenchResult res = {0};
+        if (benchOnce(type, keys, num, &res) != 0) {
+          printf("failed to run benchmark, type:%s keys:%" PRId64 "\n", typeName[type], num);
+          taosMemoryFree(keys);
+          return -1;
+        }
+
+        best.insert = TMAX(best.insert, res.insert);
+        best.probeHit = TMAX(best.probeHit, res.probeHit);
+        best.probeMiss = TMAX(best.probeMiss, res.probeMiss);
+        best.iterate = TMAX(best.iterate, res.iterate);
+      }
+
+      printf("%s,%" PRId64 ",%.2f,%.2f,%.2f,%.2f\n", typeName[type], num, best.insert, best.probeHit, best.probeMiss,
+             best.iterate);
+    }
+
+    taosMemoryFree(keys);
+  }
+
+  return 0;
+}
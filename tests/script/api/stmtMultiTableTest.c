@@ -0,0 +1,233 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "../../../include/client/taos.h"
+
+#define PRINT_ERROR printf("\033[31m");
+#define PRINT_SUCCESS printf("\033[32m");
+
+#define NUM_OF_TABLES 4
+#define NUM_OF_ROWS 12
+#define TBNAME_LEN 16
+
+void execute_simple_sql(void *taos, char *sql) {
+    TAOS_RES *result = taos_query(taos, sql);
+    if ( result == NULL || taos_errno(result) != 0) {
+        PRINT_ERROR
+        printf("failed to %s, Reason: %s\n", sql, taos_errstr(result));
+        taos_free_result(result);
+        exit(EXIT_FAILURE);
+    }
+    taos_free_result(result);
+    PRINT_SUCCESS
+    printf("Successfully %s\n", sql);
+}
+
+void check_count(void *taos, char *sql, int64_t expected) {
+    TAOS_RES *result = taos_query(taos, sql);
+    if (result == NULL || taos_errno(result) != 0) {
+        PRINT_ERROR
+        printf("failed to %s, Reason: %s\n", sql, taos_errstr(result));
+        taos_free_result(result);
+        exit(EXIT_FAILURE);
+    }
+
+    TAOS_ROW row = taos_fetch_row(result);
+    int64_t count = row ? *(int64_t *)row[0] : 0;
+    taos_free_result(result);
+    if (count != expected) {
+        PRINT_ERROR
+        printf("%s: %" PRId64 " rows but %" PRId64 " expected\n", sql, count, expected);
+        exit(EXIT_FAILURE);
+    }
+    PRINT_SUCCESS
+    printf("%s: %" PRId64 " rows as expected\n", sql, count);
+}
+
+TAOS_STMT *prepare_stmt(void *taos, char *sql) {
+    TAOS_STMT *stmt = taos_stmt_init(taos);
+    if (stmt == NULL) {
+        PRINT_ERROR
+        printf("TDengine error: failed to init taos_stmt\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int code = taos_stmt_prepare(stmt, sql, 0);
+    if (code != 0) {
+        PRINT_ERROR
+        printf("failed to execute taos_stmt_prepare %s. error:%s\n", sql, taos_stmt_errstr(stmt));
+        exit(EXIT_FAILURE);
+    }
+    return stmt;
+}
+
+// the rows of the tables are interleaved, and each table has NUM_OF_ROWS / NUM_OF_TABLES rows in a batch
+typedef struct {
+    char    tbnames[NUM_OF_ROWS][TBNAME_LEN];
+    int32_t tbnameLen[NUM_OF_ROWS];
+    int64_t ts[NUM_OF_ROWS];
+    int32_t c1[NUM_OF_ROWS];
+    int32_t t1[NUM_OF_ROWS];
+    TAOS_MULTI_BIND tbnameBind;
+    TAOS_MULTI_BIND tagBind[1];
+    TAOS_MULTI_BIND colBind[2];
+} SMultiTableBatch;
+
+void init_batch(SMultiTableBatch *pBatch, const char *prefix, int64_t startTs, int numOfRows) {
+    memset(pBatch, 0, sizeof(*pBatch));
+    for (int i = 0; i < numOfRows; ++i) {
+        int tb = i % NUM_OF_TABLES;
+        pBatch->tbnameLen[i] = sprintf(pBatch->tbnames[i], "%s%d", prefix, tb);
+        pBatch->ts[i] = startTs + i;
+        pBatch->c1[i] = i;
+        pBatch->t1[i] = tb;
+    }
+
+    pBatch->tbnameBind.buffer_type = TSDB_DATA_TYPE_BINARY;
+    pBatch->tbnameBind.buffer = pBatch->tbnames;
+    pBatch->tbnameBind.buffer_length = TBNAME_LEN;
+    pBatch->tbnameBind.length = pBatch->tbnameLen;
+    pBatch->tbnameBind.num = numOfRows;
+
+    pBatch->tagBind[0].buffer_type = TSDB_DATA_TYPE_INT;
+    pBatch->tagBind[0].buffer = pBatch->t1;
+    pBatch->tagBind[0].buffer_length = sizeof(int32_t);
+    pBatch->tagBind[0].num = numOfRows;
+
+    pBatch->colBind[0].buffer_type = TSDB_DATA_TYPE_TIMESTAMP;
+    pBatch->colBind[0].buffer = pBatch->ts;
+    pBatch->colBind[0].buffer_length = sizeof(int64_t);
+    pBatch->colBind[0].num = numOfRows;
+
+    pBatch->colBind[1].buffer_type = TSDB_DATA_TYPE_INT;
+    pBatch->colBind[1].buffer = pBatch->c1;
+    pBatch->colBind[1].buffer_length = sizeof(int32_t);
+    pBatch->colBind[1].num = numOfRows;
+}
+
+void bind_and_execute(TAOS_STMT *stmt, SMultiTableBatch *pBatch, TAOS_MULTI_BIND *tags) {
+    int code = taos_stmt_bind_multi_table_batch(stmt, &pBatch->tbnameBind, tags, pBatch->colBind);
+    if (code != 0) {
+        PRINT_ERROR
+        printf("failed to execute taos_stmt_bind_multi_table_batch. error:%s\n", taos_stmt_errstr(stmt));
+        exit(EXIT_FAILURE);
+    }
+
+    if (taos_stmt_execute(stmt) != 0) {
+        PRINT_ERROR
+        printf("failed to execute insert statement. error:%s\n", taos_stmt_errstr(stmt));
+        exit(EXIT_FAILURE);
+    }
+
+    if (taos_stmt_affected_rows_once(stmt) != pBatch->tbnameBind.num) {
+        PRINT_ERROR
+        printf("%d rows inserted but %d expected\n", taos_stmt_affected_rows_once(stmt), pBatch->tbnameBind.num);
+        exit(EXIT_FAILURE);
+    }
+    PRINT_SUCCESS
+    printf("Successfully insert %d rows of %d tables\n", pBatch->tbnameBind.num, NUM_OF_TABLES);
+}
+
+void expect_bind_failure(TAOS_STMT *stmt, SMultiTableBatch *pBatch, TAOS_MULTI_BIND *tags, char *desc) {
+    int code = taos_stmt_bind_multi_table_batch(stmt, &pBatch->tbnameBind, tags, pBatch->colBind);
+    if (code == 0) {
+        PRINT_ERROR
+        printf("%s: taos_stmt_bind_multi_table_batch succeeded but failure expected\n", desc);
+        exit(EXIT_FAILURE);
+    }
+    PRINT_SUCCESS
+    printf("%s: taos_stmt_bind_multi_table_batch failed as expected, error:%s\n", desc, taos_stmt_errstr(stmt));
+}
+
+// the child tables are created by the first batch, and the second one goes to the tables already created
+void test_auto_create_tables(void *taos) {
+    SMultiTableBatch batch;
+    TAOS_STMT *stmt = prepare_stmt(taos, "insert into ? using stb tags(?) values(?,?)");
+
+    init_batch(&batch, "ct", 1700000000000, NUM_OF_ROWS);
+    bind_and_execute(stmt, &batch, batch.tagBind);
+    init_batch(&batch, "ct", 1700000001000, NUM_OF_ROWS);
+    bind_and_execute(stmt, &batch, batch.tagBind);
+    taos_stmt_close(stmt);
+
+    check_count(taos, "select count(*) from stb", 2 * NUM_OF_ROWS);
+    check_count(taos, "select count(*) from ct0", 2 * NUM_OF_ROWS / NUM_OF_TABLES);
+    check_count(taos, "select count(*) from stb where t1 = 3", 2 * NUM_OF_ROWS / NUM_OF_TABLES);
+}
+
+// several existing tables in one batch, and a second batch with one row of each table
+void test_existing_tables(void *taos) {
+    SMultiTableBatch batch;
+    TAOS_STMT *stmt = prepare_stmt(taos, "insert into ? values(?,?)");
+
+    init_batch(&batch, "ct", 1700000002000, NUM_OF_ROWS);
+    bind_and_execute(stmt, &batch, NULL);
+    init_batch(&batch, "ct", 1700000003000, NUM_OF_TABLES);
+    bind_and_execute(stmt, &batch, NULL);
+    taos_stmt_close(stmt);
+
+    check_count(taos, "select count(*) from stb", 3 * NUM_OF_ROWS + NUM_OF_TABLES);
+    check_count(taos, "select count(*) from ct1", 3 * NUM_OF_ROWS / NUM_OF_TABLES + 1);
+}
+
+// a table in the batch does not exist, no row of the batch is inserted
+void test_missing_table(void *taos) {
+    SMultiTableBatch batch;
+    TAOS_STMT *stmt = prepare_stmt(taos, "insert into ? values(?,?)");
+
+    init_batch(&batch, "ct", 1700000004000, NUM_OF_ROWS);
+    strcpy(batch.tbnames[NUM_OF_ROWS - 1], "not_exist");
+    batch.tbnameLen[NUM_OF_ROWS - 1] = strlen("not_exist");
+    expect_bind_failure(stmt, &batch, NULL, "missing table");
+    taos_stmt_close(stmt);
+
+    check_count(taos, "select count(*) from stb", 3 * NUM_OF_ROWS + NUM_OF_TABLES);
+}
+
+// the rows of the columns and tags shall be as many as the table names
+void test_mismatched_rows(void *taos) {
+    SMultiTableBatch batch;
+    TAOS_STMT *stmt = prepare_stmt(taos, "insert into ? values(?,?)");
+
+    init_batch(&batch, "ct", 1700000005000, NUM_OF_ROWS);
+    batch.colBind[1].num = NUM_OF_ROWS - 1;
+    expect_bind_failure(stmt, &batch, NULL, "mismatched column rows");
+    taos_stmt_close(stmt);
+
+    stmt = prepare_stmt(taos, "insert into ? using stb tags(?) values(?,?)");
+    init_batch(&batch, "nt", 1700000005000, NUM_OF_ROWS);
+    batch.tagBind[0].num = NUM_OF_ROWS - 1;
+    expect_bind_failure(stmt, &batch, batch.tagBind, "mismatched tag rows");
+    taos_stmt_close(stmt);
+
+    check_count(taos, "select count(*) from stb", 3 * NUM_OF_ROWS + NUM_OF_TABLES);
+}
+
+int main(int argc, char *argv[]) {
+    void *taos = taos_connect("127.0.0.1", "root", "taosdata", NULL, 0);
+    if (taos == NULL) {
+        PRINT_ERROR
+        printf("TDengine error: failed to connect\n");
+        exit(EXIT_FAILURE);
+    }
+    PRINT_SUCCESS
+    printf("Successfully connected to TDengine\n");
+
+    execute_simple_sql(taos, "drop database if exists test");
+    execute_simple_sql(taos, "create database test vgroups 2");
+    execute_simple_sql(taos, "use test");
+    execute_simple_sql(taos, "create table stb(ts timestamp, c1 int) tags (t1 int)");
+
+    test_auto_create_tables(taos);
+    test_existing_tables(taos);
+    test_missing_table(taos);
+    test_mismatched_rows(taos);
+
+    taos_close(taos);
+    taos_cleanup();
+
+    return 0;
+}